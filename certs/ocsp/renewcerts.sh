@@ -113,4 +113,14 @@ openssl ocsp -issuer ./root-ca-cert.pem -cert ./intermediate1-ca-cert.pem -url h
 kill $PID
 wait $PID
 
+# now start up a responder whose responses expire well before the certificates
+openssl ocsp -port 22221 -ndays 365 -index index-ca-and-intermediate-cas.txt -rsigner ocsp-responder-cert.pem -rkey ocsp-responder-key.pem -CA root-ca-cert.pem -partial_chain &
+PID=$!
+sleep 1 # Make sure server is ready
+
+openssl ocsp -issuer ./root-ca-cert.pem -cert ./intermediate1-ca-cert.pem -cert ./intermediate2-ca-cert.pem -url http://localhost:22221/ -respout test-multi-response-short.der -noverify
+
+kill $PID
+wait $PID
+
 exit 0
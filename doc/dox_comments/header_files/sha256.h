@@ -244,3 +244,47 @@ int wc_Sha224Update(wc_Sha224* sha224, const byte* data, word32 len);
     \sa wc_Sha224Update
 */
 int wc_Sha224Final(wc_Sha224* sha224, byte* hash);
+
+/*!
+    \ingroup SHA
+
+    \brief Hashes a number of independent messages with SHA-256.
+    Available when wolfSSL is built with WOLFSSL_SHA256_MULTI
+    (--enable-sha256-multi). On x86_64 with AVX2 or AVX1, and without the SHA
+    instructions, the messages are hashed in parallel in the lanes of vector
+    registers. Otherwise each message is hashed in turn.
+
+    \return 0 Success
+    \return BAD_FUNC_ARG Returned when an array is NULL, a hash buffer is NULL
+    or a message is NULL and its length is not 0.
+    \return MEMORY_E Returned on dynamic memory allocation failure.
+
+    \param data array of cnt messages to hash.
+    \param sz array of cnt message lengths in bytes.
+    \param hash array of cnt buffers, each WC_SHA256_DIGEST_SIZE bytes, to
+    hold the digests.
+    \param cnt number of messages.
+    \param heap heap hint for dynamic memory allocation. May be NULL.
+    \param devId device identifier. Use INVALID_DEVID when not using a device.
+
+    _Example_
+    \code
+    byte msg0[] = { /* first message */ };
+    byte msg1[] = { /* second message */ };
+    const byte* data[2] = { msg0, msg1 };
+    word32 sz[2] = { sizeof(msg0), sizeof(msg1) };
+    byte digest0[WC_SHA256_DIGEST_SIZE];
+    byte digest1[WC_SHA256_DIGEST_SIZE];
+    byte* hash[2] = { digest0, digest1 };
+
+    if (wc_Sha256_MultiHash(data, sz, hash, 2, NULL, INVALID_DEVID) != 0) {
+        // error hashing messages
+    }
+    \endcode
+
+    \sa wc_Sha256Hash
+    \sa wc_Sha256Update
+    \sa wc_Sha256Final
+*/
+int wc_Sha256_MultiHash(const byte* const* data, const word32* sz,
+    byte* const* hash, word32 cnt, void* heap, int devId);
@@ -992,6 +992,135 @@ int wc_Shake128_GetHash(wc_Shake* shake, byte* hash);
 */
 int wc_Shake128_Copy(wc_Shake* shake, wc_Shake* dst);
 
+/*!
+    \ingroup SHA
+
+    \brief This function initializes four SHAKE128 operations that are
+    performed in parallel. Each operation must absorb the same length of data.
+    Uses AVX2 when available on the CPU.
+
+    \return 0 Returned upon successfully initializing.
+    \return BAD_FUNC_ARG Returned when shake is NULL.
+
+    \param shake pointer to the four-way shake structure to initialize
+    \param heap pointer to a heap hint for dynamic memory allocation
+    \param devId device identifier - unused
+
+    _Example_
+    \code
+    wc_Shakex4 shake[1];
+    const byte* data[4] = { data0, data1, data2, data3 };
+    byte* out[4] = { out0, out1, out2, out3 };
+
+    if ((ret = wc_InitShake128x4(shake, NULL, INVALID_DEVID)) != 0) {
+       WOLFSSL_MSG("wc_InitShake128x4 failed");
+    }
+    else {
+       wc_Shake128x4_Absorb(shake, data, len);
+       wc_Shake128x4_SqueezeBlocks(shake, out, 2);
+       wc_Shake128x4_Free(shake);
+    }
+    \endcode
+
+    \sa wc_Shake128x4_Absorb
+    \sa wc_Shake128x4_SqueezeBlocks
+    \sa wc_Shake128x4_Free
+*/
+int wc_InitShake128x4(wc_Shakex4* shake, void* heap, int devId);
+
+/*!
+    \ingroup SHA
+
+    \brief Absorb the same length of data into each of the four SHAKE128
+    operations. Can only be called once per initialization.
+
+    \return 0 Returned upon successfully absorbing the data.
+    \return BAD_FUNC_ARG Returned when shake or data is NULL, or when a data
+    pointer is NULL and len is not 0.
+
+    \param shake pointer to the four-way shake structure
+    \param data array of four pointers to data to absorb
+    \param len length of each of the four data in bytes
+
+    _Example_
+    \code
+    wc_Shakex4 shake[1];
+    const byte* data[4] = { data0, data1, data2, data3 };
+
+    if ((ret = wc_InitShake128x4(shake, NULL, INVALID_DEVID)) != 0) {
+       WOLFSSL_MSG("wc_InitShake128x4 failed");
+    }
+    else {
+       wc_Shake128x4_Absorb(shake, data, len);
+    }
+    \endcode
+
+    \sa wc_InitShake128x4
+    \sa wc_Shake128x4_SqueezeBlocks
+*/
+int wc_Shake128x4_Absorb(wc_Shakex4* shake, const byte* const* data,
+    word32 len);
+
+/*!
+    \ingroup SHA
+
+    \brief Squeeze out more blocks of data from each of the four SHAKE128
+    operations. Can be called incrementally.
+
+    \return 0 Returned upon successfully squeezing.
+    \return BAD_FUNC_ARG Returned when shake or out is NULL, or when an
+    output pointer is NULL and blockCnt is not 0.
+
+    \param shake pointer to the four-way shake structure
+    \param out array of four output buffers
+    \param blockCnt Number of blocks to squeeze into each buffer. Each block
+    is WC_SHA3_128_BLOCK_SIZE bytes in length.
+
+    _Example_
+    \code
+    wc_Shakex4 shake[1];
+    const byte* data[4] = { data0, data1, data2, data3 };
+    byte* out[4] = { out0, out1, out2, out3 };
+
+    if ((ret = wc_InitShake128x4(shake, NULL, INVALID_DEVID)) != 0) {
+       WOLFSSL_MSG("wc_InitShake128x4 failed");
+    }
+    else {
+       wc_Shake128x4_Absorb(shake, data, len);
+       wc_Shake128x4_SqueezeBlocks(shake, out, 2);
+    }
+    \endcode
+
+    \sa wc_InitShake128x4
+    \sa wc_Shake128x4_Absorb
+*/
+int wc_Shake128x4_SqueezeBlocks(wc_Shakex4* shake, byte* const* out,
+    word32 blockCnt);
+
+/*!
+    \ingroup SHA
+
+    \brief Disposes of the state of the four SHAKE128 operations.
+
+    \return none No returns.
+
+    \param shake pointer to the four-way shake structure
+
+    _Example_
+    \code
+    wc_Shakex4 shake[1];
+
+    if ((ret = wc_InitShake128x4(shake, NULL, INVALID_DEVID)) == 0) {
+        wc_Shake128x4_Absorb(shake, data, len);
+        wc_Shake128x4_SqueezeBlocks(shake, out, 1);
+        wc_Shake128x4_Free(shake);
+    }
+    \endcode
+
+    \sa wc_InitShake128x4
+*/
+void wc_Shake128x4_Free(wc_Shakex4* shake);
+
 /*!
     \ingroup SHA
 
@@ -1247,4 +1376,133 @@ int wc_Shake256_GetHash(wc_Shake* shake, byte* hash);
 */
 int wc_Shake256_Copy(wc_Shake* shake, wc_Shake* dst);
 
+/*!
+    \ingroup SHA
+
+    \brief This function initializes four SHAKE256 operations that are
+    performed in parallel. Each operation must absorb the same length of data.
+    Uses AVX2 when available on the CPU.
+
+    \return 0 Returned upon successfully initializing.
+    \return BAD_FUNC_ARG Returned when shake is NULL.
+
+    \param shake pointer to the four-way shake structure to initialize
+    \param heap pointer to a heap hint for dynamic memory allocation
+    \param devId device identifier - unused
+
+    _Example_
+    \code
+    wc_Shakex4 shake[1];
+    const byte* data[4] = { data0, data1, data2, data3 };
+    byte* out[4] = { out0, out1, out2, out3 };
+
+    if ((ret = wc_InitShake256x4(shake, NULL, INVALID_DEVID)) != 0) {
+       WOLFSSL_MSG("wc_InitShake256x4 failed");
+    }
+    else {
+       wc_Shake256x4_Absorb(shake, data, len);
+       wc_Shake256x4_SqueezeBlocks(shake, out, 2);
+       wc_Shake256x4_Free(shake);
+    }
+    \endcode
+
+    \sa wc_Shake256x4_Absorb
+    \sa wc_Shake256x4_SqueezeBlocks
+    \sa wc_Shake256x4_Free
+*/
+int wc_InitShake256x4(wc_Shakex4* shake, void* heap, int devId);
+
+/*!
+    \ingroup SHA
+
+    \brief Absorb the same length of data into each of the four SHAKE256
+    operations. Can only be called once per initialization.
+
+    \return 0 Returned upon successfully absorbing the data.
+    \return BAD_FUNC_ARG Returned when shake or data is NULL, or when a data
+    pointer is NULL and len is not 0.
+
+    \param shake pointer to the four-way shake structure
+    \param data array of four pointers to data to absorb
+    \param len length of each of the four data in bytes
+
+    _Example_
+    \code
+    wc_Shakex4 shake[1];
+    const byte* data[4] = { data0, data1, data2, data3 };
+
+    if ((ret = wc_InitShake256x4(shake, NULL, INVALID_DEVID)) != 0) {
+       WOLFSSL_MSG("wc_InitShake256x4 failed");
+    }
+    else {
+       wc_Shake256x4_Absorb(shake, data, len);
+    }
+    \endcode
+
+    \sa wc_InitShake256x4
+    \sa wc_Shake256x4_SqueezeBlocks
+*/
+int wc_Shake256x4_Absorb(wc_Shakex4* shake, const byte* const* data,
+    word32 len);
+
+/*!
+    \ingroup SHA
+
+    \brief Squeeze out more blocks of data from each of the four SHAKE256
+    operations. Can be called incrementally.
+
+    \return 0 Returned upon successfully squeezing.
+    \return BAD_FUNC_ARG Returned when shake or out is NULL, or when an
+    output pointer is NULL and blockCnt is not 0.
+
+    \param shake pointer to the four-way shake structure
+    \param out array of four output buffers
+    \param blockCnt Number of blocks to squeeze into each buffer. Each block
+    is WC_SHA3_256_BLOCK_SIZE bytes in length.
+
+    _Example_
+    \code
+    wc_Shakex4 shake[1];
+    const byte* data[4] = { data0, data1, data2, data3 };
+    byte* out[4] = { out0, out1, out2, out3 };
+
+    if ((ret = wc_InitShake256x4(shake, NULL, INVALID_DEVID)) != 0) {
+       WOLFSSL_MSG("wc_InitShake256x4 failed");
+    }
+    else {
+       wc_Shake256x4_Absorb(shake, data, len);
+       wc_Shake256x4_SqueezeBlocks(shake, out, 2);
+    }
+    \endcode
+
+    \sa wc_InitShake256x4
+    \sa wc_Shake256x4_Absorb
+*/
+int wc_Shake256x4_SqueezeBlocks(wc_Shakex4* shake, byte* const* out,
+    word32 blockCnt);
+
+/*!
+    \ingroup SHA
+
+    \brief Disposes of the state of the four SHAKE256 operations.
+
+    \return none No returns.
+
+    \param shake pointer to the four-way shake structure
+
+    _Example_
+    \code
+    wc_Shakex4 shake[1];
+
+    if ((ret = wc_InitShake256x4(shake, NULL, INVALID_DEVID)) == 0) {
+        wc_Shake256x4_Absorb(shake, data, len);
+        wc_Shake256x4_SqueezeBlocks(shake, out, 1);
+        wc_Shake256x4_Free(shake);
+    }
+    \endcode
+
+    \sa wc_InitShake256x4
+*/
+void wc_Shake256x4_Free(wc_Shakex4* shake);
+
 
@@ -2245,6 +2245,84 @@ int  wolfSSL_read(WOLFSSL* ssl, void* data, int sz);
 */
 int  wolfSSL_peek(WOLFSSL* ssl, void* data, int sz);
 
+/*!
+    \ingroup IO
+
+    \brief This function reads application data like wolfSSL_read() but
+    does not copy it. The record is decrypted in place in the internal
+    receive buffer and data is set to point at the plaintext. At most sz
+    bytes, and never more than what remains of the current record, are
+    returned. The plaintext is not consumed: the application calls
+    wolfSSL_read_zc_release() with the number of bytes it processed. Bytes
+    not released are returned again by the next read. The pointer stays
+    valid until wolfSSL_read_zc_release() is called and must not be held
+    across a wolfSSL_read() or wolfSSL_peek() call. Calling wolfSSL_read_zc()
+    again returns the same data. wolfSSL_write() may be called while the data
+    is held.
+
+    \return >0 the number of plaintext bytes available at data.
+    \return 0 when the peer closed the connection. Call wolfSSL_get_error()
+    for the specific error code.
+    \return SSL_FATAL_ERROR will be returned upon failure, including
+    SSL_ERROR_WANT_READ or SSL_ERROR_WANT_WRITE with non-blocking sockets.
+    Use wolfSSL_get_error() to get a specific error code.
+    \return BAD_FUNC_ARG when ssl or data is NULL or sz is negative.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param data set to the start of the decrypted data.
+    \param sz maximum number of bytes to return.
+
+    _Example_
+    \code
+    WOLFSSL* ssl = 0;
+    const unsigned char* data;
+    int sz;
+    ...
+    sz = wolfSSL_read_zc(ssl, &data, 16384);
+    if (sz > 0) {
+        // process “sz” bytes at “data”
+        wolfSSL_read_zc_release(ssl, sz);
+    }
+    \endcode
+
+    \sa wolfSSL_read_zc_release
+    \sa wolfSSL_read
+*/
+int  wolfSSL_read_zc(WOLFSSL* ssl, const unsigned char** data, int sz);
+
+/*!
+    \ingroup IO
+
+    \brief This function consumes application data returned by
+    wolfSSL_read_zc(). Once all plaintext of a record is released, the
+    internal receive buffer may be reused or shrunk.
+
+    \return SSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ssl is NULL, or sz is negative or more than
+    the amount of plaintext pending.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param sz number of bytes processed by the application.
+
+    _Example_
+    \code
+    WOLFSSL* ssl = 0;
+    const unsigned char* data;
+    int sz;
+    ...
+    sz = wolfSSL_read_zc(ssl, &data, 16384);
+    if (sz > 0) {
+        // process data
+        if (wolfSSL_read_zc_release(ssl, sz) != SSL_SUCCESS) {
+            // failed to release data
+        }
+    }
+    \endcode
+
+    \sa wolfSSL_read_zc
+*/
+int  wolfSSL_read_zc_release(WOLFSSL* ssl, int sz);
+
 /*!
     \ingroup IO
 
@@ -3313,6 +3391,62 @@ int  wolfSSL_memrestore_session_cache(const void* mem, int sz);
 */
 int  wolfSSL_get_session_cache_memsize(void);
 
+/*!
+    \ingroup IO
+
+    \brief This function moves the global session cache into anonymous
+    shared memory so that server processes forked afterwards store and
+    resume sessions from one cache. Call it once in the parent after
+    wolfSSL_Init() and before forking workers. Cached sessions keep process
+    local pointers, so only processes forked from the caller may share the
+    cache. The cache size set with wolfSSL_CTX_sess_set_cache_size() and the
+    session statistics are kept in the shared memory too, so all processes
+    see the same values. Requires SESSION_CACHE_SHARED_MEM.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_STATE_E if the shared cache is already in use.
+    \return MEMORY_E if the shared mapping could not be created.
+    \return BAD_MUTEX_E if the process shared locks could not be set up.
+
+    \param none No parameters.
+
+    _Example_
+    \code
+    wolfSSL_Init();
+    if (wolfSSL_use_shared_session_cache() != WOLFSSL_SUCCESS) {
+        // Fall back to a per process cache
+    }
+    // fork() worker processes
+    \endcode
+
+    \sa wolfSSL_get_session_stats
+    \sa wolfSSL_release_shared_session_cache
+*/
+int  wolfSSL_use_shared_session_cache(void);
+
+/*!
+    \ingroup IO
+
+    \brief This function stops this process using the shared session cache
+    set up with wolfSSL_use_shared_session_cache() and goes back to the
+    process local cache. Other processes keep using the shared cache. Must
+    not be called while other threads use the session cache. Called by
+    wolfSSL_Cleanup(). Requires SESSION_CACHE_SHARED_MEM.
+
+    \return WOLFSSL_SUCCESS always.
+
+    \param none No parameters.
+
+    _Example_
+    \code
+    // Worker process leaving the pool of shared cache users
+    wolfSSL_release_shared_session_cache();
+    \endcode
+
+    \sa wolfSSL_use_shared_session_cache
+*/
+int  wolfSSL_release_shared_session_cache(void);
+
 /*!
     \ingroup CertsKeys
 
@@ -6274,6 +6408,61 @@ int wolfSSL_set_timeout(WOLFSSL* ssl, unsigned int to);
 */
 int wolfSSL_CTX_set_timeout(WOLFSSL_CTX* ctx, unsigned int to);
 
+/*!
+    \ingroup Setup
+
+    \brief This function sets the number of sessions the internal session
+    cache holds. The session cache is global: the size applies to every
+    WOLFSSL_CTX, not only to ctx, and ctx may be NULL. The size is rounded up
+    to a whole number of sessions per row and is limited to the maximum set at
+    compile time (see TITAN_SESSION_CACHE and the other session cache size
+    options). Cached sessions in slots no longer used are evicted.
+
+    \return the previous cache size.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    Not used.
+    \param sz number of sessions to cache. Values of 0 or less leave the size
+    unchanged.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    // Limit the cache of all contexts to about 1000 sessions.
+    (void)wolfSSL_CTX_sess_set_cache_size(ctx, 1000);
+    \endcode
+
+    \sa wolfSSL_CTX_sess_get_cache_size
+    \sa wolfSSL_get_session_cache_stats
+*/
+long wolfSSL_CTX_sess_set_cache_size(WOLFSSL_CTX* ctx, long sz);
+
+/*!
+    \ingroup Setup
+
+    \brief This function returns the number of sessions the internal session
+    cache holds. The session cache is global so the value is the same for
+    every WOLFSSL_CTX.
+
+    \return the number of sessions the cache holds.
+    \return 0 when the session cache is not compiled in.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    Not used.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    long sz;
+    ...
+    sz = wolfSSL_CTX_sess_get_cache_size(ctx);
+    \endcode
+
+    \sa wolfSSL_CTX_sess_set_cache_size
+*/
+long wolfSSL_CTX_sess_get_cache_size(WOLFSSL_CTX* ctx);
+
 /*!
     \ingroup openSSL
 
@@ -7538,19 +7727,22 @@ int wolfSSL_make_eap_keys(WOLFSSL* ssl, void* key, unsigned int len,
 /*!
     \ingroup IO
 
-    \brief Simulates writev semantics but doesn’t actually do block at a time
-    because of SSL_write() behavior and because front adds may be small.
-    Makes porting into software that uses writev easier.
+    \brief Writes the data of all the I/O vectors as if they were one buffer
+    passed to wolfSSL_write(). Records are built from the vectors directly,
+    without first copying the data into one buffer, and a record may span
+    vectors. Makes porting into software that uses writev easier.
 
     \return >0 the number of bytes written upon success.
     \return 0 will be returned upon failure.  Call wolfSSL_get_error() for
     the specific error code.
-    \return MEMORY_ERROR will be returned if a memory error was encountered.
+    \return BAD_FUNC_ARG when ssl or iov is NULL, iovcnt is negative, a
+    vector with a non-zero length has a NULL base or the total length does
+    not fit in an int.
     \return SSL_FATAL_ERROR will be returned upon failure when either an error
     occurred or, when using non-blocking sockets, the SSL_ERROR_WANT_READ or
     SSL_ERROR_WANT_WRITE error was received and and the application needs to
-    call wolfSSL_write() again.  Use wolfSSL_get_error() to get a specific
-    error code.
+    call wolfSSL_writev() again with the same vectors.  Use wolfSSL_get_error()
+    to get a specific error code.
 
     \param ssl pointer to the SSL session, created with wolfSSL_new().
     \param iov array of I/O vectors to write
@@ -7579,6 +7771,408 @@ int wolfSSL_make_eap_keys(WOLFSSL* ssl, void* key, unsigned int len,
 int wolfSSL_writev(WOLFSSL* ssl, const struct iovec* iov,
                                      int iovcnt);
 
+/*!
+    \ingroup IO
+
+    \brief Offloads record protection to the Linux kernel (kTLS) once the
+    handshake is complete. The negotiated keys, IVs and sequence numbers are
+    given to the kernel for the directions requested. Afterwards
+    wolfSSL_write() and wolfSSL_read() pass plain text through the socket and
+    the application may also use sendfile() or splice() on the socket.
+    Available when wolfSSL is built with --enable-ktls (WOLFSSL_KTLS).
+    Supported are TLS 1.2 and TLS 1.3 with AES-128-GCM, AES-256-GCM and
+    ChaCha20-Poly1305. TLS 1.3 KeyUpdate messages are handled by updating the
+    keys in the kernel. Renegotiation and post-handshake authentication are
+    not supported while offloaded.
+
+    \return SSL_SUCCESS on success or when the directions are already
+    offloaded.
+    \return BAD_FUNC_ARG when ssl is NULL or dir is not a combination of
+    WOLFSSL_KTLS_TX and WOLFSSL_KTLS_RX.
+    \return BAD_STATE_E when the handshake is not done, the connection is DTLS
+    or QUIC, I/O callbacks other than the built-in socket ones are set or data
+    is buffered in a direction to offload.
+    \return UNSUPPORTED_SUITE when the protocol version or cipher suite can't
+    be offloaded.
+    \return SOCKET_ERROR_E when the kernel doesn't support TLS or rejected the
+    keys.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param dir directions to offload: WOLFSSL_KTLS_TX and/or WOLFSSL_KTLS_RX.
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    ...
+    if (wolfSSL_connect(ssl) == SSL_SUCCESS &&
+            wolfSSL_EnableKTLS(ssl, WOLFSSL_KTLS_TX | WOLFSSL_KTLS_RX) ==
+            SSL_SUCCESS) {
+        // records now encrypted by the kernel
+        sendfile(wolfSSL_get_fd(ssl), fileFd, NULL, fileSz);
+    }
+    \endcode
+
+    \sa wolfSSL_GetKTLS
+    \sa wolfSSL_set_fd
+*/
+int wolfSSL_EnableKTLS(WOLFSSL* ssl, int dir);
+
+/*!
+    \ingroup IO
+
+    \brief Gets the directions of record protection that have been offloaded
+    to the Linux kernel with wolfSSL_EnableKTLS().
+
+    \return WOLFSSL_KTLS_TX and/or WOLFSSL_KTLS_RX bits.
+    \return 0 when nothing is offloaded or ssl is NULL.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    ...
+    if (wolfSSL_GetKTLS(ssl) & WOLFSSL_KTLS_TX) {
+        // may use sendfile() on the socket
+    }
+    \endcode
+
+    \sa wolfSSL_EnableKTLS
+*/
+int wolfSSL_GetKTLS(WOLFSSL* ssl);
+
+/*!
+    \ingroup IO
+
+    \brief Writes a vector of application messages, each in its own DTLS
+    record. The datagrams of all the messages are handed to the kernel with
+    sendmmsg(), up to WOLFSSL_DTLS_MMSG_CNT at a time. Datagrams that can't be
+    written without blocking stay queued and are written before the next
+    datagram - call with a cnt of 0 to retry writing them. Requires the
+    built-in socket I/O callbacks and WOLFSSL_DTLS_MMSG (--enable-dtls-mmsg).
+
+    \return count the number of messages written.
+    \return BAD_FUNC_ARG when ssl is NULL, msgs is NULL and cnt is not 0,
+    cnt is negative or ssl is not a DTLS session.
+    \return BAD_STATE_E when the built-in I/O callbacks are not used.
+    \return MEMORY_E when allocating the queue fails.
+    \return SSL_FATAL_ERROR when no message was written or, with a cnt of 0,
+    the queued datagrams were not all written. Call wolfSSL_get_error() for
+    the reason.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param msgs array of messages to write. May be NULL when cnt is 0.
+    \param cnt number of messages in msgs.
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    struct iovec msgs[2];
+    msgs[0].iov_base = "hello"; msgs[0].iov_len = 5;
+    msgs[1].iov_base = "world"; msgs[1].iov_len = 5;
+    if (wolfSSL_dtls_write_batch(ssl, msgs, 2) != 2) {
+        // not all messages written
+    }
+    \endcode
+
+    \sa wolfSSL_dtls_read_batch
+    \sa wolfSSL_write
+*/
+int wolfSSL_dtls_write_batch(WOLFSSL* ssl, const struct iovec* msgs, int cnt);
+
+/*!
+    \ingroup IO
+
+    \brief Reads a vector of application messages, each from its own DTLS
+    record. Only the first message is waited for, as with wolfSSL_read().
+    Up to WOLFSSL_DTLS_MMSG_CNT datagrams are received with a single
+    recvmmsg() call and further messages are read only from the datagrams
+    already received. On return, the iov_len of each element read holds the
+    length of its message. Requires the built-in socket I/O callbacks and
+    WOLFSSL_DTLS_MMSG (--enable-dtls-mmsg).
+
+    \return count the number of messages read.
+    \return BAD_FUNC_ARG when ssl or msgs is NULL, cnt is negative or ssl is
+    not a DTLS session.
+    \return BAD_STATE_E when the built-in I/O callbacks are not used.
+    \return 0 or SSL_FATAL_ERROR when no message was read. Call
+    wolfSSL_get_error() for the reason.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param msgs array of buffers to read messages into.
+    \param cnt number of buffers in msgs.
+
+    _Example_
+    \code
+    WOLFSSL* ssl;
+    char bufs[8][1500];
+    struct iovec msgs[8];
+    int i, n;
+    for (i = 0; i < 8; i++) {
+        msgs[i].iov_base = bufs[i];
+        msgs[i].iov_len = sizeof(bufs[i]);
+    }
+    n = wolfSSL_dtls_read_batch(ssl, msgs, 8);
+    for (i = 0; i < n; i++) {
+        // msgs[i].iov_len bytes of message i in bufs[i]
+    }
+    \endcode
+
+    \sa wolfSSL_dtls_write_batch
+    \sa wolfSSL_read
+*/
+int wolfSSL_dtls_read_batch(WOLFSSL* ssl, struct iovec* msgs, int cnt);
+
+/*!
+    \ingroup Setup
+
+    \brief Sets the number of idle record buffers kept by the record pool.
+    Available when wolfSSL is compiled with WOLFSSL_RECORD_POOL
+    (--enable-record-pool). Connections borrow a buffer of
+    WOLFSSL_RECORD_POOL_BUF_SZ bytes from the pool only while a record is
+    being read or written, and give it back when done. Up to maxIdle given
+    back buffers are kept for reuse and the rest are freed. Idle buffers over
+    the new limit are freed immediately. The default is
+    WOLFSSL_RECORD_POOL_MAX_IDLE.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_STATE_E when wolfSSL_Init() has not been called.
+    \return BAD_MUTEX_E when locking the pool fails.
+
+    \param maxIdle maximum number of idle buffers to keep.
+
+    _Example_
+    \code
+    wolfSSL_Init();
+    // Keep enough buffers for the connections expected to be active at once
+    wolfSSL_RecordPool_SetMaxIdle(1024);
+    \endcode
+
+    \sa wolfSSL_RecordPool_GetStats
+*/
+int wolfSSL_RecordPool_SetMaxIdle(word32 maxIdle);
+
+/*!
+    \ingroup Setup
+
+    \brief Gets the statistics of the record pool: the buffers currently lent
+    to connections, the idle buffers kept for reuse, the most buffers lent at
+    one time, and the number of buffers allocated from the heap.
+    Available when wolfSSL is compiled with WOLFSSL_RECORD_POOL.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when stats is NULL.
+    \return BAD_STATE_E when wolfSSL_Init() has not been called.
+    \return BAD_MUTEX_E when locking the pool fails.
+
+    \param stats structure to fill with the statistics.
+
+    _Example_
+    \code
+    WOLFSSL_RECORD_POOL_STATS stats;
+
+    if (wolfSSL_RecordPool_GetStats(&stats) == WOLFSSL_SUCCESS) {
+        printf("Record buffers: %u in use, %u idle, peak %u\n", stats.inUse,
+            stats.idle, stats.peakInUse);
+    }
+    \endcode
+
+    \sa wolfSSL_RecordPool_SetMaxIdle
+*/
+int wolfSSL_RecordPool_GetStats(WOLFSSL_RECORD_POOL_STATS* stats);
+
+/*!
+    \ingroup Setup
+
+    \brief Sets the number of single-use TLS 1.3 key shares of a named group
+    to keep pregenerated for the context. Available when wolfSSL is compiled
+    with WOLFSSL_KEY_SHARE_POOL (--enable-key-share-pool). Handshakes on
+    objects of the context take a ready key share from the pool instead of
+    generating one. When the pool is empty the key share is generated as
+    normal. Key shares are generated by wolfSSL_CTX_KeySharePool_Fill().
+    A server needs no key pair for ML-KEM groups as it encapsulates; for
+    hybrid groups pool the ECC group instead. A depth of 0 stops pooling the
+    group and frees its key shares.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ctx is NULL, the group is not supported or too
+    many groups are pooled.
+    \return MEMORY_E when dynamic memory allocation fails.
+    \return BAD_MUTEX_E when locking the pool fails.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created with
+    wolfSSL_CTX_new().
+    \param group a key exchange group identifier.
+    \param depth number of key shares to keep ready.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    ...
+    wolfSSL_CTX_KeySharePool_Set(ctx, WOLFSSL_ECC_X25519, 64);
+    wolfSSL_CTX_KeySharePool_Set(ctx, WOLFSSL_ECC_SECP256R1, 16);
+    wolfSSL_CTX_KeySharePool_Fill(ctx, 0);
+    \endcode
+
+    \sa wolfSSL_CTX_KeySharePool_Fill
+    \sa wolfSSL_CTX_KeySharePool_GetStats
+    \sa wolfSSL_UseKeyShare
+*/
+int wolfSSL_CTX_KeySharePool_Set(WOLFSSL_CTX* ctx, word16 group,
+                                 word16 depth);
+
+/*!
+    \ingroup Setup
+
+    \brief Generates key shares for the pooled groups of the context that
+    are below their depth. Groups are refilled in turn. Call from a
+    background thread or when the application is idle so that key generation
+    is kept off the handshake path. It is safe to call while handshakes take
+    key shares from the pool. A temporary WOLFSSL object is created to
+    provide the random number generator and callbacks of the context.
+
+    \return the number of key shares generated on success.
+    \return BAD_FUNC_ARG when ctx is NULL.
+    \return MEMORY_E when dynamic memory allocation fails.
+    \return BAD_MUTEX_E when locking the pool fails.
+    \return other negative value when key generation fails.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created with
+    wolfSSL_CTX_new().
+    \param maxKeys the most key shares to generate in this call. 0 to
+    generate until all pools are full.
+
+    _Example_
+    \code
+    static void* refill_thread(void* arg)
+    {
+        WOLFSSL_CTX* ctx = (WOLFSSL_CTX*)arg;
+        while (running) {
+            if (wolfSSL_CTX_KeySharePool_Fill(ctx, 0) == 0)
+                usleep(1000);
+        }
+        return NULL;
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_KeySharePool_Set
+    \sa wolfSSL_CTX_KeySharePool_GetStats
+*/
+int wolfSSL_CTX_KeySharePool_Fill(WOLFSSL_CTX* ctx, word32 maxKeys);
+
+/*!
+    \ingroup Setup
+
+    \brief Gets the statistics of the context's pool of pregenerated key
+    shares: the number ready in all groups, the number taken by handshakes,
+    the number of handshakes that found their group's pool empty, and the
+    number generated to fill the pool.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ctx or stats is NULL.
+    \return BAD_MUTEX_E when locking the pool fails.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created with
+    wolfSSL_CTX_new().
+    \param stats structure to fill with the statistics.
+
+    _Example_
+    \code
+    WOLFSSL_KEY_SHARE_POOL_STATS stats;
+
+    if (wolfSSL_CTX_KeySharePool_GetStats(ctx, &stats) == WOLFSSL_SUCCESS) {
+        printf("Key shares: %u ready, %u hits, %u misses\n", stats.ready,
+            stats.hits, stats.misses);
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_KeySharePool_Set
+    \sa wolfSSL_CTX_KeySharePool_Fill
+*/
+int wolfSSL_CTX_KeySharePool_GetStats(WOLFSSL_CTX* ctx,
+                                      WOLFSSL_KEY_SHARE_POOL_STATS* stats);
+
+/*!
+    \ingroup Setup
+
+    \brief Gets the statistics of the context's cache of decoded private key
+    objects: the number of decoded keys idle in the cache, the number of
+    handshakes that took a decoded key from the cache, and the number of
+    handshakes that had to decode the private key.
+    Available with WOLFSSL_PRIV_KEY_CACHE.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ctx or stats is NULL.
+    \return BAD_MUTEX_E when locking the cache fails.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created with
+    wolfSSL_CTX_new().
+    \param stats structure to fill with the statistics.
+
+    _Example_
+    \code
+    WOLFSSL_PRIV_KEY_CACHE_STATS stats;
+
+    if (wolfSSL_CTX_PrivKeyCache_GetStats(ctx, &stats) == WOLFSSL_SUCCESS) {
+        printf("Private keys: %u ready, %u hits, %u misses\n", stats.ready,
+            stats.hits, stats.misses);
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_use_PrivateKey_file
+*/
+int wolfSSL_CTX_PrivKeyCache_GetStats(WOLFSSL_CTX* ctx,
+                                      WOLFSSL_PRIV_KEY_CACHE_STATS* stats);
+
+/*!
+    \ingroup Setup
+
+    \brief Adds a TLS 1.3 certificate compression algorithm (RFC 8879) to
+    the context. A client offers the algorithms it has a decompression
+    callback for. A server sends its certificate chain in a
+    CompressedCertificate message using the first algorithm added that it
+    has a compression callback for and the client offered. The compressed
+    chain is cached in the context and only recompressed when the
+    Certificate message changes. Adding an algorithm again replaces its
+    callbacks. Client certificates are not compressed and compression is not
+    used with DTLS. Requires WOLFSSL_CERT_COMPRESSION.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ctx is NULL, alg is 0 or both callbacks are
+    NULL and there is no built-in support for the algorithm.
+    \return BUFFER_E when WOLFSSL_CERT_COMP_MAX_ALGS algorithms are already
+    added.
+    \return MEMORY_E when allocating memory fails.
+    \return BAD_MUTEX_E when a mutex operation fails.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created with
+    wolfSSL_CTX_new().
+    \param alg the CertificateCompressionAlgorithm: WOLFSSL_CERT_COMP_ZLIB,
+    WOLFSSL_CERT_COMP_BROTLI or WOLFSSL_CERT_COMP_ZSTD.
+    \param compressCb callback compressing the Certificate message. Returns
+    the number of bytes written to out or a negative error. NULL when only
+    decompressing.
+    \param decompressCb callback decompressing the peer's Certificate
+    message. Returns the number of bytes written to out or a negative error.
+    NULL when only compressing. When both callbacks are NULL and alg is
+    WOLFSSL_CERT_COMP_ZLIB, the built-in zlib support (HAVE_LIBZ) is used.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new(wolfTLSv1_3_server_method());
+
+    if (wolfSSL_CTX_AddCertCompression(ctx, WOLFSSL_CERT_COMP_ZLIB, NULL,
+            NULL) != WOLFSSL_SUCCESS) {
+        // zlib certificate compression not available
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_new
+*/
+int wolfSSL_CTX_AddCertCompression(WOLFSSL_CTX* ctx, word16 alg,
+                                   CallbackCertCompress compressCb,
+                                   CallbackCertDecompress decompressCb);
+
 /*!
     \ingroup Setup
 
@@ -9790,6 +10384,76 @@ int wolfSSL_CertManagerVerifyBuffer(WOLFSSL_CERT_MANAGER* cm,
 void wolfSSL_CertManagerSetVerify(WOLFSSL_CERT_MANAGER* cm,
                                                              VerifyCallback vc);
 
+/*!
+    \ingroup CertManager
+    \brief Enables caching of certificate signature verification results in
+    the Certificate Manager. When a certificate is verified again with the
+    same CA public key, the signature check is skipped. Only the signature
+    check is cached - the certificate is still fully decoded and the cache is
+    keyed by a SHA-256 digest of the signed data, signature and CA public key.
+    All other checks, including validity dates and revocation, are still
+    performed. Results are kept for timeout seconds. Changing the size discards cached results.
+    Requires WOLFSSL_CERT_VERIFY_CACHE (--enable-cert-verify-cache). Call
+    before the Certificate Manager is used to verify certificates.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if cm is NULL.
+    \return MEMORY_E if dynamic memory allocation fails.
+    \return BAD_MUTEX_E if initializing the mutex fails.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure, created using
+    wolfSSL_CertManagerNew().
+    \param sz number of results to cache. 0 disables the cache.
+    \param timeout seconds to keep a result. 0 uses
+    WOLFSSL_CERT_VERIFY_CACHE_TIMEOUT.
+
+    _Example_
+    \code
+    #include <wolfssl/ssl.h>
+
+    WOLFSSL_CERT_MANAGER* cm = wolfSSL_CertManagerNew();
+    ...
+    if (wolfSSL_CertManagerSetVerifyCache(cm, 1024, 600) != WOLFSSL_SUCCESS) {
+        // error enabling cache
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerGetVerifyCacheStats
+    \sa wolfSSL_CertManagerVerifyBuffer
+*/
+int wolfSSL_CertManagerSetVerifyCache(WOLFSSL_CERT_MANAGER* cm, word32 sz,
+    word32 timeout);
+
+/*!
+    \ingroup CertManager
+    \brief Gets the statistics of the certificate signature verification
+    cache: the number of signature checks skipped (hits) and performed
+    (misses), the number of results cached and the number of results dropped
+    to make room.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG if cm or stats is NULL.
+    \return BAD_STATE_E if the cache is not enabled.
+    \return BAD_MUTEX_E if locking the cache fails.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param stats a pointer to the structure to fill.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_VERIFY_CACHE_STATS stats;
+
+    if (wolfSSL_CertManagerGetVerifyCacheStats(cm, &stats) ==
+            WOLFSSL_SUCCESS) {
+        printf("hits: %u, misses: %u\n", stats.hits, stats.misses);
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerSetVerifyCache
+*/
+int wolfSSL_CertManagerGetVerifyCacheStats(WOLFSSL_CERT_MANAGER* cm,
+    WOLFSSL_CERT_VERIFY_CACHE_STATS* stats);
+
 /*!
     \brief Check CRL if the option is enabled and compares the cert to the
     CRL list.
@@ -9972,6 +10636,182 @@ int wolfSSL_CertManagerLoadCRLBuffer(WOLFSSL_CERT_MANAGER* cm,
                                      const unsigned char* buff, long sz,
                                      int type);
 
+/*!
+    \ingroup CertManager
+    \brief Sets the key used to authenticate compiled CRLs. A compiled CRL
+    is tagged with an HMAC-SHA256 using this key when compiled and is only
+    loaded when the tag matches, so that anyone able to write a compiled CRL
+    file can't remove revoked certificates from it. The key is not stored in
+    the compiled CRL and must be kept secret from those able to write the
+    file. The same key must be set when compiling and when loading. Available
+    when wolfSSL is built with WOLFSSL_CRL_COMPILED (--enable-crl-compiled).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when cm or key is NULL or keySz is less than
+    WOLFSSL_CRL_COMPILED_MIN_KEY_SZ (default 16) or more than 64.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param key buffer holding the key.
+    \param keySz size of the key in bytes.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm;
+    unsigned char key[32];
+    ...
+    if (wolfSSL_CertManagerSetCompiledCRLKey(cm, key, sizeof(key)) !=
+            WOLFSSL_SUCCESS) {
+        // failed to set key
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerCompileCRL
+    \sa wolfSSL_CertManagerLoadCompiledCRL
+    \sa wolfSSL_CertManagerLoadCompiledCRLFile
+*/
+int wolfSSL_CertManagerSetCompiledCRLKey(WOLFSSL_CERT_MANAGER* cm,
+    const unsigned char* key, word32 keySz);
+
+/*!
+    \ingroup CertManager
+    \brief Verifies a CRL with the CAs loaded into the certificate manager
+    and compiles it into a flat, sorted and position independent form. The
+    compiled CRL is loaded with wolfSSL_CertManagerLoadCompiledCRL() or
+    wolfSSL_CertManagerLoadCompiledCRLFile() and searched in place without
+    parsing or per entry allocation. Only the serial numbers and dates needed
+    for revocation checking are kept. The compiled CRL is authenticated with
+    the key set by wolfSSL_CertManagerSetCompiledCRLKey(). Available when
+    wolfSSL is built with WOLFSSL_CRL_COMPILED (--enable-crl-compiled).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return LENGTH_ONLY_E when out is NULL. outSz is set to the size needed.
+    \return BAD_STATE_E when no compiled CRL key is set.
+    \return BUFFER_E when out is too small.
+    \return BAD_FUNC_ARG when cm, buff or outSz is NULL or sz is not positive.
+    \return Other negative value when the CRL fails to parse or verify.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure holding the CAs.
+    \param buff buffer holding the CRL.
+    \param sz size of the CRL in bytes.
+    \param type format of the CRL: WOLFSSL_FILETYPE_ASN1 or
+    WOLFSSL_FILETYPE_PEM.
+    \param out buffer to hold the compiled CRL. May be NULL to get size.
+    \param outSz on input, size of out in bytes. On output, size of the
+    compiled CRL in bytes.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm;
+    const unsigned char* crl;
+    long crlSz;
+    unsigned char* out;
+    word32 outSz;
+    ...
+    if (wolfSSL_CertManagerCompileCRL(cm, crl, crlSz, WOLFSSL_FILETYPE_PEM,
+            NULL, &outSz) != LENGTH_ONLY_E) {
+        // failed to verify CRL
+    }
+    out = (unsigned char*)malloc(outSz);
+    if (wolfSSL_CertManagerCompileCRL(cm, crl, crlSz, WOLFSSL_FILETYPE_PEM,
+            out, &outSz) != WOLFSSL_SUCCESS) {
+        // failed to compile CRL
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerSetCompiledCRLKey
+    \sa wolfSSL_CertManagerLoadCompiledCRL
+    \sa wolfSSL_CertManagerLoadCompiledCRLFile
+*/
+int wolfSSL_CertManagerCompileCRL(WOLFSSL_CERT_MANAGER* cm,
+    const unsigned char* buff, long sz, int type, unsigned char* out,
+    word32* outSz);
+
+/*!
+    \ingroup CertManager
+    \brief Loads a CRL compiled by wolfSSL_CertManagerCompileCRL() and
+    enables CRL checking if not already enabled. The buffer is used in place
+    and must remain valid until it is replaced or the certificate manager is
+    freed. Loading a compiled CRL for an issuer that already has one swaps the
+    pointer to the new data - the previous buffer may be freed once this
+    function returns. The CRL was verified when compiled and is not verified
+    again. Instead the HMAC-SHA256, keyed with the key set by
+    wolfSSL_CertManagerSetCompiledCRLKey(), is checked and the issuer must be
+    a CA loaded into the certificate manager. The ordering of the records is
+    also checked.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when cm or buff is NULL or sz is out of range.
+    \return BAD_STATE_E when no compiled CRL key is set.
+    \return ASN_PARSE_E when buff is not a compiled CRL for this build or the
+    records are not in order.
+    \return ASN_CRL_CONFIRM_E when the HMAC of the compiled data doesn't
+    match.
+    \return ASN_CRL_NO_SIGNER_E when the issuer is not a loaded CA.
+    \return WOLFSSL_FATAL_ERROR when enabling CRL checking fails.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param buff buffer holding the compiled CRL.
+    \param sz size of the compiled CRL in bytes.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm;
+    const unsigned char* compiled;
+    long compiledSz;
+    ...
+    if (wolfSSL_CertManagerLoadCompiledCRL(cm, compiled, compiledSz) !=
+            WOLFSSL_SUCCESS) {
+        // failed to load compiled CRL
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerSetCompiledCRLKey
+    \sa wolfSSL_CertManagerCompileCRL
+    \sa wolfSSL_CertManagerLoadCompiledCRLFile
+*/
+int wolfSSL_CertManagerLoadCompiledCRL(WOLFSSL_CERT_MANAGER* cm,
+    const unsigned char* buff, long sz);
+
+/*!
+    \ingroup CertManager
+    \brief Maps a file holding a CRL compiled by
+    wolfSSL_CertManagerCompileCRL(), for example with the crl_compile example
+    program, into memory read-only and loads it. Loading a new file for the
+    same issuer swaps in the new mapping and unmaps the old one. Write a
+    new file and rename it over the old one rather than modifying a file in
+    place. The file is checked as by wolfSSL_CertManagerLoadCompiledCRL().
+    Available when WOLFSSL_CRL_COMPILED_MMAP is defined.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when cm or file is NULL.
+    \return BAD_PATH_ERROR when the file can't be opened or is empty.
+    \return MEMORY_E when mapping the file fails.
+    \return ASN_PARSE_E when the file is not a compiled CRL for this build or
+    the records are not in order.
+    \return BAD_STATE_E when no compiled CRL key is set.
+    \return ASN_CRL_CONFIRM_E when the HMAC of the file data doesn't match.
+    \return ASN_CRL_NO_SIGNER_E when the issuer is not a loaded CA.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param file name of the compiled CRL file.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm;
+    ...
+    if (wolfSSL_CertManagerLoadCompiledCRLFile(cm, "/etc/crl/ca.wcrl") !=
+            WOLFSSL_SUCCESS) {
+        // failed to load compiled CRL
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerSetCompiledCRLKey
+    \sa wolfSSL_CertManagerCompileCRL
+    \sa wolfSSL_CertManagerLoadCompiledCRL
+*/
+int wolfSSL_CertManagerLoadCompiledCRLFile(WOLFSSL_CERT_MANAGER* cm,
+    const char* file);
+
 /*!
     \ingroup CertManager
     \brief This function sets the CRL Certificate Manager callback. If
@@ -10205,6 +11045,75 @@ int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER* cm,
                                   CbOCSPIO ioCb, CbOCSPRespFree respFreeCb,
                                   void* ioCbCtx);
 
+/*!
+    \ingroup CertManager
+    \brief This function sets the policy of the OCSP response cache and
+    starts a thread that refreshes responses in the background using the
+    OCSP I/O callback. A cached response is refreshed when it is used within
+    prefetch seconds of its nextUpdate. An expired response is used for up to
+    maxStale seconds after its nextUpdate while a new one is fetched - it is
+    never used for stapling. The least recently used response is evicted when
+    maxEntries responses are cached. Calling again changes the policy.
+    Available when wolfSSL is built with WOLFSSL_OCSP_CACHE_REFRESH
+    (--enable-ocsp-cache-refresh).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when cm is NULL or OCSP has not been enabled.
+    \return MEMORY_E when dynamic memory allocation fails.
+    \return THREAD_CREATE_E when the refresh thread can't be started.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param maxEntries maximum number of responses to cache. 0 for no limit.
+    \param prefetch seconds before nextUpdate to refresh a response.
+    \param maxStale seconds after nextUpdate to use a response while it is
+    refreshed. 0 to never use an expired response.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm;
+
+    wolfSSL_CertManagerEnableOCSP(cm, 0);
+    if (wolfSSL_CertManagerSetOCSPCache(cm, 1024, 3600, 86400) !=
+            WOLFSSL_SUCCESS) {
+        // failed to set OCSP cache policy
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerGetOCSPCacheStats
+    \sa wolfSSL_CertManagerEnableOCSP
+    \sa wolfSSL_CertManagerSetOCSP_Cb
+*/
+int wolfSSL_CertManagerSetOCSPCache(WOLFSSL_CERT_MANAGER* cm,
+    word32 maxEntries, word32 prefetch, word32 maxStale);
+
+/*!
+    \ingroup CertManager
+    \brief This function gets the statistics of the OCSP response cache:
+    lookups answered with current and expired responses, lookups that waited
+    on the responder, background refreshes that succeeded and failed, and the
+    number of responses evicted and currently cached.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when cm or stats is NULL or no cache policy is set.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param stats a pointer to a WOLFSSL_OCSP_CACHE_STATS to fill.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm;
+    WOLFSSL_OCSP_CACHE_STATS stats;
+
+    if (wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats) == WOLFSSL_SUCCESS) {
+        printf("hits: %u, stale: %u\n", stats.hits, stats.staleHits);
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerSetOCSPCache
+*/
+int wolfSSL_CertManagerGetOCSPCacheStats(WOLFSSL_CERT_MANAGER* cm,
+    WOLFSSL_OCSP_CACHE_STATS* stats);
+
 /*!
     \ingroup CertManager
     \brief This function turns on OCSP stapling if it is not turned on as well
@@ -10771,6 +11680,73 @@ int wolfSSL_CTX_SetOCSP_Cb(WOLFSSL_CTX* ctx,
 */
 int wolfSSL_CTX_EnableOCSPStapling(WOLFSSL_CTX*);
 
+/*!
+    \ingroup CertsKeys
+    \brief This function enables a cache of the OCSP responses to staple for
+    the certificate and chain loaded into the context. A thread fetches the
+    responses using the OCSP I/O callback and refreshes them half way through
+    their validity, or after interval seconds when not zero. Handshakes
+    staple the cached response without contacting the responder. An SSL
+    object with its own certificate or an expired cached response falls back
+    to fetching the response during the handshake. Call again after changing
+    the certificate or chain. Available when wolfSSL is built with
+    WOLFSSL_OCSP_STAPLE_CACHE (--enable-ocsp-staple-cache).
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ctx is NULL or OCSP stapling is not enabled.
+    \return MEMORY_E when dynamic memory allocation fails.
+    \return THREAD_CREATE_E when the refresh thread can't be started.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created using
+    wolfSSL_CTX_new().
+    \param interval maximum seconds between refreshes. 0 to refresh half way
+    through the validity of the responses.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+
+    wolfSSL_CTX_EnableOCSPStapling(ctx);
+    if (wolfSSL_CTX_EnableOCSPStapleCache(ctx, 0) != WOLFSSL_SUCCESS) {
+        // staple cache not enabled
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_RefreshOCSPStapleCache
+    \sa wolfSSL_CTX_EnableOCSPStapling
+    \sa wolfSSL_CTX_SetOCSP_Cb
+*/
+int wolfSSL_CTX_EnableOCSPStapleCache(WOLFSSL_CTX* ctx, word32 interval);
+
+/*!
+    \ingroup CertsKeys
+    \brief This function fetches the OCSP responses to staple for the context
+    now, blocking until the responder answers. Use after
+    wolfSSL_CTX_EnableOCSPStapleCache() to have a response ready before the
+    first handshake.
+
+    \return WOLFSSL_SUCCESS when a response for the certificate was fetched.
+    \return BAD_FUNC_ARG when ctx is NULL or the staple cache is not enabled.
+    \return OCSP_CERT_REVOKED or OCSP_CERT_UNKNOWN when the certificate's
+    status isn't good. Only responses with a good status are stapled.
+    \return Other negative value when fetching the response failed.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure, created using
+    wolfSSL_CTX_new().
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+
+    if (wolfSSL_CTX_RefreshOCSPStapleCache(ctx) != WOLFSSL_SUCCESS) {
+        // no response to staple yet
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_EnableOCSPStapleCache
+*/
+int wolfSSL_CTX_RefreshOCSPStapleCache(WOLFSSL_CTX* ctx);
+
 /*!
     \ingroup CertsKeys
 
@@ -12072,6 +13048,35 @@ int wolfSSL_get_session_stats(unsigned int* active,
                                           unsigned int* peak,
                                           unsigned int* maxSessions);
 
+/*!
+    \ingroup IO
+
+    \brief This function gets the lookup and eviction counters of the
+    internal session cache. Counters cover all contexts as the cache is
+    shared. Available with WOLFSSL_SESSION_STATS.
+
+    \return SSL_SUCCESS always.
+
+    \param hits a word32 pointer to hold the number of lookups that found the
+    session. May be NULL.
+    \param misses a word32 pointer to hold the number of lookups that did not
+    find the session. May be NULL.
+    \param evictions a word32 pointer to hold the number of live sessions
+    replaced to make room for a new one. May be NULL.
+
+    _Example_
+    \code
+    unsigned int hits, misses, evictions;
+    wolfSSL_get_session_cache_stats(&hits, &misses, &evictions);
+    \endcode
+
+    \sa wolfSSL_get_session_stats
+    \sa wolfSSL_CTX_sess_set_cache_size
+*/
+int wolfSSL_get_session_cache_stats(unsigned int* hits,
+                                    unsigned int* misses,
+                                    unsigned int* evictions);
+
 /*!
     \ingroup TLS
 
@@ -575,3 +575,214 @@ int wolfSSL_SetIO_ISOTP(WOLFSSL *ssl, isotp_wolfssl_ctx *ctx,
         can_recv_fn recv_fn, can_send_fn send_fn, can_delay_fn delay_fn,
         word32 receive_delay, char *receive_buffer, int receive_buffer_size,
         void *arg);
+
+/*!
+    \ingroup IO
+
+    \brief Creates an io_uring to drive the socket I/O of many connections.
+    Available when wolfSSL is compiled with WOLFSSL_IO_URING (Linux only).
+    The ring owns a receive and a send staging buffer of
+    WOLFSSL_IO_URING_BUF_SZ bytes for each connection. Receives and sends of
+    all connections are queued on the ring and submitted together with
+    wolfSSL_IoUring_Submit(). With WOLFSSL_IO_URING_FIXED_BUFFERS the staging
+    buffers are registered with the kernel once and receives use them without
+    mapping pages per operation. When registration fails, plain receives
+    are used instead.
+
+    \return pointer to the new io_uring object on success.
+    \return NULL when conns is out of range, memory allocation fails or the
+    kernel does not support io_uring.
+
+    \param conns maximum number of connections on the ring, at most
+    WOLFSSL_IO_URING_MAX_CONNS.
+    \param flags 0 or WOLFSSL_IO_URING_FIXED_BUFFERS.
+    \param heap heap hint used for memory allocation.
+
+    _Example_
+    \code
+    WOLFSSL_URING* ring;
+
+    ring = wolfSSL_IoUring_new(1024, WOLFSSL_IO_URING_FIXED_BUFFERS, NULL);
+    if (ring == NULL) {
+        // io_uring not available - use the socket callbacks
+    }
+    \endcode
+
+    \sa wolfSSL_IoUring_free
+    \sa wolfSSL_SetIO_IoUring
+    \sa wolfSSL_IoUring_Submit
+*/
+WOLFSSL_URING* wolfSSL_IoUring_new(int conns, int flags, void* heap);
+
+/*!
+    \ingroup IO
+
+    \brief Frees an io_uring and its staging buffers. Connections still on the
+    ring are detached and their outstanding operations are cancelled. The
+    WOLFSSL objects are not freed.
+
+    \return none No returns.
+
+    \param ring io_uring object to free. May be NULL.
+
+    \sa wolfSSL_IoUring_new
+*/
+void wolfSSL_IoUring_free(WOLFSSL_URING* ring);
+
+/*!
+    \ingroup IO
+
+    \brief Puts the socket I/O of a TLS connection on an io_uring. The socket
+    must already be set with wolfSSL_set_fd() and be a stream socket. The
+    read and write callbacks of the WOLFSSL object are replaced. Calls to
+    wolfSSL_connect(), wolfSSL_accept(), wolfSSL_read() and wolfSSL_write()
+    return WOLFSSL_ERROR_WANT_READ or WOLFSSL_ERROR_WANT_WRITE until the
+    queued operations complete; call them again when wolfSSL_IoUring_Submit()
+    returns the object. The connection is detached from the ring when the
+    WOLFSSL object is freed.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ssl or ring is NULL.
+    \return BAD_STATE_E when the object is already on a ring, is DTLS or does
+    not have a single socket set.
+    \return MEMORY_E when all connections of the ring are in use.
+
+    \param ssl WOLFSSL object with a socket set.
+    \param ring io_uring object.
+
+    _Example_
+    \code
+    WOLFSSL* ssl = wolfSSL_new(ctx);
+
+    wolfSSL_set_fd(ssl, sockfd);
+    if (wolfSSL_SetIO_IoUring(ssl, ring) != WOLFSSL_SUCCESS) {
+        // handle error
+    }
+    ret = wolfSSL_accept(ssl); // WOLFSSL_ERROR_WANT_READ - try again later
+    \endcode
+
+    \sa wolfSSL_IoUring_new
+    \sa wolfSSL_IoUring_Submit
+    \sa wolfSSL_IoUring_Pending
+*/
+int wolfSSL_SetIO_IoUring(WOLFSSL* ssl, WOLFSSL_URING* ring);
+
+/*!
+    \ingroup IO
+
+    \brief Submits the queued receives and sends of all connections on the
+    ring with one system call and reaps the completions. The WOLFSSL objects
+    whose operations completed are returned so that the application can call
+    the TLS function that returned WANT_READ or WANT_WRITE again. Objects that
+    do not fit in ready are returned by the next call.
+
+    \return number of WOLFSSL objects put in ready on success.
+    \return BAD_FUNC_ARG when ring is NULL or ready is NULL and readySz is
+    greater than 0.
+    \return SOCKET_ERROR_E when the kernel fails the submission.
+
+    \param ring io_uring object.
+    \param wait when non-zero, wait for a completion when none are available
+    and operations are in flight.
+    \param ready array to hold the WOLFSSL objects that can make progress.
+    \param readySz number of entries in ready.
+
+    _Example_
+    \code
+    WOLFSSL* ready[64];
+    int i, n;
+
+    while ((n = wolfSSL_IoUring_Submit(ring, 1, ready, 64)) >= 0) {
+        for (i = 0; i < n; i++) {
+            ret = wolfSSL_read(ready[i], buf, sizeof(buf));
+            ...
+        }
+    }
+    \endcode
+
+    \sa wolfSSL_SetIO_IoUring
+    \sa wolfSSL_IoUring_GetFd
+*/
+int wolfSSL_IoUring_Submit(WOLFSSL_URING* ring, int wait, WOLFSSL** ready,
+    int readySz);
+
+/*!
+    \ingroup IO
+
+    \brief Gets the number of bytes of a connection staged to be sent but not
+    yet sent by the kernel. Use it to make sure the last data, such as a
+    close_notify alert, has been sent before freeing the WOLFSSL object.
+
+    \return number of bytes waiting to be sent.
+    \return BAD_FUNC_ARG when ssl is NULL or is not on an io_uring.
+
+    \param ssl WOLFSSL object on an io_uring.
+
+    _Example_
+    \code
+    wolfSSL_shutdown(ssl);
+    while (wolfSSL_IoUring_Pending(ssl) > 0) {
+        wolfSSL_IoUring_Submit(ring, 1, ready, readySz);
+    }
+    wolfSSL_free(ssl);
+    \endcode
+
+    \sa wolfSSL_IoUring_Submit
+*/
+int wolfSSL_IoUring_Pending(WOLFSSL* ssl);
+
+/*!
+    \ingroup IO
+
+    \brief Gets the statistics of an io_uring: the number of io_uring_enter()
+    system calls made, the operations submitted and completed, and whether the
+    staging buffers are registered with the kernel.
+
+    \return WOLFSSL_SUCCESS on success.
+    \return BAD_FUNC_ARG when ring or stats is NULL.
+
+    \param ring io_uring object.
+    \param stats structure to fill with the statistics.
+
+    _Example_
+    \code
+    WOLFSSL_URING_STATS stats;
+
+    if (wolfSSL_IoUring_GetStats(ring, &stats) == WOLFSSL_SUCCESS) {
+        printf("%u system calls for %u operations\n", stats.enters,
+            stats.submitted);
+    }
+    \endcode
+
+    \sa wolfSSL_IoUring_new
+*/
+int wolfSSL_IoUring_GetStats(WOLFSSL_URING* ring, WOLFSSL_URING_STATS* stats);
+
+/*!
+    \ingroup IO
+
+    \brief Gets the file descriptor of an io_uring. The descriptor is readable
+    when completions are waiting. Use it to wait on the ring together with
+    other descriptors, such as a listening socket, after calling
+    wolfSSL_IoUring_Submit() without waiting.
+
+    \return file descriptor on success.
+    \return BAD_FUNC_ARG when ring is NULL.
+
+    \param ring io_uring object.
+
+    _Example_
+    \code
+    struct pollfd pfd[2];
+
+    wolfSSL_IoUring_Submit(ring, 0, ready, readySz);
+    pfd[0].fd = listenfd;
+    pfd[0].events = POLLIN;
+    pfd[1].fd = wolfSSL_IoUring_GetFd(ring);
+    pfd[1].events = POLLIN;
+    poll(pfd, 2, -1);
+    \endcode
+
+    \sa wolfSSL_IoUring_Submit
+*/
+int wolfSSL_IoUring_GetFd(WOLFSSL_URING* ring);
@@ -0,0 +1,391 @@
+/* cm_bench.c
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+
+/*
+Certificate manager contention benchmark.
+
+Loads many generated CA certificates into one certificate manager and then
+verifies leaf certificates issued by them from an increasing number of
+threads. Reports verifications per second for each thread count.
+
+  ./examples/benchmark/cm_bench -c 10000 -t 8
+
+With WOLFSSL_CERT_VERIFY_CACHE the signature checks are cached so that the
+CA lookup dominates. Use -s to check signatures every time.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+#ifndef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/wc_port.h>
+#include <wolfssl/ssl.h>
+#include <wolfssl/wolfcrypt/asn_public.h>
+#include <wolfssl/wolfcrypt/ecc.h>
+#include <wolfssl/wolfcrypt/random.h>
+#include <wolfssl/wolfcrypt/sha256.h>
+#include <wolfssl/test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#if !defined(SINGLE_THREADED) && !defined(NO_CERTS) && \
+    defined(WOLFSSL_CERT_GEN) && defined(WOLFSSL_CERT_EXT) && \
+    defined(HAVE_ECC) && !defined(NO_SHA256) && !defined(WOLFCRYPT_ONLY) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    #define CM_BENCH
+#endif
+
+/* Defaults for configuration parameters */
+#define CM_BENCH_CAS         2000  /* CA certificates loaded */
+#define CM_BENCH_LEAVES      64    /* Leaf certificates verified */
+#define CM_BENCH_THREADS     8     /* Maximum number of verifying threads */
+#define CM_BENCH_VERIFIES    20000 /* Verifications per thread */
+#define CM_BENCH_CERT_SZ     1024  /* Maximum size of a generated cert */
+
+/* Global vars for argument parsing */
+int myoptind = 0;
+char* myoptarg = NULL;
+
+#ifdef CM_BENCH
+
+typedef struct {
+    byte der[CM_BENCH_CERT_SZ];
+    int  derSz;
+} bench_cert_t;
+
+typedef struct {
+    WOLFSSL_CERT_MANAGER* cm;
+    bench_cert_t* leaves;
+    int leafCnt;
+    int verifies;
+    int first;  /* Index of leaf to start at */
+    int failed;
+} bench_thread_t;
+
+static double gettime_secs(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000;
+}
+
+/* Make a key identifier from the index of a certificate. */
+static int bench_key_id(byte* id, int idx, int isCa)
+{
+    int ret;
+    byte data[5];
+    byte digest[WC_SHA256_DIGEST_SIZE];
+
+    data[0] = (byte)(idx >> 24);
+    data[1] = (byte)(idx >> 16);
+    data[2] = (byte)(idx >>  8);
+    data[3] = (byte)idx;
+    data[4] = (byte)isCa;
+    ret = wc_Sha256Hash(data, sizeof(data), digest);
+    if (ret == 0) {
+        XMEMCPY(id, digest, KEYID_SIZE);
+    }
+
+    return ret;
+}
+
+/* Generate a certificate with the SKID made from the index.
+ *
+ * Self-signed CA when ca is NULL, otherwise a leaf issued by ca.
+ */
+static int bench_make_cert(bench_cert_t* out, int idx, bench_cert_t* ca,
+    int caIdx, ecc_key* key, WC_RNG* rng)
+{
+    int ret;
+    Cert cert;
+
+    ret = wc_InitCert(&cert);
+    if (ret == 0) {
+        cert.sigType = CTC_SHA256wECDSA;
+        XSNPRINTF(cert.subject.commonName, CTC_NAME_SIZE, "cm_bench %s %d",
+            (ca == NULL) ? "CA" : "leaf", idx);
+        ret = bench_key_id(cert.skid, idx, ca == NULL);
+        cert.skidSz = KEYID_SIZE;
+        if (ca == NULL) {
+            cert.isCA = 1;
+            XSTRNCPY(cert.issuer.commonName, cert.subject.commonName,
+                CTC_NAME_SIZE);
+        }
+        else {
+            /* AKID is the SKID of the issuing CA. */
+            if (ret == 0) {
+                ret = bench_key_id(cert.akid, caIdx, 1);
+                cert.akidSz = KEYID_SIZE;
+            }
+            if (ret == 0) {
+                ret = wc_SetIssuerBuffer(&cert, ca->der, ca->derSz);
+            }
+        }
+    }
+    if (ret == 0) {
+        ret = wc_MakeCert_ex(&cert, out->der, sizeof(out->der), ECC_TYPE, key,
+            rng);
+    }
+    if (ret > 0) {
+        ret = wc_SignCert_ex(cert.bodySz, cert.sigType, out->der,
+            sizeof(out->der), ECC_TYPE, key, rng);
+    }
+    if (ret > 0) {
+        out->derSz = ret;
+        ret = 0;
+    }
+
+    return ret;
+}
+
+static THREAD_RETURN WOLFSSL_THREAD bench_verify_thread(void* args)
+{
+    bench_thread_t* info = (bench_thread_t*)args;
+    int i;
+    int leaf = info->first;
+
+    for (i = 0; i < info->verifies; i++) {
+        if (wolfSSL_CertManagerVerifyBuffer(info->cm, info->leaves[leaf].der,
+                info->leaves[leaf].derSz, WOLFSSL_FILETYPE_ASN1) !=
+                WOLFSSL_SUCCESS) {
+            info->failed++;
+        }
+        if (++leaf == info->leafCnt) {
+            leaf = 0;
+        }
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Verify with threadCnt threads. Returns verifications per second. */
+static double bench_verify(WOLFSSL_CERT_MANAGER* cm, bench_cert_t* leaves,
+    int leafCnt, int threadCnt, int verifies, int* failed)
+{
+    THREAD_TYPE threads[64];
+    bench_thread_t info[64];
+    double start;
+    int i;
+
+    for (i = 0; i < threadCnt; i++) {
+        info[i].cm = cm;
+        info[i].leaves = leaves;
+        info[i].leafCnt = leafCnt;
+        info[i].verifies = verifies;
+        info[i].first = (i * leafCnt) / threadCnt;
+        info[i].failed = 0;
+    }
+
+    start = gettime_secs();
+    for (i = 0; i < threadCnt; i++) {
+        THREAD_CHECK_RET(wolfSSL_NewThread(&threads[i], bench_verify_thread,
+            &info[i]));
+    }
+    for (i = 0; i < threadCnt; i++) {
+        THREAD_CHECK_RET(wolfSSL_JoinThread(threads[i]));
+        *failed += info[i].failed;
+    }
+
+    return (double)threadCnt * verifies / (gettime_secs() - start);
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "cm_bench " LIBWOLFSSL_VERSION_STRING "\n");
+    fprintf(stderr, "-?          Help, print this usage\n");
+    fprintf(stderr, "-c <num>    Number of CA certificates (default %d)\n",
+        CM_BENCH_CAS);
+    fprintf(stderr, "-l <num>    Number of leaf certificates (default %d)\n",
+        CM_BENCH_LEAVES);
+    fprintf(stderr, "-t <num>    Maximum number of threads [1-64] "
+        "(default %d)\n", CM_BENCH_THREADS);
+    fprintf(stderr, "-n <num>    Verifications per thread (default %d)\n",
+        CM_BENCH_VERIFIES);
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    fprintf(stderr, "-s          Check signatures every time - "
+        "no verify cache\n");
+#endif
+}
+
+static int bench_cm(int argc, char** argv)
+{
+    int ret = 0;
+    int ch;
+    int i;
+    int threadCnt;
+    int failed = 0;
+    double rate;
+    double base = 0;
+    double start;
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    bench_cert_t* cas = NULL;
+    bench_cert_t* leaves = NULL;
+    ecc_key key;
+    WC_RNG rng;
+    int argCas = CM_BENCH_CAS;
+    int argLeaves = CM_BENCH_LEAVES;
+    int argThreads = CM_BENCH_THREADS;
+    int argVerifies = CM_BENCH_VERIFIES;
+    int argNoCache = 0;
+
+    XMEMSET(&key, 0, sizeof(key));
+    XMEMSET(&rng, 0, sizeof(rng));
+
+    while ((ch = mygetopt(argc, argv, "?c:l:t:n:s")) != -1) {
+        switch (ch) {
+            case 'c':
+                argCas = atoi(myoptarg);
+                break;
+            case 'l':
+                argLeaves = atoi(myoptarg);
+                break;
+            case 't':
+                argThreads = atoi(myoptarg);
+                break;
+            case 'n':
+                argVerifies = atoi(myoptarg);
+                break;
+            case 's':
+                argNoCache = 1;
+                break;
+            case '?':
+            default:
+                Usage();
+                return 0;
+        }
+    }
+    if ((argCas <= 0) || (argLeaves <= 0) || (argThreads <= 0) ||
+            (argThreads > 64) || (argVerifies <= 0)) {
+        Usage();
+        return -1;
+    }
+
+    cas = (bench_cert_t*)XMALLOC(sizeof(bench_cert_t) * argCas, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    leaves = (bench_cert_t*)XMALLOC(sizeof(bench_cert_t) * argLeaves, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if ((cas == NULL) || (leaves == NULL)) {
+        ret = MEMORY_E;
+    }
+
+    /* All certificates have the same key - only the lookup is of interest. */
+    if ((ret == 0) && ((ret = wc_InitRng(&rng)) == 0)) {
+        ret = wc_ecc_init(&key);
+        if (ret == 0) {
+            ret = wc_ecc_make_key(&rng, 32, &key);
+        }
+    }
+
+    if (ret == 0) {
+        cm = wolfSSL_CertManagerNew();
+        if (cm == NULL) {
+            ret = MEMORY_E;
+        }
+    }
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    if ((ret == 0) && (!argNoCache)) {
+        ret = wolfSSL_CertManagerSetVerifyCache(cm, (word32)argLeaves * 2, 0);
+        if (ret == WOLFSSL_SUCCESS) {
+            ret = 0;
+        }
+    }
+#endif
+    (void)argNoCache;
+
+    start = gettime_secs();
+    for (i = 0; (ret == 0) && (i < argCas); i++) {
+        ret = bench_make_cert(&cas[i], i, NULL, 0, &key, &rng);
+        if (ret == 0) {
+            ret = wolfSSL_CertManagerLoadCABuffer(cm, cas[i].der, cas[i].derSz,
+                WOLFSSL_FILETYPE_ASN1);
+            ret = (ret == WOLFSSL_SUCCESS) ? 0 : ret;
+        }
+    }
+    if (ret == 0) {
+        printf("Generated and loaded %d CAs in %.3f sec\n", argCas,
+            gettime_secs() - start);
+    }
+    /* Leaves issued by CAs spread over the table. */
+    for (i = 0; (ret == 0) && (i < argLeaves); i++) {
+        int caIdx = (int)(((long)i * argCas) / argLeaves);
+        ret = bench_make_cert(&leaves[i], i, &cas[caIdx], caIdx, &key, &rng);
+    }
+
+    if (ret == 0) {
+        printf("%-8s  %15s  %8s\n", "threads", "verifies/sec", "scaling");
+        for (threadCnt = 1; threadCnt <= argThreads; threadCnt *= 2) {
+            rate = bench_verify(cm, leaves, argLeaves, threadCnt, argVerifies,
+                &failed);
+            if (threadCnt == 1) {
+                base = rate;
+            }
+            printf("%-8d  %15.0f  %8.2f\n", threadCnt, rate, rate / base);
+            if ((threadCnt < argThreads) && (threadCnt * 2 > argThreads)) {
+                /* Always run with the maximum number of threads. */
+                threadCnt = argThreads / 2;
+            }
+        }
+        if (failed != 0) {
+            fprintf(stderr, "%d verifications failed\n", failed);
+            ret = -1;
+        }
+    }
+    if (ret != 0) {
+        fprintf(stderr, "cm_bench failed: %d\n", ret);
+    }
+
+    wolfSSL_CertManagerFree(cm);
+    wc_ecc_free(&key);
+    wc_FreeRng(&rng);
+    XFREE(leaves, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(cas, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+
+#endif /* CM_BENCH */
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+#ifdef CM_BENCH
+    wolfSSL_Init();
+    ret = bench_cm(argc, argv);
+    wolfSSL_Cleanup();
+#else
+    (void)argc;
+    (void)argv;
+    printf("cm_bench requires threads, certificate generation and ECC\n");
+#endif
+
+    return (ret == 0) ? 0 : 1;
+}
@@ -0,0 +1,393 @@
+/* crl_bench.c
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+
+/*
+CRL revocation check benchmark.
+
+Generates CRLs with an increasing number of revoked certificates, loads each
+into a certificate manager and checks a certificate that is not revoked -
+the worst case when the revoked list is searched. Reports the load time and
+the time per revocation check for each CRL size.
+
+  ./examples/benchmark/crl_bench -m 1000000
+
+With WOLFSSL_CRL_SERIAL_INDEX the check time does not depend on CRL size.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+#ifndef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/ssl.h>
+#include <wolfssl/wolfcrypt/asn.h>
+#include <wolfssl/wolfcrypt/asn_public.h>
+#include <wolfssl/wolfcrypt/ecc.h>
+#include <wolfssl/wolfcrypt/random.h>
+#include <wolfssl/test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#if defined(HAVE_CRL) && defined(WOLFSSL_CERT_GEN) && \
+    defined(WOLFSSL_CERT_EXT) && defined(HAVE_ECC) && !defined(NO_SHA256) && \
+    !defined(WOLFCRYPT_ONLY) && !defined(WOLFSSL_ASYNC_CRYPT)
+    #define CRL_BENCH
+#endif
+
+/* Defaults for configuration parameters */
+#define CRL_BENCH_MAX_REVOKED  100000 /* Largest CRL size */
+#define CRL_BENCH_CHECKS       10000  /* Revocation checks per CRL size */
+#define CRL_BENCH_CERT_SZ      1024   /* Maximum size of a generated cert */
+
+/* Size of an entry in the revoked list: SEQUENCE { INTEGER, UTCTime } */
+#define CRL_BENCH_ENTRY_SZ     (2 + 2 + 4 + 15)
+
+/* Global vars for argument parsing */
+int myoptind = 0;
+char* myoptarg = NULL;
+
+#ifdef CRL_BENCH
+
+static const byte crlSigAlgo[] = {
+    0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02
+};
+static const byte crlVersion[] = { 0x02, 0x01, 0x01 };
+static const byte crlThisUpdate[] = "\x17\x0d" "240101000000Z";
+static const byte crlNextUpdate[] = "\x17\x0d" "490101000000Z";
+
+static double gettime_secs(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000;
+}
+
+/* Encode DER tag and length. Only calculates size when out is NULL. */
+static word32 bench_der_hdr(byte* out, byte tag, word32 len)
+{
+    byte tmp[6];
+    word32 i = 0;
+
+    if (out == NULL) {
+        out = tmp;
+    }
+    out[i++] = tag;
+    if (len < 0x80) {
+        out[i++] = (byte)len;
+    }
+    else if (len < 0x100) {
+        out[i++] = 0x81;
+        out[i++] = (byte)len;
+    }
+    else if (len < 0x10000) {
+        out[i++] = 0x82;
+        out[i++] = (byte)(len >> 8);
+        out[i++] = (byte)len;
+    }
+    else if (len < 0x1000000) {
+        out[i++] = 0x83;
+        out[i++] = (byte)(len >> 16);
+        out[i++] = (byte)(len >> 8);
+        out[i++] = (byte)len;
+    }
+    else {
+        out[i++] = 0x84;
+        out[i++] = (byte)(len >> 24);
+        out[i++] = (byte)(len >> 16);
+        out[i++] = (byte)(len >> 8);
+        out[i++] = (byte)len;
+    }
+
+    return i;
+}
+
+/* Make a CRL revoking the serial numbers 0x01, i for i in 0 to cnt - 1.
+ *
+ * The issuer is the contents of the issuing CA's subject name.
+ * Returns size of CRL DER or negative on error.
+ */
+static int bench_make_crl(byte* der, word32 derSz, const byte* issuer,
+    word32 issuerSz, int cnt, ecc_key* key, WC_RNG* rng)
+{
+    word32 listSz = (word32)cnt * CRL_BENCH_ENTRY_SZ;
+    word32 tbsSz;
+    word32 idx = 0;
+    int i;
+
+    tbsSz = (word32)sizeof(crlVersion) + (word32)sizeof(crlSigAlgo) +
+        bench_der_hdr(NULL, 0x30, issuerSz) + issuerSz +
+        2 * ((word32)sizeof(crlThisUpdate) - 1) +
+        bench_der_hdr(NULL, 0x30, listSz) + listSz;
+    if (tbsSz + 6 + 128 > derSz) {
+        return BUFFER_E;
+    }
+
+    idx += bench_der_hdr(der + idx, 0x30, tbsSz);
+    XMEMCPY(der + idx, crlVersion, sizeof(crlVersion));
+    idx += (word32)sizeof(crlVersion);
+    XMEMCPY(der + idx, crlSigAlgo, sizeof(crlSigAlgo));
+    idx += (word32)sizeof(crlSigAlgo);
+    idx += bench_der_hdr(der + idx, 0x30, issuerSz);
+    XMEMCPY(der + idx, issuer, issuerSz);
+    idx += issuerSz;
+    XMEMCPY(der + idx, crlThisUpdate, sizeof(crlThisUpdate) - 1);
+    idx += (word32)sizeof(crlThisUpdate) - 1;
+    XMEMCPY(der + idx, crlNextUpdate, sizeof(crlNextUpdate) - 1);
+    idx += (word32)sizeof(crlNextUpdate) - 1;
+    idx += bench_der_hdr(der + idx, 0x30, listSz);
+    for (i = 0; i < cnt; i++) {
+        idx += bench_der_hdr(der + idx, 0x30, CRL_BENCH_ENTRY_SZ - 2);
+        idx += bench_der_hdr(der + idx, 0x02, 4);
+        der[idx++] = 0x01;
+        der[idx++] = (byte)(i >> 16);
+        der[idx++] = (byte)(i >>  8);
+        der[idx++] = (byte)i;
+        XMEMCPY(der + idx, crlThisUpdate, sizeof(crlThisUpdate) - 1);
+        idx += (word32)sizeof(crlThisUpdate) - 1;
+    }
+
+    return wc_SignCert_ex((int)idx, CTC_SHA256wECDSA, der, derSz, ECC_TYPE,
+        key, rng);
+}
+
+/* Generate a self-signed CA when ca is NULL, otherwise a certificate issued
+ * by ca with the serial number 0x02, 0, 0, 0 - never revoked. */
+static int bench_make_cert(byte* der, int* derSz, const byte* ca, int caSz,
+    ecc_key* key, WC_RNG* rng)
+{
+    int ret;
+    Cert cert;
+
+    ret = wc_InitCert(&cert);
+    if (ret == 0) {
+        cert.sigType = CTC_SHA256wECDSA;
+        if (ca == NULL) {
+            XSTRNCPY(cert.subject.commonName, "crl_bench CA", CTC_NAME_SIZE);
+            XSTRNCPY(cert.issuer.commonName, cert.subject.commonName,
+                CTC_NAME_SIZE);
+            cert.isCA = 1;
+        }
+        else {
+            XSTRNCPY(cert.subject.commonName, "crl_bench leaf",
+                CTC_NAME_SIZE);
+            XMEMSET(cert.serial, 0, 4);
+            cert.serial[0] = 0x02;
+            cert.serialSz = 4;
+            ret = wc_SetIssuerBuffer(&cert, ca, caSz);
+        }
+    }
+    if (ret == 0) {
+        ret = wc_MakeCert_ex(&cert, der, CRL_BENCH_CERT_SZ, ECC_TYPE, key,
+            rng);
+    }
+    if (ret > 0) {
+        ret = wc_SignCert_ex(cert.bodySz, cert.sigType, der,
+            CRL_BENCH_CERT_SZ, ECC_TYPE, key, rng);
+    }
+    if (ret > 0) {
+        *derSz = ret;
+        ret = 0;
+    }
+
+    return ret;
+}
+
+/* Load CRL into a new certificate manager and time revocation checks. */
+static int bench_crl_size(const byte* ca, int caSz, const byte* leaf,
+    int leafSz, const byte* crl, int crlSz, int cnt, int checks)
+{
+    int ret = 0;
+    int i;
+    double start;
+    double load;
+    double check;
+    WOLFSSL_CERT_MANAGER* cm;
+
+    cm = wolfSSL_CertManagerNew();
+    if (cm == NULL) {
+        return MEMORY_E;
+    }
+    if ((wolfSSL_CertManagerEnableCRL(cm, 0) != WOLFSSL_SUCCESS) ||
+            (wolfSSL_CertManagerLoadCABuffer(cm, ca, caSz,
+                WOLFSSL_FILETYPE_ASN1) != WOLFSSL_SUCCESS)) {
+        ret = -1;
+    }
+
+    if (ret == 0) {
+        start = gettime_secs();
+        if (wolfSSL_CertManagerLoadCRLBuffer(cm, crl, crlSz,
+                WOLFSSL_FILETYPE_ASN1) != WOLFSSL_SUCCESS) {
+            ret = -1;
+        }
+        load = gettime_secs() - start;
+    }
+    if (ret == 0) {
+        start = gettime_secs();
+        for (i = 0; (ret == 0) && (i < checks); i++) {
+            if (wolfSSL_CertManagerCheckCRL(cm, leaf, leafSz) !=
+                    WOLFSSL_SUCCESS) {
+                ret = -1;
+            }
+        }
+        check = gettime_secs() - start;
+    }
+    if (ret == 0) {
+        printf("%-10d  %12.3f  %14.2f\n", cnt, load * 1000,
+            check * 1000000 / checks);
+    }
+
+    wolfSSL_CertManagerFree(cm);
+
+    return ret;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "crl_bench " LIBWOLFSSL_VERSION_STRING "\n");
+    fprintf(stderr, "-?          Help, print this usage\n");
+    fprintf(stderr, "-m <num>    Maximum number of revoked certificates "
+        "[1-16777216] (default %d)\n", CRL_BENCH_MAX_REVOKED);
+    fprintf(stderr, "-n <num>    Revocation checks per CRL size "
+        "(default %d)\n", CRL_BENCH_CHECKS);
+}
+
+static int bench_crl(int argc, char** argv)
+{
+    int ret = 0;
+    int ch;
+    int cnt;
+    byte ca[CRL_BENCH_CERT_SZ];
+    int caSz = 0;
+    byte leaf[CRL_BENCH_CERT_SZ];
+    int leafSz = 0;
+    byte* crl = NULL;
+    word32 crlMax;
+    int crlSz = 0;
+    ecc_key key;
+    WC_RNG rng;
+    DecodedCert dCert;
+    int argMax = CRL_BENCH_MAX_REVOKED;
+    int argChecks = CRL_BENCH_CHECKS;
+
+    XMEMSET(&key, 0, sizeof(key));
+    XMEMSET(&rng, 0, sizeof(rng));
+
+    while ((ch = mygetopt(argc, argv, "?m:n:")) != -1) {
+        switch (ch) {
+            case 'm':
+                argMax = atoi(myoptarg);
+                break;
+            case 'n':
+                argChecks = atoi(myoptarg);
+                break;
+            case '?':
+            default:
+                Usage();
+                return 0;
+        }
+    }
+    if ((argMax <= 0) || (argMax > 0x1000000) || (argChecks <= 0)) {
+        Usage();
+        return -1;
+    }
+
+    crlMax = (word32)argMax * CRL_BENCH_ENTRY_SZ + 1024;
+    crl = (byte*)XMALLOC(crlMax, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (crl == NULL) {
+        ret = MEMORY_E;
+    }
+
+    if ((ret == 0) && ((ret = wc_InitRng(&rng)) == 0)) {
+        ret = wc_ecc_init(&key);
+        if (ret == 0) {
+            ret = wc_ecc_make_key(&rng, 32, &key);
+        }
+    }
+    if (ret == 0) {
+        ret = bench_make_cert(ca, &caSz, NULL, 0, &key, &rng);
+    }
+    if (ret == 0) {
+        ret = bench_make_cert(leaf, &leafSz, ca, caSz, &key, &rng);
+    }
+
+    if (ret == 0) {
+        printf("%-10s  %12s  %14s\n", "revoked", "load ms", "check us");
+    }
+    for (cnt = 1; ret == 0; cnt *= 10) {
+        if (cnt > argMax) {
+            cnt = argMax;
+        }
+        wc_InitDecodedCert(&dCert, ca, (word32)caSz, NULL);
+        ret = wc_ParseCert(&dCert, CERT_TYPE, NO_VERIFY, NULL);
+        if (ret == 0) {
+            crlSz = bench_make_crl(crl, crlMax, dCert.subjectRaw,
+                (word32)dCert.subjectRawLen, cnt, &key, &rng);
+            if (crlSz < 0) {
+                ret = crlSz;
+            }
+        }
+        wc_FreeDecodedCert(&dCert);
+        if (ret == 0) {
+            ret = bench_crl_size(ca, caSz, leaf, leafSz, crl, crlSz, cnt,
+                argChecks);
+        }
+        if (cnt == argMax) {
+            break;
+        }
+    }
+    if (ret != 0) {
+        fprintf(stderr, "crl_bench failed: %d\n", ret);
+    }
+
+    wc_ecc_free(&key);
+    wc_FreeRng(&rng);
+    XFREE(crl, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+
+#endif /* CRL_BENCH */
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+#ifdef CRL_BENCH
+    wolfSSL_Init();
+    ret = bench_crl(argc, argv);
+    wolfSSL_Cleanup();
+#else
+    (void)argc;
+    (void)argv;
+    printf("crl_bench requires CRL, certificate generation and ECC\n");
+#endif
+
+    return (ret == 0) ? 0 : 1;
+}
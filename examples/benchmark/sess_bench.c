@@ -0,0 +1,480 @@
+/* sess_bench.c
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+
+/*
+Session cache resumption benchmark.
+
+Fills the server session cache with full TLS 1.2 handshakes and then resumes
+those sessions from an increasing number of threads. Client and server of
+each connection run in the same thread over memory buffers so that only the
+handshake and the session cache are measured. Reports resumptions per second
+for each thread count.
+
+  ./examples/benchmark/sess_bench -t 16
+
+Use -c to change the size of the session cache at runtime and -s to set the
+number of sessions resumed (default is half the cache size).
+*/
+
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+#ifndef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/wc_port.h>
+#include <wolfssl/ssl.h>
+#include <wolfssl/test.h>
+
+#undef  USE_CERT_BUFFERS_256
+#define USE_CERT_BUFFERS_256
+#include <wolfssl/certs_test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#if !defined(SINGLE_THREADED) && !defined(NO_SESSION_CACHE) && \
+    !defined(NO_CERTS) && defined(HAVE_ECC) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFCRYPT_ONLY) && !defined(WOLFSSL_ASYNC_CRYPT)
+    #define SESS_BENCH
+#endif
+
+/* Defaults for configuration parameters */
+#define SESS_BENCH_THREADS     8     /* Maximum number of resuming threads */
+#define SESS_BENCH_RESUMES     2000  /* Resumptions per thread */
+#define SESS_BENCH_BUF_SZ      8192  /* Size of memory buffer per direction */
+
+/* Global vars for argument parsing */
+int myoptind = 0;
+char* myoptarg = NULL;
+
+#ifdef SESS_BENCH
+
+/* Data sent in one direction over memory. */
+typedef struct {
+    byte buf[SESS_BENCH_BUF_SZ];
+    int  len;
+} bench_pipe_t;
+
+/* Both directions of a connection. */
+typedef struct {
+    bench_pipe_t toSrv;
+    bench_pipe_t toCli;
+} bench_conn_t;
+
+typedef struct {
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL_SESSION** sessions;
+    int sessCnt;
+    int first;  /* Index of first session to resume */
+    int step;   /* Distance to next session to resume */
+    int resumes;
+    int failed;
+    int missed; /* Full handshakes instead of resumption */
+} bench_thread_t;
+
+static double gettime_secs(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000;
+}
+
+static int bench_pipe_send(bench_pipe_t* pipe, const char* data, int sz)
+{
+    if (sz > SESS_BENCH_BUF_SZ - pipe->len) {
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    }
+    XMEMCPY(pipe->buf + pipe->len, data, (size_t)sz);
+    pipe->len += sz;
+
+    return sz;
+}
+
+static int bench_pipe_recv(bench_pipe_t* pipe, char* data, int sz)
+{
+    if (pipe->len == 0) {
+        return WOLFSSL_CBIO_ERR_WANT_READ;
+    }
+    if (sz > pipe->len) {
+        sz = pipe->len;
+    }
+    XMEMCPY(data, pipe->buf, (size_t)sz);
+    pipe->len -= sz;
+    XMEMMOVE(pipe->buf, pipe->buf + sz, (size_t)pipe->len);
+
+    return sz;
+}
+
+static int bench_cli_send(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    (void)ssl;
+    return bench_pipe_send(&((bench_conn_t*)ctx)->toSrv, buf, sz);
+}
+
+static int bench_cli_recv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    (void)ssl;
+    return bench_pipe_recv(&((bench_conn_t*)ctx)->toCli, buf, sz);
+}
+
+static int bench_srv_send(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    (void)ssl;
+    return bench_pipe_send(&((bench_conn_t*)ctx)->toCli, buf, sz);
+}
+
+static int bench_srv_recv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    (void)ssl;
+    return bench_pipe_recv(&((bench_conn_t*)ctx)->toSrv, buf, sz);
+}
+
+/* Perform a handshake between a client and server over memory.
+ *
+ * When session is not NULL the client attempts to resume it.
+ * On success and when out is not NULL, the client's session is returned.
+ */
+static int bench_handshake(WOLFSSL_CTX* cliCtx, WOLFSSL_CTX* srvCtx,
+    WOLFSSL_SESSION* session, WOLFSSL_SESSION** out, int* resumed)
+{
+    int ret = 0;
+    int i;
+    int cliDone = 0;
+    int srvDone = 0;
+    WOLFSSL* cli = NULL;
+    WOLFSSL* srv = NULL;
+    bench_conn_t conn;
+
+    conn.toSrv.len = 0;
+    conn.toCli.len = 0;
+
+    cli = wolfSSL_new(cliCtx);
+    srv = wolfSSL_new(srvCtx);
+    if ((cli == NULL) || (srv == NULL)) {
+        ret = MEMORY_E;
+    }
+    if (ret == 0) {
+        wolfSSL_SSLSetIOSend(cli, bench_cli_send);
+        wolfSSL_SSLSetIORecv(cli, bench_cli_recv);
+        wolfSSL_SetIOWriteCtx(cli, &conn);
+        wolfSSL_SetIOReadCtx(cli, &conn);
+        wolfSSL_SSLSetIOSend(srv, bench_srv_send);
+        wolfSSL_SSLSetIORecv(srv, bench_srv_recv);
+        wolfSSL_SetIOWriteCtx(srv, &conn);
+        wolfSSL_SetIOReadCtx(srv, &conn);
+        if ((session != NULL) &&
+                (wolfSSL_set_session(cli, session) != WOLFSSL_SUCCESS)) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    /* Step client and server until both are done. */
+    for (i = 0; (ret == 0) && (i < 32) && !(cliDone && srvDone); i++) {
+        int err;
+
+        if (!cliDone) {
+            err = wolfSSL_connect(cli);
+            if (err == WOLFSSL_SUCCESS) {
+                cliDone = 1;
+            }
+            else if (wolfSSL_get_error(cli, err) != WOLFSSL_ERROR_WANT_READ) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+        }
+        if ((ret == 0) && !srvDone) {
+            err = wolfSSL_accept(srv);
+            if (err == WOLFSSL_SUCCESS) {
+                srvDone = 1;
+            }
+            else if (wolfSSL_get_error(srv, err) != WOLFSSL_ERROR_WANT_READ) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+        }
+    }
+    if ((ret == 0) && !(cliDone && srvDone)) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        if (resumed != NULL) {
+            *resumed = wolfSSL_session_reused(cli);
+        }
+        if (out != NULL) {
+            *out = wolfSSL_get1_session(cli);
+            if (*out == NULL) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+        }
+    }
+
+    wolfSSL_free(srv);
+    wolfSSL_free(cli);
+
+    return ret;
+}
+
+static THREAD_RETURN WOLFSSL_THREAD bench_resume_thread(void* args)
+{
+    bench_thread_t* info = (bench_thread_t*)args;
+    int i;
+    int idx = info->first;
+    int resumed;
+
+    for (i = 0; i < info->resumes; i++) {
+        resumed = 0;
+        if (bench_handshake(info->cliCtx, info->srvCtx, info->sessions[idx],
+                NULL, &resumed) != 0) {
+            info->failed++;
+        }
+        else if (!resumed) {
+            info->missed++;
+        }
+        idx += info->step;
+        if (idx >= info->sessCnt) {
+            idx = info->first;
+        }
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Resume with threadCnt threads. Returns resumptions per second. */
+static double bench_resume(WOLFSSL_CTX* cliCtx, WOLFSSL_CTX* srvCtx,
+    WOLFSSL_SESSION** sessions, int sessCnt, int threadCnt, int resumes,
+    int* failed, int* missed)
+{
+    THREAD_TYPE threads[64];
+    bench_thread_t info[64];
+    double start;
+    int i;
+
+    /* Each thread resumes its own sessions. */
+    for (i = 0; i < threadCnt; i++) {
+        info[i].cliCtx = cliCtx;
+        info[i].srvCtx = srvCtx;
+        info[i].sessions = sessions;
+        info[i].sessCnt = sessCnt;
+        info[i].first = i;
+        info[i].step = threadCnt;
+        info[i].resumes = resumes;
+        info[i].failed = 0;
+        info[i].missed = 0;
+    }
+
+    start = gettime_secs();
+    for (i = 0; i < threadCnt; i++) {
+        THREAD_CHECK_RET(wolfSSL_NewThread(&threads[i], bench_resume_thread,
+            &info[i]));
+    }
+    for (i = 0; i < threadCnt; i++) {
+        THREAD_CHECK_RET(wolfSSL_JoinThread(threads[i]));
+        *failed += info[i].failed;
+        *missed += info[i].missed;
+    }
+
+    return (double)threadCnt * resumes / (gettime_secs() - start);
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "sess_bench " LIBWOLFSSL_VERSION_STRING "\n");
+    fprintf(stderr, "-?          Help, print this usage\n");
+    fprintf(stderr, "-c <num>    Session cache size, up to the compile time "
+        "size\n");
+    fprintf(stderr, "-s <num>    Number of sessions (default half the cache "
+        "size)\n");
+    fprintf(stderr, "-t <num>    Maximum number of threads [1-64] "
+        "(default %d)\n", SESS_BENCH_THREADS);
+    fprintf(stderr, "-n <num>    Resumptions per thread (default %d)\n",
+        SESS_BENCH_RESUMES);
+}
+
+static int bench_sess(int argc, char** argv)
+{
+    int ret = 0;
+    int ch;
+    int i;
+    int threadCnt;
+    int failed = 0;
+    int missed = 0;
+    double rate;
+    double base = 0;
+    double start;
+    WOLFSSL_CTX* cliCtx = NULL;
+    WOLFSSL_CTX* srvCtx = NULL;
+    WOLFSSL_SESSION** sessions = NULL;
+    long argCache = 0;
+    int argSessions = 0;
+    int argThreads = SESS_BENCH_THREADS;
+    int argResumes = SESS_BENCH_RESUMES;
+#ifdef WOLFSSL_SESSION_STATS
+    word32 hits = 0;
+    word32 misses = 0;
+    word32 evictions = 0;
+#endif
+
+    while ((ch = mygetopt(argc, argv, "?c:s:t:n:")) != -1) {
+        switch (ch) {
+            case 'c':
+                argCache = atol(myoptarg);
+                break;
+            case 's':
+                argSessions = atoi(myoptarg);
+                break;
+            case 't':
+                argThreads = atoi(myoptarg);
+                break;
+            case 'n':
+                argResumes = atoi(myoptarg);
+                break;
+            case '?':
+            default:
+                Usage();
+                return 0;
+        }
+    }
+    if ((argCache < 0) || (argSessions < 0) || (argThreads <= 0) ||
+            (argThreads > 64) || (argResumes <= 0)) {
+        Usage();
+        return -1;
+    }
+
+    srvCtx = wolfSSL_CTX_new(wolfTLSv1_2_server_method());
+    cliCtx = wolfSSL_CTX_new(wolfTLSv1_2_client_method());
+    if ((srvCtx == NULL) || (cliCtx == NULL)) {
+        ret = MEMORY_E;
+    }
+    if ((ret == 0) && (wolfSSL_CTX_use_certificate_buffer(srvCtx,
+            serv_ecc_der_256, sizeof_serv_ecc_der_256,
+            WOLFSSL_FILETYPE_ASN1) != WOLFSSL_SUCCESS)) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if ((ret == 0) && (wolfSSL_CTX_use_PrivateKey_buffer(srvCtx,
+            ecc_key_der_256, sizeof_ecc_key_der_256,
+            WOLFSSL_FILETYPE_ASN1) != WOLFSSL_SUCCESS)) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        wolfSSL_CTX_set_verify(cliCtx, WOLFSSL_VERIFY_NONE, NULL);
+        if (argCache > 0) {
+            (void)wolfSSL_CTX_sess_set_cache_size(srvCtx, argCache);
+        }
+        if (argSessions == 0) {
+            /* Leave room so that few sessions collide in a row. */
+            argSessions = (int)(wolfSSL_CTX_sess_get_cache_size(srvCtx) / 2);
+        }
+        if (argSessions < argThreads) {
+            argSessions = argThreads;
+        }
+        sessions = (WOLFSSL_SESSION**)XMALLOC(sizeof(WOLFSSL_SESSION*) *
+            (size_t)argSessions, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        if (sessions == NULL) {
+            ret = MEMORY_E;
+        }
+        else {
+            XMEMSET(sessions, 0, sizeof(WOLFSSL_SESSION*) *
+                (size_t)argSessions);
+        }
+    }
+
+    /* Full handshakes to fill the session cache. */
+    start = gettime_secs();
+    for (i = 0; (ret == 0) && (i < argSessions); i++) {
+        ret = bench_handshake(cliCtx, srvCtx, NULL, &sessions[i], NULL);
+    }
+    if (ret == 0) {
+        printf("Cache size %ld, %d sessions established in %.3f sec\n",
+            wolfSSL_CTX_sess_get_cache_size(srvCtx), argSessions,
+            gettime_secs() - start);
+    }
+
+    if (ret == 0) {
+        printf("%-8s  %15s  %8s\n", "threads", "resumes/sec", "scaling");
+        for (threadCnt = 1; threadCnt <= argThreads; threadCnt *= 2) {
+            rate = bench_resume(cliCtx, srvCtx, sessions, argSessions,
+                threadCnt, argResumes, &failed, &missed);
+            if (threadCnt == 1) {
+                base = rate;
+            }
+            printf("%-8d  %15.0f  %8.2f\n", threadCnt, rate, rate / base);
+            if ((threadCnt < argThreads) && (threadCnt * 2 > argThreads)) {
+                /* Always run with the maximum number of threads. */
+                threadCnt = argThreads / 2;
+            }
+        }
+        if (missed != 0) {
+            printf("%d handshakes did not resume\n", missed);
+        }
+    #ifdef WOLFSSL_SESSION_STATS
+        if (wolfSSL_get_session_cache_stats(&hits, &misses, &evictions) ==
+                WOLFSSL_SUCCESS) {
+            printf("Cache hits %u, misses %u, evictions %u\n", hits, misses,
+                evictions);
+        }
+    #endif
+        if (failed != 0) {
+            fprintf(stderr, "%d handshakes failed\n", failed);
+            ret = -1;
+        }
+    }
+    if (ret != 0) {
+        fprintf(stderr, "sess_bench failed: %d\n", ret);
+    }
+
+    if (sessions != NULL) {
+        for (i = 0; i < argSessions; i++) {
+            wolfSSL_SESSION_free(sessions[i]);
+        }
+        XFREE(sessions, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    wolfSSL_CTX_free(cliCtx);
+    wolfSSL_CTX_free(srvCtx);
+
+    return ret;
+}
+
+#endif /* SESS_BENCH */
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+#ifdef SESS_BENCH
+    wolfSSL_Init();
+    ret = bench_sess(argc, argv);
+    wolfSSL_Cleanup();
+#else
+    (void)argc;
+    (void)argv;
+    printf("sess_bench requires threads, the session cache, TLS 1.2 and "
+        "ECC\n");
+#endif
+
+    return (ret == 0) ? 0 : 1;
+}
@@ -0,0 +1,477 @@
+/* ticket_bench.c
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+
+/*
+Session ticket resumption benchmark.
+
+Establishes TLS 1.2 sessions with a server that has no session cache and then
+resumes them from an increasing number of threads. Each resumption has the
+default ticket callback decrypt the client's ticket and encrypt a new one,
+with no public key operations. Client and server of each connection run in
+the same thread over memory buffers. Reports resumptions per second for each
+thread count.
+
+  ./examples/benchmark/ticket_bench -t 8
+
+The default ticket cipher is ChaCha20-Poly1305 when available. Build with
+CFLAGS=-DWOLFSSL_TICKET_ENC_AES128_GCM (or _AES256_GCM) to use AES-GCM, which
+keeps a keyed context per ticket key, and add -DWOLFSSL_TICKET_ENC_NO_PREKEY
+to compare against keying AES-GCM for every ticket.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+#ifndef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/wc_port.h>
+#include <wolfssl/ssl.h>
+#include <wolfssl/test.h>
+
+#undef  USE_CERT_BUFFERS_256
+#define USE_CERT_BUFFERS_256
+#include <wolfssl/certs_test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#if !defined(SINGLE_THREADED) && defined(HAVE_SESSION_TICKET) && \
+    !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && !defined(NO_CERTS) && \
+    defined(HAVE_ECC) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFCRYPT_ONLY) && !defined(WOLFSSL_ASYNC_CRYPT)
+    #define TICKET_BENCH
+#endif
+
+/* Defaults for configuration parameters */
+#define TICKET_BENCH_SESSIONS   64    /* Sessions established */
+#define TICKET_BENCH_THREADS    8     /* Maximum number of resuming threads */
+#define TICKET_BENCH_RESUMES    5000  /* Resumptions per thread */
+#define TICKET_BENCH_BUF_SZ     8192  /* Size of memory buffer per direction */
+
+/* Global vars for argument parsing */
+int myoptind = 0;
+char* myoptarg = NULL;
+
+#ifdef TICKET_BENCH
+
+/* Name of cipher used by the default ticket callback. */
+#if defined(WOLFSSL_TICKET_ENC_CBC_HMAC)
+    #define TICKET_BENCH_CIPHER     "AES-CBC/HMAC"
+#elif defined(HAVE_CHACHA) && defined(HAVE_POLY1305) && \
+    !defined(WOLFSSL_TICKET_ENC_AES128_GCM) && \
+    !defined(WOLFSSL_TICKET_ENC_AES256_GCM)
+    #define TICKET_BENCH_CIPHER     "ChaCha20-Poly1305"
+#elif defined(HAVE_AESGCM) && defined(WOLFSSL_TICKET_ENC_AES256_GCM)
+    #define TICKET_BENCH_CIPHER     "AES-256-GCM"
+#elif defined(HAVE_AESGCM)
+    #define TICKET_BENCH_CIPHER     "AES-128-GCM"
+#else
+    #define TICKET_BENCH_CIPHER     "SM4-GCM"
+#endif
+
+/* Data sent in one direction over memory. */
+typedef struct {
+    byte buf[TICKET_BENCH_BUF_SZ];
+    int  len;
+} bench_pipe_t;
+
+/* Both directions of a connection. */
+typedef struct {
+    bench_pipe_t toSrv;
+    bench_pipe_t toCli;
+} bench_conn_t;
+
+typedef struct {
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL_SESSION** sessions;
+    int sessCnt;
+    int first;  /* Index of first session to resume */
+    int step;   /* Distance to next session to resume */
+    int resumes;
+    int failed;
+    int missed; /* Full handshakes instead of resumption */
+} bench_thread_t;
+
+static double gettime_secs(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000;
+}
+
+static int bench_pipe_send(bench_pipe_t* pipe, const char* data, int sz)
+{
+    if (sz > TICKET_BENCH_BUF_SZ - pipe->len) {
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    }
+    XMEMCPY(pipe->buf + pipe->len, data, (size_t)sz);
+    pipe->len += sz;
+
+    return sz;
+}
+
+static int bench_pipe_recv(bench_pipe_t* pipe, char* data, int sz)
+{
+    if (pipe->len == 0) {
+        return WOLFSSL_CBIO_ERR_WANT_READ;
+    }
+    if (sz > pipe->len) {
+        sz = pipe->len;
+    }
+    XMEMCPY(data, pipe->buf, (size_t)sz);
+    pipe->len -= sz;
+    XMEMMOVE(pipe->buf, pipe->buf + sz, (size_t)pipe->len);
+
+    return sz;
+}
+
+static int bench_cli_send(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    (void)ssl;
+    return bench_pipe_send(&((bench_conn_t*)ctx)->toSrv, buf, sz);
+}
+
+static int bench_cli_recv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    (void)ssl;
+    return bench_pipe_recv(&((bench_conn_t*)ctx)->toCli, buf, sz);
+}
+
+static int bench_srv_send(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    (void)ssl;
+    return bench_pipe_send(&((bench_conn_t*)ctx)->toCli, buf, sz);
+}
+
+static int bench_srv_recv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    (void)ssl;
+    return bench_pipe_recv(&((bench_conn_t*)ctx)->toSrv, buf, sz);
+}
+
+/* Perform a handshake between a client and server over memory.
+ *
+ * When session is not NULL the client attempts to resume it.
+ * On success and when out is not NULL, the client's session is returned.
+ */
+static int bench_handshake(WOLFSSL_CTX* cliCtx, WOLFSSL_CTX* srvCtx,
+    WOLFSSL_SESSION* session, WOLFSSL_SESSION** out, int* resumed)
+{
+    int ret = 0;
+    int i;
+    int cliDone = 0;
+    int srvDone = 0;
+    WOLFSSL* cli = NULL;
+    WOLFSSL* srv = NULL;
+    bench_conn_t conn;
+
+    conn.toSrv.len = 0;
+    conn.toCli.len = 0;
+
+    cli = wolfSSL_new(cliCtx);
+    srv = wolfSSL_new(srvCtx);
+    if ((cli == NULL) || (srv == NULL)) {
+        ret = MEMORY_E;
+    }
+    if (ret == 0) {
+        wolfSSL_SSLSetIOSend(cli, bench_cli_send);
+        wolfSSL_SSLSetIORecv(cli, bench_cli_recv);
+        wolfSSL_SetIOWriteCtx(cli, &conn);
+        wolfSSL_SetIOReadCtx(cli, &conn);
+        wolfSSL_SSLSetIOSend(srv, bench_srv_send);
+        wolfSSL_SSLSetIORecv(srv, bench_srv_recv);
+        wolfSSL_SetIOWriteCtx(srv, &conn);
+        wolfSSL_SetIOReadCtx(srv, &conn);
+        if ((session != NULL) &&
+                (wolfSSL_set_session(cli, session) != WOLFSSL_SUCCESS)) {
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+    /* Step client and server until both are done. */
+    for (i = 0; (ret == 0) && (i < 32) && !(cliDone && srvDone); i++) {
+        int err;
+
+        if (!cliDone) {
+            err = wolfSSL_connect(cli);
+            if (err == WOLFSSL_SUCCESS) {
+                cliDone = 1;
+            }
+            else if (wolfSSL_get_error(cli, err) != WOLFSSL_ERROR_WANT_READ) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+        }
+        if ((ret == 0) && !srvDone) {
+            err = wolfSSL_accept(srv);
+            if (err == WOLFSSL_SUCCESS) {
+                srvDone = 1;
+            }
+            else if (wolfSSL_get_error(srv, err) != WOLFSSL_ERROR_WANT_READ) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+        }
+    }
+    if ((ret == 0) && !(cliDone && srvDone)) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        if (resumed != NULL) {
+            *resumed = wolfSSL_session_reused(cli);
+        }
+        if (out != NULL) {
+            *out = wolfSSL_get1_session(cli);
+            if (*out == NULL) {
+                ret = WOLFSSL_FATAL_ERROR;
+            }
+        }
+    }
+
+    wolfSSL_free(srv);
+    wolfSSL_free(cli);
+
+    return ret;
+}
+
+static THREAD_RETURN WOLFSSL_THREAD bench_resume_thread(void* args)
+{
+    bench_thread_t* info = (bench_thread_t*)args;
+    int i;
+    int idx = info->first;
+    int resumed;
+
+    for (i = 0; i < info->resumes; i++) {
+        resumed = 0;
+        if (bench_handshake(info->cliCtx, info->srvCtx, info->sessions[idx],
+                NULL, &resumed) != 0) {
+            info->failed++;
+        }
+        else if (!resumed) {
+            info->missed++;
+        }
+        idx += info->step;
+        if (idx >= info->sessCnt) {
+            idx = info->first;
+        }
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Resume with threadCnt threads. Returns resumptions per second. */
+static double bench_resume(WOLFSSL_CTX* cliCtx, WOLFSSL_CTX* srvCtx,
+    WOLFSSL_SESSION** sessions, int sessCnt, int threadCnt, int resumes,
+    int* failed, int* missed)
+{
+    THREAD_TYPE threads[64];
+    bench_thread_t info[64];
+    double start;
+    int i;
+
+    /* Each thread resumes its own sessions. */
+    for (i = 0; i < threadCnt; i++) {
+        info[i].cliCtx = cliCtx;
+        info[i].srvCtx = srvCtx;
+        info[i].sessions = sessions;
+        info[i].sessCnt = sessCnt;
+        info[i].first = i;
+        info[i].step = threadCnt;
+        info[i].resumes = resumes;
+        info[i].failed = 0;
+        info[i].missed = 0;
+    }
+
+    start = gettime_secs();
+    for (i = 0; i < threadCnt; i++) {
+        THREAD_CHECK_RET(wolfSSL_NewThread(&threads[i], bench_resume_thread,
+            &info[i]));
+    }
+    for (i = 0; i < threadCnt; i++) {
+        THREAD_CHECK_RET(wolfSSL_JoinThread(threads[i]));
+        *failed += info[i].failed;
+        *missed += info[i].missed;
+    }
+
+    return (double)threadCnt * resumes / (gettime_secs() - start);
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "ticket_bench " LIBWOLFSSL_VERSION_STRING "\n");
+    fprintf(stderr, "-?          Help, print this usage\n");
+    fprintf(stderr, "-s <num>    Number of sessions (default %d)\n",
+        TICKET_BENCH_SESSIONS);
+    fprintf(stderr, "-t <num>    Maximum number of threads [1-64] "
+        "(default %d)\n", TICKET_BENCH_THREADS);
+    fprintf(stderr, "-n <num>    Resumptions per thread (default %d)\n",
+        TICKET_BENCH_RESUMES);
+}
+
+static int bench_ticket(int argc, char** argv)
+{
+    int ret = 0;
+    int ch;
+    int i;
+    int threadCnt;
+    int failed = 0;
+    int missed = 0;
+    double rate;
+    double base = 0;
+    WOLFSSL_CTX* cliCtx = NULL;
+    WOLFSSL_CTX* srvCtx = NULL;
+    WOLFSSL_SESSION** sessions = NULL;
+    int argSessions = TICKET_BENCH_SESSIONS;
+    int argThreads = TICKET_BENCH_THREADS;
+    int argResumes = TICKET_BENCH_RESUMES;
+
+    while ((ch = mygetopt(argc, argv, "?s:t:n:")) != -1) {
+        switch (ch) {
+            case 's':
+                argSessions = atoi(myoptarg);
+                break;
+            case 't':
+                argThreads = atoi(myoptarg);
+                break;
+            case 'n':
+                argResumes = atoi(myoptarg);
+                break;
+            case '?':
+            default:
+                Usage();
+                return 0;
+        }
+    }
+    if ((argSessions <= 0) || (argThreads <= 0) || (argThreads > 64) ||
+            (argResumes <= 0)) {
+        Usage();
+        return -1;
+    }
+    if (argSessions < argThreads) {
+        argSessions = argThreads;
+    }
+
+    srvCtx = wolfSSL_CTX_new(wolfTLSv1_2_server_method());
+    cliCtx = wolfSSL_CTX_new(wolfTLSv1_2_client_method());
+    if ((srvCtx == NULL) || (cliCtx == NULL)) {
+        ret = MEMORY_E;
+    }
+    if ((ret == 0) && (wolfSSL_CTX_use_certificate_buffer(srvCtx,
+            serv_ecc_der_256, sizeof_serv_ecc_der_256,
+            WOLFSSL_FILETYPE_ASN1) != WOLFSSL_SUCCESS)) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if ((ret == 0) && (wolfSSL_CTX_use_PrivateKey_buffer(srvCtx,
+            ecc_key_der_256, sizeof_ecc_key_der_256,
+            WOLFSSL_FILETYPE_ASN1) != WOLFSSL_SUCCESS)) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if ((ret == 0) && (wolfSSL_CTX_UseSessionTicket(cliCtx) !=
+            WOLFSSL_SUCCESS)) {
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+    if (ret == 0) {
+        wolfSSL_CTX_set_verify(cliCtx, WOLFSSL_VERIFY_NONE, NULL);
+        /* Only the ticket can resume a session. */
+        (void)wolfSSL_CTX_set_session_cache_mode(srvCtx,
+            WOLFSSL_SESS_CACHE_OFF);
+        sessions = (WOLFSSL_SESSION**)XMALLOC(sizeof(WOLFSSL_SESSION*) *
+            (size_t)argSessions, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        if (sessions == NULL) {
+            ret = MEMORY_E;
+        }
+        else {
+            XMEMSET(sessions, 0, sizeof(WOLFSSL_SESSION*) *
+                (size_t)argSessions);
+        }
+    }
+
+    /* Full handshakes to get tickets. */
+    for (i = 0; (ret == 0) && (i < argSessions); i++) {
+        ret = bench_handshake(cliCtx, srvCtx, NULL, &sessions[i], NULL);
+    }
+
+    if (ret == 0) {
+        printf("Ticket cipher %s, %d sessions\n", TICKET_BENCH_CIPHER,
+            argSessions);
+        printf("%-8s  %15s  %8s\n", "threads", "resumes/sec", "scaling");
+        for (threadCnt = 1; threadCnt <= argThreads; threadCnt *= 2) {
+            rate = bench_resume(cliCtx, srvCtx, sessions, argSessions,
+                threadCnt, argResumes, &failed, &missed);
+            if (threadCnt == 1) {
+                base = rate;
+            }
+            printf("%-8d  %15.0f  %8.2f\n", threadCnt, rate, rate / base);
+            if ((threadCnt < argThreads) && (threadCnt * 2 > argThreads)) {
+                /* Always run with the maximum number of threads. */
+                threadCnt = argThreads / 2;
+            }
+        }
+        if (missed != 0) {
+            printf("%d handshakes did not resume\n", missed);
+        }
+        if (failed != 0) {
+            fprintf(stderr, "%d handshakes failed\n", failed);
+            ret = -1;
+        }
+    }
+    if (ret != 0) {
+        fprintf(stderr, "ticket_bench failed: %d\n", ret);
+    }
+
+    if (sessions != NULL) {
+        for (i = 0; i < argSessions; i++) {
+            wolfSSL_SESSION_free(sessions[i]);
+        }
+        XFREE(sessions, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    wolfSSL_CTX_free(cliCtx);
+    wolfSSL_CTX_free(srvCtx);
+
+    return ret;
+}
+
+#endif /* TICKET_BENCH */
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+#ifdef TICKET_BENCH
+    wolfSSL_Init();
+    ret = bench_ticket(argc, argv);
+    wolfSSL_Cleanup();
+#else
+    (void)argc;
+    (void)argv;
+    printf("ticket_bench requires threads, session tickets with the default "
+        "ticket callback, TLS 1.2 and ECC\n");
+#endif
+
+    return (ret == 0) ? 0 : 1;
+}
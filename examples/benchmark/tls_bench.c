@@ -93,6 +93,16 @@ platform supports it"
 #define BENCH_USE_NONBLOCK
 #endif
 
+/* Many concurrent connections mode waits with epoll or io_uring. */
+#if defined(__linux__) && !defined(SINGLE_THREADED) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    defined(WOLFSSL_THREAD_NO_JOIN)
+    #define BENCH_MANY_CONNS
+    #include <sys/epoll.h>
+    #include <sys/resource.h>
+    #include <fcntl.h>
+#endif
+
 /* Defaults for configuration parameters */
 #define BENCH_DEFAULT_HOST  "localhost"
 #define BENCH_DEFAULT_PORT  11112
@@ -1694,6 +1704,621 @@ static THREAD_RETURN WOLFSSL_THREAD_NO_JOIN server_thread(void* args)
 #endif /* !SINGLE_THREADED */
 #endif /* !NO_WOLFSSL_SERVER */
 
+#ifdef BENCH_MANY_CONNS
+/* Many concurrent connections mode (-C): each side drives all of its
+ * connections from one thread. By default the sockets are non-blocking and
+ * waited on with epoll. With -U all socket I/O of a side goes through one
+ * io_uring. The I/O system calls made by each side are counted. */
+
+enum {
+    CONN_HANDSHAKE,
+    CONN_WRITE,
+    CONN_READ,
+    CONN_DONE
+};
+
+struct conns_t;
+
+typedef struct {
+    struct conns_t* owner;
+    WOLFSSL* ssl;
+    int fd;
+    int state;
+    int rounds; /* echo round trips left */
+    int rxIdx;
+    word32 events; /* epoll events waited on */
+} conn_t;
+
+typedef struct conns_t {
+    info_t* info;
+    int server;
+    int connCnt;
+    int rounds;
+    int useUring;
+    int uringFlags;
+    int listenFd;
+    conn_t* conns;
+    conn_t** byFd;
+    int maxFd;
+    byte* buf;
+    word32 ioCalls; /* socket and wait system calls */
+    int handshakes;
+    double start;
+    double hsTime; /* time the last handshake completed */
+    double time;
+    long bytes;
+    struct conns_t* peer;
+    volatile int connected;
+    volatile int done;
+    volatile int closed;
+} conns_t;
+
+static int ConnsRecv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    conn_t* conn = (conn_t*)ctx;
+    conn->owner->ioCalls++;
+    return EmbedReceive(ssl, buf, sz, &conn->fd);
+}
+
+static int ConnsSend(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    conn_t* conn = (conn_t*)ctx;
+    conn->owner->ioCalls++;
+    return EmbedSend(ssl, buf, sz, &conn->fd);
+}
+
+static WOLFSSL_CTX* ConnsCtxNew(info_t* info, int server)
+{
+    WOLFSSL_CTX* ctx;
+    int ret = WOLFSSL_SUCCESS;
+    int tls13 = XSTRNCMP(info->cipher, "TLS13", 5) == 0;
+    int ecc = 0;
+
+#ifdef WOLFSSL_TLS13
+    if (tls13) {
+        ctx = wolfSSL_CTX_new(server ? wolfTLSv1_3_server_method() :
+                                       wolfTLSv1_3_client_method());
+    }
+    else
+#endif
+    {
+    #if !defined(WOLFSSL_TLS13)
+        ctx = wolfSSL_CTX_new(server ? wolfSSLv23_server_method() :
+                                       wolfSSLv23_client_method());
+    #elif !defined(WOLFSSL_NO_TLS12)
+        ctx = wolfSSL_CTX_new(server ? wolfTLSv1_2_server_method() :
+                                       wolfTLSv1_2_client_method());
+    #else
+        ctx = NULL;
+    #endif
+    }
+    (void)tls13;
+    if (ctx == NULL) {
+        return NULL;
+    }
+
+#ifdef HAVE_ECC
+    ecc = XSTRSTR(info->cipher, "ECDSA") != NULL;
+#endif
+#ifndef NO_CERTS
+    if (server) {
+        ret = ecc ?
+        #ifdef HAVE_ECC
+            wolfSSL_CTX_use_PrivateKey_buffer(ctx, ecc_key_der_256,
+                sizeof_ecc_key_der_256, WOLFSSL_FILETYPE_ASN1) :
+        #else
+            WOLFSSL_FAILURE :
+        #endif
+            wolfSSL_CTX_use_PrivateKey_buffer(ctx, server_key_der_2048,
+                sizeof_server_key_der_2048, WOLFSSL_FILETYPE_ASN1);
+        if (ret == WOLFSSL_SUCCESS) {
+            ret = ecc ?
+            #ifdef HAVE_ECC
+                wolfSSL_CTX_use_certificate_buffer(ctx, serv_ecc_der_256,
+                    sizeof_serv_ecc_der_256, WOLFSSL_FILETYPE_ASN1) :
+            #else
+                WOLFSSL_FAILURE :
+            #endif
+                wolfSSL_CTX_use_certificate_buffer(ctx, server_cert_der_2048,
+                    sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1);
+        }
+    }
+    else {
+        ret = ecc ?
+        #ifdef HAVE_ECC
+            wolfSSL_CTX_load_verify_buffer(ctx, ca_ecc_cert_der_256,
+                sizeof_ca_ecc_cert_der_256, WOLFSSL_FILETYPE_ASN1) :
+        #else
+            WOLFSSL_FAILURE :
+        #endif
+            wolfSSL_CTX_load_verify_buffer(ctx, ca_cert_der_2048,
+                sizeof_ca_cert_der_2048, WOLFSSL_FILETYPE_ASN1);
+    }
+#endif /* !NO_CERTS */
+    (void)ecc;
+
+    if (ret == WOLFSSL_SUCCESS) {
+        ret = wolfSSL_CTX_set_cipher_list(ctx, info->cipher);
+    }
+#ifndef NO_DH
+    if (ret == WOLFSSL_SUCCESS) {
+        ret = wolfSSL_CTX_SetMinDhKey_Sz(ctx, MIN_DHKEY_BITS);
+    }
+    if (ret == WOLFSSL_SUCCESS && server) {
+        ret = wolfSSL_CTX_SetTmpDH(ctx, dhp, sizeof(dhp), dhg, sizeof(dhg));
+    }
+#endif
+#ifndef NO_PSK
+    if (server) {
+        wolfSSL_CTX_set_psk_server_callback(ctx, my_psk_server_cb);
+    #ifdef WOLFSSL_TLS13
+        wolfSSL_CTX_set_psk_server_tls13_callback(ctx, my_psk_server_tls13_cb);
+    #endif
+    }
+    else {
+        wolfSSL_CTX_set_psk_client_callback(ctx, my_psk_client_cb);
+    #ifdef WOLFSSL_TLS13
+    #if !defined(WOLFSSL_PSK_TLS13_CB) && !defined(WOLFSSL_PSK_ONE_ID)
+        wolfSSL_CTX_set_psk_client_cs_callback(ctx, my_psk_client_cs_cb);
+    #else
+        wolfSSL_CTX_set_psk_client_tls13_callback(ctx, my_psk_client_tls13_cb);
+    #endif
+    #endif
+        wolfSSL_CTX_set_psk_callback_ctx(ctx, (void*)info->cipher);
+    }
+#endif /* !NO_PSK */
+    if (ret != WOLFSSL_SUCCESS) {
+        wolfSSL_CTX_free(ctx);
+        ctx = NULL;
+    }
+    return ctx;
+}
+
+/* Make as much progress as possible on a connection.
+ *
+ * @return  1 when all round trips are done.
+ * @return  0 when waiting on I/O.
+ * @return  -1 on error.
+ */
+static int ConnsStep(conns_t* c, conn_t* conn)
+{
+    int ret = 0;
+    int err;
+
+    while (conn->state != CONN_DONE) {
+        if (conn->state == CONN_HANDSHAKE) {
+            ret = c->server ? wolfSSL_accept(conn->ssl) :
+                              wolfSSL_connect(conn->ssl);
+            if (ret == WOLFSSL_SUCCESS) {
+                conn->state = c->server ? CONN_READ : CONN_WRITE;
+                if (++c->handshakes == c->connCnt) {
+                    c->hsTime = gettime_secs(0) - c->start;
+                }
+                continue;
+            }
+        }
+        else if (conn->state == CONN_WRITE) {
+            ret = wolfSSL_write(conn->ssl, c->buf, c->info->packetSize);
+            if (ret > 0) {
+                c->bytes += ret;
+                conn->state = (c->server && --conn->rounds == 0) ?
+                    CONN_DONE : CONN_READ;
+                continue;
+            }
+        }
+        else {
+            ret = wolfSSL_read(conn->ssl, c->buf + conn->rxIdx,
+                c->info->packetSize - conn->rxIdx);
+            if (ret > 0) {
+                c->bytes += ret;
+                conn->rxIdx += ret;
+                if (conn->rxIdx == c->info->packetSize) {
+                    conn->rxIdx = 0;
+                    conn->state = (!c->server && --conn->rounds == 0) ?
+                        CONN_DONE : CONN_WRITE;
+                }
+                continue;
+            }
+        }
+
+        err = wolfSSL_get_error(conn->ssl, ret);
+        if (err == WOLFSSL_ERROR_WANT_READ || err == WOLFSSL_ERROR_WANT_WRITE) {
+            return 0;
+        }
+        fprintf(stderr, "%s connection error %d\n",
+            c->server ? "Server" : "Client", err);
+        return -1;
+    }
+    return 1;
+}
+
+static int ConnsRunEpoll(conns_t* c)
+{
+    struct epoll_event* evs;
+    struct epoll_event ev;
+    int efd;
+    int active = c->connCnt;
+    int ret = 0;
+    int i, n;
+
+    evs = (struct epoll_event*)XMALLOC(sizeof(*evs) * (size_t)c->connCnt,
+        NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    efd = epoll_create1(0);
+    if (evs == NULL || efd < 0) {
+        ret = -1;
+    }
+    for (i = 0; ret == 0 && i < c->connCnt; i++) {
+        c->conns[i].events = EPOLLIN;
+        ev.events = EPOLLIN;
+        ev.data.ptr = &c->conns[i];
+        if (epoll_ctl(efd, EPOLL_CTL_ADD, c->conns[i].fd, &ev) != 0) {
+            ret = -1;
+        }
+    }
+    if (ret != 0) {
+        active = 0;
+    }
+
+    c->start = gettime_secs(1);
+
+    /* Start every connection then service the ones that can progress. */
+    for (i = 0; i < active; i++) {
+        evs[i].data.ptr = &c->conns[i];
+    }
+    n = active;
+    while (ret == 0 && active > 0) {
+        for (i = 0; i < n; i++) {
+            conn_t* conn = (conn_t*)evs[i].data.ptr;
+            word32 want;
+
+            if (conn->state == CONN_DONE) {
+                continue;
+            }
+            ret = ConnsStep(c, conn);
+            if (ret < 0) {
+                break;
+            }
+            if (ret > 0) {
+                active--;
+                ret = 0;
+                continue;
+            }
+            want = (wolfSSL_get_error(conn->ssl, 0) ==
+                    WOLFSSL_ERROR_WANT_WRITE) ? EPOLLOUT : EPOLLIN;
+            if (want != conn->events) {
+                conn->events = want;
+                ev.events = want;
+                ev.data.ptr = conn;
+                c->ioCalls++;
+                if (epoll_ctl(efd, EPOLL_CTL_MOD, conn->fd, &ev) != 0) {
+                    ret = -1;
+                    break;
+                }
+            }
+        }
+        if (ret == 0 && active > 0) {
+            c->ioCalls++;
+            n = epoll_wait(efd, evs, c->connCnt, -1);
+            if (n < 0) {
+                n = 0;
+                if (errno != EINTR) {
+                    ret = -1;
+                }
+            }
+        }
+    }
+    c->time = gettime_secs(0) - c->start;
+
+    if (efd >= 0) {
+        close(efd);
+    }
+    XFREE(evs, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    return ret;
+}
+
+#ifdef WOLFSSL_IO_URING
+static int ConnsRunUring(conns_t* c, WOLFSSL_URING* ring)
+{
+    WOLFSSL** ready;
+    WOLFSSL_URING_STATS stats;
+    int active = c->connCnt;
+    int ret = 0;
+    int i, n;
+
+    ready = (WOLFSSL**)XMALLOC(sizeof(*ready) * (size_t)c->connCnt, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (ready == NULL) {
+        return -1;
+    }
+
+    c->start = gettime_secs(1);
+
+    for (i = 0; i < c->connCnt; i++) {
+        ready[i] = c->conns[i].ssl;
+    }
+    n = c->connCnt;
+    while (ret == 0 && active > 0) {
+        for (i = 0; i < n; i++) {
+            conn_t* conn = c->byFd[wolfSSL_get_fd(ready[i])];
+
+            if (conn->state == CONN_DONE) {
+                continue;
+            }
+            ret = ConnsStep(c, conn);
+            if (ret < 0) {
+                break;
+            }
+            if (ret > 0) {
+                active--;
+                ret = 0;
+            }
+        }
+        if (ret == 0) {
+            n = wolfSSL_IoUring_Submit(ring, 1, ready, c->connCnt);
+            if (n < 0) {
+                ret = -1;
+            }
+        }
+    }
+    c->time = gettime_secs(0) - c->start;
+
+    /* Make sure the last echoes have been sent. */
+    for (i = 0; ret == 0 && i < c->connCnt; i++) {
+        while (ret == 0 && wolfSSL_IoUring_Pending(c->conns[i].ssl) > 0) {
+            if (wolfSSL_IoUring_Submit(ring, 1, ready, c->connCnt) < 0) {
+                ret = -1;
+            }
+        }
+    }
+
+    if (wolfSSL_IoUring_GetStats(ring, &stats) == WOLFSSL_SUCCESS) {
+        c->ioCalls = stats.enters;
+        if (c->uringFlags != 0 && !stats.fixed) {
+            fprintf(stderr, "%s: io_uring buffers not registered\n",
+                c->server ? "Server" : "Client");
+        }
+    }
+
+    XFREE(ready, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    return ret;
+}
+#endif /* WOLFSSL_IO_URING */
+
+/* Set up the connections of one side then run the benchmark on them. */
+static int ConnsRun(conns_t* c)
+{
+    WOLFSSL_CTX* ctx = NULL;
+#ifdef WOLFSSL_IO_URING
+    WOLFSSL_URING* ring = NULL;
+#endif
+    int ret = 0;
+    int i;
+
+    ctx = ConnsCtxNew(c->info, c->server);
+    if (ctx == NULL) {
+        fprintf(stderr, "error creating ctx\n");
+        ret = -1;
+    }
+#ifdef WOLFSSL_IO_URING
+    if (ret == 0 && c->useUring) {
+        ring = wolfSSL_IoUring_new(c->connCnt, c->uringFlags, NULL);
+        if (ring == NULL) {
+            fprintf(stderr, "error creating io_uring\n");
+            ret = -1;
+        }
+    }
+#endif
+    if (ret == 0 && !c->useUring) {
+        wolfSSL_CTX_SetIORecv(ctx, ConnsRecv);
+        wolfSSL_CTX_SetIOSend(ctx, ConnsSend);
+    }
+
+    /* Establish the TCP connections - not measured. */
+    for (i = 0; ret == 0 && i < c->connCnt; i++) {
+        conn_t* conn = &c->conns[i];
+
+        conn->owner = c;
+        conn->rounds = c->rounds;
+        if (c->server) {
+            conn->fd = accept(c->listenFd, NULL, NULL);
+        }
+        else {
+            struct sockaddr_in addr;
+
+            XMEMSET(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons((word16)c->info->port);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            conn->fd = socket(AF_INET, SOCK_STREAM, 0);
+            if (conn->fd >= 0 && connect(conn->fd, (struct sockaddr*)&addr,
+                    sizeof(addr)) != 0) {
+                close(conn->fd);
+                conn->fd = -1;
+            }
+        }
+        if (conn->fd < 0 || conn->fd >= c->maxFd) {
+            fprintf(stderr, "error %s connection %d: %d\n",
+                c->server ? "accepting" : "connecting", i, errno);
+            ret = -1;
+            break;
+        }
+        c->byFd[conn->fd] = conn;
+        if (fcntl(conn->fd, F_SETFL, O_NONBLOCK) != 0) {
+            ret = -1;
+            break;
+        }
+
+        conn->ssl = wolfSSL_new(ctx);
+        if (conn->ssl == NULL ||
+                wolfSSL_set_fd(conn->ssl, conn->fd) != WOLFSSL_SUCCESS) {
+            ret = -1;
+            break;
+        }
+    #if defined(WOLFSSL_TLS13) && defined(HAVE_SUPPORTED_CURVES)
+        if (!c->server && c->info->group != 0 &&
+                wolfSSL_UseKeyShare(conn->ssl, c->info->group) !=
+                WOLFSSL_SUCCESS) {
+            ret = -1;
+            break;
+        }
+    #endif
+    #ifdef WOLFSSL_IO_URING
+        if (c->useUring) {
+            if (wolfSSL_SetIO_IoUring(conn->ssl, ring) != WOLFSSL_SUCCESS) {
+                ret = -1;
+                break;
+            }
+        }
+        else
+    #endif
+        {
+            wolfSSL_SetIOReadCtx(conn->ssl, conn);
+            wolfSSL_SetIOWriteCtx(conn->ssl, conn);
+        }
+    }
+    if (ret != 0) {
+        /* Stop the peer waiting on connections. */
+        (void)shutdown(c->listenFd, SHUT_RDWR);
+    }
+    c->connected = 1;
+
+    /* Start measuring when both sides have all their connections. */
+    while (ret == 0 && !c->peer->connected) {
+        XSLEEP_MS(1);
+    }
+    if (ret == 0) {
+    #ifdef WOLFSSL_IO_URING
+        if (c->useUring) {
+            ret = ConnsRunUring(c, ring);
+        }
+        else
+    #endif
+        {
+            ret = ConnsRunEpoll(c);
+        }
+    }
+    c->done = 1;
+
+    /* Keep the sockets open until the peer has finished. */
+    while (ret == 0 && !c->peer->done) {
+        XSLEEP_MS(1);
+    }
+
+    for (i = 0; i < c->connCnt; i++) {
+        wolfSSL_free(c->conns[i].ssl);
+        if (c->conns[i].fd >= 0) {
+            close(c->conns[i].fd);
+        }
+    }
+#ifdef WOLFSSL_IO_URING
+    wolfSSL_IoUring_free(ring);
+#endif
+    wolfSSL_CTX_free(ctx);
+    c->closed = 1;
+
+    return ret;
+}
+
+static THREAD_RETURN WOLFSSL_THREAD_NO_JOIN conns_server_thread(void* args)
+{
+    (void)ConnsRun((conns_t*)args);
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+static void ConnsPrint(conns_t* c, const char* desc, const char* cipher)
+{
+    fprintf(stderr,
+            "%-6s  %-33s  %9d  %16.3f  %11.3f  %11ld  %9.3f  %12u  %10.2f\n",
+            desc, cipher, c->connCnt, c->hsTime * 1000, c->time * 1000,
+            c->bytes, c->bytes / c->time / 1024 / 1024, c->ioCalls,
+            (double)c->ioCalls / c->connCnt);
+}
+
+/* Benchmark many concurrent connections between a server thread and a
+ * client thread. */
+static int bench_tls_conns(info_t* info, int connCnt, int useUring,
+    int uringFlags)
+{
+    conns_t* sides;
+    struct rlimit rl;
+    int ret = 0;
+    int i;
+
+    /* Both ends of every connection are in this process. */
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        (void)setrlimit(RLIMIT_NOFILE, &rl);
+    }
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0 ||
+            (rlim_t)connCnt * 2 + 32 > rl.rlim_cur) {
+        fprintf(stderr, "Too many connections for the descriptor limit\n");
+        return MY_EX_USAGE;
+    }
+
+    sides = (conns_t*)XMALLOC(sizeof(conns_t) * 2, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (sides == NULL) {
+        return MEMORY_E;
+    }
+    XMEMSET(sides, 0, sizeof(conns_t) * 2);
+    for (i = 0; i < 2; i++) {
+        conns_t* c = &sides[i];
+
+        c->info = info;
+        c->server = (i == 0);
+        c->peer = &sides[1 - i];
+        c->connCnt = connCnt;
+        c->rounds = info->maxSize / info->packetSize;
+        if (c->rounds <= 0) {
+            c->rounds = 1;
+        }
+        c->useUring = useUring;
+        c->uringFlags = uringFlags;
+        c->listenFd = info->listenFd;
+        c->maxFd = (int)rl.rlim_cur;
+        c->conns = (conn_t*)XMALLOC(sizeof(conn_t) * (size_t)connCnt, NULL,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        c->byFd = (conn_t**)XMALLOC(sizeof(conn_t*) * (size_t)c->maxFd, NULL,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        c->buf = (byte*)XMALLOC((size_t)info->packetSize, NULL,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        if (c->conns == NULL || c->byFd == NULL || c->buf == NULL) {
+            ret = MEMORY_E;
+            break;
+        }
+        XMEMSET(c->conns, 0, sizeof(conn_t) * (size_t)connCnt);
+        XMEMSET(c->byFd, 0, sizeof(conn_t*) * (size_t)c->maxFd);
+        XMEMSET(c->buf, 0x5a, (size_t)info->packetSize);
+    }
+
+    if (ret == 0) {
+        THREAD_CHECK_RET(wolfSSL_NewThreadNoJoin(conns_server_thread,
+            &sides[0]));
+        ret = ConnsRun(&sides[1]);
+        /* Wait for the server to free its connections. */
+        while (!sides[0].closed) {
+            XSLEEP_MS(1);
+        }
+    }
+    if (ret == 0) {
+        fprintf(stderr, "%-6s  %-33s  %9s  %16s  %11s  %11s  %9s  %12s  "
+                "%10s\n", "Side", "Cipher", "Num Conns", "Handshakes ms",
+                "Total ms", "Total Bytes", "MB/s", "I/O syscalls",
+                "Per Conn");
+        ConnsPrint(&sides[0], "Server", info->cipher);
+        ConnsPrint(&sides[1], "Client", info->cipher);
+    }
+
+    for (i = 0; i < 2; i++) {
+        XFREE(sides[i].conns, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(sides[i].byFd, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        XFREE(sides[i].buf, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    XFREE(sides, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    return ret;
+}
+#endif /* BENCH_MANY_CONNS */
+
 
 static void print_stats(stats_t* wcStat, const char* desc, const char* cipher, const char *group, int verbose)
 {
@@ -1770,6 +2395,13 @@ static void Usage(void)
 #ifdef WOLFSSL_DTLS
     fprintf(stderr, "-u          Use DTLS\n");
 #endif
+#ifdef BENCH_MANY_CONNS
+    fprintf(stderr, "-C <num>    Run <num> concurrent connections from one server and one client thread\n");
+    #ifdef WOLFSSL_IO_URING
+    fprintf(stderr, "-U          With -C, do socket I/O through io_uring\n");
+    fprintf(stderr, "-F          With -U, register the io_uring buffers with the kernel\n");
+    #endif
+#endif
 }
 
 static void ShowCiphers(void)
@@ -1881,6 +2513,11 @@ int bench_tls(void* args)
     int group_index = 0;
     int argDoGroups = 0;
 #endif
+#ifdef BENCH_MANY_CONNS
+    int argConns = 0;
+    int argUring = 0;
+    int argUringFlags = 0;
+#endif
 
     if (args != NULL) {
         argc = ((func_args*)args)->argc;
@@ -1909,7 +2546,7 @@ int bench_tls(void* args)
 #endif /* HAVE_FIPS && HAVE_FIPS_VERSION == 5 */
 
     /* Parse command line arguments */
-    while ((ch = mygetopt(argc, argv, "?" "udeil:p:t:vT:sch:P:mS:g")) != -1) {
+    while ((ch = mygetopt(argc, argv, "?" "udeil:p:t:vT:sch:P:mS:gC:UF")) != -1) {
         switch (ch) {
             case '?' :
                 Usage();
@@ -2004,6 +2641,29 @@ int bench_tls(void* args)
                 #endif
             #endif
                 break;
+
+            case 'C':
+            #ifdef BENCH_MANY_CONNS
+                argConns = atoi(myoptarg);
+            #endif
+                break;
+
+            case 'U':
+            #if defined(BENCH_MANY_CONNS) && defined(WOLFSSL_IO_URING)
+                argUring = 1;
+            #else
+                fprintf(stderr, "io_uring support not compiled in\n");
+                Usage();
+                ret = MY_EX_USAGE; goto exit;
+            #endif
+                break;
+
+            case 'F':
+            #if defined(BENCH_MANY_CONNS) && defined(WOLFSSL_IO_URING)
+                argUringFlags = WOLFSSL_IO_URING_FIXED_BUFFERS;
+            #endif
+                break;
+
             default:
                 Usage();
                 ret = MY_EX_USAGE; goto exit;
@@ -2070,6 +2730,28 @@ int bench_tls(void* args)
     }
 #endif
 
+#ifdef BENCH_MANY_CONNS
+    if (argConns > 0) {
+        if (argServerOnly || argClientOnly || argLocalMem
+        #ifdef WOLFSSL_DTLS
+                || doDTLS
+        #endif
+                ) {
+            fprintf(stderr, "-C runs both sides over TCP sockets\n");
+            Usage();
+            ret = MY_EX_USAGE; goto exit;
+        }
+        ret = SetupSocketAndListen(&listenFd, argPort, 0);
+        /* All connections are made before the handshakes start. */
+        if (ret == 0 && listen(listenFd, SOMAXCONN) != 0) {
+            ret = -1;
+        }
+        if (ret != 0) {
+            goto exit;
+        }
+    }
+#endif
+
 #if defined(WOLFSSL_DTLS) && !defined(NO_WOLFSSL_SERVER)
     if (doDTLS) {
         if (argLocalMem) {
@@ -2103,6 +2785,25 @@ int bench_tls(void* args)
             fprintf(stderr, "Cipher: %s\n", cipher);
         }
 
+#ifdef BENCH_MANY_CONNS
+        if (argConns > 0) {
+            info = &theadInfo[0];
+            XMEMSET(info, 0, sizeof(info_t));
+            info->host = argHost;
+            info->port = argPort;
+            info->cipher = cipher;
+            info->packetSize = argTestPacketSize;
+            info->maxSize = argTestMaxSize;
+            info->listenFd = listenFd;
+            ret = bench_tls_conns(info, argConns, argUring, argUringFlags);
+            if (ret != 0) {
+                goto exit;
+            }
+            cipher = (next_cipher != NULL) ? (next_cipher + 1) : NULL;
+            continue;
+        }
+#endif
+
 #if defined(WOLFSSL_TLS13) && defined(HAVE_SUPPORTED_CURVES)
         for (group_index = 0; groups[group_index].name != NULL; group_index++) {
             const char *gname = theadInfo[0].group == 0 ? "N/A"
@@ -2289,7 +2990,11 @@ int bench_tls(void* args)
 exit:
 
 #ifndef NO_WOLFSSL_SERVER
-    if (argServerOnly && !argLocalMem) {
+    if ((argServerOnly && !argLocalMem)
+    #ifdef BENCH_MANY_CONNS
+            || argConns > 0
+    #endif
+            ) {
         /* Close server listener */
         CloseAndCleanupListenSocket(&listenFd);
     }
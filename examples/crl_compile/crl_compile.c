@@ -0,0 +1,339 @@
+/* crl_compile.c
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+#ifndef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/ssl.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(HAVE_CRL) && defined(WOLFSSL_CRL_COMPILED) && \
+    !defined(NO_FILESYSTEM)
+
+/* Increment allocated data by this much. */
+#define DATA_INC_LEN        4096
+
+/* Usage lines to show. */
+static const char* usage[] = {
+    "crl_compile [OPTION]...",
+    "Verify a CRL and compile it into the form searched in place by wolfSSL.",
+    "",
+    "Options:",
+    "  -?, --help       display this help and exit",
+    "  -ca              name of PEM file with CA certificates to verify CRL",
+    "  -in              name of CRL file to read",
+    "  -out             name of compiled CRL file to write",
+    "  -key             name of file with key to authenticate compiled CRL",
+    "  -d --der         CRL is DER encoded (PEM otherwise)",
+    "",
+    "The output is written to a temporary file and renamed so that a file",
+    "mapped by a running application is not modified.",
+    "The key file holds the raw key bytes that the application also sets with",
+    "wolfSSL_CertManagerSetCompiledCRLKey(). Keep it secret from anyone able",
+    "to write the compiled CRL file.",
+};
+/* Number of usage lines. */
+#define USAGE_SZ  ((int)(sizeof(usage) / sizeof(*usage)))
+
+/* Print out usage lines.
+ */
+static void Usage(void)
+{
+    int i;
+
+    for (i = 0; i < USAGE_SZ; i++) {
+        printf("%s\n", usage[i]);
+    }
+}
+
+/* Read the contents of a file into a dynamically allocated buffer.
+ *
+ * @param [in]  name   Name of file to read.
+ * @param [out] pdata  Pointer to data.
+ * @param [out] plen   Pointer to length.
+ * @return  0 on success.
+ * @return  1 on failure.
+ */
+static int ReadFile(const char* name, unsigned char** pdata, long* plen)
+{
+    int ret = 0;
+    long len = 0;
+    size_t read_len;
+    unsigned char* data = NULL;
+    FILE* fp;
+
+    fp = fopen(name, "rb");
+    if (fp == NULL) {
+        fprintf(stderr, "File not able to be read: %s\n", name);
+        return 1;
+    }
+    data = (unsigned char*)malloc(DATA_INC_LEN);
+    while ((data != NULL) &&
+            ((read_len = fread(data + len, 1, DATA_INC_LEN, fp)) != 0)) {
+        unsigned char* p;
+
+        len += (long)read_len;
+        if (feof(fp)) {
+            break;
+        }
+        p = (unsigned char*)realloc(data, (size_t)len + DATA_INC_LEN);
+        if (p == NULL) {
+            free(data);
+        }
+        data = p;
+    }
+    fclose(fp);
+
+    if (data == NULL) {
+        fprintf(stderr, "Out of memory reading: %s\n", name);
+        ret = 1;
+    }
+    else {
+        *pdata = data;
+        *plen = len;
+    }
+
+    return ret;
+}
+
+/* Write data to a temporary file and rename it to the name.
+ *
+ * @param [in] name  Name of file to write.
+ * @param [in] data  Data to write.
+ * @param [in] len   Length of data in bytes.
+ * @return  0 on success.
+ * @return  1 on failure.
+ */
+static int WriteFile(const char* name, const unsigned char* data, word32 len)
+{
+    int ret = 0;
+    FILE* fp;
+    char tmpName[1024];
+
+    if (XSNPRINTF(tmpName, sizeof(tmpName), "%s.tmp", name) >=
+            (int)sizeof(tmpName)) {
+        fprintf(stderr, "File name too long: %s\n", name);
+        return 1;
+    }
+    fp = fopen(tmpName, "wb");
+    if (fp == NULL) {
+        fprintf(stderr, "File not able to be written: %s\n", tmpName);
+        return 1;
+    }
+    if (fwrite(data, 1, len, fp) != len) {
+        fprintf(stderr, "Failed to write: %s\n", tmpName);
+        ret = 1;
+    }
+    if (fclose(fp) != 0) {
+        ret = 1;
+    }
+    if ((ret == 0) && (rename(tmpName, name) != 0)) {
+        fprintf(stderr, "Failed to rename %s to %s\n", tmpName, name);
+        ret = 1;
+    }
+    if (ret != 0) {
+        (void)remove(tmpName);
+    }
+
+    return ret;
+}
+
+/* Main entry of CRL compiling program.
+ *
+ * @param [in] argc  Count of command line arguments.
+ * @param [in] argv  Command line arguments.
+ * @return  0 on success.
+ * @return  1 on failure.
+ */
+int main(int argc, char* argv[])
+{
+    int ret = 0;
+    const char* ca_name = NULL;
+    const char* in_name = NULL;
+    const char* out_name = NULL;
+    const char* key_name = NULL;
+    int type = WOLFSSL_FILETYPE_PEM;
+    unsigned char* in = NULL;
+    long in_len = 0;
+    unsigned char* out = NULL;
+    word32 out_len = 0;
+    unsigned char* key = NULL;
+    long key_len = 0;
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+
+    /* Skip over program name. */
+    argc--;
+    argv++;
+    while (argc > 0) {
+        if (strcmp(argv[0], "-ca") == 0) {
+            argc--;
+            argv++;
+            if (argc == 0) {
+                fprintf(stderr, "No filename provided\n");
+                return 1;
+            }
+            ca_name = argv[0];
+        }
+        else if (strcmp(argv[0], "-in") == 0) {
+            argc--;
+            argv++;
+            if (argc == 0) {
+                fprintf(stderr, "No filename provided\n");
+                return 1;
+            }
+            in_name = argv[0];
+        }
+        else if (strcmp(argv[0], "-out") == 0) {
+            argc--;
+            argv++;
+            if (argc == 0) {
+                fprintf(stderr, "No filename provided\n");
+                return 1;
+            }
+            out_name = argv[0];
+        }
+        else if (strcmp(argv[0], "-key") == 0) {
+            argc--;
+            argv++;
+            if (argc == 0) {
+                fprintf(stderr, "No filename provided\n");
+                return 1;
+            }
+            key_name = argv[0];
+        }
+        else if ((strcmp(argv[0], "-d") == 0) ||
+                 (strcmp(argv[0], "--der") == 0)) {
+            type = WOLFSSL_FILETYPE_ASN1;
+        }
+        else if ((strcmp(argv[0], "-?") == 0) ||
+                 (strcmp(argv[0], "--help") == 0)) {
+            Usage();
+            return 0;
+        }
+        else {
+            fprintf(stderr, "Bad option: %s\n", argv[0]);
+            Usage();
+            return 1;
+        }
+
+        argc--;
+        argv++;
+    }
+    if ((ca_name == NULL) || (in_name == NULL) || (out_name == NULL) ||
+            (key_name == NULL)) {
+        fprintf(stderr, "CA, input, output and key files are required\n");
+        Usage();
+        return 1;
+    }
+
+    wolfSSL_Init();
+
+    cm = wolfSSL_CertManagerNew();
+    if (cm == NULL) {
+        fprintf(stderr, "Failed to create certificate manager\n");
+        ret = 1;
+    }
+    if ((ret == 0) && (wolfSSL_CertManagerLoadCA(cm, ca_name, NULL) !=
+            WOLFSSL_SUCCESS)) {
+        fprintf(stderr, "Failed to load CA certificates: %s\n", ca_name);
+        ret = 1;
+    }
+    if (ret == 0) {
+        ret = ReadFile(key_name, &key, &key_len);
+    }
+    if ((ret == 0) && (wolfSSL_CertManagerSetCompiledCRLKey(cm, key,
+            (word32)key_len) != WOLFSSL_SUCCESS)) {
+        fprintf(stderr, "Invalid key size: %ld\n", key_len);
+        ret = 1;
+    }
+    if (ret == 0) {
+        ret = ReadFile(in_name, &in, &in_len);
+    }
+    if (ret == 0) {
+        /* Get size of compiled CRL. */
+        ret = wolfSSL_CertManagerCompileCRL(cm, in, in_len, type, NULL,
+            &out_len);
+        if (ret == WC_NO_ERR_TRACE(LENGTH_ONLY_E)) {
+            ret = 0;
+            out = (unsigned char*)malloc(out_len);
+            if (out == NULL) {
+                fprintf(stderr, "Out of memory\n");
+                ret = 1;
+            }
+        }
+        else {
+            fprintf(stderr, "Failed to verify and compile CRL: %d\n", ret);
+            ret = 1;
+        }
+    }
+    if (ret == 0) {
+        ret = wolfSSL_CertManagerCompileCRL(cm, in, in_len, type, out,
+            &out_len);
+        if (ret != WOLFSSL_SUCCESS) {
+            fprintf(stderr, "Failed to compile CRL: %d\n", ret);
+            ret = 1;
+        }
+        else {
+            ret = 0;
+        }
+    }
+    if (ret == 0) {
+        ret = WriteFile(out_name, out, out_len);
+    }
+
+    free(out);
+    free(in);
+    if (key != NULL) {
+        memset(key, 0, (size_t)key_len);
+        free(key);
+    }
+    wolfSSL_CertManagerFree(cm);
+    wolfSSL_Cleanup();
+
+    return ret;
+}
+
+#else
+
+/* Main entry of CRL compiling program.
+ *
+ * @param [in] argc  Count of command line arguments.
+ * @param [in] argv  Command line arguments.
+ * @return  0 on success.
+ * @return  1 on failure.
+ */
+int main(int argc, char* argv[])
+{
+    (void)argc;
+    (void)argv;
+    fprintf(stderr, "crl_compile: compiled CRLs or filesystem not compiled "
+                    "in\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,412 @@
+/* io_uring_server.c
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+/* TLS echo server handling many connections from one thread with the
+ * socket I/O of all connections on an io_uring. */
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+
+/* std */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+/* socket */
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+
+/* wolfSSL */
+#ifndef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/ssl.h>
+#include <wolfssl/wolfio.h>
+
+#ifdef WOLFSSL_IO_URING
+
+/* Test certificates and keys for RSA and ECC */
+#ifndef NO_RSA
+    #define CERT_FILE "./certs/server-cert.pem"
+    #define KEY_FILE  "./certs/server-key.pem"
+#elif defined(HAVE_ECC)
+    #define CERT_FILE "./certs/server-ecc.pem"
+    #define KEY_FILE  "./certs/ecc-key.pem"
+#else
+    #error No authentication algorithm (ECC/RSA)
+#endif
+
+#define DEFAULT_PORT      11111
+#define DEFAULT_MAX_CONNS 1024
+#define ECHO_BUF_SZ       4096
+#define READY_SZ          256
+
+enum {
+    CONN_ACCEPT,
+    CONN_READ,
+    CONN_WRITE,
+    CONN_CLOSE
+};
+
+/* State of one client connection. */
+typedef struct Conn {
+    WOLFSSL* ssl;
+    int      fd;
+    int      state;
+    int      len;               /* Bytes to echo back */
+    char     buf[ECHO_BUF_SZ];
+} Conn;
+
+static volatile int mShutdown = 0;
+
+static void sig_handler(const int sig)
+{
+    (void)sig;
+    mShutdown = 1;
+}
+
+static void Usage(void)
+{
+    printf("io_uring_server " LIBWOLFSSL_VERSION_STRING "\n");
+    printf("-?          Help, print this usage\n");
+    printf("-p <num>    Port to listen on, default %d\n", DEFAULT_PORT);
+    printf("-C <num>    Maximum concurrent connections, default %d\n",
+        DEFAULT_MAX_CONNS);
+    printf("-F          Register the staging buffers with the kernel\n");
+    printf("-N <num>    Exit after <num> connections have closed\n");
+}
+
+/* Close a connection and make its slot available. */
+static void CloseConn(Conn** conns, Conn* conn)
+{
+    wolfSSL_free(conn->ssl);   /* detaches from the ring */
+    close(conn->fd);
+    conns[conn->fd] = NULL;
+    free(conn);
+}
+
+/* Make as much progress as possible on a connection.
+ *
+ * @return  1 when the connection is finished.
+ * @return  0 when waiting on I/O.
+ */
+static int ServeConn(Conn* conn, unsigned long* bytes)
+{
+    int ret;
+    int err;
+
+    for (;;) {
+        switch (conn->state) {
+            case CONN_ACCEPT:
+                ret = wolfSSL_accept(conn->ssl);
+                if (ret == WOLFSSL_SUCCESS) {
+                    conn->state = CONN_READ;
+                    continue;
+                }
+                break;
+            case CONN_READ:
+                ret = wolfSSL_read(conn->ssl, conn->buf, sizeof(conn->buf));
+                if (ret > 0) {
+                    *bytes += (unsigned long)ret;
+                    conn->len = ret;
+                    conn->state = CONN_WRITE;
+                    continue;
+                }
+                break;
+            case CONN_WRITE:
+                ret = wolfSSL_write(conn->ssl, conn->buf, conn->len);
+                if (ret > 0) {
+                    conn->state = CONN_READ;
+                    continue;
+                }
+                break;
+            default:
+                /* Closing - wait for the close_notify to be sent. */
+                return wolfSSL_IoUring_Pending(conn->ssl) <= 0;
+        }
+
+        err = wolfSSL_get_error(conn->ssl, ret);
+        if (err == WOLFSSL_ERROR_WANT_READ || err == WOLFSSL_ERROR_WANT_WRITE) {
+            return 0;
+        }
+        if (err == WOLFSSL_ERROR_ZERO_RETURN) {
+            /* Peer sent close_notify - reply with ours. */
+            (void)wolfSSL_shutdown(conn->ssl);
+            conn->state = CONN_CLOSE;
+            continue;
+        }
+        return 1;
+    }
+}
+
+static int io_uring_server_test(int argc, char** argv)
+{
+    int ret = 0;
+    int ch;
+    int on = 1;
+    int i;
+    int n;
+    int fd;
+    int port = DEFAULT_PORT;
+    int maxConns = DEFAULT_MAX_CONNS;
+    int flags = 0;
+    long exitAfter = 0;
+    long active = 0;
+    unsigned long served = 0;
+    unsigned long bytes = 0;
+    int listenFd = -1;
+    struct sockaddr_in servAddr;
+    struct pollfd pfd[2];
+    struct rlimit rl;
+    Conn** conns = NULL;
+    Conn* conn;
+    WOLFSSL* ready[READY_SZ];
+    WOLFSSL_URING_STATS stats;
+
+    /* declare wolfSSL objects */
+    WOLFSSL_CTX*   ctx = NULL;
+    WOLFSSL_URING* ring = NULL;
+
+    while ((ch = getopt(argc, argv, "?p:C:FN:")) != -1) {
+        switch (ch) {
+            case 'p':
+                port = atoi(optarg);
+                break;
+            case 'C':
+                maxConns = atoi(optarg);
+                break;
+            case 'F':
+                flags |= WOLFSSL_IO_URING_FIXED_BUFFERS;
+                break;
+            case 'N':
+                exitAfter = atol(optarg);
+                break;
+            default:
+                Usage();
+                return 0;
+        }
+    }
+    if (maxConns <= 0 || maxConns > WOLFSSL_IO_URING_MAX_CONNS) {
+        fprintf(stderr, "ERROR: -C must be 1 to %d\n",
+            WOLFSSL_IO_URING_MAX_CONNS);
+        return -1;
+    }
+
+    if (signal(SIGINT, sig_handler) == SIG_ERR) {
+        fprintf(stderr, "ERROR: failed to listen to SIGINT (errno: %d)\n",
+            errno);
+        return -1;
+    }
+
+    /* Each connection needs a descriptor - connections are found by it. */
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 &&
+            rl.rlim_cur < (rlim_t)maxConns + 64) {
+        rl.rlim_cur = ((rlim_t)maxConns + 64 < rl.rlim_max) ?
+            (rlim_t)maxConns + 64 : rl.rlim_max;
+        (void)setrlimit(RLIMIT_NOFILE, &rl);
+    }
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0) {
+        fprintf(stderr, "ERROR: failed to get descriptor limit\n");
+        return -1;
+    }
+    conns = (Conn**)calloc((size_t)rl.rlim_cur, sizeof(Conn*));
+    if (conns == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate connection table\n");
+        return -1;
+    }
+
+    memset(&servAddr, 0, sizeof(servAddr));
+    servAddr.sin_family      = AF_INET;
+    servAddr.sin_port        = htons((unsigned short)port);
+    servAddr.sin_addr.s_addr = INADDR_ANY;
+
+    if ((listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0)) == -1) {
+        fprintf(stderr, "ERROR: failed to create the socket\n");
+        ret = -1; goto exit;
+    }
+    if (setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR,
+            (char*)&on, (socklen_t)sizeof(on)) != 0) {
+        fprintf(stderr, "ERROR: failed to set SO_REUSEADDR (errno: %d)\n",
+            errno);
+        ret = -1; goto exit;
+    }
+    if (bind(listenFd, (struct sockaddr*)&servAddr, sizeof(servAddr)) == -1) {
+        fprintf(stderr, "ERROR: failed to bind\n");
+        ret = -1; goto exit;
+    }
+    if (listen(listenFd, SOMAXCONN) == -1) {
+        fprintf(stderr, "ERROR: failed to listen\n");
+        ret = -1; goto exit;
+    }
+
+#ifdef DEBUG_WOLFSSL
+    wolfSSL_Debugging_ON();
+#endif
+    if ((ret = wolfSSL_Init()) != WOLFSSL_SUCCESS) {
+        fprintf(stderr, "ERROR: Failed to initialize the library\n");
+        goto exit;
+    }
+    ret = 0;
+
+    if ((ctx = wolfSSL_CTX_new(wolfSSLv23_server_method())) == NULL) {
+        fprintf(stderr, "ERROR: failed to create WOLFSSL_CTX\n");
+        ret = -1; goto exit;
+    }
+    if (wolfSSL_CTX_use_certificate_file(ctx, CERT_FILE,
+            WOLFSSL_FILETYPE_PEM) != WOLFSSL_SUCCESS) {
+        fprintf(stderr, "ERROR: failed to load %s, please check the file.\n",
+                CERT_FILE);
+        ret = -1; goto exit;
+    }
+    if (wolfSSL_CTX_use_PrivateKey_file(ctx, KEY_FILE,
+            WOLFSSL_FILETYPE_PEM) != WOLFSSL_SUCCESS) {
+        fprintf(stderr, "ERROR: failed to load %s, please check the file.\n",
+                KEY_FILE);
+        ret = -1; goto exit;
+    }
+
+    if ((ring = wolfSSL_IoUring_new(maxConns, flags, NULL)) == NULL) {
+        fprintf(stderr, "ERROR: failed to create io_uring\n");
+        ret = -1; goto exit;
+    }
+
+    printf("Waiting for connections on port %d...\n", port);
+    pfd[0].fd = listenFd;
+    pfd[0].events = POLLIN;
+    pfd[1].fd = wolfSSL_IoUring_GetFd(ring);
+    pfd[1].events = POLLIN;
+
+    while (!mShutdown) {
+        /* Submit the I/O of all connections and handle the ones that can
+         * make progress. */
+        n = wolfSSL_IoUring_Submit(ring, 0, ready, READY_SZ);
+        if (n < 0) {
+            fprintf(stderr, "ERROR: io_uring submit failed %d\n", n);
+            ret = n; break;
+        }
+        for (i = 0; i < n; i++) {
+            conn = conns[wolfSSL_get_fd(ready[i])];
+            if (ServeConn(conn, &bytes)) {
+                CloseConn(conns, conn);
+                active--;
+                served++;
+            }
+        }
+        if (exitAfter > 0 && (long)served >= exitAfter) {
+            break;
+        }
+        if (n > 0) {
+            /* Submit the I/O queued by these connections first. */
+            continue;
+        }
+
+        /* Nothing ready - wait for a completion or a new connection. */
+        if (poll(pfd, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ret = -1; break;
+        }
+        if ((pfd[0].revents & POLLIN) == 0) {
+            continue;
+        }
+        while (active < maxConns &&
+                (fd = accept(listenFd, NULL, NULL)) >= 0) {
+            if ((rlim_t)fd >= rl.rlim_cur ||
+                    fcntl(fd, F_SETFL, O_NONBLOCK) != 0 ||
+                    (conn = (Conn*)calloc(1, sizeof(Conn))) == NULL) {
+                close(fd);
+                continue;
+            }
+            conn->fd = fd;
+            conn->state = CONN_ACCEPT;
+            conn->ssl = wolfSSL_new(ctx);
+            if (conn->ssl == NULL || wolfSSL_set_fd(conn->ssl, fd) !=
+                    WOLFSSL_SUCCESS ||
+                    wolfSSL_SetIO_IoUring(conn->ssl, ring) != WOLFSSL_SUCCESS) {
+                fprintf(stderr, "ERROR: failed to set up connection\n");
+                wolfSSL_free(conn->ssl);
+                close(fd);
+                free(conn);
+                continue;
+            }
+            conns[fd] = conn;
+            active++;
+            /* Queues the receive of the ClientHello. */
+            if (ServeConn(conn, &bytes)) {
+                CloseConn(conns, conn);
+                active--;
+            }
+        }
+    }
+
+    if (wolfSSL_IoUring_GetStats(ring, &stats) == WOLFSSL_SUCCESS) {
+        printf("Connections: %lu, bytes echoed: %lu\n", served, bytes);
+        printf("io_uring_enter calls: %u, operations: %u submitted, "
+               "%u completed, fixed buffers: %s\n", stats.enters,
+               stats.submitted, stats.completed, stats.fixed ? "yes" : "no");
+    }
+
+exit:
+    if (conns != NULL) {
+        for (i = 0; i < (int)rl.rlim_cur; i++) {
+            if (conns[i] != NULL) {
+                CloseConn(conns, conns[i]);
+            }
+        }
+        free(conns);
+    }
+    wolfSSL_IoUring_free(ring);
+    if (listenFd != -1) {
+        close(listenFd);
+    }
+    if (ctx) {
+        wolfSSL_CTX_free(ctx);
+    }
+    wolfSSL_Cleanup();
+
+    return ret;
+}
+
+#endif /* WOLFSSL_IO_URING */
+
+#ifndef NO_MAIN_DRIVER
+int main(int argc, char** argv)
+{
+#ifdef WOLFSSL_IO_URING
+    return io_uring_server_test(argc, argv);
+#else
+    (void)argc;
+    (void)argv;
+    printf("io_uring support not compiled in: configure with "
+           "--enable-io-uring\n");
+    return 0;
+#endif
+}
+#endif /* !NO_MAIN_DRIVER */
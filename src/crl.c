@@ -31,6 +31,18 @@ CRL Options:
  * CRL_REPORT_LOAD_ERRORS:                                         default: off
  *                         Return any errors encountered during loading CRL
  *                         from a directory.
+ * WOLFSSL_CRL_SERIAL_INDEX:                                       default: off
+ *                         Builds a hash index of the revoked serial numbers,
+ *                         and their hashes, when a CRL is loaded so that the
+ *                         revocation check doesn't walk the list.
+ * WOLFSSL_CRL_COMPILED:                                           default: off
+ *                         Enables compiling a verified CRL into a flat sorted
+ *                         form that is loaded without parsing or allocating
+ *                         per revoked certificate and searched in place.
+ *                         Compiled CRLs are authenticated with an HMAC-SHA256
+ *                         key set on the certificate manager.
+ * WOLFSSL_CRL_COMPILED_MMAP:                                      default: off
+ *                         Enables loading a compiled CRL file with mmap().
 */
 #ifdef HAVE_CONFIG_H
     #include <config.h>
@@ -44,6 +56,15 @@ CRL Options:
 #include <wolfssl/internal.h>
 #include <wolfssl/error-ssl.h>
 
+#ifdef WOLFSSL_CRL_COMPILED
+    #ifdef NO_INLINE
+        #include <wolfssl/wolfcrypt/misc.h>
+    #else
+        #define WOLFSSL_MISC_INCLUDED
+        #include <wolfcrypt/src/misc.c>
+    #endif
+#endif
+
 #ifndef WOLFSSL_LINUXKM
     #include <string.h>
 #endif
@@ -57,6 +78,17 @@ CRL Options:
     #endif
 #endif /* HAVE_CRL_MONITOR */
 
+#if defined(WOLFSSL_CRL_COMPILED) && (defined(NO_SHA256) || defined(NO_HMAC))
+    #error "Compiled CRLs require SHA-256 and HMAC"
+#endif
+
+#if defined(WOLFSSL_CRL_COMPILED) && defined(WOLFSSL_CRL_COMPILED_MMAP)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
 
 /* Initialize CRL members */
 int InitCRL(WOLFSSL_CRL* crl, WOLFSSL_CERT_MANAGER* cm)
@@ -69,6 +101,9 @@ int InitCRL(WOLFSSL_CRL* crl, WOLFSSL_CERT_MANAGER* cm)
     crl->cm = cm;
     crl->crlList  = NULL;
     crl->currentEntry = NULL;
+#ifdef WOLFSSL_CRL_COMPILED
+    crl->compiledList = NULL;
+#endif
 #ifdef HAVE_CRL_MONITOR
     crl->monitors[0].path = NULL;
     crl->monitors[1].path = NULL;
@@ -218,6 +253,9 @@ static void CRL_Entry_free(CRL_Entry* crle, void* heap)
         XFREE(tmp, heap, DYNAMIC_TYPE_REVOKED);
         tmp = next;
     }
+#endif
+#ifdef WOLFSSL_CRL_SERIAL_INDEX
+    XFREE(crle->serialIndex, heap, DYNAMIC_TYPE_CRL_ENTRY);
 #endif
     XFREE(crle->signature, heap, DYNAMIC_TYPE_CRL_ENTRY);
     XFREE(crle->toBeSigned, heap, DYNAMIC_TYPE_CRL_ENTRY);
@@ -235,6 +273,29 @@ static void CRL_Entry_free(CRL_Entry* crle, void* heap)
     (void)heap;
 }
 
+#ifdef WOLFSSL_CRL_COMPILED
+/* Release compiled CRL data - only file mappings are owned. */
+static void CRL_Compiled_Release(const byte* data, word32 sz, byte mapped)
+{
+#ifdef WOLFSSL_CRL_COMPILED_MMAP
+    if (mapped) {
+        (void)munmap((void*)data, (size_t)sz);
+    }
+#endif
+    (void)data;
+    (void)sz;
+    (void)mapped;
+}
+
+/* Free a compiled CRL. */
+static void CRL_Compiled_free(CRL_Compiled* c, void* heap)
+{
+    CRL_Compiled_Release(c->data, c->sz, c->mapped);
+    XFREE(c, heap, DYNAMIC_TYPE_CRL_ENTRY);
+    (void)heap;
+}
+#endif
+
 
 /* Free all CRL resources */
 void FreeCRL(WOLFSSL_CRL* crl, int dynamic)
@@ -261,6 +322,13 @@ void FreeCRL(WOLFSSL_CRL* crl, int dynamic)
         CRL_Entry_free(tmp, crl->heap);
         tmp = next;
     }
+#ifdef WOLFSSL_CRL_COMPILED
+    while (crl->compiledList != NULL) {
+        CRL_Compiled* next = crl->compiledList->next;
+        CRL_Compiled_free(crl->compiledList, crl->heap);
+        crl->compiledList = next;
+    }
+#endif
 
 #ifdef HAVE_CRL_MONITOR
     if (crl->tid != INVALID_THREAD_VAL) {
@@ -337,6 +405,394 @@ static int FindRevokedSerial(RevokedCert* rc, byte* serial, int serialSz,
     return ret;
 }
 
+#ifdef WOLFSSL_CRL_SERIAL_INDEX
+/* Minimum number of slots in a revoked serial index. */
+#define CRL_SERIAL_INDEX_MIN_SZ     16
+
+/* Slot for the serial number - FNV-1a of the bytes. */
+static word32 CrlSerialSlot(const byte* serial, int serialSz, word32 mask)
+{
+    word32 h = 0x811C9DC5;
+    int i;
+
+    for (i = 0; i < serialSz; i++) {
+        h = (h ^ serial[i]) * 0x01000193;
+    }
+
+    return (h ^ (h >> 16)) & mask;
+}
+
+/* Slot for the hash of a serial number - the hash bytes are uniform. */
+static word32 CrlHashSlot(const byte* hash, word32 mask)
+{
+    return (((word32)hash[0] << 24) | ((word32)hash[1] << 16) |
+            ((word32)hash[2] <<  8) |  (word32)hash[3]) & mask;
+}
+
+/* Build the index of the revoked certificates of the CRL entry.
+ *
+ * The tables are kept at most half full so that probe sequences stay short.
+ *
+ * @param [in, out] crle  CRL entry with list of revoked certificates.
+ * @param [in]      heap  Dynamic memory hint.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Other negative value when hashing a serial number fails.
+ */
+static int CRL_Entry_BuildIndex(CRL_Entry* crle, void* heap)
+{
+    int ret = 0;
+    CrlSerialIndex* idx;
+    RevokedCert* rc;
+    word32 cnt = 0;
+    word32 sz = CRL_SERIAL_INDEX_MIN_SZ;
+    word32 i;
+    byte hash[SIGNER_DIGEST_SIZE];
+
+    for (rc = crle->certs; rc != NULL; rc = rc->next) {
+        cnt++;
+    }
+    if (cnt == 0) {
+        /* Nothing to look up - list is empty. */
+        return 0;
+    }
+    while ((sz < cnt * 2) && (sz < (1U << 30))) {
+        sz <<= 1;
+    }
+    if (sz < cnt * 2) {
+        return MEMORY_E;
+    }
+
+    idx = (CrlSerialIndex*)XMALLOC(sizeof(CrlSerialIndex) +
+        sz * (sizeof(CrlSerialHashSlot) + sizeof(RevokedCert*)), heap,
+        DYNAMIC_TYPE_CRL_ENTRY);
+    if (idx == NULL) {
+        return MEMORY_E;
+    }
+    XMEMSET(idx, 0, sizeof(CrlSerialIndex) +
+        sz * (sizeof(CrlSerialHashSlot) + sizeof(RevokedCert*)));
+    idx->byHash = (CrlSerialHashSlot*)(idx + 1);
+    idx->bySerial = (RevokedCert**)(idx->byHash + sz);
+    idx->mask = sz - 1;
+
+    for (rc = crle->certs; rc != NULL; rc = rc->next) {
+        i = CrlSerialSlot(rc->serialNumber, rc->serialSz, idx->mask);
+        while (idx->bySerial[i] != NULL) {
+            i = (i + 1) & idx->mask;
+        }
+        idx->bySerial[i] = rc;
+
+        ret = CalcHashId(rc->serialNumber, (word32)rc->serialSz, hash);
+        if (ret != 0) {
+            break;
+        }
+        i = CrlHashSlot(hash, idx->mask);
+        while (idx->byHash[i].rc != NULL) {
+            i = (i + 1) & idx->mask;
+        }
+        idx->byHash[i].rc = rc;
+        XMEMCPY(idx->byHash[i].hash, hash, SIGNER_DIGEST_SIZE);
+    }
+
+    if (ret != 0) {
+        XFREE(idx, heap, DYNAMIC_TYPE_CRL_ENTRY);
+        idx = NULL;
+    }
+    crle->serialIndex = idx;
+    (void)heap;
+
+    return ret;
+}
+
+/* Find serial number, or hash of serial number, in the index.
+ *
+ * @param [in] idx         Index of revoked certificates.
+ * @param [in] serial      Serial number. Used when serialHash is NULL.
+ * @param [in] serialSz    Size of serial number in bytes.
+ * @param [in] serialHash  Hash of serial number. May be NULL.
+ * @return  0 when not revoked.
+ * @return  CRL_CERT_REVOKED when serial number is in the index.
+ */
+static int FindRevokedSerialIndex(const CrlSerialIndex* idx, const byte* serial,
+        int serialSz, const byte* serialHash)
+{
+    word32 i;
+
+    if (serialHash == NULL) {
+        RevokedCert* rc;
+
+        for (i = CrlSerialSlot(serial, serialSz, idx->mask);
+                (rc = idx->bySerial[i]) != NULL; i = (i + 1) & idx->mask) {
+            if (rc->serialSz == serialSz &&
+                   XMEMCMP(rc->serialNumber, serial, (size_t)serialSz) == 0) {
+                WOLFSSL_MSG("Cert revoked");
+                return CRL_CERT_REVOKED;
+            }
+        }
+    }
+    else {
+        for (i = CrlHashSlot(serialHash, idx->mask);
+                idx->byHash[i].rc != NULL; i = (i + 1) & idx->mask) {
+            if (XMEMCMP(idx->byHash[i].hash, serialHash,
+                    SIGNER_DIGEST_SIZE) == 0) {
+                WOLFSSL_MSG("Cert revoked");
+                return CRL_CERT_REVOKED;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif /* WOLFSSL_CRL_SERIAL_INDEX */
+
+#ifdef WOLFSSL_CRL_COMPILED
+/* Compiled CRL format. Multi-byte numbers are big-endian.
+ *
+ *  Offset  Size
+ *   0       4   Magic: "wCRL"
+ *   4       1   Format version
+ *   5       1   Size of issuer hash - CRL_DIGEST_SIZE
+ *   6       1   Size of serial number hash - SIGNER_DIGEST_SIZE
+ *   7       1   Size of serial number record - CRL_COMPILED_SERIAL_SZ
+ *   8       1   Size of date - MAX_DATE_SIZE
+ *   9       3   Reserved - zero
+ *  12      32   HMAC-SHA256 of all other data - bytes 0-11 and the body
+ *  44       1   Last date format
+ *  45       1   Next date format
+ *  46       2   Reserved - zero
+ *  48       4   Number of revoked certificates
+ *  52       4   CRL number
+ *  56           Issuer hash
+ *               Last date
+ *               Next date
+ *               Serial number records: length byte then serial number
+ *               padded with zeros. Sorted, strictly increasing.
+ *               Hashes of serial numbers. Sorted, strictly increasing.
+ *
+ * The sizes depend on the build so a compiled CRL is only loaded by a build
+ * with the same sizes. The HMAC is keyed with the certificate manager's
+ * compiled CRL key, which is not stored in the file, so that a compiled CRL
+ * can't be modified without the key. The HMAC, the issuer CA and the ordering
+ * are checked on load.
+ */
+#define CRL_COMPILED_VERSION            3
+#define CRL_COMPILED_OFF_VERSION        4
+#define CRL_COMPILED_OFF_ISSUER_SZ      5
+#define CRL_COMPILED_OFF_HASH_SZ        6
+#define CRL_COMPILED_OFF_SERIAL_SZ      7
+#define CRL_COMPILED_OFF_DATE_SZ        8
+#define CRL_COMPILED_OFF_MAC         12
+#define CRL_COMPILED_OFF_BODY           (CRL_COMPILED_OFF_MAC + \
+                                         WC_SHA256_DIGEST_SIZE)
+#define CRL_COMPILED_OFF_LAST_FMT       (CRL_COMPILED_OFF_BODY + 0)
+#define CRL_COMPILED_OFF_NEXT_FMT       (CRL_COMPILED_OFF_BODY + 1)
+#define CRL_COMPILED_OFF_COUNT          (CRL_COMPILED_OFF_BODY + 4)
+#define CRL_COMPILED_OFF_NUMBER         (CRL_COMPILED_OFF_BODY + 8)
+#define CRL_COMPILED_OFF_ISSUER         (CRL_COMPILED_OFF_BODY + 12)
+#define CRL_COMPILED_OFF_LAST_DATE      (CRL_COMPILED_OFF_ISSUER + \
+                                         CRL_DIGEST_SIZE)
+#define CRL_COMPILED_OFF_NEXT_DATE      (CRL_COMPILED_OFF_LAST_DATE + \
+                                         MAX_DATE_SIZE)
+#define CRL_COMPILED_HDR_SZ             (CRL_COMPILED_OFF_NEXT_DATE + \
+                                         MAX_DATE_SIZE)
+/* Serial number record: length and serial number. */
+#define CRL_COMPILED_SERIAL_SZ          (1 + EXTERNAL_SERIAL_SIZE)
+/* Bytes for each revoked certificate. */
+#define CRL_COMPILED_ENTRY_SZ           (CRL_COMPILED_SERIAL_SZ + \
+                                         SIGNER_DIGEST_SIZE)
+
+static const byte crlCompiledMagic[4] = { 'w', 'C', 'R', 'L' };
+
+static word32 CrlCompiledGet32(const byte* p)
+{
+    return ((word32)p[0] << 24) | ((word32)p[1] << 16) |
+           ((word32)p[2] <<  8) |  (word32)p[3];
+}
+
+/* Calculate the HMAC-SHA256 of a compiled CRL with the certificate manager's
+ * key. All data except the HMAC field is authenticated.
+ *
+ * @param [in]  cm    Certificate manager holding key.
+ * @param [in]  data  Compiled CRL.
+ * @param [in]  sz    Size of compiled CRL in bytes.
+ * @param [out] mac   Buffer to hold HMAC. WC_SHA256_DIGEST_SIZE bytes.
+ * @return  0 on success.
+ * @return  BAD_STATE_E when no compiled CRL key is set.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Other negative value when HMAC operation fails.
+ */
+static int CrlCompiledMac(WOLFSSL_CERT_MANAGER* cm, const byte* data,
+        word32 sz, byte* mac)
+{
+    int ret;
+#ifdef WOLFSSL_SMALL_STACK
+    Hmac* hmac;
+#else
+    Hmac  hmac[1];
+#endif
+
+    if (cm->crlCompiledKeySz == 0) {
+        WOLFSSL_MSG("No compiled CRL key set");
+        return BAD_STATE_E;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    hmac = (Hmac*)XMALLOC(sizeof(Hmac), cm->heap, DYNAMIC_TYPE_HMAC);
+    if (hmac == NULL)
+        return MEMORY_E;
+#endif
+
+    ret = wc_HmacInit(hmac, cm->heap, INVALID_DEVID);
+    if (ret == 0) {
+        ret = wc_HmacSetKey(hmac, WC_SHA256, cm->crlCompiledKey,
+            cm->crlCompiledKeySz);
+        if (ret == 0) {
+            ret = wc_HmacUpdate(hmac, data, CRL_COMPILED_OFF_MAC);
+        }
+        if (ret == 0) {
+            ret = wc_HmacUpdate(hmac, data + CRL_COMPILED_OFF_BODY,
+                sz - CRL_COMPILED_OFF_BODY);
+        }
+        if (ret == 0) {
+            ret = wc_HmacFinal(hmac, mac);
+        }
+        wc_HmacFree(hmac);
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(hmac, cm->heap, DYNAMIC_TYPE_HMAC);
+#endif
+    return ret;
+}
+
+/* Binary search of sorted fixed size records. Returns 1 when key found. */
+static int CrlCompiledFind(const byte* recs, word32 cnt, word32 recSz,
+        const byte* key)
+{
+    word32 low = 0;
+    word32 high = cnt;
+
+    while (low < high) {
+        word32 mid = low + (high - low) / 2;
+        int cmp = XMEMCMP(recs + (size_t)mid * recSz, key, recSz);
+
+        if (cmp == 0) {
+            return 1;
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    return 0;
+}
+
+/* Check fixed size records are strictly increasing. Returns 1 when they are.
+ */
+static int CrlCompiledIsSorted(const byte* recs, word32 cnt, word32 recSz)
+{
+    word32 i;
+
+    for (i = 1; i < cnt; i++) {
+        if (XMEMCMP(recs + (size_t)(i - 1) * recSz, recs + (size_t)i * recSz,
+                recSz) >= 0) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* Find serial number, or hash of serial number, in a compiled CRL.
+ *
+ * @param [in] data        Compiled CRL.
+ * @param [in] serial      Serial number. Used when serialHash is NULL.
+ * @param [in] serialSz    Size of serial number in bytes.
+ * @param [in] serialHash  Hash of serial number. May be NULL.
+ * @return  0 when not revoked.
+ * @return  CRL_CERT_REVOKED when serial number is in the compiled CRL.
+ */
+static int FindRevokedSerialCompiled(const byte* data, const byte* serial,
+        int serialSz, const byte* serialHash)
+{
+    word32 cnt = CrlCompiledGet32(data + CRL_COMPILED_OFF_COUNT);
+    const byte* serials = data + CRL_COMPILED_HDR_SZ;
+    int found = 0;
+
+    if (serialHash == NULL) {
+        byte key[CRL_COMPILED_SERIAL_SZ];
+
+        if ((serialSz > 0) && (serialSz <= EXTERNAL_SERIAL_SIZE)) {
+            XMEMSET(key, 0, sizeof(key));
+            key[0] = (byte)serialSz;
+            XMEMCPY(key + 1, serial, (size_t)serialSz);
+            found = CrlCompiledFind(serials, cnt, CRL_COMPILED_SERIAL_SZ, key);
+        }
+    }
+    else {
+        found = CrlCompiledFind(serials + (size_t)cnt * CRL_COMPILED_SERIAL_SZ,
+            cnt, SIGNER_DIGEST_SIZE, serialHash);
+    }
+    if (found) {
+        WOLFSSL_MSG("Cert revoked");
+        return CRL_CERT_REVOKED;
+    }
+
+    return 0;
+}
+
+/* Check the compiled CRLs of the issuer. Call with CRL lock held.
+ *
+ * Same date handling as CRL entries: ret and foundEntry carry on from the
+ * check of the CRL list.
+ */
+static int CheckCertCRLCompiled(WOLFSSL_CRL* crl, const byte* issuerHash,
+        const byte* serial, int serialSz, const byte* serialHash,
+        int* foundEntry, int ret)
+{
+    CRL_Compiled* c;
+
+    for (c = crl->compiledList; c != NULL; c = c->next) {
+        const byte* data = c->data;
+        int nextDateValid = 1;
+
+        if (XMEMCMP(data + CRL_COMPILED_OFF_ISSUER, issuerHash,
+                CRL_DIGEST_SIZE) != 0) {
+            continue;
+        }
+        WOLFSSL_MSG("Found compiled CRL on list");
+
+    #ifdef WOLFSSL_NO_CRL_NEXT_DATE
+        if (data[CRL_COMPILED_OFF_NEXT_FMT] != ASN_OTHER_TYPE)
+    #endif
+        {
+        #if !defined(NO_ASN_TIME) && !defined(WOLFSSL_NO_CRL_DATE_CHECK)
+            if (!XVALIDATE_DATE(data + CRL_COMPILED_OFF_NEXT_DATE,
+                    data[CRL_COMPILED_OFF_NEXT_FMT], ASN_AFTER)) {
+                WOLFSSL_MSG("Compiled CRL next date is no longer valid");
+                nextDateValid = 0;
+            }
+        #endif
+        }
+        if (nextDateValid) {
+            *foundEntry = 1;
+            ret = FindRevokedSerialCompiled(data, serial, serialSz,
+                    serialHash);
+            if (ret != 0)
+                break;
+        }
+        else if (*foundEntry == 0) {
+            ret = CRL_CERT_DATE_ERR;
+        }
+    }
+
+    return ret;
+}
+#endif /* WOLFSSL_CRL_COMPILED */
+
 static int VerifyCRLE(const WOLFSSL_CRL* crl, CRL_Entry* crle)
 {
     Signer* ca = NULL;
@@ -431,6 +887,12 @@ static int CheckCertCRLList(WOLFSSL_CRL* crl, byte* issuerHash, byte* serial,
             }
             if (nextDateValid) {
                 foundEntry = 1;
+            #ifdef WOLFSSL_CRL_SERIAL_INDEX
+                if (crle->serialIndex != NULL)
+                    ret = FindRevokedSerialIndex(crle->serialIndex, serial,
+                            serialSz, serialHash);
+                else
+            #endif
                 ret = FindRevokedSerial(crle->certs, serial, serialSz,
                         serialHash, crle->totalCerts);
                 if (ret != 0)
@@ -442,6 +904,13 @@ static int CheckCertCRLList(WOLFSSL_CRL* crl, byte* issuerHash, byte* serial,
         }
     }
 
+#ifdef WOLFSSL_CRL_COMPILED
+    if ((ret == 0) || (ret == WC_NO_ERR_TRACE(CRL_CERT_DATE_ERR))) {
+        ret = CheckCertCRLCompiled(crl, issuerHash, serial, serialSz,
+                serialHash, &foundEntry, ret);
+    }
+#endif
+
     wc_UnLockRwLock(&crl->crlLock);
 
     *pFoundEntry = foundEntry;
@@ -566,6 +1035,9 @@ static int AddCRL(WOLFSSL_CRL* crl, DecodedCRL* dcrl, const byte* buff,
                   int verified)
 {
     CRL_Entry* crle = NULL;
+#ifdef WOLFSSL_CRL_SERIAL_INDEX
+    int ret;
+#endif
 
     WOLFSSL_ENTER("AddCRL");
 
@@ -588,6 +1060,16 @@ static int AddCRL(WOLFSSL_CRL* crl, DecodedCRL* dcrl, const byte* buff,
         return WOLFSSL_FATAL_ERROR;
     }
 
+#ifdef WOLFSSL_CRL_SERIAL_INDEX
+    /* Index the revoked serial numbers before the entry is visible. */
+    ret = CRL_Entry_BuildIndex(crle, crl->heap);
+    if (ret != 0) {
+        WOLFSSL_MSG("Building CRL serial index failed");
+        CRL_Entry_free(crle, crl->heap);
+        return ret;
+    }
+#endif
+
     if (wc_LockRwLock_Wr(&crl->crlLock) != 0) {
         WOLFSSL_MSG("wc_LockRwLock_Wr failed");
         CRL_Entry_free(crle, crl->heap);
@@ -686,6 +1168,436 @@ int BufferLoadCRL(WOLFSSL_CRL* crl, const byte* buff, long sz, int type,
     return ret ? ret : WOLFSSL_SUCCESS; /* convert 0 to WOLFSSL_SUCCESS */
 }
 
+#ifdef WOLFSSL_CRL_COMPILED
+static void CrlCompiledSet32(byte* p, word32 v)
+{
+    p[0] = (byte)(v >> 24);
+    p[1] = (byte)(v >> 16);
+    p[2] = (byte)(v >>  8);
+    p[3] = (byte)v;
+}
+
+static void CrlCompiledSwap(byte* a, byte* b, word32 sz)
+{
+    while (sz-- > 0) {
+        byte t = *a;
+        *a++ = *b;
+        *b++ = t;
+    }
+}
+
+/* Heap sort fixed size records - no allocation or recursion. */
+static void CrlCompiledSort(byte* recs, word32 cnt, word32 recSz)
+{
+    word32 i;
+    word32 end;
+    word32 root;
+    word32 child;
+
+    for (i = cnt / 2, end = cnt; end > 1; ) {
+        if (i > 0) {
+            /* Build heap. */
+            root = --i;
+        }
+        else {
+            /* Move largest to end and restore heap. */
+            end--;
+            CrlCompiledSwap(recs, recs + (size_t)end * recSz, recSz);
+            root = 0;
+        }
+        while ((child = 2 * root + 1) < end) {
+            if ((child + 1 < end) && (XMEMCMP(recs + (size_t)child * recSz,
+                    recs + (size_t)(child + 1) * recSz, recSz) < 0)) {
+                child++;
+            }
+            if (XMEMCMP(recs + (size_t)root * recSz,
+                    recs + (size_t)child * recSz, recSz) >= 0) {
+                break;
+            }
+            CrlCompiledSwap(recs + (size_t)root * recSz,
+                recs + (size_t)child * recSz, recSz);
+            root = child;
+        }
+    }
+}
+
+/* Remove duplicates from sorted fixed size records. Returns new count. */
+static word32 CrlCompiledUnique(byte* recs, word32 cnt, word32 recSz)
+{
+    word32 i;
+    word32 n = 0;
+
+    for (i = 0; i < cnt; i++) {
+        if ((n == 0) || (XMEMCMP(recs + (size_t)(n - 1) * recSz,
+                recs + (size_t)i * recSz, recSz) != 0)) {
+            if (n != i) {
+                XMEMMOVE(recs + (size_t)n * recSz, recs + (size_t)i * recSz,
+                    recSz);
+            }
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/* Compile a CRL into the form searched in place.
+ *
+ * The CRL is parsed and its signature verified with the CAs of the
+ * certificate manager. Revocation dates and extensions are not kept.
+ *
+ * @param [in]      cm     Certificate manager with CAs to verify CRL.
+ * @param [in]      buff   Buffer holding CRL.
+ * @param [in]      sz     Size in bytes of CRL in buffer.
+ * @param [in]      type   Format of encoding: WOLFSSL_FILETYPE_ASN1 or
+ *                         WOLFSSL_FILETYPE_PEM.
+ * @param [out]     out    Buffer to hold compiled CRL. May be NULL.
+ * @param [in, out] outSz  On in, size of buffer in bytes.
+ *                         On out, size of compiled CRL in bytes.
+ * @return  0 on success.
+ * @return  LENGTH_ONLY_E when out is NULL and outSz is set.
+ * @return  BAD_STATE_E when no compiled CRL key is set.
+ * @return  BUFFER_E when out is too small.
+ * @return  Other negative value when parsing or verifying CRL fails.
+ */
+int CompileCRL(WOLFSSL_CERT_MANAGER* cm, const byte* buff, long sz, int type,
+               byte* out, word32* outSz)
+{
+    int          ret = 0;
+    const byte*  myBuffer = buff;    /* if DER ok, otherwise switch */
+    DerBuffer*   der = NULL;
+    RevokedCert* rc;
+    word32       cnt = 0;
+    word32       need = 0;
+    byte*        serials;
+    byte*        hashes;
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCRL*  dcrl;
+#else
+    DecodedCRL   dcrl[1];
+#endif
+
+    WOLFSSL_ENTER("CompileCRL");
+
+    if (cm == NULL || buff == NULL || sz <= 0 || outSz == NULL)
+        return BAD_FUNC_ARG;
+    /* Compiled CRL can't be authenticated without a key. */
+    if (cm->crlCompiledKeySz == 0) {
+        WOLFSSL_MSG("No compiled CRL key set");
+        return BAD_STATE_E;
+    }
+
+    if (type == WOLFSSL_FILETYPE_PEM) {
+    #ifdef WOLFSSL_PEM_TO_DER
+        ret = PemToDer(buff, sz, CRL_TYPE, &der, NULL, NULL, NULL);
+        if (ret == 0) {
+            myBuffer = der->buffer;
+            sz = der->length;
+        }
+        else {
+            WOLFSSL_MSG("Pem to Der failed");
+            FreeDer(&der);
+            return WOLFSSL_FATAL_ERROR;
+        }
+    #else
+        return NOT_COMPILED_IN;
+    #endif
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    dcrl = (DecodedCRL*)XMALLOC(sizeof(DecodedCRL), NULL,
+                                DYNAMIC_TYPE_TMP_BUFFER);
+    if (dcrl == NULL) {
+        FreeDer(&der);
+        return MEMORY_E;
+    }
+#endif
+
+    InitDecodedCRL(dcrl, cm->heap);
+    /* Only a verified CRL is compiled. */
+    ret = ParseCRL(NULL, dcrl, myBuffer, (word32)sz, VERIFY, cm);
+    if (ret != 0) {
+        WOLFSSL_MSG("ParseCRL error");
+    }
+    else {
+        for (rc = dcrl->certs; rc != NULL; rc = rc->next) {
+            cnt++;
+        }
+        if (cnt > (0xFFFFFFFFU - CRL_COMPILED_HDR_SZ) / CRL_COMPILED_ENTRY_SZ) {
+            ret = BUFFER_E;
+        }
+        else {
+            need = CRL_COMPILED_HDR_SZ + cnt * CRL_COMPILED_ENTRY_SZ;
+            if (out == NULL) {
+                *outSz = need;
+                ret = LENGTH_ONLY_E;
+            }
+            else if (*outSz < need) {
+                WOLFSSL_MSG("Compiled CRL buffer too small");
+                ret = BUFFER_E;
+            }
+        }
+    }
+
+    if (ret == 0) {
+        XMEMSET(out, 0, CRL_COMPILED_HDR_SZ);
+        XMEMCPY(out, crlCompiledMagic, sizeof(crlCompiledMagic));
+        out[CRL_COMPILED_OFF_VERSION] = CRL_COMPILED_VERSION;
+        out[CRL_COMPILED_OFF_ISSUER_SZ] = CRL_DIGEST_SIZE;
+        out[CRL_COMPILED_OFF_HASH_SZ] = SIGNER_DIGEST_SIZE;
+        out[CRL_COMPILED_OFF_SERIAL_SZ] = CRL_COMPILED_SERIAL_SZ;
+        out[CRL_COMPILED_OFF_DATE_SZ] = MAX_DATE_SIZE;
+        out[CRL_COMPILED_OFF_LAST_FMT] = dcrl->lastDateFormat;
+        out[CRL_COMPILED_OFF_NEXT_FMT] = dcrl->nextDateFormat;
+        CrlCompiledSet32(out + CRL_COMPILED_OFF_COUNT, cnt);
+        CrlCompiledSet32(out + CRL_COMPILED_OFF_NUMBER,
+                         (word32)dcrl->crlNumber);
+        XMEMCPY(out + CRL_COMPILED_OFF_ISSUER, dcrl->issuerHash,
+                CRL_DIGEST_SIZE);
+        XMEMCPY(out + CRL_COMPILED_OFF_LAST_DATE, dcrl->lastDate,
+                MAX_DATE_SIZE);
+        XMEMCPY(out + CRL_COMPILED_OFF_NEXT_DATE, dcrl->nextDate,
+                MAX_DATE_SIZE);
+
+        serials = out + CRL_COMPILED_HDR_SZ;
+        hashes = serials + (size_t)cnt * CRL_COMPILED_SERIAL_SZ;
+        XMEMSET(serials, 0, (size_t)cnt * CRL_COMPILED_SERIAL_SZ);
+        for (rc = dcrl->certs; rc != NULL; rc = rc->next) {
+            serials[0] = (byte)rc->serialSz;
+            XMEMCPY(serials + 1, rc->serialNumber, (size_t)rc->serialSz);
+            serials += CRL_COMPILED_SERIAL_SZ;
+            ret = CalcHashId(rc->serialNumber, (word32)rc->serialSz, hashes);
+            if (ret != 0)
+                break;
+            hashes += SIGNER_DIGEST_SIZE;
+        }
+    }
+    if (ret == 0) {
+        word32 uniq;
+
+        serials = out + CRL_COMPILED_HDR_SZ;
+        hashes = serials + (size_t)cnt * CRL_COMPILED_SERIAL_SZ;
+        CrlCompiledSort(serials, cnt, CRL_COMPILED_SERIAL_SZ);
+        CrlCompiledSort(hashes, cnt, SIGNER_DIGEST_SIZE);
+        /* A serial number listed more than once is only stored once. */
+        uniq = CrlCompiledUnique(serials, cnt, CRL_COMPILED_SERIAL_SZ);
+        if (uniq != CrlCompiledUnique(hashes, cnt, SIGNER_DIGEST_SIZE)) {
+            ret = BAD_STATE_E;
+        }
+        else if (uniq != cnt) {
+            XMEMMOVE(serials + (size_t)uniq * CRL_COMPILED_SERIAL_SZ, hashes,
+                (size_t)uniq * SIGNER_DIGEST_SIZE);
+            cnt = uniq;
+            need = CRL_COMPILED_HDR_SZ + cnt * CRL_COMPILED_ENTRY_SZ;
+            CrlCompiledSet32(out + CRL_COMPILED_OFF_COUNT, cnt);
+        }
+    }
+    if (ret == 0) {
+        ret = CrlCompiledMac(cm, out, need, out + CRL_COMPILED_OFF_MAC);
+    }
+    if (ret == 0) {
+        *outSz = need;
+    }
+
+    FreeDecodedCRL(dcrl);
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(dcrl, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    FreeDer(&der);
+
+    return ret;
+}
+
+/* Load a compiled CRL. The data is used in place and not copied.
+ *
+ * A compiled CRL for the same issuer is replaced by swapping the data under
+ * the write lock. Once this returns, no check is using the old data and it
+ * may be freed by the caller. Data mapped from a file is unmapped here.
+ *
+ * The signature of the CRL was verified when compiled. The HMAC, keyed with
+ * the certificate manager's compiled CRL key, binds the data to that
+ * verification so that a corrupted or modified file is not searched. The
+ * issuer must still be a CA of the certificate manager and the ordering of
+ * the records is checked.
+ *
+ * @param [in] crl     CRL object.
+ * @param [in] data    Compiled CRL. Must stay valid until replaced or CRL
+ *                     freed.
+ * @param [in] sz      Size of compiled CRL in bytes.
+ * @param [in] mapped  Data is a file mapping owned by the CRL object.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when crl or data is NULL.
+ * @return  BAD_STATE_E when CRL object has no certificate manager or no
+ *          compiled CRL key is set.
+ * @return  ASN_PARSE_E when data is not a compiled CRL for this build.
+ * @return  ASN_PARSE_E when records are not strictly increasing.
+ * @return  ASN_CRL_CONFIRM_E when the HMAC doesn't match.
+ * @return  ASN_CRL_NO_SIGNER_E when the issuer is not a CA of the certificate
+ *          manager.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  BAD_MUTEX_E when locking fails.
+ */
+int LoadCompiledCRL(WOLFSSL_CRL* crl, const byte* data, word32 sz, int mapped)
+{
+    CRL_Compiled* c;
+    CRL_Compiled* node;
+    const byte* old = NULL;
+    word32 oldSz = 0;
+    byte oldMapped = 0;
+    word32 cnt;
+    int ret;
+    byte mac[WC_SHA256_DIGEST_SIZE];
+    byte issuerHash[CRL_DIGEST_SIZE];
+
+    WOLFSSL_ENTER("LoadCompiledCRL");
+
+    if (crl == NULL || data == NULL)
+        return BAD_FUNC_ARG;
+    if (crl->cm == NULL)
+        return BAD_STATE_E;
+
+    if ((sz < CRL_COMPILED_HDR_SZ) ||
+            (XMEMCMP(data, crlCompiledMagic, sizeof(crlCompiledMagic)) != 0) ||
+            (data[CRL_COMPILED_OFF_VERSION] != CRL_COMPILED_VERSION) ||
+            (data[CRL_COMPILED_OFF_ISSUER_SZ] != CRL_DIGEST_SIZE) ||
+            (data[CRL_COMPILED_OFF_HASH_SZ] != SIGNER_DIGEST_SIZE) ||
+            (data[CRL_COMPILED_OFF_SERIAL_SZ] != CRL_COMPILED_SERIAL_SZ) ||
+            (data[CRL_COMPILED_OFF_DATE_SZ] != MAX_DATE_SIZE) ||
+            (data[CRL_COMPILED_OFF_DATE_SZ + 1] != 0) ||
+            (data[CRL_COMPILED_OFF_DATE_SZ + 2] != 0) ||
+            (data[CRL_COMPILED_OFF_DATE_SZ + 3] != 0)) {
+        WOLFSSL_MSG("Not a compiled CRL for this build");
+        return ASN_PARSE_E;
+    }
+    cnt = CrlCompiledGet32(data + CRL_COMPILED_OFF_COUNT);
+    if ((cnt > (sz - CRL_COMPILED_HDR_SZ) / CRL_COMPILED_ENTRY_SZ) ||
+            (CRL_COMPILED_HDR_SZ + cnt * CRL_COMPILED_ENTRY_SZ != sz)) {
+        WOLFSSL_MSG("Compiled CRL size doesn't match count");
+        return ASN_PARSE_E;
+    }
+    ret = CrlCompiledMac(crl->cm, data, sz, mac);
+    if (ret != 0)
+        return ret;
+    if (ConstantCompare(mac, data + CRL_COMPILED_OFF_MAC, sizeof(mac)) != 0) {
+        WOLFSSL_MSG("Compiled CRL HMAC doesn't match");
+        return ASN_CRL_CONFIRM_E;
+    }
+    /* Only use a compiled CRL from an issuer that is currently trusted. */
+    XMEMCPY(issuerHash, data + CRL_COMPILED_OFF_ISSUER, CRL_DIGEST_SIZE);
+#ifndef NO_SKID
+    if (GetCAByName(crl->cm, issuerHash) == NULL)
+#else
+    if (GetCA(crl->cm, issuerHash) == NULL)
+#endif
+    {
+        WOLFSSL_MSG("Did NOT find compiled CRL issuer CA");
+        return ASN_CRL_NO_SIGNER_E;
+    }
+    if (!CrlCompiledIsSorted(data + CRL_COMPILED_HDR_SZ, cnt,
+                CRL_COMPILED_SERIAL_SZ) ||
+            !CrlCompiledIsSorted(data + CRL_COMPILED_HDR_SZ +
+                (size_t)cnt * CRL_COMPILED_SERIAL_SZ, cnt,
+                SIGNER_DIGEST_SIZE)) {
+        WOLFSSL_MSG("Compiled CRL records not in order");
+        return ASN_PARSE_E;
+    }
+
+    node = (CRL_Compiled*)XMALLOC(sizeof(CRL_Compiled), crl->heap,
+                                  DYNAMIC_TYPE_CRL_ENTRY);
+    if (node == NULL)
+        return MEMORY_E;
+    node->data = data;
+    node->sz = sz;
+    node->mapped = (byte)(mapped != 0);
+
+    if (wc_LockRwLock_Wr(&crl->crlLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr failed");
+        XFREE(node, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+        return BAD_MUTEX_E;
+    }
+    for (c = crl->compiledList; c != NULL; c = c->next) {
+        if (XMEMCMP(c->data + CRL_COMPILED_OFF_ISSUER,
+                data + CRL_COMPILED_OFF_ISSUER, CRL_DIGEST_SIZE) == 0) {
+            break;
+        }
+    }
+    if (c != NULL) {
+        /* Swap in new data for issuer. */
+        old = c->data;
+        oldSz = c->sz;
+        oldMapped = c->mapped;
+        c->data = node->data;
+        c->sz = node->sz;
+        c->mapped = node->mapped;
+    }
+    else {
+        node->next = crl->compiledList;
+        crl->compiledList = node;
+        node = NULL;
+    }
+    wc_UnLockRwLock(&crl->crlLock);
+
+    XFREE(node, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+    if (old != NULL) {
+        CRL_Compiled_Release(old, oldSz, oldMapped);
+    }
+
+    return 0;
+}
+
+#if defined(WOLFSSL_CRL_COMPILED_MMAP) && !defined(NO_FILESYSTEM)
+/* Map a compiled CRL file and load it.
+ *
+ * @param [in] crl   CRL object.
+ * @param [in] file  Name of compiled CRL file.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when crl or file is NULL.
+ * @return  BAD_PATH_ERROR when file can't be opened or is empty.
+ * @return  MEMORY_E when mapping file fails.
+ * @return  Other negative value when loading fails.
+ */
+int LoadCompiledCRLFile(WOLFSSL_CRL* crl, const char* file)
+{
+    int ret;
+    int fd;
+    struct stat st;
+    void* mem;
+
+    WOLFSSL_ENTER("LoadCompiledCRLFile");
+
+    if (crl == NULL || file == NULL)
+        return BAD_FUNC_ARG;
+
+    fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        WOLFSSL_MSG("Couldn't open compiled CRL file");
+        return BAD_PATH_ERROR;
+    }
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0) ||
+            ((word64)st.st_size > 0xFFFFFFFFU)) {
+        WOLFSSL_MSG("Bad compiled CRL file size");
+        (void)close(fd);
+        return BAD_PATH_ERROR;
+    }
+    mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (mem == MAP_FAILED) {
+        WOLFSSL_MSG("Compiled CRL mmap failed");
+        return MEMORY_E;
+    }
+
+    ret = LoadCompiledCRL(crl, (const byte*)mem, (word32)st.st_size, 1);
+    if (ret != 0) {
+        (void)munmap(mem, (size_t)st.st_size);
+    }
+
+    return ret;
+}
+#endif
+#endif /* WOLFSSL_CRL_COMPILED */
+
 #if defined(OPENSSL_EXTRA) && defined(HAVE_CRL)
 /* helper function to create a new dynamic WOLFSSL_X509_CRL structure */
 static WOLFSSL_X509_CRL* wolfSSL_X509_crl_new(WOLFSSL_CERT_MANAGER* cm)
@@ -769,6 +1681,14 @@ static CRL_Entry* DupCRL_Entry(const CRL_Entry* ent, void* heap)
 #ifndef CRL_STATIC_REVOKED_LIST
     dupl->certs = DupRevokedCertList(ent->certs, heap);
 #endif
+#ifdef WOLFSSL_CRL_SERIAL_INDEX
+    /* Index refers to the revoked certificates of the original. */
+    if ((ent->serialIndex != NULL) &&
+            (CRL_Entry_BuildIndex(dupl, heap) != 0)) {
+        CRL_Entry_free(dupl, heap);
+        return NULL;
+    }
+#endif
 #ifdef OPENSSL_EXTRA
     dupl->issuer = wolfSSL_X509_NAME_dup(ent->issuer);
 #endif
@@ -1231,12 +2151,10 @@ static THREAD_RETURN WOLFSSL_THREAD DoMonitor(void* arg)
 #include <unistd.h>
 
 
-#ifndef max
-    static WC_INLINE int max(int a, int b)
-    {
-        return a > b ? a : b;
-    }
-#endif /* max */
+static WC_INLINE int crl_max_fd(int a, int b)
+{
+    return a > b ? a : b;
+}
 
 
 /* shutdown monitor thread, 0 on success */
@@ -1334,7 +2252,8 @@ static THREAD_RETURN WOLFSSL_THREAD DoMonitor(void* arg)
         FD_SET(notifyFd, &readfds);
         FD_SET(crl->mfd, &readfds);
 
-        result = select(max(notifyFd, crl->mfd) + 1, &readfds, NULL, NULL,NULL);
+        result = select(crl_max_fd(notifyFd, crl->mfd) + 1, &readfds, NULL,
+            NULL, NULL);
 
         WOLFSSL_MSG("Got notify event");
 
@@ -234,6 +234,7 @@ static byte Dtls13TypeIsEncrypted(enum HandShakeType hs_type)
     case finished:
     case certificate_status:
     case key_update:
+    case compressed_certificate:
     case change_cipher_hs:
     case message_hash:
     case no_shake:
@@ -1504,7 +1505,7 @@ static void Dtls13RtxMoveToEndOfList(WOLFSSL* ssl, Dtls13RtxRecord** prevNext,
     Dtls13RtxAddRecord(&ssl->dtls13Rtx, r);
 }
 
-static int Dtls13RtxSendBuffered(WOLFSSL* ssl)
+static int Dtls13RtxSendRecords(WOLFSSL* ssl)
 {
     word16 headerLength;
     Dtls13RtxRecord *r, **prevNext;
@@ -1587,6 +1588,31 @@ static int Dtls13RtxSendBuffered(WOLFSSL* ssl)
     return 0;
 }
 
+static int Dtls13RtxSendBuffered(WOLFSSL* ssl)
+{
+#ifdef WOLFSSL_DTLS_MMSG
+    int ret;
+
+    if (!DtlsMmsgSendStart(ssl))
+        return Dtls13RtxSendRecords(ssl);
+
+    /* All records to retransmit are written with one sendmmsg(). */
+    ret = Dtls13RtxSendRecords(ssl);
+    if (ret == 0)
+        ret = DtlsMmsgSendEnd(ssl);
+    else
+        (void)DtlsMmsgSendEnd(ssl);
+    /* Records left queued go out before the next datagram. */
+    if (ret == WC_NO_ERR_TRACE(WANT_WRITE) &&
+            ssl->buffers.outputBuffer.length == 0) {
+        ret = 0;
+    }
+    return ret;
+#else
+    return Dtls13RtxSendRecords(ssl);
+#endif
+}
+
 static int Dtls13AcceptFragmented(WOLFSSL *ssl, enum HandShakeType type)
 {
     if (IsEncryptionOn(ssl, 0))
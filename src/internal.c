@@ -131,6 +131,11 @@
     #include <wolfssl/wolfcrypt/port/aria/aria-cryptocb.h>
 #endif
 
+#ifdef WOLFSSL_KTLS
+    /* included to get kernel TLS crypto info structures */
+    #include <linux/tls.h>
+#endif
+
 #if defined(DEBUG_WOLFSSL) || defined(SHOW_SECRETS) || \
     defined(CHACHA_AEAD_TEST) || defined(WOLFSSL_SESSION_EXPORT_DEBUG)
     #ifndef NO_STDIO_FILESYSTEM
@@ -2547,6 +2552,17 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
     ctx->doAppleNativeCertValidationFlag = 0;
 #endif /* defined(__APPLE__) && defined(WOLFSSL_SYS_CA_CERTS) */
 
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    if (ret == 0) {
+        if (wc_InitMutex(&ctx->privKeyCache.lock) != 0) {
+            WOLFSSL_MSG("Bad mutex init");
+            WOLFSSL_ERROR_VERBOSE(BAD_MUTEX_E);
+            return BAD_MUTEX_E;
+        }
+        ctx->privKeyCacheInit = 1;
+    }
+#endif
+
     return ret;
 }
 
@@ -2626,6 +2642,10 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
     XFREE(ctx->suites, ctx->heap, DYNAMIC_TYPE_SUITES);
     ctx->suites = NULL;
 
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    TLSX_KeySharePool_Free(ctx);
+#endif
+
 #ifndef NO_DH
     XFREE(ctx->serverDH_G.buffer, ctx->heap, DYNAMIC_TYPE_PUBLIC_KEY);
     ctx->serverDH_G.buffer = NULL;
@@ -2642,6 +2662,13 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
 #endif /* SINGLE_THREADED */
 
 #ifndef NO_CERTS
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    if (ctx->privKeyCacheInit) {
+        PrivKeyCache_Flush(ctx);
+        wc_FreeMutex(&ctx->privKeyCache.lock);
+        ctx->privKeyCacheInit = 0;
+    }
+#endif
     if (ctx->privateKey != NULL && ctx->privateKey->buffer != NULL) {
         ForceZero(ctx->privateKey->buffer, ctx->privateKey->length);
     }
@@ -2698,6 +2725,10 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
     TLSX_FreeAll(ctx->extensions, ctx->heap);
 #endif /* !NO_TLS */
 #ifndef NO_WOLFSSL_SERVER
+#ifdef WOLFSSL_OCSP_STAPLE_CACHE
+    /* Stop refresh thread before certificate manager is freed. */
+    FreeOcspStapleCache(ctx);
+#endif
 #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
  || defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
     if (ctx->certOcspRequest) {
@@ -7773,9 +7804,9 @@ void FreeArrays(WOLFSSL* ssl, int keep)
     ssl->arrays = NULL;
 }
 
-void FreeKey(WOLFSSL* ssl, int type, void** pKey)
+static void FreeKey_ex(void* heap, int type, void** pKey)
 {
-    if (ssl && pKey && *pKey) {
+    if (pKey && *pKey) {
         switch (type) {
         #ifndef NO_RSA
             case DYNAMIC_TYPE_RSA:
@@ -7833,13 +7864,246 @@ void FreeKey(WOLFSSL* ssl, int type, void** pKey)
             default:
                 break;
         }
-        XFREE(*pKey, ssl->heap, type);
+        XFREE(*pKey, heap, type);
 
         /* Reset pointer */
         *pKey = NULL;
     }
+
+    (void)heap;
 }
 
+void FreeKey(WOLFSSL* ssl, int type, void** pKey)
+{
+    if (ssl) {
+        FreeKey_ex(ssl->heap, type, pKey);
+    }
+}
+
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+/* Check whether the handshake key of the SSL object can be shared through the
+ * CTX cache: the SSL is using the CTX private key, by reference or as a copy
+ * (WOLFSSL_COPY_KEY), with the same heap and device as the CTX.
+ *
+ * ssl  The SSL/TLS object.
+ * returns 1 when the cache can be used and 0 otherwise.
+ */
+static int PrivKeyCache_Usable(WOLFSSL* ssl)
+{
+    DerBuffer* key = ssl->buffers.key;
+    DerBuffer* ctxKey;
+
+    if (ssl->ctx == NULL || !ssl->ctx->privKeyCacheInit || key == NULL ||
+            ssl->heap != ssl->ctx->heap || ssl->devId != ssl->ctx->devId) {
+        return 0;
+    }
+#ifdef WOLF_PRIVATE_KEY_ID
+    if (ssl->buffers.keyId || ssl->buffers.keyLabel) {
+        return 0;
+    }
+#endif
+    ctxKey = ssl->ctx->privateKey;
+    if (key == ctxKey) {
+        return 1;
+    }
+    return ctxKey != NULL && key->length == ctxKey->length &&
+           ConstantCompare(key->buffer, ctxKey->buffer,
+                           (int)key->length) == 0;
+}
+
+/* Take a decoded private key object from the CTX cache.
+ *
+ * On a hit, hsKey and hsType are set and the maximum signature length is
+ * returned. On a miss, hsKey is left NULL and the caller decodes the key.
+ *
+ * ssl     The SSL/TLS object.
+ * length  The length of a signature.
+ * returns 0 on hit or miss, otherwise failure.
+ */
+static int PrivKeyCache_Take(WOLFSSL* ssl, word32* length)
+{
+    int ret = 0;
+    PrivKeyCache* cache = &ssl->ctx->privKeyCache;
+
+    if (ssl->hsKey != NULL || !PrivKeyCache_Usable(ssl)) {
+        return 0;
+    }
+    if (wc_LockMutex(&cache->lock) != 0) {
+        return BAD_MUTEX_E;
+    }
+    ssl->hsKeyGen = cache->gen;
+    if (cache->count > 0) {
+        cache->count--;
+        ssl->hsKey = cache->keys[cache->count];
+        cache->keys[cache->count] = NULL;
+        ssl->hsType = cache->type;
+        cache->hits++;
+    }
+    else {
+        cache->misses++;
+    }
+    wc_UnLockMutex(&cache->lock);
+
+    if (ssl->hsKey == NULL) {
+        return 0;
+    }
+    /* Key is returned to the cache when the handshake key is freed. */
+    ssl->options.hsKeyCached = 1;
+
+    /* Minimum key sizes are per SSL object - check again. */
+#ifndef NO_RSA
+    if (ssl->hsType == DYNAMIC_TYPE_RSA) {
+        int keySz = wc_RsaEncryptSize((RsaKey*)ssl->hsKey);
+        if (keySz < 0) {
+            ret = keySz;
+        }
+        else if (keySz < ssl->options.minRsaKeySz) {
+            WOLFSSL_MSG("RSA key size too small");
+            ret = RSA_KEY_SIZE_E;
+        }
+        else {
+            *length = (word32)keySz;
+        }
+    }
+#endif
+#ifdef HAVE_ECC
+    if (ssl->hsType == DYNAMIC_TYPE_ECC) {
+        if (wc_ecc_size((ecc_key*)ssl->hsKey) < ssl->options.minEccKeySz) {
+            WOLFSSL_MSG("ECC key size too small");
+            ret = ECC_KEY_SIZE_E;
+        }
+        else {
+            *length = (word32)wc_ecc_sig_size((ecc_key*)ssl->hsKey);
+        }
+    }
+#endif
+
+    return ret;
+}
+
+/* Mark a freshly decoded handshake key to be put in the CTX cache when it is
+ * freed. Only RSA and ECC keys holding the private part are cached.
+ *
+ * ssl  The SSL/TLS object.
+ */
+static void PrivKeyCache_Mark(WOLFSSL* ssl)
+{
+    int priv = 0;
+
+    if (ssl->hsKey == NULL || ssl->options.hsKeyCached ||
+            !PrivKeyCache_Usable(ssl)) {
+        return;
+    }
+#ifndef NO_RSA
+    if (ssl->hsType == DYNAMIC_TYPE_RSA) {
+        priv = ((RsaKey*)ssl->hsKey)->type == RSA_PRIVATE;
+    }
+#endif
+#ifdef HAVE_ECC
+    if (ssl->hsType == DYNAMIC_TYPE_ECC) {
+        priv = ((ecc_key*)ssl->hsKey)->type == ECC_PRIVATEKEY ||
+               ((ecc_key*)ssl->hsKey)->type == ECC_PRIVATEKEY_ONLY;
+    }
+#endif
+    ssl->options.hsKeyCached = (word16)priv;
+}
+
+/* Put the handshake key back into the CTX cache.
+ * The key is freed instead when the cache is full or the CTX private key has
+ * changed since the key was taken.
+ *
+ * ssl  The SSL/TLS object.
+ */
+static void PrivKeyCache_Put(WOLFSSL* ssl)
+{
+    PrivKeyCache* cache = &ssl->ctx->privKeyCache;
+
+    ssl->options.hsKeyCached = 0;
+    if (ssl->hsKey == NULL) {
+        return;
+    }
+
+    /* Don't leave a reference to this SSL object's random in the key. */
+#if !defined(NO_RSA) && defined(WC_RSA_BLINDING)
+    if (ssl->hsType == DYNAMIC_TYPE_RSA) {
+        ((RsaKey*)ssl->hsKey)->rng = NULL;
+    }
+#endif
+#if defined(HAVE_ECC) && defined(ECC_TIMING_RESISTANT)
+    if (ssl->hsType == DYNAMIC_TYPE_ECC) {
+        ((ecc_key*)ssl->hsKey)->rng = NULL;
+    }
+#endif
+
+    if (wc_LockMutex(&cache->lock) != 0) {
+        return;
+    }
+    if (ssl->hsKeyGen == cache->gen &&
+            cache->count < WOLFSSL_PRIV_KEY_CACHE_SZ &&
+            (cache->count == 0 || cache->type == ssl->hsType)) {
+        cache->type = ssl->hsType;
+        cache->keys[cache->count++] = ssl->hsKey;
+        ssl->hsKey = NULL;
+    }
+    wc_UnLockMutex(&cache->lock);
+}
+
+/* Free all cached private key objects of the CTX.
+ * Called when the CTX private key is replaced or the CTX is freed. Keys
+ * checked out by handshakes in progress are freed when they are put back.
+ *
+ * ctx  The SSL/TLS context.
+ */
+void PrivKeyCache_Flush(WOLFSSL_CTX* ctx)
+{
+    PrivKeyCache* cache;
+
+    if (ctx == NULL || !ctx->privKeyCacheInit) {
+        return;
+    }
+    cache = &ctx->privKeyCache;
+    if (wc_LockMutex(&cache->lock) != 0) {
+        return;
+    }
+    while (cache->count > 0) {
+        cache->count--;
+        FreeKey_ex(ctx->heap, (int)cache->type, &cache->keys[cache->count]);
+    }
+    cache->gen++;
+    wc_UnLockMutex(&cache->lock);
+}
+
+/* Get the statistics of the cache of decoded private key objects.
+ *
+ * ctx    The SSL/TLS CTX object.
+ * stats  The statistics filled in.
+ * returns WOLFSSL_SUCCESS on success, BAD_FUNC_ARG when a parameter is NULL
+ * and BAD_MUTEX_E when the lock can't be taken.
+ */
+int wolfSSL_CTX_PrivKeyCache_GetStats(WOLFSSL_CTX* ctx,
+    WOLFSSL_PRIV_KEY_CACHE_STATS* stats)
+{
+    PrivKeyCache* cache;
+
+    if (ctx == NULL || stats == NULL)
+        return BAD_FUNC_ARG;
+
+    XMEMSET(stats, 0, sizeof(*stats));
+    if (!ctx->privKeyCacheInit)
+        return WOLFSSL_SUCCESS;
+
+    cache = &ctx->privKeyCache;
+    if (wc_LockMutex(&cache->lock) != 0)
+        return BAD_MUTEX_E;
+    stats->ready = cache->count;
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    wc_UnLockMutex(&cache->lock);
+
+    return WOLFSSL_SUCCESS;
+}
+#endif /* WOLFSSL_PRIV_KEY_CACHE */
+
 int AllocKey(WOLFSSL* ssl, int type, void** pKey)
 {
     int ret = WC_NO_ERR_TRACE(BAD_FUNC_ARG);
@@ -8125,6 +8389,11 @@ void FreeKeyExchange(WOLFSSL* ssl)
     }
 
     /* Free handshake key */
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    if (ssl->options.hsKeyCached) {
+        PrivKeyCache_Put(ssl);
+    }
+#endif
     FreeKey(ssl, (int)ssl->hsType, &ssl->hsKey);
 #ifdef WOLFSSL_DUAL_ALG_CERTS
     FreeKey(ssl, ssl->hsAltType, &ssl->hsAltKey);
@@ -8172,6 +8441,9 @@ void SSL_ResourceFree(WOLFSSL* ssl)
 #ifdef HAVE_EX_DATA_CLEANUP_HOOKS
     wolfSSL_CRYPTO_cleanup_ex_data(&ssl->ex_data);
 #endif
+#ifdef WOLFSSL_IO_URING
+    wolfIO_IoUringDetach(ssl);
+#endif
 
     FreeCiphers(ssl);
     FreeArrays(ssl, 0);
@@ -8260,6 +8532,9 @@ void SSL_ResourceFree(WOLFSSL* ssl)
     }
     XFREE(ssl->buffers.dtlsCtx.peer.sa, ssl->heap, DYNAMIC_TYPE_SOCKADDR);
     ssl->buffers.dtlsCtx.peer.sa = NULL;
+#ifdef WOLFSSL_DTLS_MMSG
+    wolfIO_DtlsMmsgFree(&ssl->buffers.dtlsCtx, ssl->heap);
+#endif
 #ifndef NO_WOLFSSL_SERVER
     if (ssl->buffers.dtlsCookieSecret.buffer != NULL) {
         ForceZero(ssl->buffers.dtlsCookieSecret.buffer,
@@ -8420,6 +8695,12 @@ void SSL_ResourceFree(WOLFSSL* ssl)
         XFREE(curr, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
     }
 #endif
+#ifdef WOLFSSL_CERT_COMPRESSION
+    XFREE(ssl->certCompMsg, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    ssl->certCompMsg = NULL;
+    XFREE(ssl->certCompIn, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    ssl->certCompIn = NULL;
+#endif
 #ifdef WOLFSSL_STATIC_EPHEMERAL
     #ifndef NO_DH
     FreeDer(&ssl->staticKE.dhKey);
@@ -9546,9 +9827,53 @@ int VerifyForTxDtlsMsgDelete(WOLFSSL* ssl, DtlsMsg* item)
 }
 
 
-/* DtlsMsgPoolSend() will send the stored transmit list. The stored list is
- * updated with new sequence numbers, and will be re-encrypted if needed. */
-int DtlsMsgPoolSend(WOLFSSL* ssl, int sendOnlyFirstPacket)
+#ifdef WOLFSSL_DTLS_MMSG
+/* Queue the datagrams about to be written to send them with one sendmmsg()
+ * call. Only the built-in I/O callback can queue.
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ * @return  1 when datagrams are queued and DtlsMmsgSendEnd() must be called.
+ * @return  0 when datagrams are sent as they are written.
+ */
+int DtlsMmsgSendStart(WOLFSSL* ssl)
+{
+    if (ssl->CBIOSend != EmbedSendTo ||
+            ssl->IOCB_WriteCtx != &ssl->buffers.dtlsCtx) {
+        return 0;
+    }
+    /* Sending one at a time still works when memory is short. */
+    return wolfIO_DtlsSendDefer(ssl, ssl->IOCB_WriteCtx) == 0;
+}
+
+/* Write the datagrams queued since DtlsMmsgSendStart().
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ * @return  0 on success.
+ * @return  WANT_WRITE when the socket is full. The datagrams not written stay
+ *          queued and are written before the next datagram.
+ * @return  SOCKET_ERROR_E when writing to the socket failed.
+ */
+int DtlsMmsgSendEnd(WOLFSSL* ssl)
+{
+    int ret = wolfIO_DtlsSendFlush(ssl, &ssl->buffers.dtlsCtx);
+
+    if (ret == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_WANT_WRITE)) {
+        return WANT_WRITE;
+    }
+    if (ret < 0) {
+        if (ret == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_CONN_RST) ||
+                ret == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_CONN_CLOSE)) {
+            ssl->options.connReset = 1;
+        }
+        WOLFSSL_ERROR_VERBOSE(SOCKET_ERROR_E);
+        return SOCKET_ERROR_E;
+    }
+
+    return 0;
+}
+#endif /* WOLFSSL_DTLS_MMSG */
+
+static int DtlsMsgPoolSendRecords(WOLFSSL* ssl, int sendOnlyFirstPacket)
 {
     int ret = 0;
     DtlsMsg* pool;
@@ -9683,6 +10008,33 @@ int DtlsMsgPoolSend(WOLFSSL* ssl, int sendOnlyFirstPacket)
     return ret;
 }
 
+/* DtlsMsgPoolSend() will send the stored transmit list. The stored list is
+ * updated with new sequence numbers, and will be re-encrypted if needed. */
+int DtlsMsgPoolSend(WOLFSSL* ssl, int sendOnlyFirstPacket)
+{
+#ifdef WOLFSSL_DTLS_MMSG
+    int ret;
+
+    if (!DtlsMmsgSendStart(ssl))
+        return DtlsMsgPoolSendRecords(ssl, sendOnlyFirstPacket);
+
+    /* Whole flight is written with one sendmmsg(). */
+    ret = DtlsMsgPoolSendRecords(ssl, sendOnlyFirstPacket);
+    if (ret == 0)
+        ret = DtlsMmsgSendEnd(ssl);
+    else
+        (void)DtlsMmsgSendEnd(ssl);
+    /* Datagrams of the flight left queued go out before the next one. */
+    if (ret == WC_NO_ERR_TRACE(WANT_WRITE) &&
+            ssl->buffers.outputBuffer.length == 0) {
+        ret = 0;
+    }
+    return ret;
+#else
+    return DtlsMsgPoolSendRecords(ssl, sendOnlyFirstPacket);
+#endif
+}
+
 #endif /* WOLFSSL_DTLS */
 
 #if defined(WOLFSSL_ALLOW_SSLV3) && !defined(NO_OLD_TLS)
@@ -10613,12 +10965,223 @@ retry:
 }
 
 
+#ifdef WOLFSSL_RECORD_POOL
+/* Record buffers shared by all connections.
+ *
+ * A connection borrows a buffer only while a record is being read or written
+ * and gives it back when the static buffer is enough again. Idle buffers are
+ * kept on a free list, linked through their first bytes, up to maxIdle.
+ * Each idle buffer remembers the heap it was allocated from and is only lent
+ * to connections using the same heap.
+ * The pool is library wide as a connection may change WOLFSSL_CTX, with a
+ * record in progress, in the SNI callback.
+ */
+typedef struct RecordPoolBuf {
+    struct RecordPoolBuf* next;
+    void* heap;
+} RecordPoolBuf;
+
+typedef struct RecordPool {
+    wolfSSL_Mutex mutex;
+    RecordPoolBuf* freeList;
+    word32 maxIdle;
+    WOLFSSL_RECORD_POOL_STATS stats;
+    byte   valid;
+} RecordPool;
+
+static RecordPool recordPool;
+
+/* Initialize the record buffer pool. Called from wolfSSL_Init().
+ *
+ * @return  0 on success.
+ * @return  BAD_MUTEX_E when the mutex can't be initialized.
+ */
+int InitRecordPool(void)
+{
+    XMEMSET(&recordPool, 0, sizeof(recordPool));
+    if (wc_InitMutex(&recordPool.mutex) != 0) {
+        WOLFSSL_MSG("Bad Init Mutex record pool");
+        return BAD_MUTEX_E;
+    }
+    recordPool.maxIdle = WOLFSSL_RECORD_POOL_MAX_IDLE;
+    recordPool.valid = 1;
+    return 0;
+}
+
+/* Free the idle buffers of the record pool. Called from wolfSSL_Cleanup().
+ * Buffers still lent out are freed when given back.
+ */
+void FreeRecordPool(void)
+{
+    RecordPoolBuf* buf;
+
+    if (!recordPool.valid) {
+        return;
+    }
+    recordPool.valid = 0;
+    while ((buf = recordPool.freeList) != NULL) {
+        recordPool.freeList = buf->next;
+        XFREE(buf, buf->heap, DYNAMIC_TYPE_IN_BUFFER);
+    }
+    wc_FreeMutex(&recordPool.mutex);
+}
+
+/* Borrow a buffer of WOLFSSL_RECORD_POOL_BUF_SZ bytes from the pool.
+ *
+ * @param [in] heap  Heap hint of the connection.
+ * @return  Buffer on success.
+ * @return  NULL when memory allocation fails.
+ */
+static byte* RecordPoolGet(void* heap)
+{
+    RecordPoolBuf** prev;
+    RecordPoolBuf*  buf = NULL;
+    byte* tmp;
+
+    if (recordPool.valid && wc_LockMutex(&recordPool.mutex) == 0) {
+        prev = &recordPool.freeList;
+        while ((buf = *prev) != NULL && buf->heap != heap) {
+            prev = &buf->next;
+        }
+        if (buf != NULL) {
+            *prev = buf->next;
+            recordPool.stats.idle--;
+        }
+        else {
+            /* Counted now so that the allocation is outside of the lock. */
+            recordPool.stats.allocs++;
+        }
+        if (++recordPool.stats.inUse > recordPool.stats.peakInUse) {
+            recordPool.stats.peakInUse = recordPool.stats.inUse;
+        }
+        wc_UnLockMutex(&recordPool.mutex);
+        if (buf != NULL) {
+            return (byte*)buf;
+        }
+    }
+
+    tmp = (byte*)XMALLOC(WOLFSSL_RECORD_POOL_BUF_SZ, heap,
+        DYNAMIC_TYPE_IN_BUFFER);
+    if (tmp == NULL && recordPool.valid &&
+            wc_LockMutex(&recordPool.mutex) == 0) {
+        recordPool.stats.allocs--;
+        recordPool.stats.inUse--;
+        wc_UnLockMutex(&recordPool.mutex);
+    }
+    return tmp;
+}
+
+/* Give a buffer back to the pool. Freed when enough buffers are idle.
+ *
+ * @param [in] buf   Buffer from RecordPoolGet().
+ * @param [in] heap  Heap hint passed to RecordPoolGet().
+ */
+static void RecordPoolPut(byte* buf, void* heap)
+{
+    if (recordPool.valid && wc_LockMutex(&recordPool.mutex) == 0) {
+        recordPool.stats.inUse--;
+        if (recordPool.stats.idle < recordPool.maxIdle) {
+            ((RecordPoolBuf*)buf)->next = recordPool.freeList;
+            ((RecordPoolBuf*)buf)->heap = heap;
+            recordPool.freeList = (RecordPoolBuf*)buf;
+            recordPool.stats.idle++;
+            buf = NULL;
+        }
+        wc_UnLockMutex(&recordPool.mutex);
+    }
+    XFREE(buf, heap, DYNAMIC_TYPE_IN_BUFFER);
+    (void)heap;
+}
+
+/* Set the number of idle record buffers kept for reuse.
+ *
+ * Idle buffers over the new limit are freed. With 0, every buffer is freed
+ * once the connection gives it back.
+ *
+ * @param [in] maxIdle  Maximum number of idle buffers.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_STATE_E when the library isn't initialized.
+ * @return  BAD_MUTEX_E when locking fails.
+ */
+int wolfSSL_RecordPool_SetMaxIdle(word32 maxIdle)
+{
+    RecordPoolBuf* freeList = NULL;
+    RecordPoolBuf* buf;
+
+    WOLFSSL_ENTER("wolfSSL_RecordPool_SetMaxIdle");
+
+    if (!recordPool.valid) {
+        return BAD_STATE_E;
+    }
+    if (wc_LockMutex(&recordPool.mutex) != 0) {
+        return BAD_MUTEX_E;
+    }
+    recordPool.maxIdle = maxIdle;
+    while (recordPool.stats.idle > maxIdle) {
+        buf = recordPool.freeList;
+        recordPool.freeList = buf->next;
+        recordPool.stats.idle--;
+        buf->next = freeList;
+        freeList = buf;
+    }
+    wc_UnLockMutex(&recordPool.mutex);
+
+    while ((buf = freeList) != NULL) {
+        freeList = buf->next;
+        XFREE(buf, buf->heap, DYNAMIC_TYPE_IN_BUFFER);
+    }
+    return WOLFSSL_SUCCESS;
+}
+
+/* Get the statistics of the record buffer pool.
+ *
+ * @param [out] stats  Statistics.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when stats is NULL.
+ * @return  BAD_STATE_E when the library isn't initialized.
+ * @return  BAD_MUTEX_E when locking fails.
+ */
+int wolfSSL_RecordPool_GetStats(WOLFSSL_RECORD_POOL_STATS* stats)
+{
+    if (stats == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    if (!recordPool.valid) {
+        return BAD_STATE_E;
+    }
+    if (wc_LockMutex(&recordPool.mutex) != 0) {
+        return BAD_MUTEX_E;
+    }
+    *stats = recordPool.stats;
+    wc_UnLockMutex(&recordPool.mutex);
+    return WOLFSSL_SUCCESS;
+}
+#endif /* WOLFSSL_RECORD_POOL */
+
+/* Free the dynamic memory of a record buffer.
+ *
+ * @param [in] ssl   SSL/TLS object.
+ * @param [in] buf   Input or output buffer with dynamic memory.
+ * @param [in] type  Dynamic memory type of buffer.
+ */
+static void FreeRecordBuffer(WOLFSSL* ssl, bufferStatic* buf, int type)
+{
+#ifdef WOLFSSL_RECORD_POOL
+    if (buf->pooled) {
+        RecordPoolPut(buf->buffer - buf->offset, ssl->heap);
+        buf->pooled = 0;
+        return;
+    }
+#endif
+    XFREE(buf->buffer - buf->offset, ssl->heap, type);
+    (void)type;
+}
+
 /* Switch dynamic output buffer back to static, buffer is assumed clear */
 void ShrinkOutputBuffer(WOLFSSL* ssl)
 {
     WOLFSSL_MSG("Shrinking output buffer");
-    XFREE(ssl->buffers.outputBuffer.buffer - ssl->buffers.outputBuffer.offset,
-          ssl->heap, DYNAMIC_TYPE_OUT_BUFFER);
+    FreeRecordBuffer(ssl, &ssl->buffers.outputBuffer, DYNAMIC_TYPE_OUT_BUFFER);
     ssl->buffers.outputBuffer.buffer = ssl->buffers.outputBuffer.staticBuffer;
     ssl->buffers.outputBuffer.bufferSize  = STATIC_BUFFER_LEN;
     ssl->buffers.outputBuffer.dynamicFlag = 0;
@@ -10650,8 +11213,7 @@ void ShrinkInputBuffer(WOLFSSL* ssl, int forcedFree)
 
     ForceZero(ssl->buffers.inputBuffer.buffer,
         ssl->buffers.inputBuffer.length);
-    XFREE(ssl->buffers.inputBuffer.buffer - ssl->buffers.inputBuffer.offset,
-          ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+    FreeRecordBuffer(ssl, &ssl->buffers.inputBuffer, DYNAMIC_TYPE_IN_BUFFER);
     ssl->buffers.inputBuffer.buffer = ssl->buffers.inputBuffer.staticBuffer;
     ssl->buffers.inputBuffer.bufferSize  = STATIC_BUFFER_LEN;
     ssl->buffers.inputBuffer.dynamicFlag = 0;
@@ -10683,6 +11245,16 @@ int SendBuffered(WOLFSSL* ssl)
     }
 #endif
 
+#ifdef WOLFSSL_KTLS
+    /* Records protected by wolfSSL would be encrypted again by the kernel. */
+    if ((ssl->ktls & WOLFSSL_KTLS_TX) &&
+            ssl->buffers.outputBuffer.length > 0) {
+        WOLFSSL_MSG("Message can't be sent with kernel TLS sending");
+        WOLFSSL_ERROR_VERBOSE(BAD_STATE_E);
+        return BAD_STATE_E;
+    }
+#endif
+
     while (ssl->buffers.outputBuffer.length > 0) {
         int sent = 0;
 retry:
@@ -10775,6 +11347,9 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
     const byte align = WOLFSSL_GENERAL_ALIGNMENT;
 #endif
     word32 newSz;
+#ifdef WOLFSSL_RECORD_POOL
+    byte pooled;
+#endif
 
 #if WOLFSSL_GENERAL_ALIGNMENT > 0
     /* the encrypted data will be offset from the front of the buffer by
@@ -10792,7 +11367,17 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
         return BUFFER_E;
     if (! WC_SAFE_SUM_WORD32(newSz, align, newSz))
         return BUFFER_E;
-    tmp = (byte*)XMALLOC(newSz, ssl->heap, DYNAMIC_TYPE_OUT_BUFFER);
+#ifdef WOLFSSL_RECORD_POOL
+    pooled = (newSz <= WOLFSSL_RECORD_POOL_BUF_SZ);
+    if (pooled) {
+        tmp = RecordPoolGet(ssl->heap);
+        newSz = WOLFSSL_RECORD_POOL_BUF_SZ;
+    }
+    else
+#endif
+    {
+        tmp = (byte*)XMALLOC(newSz, ssl->heap, DYNAMIC_TYPE_OUT_BUFFER);
+    }
     newSz -= align;
     WOLFSSL_MSG("growing output buffer");
 
@@ -10819,11 +11404,13 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
                ssl->buffers.outputBuffer.length);
 
     if (ssl->buffers.outputBuffer.dynamicFlag) {
-        XFREE(ssl->buffers.outputBuffer.buffer -
-              ssl->buffers.outputBuffer.offset, ssl->heap,
-              DYNAMIC_TYPE_OUT_BUFFER);
+        FreeRecordBuffer(ssl, &ssl->buffers.outputBuffer,
+            DYNAMIC_TYPE_OUT_BUFFER);
     }
     ssl->buffers.outputBuffer.dynamicFlag = 1;
+#ifdef WOLFSSL_RECORD_POOL
+    ssl->buffers.outputBuffer.pooled = pooled;
+#endif
 
 #if WOLFSSL_GENERAL_ALIGNMENT > 0
     if (align)
@@ -10842,6 +11429,9 @@ static WC_INLINE int GrowOutputBuffer(WOLFSSL* ssl, int size)
 int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength)
 {
     byte* tmp;
+#ifdef WOLFSSL_RECORD_POOL
+    byte  pooled;
+#endif
 #if defined(WOLFSSL_DTLS) || WOLFSSL_GENERAL_ALIGNMENT > 0
     byte  align = ssl->options.dtls ? WOLFSSL_GENERAL_ALIGNMENT : 0;
     byte  hdrSz = DTLS_RECORD_HEADER_SZ;
@@ -10866,8 +11456,20 @@ int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength)
         return BAD_FUNC_ARG;
     }
 
-    tmp = (byte*)XMALLOC((size_t)(size + usedLength + align),
-                             ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+#ifdef WOLFSSL_RECORD_POOL
+    pooled = ((word32)size + (word32)usedLength + align <=
+              WOLFSSL_RECORD_POOL_BUF_SZ);
+    if (pooled) {
+        tmp = RecordPoolGet(ssl->heap);
+        /* Use all of the pooled buffer. */
+        size = (int)(WOLFSSL_RECORD_POOL_BUF_SZ - align) - usedLength;
+    }
+    else
+#endif
+    {
+        tmp = (byte*)XMALLOC((size_t)(size + usedLength + align),
+                                 ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+    }
     WOLFSSL_MSG("growing input buffer");
 
     if (tmp == NULL)
@@ -10897,11 +11499,14 @@ int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength)
             ForceZero(ssl->buffers.inputBuffer.buffer,
                 ssl->buffers.inputBuffer.length);
         }
-        XFREE(ssl->buffers.inputBuffer.buffer - ssl->buffers.inputBuffer.offset,
-              ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+        FreeRecordBuffer(ssl, &ssl->buffers.inputBuffer,
+            DYNAMIC_TYPE_IN_BUFFER);
     }
 
     ssl->buffers.inputBuffer.dynamicFlag = 1;
+#ifdef WOLFSSL_RECORD_POOL
+    ssl->buffers.inputBuffer.pooled = pooled;
+#endif
 #if defined(WOLFSSL_DTLS) || WOLFSSL_GENERAL_ALIGNMENT > 0
     if (align)
         ssl->buffers.inputBuffer.offset = align - hdrSz;
@@ -11003,6 +11608,7 @@ int MsgCheckEncryption(WOLFSSL* ssl, byte type, byte encrypted)
             case finished:
             case certificate_status:
             case key_update:
+            case compressed_certificate:
                 if (!encrypted) {
                     WOLFSSL_MSG("Message always has to be encrypted");
                     WOLFSSL_ERROR_VERBOSE(OUT_OF_ORDER_E);
@@ -11063,6 +11669,7 @@ int MsgCheckEncryption(WOLFSSL* ssl, byte type, byte encrypted)
             case key_update:
             case encrypted_extensions:
             case end_of_early_data:
+            case compressed_certificate:
             case message_hash:
             case no_shake:
             default:
@@ -11113,6 +11720,7 @@ static int MsgCheckBoundary(const WOLFSSL* ssl, byte type,
                 case client_key_exchange:
                 case certificate_status:
                 case key_update:
+                case compressed_certificate:
                 case change_cipher_hs:
                     break;
                 case server_hello_done:
@@ -11151,6 +11759,7 @@ static int MsgCheckBoundary(const WOLFSSL* ssl, byte type,
                 case hello_retry_request:
                 case encrypted_extensions:
                 case key_update:
+                case compressed_certificate:
                 case message_hash:
                 case no_shake:
                 default:
@@ -11185,6 +11794,7 @@ static int MsgCheckBoundary(const WOLFSSL* ssl, byte type,
             case finished:
             case certificate_status:
             case key_update:
+            case compressed_certificate:
             case change_cipher_hs:
                 break;
             case message_hash:
@@ -21126,6 +21736,453 @@ static int removeMsgInnerPadding(WOLFSSL* ssl)
 }
 #endif
 
+#ifdef WOLFSSL_KTLS
+
+/* Kernel crypto info of the ciphers that can be offloaded. */
+typedef union KtlsCryptoInfo {
+    struct tls_crypto_info                     info;
+    struct tls12_crypto_info_aes_gcm_128       aesGcm128;
+    struct tls12_crypto_info_aes_gcm_256       aesGcm256;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    struct tls12_crypto_info_chacha20_poly1305 chacha;
+#endif
+} KtlsCryptoInfo;
+
+/* Put the current traffic keys of one direction into kernel crypto info.
+ *
+ * @param [in]  ssl   SSL/TLS object.
+ * @param [in]  tx    1 for the keys records are sent with, 0 for receiving.
+ * @param [out] ci    Kernel crypto info.
+ * @param [out] ciSz  Size of the crypto info of the cipher in bytes.
+ * @return  0 on success.
+ * @return  UNSUPPORTED_SUITE when the protocol version or cipher can't be
+ *          offloaded.
+ */
+static int KtlsGetCryptoInfo(WOLFSSL* ssl, int tx, KtlsCryptoInfo* ci,
+    word32* ciSz)
+{
+    const byte* key;
+    const byte* iv;
+    byte*       keyOut = NULL;
+    byte*       ivOut = NULL;
+    byte*       saltOut = NULL;
+    byte*       seqOut = NULL;
+    word32      ivSz = 0;
+    word32      saltSz = 0;
+    word32      keySz = ssl->specs.key_size;
+
+    XMEMSET(ci, 0, sizeof(*ci));
+
+    if (ssl->options.dtls || !IsAtLeastTLSv1_2(ssl)
+    #ifdef HAVE_LIBZ
+            || ssl->options.usingCompression
+    #endif
+    ) {
+        WOLFSSL_MSG("Protocol can't be offloaded to kernel TLS");
+        return UNSUPPORTED_SUITE;
+    }
+    ci->info.version = IsAtLeastTLSv1_3(ssl->version) ? TLS_1_3_VERSION :
+                                                        TLS_1_2_VERSION;
+
+    if (ssl->specs.bulk_cipher_algorithm == wolfssl_aes_gcm &&
+            keySz == AES_128_KEY_SIZE) {
+        ci->info.cipher_type = TLS_CIPHER_AES_GCM_128;
+        keyOut  = ci->aesGcm128.key;
+        ivOut   = ci->aesGcm128.iv;
+        ivSz    = TLS_CIPHER_AES_GCM_128_IV_SIZE;
+        saltOut = ci->aesGcm128.salt;
+        saltSz  = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+        seqOut  = ci->aesGcm128.rec_seq;
+        *ciSz   = (word32)sizeof(ci->aesGcm128);
+    }
+    else if (ssl->specs.bulk_cipher_algorithm == wolfssl_aes_gcm &&
+            keySz == AES_256_KEY_SIZE) {
+        ci->info.cipher_type = TLS_CIPHER_AES_GCM_256;
+        keyOut  = ci->aesGcm256.key;
+        ivOut   = ci->aesGcm256.iv;
+        ivSz    = TLS_CIPHER_AES_GCM_256_IV_SIZE;
+        saltOut = ci->aesGcm256.salt;
+        saltSz  = TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+        seqOut  = ci->aesGcm256.rec_seq;
+        *ciSz   = (word32)sizeof(ci->aesGcm256);
+    }
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    else if (ssl->specs.bulk_cipher_algorithm == wolfssl_chacha &&
+            keySz == TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE) {
+        ci->info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+        keyOut  = ci->chacha.key;
+        ivOut   = ci->chacha.iv;
+        ivSz    = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+        seqOut  = ci->chacha.rec_seq;
+        *ciSz   = (word32)sizeof(ci->chacha);
+    }
+#endif
+    else {
+        WOLFSSL_MSG("Cipher can't be offloaded to kernel TLS");
+        return UNSUPPORTED_SUITE;
+    }
+
+    /* Records are sent with this side's write keys. */
+    if ((ssl->options.side == WOLFSSL_CLIENT_END) == (tx != 0))
+        key = ssl->keys.client_write_key;
+    else
+        key = ssl->keys.server_write_key;
+    iv = tx ? ssl->keys.aead_enc_imp_IV : ssl->keys.aead_dec_imp_IV;
+
+    XMEMCPY(keyOut, key, keySz);
+    /* Nonce is the salt followed by the IV. */
+    if (saltSz > 0)
+        XMEMCPY(saltOut, iv, saltSz);
+    if (ci->info.version == TLS_1_3_VERSION || saltSz == 0) {
+        XMEMCPY(ivOut, iv + saltSz, ivSz);
+    }
+    else if (tx) {
+        /* TLS 1.2 AES-GCM explicit nonce - kernel increments per record. */
+        XMEMCPY(ivOut, ssl->keys.aead_exp_IV, ivSz);
+    }
+
+    if (tx) {
+        c32toa(ssl->keys.sequence_number_hi, seqOut);
+        c32toa(ssl->keys.sequence_number_lo, seqOut + OPAQUE32_LEN);
+    }
+    else {
+        c32toa(ssl->keys.peer_sequence_number_hi, seqOut);
+        c32toa(ssl->keys.peer_sequence_number_lo, seqOut + OPAQUE32_LEN);
+    }
+
+    return 0;
+}
+
+/* Give the kernel the current traffic keys to protect records with.
+ *
+ * Kernel TLS is attached to the socket when a direction is first offloaded.
+ * Called again for a direction when the keys change with a TLS 1.3
+ * KeyUpdate.
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ * @param [in]      dir  WOLFSSL_KTLS_TX and/or WOLFSSL_KTLS_RX.
+ * @return  0 on success.
+ * @return  UNSUPPORTED_SUITE when the protocol version or cipher can't be
+ *          offloaded.
+ * @return  SOCKET_ERROR_E when the kernel doesn't support TLS or rejects the
+ *          keys.
+ */
+int KtlsSetKeys(WOLFSSL* ssl, int dir)
+{
+    KtlsCryptoInfo txInfo;
+    KtlsCryptoInfo rxInfo;
+    word32         txSz = 0;
+    word32         rxSz = 0;
+    int            ret = 0;
+
+    WOLFSSL_ENTER("KtlsSetKeys");
+
+    /* Check all directions can be offloaded before changing the socket. */
+    if ((dir & WOLFSSL_KTLS_TX) != 0)
+        ret = KtlsGetCryptoInfo(ssl, 1, &txInfo, &txSz);
+    if ((ret == 0) && ((dir & WOLFSSL_KTLS_RX) != 0))
+        ret = KtlsGetCryptoInfo(ssl, 0, &rxInfo, &rxSz);
+
+    if ((ret == 0) && ((dir & WOLFSSL_KTLS_TX) != 0)) {
+        if ((((ssl->ktls & WOLFSSL_KTLS_TX) == 0) &&
+                (wolfIO_KtlsAttach(ssl->wfd) != 0)) ||
+                (wolfIO_KtlsSetCrypto(ssl->wfd, 0, &txInfo, txSz) != 0)) {
+            ret = SOCKET_ERROR_E;
+        }
+        else {
+            ssl->ktls |= WOLFSSL_KTLS_TX;
+        }
+    }
+    if ((ret == 0) && ((dir & WOLFSSL_KTLS_RX) != 0)) {
+        if ((((ssl->ktls & WOLFSSL_KTLS_RX) == 0) &&
+                (wolfIO_KtlsAttach(ssl->rfd) != 0)) ||
+                (wolfIO_KtlsSetCrypto(ssl->rfd, 1, &rxInfo, rxSz) != 0)) {
+            ret = SOCKET_ERROR_E;
+        }
+        else {
+            ssl->ktls |= WOLFSSL_KTLS_RX;
+        }
+    }
+
+    ForceZero(&txInfo, sizeof(txInfo));
+    ForceZero(&rxInfo, sizeof(rxInfo));
+
+    WOLFSSL_LEAVE("KtlsSetKeys", ret);
+    return ret;
+}
+
+/* Convert an I/O error on a kernel TLS socket into a wolfSSL error.
+ *
+ * @param [in, out] ssl      SSL/TLS object.
+ * @param [in]      err      WOLFSSL_CBIO_ERR_* value.
+ * @param [in]      sending  1 when sending and 0 when receiving.
+ * @return  WANT_READ or WANT_WRITE when the operation would block.
+ * @return  SOCKET_ERROR_E otherwise.
+ */
+static int KtlsIoError(WOLFSSL* ssl, int err, int sending)
+{
+    switch (err) {
+        /* Same value as WOLFSSL_CBIO_ERR_WANT_WRITE. */
+        case WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_WANT_READ):
+            return sending ? WANT_WRITE : WANT_READ;
+        case WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_CONN_RST):
+            ssl->options.connReset = 1;
+            break;
+        case WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_CONN_CLOSE):
+            if (sending)
+                ssl->options.connReset = 1;  /* treat same as reset */
+            else
+                ssl->options.isClosed = 1;
+            break;
+        default:
+            break;
+    }
+
+    WOLFSSL_ERROR_VERBOSE(SOCKET_ERROR_E);
+    return SOCKET_ERROR_E;
+}
+
+/* Send a record that isn't application data through kernel TLS.
+ *
+ * @param [in, out] ssl   SSL/TLS object.
+ * @param [in]      type  Record content type.
+ * @param [in]      data  Plain text of record.
+ * @param [in]      sz    Size of plain text in bytes.
+ * @return  0 on success.
+ * @return  WANT_WRITE when the socket would block.
+ * @return  SOCKET_ERROR_E on other failure.
+ */
+int KtlsSendRecord(WOLFSSL* ssl, byte type, const byte* data, int sz)
+{
+    int sent = 0;
+
+    while (sent < sz) {
+        int ret = wolfIO_SendRecord(ssl->wfd, type, (char*)data + sent,
+                                    sz - sent, ssl->wflags);
+        if (ret == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_ISR))
+            continue;
+        if (ret < 0)
+            return KtlsIoError(ssl, ret, 1);
+        sent += ret;
+    }
+
+    return 0;
+}
+
+/* Send application data with kernel TLS protecting the records.
+ *
+ * The kernel splits the data into records so it goes straight from the
+ * caller's buffer, or I/O vector, to the socket.
+ *
+ * @param [in, out] ssl   SSL/TLS object.
+ * @param [in]      data  Data to send. May be NULL when ssl->buffers.sendIov
+ *                        set.
+ * @param [in]      sz    Number of bytes to send.
+ * @return  Number of bytes sent on success.
+ * @return  0 when the peer closed the connection.
+ * @return  Negative on error.
+ */
+static int KtlsSendData(WOLFSSL* ssl, const byte* data, int sz)
+{
+    /* Continue from where the last call stopped with WANT_WRITE. */
+    int sent = ssl->buffers.prevSent;
+    int ret;
+
+    if (sent > sz) {
+        WOLFSSL_MSG("error: write() after WANT_WRITE with short size");
+        return ssl->error = BAD_FUNC_ARG;
+    }
+
+    while (sent < sz) {
+        const byte* buf;
+        int         len;
+
+    #if !defined(USE_WINDOWS_API) && !defined(NO_WRITEV)
+        if (ssl->buffers.sendIov != NULL) {
+            const struct iovec* iov = ssl->buffers.sendIov;
+            int off = sent;
+
+            /* Rest of the element holding the next byte to send. */
+            while ((int)iov->iov_len <= off) {
+                off -= (int)iov->iov_len;
+                iov++;
+            }
+            buf = (const byte*)iov->iov_base + off;
+            len = (int)iov->iov_len - off;
+        }
+        else
+    #endif
+        {
+            buf = data + sent;
+            len = sz - sent;
+        }
+
+        ret = wolfIO_Send(ssl->wfd, (char*)buf, len, ssl->wflags);
+        if (ret == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_ISR))
+            continue;
+        if (ret < 0) {
+            ret = KtlsIoError(ssl, ret, 1);
+            if (ret == WC_NO_ERR_TRACE(WANT_WRITE) && sent > 0 &&
+                    ssl->options.partialWrite) {
+                break;
+            }
+            ssl->buffers.prevSent = (ret == WC_NO_ERR_TRACE(WANT_WRITE)) ?
+                                    sent : 0;
+            ssl->error = ret;
+            if (ret == WC_NO_ERR_TRACE(SOCKET_ERROR_E) &&
+                    (ssl->options.connReset || ssl->options.isClosed)) {
+                ssl->error = SOCKET_PEER_CLOSED_E;
+                WOLFSSL_ERROR(ssl->error);
+                return 0;  /* peer reset or closed */
+            }
+            WOLFSSL_ERROR(ssl->error);
+            return ssl->error;
+        }
+        sent += ret;
+
+        if (ssl->options.partialWrite)
+            break;
+    }
+
+    ssl->buffers.prevSent = 0;
+    return sent;
+}
+
+/* Process handshake messages passed up by kernel TLS.
+ *
+ * Only TLS 1.3 NewSessionTicket and KeyUpdate messages can be handled as
+ * other post-handshake messages need wolfSSL to protect the records. A TLS 1.2
+ * HelloRequest is declined.
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ * @return  0 on success.
+ * @return  Negative on error.
+ */
+static int KtlsDoHandShake(WOLFSSL* ssl)
+{
+    byte*   input = ssl->buffers.inputBuffer.buffer;
+    word32* idx = &ssl->buffers.inputBuffer.idx;
+    int     ret = 0;
+
+#ifdef WOLFSSL_TLS13
+    if (IsAtLeastTLSv1_3(ssl->version)) {
+        while ((ret == 0) && (*idx < ssl->buffers.inputBuffer.length)) {
+            byte msgType = input[*idx];
+
+            if (ssl->arrays != NULL && ssl->arrays->pendingMsgSz != 0)
+                msgType = ssl->arrays->pendingMsgType;
+            if (msgType != key_update && (msgType != session_ticket ||
+                    ssl->options.side != WOLFSSL_CLIENT_END)) {
+                SendAlert(ssl, alert_fatal, unexpected_message);
+                WOLFSSL_ERROR_VERBOSE(OUT_OF_ORDER_E);
+                return OUT_OF_ORDER_E;
+            }
+
+            ret = DoTls13HandShakeMsg(ssl, input, idx,
+                                      ssl->buffers.inputBuffer.length);
+            /* Kernel doesn't decrypt more until it has the peer's new keys. */
+            if ((ret == 0) && (msgType == key_update))
+                ret = KtlsSetKeys(ssl, WOLFSSL_KTLS_RX);
+        }
+
+        return ret;
+    }
+#endif
+
+    if (ssl->buffers.inputBuffer.length == HANDSHAKE_HEADER_SZ &&
+            input[0] == hello_request) {
+        *idx = ssl->buffers.inputBuffer.length;
+        return SendAlert(ssl, alert_warning, no_renegotiation);
+    }
+
+    SendAlert(ssl, alert_fatal, unexpected_message);
+    WOLFSSL_ERROR_VERBOSE(OUT_OF_ORDER_E);
+    return OUT_OF_ORDER_E;
+}
+
+/* Receive and process a record with kernel TLS decrypting.
+ *
+ * Application data is left in the input buffer as the clear output for
+ * ReceiveData(). Alerts and handshake messages are processed here.
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ * @return  0 on success.
+ * @return  ZERO_RETURN when the peer sent close_notify.
+ * @return  Negative on error.
+ */
+static int KtlsProcessReply(WOLFSSL* ssl)
+{
+    byte type = 0;
+    int  recvd;
+    int  ret = 0;
+
+    /* No record has more plain text than the maximum. */
+    ssl->buffers.inputBuffer.idx = 0;
+    ssl->buffers.inputBuffer.length = 0;
+    if (ssl->buffers.inputBuffer.bufferSize < MAX_RECORD_SIZE &&
+            GrowInputBuffer(ssl, MAX_RECORD_SIZE, 0) < 0) {
+        return MEMORY_E;
+    }
+
+    do {
+        recvd = wolfIO_RecvRecord(ssl->rfd, &type,
+                    (char*)ssl->buffers.inputBuffer.buffer, MAX_RECORD_SIZE,
+                    ssl->rflags);
+    } while (recvd == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_ISR));
+    if (recvd == 0)
+        recvd = WOLFSSL_CBIO_ERR_CONN_CLOSE;
+    if (recvd < 0)
+        return KtlsIoError(ssl, recvd, 0);
+
+    ssl->buffers.inputBuffer.length = (word32)recvd;
+    ssl->curRL.type = type;
+    ssl->curSize = (word16)recvd;
+    ssl->curStartIdx = 0;
+    ssl->keys.padSz = 0;
+    ssl->keys.decryptedCur = 1;
+
+    switch (type) {
+        case application_data:
+            ssl->buffers.clearOutputBuffer.buffer =
+                ssl->buffers.inputBuffer.buffer;
+            ssl->buffers.clearOutputBuffer.length = (word32)recvd;
+            ssl->buffers.inputBuffer.idx = (word32)recvd;
+            break;
+
+        case alert:
+        {
+            int code = 0;
+
+            WOLFSSL_MSG("got ALERT!");
+            ret = DoAlert(ssl, ssl->buffers.inputBuffer.buffer,
+                          &ssl->buffers.inputBuffer.idx, &code);
+            if (ret == alert_fatal)
+                ret = FATAL_ERROR;
+            else if (ret >= 0 && code == close_notify)
+                ret = ssl->error = ZERO_RETURN;
+            else if (ret >= 0 && code == decrypt_error)
+                ret = FATAL_ERROR;
+            else if (ret > 0)
+                ret = 0;
+            break;
+        }
+
+        case handshake:
+            ret = KtlsDoHandShake(ssl);
+            break;
+
+        default:
+            SendAlert(ssl, alert_fatal, unexpected_message);
+            WOLFSSL_ERROR_VERBOSE(UNKNOWN_RECORD_TYPE);
+            ret = UNKNOWN_RECORD_TYPE;
+            break;
+    }
+
+    return ret;
+}
+
+#endif /* WOLFSSL_KTLS */
+
 int ProcessReply(WOLFSSL* ssl)
 {
     return ProcessReplyEx(ssl, 0);
@@ -21209,6 +22266,11 @@ int ProcessReplyEx(WOLFSSL* ssl, int allowSocketErr)
         return ret;
     }
 
+#ifdef WOLFSSL_KTLS
+    if (ssl->ktls & WOLFSSL_KTLS_RX)
+        return KtlsProcessReply(ssl);
+#endif
+
     for (;;) {
         switch (ssl->options.processReply) {
 
@@ -22681,6 +23743,91 @@ void FreeBuildMsgArgs(WOLFSSL* ssl, BuildMsgArgs* args)
 }
 #endif
 
+#if !defined(USE_WINDOWS_API) && !defined(NO_WRITEV)
+/* Find plain text in one element of an I/O vector.
+ *
+ * @param [in]  iov     I/O vector.
+ * @param [in]  iovcnt  Number of elements in I/O vector.
+ * @param [in]  off     Offset of plain text from start of vector.
+ * @param [in]  sz      Size of plain text in bytes.
+ * @return  Pointer to plain text when all in one element.
+ * @return  NULL when plain text spans elements.
+ */
+static byte* IovContiguous(const struct iovec* iov, int iovcnt, int off,
+                           int sz)
+{
+    int i;
+
+    for (i = 0; i < iovcnt; i++) {
+        int len = (int)iov[i].iov_len;
+
+        if (off < len) {
+            if (off + sz <= len)
+                return (byte*)iov[i].iov_base + off;
+            break;
+        }
+        off -= len;
+    }
+
+    return NULL;
+}
+
+/* Copy plain text spanning elements of an I/O vector into a buffer.
+ *
+ * @param [out]  out     Buffer to write plain text to.
+ * @param [in]   iov     I/O vector.
+ * @param [in]   iovcnt  Number of elements in I/O vector.
+ * @param [in]   off     Offset of plain text from start of vector.
+ * @param [in]   sz      Size of plain text in bytes.
+ */
+static void IovGather(byte* out, const struct iovec* iov, int iovcnt, int off,
+                      int sz)
+{
+    int i;
+
+    for (i = 0; (i < iovcnt) && (sz > 0); i++) {
+        int len = (int)iov[i].iov_len;
+
+        if (off >= len) {
+            off -= len;
+            continue;
+        }
+        len -= off;
+        if (len > sz)
+            len = sz;
+        XMEMCPY(out, (const byte*)iov[i].iov_base + off, (size_t)len);
+        out += len;
+        sz  -= len;
+        off = 0;
+    }
+}
+#endif
+
+/* Put the plain text of a record into the output buffer.
+ *
+ * When the record's plain text spans elements of the I/O vector passed to
+ * wolfSSL_writev(), it is gathered from the elements instead of input so that
+ * it is only copied once.
+ *
+ * @param [in]   ssl     SSL/TLS object.
+ * @param [out]  output  Buffer to write plain text to.
+ * @param [in]   input   Plain text.
+ * @param [in]   inSz    Size of plain text in bytes.
+ */
+void BuildMessageInput(WOLFSSL* ssl, byte* output, const byte* input, int inSz)
+{
+#if !defined(USE_WINDOWS_API) && !defined(NO_WRITEV)
+    if (ssl->buffers.sendIovGather) {
+        IovGather(output, ssl->buffers.sendIov, ssl->buffers.sendIovCnt,
+                  ssl->buffers.sendIovOff, inSz);
+        return;
+    }
+#endif
+    (void)ssl;
+
+    XMEMCPY(output, input, (size_t)inSz);
+}
+
 /* Build SSL Message, encrypted */
 int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
              int inSz, int type, int hashOutput, int sizeOnly, int asyncOkay,
@@ -22926,7 +24073,7 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
                                         min(args->ivSz, MAX_IV_SZ));
                 args->idx += min(args->ivSz, MAX_IV_SZ);
             }
-            XMEMCPY(output + args->idx, input, inSz);
+            BuildMessageInput(ssl, output + args->idx, input, inSz);
             args->idx += (word32)inSz;
 #if defined(WOLFSSL_DTLS) && defined(WOLFSSL_DTLS_CID)
             if (ssl->options.dtls && DtlsGetCidTxSize(ssl) > 0) {
@@ -24189,6 +25336,17 @@ int SendCertificateStatus(WOLFSSL* ssl)
         {
             OcspRequest* request = ssl->ctx->certOcspRequest;
             buffer response;
+        #ifdef WOLFSSL_OCSP_STAPLE_CACHE
+            OcspStaple* staple = GetOcspStaple(ssl, 0);
+
+            if (staple != NULL) {
+                /* Response is ready - no parsing or fetching. */
+                ret = BuildCertificateStatus(ssl, status_type,
+                    staple->response, 1);
+                ReleaseOcspStaple(staple);
+                break;
+            }
+        #endif
 
             ret = CreateOcspResponse(ssl, &request, &response);
 
@@ -24226,6 +25384,17 @@ int SendCertificateStatus(WOLFSSL* ssl)
             buffer responses[1 + MAX_CHAIN_DEPTH];
             byte ctxOwnsRequest = 0;
             int i = 0;
+        #ifdef WOLFSSL_OCSP_STAPLE_CACHE
+            OcspStaple* staple = GetOcspStaple(ssl, 1);
+
+            if (staple != NULL) {
+                /* Responses are ready - no parsing or fetching. */
+                ret = BuildCertificateStatus(ssl, status_type,
+                    staple->response, staple->count);
+                ReleaseOcspStaple(staple);
+                break;
+            }
+        #endif
 
             XMEMSET(responses, 0, sizeof(responses));
 
@@ -24580,8 +25749,13 @@ static int ssl_in_handshake(WOLFSSL *ssl, int send)
 int SendData(WOLFSSL* ssl, const void* data, int sz)
 {
     int sent = 0,  /* plainText size */
+        flushed,   /* plainText size of records written to socket */
         sendSz,
         ret;
+#ifdef WOLFSSL_SEND_BATCH
+    int batched = 0;  /* records built but not yet written */
+    int batch;
+#endif
 #if defined(WOLFSSL_EARLY_DATA) && defined(WOLFSSL_EARLY_DATA_GROUP)
     int groupMsgs = 0;
 #endif
@@ -24678,9 +25852,20 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         return WOLFSSL_FATAL_ERROR;
     }
 
+#ifdef WOLFSSL_KTLS
+    if (ssl->ktls & WOLFSSL_KTLS_TX)
+        return KtlsSendData(ssl, (const byte*)data, sz);
+#endif
+
+#ifdef WOLFSSL_SEND_BATCH
+    /* Datagrams and partial writes go out one record at a time. */
+    batch = (!ssl->options.dtls && !ssl->options.partialWrite);
+#endif
+    flushed = sent;
+
     for (;;) {
         byte* out;
-        byte* sendBuffer = (byte*)data + sent;  /* may switch on comp */
+        byte* sendBuffer;                       /* may switch on comp */
         int   buffSz;                           /* may switch on comp */
         int   outputSz;
 #ifdef HAVE_LIBZ
@@ -24767,6 +25952,18 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         }
 #endif
 
+#ifdef WOLFSSL_SEND_BATCH
+        if (batch && batched == 0) {
+            /* Make room for all the records of the batch up front. */
+            int cnt = (sz - sent + buffSz - 1) / buffSz;
+
+            if (cnt > WOLFSSL_SEND_BATCH_RECORDS)
+                cnt = WOLFSSL_SEND_BATCH_RECORDS;
+            if ((ret = CheckAvailableSize(ssl, outputSz * cnt)) != 0)
+                return ssl->error = ret;
+        }
+#endif
+
         /* check for available size */
         if ((ret = CheckAvailableSize(ssl, outputSz)) != 0)
             return ssl->error = ret;
@@ -24774,6 +25971,32 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         /* get output buffer */
         out = GetOutputBuffer(ssl);
 
+#if !defined(USE_WINDOWS_API) && !defined(NO_WRITEV)
+        if (ssl->buffers.sendIov != NULL) {
+            sendBuffer = IovContiguous(ssl->buffers.sendIov,
+                                       ssl->buffers.sendIovCnt, sent, buffSz);
+            if (sendBuffer == NULL) {
+                /* Record spans elements - BuildMessage gathers it straight
+                 * into the output buffer. */
+                ssl->buffers.sendIovOff = sent;
+                ssl->buffers.sendIovGather = 1;
+                sendBuffer = out;
+            #ifdef HAVE_LIBZ
+                if (ssl->options.usingCompression) {
+                    /* Output buffer is free until the record is built. */
+                    IovGather(out, ssl->buffers.sendIov,
+                              ssl->buffers.sendIovCnt, sent, buffSz);
+                    ssl->buffers.sendIovGather = 0;
+                }
+            #endif
+            }
+        }
+        else
+#endif
+        {
+            sendBuffer = (byte*)data + sent;
+        }
+
 #ifdef HAVE_LIBZ
         if (ssl->options.usingCompression) {
             buffSz = myCompress(ssl, sendBuffer, buffSz, comp, sizeof(comp));
@@ -24805,6 +26028,9 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
             sendSz = BUFFER_ERROR;
 #endif
         }
+#if !defined(USE_WINDOWS_API) && !defined(NO_WRITEV)
+        ssl->buffers.sendIovGather = 0;
+#endif
         if (sendSz < 0) {
         #ifdef WOLFSSL_ASYNC_CRYPT
             if (sendSz == WC_NO_ERR_TRACE(WC_PENDING_E))
@@ -24817,13 +26043,22 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         FreeAsyncCtx(ssl, 0);
 #endif
         ssl->buffers.outputBuffer.length += (word32)sendSz;
+        sent += buffSz;
+
+#ifdef WOLFSSL_SEND_BATCH
+        /* Build the next record straight after this one - the coalesced
+         * records are written to the socket in one go. */
+        if (batch && ++batched < WOLFSSL_SEND_BATCH_RECORDS && sent < sz)
+            continue;
+        batched = 0;
+#endif
 
         if ( (ssl->error = SendBuffered(ssl)) < 0) {
             WOLFSSL_ERROR(ssl->error);
             /* store for next call if WANT_WRITE or user embedSend() that
                doesn't present like WANT_WRITE */
-            ssl->buffers.plainSz  = buffSz;
-            ssl->buffers.prevSent = sent;
+            ssl->buffers.plainSz  = sent - flushed;
+            ssl->buffers.prevSent = flushed;
             if (ssl->error == WC_NO_ERR_TRACE(SOCKET_ERROR_E) &&
                 (ssl->options.connReset || ssl->options.isClosed)) {
                 ssl->error = SOCKET_PEER_CLOSED_E;
@@ -24832,8 +26067,7 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
             }
             return ssl->error;
         }
-
-        sent += buffSz;
+        flushed = sent;
 
         /* only one message per attempt */
         if (ssl->options.partialWrite == 1) {
@@ -24845,8 +26079,21 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
     return sent;
 }
 
-/* process input data */
-int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek)
+/* Process input data.
+ *
+ * @param [in, out] ssl      SSL/TLS object.
+ * @param [out]     output   Buffer to copy plaintext into. May be NULL when
+ *                           inPlace is set.
+ * @param [out]     inPlace  When not NULL, set to the plaintext in the input
+ *                           buffer instead of copying. Nothing is consumed.
+ * @param [in]      sz       Maximum number of plaintext bytes to return.
+ * @param [in]      peek     Whether to leave the plaintext unconsumed.
+ * @return  Number of plaintext bytes on success.
+ * @return  0 when the peer has closed the connection.
+ * @return  Negative on error.
+ */
+static int ReceiveData_ex(WOLFSSL* ssl, byte* output, const byte** inPlace,
+    int sz, int peek)
 {
     int size;
 
@@ -24995,6 +26242,14 @@ startScr:
 
     size = (int)min((word32)sz, ssl->buffers.clearOutputBuffer.length);
 
+    if (inPlace != NULL) {
+        /* Plaintext stays in the input buffer until released. The input
+         * buffer is not shrunk or refilled while clear data is pending. */
+        *inPlace = ssl->buffers.clearOutputBuffer.buffer;
+        WOLFSSL_LEAVE("ReceiveData()", size);
+        return size;
+    }
+
     XMEMCPY(output, ssl->buffers.clearOutputBuffer.buffer, size);
 
     if (peek == 0) {
@@ -25009,6 +26264,49 @@ startScr:
     return size;
 }
 
+/* process input data */
+int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek)
+{
+    return ReceiveData_ex(ssl, output, NULL, sz, peek);
+}
+
+/* Process input data and return the decrypted plaintext in place.
+ *
+ * The plaintext is not consumed - call ReleaseReceivedData() when done.
+ *
+ * @param [in, out] ssl   SSL/TLS object.
+ * @param [out]     data  Set to the start of the plaintext in the input buffer.
+ * @param [in]      sz    Maximum number of plaintext bytes to return.
+ * @return  Number of plaintext bytes on success.
+ * @return  0 when the peer has closed the connection.
+ * @return  Negative on error.
+ */
+int ReceiveDataInPlace(WOLFSSL* ssl, const byte** data, int sz)
+{
+    return ReceiveData_ex(ssl, NULL, data, sz, 0);
+}
+
+/* Consume plaintext returned by ReceiveDataInPlace().
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ * @param [in]      sz   Number of plaintext bytes processed by the caller.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when sz is more than the pending plaintext.
+ */
+int ReleaseReceivedData(WOLFSSL* ssl, int sz)
+{
+    if (sz < 0 || (word32)sz > ssl->buffers.clearOutputBuffer.length)
+        return BAD_FUNC_ARG;
+
+    ssl->buffers.clearOutputBuffer.length -= (word32)sz;
+    ssl->buffers.clearOutputBuffer.buffer += sz;
+
+    if (ssl->buffers.inputBuffer.dynamicFlag)
+       ShrinkInputBuffer(ssl, NO_FORCED_FREE);
+
+    return 0;
+}
+
 static int SendAlert_ex(WOLFSSL* ssl, int severity, int type)
 {
     byte input[ALERT_SIZE];
@@ -25105,6 +26403,23 @@ static int SendAlert_ex(WOLFSSL* ssl, int severity, int type)
             ssl->options.isClosed = 1;  /* Don't send close_notify */
     }
 
+#ifdef WOLFSSL_KTLS
+    if (ssl->ktls & WOLFSSL_KTLS_TX) {
+        /* Kernel encrypts the alert. */
+        if (type == close_notify && ssl->options.sentNotify)
+            return 0;
+        ret = KtlsSendRecord(ssl, alert, input, ALERT_SIZE);
+        if (ret == WC_NO_ERR_TRACE(WANT_WRITE))
+            return ret;
+        if (type == close_notify)
+            ssl->options.sentNotify = 1;
+        ssl->pendingAlert.code = 0;
+        ssl->pendingAlert.level = alert_none;
+        WOLFSSL_LEAVE("SendAlert", ret);
+        return ret;
+    }
+#endif
+
     /* send encrypted alert if encryption is on - can be a rehandshake over
      * an existing encrypted channel.
      * TLS 1.3 encrypts handshake packets after the ServerHello
@@ -28490,6 +29805,14 @@ int DecodePrivateKey(WOLFSSL *ssl, word32* length)
     }
 #endif /* WOLF_PRIVATE_KEY_ID */
 
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    /* Use an already decoded key object when one is available. */
+    ret = PrivKeyCache_Take(ssl, length);
+    if (ret != 0 || ssl->hsKey != NULL) {
+        goto exit_dpk;
+    }
+#endif
+
 #ifndef NO_RSA
     if (ssl->buffers.keyType == rsa_sa_algo || ssl->buffers.keyType == 0) {
         ssl->hsType = DYNAMIC_TYPE_RSA;
@@ -28868,6 +30191,11 @@ exit_dpk:
     if (ret != 0) {
         WOLFSSL_ERROR_VERBOSE(ret);
     }
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    else {
+        PrivKeyCache_Mark(ssl);
+    }
+#endif
 
     return ret;
 }
@@ -38828,6 +40156,9 @@ cleanup:
 static int TicketEncCbCtx_Init(WOLFSSL_CTX* ctx, TicketEncCbCtx* keyCtx)
 {
     int ret = 0;
+#ifdef WOLFSSL_TICKET_ENC_PREKEY
+    int i;
+#endif
 
     XMEMSET(keyCtx, 0, sizeof(*keyCtx));
     keyCtx->ctx = ctx;
@@ -38835,19 +40166,72 @@ static int TicketEncCbCtx_Init(WOLFSSL_CTX* ctx, TicketEncCbCtx* keyCtx)
 #ifdef WOLFSSL_CHECK_MEM_ZERO
     wc_MemZero_Add("TicketEncCbCtx_Init keyCtx->name", keyCtx->name,
         sizeof(keyCtx->name));
-    wc_MemZero_Add("TicketEncCbCtx_Init keyCtx->key[0]", keyCtx->key[0],
-        sizeof(keyCtx->key[0]));
-    wc_MemZero_Add("TicketEncCbCtx_Init keyCtx->key[1]", keyCtx->key[1],
-        sizeof(keyCtx->key[1]));
+    wc_MemZero_Add("TicketEncCbCtx_Init keyCtx->key", keyCtx->key,
+        sizeof(keyCtx->key));
+#endif
+
+#ifdef WOLFSSL_TICKET_ENC_PREKEY
+    for (i = 0; (ret == 0) && (i < WOLFSSL_TICKET_KEY_CNT); i++) {
+        ret = wc_AesInit(&keyCtx->aes[i], ctx->heap, INVALID_DEVID);
+    }
 #endif
 
 #ifndef SINGLE_THREADED
-    ret = wc_InitMutex(&keyCtx->mutex);
+    if (ret == 0) {
+        ret = wc_InitMutex(&keyCtx->mutex);
+    }
 #endif
 
     return ret;
 }
 
+/* Set up the cipher object for a ticket key.
+ *
+ * Called whenever the key data at the index changes so that each ticket
+ * encryption/decryption only copies an object that is ready to use.
+ * Call with the key context mutex held.
+ *
+ * @param [in]  keyCtx  Context for session ticket encryption.
+ * @param [in]  idx     Index of key that changed.
+ * @return  0 on success.
+ * @return  Other value when setting the key fails.
+ */
+int TicketEncCbCtx_SetKey(TicketEncCbCtx* keyCtx, int idx)
+{
+#ifdef WOLFSSL_TICKET_ENC_PREKEY
+    return wc_AesGcmSetKey(&keyCtx->aes[idx], keyCtx->key[idx],
+        WOLFSSL_TICKET_KEY_SZ);
+#else
+    (void)keyCtx;
+    (void)idx;
+    return 0;
+#endif
+}
+
+/* Generate a new key at the index and set its expirary.
+ *
+ * @param [in]  keyCtx  Context for session ticket encryption.
+ * @param [in]  idx     Index of key to generate.
+ * @param [in]  now     Current time in seconds.
+ * @return  0 on success.
+ * @return  Other value when random number generation or setting key fails.
+ */
+static int TicketEncCbCtx_GenKey(TicketEncCbCtx* keyCtx, int idx, word32 now)
+{
+    int ret;
+
+    ret = wc_RNG_GenerateBlock(&keyCtx->rng, keyCtx->key[idx],
+                               WOLFSSL_TICKET_KEY_SZ);
+    if (ret == 0) {
+        ret = TicketEncCbCtx_SetKey(keyCtx, idx);
+    }
+    if (ret == 0) {
+        keyCtx->expirary[idx] = now + WOLFSSL_TICKET_KEY_LIFETIME;
+    }
+
+    return ret;
+}
+
 /* Setup the session ticket encryption context for this.
  *
  * Initialize RNG, generate name, generate primary key and set primary key
@@ -38876,15 +40260,13 @@ static int TicketEncCbCtx_Setup(TicketEncCbCtx* keyCtx, void* heap, int devId)
                                        sizeof(keyCtx->name));
         }
         if (ret == 0) {
-            /* Mask of the bottom bit - used for index of key. */
-            keyCtx->name[WOLFSSL_TICKET_NAME_SZ - 1] &= 0xfe;
+            /* Mask of the bottom bits - used for index of key. */
+            keyCtx->name[WOLFSSL_TICKET_NAME_SZ - 1] &=
+                (byte)~(WOLFSSL_TICKET_KEY_CNT - 1);
 
             /* Generate initial primary key. */
-            ret = wc_RNG_GenerateBlock(&keyCtx->rng, keyCtx->key[0],
-                                       WOLFSSL_TICKET_KEY_SZ);
-        }
-        if (ret == 0) {
-            keyCtx->expirary[0] = LowResTimer() + WOLFSSL_TICKET_KEY_LIFETIME;
+            keyCtx->encIdx = 0;
+            ret = TicketEncCbCtx_GenKey(keyCtx, 0, LowResTimer());
         }
     }
 
@@ -38898,15 +40280,22 @@ static int TicketEncCbCtx_Setup(TicketEncCbCtx* keyCtx, void* heap, int devId)
  */
 static void TicketEncCbCtx_Free(TicketEncCbCtx* keyCtx)
 {
+#ifdef WOLFSSL_TICKET_ENC_PREKEY
+    int i;
+
+    for (i = 0; i < WOLFSSL_TICKET_KEY_CNT; i++) {
+        wc_AesFree(&keyCtx->aes[i]);
+    }
+    ForceZero(keyCtx->aes, sizeof(keyCtx->aes));
+#endif
+
     /* Zeroize sensitive data. */
     ForceZero(keyCtx->name, sizeof(keyCtx->name));
-    ForceZero(keyCtx->key[0], sizeof(keyCtx->key[0]));
-    ForceZero(keyCtx->key[1], sizeof(keyCtx->key[1]));
+    ForceZero(keyCtx->key, sizeof(keyCtx->key));
 
 #ifdef WOLFSSL_CHECK_MEM_ZERO
     wc_MemZero_Check(keyCtx->name, sizeof(keyCtx->name));
-    wc_MemZero_Check(keyCtx->key[0], sizeof(keyCtx->key[0]));
-    wc_MemZero_Check(keyCtx->key[1], sizeof(keyCtx->key[1]));
+    wc_MemZero_Check(keyCtx->key, sizeof(keyCtx->key));
 #endif
 
 #ifndef SINGLE_THREADED
@@ -38918,8 +40307,8 @@ static void TicketEncCbCtx_Free(TicketEncCbCtx* keyCtx)
 #ifdef WOLFSSL_TICKET_ENC_CBC_HMAC
 /* Ticket encryption/decryption implementation.
  *
- * @param [in]   key     Key for encryption/decryption and HMAC.
- * @param [in]   keyLen  Length of key in bytes.
+ * @param [in]   keyCtx  Context for session ticket encryption.
+ * @param [in]   keyIdx  Index of key for encryption/decryption and HMAC.
  * @param [in]   iv      IV/Nonce for encryption/decryption.
  * @param [in]   aad     Additional authentication data.
  * @param [in]   aadSz   Length of additional authentication data.
@@ -38933,9 +40322,9 @@ static void TicketEncCbCtx_Free(TicketEncCbCtx* keyCtx)
  * @return  0 on success.
  * @return  Other value when encryption/decryption fails.
  */
-static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
-                        byte* in, int inLen, byte* out, int* outLen, byte* tag,
-                        void* heap, int enc)
+static int TicketEncDec(TicketEncCbCtx* keyCtx, int keyIdx, byte* iv,
+                        byte* aad, int aadSz, byte* in, int inLen, byte* out,
+                        int* outLen, byte* tag, void* heap, int enc)
 {
     int ret;
 #ifdef WOLFSSL_SMALL_STACK
@@ -38945,6 +40334,8 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
     Aes  aes[1];
     Hmac hmac[1];
 #endif
+    byte* key = keyCtx->key[keyIdx];
+    int keyLen = WOLFSSL_TICKET_KEY_SZ;
 
     (void)heap;
 
@@ -39036,8 +40427,8 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
     !defined(WOLFSSL_TICKET_ENC_AES256_GCM)
 /* Ticket encryption/decryption implementation.
  *
- * @param [in]   key     Key for encryption/decryption.
- * @param [in]   keyLen  Length of key in bytes.
+ * @param [in]   keyCtx  Context for session ticket encryption.
+ * @param [in]   keyIdx  Index of key for encryption/decryption.
  * @param [in]   iv      IV/Nonce for encryption/decryption.
  * @param [in]   aad     Additional authentication data.
  * @param [in]   aadSz   Length of additional authentication data.
@@ -39051,15 +40442,18 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
  * @return  0 on success.
  * @return  Other value when encryption/decryption fails.
  */
-static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
-                        byte* in, int inLen, byte* out, int* outLen, byte* tag,
-                        void* heap, int enc)
+static int TicketEncDec(TicketEncCbCtx* keyCtx, int keyIdx, byte* iv,
+                        byte* aad, int aadSz, byte* in, int inLen, byte* out,
+                        int* outLen, byte* tag, void* heap, int enc)
 {
     int ret;
+    byte* key = keyCtx->key[keyIdx];
 
-    (void)keyLen;
     (void)heap;
 
+    /* Not pre-keyed - the Poly1305 key depends on the nonce and the ChaCha20
+     * key setup is only a copy of the key bytes. Use
+     * WOLFSSL_TICKET_ENC_AES128_GCM/AES256_GCM for a pre-keyed cipher. */
     if (enc) {
         ret = wc_ChaCha20Poly1305_Encrypt(key, iv, aad, aadSz, in, inLen, out,
                                           tag);
@@ -39076,8 +40470,8 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
 #elif defined(HAVE_AESGCM)
 /* Ticket encryption/decryption implementation.
  *
- * @param [in]   key     Key for encryption/decryption.
- * @param [in]   keyLen  Length of key in bytes.
+ * @param [in]   keyCtx  Context for session ticket encryption.
+ * @param [in]   keyIdx  Index of key for encryption/decryption.
  * @param [in]   iv      IV/Nonce for encryption/decryption.
  * @param [in]   aad     Additional authentication data.
  * @param [in]   aadSz   Length of additional authentication data.
@@ -39092,9 +40486,9 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
  * @return  MEMORY_E when dynamic memory allocation fails.
  * @return  Other value when encryption/decryption fails.
  */
-static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
-                        byte* in, int inLen, byte* out, int* outLen, byte* tag,
-                        void* heap, int enc)
+static int TicketEncDec(TicketEncCbCtx* keyCtx, int keyIdx, byte* iv,
+                        byte* aad, int aadSz, byte* in, int inLen, byte* out,
+                        int* outLen, byte* tag, void* heap, int enc)
 {
     int ret;
 #ifdef WOLFSSL_SMALL_STACK
@@ -39111,28 +40505,46 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
         return MEMORY_E;
 #endif
 
-    if (enc) {
-        ret = wc_AesInit(aes, NULL, INVALID_DEVID);
-        if (ret == 0) {
-            ret = wc_AesGcmSetKey(aes, key, keyLen);
-        }
-        if (ret == 0) {
+#ifdef WOLFSSL_TICKET_ENC_PREKEY
+    /* Copy the keyed object so the key schedule and GHASH table aren't
+     * computed for every ticket. Lock so that a key being replaced isn't
+     * copied part way through. */
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&keyCtx->mutex) != 0) {
+        WOLFSSL_MSG("Couldn't lock key context mutex");
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(aes, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+        return BAD_MUTEX_E;
+    }
+#endif
+    XMEMCPY(aes, &keyCtx->aes[keyIdx], sizeof(Aes));
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&keyCtx->mutex);
+#endif
+    ret = 0;
+#else
+    ret = wc_AesInit(aes, NULL, INVALID_DEVID);
+    if (ret == 0) {
+        ret = wc_AesGcmSetKey(aes, keyCtx->key[keyIdx], WOLFSSL_TICKET_KEY_SZ);
+    }
+#endif
+    if (ret == 0) {
+        if (enc) {
             ret = wc_AesGcmEncrypt(aes, in, out, inLen, iv, GCM_NONCE_MID_SZ,
                                    tag, AES_BLOCK_SIZE, aad, aadSz);
         }
-        wc_AesFree(aes);
-    }
-    else {
-        ret = wc_AesInit(aes, NULL, INVALID_DEVID);
-        if (ret == 0) {
-            ret = wc_AesGcmSetKey(aes, key, keyLen);
-        }
-        if (ret == 0) {
+        else {
             ret = wc_AesGcmDecrypt(aes, in, out, inLen, iv, GCM_NONCE_MID_SZ,
                                    tag, AES_BLOCK_SIZE, aad, aadSz);
         }
-        wc_AesFree(aes);
     }
+#ifdef WOLFSSL_TICKET_ENC_PREKEY
+    /* Copy doesn't own any resources - only clear it. */
+    ForceZero(aes, sizeof(Aes));
+#else
+    wc_AesFree(aes);
+#endif
 
 #ifdef WOLFSSL_SMALL_STACK
     XFREE(aes, heap, DYNAMIC_TYPE_TMP_BUFFER);
@@ -39145,8 +40557,8 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
 #elif defined(WOLFSSL_SM4_GCM)
 /* Ticket encryption/decryption implementation.
  *
- * @param [in]   key     Key for encryption/decryption.
- * @param [in]   keyLen  Length of key in bytes.
+ * @param [in]   keyCtx  Context for session ticket encryption.
+ * @param [in]   keyIdx  Index of key for encryption/decryption.
  * @param [in]   iv      IV/Nonce for encryption/decryption.
  * @param [in]   aad     Additional authentication data.
  * @param [in]   aadSz   Length of additional authentication data.
@@ -39161,9 +40573,9 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
  * @return  MEMORY_E when dynamic memory allocation fails.
  * @return  Other value when encryption/decryption fails.
  */
-static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
-                        byte* in, int inLen, byte* out, int* outLen, byte* tag,
-                        void* heap, int enc)
+static int TicketEncDec(TicketEncCbCtx* keyCtx, int keyIdx, byte* iv,
+                        byte* aad, int aadSz, byte* in, int inLen, byte* out,
+                        int* outLen, byte* tag, void* heap, int enc)
 {
     int ret;
 #ifdef WOLFSSL_SMALL_STACK
@@ -39171,6 +40583,8 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
 #else
     wc_Sm4 sm4[1];
 #endif
+    byte* key = keyCtx->key[keyIdx];
+    int keyLen = WOLFSSL_TICKET_KEY_SZ;
 
     (void)heap;
 
@@ -39215,11 +40629,33 @@ static int TicketEncDec(byte* key, int keyLen, byte* iv, byte* aad, int aadSz,
     #error "No encryption algorithm available for default ticket encryption."
 #endif
 
+/* Check whether a key can be used to encrypt a new ticket.
+ *
+ * The key must stay valid for decryption for the lifetime of the ticket and
+ * must be within its rotation period.
+ *
+ * @param [in]  keyCtx      Ticket encryption callback context.
+ * @param [in]  idx         Index of key to check.
+ * @param [in]  now         Current time in seconds.
+ * @param [in]  ticketHint  Session ticket lifetime.
+ * @return  1 when key can be used for encryption.
+ * @return  0 otherwise.
+ */
+static WC_INLINE int TicketEncCbCtx_CanEncrypt(TicketEncCbCtx* keyCtx, int idx,
+                                               word32 now, int ticketHint)
+{
+    word32 expirary = keyCtx->expirary[idx];
+
+    return (expirary >= now + ticketHint) &&
+           (expirary > now + (WOLFSSL_TICKET_KEY_LIFETIME -
+                              WOLFSSL_TICKET_KEY_ROTATE));
+}
+
 /* Choose a key to use for encryption.
  *
- * Generate a new key if the current ones are expired.
- * If the secondary key has not been used and the primary key has expired then
- * generate a new primary key.
+ * Use the newest key that can still be used for encryption.
+ * When none can be used, generate a new key in place of the oldest key that
+ * has expired for decryption.
  *
  * @param [in]   Ticket encryption callback context.
  * @param [in]   Session ticket lifetime.
@@ -39231,42 +40667,44 @@ static int TicketEncCbCtx_ChooseKey(TicketEncCbCtx* keyCtx, int ticketHint,
                                     int* keyIdx)
 {
     int ret = 0;
+    int i;
+    int useKey = -1;
+    int genKey = -1;
 
     /* Get new current time as lock may have taken some time. */
     word32 now = LowResTimer();
 
-    /* Check expirary of primary key for encrypt. */
-    if (keyCtx->expirary[0] >= now + ticketHint) {
-        *keyIdx = 0;
-    }
-    /* Check expirary of primary key for encrypt. */
-    else if (keyCtx->expirary[1] >= now + ticketHint) {
-        *keyIdx = 1;
-    }
-    /* No key available to use. */
-    else {
-        int genKey;
-
-        /* Generate which ever key is expired for decrypt - primary first. */
-        if (keyCtx->expirary[0] < now) {
-            genKey = 0;
+    for (i = 0; i < WOLFSSL_TICKET_KEY_CNT; i++) {
+        if (TicketEncCbCtx_CanEncrypt(keyCtx, i, now, ticketHint)) {
+            if ((useKey == -1) ||
+                    (keyCtx->expirary[i] > keyCtx->expirary[useKey])) {
+                useKey = i;
+            }
         }
-        else if (keyCtx->expirary[1] < now) {
-            genKey = 1;
+        else if (keyCtx->expirary[i] < now) {
+            if ((genKey == -1) ||
+                    (keyCtx->expirary[i] < keyCtx->expirary[genKey])) {
+                genKey = i;
+            }
         }
+    }
+
+    if (useKey == -1) {
         /* Timeouts and expirary should not allow this to happen. */
-        else {
+        if (genKey == -1) {
             return BAD_STATE_E;
         }
 
         /* Generate the required key */
-        ret = wc_RNG_GenerateBlock(&keyCtx->rng, keyCtx->key[genKey],
-                                   WOLFSSL_TICKET_KEY_SZ);
+        ret = TicketEncCbCtx_GenKey(keyCtx, genKey, now);
         if (ret == 0) {
-            keyCtx->expirary[genKey] = now + WOLFSSL_TICKET_KEY_LIFETIME;
-            *keyIdx = genKey;
+            useKey = genKey;
         }
     }
+    if (ret == 0) {
+        keyCtx->encIdx = useKey;
+        *keyIdx = useKey;
+    }
 
     return ret;
 }
@@ -39274,14 +40712,16 @@ static int TicketEncCbCtx_ChooseKey(TicketEncCbCtx* keyCtx, int ticketHint,
 /* Default Session Ticket encryption/decryption callback.
  *
  * Use ChaCha20-Poly1305, AES-GCM or SM4-GCM to encrypt/decrypt the ticket.
- * Two keys are used:
- *  - When the first expires for encryption, then use the other.
+ * WOLFSSL_TICKET_KEY_CNT keys are used (two by default):
+ *  - One key is used for encryption until it expires for encryption, then
+ *    the newest other key still valid for encryption is used.
  *  - Don't encrypt with key if the ticket lifetime will go beyond expirary.
- *  - Generate a new primary key when primary key expired for decrypt and
- *    no secondary key is activate for encryption.
- *  - Generate a new secondary key when expired and needed.
+ *  - Don't encrypt with key for longer than WOLFSSL_TICKET_KEY_ROTATE after
+ *    it was generated.
+ *  - Generate a new key, in place of the oldest key expired for decrypt, when
+ *    no key is valid for encryption.
  *  - Calculate expirary starting from first encrypted ticket.
- *  - Key name has last bit set to indicate index of key.
+ *  - Key name has last bits set to indicate index of key.
  * Keys expire for decryption after ticket key lifetime from the first encrypted
  * ticket.
  * Keys can only be use for encryption while the ticket hint does not exceed
@@ -39361,8 +40801,9 @@ static int DefTicketEncCb(WOLFSSL* ssl, byte key_name[WOLFSSL_TICKET_NAME_SZ],
         }
     }
     else {
-        /* Mask of last bit that is the key index. */
-        byte lastByte = key_name[WOLFSSL_TICKET_NAME_SZ - 1] & 0xfe;
+        /* Mask of last bits that are the key index. */
+        byte lastByte = key_name[WOLFSSL_TICKET_NAME_SZ - 1] &
+                        (byte)~(WOLFSSL_TICKET_KEY_CNT - 1);
 
         /* For decryption, see if we know this key - check all but last byte. */
         if (XMEMCMP(key_name, keyCtx->name, WOLFSSL_TICKET_NAME_SZ - 1) != 0) {
@@ -39386,47 +40827,43 @@ static int DefTicketEncCb(WOLFSSL* ssl, byte key_name[WOLFSSL_TICKET_NAME_SZ],
         word32 now;
 
         now = LowResTimer();
-        /* As long as encryption expirary isn't imminent - no lock. */
-        if (keyCtx->expirary[0] > now + ctx->ticketHint) {
-            keyIdx = 0;
-        }
-        else if (keyCtx->expirary[1] > now + ctx->ticketHint) {
-            keyIdx = 1;
-        }
-        else {
 #ifndef SINGLE_THREADED
-            /* Lock around access to expirary and key - stop key being generated
-             * twice at the same time. */
-            if (wc_LockMutex(&keyCtx->mutex) != 0) {
-                WOLFSSL_MSG("Couldn't lock key context mutex");
-                return WOLFSSL_TICKET_RET_REJECT;
-            }
+        /* Lock around access to index, expirary and key - stop key being
+         * generated twice at the same time. */
+        if (wc_LockMutex(&keyCtx->mutex) != 0) {
+            WOLFSSL_MSG("Couldn't lock key context mutex");
+            return WOLFSSL_TICKET_RET_REJECT;
+        }
 #endif
+        ret = 0;
+        /* Use current key as long as it can be used for encryption. */
+        keyIdx = keyCtx->encIdx;
+        if (!TicketEncCbCtx_CanEncrypt(keyCtx, keyIdx, now, ctx->ticketHint)) {
             ret = TicketEncCbCtx_ChooseKey(keyCtx, ctx->ticketHint, &keyIdx);
+        }
 #ifndef SINGLE_THREADED
-            wc_UnLockMutex(&keyCtx->mutex);
+        wc_UnLockMutex(&keyCtx->mutex);
 #endif
-            if (ret != 0) {
-                return WOLFSSL_TICKET_RET_REJECT;
-            }
+        if (ret != 0) {
+            return WOLFSSL_TICKET_RET_REJECT;
         }
         /* Set the name of the key to the index chosen. */
-        key_name[WOLFSSL_TICKET_NAME_SZ - 1] |= keyIdx;
+        key_name[WOLFSSL_TICKET_NAME_SZ - 1] |= (byte)keyIdx;
         /* Update AAD too. */
-        aad[WOLFSSL_TICKET_NAME_SZ - 1] |= keyIdx;
+        aad[WOLFSSL_TICKET_NAME_SZ - 1] |= (byte)keyIdx;
 
         /* Encrypt ticket data. */
-        ret = TicketEncDec(keyCtx->key[keyIdx], WOLFSSL_TICKET_KEY_SZ, iv, aad,
-                           aadSz, ticket, inLen, ticket, outLen, mac, ssl->heap,
-                           1);
+        ret = TicketEncDec(keyCtx, keyIdx, iv, aad, aadSz, ticket, inLen,
+                           ticket, outLen, mac, ssl->heap, 1);
         if (ret != 0) return WOLFSSL_TICKET_RET_REJECT;
     }
     /* Decrypt ticket. */
     else {
         /* Get index of key from name. */
-        keyIdx = key_name[WOLFSSL_TICKET_NAME_SZ - 1] & 0x1;
+        keyIdx = key_name[WOLFSSL_TICKET_NAME_SZ - 1] &
+                 (WOLFSSL_TICKET_KEY_CNT - 1);
         /* Update AAD with index. */
-        aad[WOLFSSL_TICKET_NAME_SZ - 1] |= keyIdx;
+        aad[WOLFSSL_TICKET_NAME_SZ - 1] |= (byte)keyIdx;
 
         /* Check expirary */
         if (keyCtx->expirary[keyIdx] <= LowResTimer()) {
@@ -39434,9 +40871,8 @@ static int DefTicketEncCb(WOLFSSL* ssl, byte key_name[WOLFSSL_TICKET_NAME_SZ],
         }
 
         /* Decrypt ticket data. */
-        ret = TicketEncDec(keyCtx->key[keyIdx], WOLFSSL_TICKET_KEY_SZ, iv, aad,
-                           aadSz, ticket, inLen, ticket, outLen, mac, ssl->heap,
-                           0);
+        ret = TicketEncDec(keyCtx, keyIdx, iv, aad, aadSz, ticket, inLen,
+                           ticket, outLen, mac, ssl->heap, 0);
         if (ret != 0) {
             return WOLFSSL_TICKET_RET_REJECT;
         }
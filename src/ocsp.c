@@ -33,6 +33,20 @@
  *     Disable looking for an authorized responder in the verification path of
  *     the issuer. This will make the authorized responder only look at the
  *     OCSP response signer and direct issuer.
+ * WOLFSSL_OCSP_CACHE_REFRESH:
+ *     Enable a cache policy, set with wolfSSL_CertManagerSetOCSPCache(), that
+ *     fetches new responses on a thread ahead of nextUpdate, keeps using an
+ *     expired response for a limited time while it is fetched and bounds the
+ *     number of responses kept with LRU eviction.
+ * WOLFSSL_OCSP_CACHE_RETRY:
+ *     Seconds between refreshes of the same response. Default: 60.
+ * WOLFSSL_OCSP_STAPLE_CACHE:
+ *     Enable a per-CTX store, set with wolfSSL_CTX_EnableOCSPStapleCache(),
+ *     of the responses to staple for the CTX certificate and chain. A thread
+ *     fetches new responses and publishes them so that handshakes staple
+ *     without parsing, fetching or locking.
+ * WOLFSSL_OCSP_STAPLE_RETRY:
+ *     Seconds before fetching staples again after a failure. Default: 60.
  */
 
 #ifndef WOLFCRYPT_ONLY
@@ -78,6 +92,26 @@ static int InitOcspEntry(OcspEntry* entry, OcspRequest* request)
 }
 
 
+static void FreeOcspStatus(CertStatus* status, void* heap)
+{
+    XFREE(status->rawOcspResponse, heap, DYNAMIC_TYPE_OCSP_STATUS);
+
+#ifdef OPENSSL_EXTRA
+    if (status->serialInt) {
+        if (status->serialInt->isDynamic) {
+            XFREE(status->serialInt->data, NULL, DYNAMIC_TYPE_OPENSSL);
+        }
+        XFREE(status->serialInt, NULL, DYNAMIC_TYPE_OPENSSL);
+    }
+    status->serialInt = NULL;
+#endif
+
+    XFREE(status, heap, DYNAMIC_TYPE_OCSP_STATUS);
+
+    (void)heap;
+}
+
+
 static void FreeOcspEntry(OcspEntry* entry, void* heap)
 {
     CertStatus *status, *next;
@@ -89,24 +123,53 @@ static void FreeOcspEntry(OcspEntry* entry, void* heap)
 
     for (status = entry->status; status; status = next) {
         next = status->next;
+        FreeOcspStatus(status, heap);
+    }
 
-        XFREE(status->rawOcspResponse, heap, DYNAMIC_TYPE_OCSP_STATUS);
+    (void)heap;
+}
 
-#ifdef OPENSSL_EXTRA
-        if (status->serialInt) {
-            if (status->serialInt->isDynamic) {
-                XFREE(status->serialInt->data, NULL, DYNAMIC_TYPE_OPENSSL);
-            }
-            XFREE(status->serialInt, NULL, DYNAMIC_TYPE_OPENSSL);
+
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+/* Stop the refresh thread and dispose of the cache policy.
+ *
+ * @param [in, out] ocsp  OCSP object.
+ */
+static void FreeOcspCache(WOLFSSL_OCSP* ocsp)
+{
+    OcspCache*   cache = ocsp->cache;
+    OcspRefresh* job;
+
+    if (cache == NULL)
+        return;
+
+    if (cache->tid != INVALID_THREAD_VAL) {
+        if (wolfSSL_CondStart(&cache->cond) != 0) {
+            WOLFSSL_MSG("wolfSSL_CondStart failed in FreeOcspCache");
         }
-        status->serialInt = NULL;
-#endif
+        else {
+            cache->stop = 1;
+            if (wolfSSL_CondSignal(&cache->cond) != 0)
+                WOLFSSL_MSG("wolfSSL_CondSignal failed in FreeOcspCache");
+            if (wolfSSL_CondEnd(&cache->cond) != 0)
+                WOLFSSL_MSG("wolfSSL_CondEnd failed in FreeOcspCache");
+            if (wolfSSL_JoinThread(cache->tid) != 0)
+                WOLFSSL_MSG("wolfSSL_JoinThread failed in FreeOcspCache");
+        }
+    }
 
-        XFREE(status, heap, DYNAMIC_TYPE_OCSP_STATUS);
+    while ((job = cache->queue) != NULL) {
+        cache->queue = job->next;
+        FreeOcspRequest(&job->request);
+        XFREE(job, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_REQUEST);
     }
 
-    (void)heap;
+    if (wolfSSL_CondFree(&cache->cond) != 0)
+        WOLFSSL_MSG("wolfSSL_CondFree failed in FreeOcspCache");
+    XFREE(cache, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+    ocsp->cache = NULL;
 }
+#endif
 
 
 void FreeOCSP(WOLFSSL_OCSP* ocsp, int dynamic)
@@ -115,6 +178,11 @@ void FreeOCSP(WOLFSSL_OCSP* ocsp, int dynamic)
 
     WOLFSSL_ENTER("FreeOCSP");
 
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    /* Stop refresh thread before responses are freed. */
+    FreeOcspCache(ocsp);
+#endif
+
     for (entry = ocsp->ocspList; entry; entry = next) {
         next = entry->next;
         FreeOcspEntry(entry, ocsp->cm->heap);
@@ -218,6 +286,318 @@ static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
 }
 
 
+#if defined(WOLFSSL_OCSP_CACHE_REFRESH) || defined(WOLFSSL_OCSP_STAPLE_CACHE)
+/* Convert an ASN.1 date to seconds since the epoch.
+ *
+ * @param [in] date    Date without tag and length.
+ * @param [in] format  ASN_UTC_TIME or ASN_GENERALIZED_TIME.
+ * @return  Seconds since the epoch on success.
+ * @return  0 when date is not set or not valid.
+ */
+static time_t OcspDateToTime(const byte* date, byte format)
+{
+    struct tm t;
+    long y;
+    long m;
+    long days;
+
+    XMEMSET(&t, 0, sizeof(t));
+    if ((date[0] == 0) ||
+            (wc_GetDateAsCalendarTime(date, MAX_DATE_SIZE, format, &t) != 0)) {
+        return 0;
+    }
+
+    /* Days since 1970-01-01 with years starting in March so that the leap
+     * day is the last day of the year. */
+    y = (long)t.tm_year + 1900;
+    m = (long)t.tm_mon + 1;
+    if (m <= 2) {
+        y--;
+        m += 12;
+    }
+    days = 365 * y + y / 4 - y / 100 + y / 400 + (153 * (m - 3) + 2) / 5 +
+           t.tm_mday - 719469;
+
+    return (time_t)days * 86400 + (time_t)t.tm_hour * 3600 +
+           (time_t)t.tm_min * 60 + (time_t)t.tm_sec;
+}
+
+/* Find the status of a serial number in an entry. Call with ocspLock held.
+ *
+ * @param [in] entry     OCSP entry of issuer.
+ * @param [in] serial    Serial number.
+ * @param [in] serialSz  Size of serial number in bytes.
+ * @return  Status on success.
+ * @return  NULL when not found.
+ */
+static CertStatus* FindOcspStatus(OcspEntry* entry, const byte* serial,
+    int serialSz)
+{
+    CertStatus* status;
+
+    for (status = entry->status; status != NULL; status = status->next) {
+        if ((status->serialSz == serialSz) &&
+                (XMEMCMP(status->serial, serial, (size_t)serialSz) == 0)) {
+            break;
+        }
+    }
+
+    return status;
+}
+#endif
+
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+
+#ifndef WOLFSSL_OCSP_CACHE_RETRY
+    /* Seconds between refreshes of the same response. */
+    #define WOLFSSL_OCSP_CACHE_RETRY    60
+#endif
+
+/* Find the entry for the issuer of the request. Call with ocspLock held.
+ *
+ * @param [in] ocsp     OCSP object.
+ * @param [in] request  OCSP request.
+ * @return  Entry on success.
+ * @return  NULL when not found.
+ */
+static OcspEntry* FindOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request)
+{
+    OcspEntry* entry;
+
+    for (entry = ocsp->ocspList; entry != NULL; entry = entry->next) {
+        if ((XMEMCMP(entry->issuerHash, request->issuerHash,
+                OCSP_DIGEST_SIZE) == 0) &&
+            (XMEMCMP(entry->issuerKeyHash, request->issuerKeyHash,
+                OCSP_DIGEST_SIZE) == 0)) {
+            break;
+        }
+    }
+
+    return entry;
+}
+
+/* Decide whether a cached status is used and whether to refresh it.
+ *
+ * A status is used until nextUpdate and, when not stapled, for up to maxStale
+ * seconds after. A refresh is wanted from prefetch seconds before nextUpdate.
+ * Call with ocspLock held.
+ *
+ * @param [in]      cache    Cache policy.
+ * @param [in, out] status   Cached status.
+ * @param [in]      staple   Response is to be stapled.
+ * @param [out]     refresh  Set to 1 when a refresh is to be queued.
+ * @return  1 when status is used.
+ * @return  0 when a response must be fetched now.
+ */
+static int OcspCacheUse(OcspCache* cache, CertStatus* status, int staple,
+    int* refresh)
+{
+    int    use = 0;
+    time_t now = wc_Time(0);
+
+    status->lastUsed = ++cache->clock;
+
+    if ((status->nextTime == 0) || !XVALIDATE_DATE(status->thisDate,
+            status->thisDateFormat, ASN_BEFORE)) {
+        /* No nextUpdate or not yet valid - fetch as without a cache. */
+    }
+    else if (now < status->nextTime) {
+        use = 1;
+        cache->stats.hits++;
+        *refresh = (now >= status->nextTime - (time_t)cache->prefetch);
+    }
+    else if (!staple && (now - status->nextTime < (time_t)cache->maxStale)) {
+        use = 1;
+        cache->stats.staleHits++;
+        *refresh = 1;
+    }
+
+    if (*refresh) {
+        if (status->refreshing || (now < status->retryTime)) {
+            *refresh = 0;
+        }
+        else {
+            status->refreshing = 1;
+        }
+    }
+
+    return use;
+}
+
+/* Set the cache fields of a status that holds a new response.
+ * Call with ocspLock held.
+ *
+ * @param [in]      cache   Cache policy.
+ * @param [in, out] status  Status updated from response.
+ */
+static void OcspCacheSetStatus(OcspCache* cache, CertStatus* status)
+{
+    status->nextTime = OcspDateToTime(status->nextDate,
+        status->nextDateFormat);
+    status->retryTime = 0;
+    status->lastUsed = ++cache->clock;
+    status->refreshing = 0;
+}
+
+/* Evict the least recently used status. Call with ocspLock held.
+ *
+ * Entries are kept as callers hold on to them without the lock.
+ *
+ * @param [in, out] ocsp  OCSP object.
+ * @return  1 when a status was evicted.
+ * @return  0 when no status cached.
+ */
+static int OcspCacheEvict(WOLFSSL_OCSP* ocsp)
+{
+    OcspCache*   cache = ocsp->cache;
+    OcspEntry*   entry;
+    OcspEntry*   lruEntry = NULL;
+    CertStatus** prev;
+    CertStatus** lruPrev = NULL;
+    CertStatus*  status;
+    word32       lruAge = 0;
+
+    for (entry = ocsp->ocspList; entry != NULL; entry = entry->next) {
+        for (prev = &entry->status; *prev != NULL; prev = &(*prev)->next) {
+            /* Age is correct when clock wraps. */
+            word32 age = cache->clock - (*prev)->lastUsed;
+
+            if ((lruPrev == NULL) || (age > lruAge)) {
+                lruEntry = entry;
+                lruPrev = prev;
+                lruAge = age;
+            }
+        }
+    }
+    if (lruPrev == NULL)
+        return 0;
+
+    status = *lruPrev;
+    *lruPrev = status->next;
+    lruEntry->totalStatus--;
+    FreeOcspStatus(status, ocsp->cm->heap);
+    if (cache->stats.entries > 0)
+        cache->stats.entries--;
+    cache->stats.evictions++;
+
+    return 1;
+}
+
+/* Record the result of a refresh against the cached status.
+ *
+ * @param [in] ocsp     OCSP object.
+ * @param [in] request  Request that was sent.
+ * @param [in] ok       Refresh got a valid response.
+ */
+static void OcspCacheRefreshDone(WOLFSSL_OCSP* ocsp, OcspRequest* request,
+    int ok)
+{
+    OcspEntry*  entry;
+    CertStatus* status = NULL;
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+        WOLFSSL_MSG("wc_LockMutex failed in OcspCacheRefreshDone");
+        return;
+    }
+
+    entry = FindOcspEntry(ocsp, request);
+    if (entry != NULL) {
+        status = FindOcspStatus(entry, request->serial, request->serialSz);
+    }
+    if (status != NULL) {
+        /* Don't refresh again straight away whether it worked or not. */
+        status->refreshing = 0;
+        status->retryTime = wc_Time(0) + WOLFSSL_OCSP_CACHE_RETRY;
+    }
+    if (ok) {
+        ocsp->cache->stats.refreshes++;
+    }
+    else {
+        ocsp->cache->stats.refreshFails++;
+    }
+
+    wc_UnLockMutex(&ocsp->ocspLock);
+}
+
+/* Queue a copy of a request for the refresh thread.
+ *
+ * @param [in] ocsp     OCSP object.
+ * @param [in] request  Request from lookup.
+ * @param [in] staple   Raw response is to be kept for stapling.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  BAD_MUTEX_E when locking fails.
+ */
+static int OcspCacheQueue(WOLFSSL_OCSP* ocsp, OcspRequest* request,
+    int staple)
+{
+    int          ret;
+    OcspRefresh* job;
+    void*        heap = ocsp->cm->heap;
+
+    job = (OcspRefresh*)XMALLOC(sizeof(OcspRefresh), heap,
+                                DYNAMIC_TYPE_OCSP_REQUEST);
+    if (job == NULL)
+        return MEMORY_E;
+
+    /* New request so that a new nonce is sent. */
+    ret = InitOcspRequest(&job->request, NULL, ocsp->cm->ocspSendNonce, heap);
+    if (ret == 0) {
+        XMEMCPY(job->request.issuerHash, request->issuerHash, KEYID_SIZE);
+        XMEMCPY(job->request.issuerKeyHash, request->issuerKeyHash,
+                KEYID_SIZE);
+    #if defined(WOLFSSL_SM2) && defined(WOLFSSL_SM3)
+        job->request.hashSz = request->hashSz;
+    #endif
+        job->request.serial = (byte*)XMALLOC((size_t)request->serialSz, heap,
+                                             DYNAMIC_TYPE_OCSP_REQUEST);
+        if (job->request.serial == NULL) {
+            ret = MEMORY_E;
+        }
+        else {
+            XMEMCPY(job->request.serial, request->serial,
+                    (size_t)request->serialSz);
+            job->request.serialSz = request->serialSz;
+        }
+    }
+    if ((ret == 0) && (request->url != NULL)) {
+        job->request.url = (byte*)XMALLOC((size_t)request->urlSz + 1, heap,
+                                          DYNAMIC_TYPE_OCSP_REQUEST);
+        if (job->request.url == NULL) {
+            ret = MEMORY_E;
+        }
+        else {
+            XMEMCPY(job->request.url, request->url, (size_t)request->urlSz);
+            job->request.url[request->urlSz] = 0;
+            job->request.urlSz = request->urlSz;
+        }
+    }
+    if (ret == 0) {
+        job->wantRaw = (byte)(staple != 0);
+
+        if (wolfSSL_CondStart(&ocsp->cache->cond) != 0) {
+            ret = BAD_MUTEX_E;
+        }
+        else {
+            job->next = ocsp->cache->queue;
+            ocsp->cache->queue = job;
+            job = NULL;
+            if (wolfSSL_CondSignal(&ocsp->cache->cond) != 0)
+                WOLFSSL_MSG("wolfSSL_CondSignal failed in OcspCacheQueue");
+            if (wolfSSL_CondEnd(&ocsp->cache->cond) != 0)
+                WOLFSSL_MSG("wolfSSL_CondEnd failed in OcspCacheQueue");
+        }
+    }
+
+    if (job != NULL) {
+        FreeOcspRequest(&job->request);
+        XFREE(job, heap, DYNAMIC_TYPE_OCSP_REQUEST);
+    }
+
+    return ret;
+}
+#endif /* WOLFSSL_OCSP_CACHE_REFRESH */
+
 /* Mallocs responseBuffer->buffer and is up to caller to free on success
  *
  * Returns OCSP status
@@ -227,6 +607,9 @@ static int GetOcspStatus(WOLFSSL_OCSP* ocsp, OcspRequest* request,
                   void* heap)
 {
     int ret = WC_NO_ERR_TRACE(OCSP_INVALID_STATUS);
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    int refresh = 0;
+#endif
 
     WOLFSSL_ENTER("GetOcspStatus");
 
@@ -248,14 +631,28 @@ static int GetOcspStatus(WOLFSSL_OCSP* ocsp, OcspRequest* request,
         ret = OCSP_INVALID_STATUS;
     }
     else if (*status) {
+        int use;
+
+    #ifdef WOLFSSL_OCSP_CACHE_REFRESH
+        if (ocsp->cache != NULL) {
+            use = OcspCacheUse(ocsp->cache, *status, responseBuffer != NULL,
+                               &refresh);
+        }
+        else
+    #endif
+        {
 #ifndef NO_ASN_TIME
-        if (XVALIDATE_DATE((*status)->thisDate,
+            use = XVALIDATE_DATE((*status)->thisDate,
                                          (*status)->thisDateFormat, ASN_BEFORE)
-        &&  ((*status)->nextDate[0] != 0)
-        &&  XVALIDATE_DATE((*status)->nextDate,
-                                         (*status)->nextDateFormat, ASN_AFTER))
+            &&  ((*status)->nextDate[0] != 0)
+            &&  XVALIDATE_DATE((*status)->nextDate,
+                                         (*status)->nextDateFormat, ASN_AFTER);
+#else
+            use = 1;
 #endif
-        {
+        }
+
+        if (use) {
             ret = xstat2err((*status)->status);
 
             if (responseBuffer) {
@@ -273,8 +670,24 @@ static int GetOcspStatus(WOLFSSL_OCSP* ocsp, OcspRequest* request,
         }
     }
 
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    if ((ocsp->cache != NULL) &&
+            (ret == WC_NO_ERR_TRACE(OCSP_INVALID_STATUS))) {
+        ocsp->cache->stats.misses++;
+    }
+#endif
+
     wc_UnLockMutex(&ocsp->ocspLock);
 
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    /* Cached status is returned while refresh thread fetches a new one. */
+    if (refresh && (OcspCacheQueue(ocsp, request, responseBuffer != NULL) !=
+            0)) {
+        WOLFSSL_MSG("Failed to queue OCSP refresh");
+        OcspCacheRefreshDone(ocsp, request, 0);
+    }
+#endif
+
     return ret;
 }
 
@@ -330,7 +743,8 @@ int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int responseSz,
 #if defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
     if (ocspRequest != NULL && ocspRequest->ssl != NULL &&
            TLSX_CSR2_IsMulti(((WOLFSSL*)ocspRequest->ssl)->extensions)) {
-        ocspResponse->pendingCAs = TLSX_CSR2_GetPendingSigners(((WOLFSSL*)ocspRequest->ssl)->extensions);
+        ocspResponse->pendingCAs = TLSX_CSR2_GetPendingSigners(
+            ((WOLFSSL*)ocspRequest->ssl)->extensions);
     }
 #endif
     ret = OcspResponseDecode(ocspResponse, ocsp->cm, ocsp->cm->heap, 0);
@@ -373,6 +787,14 @@ int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int responseSz,
         goto end;
     }
 
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    if ((status == NULL) && (ocsp->cache != NULL)) {
+        /* Status found by lookup may have been evicted - find it again. */
+        status = FindOcspStatus(entry, ocspResponse->single->status->serial,
+                                ocspResponse->single->status->serialSz);
+    }
+#endif
+
     if (status != NULL) {
         XFREE(status->rawOcspResponse, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_STATUS);
 
@@ -381,6 +803,12 @@ int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int responseSz,
         XMEMCPY(status, ocspResponse->single->status, sizeof(CertStatus));
     }
     else {
+    #ifdef WOLFSSL_OCSP_CACHE_REFRESH
+        if ((ocsp->cache != NULL) && (ocsp->cache->maxEntries != 0) &&
+                (ocsp->cache->stats.entries >= ocsp->cache->maxEntries)) {
+            (void)OcspCacheEvict(ocsp);
+        }
+    #endif
         /* Save new certificate entry */
         status = (CertStatus*)XMALLOC(sizeof(CertStatus),
                                       ocsp->cm->heap, DYNAMIC_TYPE_OCSP_STATUS);
@@ -390,9 +818,18 @@ int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int responseSz,
             entry->status = status;
             entry->ownStatus = 1;
             entry->totalStatus++;
+        #ifdef WOLFSSL_OCSP_CACHE_REFRESH
+            if (ocsp->cache != NULL)
+                ocsp->cache->stats.entries++;
+        #endif
         }
     }
 
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    if ((status != NULL) && (ocsp->cache != NULL))
+        OcspCacheSetStatus(ocsp->cache, status);
+#endif
+
     if (status && responseBuffer && responseBuffer->buffer) {
         status->rawOcspResponse = (byte*)XMALLOC(responseBuffer->length,
                                                  ocsp->cm->heap,
@@ -436,20 +873,81 @@ end:
 #ifndef OCSP_MAX_REQUEST_SZ
 #define OCSP_MAX_REQUEST_SZ 2048
 #endif
-int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
-                     buffer* responseBuffer, void* heap)
+
+/* Send the request to the OCSP responder and check the response.
+ *
+ * Returns OCSP status of response or error.
+ */
+static int SendOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
+                           OcspEntry* entry, CertStatus* status,
+                           buffer* responseBuffer, void* ioCtx, void* heap)
 {
-    OcspEntry*  entry          = NULL;
-    CertStatus* status         = NULL;
     byte*       request        = NULL;
     int         requestSz      = OCSP_MAX_REQUEST_SZ;
     int         responseSz     = 0;
     byte*       response       = NULL;
     const char* url            = NULL;
     int         urlSz          = 0;
+    /* No status when the responder can't be reached. */
+    int         ret            = WC_NO_ERR_TRACE(OCSP_INVALID_STATUS);
+
+    if (ocsp->cm->ocspUseOverrideURL) {
+        url = ocsp->cm->ocspOverrideURL;
+        if (url != NULL && url[0] != '\0')
+            urlSz = (int)XSTRLEN(url);
+        else
+            return OCSP_NEED_URL;
+    }
+    else if (ocspRequest->urlSz != 0 && ocspRequest->url != NULL) {
+        url = (const char *)ocspRequest->url;
+        urlSz = ocspRequest->urlSz;
+    }
+    else {
+        /* cert doesn't have extAuthInfo, assuming CERT_GOOD */
+        WOLFSSL_MSG("Cert has no OCSP URL, assuming CERT_GOOD");
+        return 0;
+    }
+
+    request = (byte*)XMALLOC((size_t)requestSz, ocsp->cm->heap,
+        DYNAMIC_TYPE_OCSP);
+    if (request == NULL) {
+        WOLFSSL_LEAVE("CheckCertOCSP", MEMORY_ERROR);
+        return MEMORY_ERROR;
+    }
+
+    requestSz = EncodeOcspRequest(ocspRequest, request, (word32)requestSz);
+    if (requestSz > 0 && ocsp->cm->ocspIOCb) {
+        responseSz = ocsp->cm->ocspIOCb(ioCtx, url, urlSz,
+                                        request, requestSz, &response);
+    }
+    if (responseSz == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_WANT_READ)) {
+        ret = OCSP_WANT_READ;
+    }
+
+    XFREE(request, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+
+    if (responseSz >= 0 && response) {
+        ret = CheckOcspResponse(ocsp, response, responseSz, responseBuffer,
+                                status, entry, ocspRequest, heap);
+    }
+
+    if (response != NULL && ocsp->cm->ocspRespFreeCb)
+        ocsp->cm->ocspRespFreeCb(ioCtx, response);
+
+    return ret;
+}
+
+int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
+                     buffer* responseBuffer, void* heap)
+{
+    OcspEntry*  entry          = NULL;
+    CertStatus* status         = NULL;
     int         ret            = -1;
     WOLFSSL*    ssl;
     void*       ioCtx;
+#if defined(OPENSSL_ALL) || defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY)
+    byte*       response       = NULL;
+#endif
 
     WOLFSSL_ENTER("CheckOcspRequest");
 
@@ -475,6 +973,13 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
         responseBuffer->buffer = NULL;
     }
 
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    if (ocsp->cache != NULL) {
+        /* Status may be evicted while waiting for the response. */
+        status = NULL;
+    }
+#endif
+
     /* get SSL and IOCtx */
     ssl = (WOLFSSL*)ocspRequest->ssl;
     ioCtx = (ssl && ssl->ocspIOCtx != NULL) ?
@@ -505,53 +1010,804 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
     }
 #endif
 
-    if (ocsp->cm->ocspUseOverrideURL) {
-        url = ocsp->cm->ocspOverrideURL;
-        if (url != NULL && url[0] != '\0')
-            urlSz = (int)XSTRLEN(url);
-        else
-            return OCSP_NEED_URL;
-    }
-    else if (ocspRequest->urlSz != 0 && ocspRequest->url != NULL) {
-        url = (const char *)ocspRequest->url;
-        urlSz = ocspRequest->urlSz;
-    }
-    else {
-        /* cert doesn't have extAuthInfo, assuming CERT_GOOD */
-        WOLFSSL_MSG("Cert has no OCSP URL, assuming CERT_GOOD");
-        return 0;
-    }
+    ret = SendOcspRequest(ocsp, ocspRequest, entry, status, responseBuffer,
+                          ioCtx, heap);
 
-    request = (byte*)XMALLOC((size_t)requestSz, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
-    if (request == NULL) {
-        WOLFSSL_LEAVE("CheckCertOCSP", MEMORY_ERROR);
-        return MEMORY_ERROR;
+    /* Keep responseBuffer in the case of getting to response check. Caller
+     * should free responseBuffer after checking OCSP return value in "ret" */
+    WOLFSSL_LEAVE("CheckOcspRequest", ret);
+    return ret;
+}
+
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+/* Fetch a new response for a queued request.
+ *
+ * @param [in] ocsp  OCSP object.
+ * @param [in] job   Queued refresh request.
+ */
+static void OcspCacheRefresh(WOLFSSL_OCSP* ocsp, OcspRefresh* job)
+{
+    int        ret;
+    OcspEntry* entry = NULL;
+    buffer     responseBuffer;
+
+    responseBuffer.buffer = NULL;
+    responseBuffer.length = 0;
+
+    ret = GetOcspEntry(ocsp, &job->request, &entry);
+    if (ret == 0) {
+        ret = SendOcspRequest(ocsp, &job->request, entry, NULL,
+            job->wantRaw ? &responseBuffer : NULL, ocsp->cm->ocspIOCtx, NULL);
     }
+    XFREE(responseBuffer.buffer, NULL, DYNAMIC_TYPE_TMP_BUFFER);
 
-    requestSz = EncodeOcspRequest(ocspRequest, request, (word32)requestSz);
-    if (requestSz > 0 && ocsp->cm->ocspIOCb) {
-        responseSz = ocsp->cm->ocspIOCb(ioCtx, url, urlSz,
-                                        request, requestSz, &response);
+    /* Revoked and unknown are valid responses. */
+    OcspCacheRefreshDone(ocsp, &job->request, (ret == 0) ||
+        (ret == WC_NO_ERR_TRACE(OCSP_CERT_REVOKED)) ||
+        (ret == WC_NO_ERR_TRACE(OCSP_CERT_UNKNOWN)));
+}
+
+/* Refresh thread - fetch responses for queued requests until stopped.
+ *
+ * @param [in] arg  OCSP object.
+ */
+static THREAD_RETURN WOLFSSL_THREAD OcspCacheThread(void* arg)
+{
+    WOLFSSL_OCSP* ocsp = (WOLFSSL_OCSP*)arg;
+    OcspCache*    cache = ocsp->cache;
+    OcspRefresh*  job;
+
+    WOLFSSL_ENTER("OcspCacheThread");
+
+    for (;;) {
+        int err = 0;
+
+        job = NULL;
+        if (wolfSSL_CondStart(&cache->cond) != 0) {
+            WOLFSSL_MSG("wolfSSL_CondStart failed in OcspCacheThread");
+            break;
+        }
+        while ((!err) && (cache->queue == NULL) && (!cache->stop)) {
+            err = (wolfSSL_CondWait(&cache->cond) != 0);
+        }
+        if ((!err) && (!cache->stop)) {
+            job = cache->queue;
+            cache->queue = job->next;
+        }
+        if (wolfSSL_CondEnd(&cache->cond) != 0) {
+            WOLFSSL_MSG("wolfSSL_CondEnd failed in OcspCacheThread");
+        }
+        if (job == NULL) {
+            break;
+        }
+
+        OcspCacheRefresh(ocsp, job);
+        FreeOcspRequest(&job->request);
+        XFREE(job, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_REQUEST);
     }
-    if (responseSz == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_WANT_READ)) {
-        ret = OCSP_WANT_READ;
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Set the cache policy and start the refresh thread when not running.
+ *
+ * @param [in, out] ocsp        OCSP object.
+ * @param [in]      maxEntries  Maximum responses to keep. 0 for no limit.
+ * @param [in]      prefetch    Seconds before nextUpdate to refresh.
+ * @param [in]      maxStale    Seconds after nextUpdate to use a response
+ *                              while refreshing.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when ocsp is NULL.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  BAD_COND_E when initializing signaling fails.
+ * @return  BAD_MUTEX_E when locking fails.
+ * @return  THREAD_CREATE_E when refresh thread can't be started.
+ */
+int SetOcspCache(WOLFSSL_OCSP* ocsp, word32 maxEntries, word32 prefetch,
+                 word32 maxStale)
+{
+    int        ret = 0;
+    OcspCache* cache = NULL;
+    OcspEntry* entry;
+
+    WOLFSSL_ENTER("SetOcspCache");
+
+    if (ocsp == NULL)
+        return BAD_FUNC_ARG;
+
+    if (ocsp->cache == NULL) {
+        cache = (OcspCache*)XMALLOC(sizeof(OcspCache), ocsp->cm->heap,
+                                    DYNAMIC_TYPE_OCSP);
+        if (cache == NULL)
+            return MEMORY_E;
+        XMEMSET(cache, 0, sizeof(OcspCache));
+        cache->tid = INVALID_THREAD_VAL;
+        if (wolfSSL_CondInit(&cache->cond) != 0) {
+            XFREE(cache, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+            return BAD_COND_E;
+        }
     }
 
-    XFREE(request, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+    if (wc_LockMutex(&ocsp->ocspLock) != 0) {
+        if (cache != NULL) {
+            (void)wolfSSL_CondFree(&cache->cond);
+            XFREE(cache, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+        }
+        return BAD_MUTEX_E;
+    }
+    if (cache != NULL) {
+        /* Count responses cached before policy set. */
+        for (entry = ocsp->ocspList; entry != NULL; entry = entry->next) {
+            cache->stats.entries += (word32)entry->totalStatus;
+        }
+        ocsp->cache = cache;
+    }
+    ocsp->cache->maxEntries = maxEntries;
+    ocsp->cache->prefetch = prefetch;
+    ocsp->cache->maxStale = maxStale;
+    while ((maxEntries != 0) && (ocsp->cache->stats.entries > maxEntries) &&
+            OcspCacheEvict(ocsp)) {
+    }
+    wc_UnLockMutex(&ocsp->ocspLock);
 
-    if (responseSz >= 0 && response) {
-        ret = CheckOcspResponse(ocsp, response, responseSz, responseBuffer, status,
-                            entry, ocspRequest, heap);
+    if ((cache != NULL) &&
+            (wolfSSL_NewThread(&cache->tid, OcspCacheThread, ocsp) != 0)) {
+        WOLFSSL_MSG("Thread creation error");
+        cache->tid = INVALID_THREAD_VAL;
+        FreeOcspCache(ocsp);
+        ret = THREAD_CREATE_E;
     }
 
-    if (response != NULL && ocsp->cm->ocspRespFreeCb)
-        ocsp->cm->ocspRespFreeCb(ioCtx, response);
+    WOLFSSL_LEAVE("SetOcspCache", ret);
+    return ret;
+}
+
+/* Get the statistics of the cache.
+ *
+ * @param [in]  ocsp   OCSP object.
+ * @param [out] stats  Statistics of cache.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when ocsp or stats is NULL or no cache policy set.
+ * @return  BAD_MUTEX_E when locking fails.
+ */
+int GetOcspCacheStats(WOLFSSL_OCSP* ocsp, WOLFSSL_OCSP_CACHE_STATS* stats)
+{
+    int ret = BAD_FUNC_ARG;
+
+    if ((ocsp == NULL) || (stats == NULL))
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0)
+        return BAD_MUTEX_E;
+    if (ocsp->cache != NULL) {
+        *stats = ocsp->cache->stats;
+        ret = 0;
+    }
+    wc_UnLockMutex(&ocsp->ocspLock);
+
+    return ret;
+}
+#endif /* WOLFSSL_OCSP_CACHE_REFRESH */
+
+#ifdef WOLFSSL_OCSP_STAPLE_CACHE
+
+#ifndef WOLFSSL_OCSP_STAPLE_RETRY
+    /* Seconds before fetching staples again after a failure. */
+    #define WOLFSSL_OCSP_STAPLE_RETRY   60
+#endif
+
+/* Fetch a response from the responder whether or not one is cached.
+ *
+ * @param [in]  ocsp      OCSP object.
+ * @param [in]  request   Request for certificate.
+ * @param [out] response  DER encoding of response.
+ * @param [out] thisTime  thisUpdate of response.
+ * @param [out] nextTime  nextUpdate of response. 0 when not set.
+ * @param [in]  heap      Heap hint for response.
+ * @return  0 on success.
+ * @return  OCSP_CERT_REVOKED or OCSP_CERT_UNKNOWN on a valid response.
+ * @return  Other negative value on failure.
+ */
+static int OcspStapleFetch(WOLFSSL_OCSP* ocsp, OcspRequest* request,
+    buffer* response, time_t* thisTime, time_t* nextTime, void* heap)
+{
+    int         ret;
+    OcspEntry*  entry = NULL;
+    CertStatus* status = NULL;
+
+    *thisTime = 0;
+    *nextTime = 0;
+
+    ret = GetOcspEntry(ocsp, request, &entry);
+    if (ret == 0) {
+        if (wc_LockMutex(&ocsp->ocspLock) != 0)
+            return BAD_MUTEX_E;
+        status = FindOcspStatus(entry, request->serial, request->serialSz);
+        wc_UnLockMutex(&ocsp->ocspLock);
+    #ifdef WOLFSSL_OCSP_CACHE_REFRESH
+        if (ocsp->cache != NULL) {
+            /* Status may be evicted while waiting for the response. */
+            status = NULL;
+        }
+    #endif
+
+        ret = SendOcspRequest(ocsp, request, entry, status, response,
+            ocsp->cm->ocspIOCtx, heap);
+    }
+    if (((ret == 0) || (ret == WC_NO_ERR_TRACE(OCSP_CERT_REVOKED)) ||
+            (ret == WC_NO_ERR_TRACE(OCSP_CERT_UNKNOWN))) &&
+            (response->buffer == NULL)) {
+        /* Certificate has no OCSP URL. */
+        ret = OCSP_NEED_URL;
+    }
+    if ((response->buffer != NULL) &&
+            (wc_LockMutex(&ocsp->ocspLock) == 0)) {
+        status = FindOcspStatus(entry, request->serial, request->serialSz);
+        if (status != NULL) {
+            *thisTime = OcspDateToTime(status->thisDate,
+                status->thisDateFormat);
+            *nextTime = OcspDateToTime(status->nextDate,
+                status->nextDateFormat);
+        }
+        wc_UnLockMutex(&ocsp->ocspLock);
+    }
+
+    return ret;
+}
+
+/* Free the responses of a staple.
+ *
+ * @param [in, out] staple  Staple not published or referenced.
+ * @param [in]      heap    Heap hint.
+ */
+static void OcspStapleClear(OcspStaple* staple, void* heap)
+{
+    int i;
+
+    for (i = 0; i < staple->count; i++) {
+        XFREE(staple->response[i].buffer, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        staple->response[i].buffer = NULL;
+        staple->response[i].length = 0;
+    }
+    staple->count = 0;
+}
+
+/* Get a staple that isn't published or referenced to fill.
+ *
+ * Staples are only freed with the CTX so that a handshake may reference one
+ * it has loaded from current while it is being replaced.
+ * Call with cache lock held.
+ *
+ * @param [in, out] cache  Staple cache.
+ * @param [in]      heap   Heap hint.
+ * @return  Empty staple on success.
+ * @return  NULL when dynamic memory allocation fails.
+ */
+static OcspStaple* OcspStapleClaim(OcspStapleCache* cache, void* heap)
+{
+    OcspStaple* staple;
+
+    /* Pairs with the fence in GetOcspStaple(): a handshake that referenced a
+     * staple before this sees the count or sees it was replaced. */
+    wolfSSL_Atomic_Fence();
+    for (staple = cache->pool; staple != NULL; staple = staple->next) {
+        if ((staple != cache->current) &&
+                (wolfSSL_Atomic_Int_FetchAdd(&staple->readers, 0) == 0)) {
+            OcspStapleClear(staple, heap);
+            break;
+        }
+    }
+    if (staple == NULL) {
+        staple = (OcspStaple*)XMALLOC(sizeof(OcspStaple), heap,
+                                      DYNAMIC_TYPE_OCSP);
+        if (staple != NULL) {
+            XMEMSET(staple, 0, sizeof(OcspStaple));
+            wolfSSL_Atomic_Int_Init(&staple->readers, 0);
+            staple->next = cache->pool;
+            cache->pool = staple;
+        }
+    }
+
+    return staple;
+}
+
+/* Fetch responses for the certificate and chain and publish them.
+ *
+ * Only responses with a good status are stapled. A response that can't be
+ * fetched is replaced by the previous one while it is valid, unless the
+ * certificate is revoked or unknown. A staple is always published so that
+ * handshakes wake the refresh thread again. Call with cache lock held.
+ *
+ * @param [in, out] ctx  SSL context.
+ * @return  0 when a response for the certificate was fetched.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Other negative value when fetching response for certificate fails.
+ */
+static int OcspStapleRefresh(WOLFSSL_CTX* ctx)
+{
+    int              ret = 0;
+    int              i;
+    OcspStapleCache* cache = ctx->stapleCache;
+    OcspStaple*      prev = cache->current;
+    OcspStaple*      staple;
+    time_t           now = wc_Time(0);
+    time_t           thisTime;
+    time_t           nextTime;
+    time_t           refreshTime;
+
+    WOLFSSL_ENTER("OcspStapleRefresh");
+
+    staple = OcspStapleClaim(cache, ctx->heap);
+    if (staple == NULL)
+        return MEMORY_E;
+
+    staple->count = cache->count;
+    staple->nextTime = 0;
+    staple->refreshTime = (cache->interval != 0) ?
+        now + (time_t)cache->interval : 0;
+    for (i = 0; i < cache->count; i++) {
+        int err = OcspStapleFetch(ctx->cm->ocsp_stapling, cache->request[i],
+            &staple->response[i], &thisTime, &nextTime, ctx->heap);
+        /* Only a good status is stapled. Don't fall back to the previous
+         * response when the certificate is revoked or unknown. */
+        int keepPrev = (err != WC_NO_ERR_TRACE(OCSP_CERT_REVOKED)) &&
+                       (err != WC_NO_ERR_TRACE(OCSP_CERT_UNKNOWN));
+
+        if ((err == 0) && (nextTime == 0)) {
+            /* No nextUpdate - staple until next try. */
+            nextTime = now + WOLFSSL_OCSP_STAPLE_RETRY;
+        }
+        if (err == 0) {
+            /* Refresh half way through validity. */
+            refreshTime = thisTime + (nextTime - thisTime) / 2;
+        }
+        else {
+            XFREE(staple->response[i].buffer, ctx->heap,
+                  DYNAMIC_TYPE_TMP_BUFFER);
+            staple->response[i].buffer = NULL;
+            staple->response[i].length = 0;
+            refreshTime = now + WOLFSSL_OCSP_STAPLE_RETRY;
+            nextTime = 0;
+
+            /* Keep previous response while it is valid. */
+            if (keepPrev && (prev != NULL) && (i < prev->count) &&
+                    (prev->response[i].buffer != NULL) &&
+                    (now < prev->nextTime)) {
+                staple->response[i].buffer = (byte*)XMALLOC(
+                    prev->response[i].length, ctx->heap,
+                    DYNAMIC_TYPE_TMP_BUFFER);
+                if (staple->response[i].buffer != NULL) {
+                    XMEMCPY(staple->response[i].buffer,
+                        prev->response[i].buffer, prev->response[i].length);
+                    staple->response[i].length = prev->response[i].length;
+                    nextTime = prev->nextTime;
+                }
+            }
+            if (i == 0) {
+                ret = err;
+            }
+        }
+
+        if ((nextTime != 0) &&
+                ((staple->nextTime == 0) || (nextTime < staple->nextTime))) {
+            staple->nextTime = nextTime;
+        }
+        if ((staple->refreshTime == 0) || (refreshTime < staple->refreshTime)) {
+            staple->refreshTime = refreshTime;
+        }
+    }
+    if (staple->refreshTime <= now) {
+        staple->refreshTime = now + WOLFSSL_OCSP_STAPLE_RETRY;
+    }
+
+    /* Publish - handshakes see the responses before the pointer. */
+    wolfSSL_Atomic_Int_Init(&staple->woken, 0);
+    wolfSSL_Atomic_Ptr_Store((void* volatile*)&cache->current, staple);
+
+    WOLFSSL_LEAVE("OcspStapleRefresh", ret);
+    return ret;
+}
+
+/* Refresh thread - fetch staples each time woken until stopped.
+ *
+ * @param [in] arg  SSL context.
+ */
+static THREAD_RETURN WOLFSSL_THREAD OcspStapleThread(void* arg)
+{
+    WOLFSSL_CTX*     ctx = (WOLFSSL_CTX*)arg;
+    OcspStapleCache* cache = ctx->stapleCache;
+
+    WOLFSSL_ENTER("OcspStapleThread");
+
+    for (;;) {
+        int err = 0;
+        int run;
+
+        if (wolfSSL_CondStart(&cache->cond) != 0) {
+            WOLFSSL_MSG("wolfSSL_CondStart failed in OcspStapleThread");
+            break;
+        }
+        while ((!err) && (!cache->wake) && (!cache->stop)) {
+            err = (wolfSSL_CondWait(&cache->cond) != 0);
+        }
+        run = (!err) && (!cache->stop);
+        cache->wake = 0;
+        if (wolfSSL_CondEnd(&cache->cond) != 0) {
+            WOLFSSL_MSG("wolfSSL_CondEnd failed in OcspStapleThread");
+        }
+        if (!run) {
+            break;
+        }
+
+        if (wc_LockMutex(&cache->lock) != 0) {
+            WOLFSSL_MSG("wc_LockMutex failed in OcspStapleThread");
+            break;
+        }
+        (void)OcspStapleRefresh(ctx);
+        wc_UnLockMutex(&cache->lock);
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Wake the refresh thread.
+ *
+ * @param [in, out] cache  Staple cache.
+ */
+static void OcspStapleWake(OcspStapleCache* cache)
+{
+    if (wolfSSL_CondStart(&cache->cond) != 0) {
+        WOLFSSL_MSG("wolfSSL_CondStart failed in OcspStapleWake");
+        return;
+    }
+    cache->wake = 1;
+    if (wolfSSL_CondSignal(&cache->cond) != 0)
+        WOLFSSL_MSG("wolfSSL_CondSignal failed in OcspStapleWake");
+    if (wolfSSL_CondEnd(&cache->cond) != 0)
+        WOLFSSL_MSG("wolfSSL_CondEnd failed in OcspStapleWake");
+}
+
+/* Free the requests for the certificate and chain. Call with cache lock held.
+ *
+ * @param [in, out] cache  Staple cache.
+ * @param [in]      heap   Heap hint.
+ */
+static void OcspStapleFreeRequests(OcspStapleCache* cache, void* heap)
+{
+    int i;
+
+    for (i = 0; i < cache->count; i++) {
+        FreeOcspRequest(cache->request[i]);
+        XFREE(cache->request[i], heap, DYNAMIC_TYPE_OCSP_REQUEST);
+        cache->request[i] = NULL;
+    }
+    cache->count = 0;
+}
+
+/* Create a request for a certificate signed by a loaded CA.
+ *
+ * @param [in]  ctx      SSL context.
+ * @param [in]  der      DER encoding of certificate.
+ * @param [in]  derSz    Size of DER encoding in bytes.
+ * @param [out] request  New request.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Other negative value when certificate can't be verified.
+ */
+static int OcspStapleNewRequest(WOLFSSL_CTX* ctx, byte* der, word32 derSz,
+    OcspRequest** request)
+{
+    int ret;
+#ifdef WOLFSSL_SMALL_STACK
+    DecodedCert* cert;
+#else
+    DecodedCert  cert[1];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    cert = (DecodedCert*)XMALLOC(sizeof(DecodedCert), ctx->heap,
+                                 DYNAMIC_TYPE_DCERT);
+    if (cert == NULL)
+        return MEMORY_E;
+#endif
+    *request = (OcspRequest*)XMALLOC(sizeof(OcspRequest), ctx->heap,
+                                     DYNAMIC_TYPE_OCSP_REQUEST);
+    if (*request == NULL) {
+        ret = MEMORY_E;
+    }
+    else {
+        InitDecodedCert(cert, der, derSz, ctx->heap);
+        ret = ParseCertRelative(cert, CERT_TYPE, VERIFY, ctx->cm, NULL);
+        if (ret == 0) {
+            /* No nonce - response is sent to many clients. */
+            ret = InitOcspRequest(*request, cert, 0, ctx->heap);
+        }
+        FreeDecodedCert(cert);
+        if (ret != 0) {
+            XFREE(*request, ctx->heap, DYNAMIC_TYPE_OCSP_REQUEST);
+            *request = NULL;
+        }
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(cert, ctx->heap, DYNAMIC_TYPE_DCERT);
+#endif
+    return ret;
+}
+
+/* Create requests for the CTX certificate and chain. Call with cache lock
+ * held.
+ *
+ * Requests are created for chain certificates until one can't be verified.
+ *
+ * @param [in] ctx  SSL context.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when no certificate loaded.
+ * @return  Other negative value when certificate can't be verified.
+ */
+static int OcspStapleNewRequests(WOLFSSL_CTX* ctx)
+{
+    int              ret;
+    OcspStapleCache* cache = ctx->stapleCache;
+    DerBuffer*       chain = ctx->certChain;
+    word32           idx = 0;
+
+    if ((ctx->certificate == NULL) || (ctx->certificate->length == 0))
+        return BAD_FUNC_ARG;
+
+    ret = OcspStapleNewRequest(ctx, ctx->certificate->buffer,
+        ctx->certificate->length, &cache->request[0]);
+    if (ret == 0) {
+        cache->count = 1;
+    }
+    while ((ret == 0) && (chain != NULL) &&
+            (cache->count < 1 + MAX_CHAIN_DEPTH) &&
+            (idx + OPAQUE24_LEN < chain->length)) {
+        word32 len;
+
+        c24to32(chain->buffer + idx, &len);
+        idx += OPAQUE24_LEN;
+        if (idx + len > chain->length)
+            break;
+        if (OcspStapleNewRequest(ctx, chain->buffer + idx, len,
+                &cache->request[cache->count]) != 0) {
+            break;
+        }
+        cache->count++;
+        idx += len;
+    }
+
+    return ret;
+}
+
+/* Stop the refresh thread and free the staple cache of a CTX.
+ *
+ * @param [in, out] ctx  SSL context.
+ */
+void FreeOcspStapleCache(WOLFSSL_CTX* ctx)
+{
+    OcspStapleCache* cache = ctx->stapleCache;
+    OcspStaple*      staple;
+
+    if (cache == NULL)
+        return;
+
+    if (cache->tid != INVALID_THREAD_VAL) {
+        if (wolfSSL_CondStart(&cache->cond) != 0) {
+            WOLFSSL_MSG("wolfSSL_CondStart failed in FreeOcspStapleCache");
+        }
+        else {
+            cache->stop = 1;
+            if (wolfSSL_CondSignal(&cache->cond) != 0)
+                WOLFSSL_MSG("wolfSSL_CondSignal failed in FreeOcspStapleCache");
+            if (wolfSSL_CondEnd(&cache->cond) != 0)
+                WOLFSSL_MSG("wolfSSL_CondEnd failed in FreeOcspStapleCache");
+            if (wolfSSL_JoinThread(cache->tid) != 0)
+                WOLFSSL_MSG("wolfSSL_JoinThread failed in FreeOcspStapleCache");
+        }
+    }
+
+    OcspStapleFreeRequests(cache, ctx->heap);
+    while ((staple = cache->pool) != NULL) {
+        cache->pool = staple->next;
+        OcspStapleClear(staple, ctx->heap);
+        XFREE(staple, ctx->heap, DYNAMIC_TYPE_OCSP);
+    }
+
+    if (wolfSSL_CondFree(&cache->cond) != 0)
+        WOLFSSL_MSG("wolfSSL_CondFree failed in FreeOcspStapleCache");
+    wc_FreeMutex(&cache->lock);
+    XFREE(cache, ctx->heap, DYNAMIC_TYPE_OCSP);
+    ctx->stapleCache = NULL;
+}
+
+/* Create the staple cache of a CTX and start the refresh thread.
+ *
+ * Requests are made for the certificate and chain loaded now. Calling again
+ * makes requests for the certificate and chain loaded then. Responses are
+ * fetched by the refresh thread.
+ *
+ * @param [in, out] ctx       SSL context.
+ * @param [in]      interval  Maximum seconds between refreshes. 0 to only
+ *                            refresh half way through validity of responses.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when OCSP stapling not enabled or no certificate.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  BAD_MUTEX_E or BAD_COND_E when initialization fails.
+ * @return  THREAD_CREATE_E when refresh thread can't be started.
+ * @return  Other negative value when certificate can't be verified.
+ */
+int InitOcspStapleCache(WOLFSSL_CTX* ctx, word32 interval)
+{
+    int              ret;
+    OcspStapleCache* cache = ctx->stapleCache;
+
+    WOLFSSL_ENTER("InitOcspStapleCache");
+
+    if ((ctx->cm == NULL) || (ctx->cm->ocsp_stapling == NULL))
+        return BAD_FUNC_ARG;
+
+    if (cache == NULL) {
+        cache = (OcspStapleCache*)XMALLOC(sizeof(OcspStapleCache), ctx->heap,
+                                          DYNAMIC_TYPE_OCSP);
+        if (cache == NULL)
+            return MEMORY_E;
+        XMEMSET(cache, 0, sizeof(OcspStapleCache));
+        cache->tid = INVALID_THREAD_VAL;
+        if (wc_InitMutex(&cache->lock) != 0) {
+            XFREE(cache, ctx->heap, DYNAMIC_TYPE_OCSP);
+            return BAD_MUTEX_E;
+        }
+        if (wolfSSL_CondInit(&cache->cond) != 0) {
+            wc_FreeMutex(&cache->lock);
+            XFREE(cache, ctx->heap, DYNAMIC_TYPE_OCSP);
+            return BAD_COND_E;
+        }
+        ctx->stapleCache = cache;
+    }
+
+    if (wc_LockMutex(&cache->lock) != 0)
+        return BAD_MUTEX_E;
+    /* Stop stapling responses for previous certificate and chain. */
+    wolfSSL_Atomic_Ptr_Store((void* volatile*)&cache->current, NULL);
+    OcspStapleFreeRequests(cache, ctx->heap);
+    cache->interval = interval;
+    ret = OcspStapleNewRequests(ctx);
+    wc_UnLockMutex(&cache->lock);
+
+    if ((ret == 0) && (cache->tid == INVALID_THREAD_VAL) &&
+            (wolfSSL_NewThread(&cache->tid, OcspStapleThread, ctx) != 0)) {
+        WOLFSSL_MSG("Thread creation error");
+        cache->tid = INVALID_THREAD_VAL;
+        ret = THREAD_CREATE_E;
+    }
+    if (ret == 0) {
+        /* Fetch first responses. */
+        OcspStapleWake(cache);
+    }
+    else {
+        FreeOcspStapleCache(ctx);
+    }
+
+    WOLFSSL_LEAVE("InitOcspStapleCache", ret);
+    return ret;
+}
+
+/* Fetch and publish the responses to staple now.
+ *
+ * @param [in, out] ctx  SSL context.
+ * @return  0 when a response for the certificate was fetched.
+ * @return  BAD_FUNC_ARG when staple cache not enabled.
+ * @return  Other negative value on failure.
+ */
+int RefreshOcspStapleCache(WOLFSSL_CTX* ctx)
+{
+    int ret;
+
+    if (ctx->stapleCache == NULL)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&ctx->stapleCache->lock) != 0)
+        return BAD_MUTEX_E;
+    ret = OcspStapleRefresh(ctx);
+    wc_UnLockMutex(&ctx->stapleCache->lock);
+
+    return ret;
+}
+
+/* Get the published staple for a handshake.
+ *
+ * No parsing or locking - the staple is referenced until released. Wakes the
+ * refresh thread once per staple when its refresh time has passed.
+ *
+ * @param [in] ssl    SSL object.
+ * @param [in] chain  Responses for the chain are to be sent too.
+ * @return  Staple with a valid response for the certificate.
+ * @return  NULL when SSL doesn't use the CTX certificate (and chain) or no
+ *          valid response.
+ */
+OcspStaple* GetOcspStaple(WOLFSSL* ssl, int chain)
+{
+    OcspStapleCache* cache = ssl->ctx->stapleCache;
+    OcspStaple*      staple;
+    time_t           now;
+
+    if ((cache == NULL) || ssl->buffers.weOwnCert ||
+            (chain && ssl->buffers.weOwnCertChain)) {
+        return NULL;
+    }
+
+    /* Reference the staple and check it is still the published one. */
+    for (;;) {
+        staple = (OcspStaple*)wolfSSL_Atomic_Ptr_Load(
+            (void* volatile*)&cache->current);
+        if (staple == NULL)
+            return NULL;
+        (void)wolfSSL_Atomic_Int_FetchAdd(&staple->readers, 1);
+        /* Count must be visible to OcspStapleClaim() before checking that
+         * the staple is still published. */
+        wolfSSL_Atomic_Fence();
+        if (staple == (OcspStaple*)wolfSSL_Atomic_Ptr_Load(
+                (void* volatile*)&cache->current)) {
+            break;
+        }
+        (void)wolfSSL_Atomic_Int_FetchSub(&staple->readers, 1);
+    }
+
+    now = wc_Time(0);
+    if ((now >= staple->refreshTime) &&
+            (wolfSSL_Atomic_Int_FetchAdd(&staple->woken, 1) == 0)) {
+        OcspStapleWake(cache);
+    }
+    if ((staple->response[0].buffer == NULL) || (now >= staple->nextTime)) {
+        /* Don't staple an expired response. */
+        ReleaseOcspStaple(staple);
+        staple = NULL;
+    }
+
+    return staple;
+}
+
+/* Release the reference of a handshake to a staple.
+ *
+ * @param [in] staple  Staple from GetOcspStaple().
+ */
+void ReleaseOcspStaple(OcspStaple* staple)
+{
+    (void)wolfSSL_Atomic_Int_FetchSub(&staple->readers, 1);
+}
+
+/* Copy the published response for the certificate.
+ *
+ * @param [in]  ssl       SSL object.
+ * @param [out] response  Copy of response.
+ * @return  1 when a response was copied.
+ * @return  0 when no staple available.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ */
+int CopyOcspStaple(WOLFSSL* ssl, buffer* response)
+{
+    int         ret = 0;
+    OcspStaple* staple = GetOcspStaple(ssl, 0);
+
+    if (staple != NULL) {
+        response->buffer = (byte*)XMALLOC(staple->response[0].length,
+                                          ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        if (response->buffer == NULL) {
+            ret = MEMORY_E;
+        }
+        else {
+            XMEMCPY(response->buffer, staple->response[0].buffer,
+                    staple->response[0].length);
+            response->length = staple->response[0].length;
+            ret = 1;
+        }
+        ReleaseOcspStaple(staple);
+    }
 
-    /* Keep responseBuffer in the case of getting to response check. Caller
-     * should free responseBuffer after checking OCSP return value in "ret" */
-    WOLFSSL_LEAVE("CheckOcspRequest", ret);
     return ret;
 }
+#endif /* WOLFSSL_OCSP_STAPLE_CACHE */
 
 #ifndef WOLFSSL_NO_OCSP_ISSUER_CHAIN_CHECK
 static int CheckOcspResponderChain(OcspEntry* single, DecodedCert *cert,
@@ -678,9 +1934,12 @@ int wolfSSL_OCSP_resp_find_status(WOLFSSL_OCSP_BASICRESP *bs,
 
     single = bs->single;
     while (single != NULL) {
-        if ((XMEMCMP(single->status->serial, id->status->serial, (size_t)single->status->serialSz) == 0)
-         && (XMEMCMP(single->issuerHash, id->issuerHash, OCSP_DIGEST_SIZE) == 0)
-         && (XMEMCMP(single->issuerKeyHash, id->issuerKeyHash, OCSP_DIGEST_SIZE) == 0)) {
+        if ((XMEMCMP(single->status->serial, id->status->serial,
+                     (size_t)single->status->serialSz) == 0)
+         && (XMEMCMP(single->issuerHash, id->issuerHash,
+                     OCSP_DIGEST_SIZE) == 0)
+         && (XMEMCMP(single->issuerKeyHash, id->issuerKeyHash,
+                     OCSP_DIGEST_SIZE) == 0)) {
             break;
         }
         single = single->next;
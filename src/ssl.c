@@ -1559,6 +1559,13 @@ int wolfSSL_set_read_fd(WOLFSSL* ssl, int fd)
             ssl->IOCB_ReadCtx = &ssl->buffers.dtlsCtx;
             ssl->buffers.dtlsCtx.rfd = fd;
         }
+        #ifdef WOLFSSL_DTLS_MMSG
+        /* Datagrams read ahead were from the previous socket. */
+        if (ssl->buffers.dtlsCtx.mmsg != NULL) {
+            ssl->buffers.dtlsCtx.mmsg->rxCnt = 0;
+            ssl->buffers.dtlsCtx.mmsg->rxIdx = 0;
+        }
+        #endif
     #endif
 
     WOLFSSL_LEAVE("wolfSSL_set_read_fd", WOLFSSL_SUCCESS);
@@ -2807,16 +2814,18 @@ int wolfSSL_GetDhKey_Sz(WOLFSSL* ssl)
 #endif /* !NO_DH */
 
 
-WOLFSSL_ABI
-int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
+/* Send application data.
+ *
+ * @param [in]  ssl   SSL/TLS object.
+ * @param [in]  data  Data to send. May be NULL when ssl->buffers.sendIov set.
+ * @param [in]  sz    Number of bytes to send.
+ * @return  Number of bytes sent on success.
+ * @return  Negative value on failure.
+ */
+static int wolfSSL_write_internal(WOLFSSL* ssl, const void* data, int sz)
 {
     int ret;
 
-    WOLFSSL_ENTER("wolfSSL_write");
-
-    if (ssl == NULL || data == NULL || sz < 0)
-        return BAD_FUNC_ARG;
-
 #ifdef WOLFSSL_QUIC
     if (WOLFSSL_IS_QUIC(ssl)) {
         WOLFSSL_MSG("SSL_write() on QUIC not allowed");
@@ -2866,23 +2875,39 @@ int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
     #endif
     ret = SendData(ssl, data, sz);
 
-    WOLFSSL_LEAVE("wolfSSL_write", ret);
-
     if (ret < 0)
         return WOLFSSL_FATAL_ERROR;
     else
         return ret;
 }
 
-static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
+WOLFSSL_ABI
+int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
 {
     int ret;
 
-    WOLFSSL_ENTER("wolfSSL_read_internal");
+    WOLFSSL_ENTER("wolfSSL_write");
 
     if (ssl == NULL || data == NULL || sz < 0)
         return BAD_FUNC_ARG;
 
+    ret = wolfSSL_write_internal(ssl, data, sz);
+
+    WOLFSSL_LEAVE("wolfSSL_write", ret);
+
+    return ret;
+}
+
+static int wolfSSL_read_internal(WOLFSSL* ssl, void* data,
+    const byte** inPlace, int sz, int peek)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_read_internal");
+
+    if (ssl == NULL || (data == NULL && inPlace == NULL) || sz < 0)
+        return BAD_FUNC_ARG;
+
 #ifdef WOLFSSL_QUIC
     if (WOLFSSL_IS_QUIC(ssl)) {
         WOLFSSL_MSG("SSL_read() on QUIC not allowed");
@@ -2904,7 +2929,8 @@ static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
     /* make sure bidirectional TLS shutdown completes */
     if (ssl->error == WOLFSSL_ERROR_SYSCALL || ssl->options.shutdownDone) {
         /* ask the underlying transport the connection is closed */
-        if (ssl->CBIORecv(ssl, (char*)data, 0, ssl->IOCB_ReadCtx)
+        char probe[1];
+        if (ssl->CBIORecv(ssl, probe, 0, ssl->IOCB_ReadCtx)
             == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_CONN_CLOSE))
         {
             ssl->options.isClosed = 1;
@@ -2925,7 +2951,10 @@ static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
         errno = 0;
 #endif
 
-    ret = ReceiveData(ssl, (byte*)data, sz, peek);
+    if (inPlace != NULL)
+        ret = ReceiveDataInPlace(ssl, inPlace, sz);
+    else
+        ret = ReceiveData(ssl, (byte*)data, sz, peek);
 
 #ifdef HAVE_WRITE_DUP
     if (ssl->dupWrite) {
@@ -2958,7 +2987,7 @@ int wolfSSL_peek(WOLFSSL* ssl, void* data, int sz)
 {
     WOLFSSL_ENTER("wolfSSL_peek");
 
-    return wolfSSL_read_internal(ssl, data, sz, TRUE);
+    return wolfSSL_read_internal(ssl, data, NULL, sz, TRUE);
 }
 
 
@@ -2976,7 +3005,71 @@ int wolfSSL_read(WOLFSSL* ssl, void* data, int sz)
         ssl->cbmode = SSL_CB_READ;
     }
     #endif
-    return wolfSSL_read_internal(ssl, data, sz, FALSE);
+    return wolfSSL_read_internal(ssl, data, NULL, sz, FALSE);
+}
+
+/* Read application data without copying it out of the record buffer.
+ *
+ * The plaintext is decrypted in place and a pointer to it is returned. The
+ * data stays valid until wolfSSL_read_zc_release() is called and must be
+ * released before the next wolfSSL_read() or wolfSSL_peek() call. Calling
+ * wolfSSL_read_zc() again returns the same data.
+ *
+ * @param [in, out] ssl   SSL/TLS object.
+ * @param [out]     data  Set to the start of the plaintext.
+ * @param [in]      sz    Maximum number of bytes to return.
+ * @return  Number of plaintext bytes available at data on success.
+ * @return  0 when the peer has closed the connection.
+ * @return  WOLFSSL_FATAL_ERROR on failure. Call wolfSSL_get_error() for the
+ *          reason.
+ * @return  BAD_FUNC_ARG when ssl or data is NULL or sz is negative.
+ */
+int wolfSSL_read_zc(WOLFSSL* ssl, const unsigned char** data, int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_read_zc");
+
+    if (data == NULL)
+        return BAD_FUNC_ARG;
+    *data = NULL;
+
+    #ifdef OPENSSL_EXTRA
+    if (ssl == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    if (ssl->CBIS != NULL) {
+        ssl->CBIS(ssl, SSL_CB_READ, WOLFSSL_SUCCESS);
+        ssl->cbmode = SSL_CB_READ;
+    }
+    #endif
+    return wolfSSL_read_internal(ssl, NULL, data, sz, FALSE);
+}
+
+/* Release application data returned by wolfSSL_read_zc().
+ *
+ * Bytes not released are returned again by the next read.
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ * @param [in]      sz   Number of bytes consumed by the application.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when ssl is NULL, or sz is negative or more than was
+ *          returned.
+ */
+int wolfSSL_read_zc_release(WOLFSSL* ssl, int sz)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_read_zc_release");
+
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = ReleaseReceivedData(ssl, sz);
+    if (ret == 0)
+        ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_LEAVE("wolfSSL_read_zc_release", ret);
+
+    return ret;
 }
 
 
@@ -2991,7 +3084,7 @@ int wolfSSL_mcast_read(WOLFSSL* ssl, word16* id, void* data, int sz)
     if (ssl == NULL)
         return BAD_FUNC_ARG;
 
-    ret = wolfSSL_read_internal(ssl, data, sz, FALSE);
+    ret = wolfSSL_read_internal(ssl, data, NULL, sz, FALSE);
     if (ssl->options.dtls && ssl->options.haveMcast && id != NULL)
         *id = ssl->keys.curPeerId;
     return ret;
@@ -4706,6 +4799,12 @@ int wolfSSL_has_pending(const WOLFSSL* ssl)
     if (ssl == NULL)
         return WOLFSSL_FAILURE;
 
+#ifdef WOLFSSL_DTLS_MMSG
+    /* Datagrams read ahead aren't seen by polling the socket. */
+    if (ssl->options.dtls && wolfIO_DtlsRecvPending(&ssl->buffers.dtlsCtx))
+        return 1;
+#endif
+
     return ssl->buffers.clearOutputBuffer.length > 0;
 }
 
@@ -4975,6 +5074,12 @@ int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash)
         return ret;
     }
 
+#ifdef WOLFSSL_CA_INDEX
+    if (CM_CaIndexFind(cm, hash, 0, &signers) == 0) {
+        return signers != NULL;
+    }
+#endif
+
     row = HashSigner(hash);
 
     if (wc_LockMutex(&cm->caLock) != 0) {
@@ -5116,6 +5221,12 @@ Signer* GetCA(void* vp, byte* hash)
     if (cm == NULL || hash == NULL)
         return NULL;
 
+#ifdef WOLFSSL_CA_INDEX
+    /* Lock free lookup. */
+    if (CM_CaIndexFind(cm, hash, 0, &ret) == 0)
+        return ret;
+#endif
+
     row = HashSigner(hash);
 
     if (wc_LockMutex(&cm->caLock) != 0)
@@ -5229,6 +5340,12 @@ Signer* GetCAByName(void* vp, byte* hash)
     if (cm == NULL)
         return NULL;
 
+#ifdef WOLFSSL_CA_INDEX
+    /* Lock free lookup instead of walking the whole table. */
+    if (CM_CaIndexFind(cm, hash, 1, &ret) == 0)
+        return ret;
+#endif
+
     if (wc_LockMutex(&cm->caLock) != 0)
         return ret;
 
@@ -5393,6 +5510,9 @@ int AddSigner(WOLFSSL_CERT_MANAGER* cm, Signer *s)
     signers = cm->caTable[row];
     s->next = signers;
     cm->caTable[row] = s;
+#ifdef WOLFSSL_CA_INDEX
+    CM_CaIndexAdd(cm, s);
+#endif
 
     wc_UnLockMutex(&cm->caLock);
     return 0;
@@ -5571,6 +5691,9 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         if (ret == 0 && wc_LockMutex(&cm->caLock) == 0) {
             signer->next = cm->caTable[row];
             cm->caTable[row] = signer;   /* takes ownership */
+        #ifdef WOLFSSL_CA_INDEX
+            CM_CaIndexAdd(cm, signer);
+        #endif
             wc_UnLockMutex(&cm->caLock);
             if (cm->caCacheCallback)
                 cm->caCacheCallback(der->buffer, (int)der->length, type);
@@ -5747,6 +5870,11 @@ int wolfSSL_Init(void)
         #endif
     #endif
 #endif
+#ifdef WOLFSSL_RECORD_POOL
+        if ((ret == WOLFSSL_SUCCESS) && (InitRecordPool() != 0)) {
+            ret = BAD_MUTEX_E;
+        }
+#endif
 #if defined(OPENSSL_EXTRA) && defined(HAVE_ATEXIT)
         /* OpenSSL registers cleanup using atexit */
         if ((ret == WOLFSSL_SUCCESS) && (atexit(AtExitCleanup) != 0)) {
@@ -5956,6 +6084,65 @@ int wolfSSL_CTX_DisableOCSPMustStaple(WOLFSSL_CTX* ctx)
     else
         return BAD_FUNC_ARG;
 }
+
+#ifdef WOLFSSL_OCSP_STAPLE_CACHE
+/* Keep the responses to staple for the CTX certificate and chain ready.
+ *
+ * Call after loading the certificate and chain, enabling OCSP stapling and
+ * loading the CAs. A thread fetches the responses and refreshes them half way
+ * through their validity or every interval seconds. Handshakes using the CTX
+ * certificate staple the responses without parsing, fetching or locking.
+ *
+ * @param [in, out] ctx       SSL context.
+ * @param [in]      interval  Maximum seconds between refreshes. 0 for no
+ *                            maximum.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when ctx is NULL, OCSP stapling not enabled or no
+ *          certificate loaded.
+ * @return  THREAD_CREATE_E when refresh thread can't be started.
+ * @return  Other negative value on failure.
+ */
+int wolfSSL_CTX_EnableOCSPStapleCache(WOLFSSL_CTX* ctx, word32 interval)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_EnableOCSPStapleCache");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = InitOcspStapleCache(ctx, interval);
+    if (ret == 0)
+        ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_LEAVE("wolfSSL_CTX_EnableOCSPStapleCache", ret);
+    return ret;
+}
+
+/* Fetch the responses to staple for the CTX now.
+ *
+ * @param [in, out] ctx  SSL context.
+ * @return  WOLFSSL_SUCCESS when a response for the certificate was fetched.
+ * @return  BAD_FUNC_ARG when ctx is NULL or staple cache not enabled.
+ * @return  Other negative value when fetching the response failed.
+ */
+int wolfSSL_CTX_RefreshOCSPStapleCache(WOLFSSL_CTX* ctx)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_RefreshOCSPStapleCache");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = RefreshOcspStapleCache(ctx);
+    if (ret == 0)
+        ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_LEAVE("wolfSSL_CTX_RefreshOCSPStapleCache", ret);
+    return ret;
+}
+#endif /* WOLFSSL_OCSP_STAPLE_CACHE */
 #endif /* HAVE_CERTIFICATE_STATUS_REQUEST || \
         * HAVE_CERTIFICATE_STATUS_REQUEST_V2 */
 
@@ -10298,6 +10485,10 @@ int wolfSSL_Cleanup(void)
 #endif
 
 #ifndef NO_SESSION_CACHE
+    #ifdef SESSION_CACHE_SHARED_MEM
+    /* Back to the local cache, leaving the shared one to other processes. */
+    (void)wolfSSL_release_shared_session_cache();
+    #endif
     #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
     for (i = 0; i < SESSION_ROWS; ++i) {
         if ((SessionCache[i].lock_valid == 1) &&
@@ -10340,6 +10531,10 @@ int wolfSSL_Cleanup(void)
     #endif
 #endif /* !NO_SESSION_CACHE */
 
+#ifdef WOLFSSL_RECORD_POOL
+    FreeRecordPool();
+#endif
+
 #ifndef WOLFSSL_MUTEX_INITIALIZER
     if ((inits_count_mutex_valid == 1) &&
             (wc_FreeMutex(&inits_count_mutex) != 0)) {
@@ -10468,57 +10663,287 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
 #ifndef USE_WINDOWS_API
     #ifndef NO_WRITEV
 
-        /* simulate writev semantics, doesn't actually do block at a time though
-           because of SSL_write behavior and because front adds may be small */
+        /* Send the data of all elements of an I/O vector.
+         *
+         * Records are built from the elements directly: the plain text of a
+         * record is only copied once, into the output buffer, and records
+         * spanning elements are gathered as they are built. Like
+         * wolfSSL_write(), all data is sent unless partial write is on.
+         *
+         * @param [in]  ssl     SSL/TLS object.
+         * @param [in]  iov     I/O vector of data to send.
+         * @param [in]  iovcnt  Number of elements in I/O vector.
+         * @return  Number of bytes sent on success.
+         * @return  BAD_FUNC_ARG when ssl or iov is NULL, iovcnt is negative,
+         *          an element with data has a NULL base or the total size is
+         *          too big.
+         * @return  WOLFSSL_FATAL_ERROR on other failure.
+         */
         int wolfSSL_writev(WOLFSSL* ssl, const struct iovec* iov, int iovcnt)
         {
-        #ifdef WOLFSSL_SMALL_STACK
-            byte   staticBuffer[1]; /* force heap usage */
-        #else
-            byte   staticBuffer[FILE_BUFFER_SIZE];
-        #endif
-            byte* myBuffer  = staticBuffer;
-            int   dynamic   = 0;
-            int   sending   = 0;
-            int   idx       = 0;
-            int   i;
-            int   ret;
+            int sending = 0;
+            int i;
+            int ret;
 
             WOLFSSL_ENTER("wolfSSL_writev");
 
-            for (i = 0; i < iovcnt; i++)
-                sending += (int)iov[i].iov_len;
-
-            if (sending > (int)sizeof(staticBuffer)) {
-                myBuffer = (byte*)XMALLOC((size_t)sending, ssl->heap,
-                                                           DYNAMIC_TYPE_WRITEV);
-                if (!myBuffer)
-                    return MEMORY_ERROR;
-
-                dynamic = 1;
-            }
+            if (ssl == NULL || iov == NULL || iovcnt < 0)
+                return BAD_FUNC_ARG;
 
             for (i = 0; i < iovcnt; i++) {
-                XMEMCPY(&myBuffer[idx], iov[i].iov_base, iov[i].iov_len);
-                idx += (int)iov[i].iov_len;
+                if (iov[i].iov_len == 0)
+                    continue;
+                if (iov[i].iov_base == NULL ||
+                        iov[i].iov_len > (size_t)(INT_MAX - sending)) {
+                    return BAD_FUNC_ARG;
+                }
+                sending += (int)iov[i].iov_len;
             }
 
-           /* myBuffer may not be initialized fully, but the span up to the
-            * sending length will be.
-            */
-            PRAGMA_GCC_DIAG_PUSH
-            PRAGMA_GCC("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-            ret = wolfSSL_write(ssl, myBuffer, sending);
-            PRAGMA_GCC_DIAG_POP
+            ssl->buffers.sendIov = iov;
+            ssl->buffers.sendIovCnt = iovcnt;
+            ret = wolfSSL_write_internal(ssl, NULL, sending);
+            ssl->buffers.sendIov = NULL;
+            ssl->buffers.sendIovCnt = 0;
 
-            if (dynamic)
-                XFREE(myBuffer, ssl->heap, DYNAMIC_TYPE_WRITEV);
+            WOLFSSL_LEAVE("wolfSSL_writev", ret);
 
             return ret;
         }
     #endif
 #endif
 
+#ifdef WOLFSSL_KTLS
+/* Offload record protection to the Linux kernel (kTLS).
+ *
+ * The negotiated keys, IVs and sequence numbers are handed to the kernel for
+ * the directions requested. wolfSSL_write() and wolfSSL_read() then send and
+ * receive plain text on the socket and the application may use sendfile() or
+ * splice() on the socket directly.
+ * Only the built-in socket I/O callbacks are supported and no data may be
+ * buffered in the direction being offloaded.
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ * @param [in]      dir  Directions to offload: WOLFSSL_KTLS_TX and/or
+ *                       WOLFSSL_KTLS_RX.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when ssl is NULL or dir is invalid.
+ * @return  BAD_STATE_E when the handshake is not done, the connection is DTLS
+ *          or QUIC, custom I/O callbacks are set or data is buffered.
+ * @return  UNSUPPORTED_SUITE when the protocol version or cipher suite can't
+ *          be offloaded.
+ * @return  SOCKET_ERROR_E when the kernel doesn't support TLS or rejected the
+ *          keys.
+ */
+int wolfSSL_EnableKTLS(WOLFSSL* ssl, int dir)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_EnableKTLS");
+
+    if (ssl == NULL || dir == 0 ||
+            (dir & ~(WOLFSSL_KTLS_TX | WOLFSSL_KTLS_RX)) != 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    /* Directions already offloaded stay as they are. */
+    dir &= ~(int)ssl->ktls;
+    if (dir == 0)
+        return WOLFSSL_SUCCESS;
+
+    if (!ssl->options.handShakeDone ||
+            ssl->options.handShakeState != HANDSHAKE_DONE ||
+            ssl->options.dtls || WOLFSSL_IS_QUIC(ssl)
+    #ifdef HAVE_WRITE_DUP
+            || ssl->dupWrite != NULL
+    #endif
+            ) {
+        ret = BAD_STATE_E;
+    }
+    /* Kernel only protects records on the socket of wolfSSL_set_fd(). */
+    else if (((dir & WOLFSSL_KTLS_TX) && (ssl->CBIOSend != EmbedSend ||
+                  ssl->IOCB_WriteCtx != &ssl->wfd)) ||
+             ((dir & WOLFSSL_KTLS_RX) && (ssl->CBIORecv != EmbedReceive ||
+                  ssl->IOCB_ReadCtx != &ssl->rfd))) {
+        ret = BAD_STATE_E;
+    }
+    /* Buffered records were protected by wolfSSL and must be handled first. */
+    else if (((dir & WOLFSSL_KTLS_TX) &&
+                  ssl->buffers.outputBuffer.length > 0) ||
+             ((dir & WOLFSSL_KTLS_RX) &&
+                  (ssl->buffers.inputBuffer.idx <
+                       ssl->buffers.inputBuffer.length ||
+                   ssl->buffers.clearOutputBuffer.length > 0 ||
+                   ssl->options.processReply != 0 /* doProcessInit */))) {
+        ret = BAD_STATE_E;
+    }
+    else {
+        ret = KtlsSetKeys(ssl, dir);
+        if (ret == 0) {
+            if (dir & WOLFSSL_KTLS_TX)
+                ssl->buffers.prevSent = 0;
+            ret = WOLFSSL_SUCCESS;
+        }
+    }
+
+    WOLFSSL_LEAVE("wolfSSL_EnableKTLS", ret);
+
+    return ret;
+}
+
+/* Get the directions of record protection offloaded to the kernel.
+ *
+ * @param [in] ssl  SSL/TLS object.
+ * @return  WOLFSSL_KTLS_TX and/or WOLFSSL_KTLS_RX bits.
+ * @return  0 when nothing is offloaded or ssl is NULL.
+ */
+int wolfSSL_GetKTLS(WOLFSSL* ssl)
+{
+    if (ssl == NULL)
+        return 0;
+    return ssl->ktls;
+}
+#endif /* WOLFSSL_KTLS */
+
+#ifdef WOLFSSL_DTLS_MMSG
+/* Write a vector of messages, each in its own DTLS record.
+ *
+ * The datagrams of all the messages are queued and written with sendmmsg().
+ * Datagrams that can't be written without blocking stay queued and are
+ * written before the next datagram. Call with no messages to retry writing
+ * them. Requires the built-in I/O callbacks.
+ *
+ * @param [in, out] ssl   SSL/TLS object.
+ * @param [in]      msgs  Messages to write. May be NULL when cnt is 0.
+ * @param [in]      cnt   Number of messages.
+ * @return  Number of messages written on success.
+ * @return  BAD_FUNC_ARG when ssl is NULL, msgs is NULL and cnt is not 0,
+ *          cnt is negative or not DTLS.
+ * @return  BAD_STATE_E when the built-in I/O callbacks are not used.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  WOLFSSL_FATAL_ERROR when no message was written or, with no
+ *          messages, the queued datagrams weren't all written. Use
+ *          wolfSSL_get_error() to get the reason.
+ */
+int wolfSSL_dtls_write_batch(WOLFSSL* ssl, const struct iovec* msgs, int cnt)
+{
+    int ret = 0;
+    int err;
+    int i;
+
+    WOLFSSL_ENTER("wolfSSL_dtls_write_batch");
+
+    if (ssl == NULL || (msgs == NULL && cnt != 0) || cnt < 0 ||
+            !ssl->options.dtls) {
+        return BAD_FUNC_ARG;
+    }
+    if (ssl->CBIOSend != EmbedSendTo ||
+            ssl->IOCB_WriteCtx != &ssl->buffers.dtlsCtx) {
+        WOLFSSL_MSG("Batch write requires the built-in I/O callbacks");
+        return BAD_STATE_E;
+    }
+    if (!DtlsMmsgSendStart(ssl))
+        return MEMORY_E;
+
+    for (i = 0; i < cnt; i++) {
+        ret = wolfSSL_write(ssl, msgs[i].iov_base, (int)msgs[i].iov_len);
+        if (ret <= 0 && msgs[i].iov_len > 0)
+            break;
+    }
+    err = DtlsMmsgSendEnd(ssl);
+    if (i == cnt) {
+        if (err == WC_NO_ERR_TRACE(WANT_WRITE) && cnt > 0) {
+            /* Messages are written and their datagrams left queued. */
+            err = 0;
+        }
+        if (err != 0) {
+            ssl->error = err;
+            i = 0;
+            ret = WOLFSSL_FATAL_ERROR;
+        }
+    }
+
+    if (i > 0 || cnt == 0)
+        ret = i;
+
+    WOLFSSL_LEAVE("wolfSSL_dtls_write_batch", ret);
+
+    return ret;
+}
+
+/* Read a vector of messages, each from its own DTLS record.
+ *
+ * Waits, as wolfSSL_read() does, only for the first message. Up to
+ * WOLFSSL_DTLS_MMSG_CNT datagrams are received with one recvmmsg() call and
+ * further messages are read only from the datagrams already received. The
+ * length of each message read is returned in the iov_len of its element.
+ * Requires the built-in I/O callbacks.
+ *
+ * @param [in, out] ssl   SSL/TLS object.
+ * @param [in, out] msgs  Buffers to read messages into.
+ * @param [in]      cnt   Number of buffers.
+ * @return  Number of messages read on success.
+ * @return  BAD_FUNC_ARG when ssl or msgs is NULL, cnt is negative or not
+ *          DTLS.
+ * @return  BAD_STATE_E when the built-in I/O callbacks are not used.
+ * @return  0 or WOLFSSL_FATAL_ERROR when no message was read. Use
+ *          wolfSSL_get_error() to get the reason.
+ */
+int wolfSSL_dtls_read_batch(WOLFSSL* ssl, struct iovec* msgs, int cnt)
+{
+    int ret = 0;
+    int i;
+
+    WOLFSSL_ENTER("wolfSSL_dtls_read_batch");
+
+    if (ssl == NULL || msgs == NULL || cnt < 0 || !ssl->options.dtls)
+        return BAD_FUNC_ARG;
+    if (ssl->CBIORecv != EmbedReceiveFrom ||
+            ssl->IOCB_ReadCtx != &ssl->buffers.dtlsCtx) {
+        WOLFSSL_MSG("Batch read requires the built-in I/O callbacks");
+        return BAD_STATE_E;
+    }
+
+    for (i = 0; i < cnt; i++) {
+        if (i > 0) {
+            int   rflags = ssl->rflags;
+            word16 nonblock = ssl->options.dtlsUseNonblock;
+
+            /* Only records already received - don't wait for more. */
+            if (ssl->buffers.clearOutputBuffer.length == 0 &&
+                    ssl->buffers.inputBuffer.idx >=
+                        ssl->buffers.inputBuffer.length &&
+                    !wolfIO_DtlsRecvPending(&ssl->buffers.dtlsCtx)) {
+                break;
+            }
+            ssl->rflags |= MSG_DONTWAIT;
+            ssl->options.dtlsUseNonblock = 1;
+            ret = wolfSSL_read(ssl, msgs[i].iov_base, (int)msgs[i].iov_len);
+            ssl->rflags = rflags;
+            ssl->options.dtlsUseNonblock = nonblock;
+            if (ret <= 0) {
+                if (ssl->error == WC_NO_ERR_TRACE(WANT_READ))
+                    ssl->error = 0;
+                break;
+            }
+        }
+        else {
+            ret = wolfSSL_read(ssl, msgs[i].iov_base, (int)msgs[i].iov_len);
+            if (ret <= 0)
+                break;
+        }
+        msgs[i].iov_len = (size_t)ret;
+    }
+
+    if (i > 0)
+        ret = i;
+
+    WOLFSSL_LEAVE("wolfSSL_dtls_read_batch", ret);
+
+    return ret;
+}
+#endif /* WOLFSSL_DTLS_MMSG */
+
 
 #ifdef WOLFSSL_CALLBACKS
 
@@ -16576,7 +17001,17 @@ long wolfSSL_CTX_sess_connect_renegotiate(WOLFSSL_CTX* ctx)
 #endif
 
 
-#ifndef NO_WOLFSSL_STUB
+#if !defined(NO_SESSION_CACHE) && defined(WOLFSSL_SESSION_STATS)
+long wolfSSL_CTX_sess_hits(WOLFSSL_CTX* ctx)
+{
+    word32 cnt = 0;
+
+    /* Session cache is global */
+    (void)ctx;
+    (void)wolfSSL_get_session_cache_stats(&cnt, NULL, NULL);
+    return (long)cnt;
+}
+#elif !defined(NO_WOLFSSL_STUB)
 long wolfSSL_CTX_sess_hits(WOLFSSL_CTX* ctx)
 {
     WOLFSSL_STUB("wolfSSL_CTX_sess_hits");
@@ -16596,7 +17031,17 @@ long wolfSSL_CTX_sess_cb_hits(WOLFSSL_CTX* ctx)
 #endif
 
 
-#ifndef NO_WOLFSSL_STUB
+#if !defined(NO_SESSION_CACHE) && defined(WOLFSSL_SESSION_STATS)
+long wolfSSL_CTX_sess_cache_full(WOLFSSL_CTX* ctx)
+{
+    word32 cnt = 0;
+
+    /* Session cache is global */
+    (void)ctx;
+    (void)wolfSSL_get_session_cache_stats(NULL, NULL, &cnt);
+    return (long)cnt;
+}
+#elif !defined(NO_WOLFSSL_STUB)
 long wolfSSL_CTX_sess_cache_full(WOLFSSL_CTX* ctx)
 {
     WOLFSSL_STUB("wolfSSL_CTX_sess_cache_full");
@@ -16606,7 +17051,17 @@ long wolfSSL_CTX_sess_cache_full(WOLFSSL_CTX* ctx)
 #endif
 
 
-#ifndef NO_WOLFSSL_STUB
+#if !defined(NO_SESSION_CACHE) && defined(WOLFSSL_SESSION_STATS)
+long wolfSSL_CTX_sess_misses(WOLFSSL_CTX* ctx)
+{
+    word32 cnt = 0;
+
+    /* Session cache is global */
+    (void)ctx;
+    (void)wolfSSL_get_session_cache_stats(NULL, &cnt, NULL);
+    return (long)cnt;
+}
+#elif !defined(NO_WOLFSSL_STUB)
 long wolfSSL_CTX_sess_misses(WOLFSSL_CTX* ctx)
 {
     WOLFSSL_STUB("wolfSSL_CTX_sess_misses");
@@ -20388,6 +20843,10 @@ WOLFSSL_CTX* wolfSSL_set_SSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx)
     if (ssl->ctx != NULL)
         wolfSSL_CTX_free(ssl->ctx);
     ssl->ctx = ctx;
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    /* A handshake key, if any, belongs to the previous CTX's cache. */
+    ssl->options.hsKeyCached = 0;
+#endif
 
 #ifndef NO_CERTS
 #ifdef WOLFSSL_COPY_CERT
@@ -21320,6 +21779,8 @@ int wolfSSL_CTX_set_tlsext_ticket_key_cb(WOLFSSL_CTX *ctx, ticketCompatCb cb)
 long wolfSSL_CTX_get_tlsext_ticket_keys(WOLFSSL_CTX *ctx,
      unsigned char *keys, int keylen)
 {
+    int i;
+
     if (ctx == NULL || keys == NULL) {
         return WOLFSSL_FAILURE;
     }
@@ -21329,13 +21790,14 @@ long wolfSSL_CTX_get_tlsext_ticket_keys(WOLFSSL_CTX *ctx,
 
     XMEMCPY(keys, ctx->ticketKeyCtx.name, WOLFSSL_TICKET_NAME_SZ);
     keys += WOLFSSL_TICKET_NAME_SZ;
-    XMEMCPY(keys, ctx->ticketKeyCtx.key[0], WOLFSSL_TICKET_KEY_SZ);
-    keys += WOLFSSL_TICKET_KEY_SZ;
-    XMEMCPY(keys, ctx->ticketKeyCtx.key[1], WOLFSSL_TICKET_KEY_SZ);
-    keys += WOLFSSL_TICKET_KEY_SZ;
-    c32toa(ctx->ticketKeyCtx.expirary[0], keys);
-    keys += OPAQUE32_LEN;
-    c32toa(ctx->ticketKeyCtx.expirary[1], keys);
+    for (i = 0; i < WOLFSSL_TICKET_KEY_CNT; i++) {
+        XMEMCPY(keys, ctx->ticketKeyCtx.key[i], WOLFSSL_TICKET_KEY_SZ);
+        keys += WOLFSSL_TICKET_KEY_SZ;
+    }
+    for (i = 0; i < WOLFSSL_TICKET_KEY_CNT; i++) {
+        c32toa(ctx->ticketKeyCtx.expirary[i], keys);
+        keys += OPAQUE32_LEN;
+    }
 
     return WOLFSSL_SUCCESS;
 }
@@ -21353,6 +21815,9 @@ long wolfSSL_CTX_set_tlsext_ticket_keys(WOLFSSL_CTX *ctx,
      const void *keys_vp, int keylen)
 {
     const byte* keys = (const byte*)keys_vp;
+    int ret = WOLFSSL_SUCCESS;
+    int i;
+
     if (ctx == NULL || keys == NULL) {
         return WOLFSSL_FAILURE;
     }
@@ -21360,17 +21825,32 @@ long wolfSSL_CTX_set_tlsext_ticket_keys(WOLFSSL_CTX *ctx,
         return WOLFSSL_FAILURE;
     }
 
+#ifndef SINGLE_THREADED
+    /* Tickets may be encrypted/decrypted by other connections. */
+    if (wc_LockMutex(&ctx->ticketKeyCtx.mutex) != 0) {
+        return WOLFSSL_FAILURE;
+    }
+#endif
     XMEMCPY(ctx->ticketKeyCtx.name, keys, WOLFSSL_TICKET_NAME_SZ);
     keys += WOLFSSL_TICKET_NAME_SZ;
-    XMEMCPY(ctx->ticketKeyCtx.key[0], keys, WOLFSSL_TICKET_KEY_SZ);
-    keys += WOLFSSL_TICKET_KEY_SZ;
-    XMEMCPY(ctx->ticketKeyCtx.key[1], keys, WOLFSSL_TICKET_KEY_SZ);
-    keys += WOLFSSL_TICKET_KEY_SZ;
-    ato32(keys, &ctx->ticketKeyCtx.expirary[0]);
-    keys += OPAQUE32_LEN;
-    ato32(keys, &ctx->ticketKeyCtx.expirary[1]);
+    for (i = 0; (ret == WOLFSSL_SUCCESS) && (i < WOLFSSL_TICKET_KEY_CNT);
+            i++) {
+        XMEMCPY(ctx->ticketKeyCtx.key[i], keys, WOLFSSL_TICKET_KEY_SZ);
+        keys += WOLFSSL_TICKET_KEY_SZ;
+        if (TicketEncCbCtx_SetKey(&ctx->ticketKeyCtx, i) != 0) {
+            ret = WOLFSSL_FAILURE;
+        }
+    }
+    for (i = 0; (ret == WOLFSSL_SUCCESS) && (i < WOLFSSL_TICKET_KEY_CNT);
+            i++) {
+        ato32(keys, &ctx->ticketKeyCtx.expirary[i]);
+        keys += OPAQUE32_LEN;
+    }
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&ctx->ticketKeyCtx.mutex);
+#endif
 
-    return WOLFSSL_SUCCESS;
+    return ret;
 }
 #endif
 
@@ -171,6 +171,22 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew(void)
     return wolfSSL_CertManagerNew_ex(NULL);
 }
 
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+/* Dispose of the signature verification cache.
+ *
+ * @param [in, out] cm  Certificate manager.
+ */
+static void cm_verify_cache_free(WOLFSSL_CERT_MANAGER* cm)
+{
+    if (cm->verifyCache != NULL) {
+        wc_FreeMutex(&cm->verifyCache->lock);
+        XFREE(cm->verifyCache->entries, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        XFREE(cm->verifyCache, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        cm->verifyCache = NULL;
+    }
+}
+#endif
+
 /* Dispose of certificate manager.
  *
  * @param [in, out] cm  Certificate manager.
@@ -221,6 +237,10 @@ void wolfSSL_CertManagerFree(WOLFSSL_CERT_MANAGER* cm)
 
             /* Dispose of CA table and mutex. */
             FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
+        #ifdef WOLFSSL_CA_INDEX
+            /* Dispose of CA index. */
+            CM_CaIndexReset(cm);
+        #endif
             wc_FreeMutex(&cm->caLock);
 
         #ifdef WOLFSSL_TRUST_PEER_CERT
@@ -229,6 +249,15 @@ void wolfSSL_CertManagerFree(WOLFSSL_CERT_MANAGER* cm)
             wc_FreeMutex(&cm->tpLock);
         #endif
 
+        #ifdef WOLFSSL_CERT_VERIFY_CACHE
+            /* Dispose of signature verification cache. */
+            cm_verify_cache_free(cm);
+        #endif
+        #ifdef WOLFSSL_CRL_COMPILED
+            /* Zeroize key authenticating compiled CRLs. */
+            ForceZero(cm->crlCompiledKey, sizeof(cm->crlCompiledKey));
+        #endif
+
             /* Dispose of reference count. */
             wolfSSL_RefFree(&cm->ref);
             /* Dispose of certificate manager memory. */
@@ -447,6 +476,9 @@ int wolfSSL_CertManagerUnloadCAs(WOLFSSL_CERT_MANAGER* cm)
     if (ret == WOLFSSL_SUCCESS) {
         /* Dispose of CA table. */
         FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
+    #ifdef WOLFSSL_CA_INDEX
+        CM_CaIndexReset(cm);
+    #endif
 
         /* Unlock CA table. */
         wc_UnLockMutex(&cm->caLock);
@@ -473,6 +505,9 @@ int wolfSSL_CertManagerUnloadIntermediateCerts(WOLFSSL_CERT_MANAGER* cm)
         /* Dispose of CA table. */
         FreeSignerTableType(cm->caTable, CA_TABLE_SIZE, WOLFSSL_CHAIN_CA,
                 cm->heap);
+    #ifdef WOLFSSL_CA_INDEX
+        CM_CaIndexReset(cm);
+    #endif
 
         /* Unlock CA table. */
         wc_UnLockMutex(&cm->caLock);
@@ -1548,6 +1583,9 @@ int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER* cm, const void* mem, int sz)
             /* Update pointer to data of next row. */
             current += added;
         }
+    #ifdef WOLFSSL_CA_INDEX
+        CM_CaIndexReset(cm);
+    #endif
 
         /* Unlock CA table. */
         wc_UnLockMutex(&cm->caLock);
@@ -1589,6 +1627,592 @@ int CM_GetCertCacheMemSize(WOLFSSL_CERT_MANAGER* cm)
 
 #endif /* PERSIST_CERT_CACHE */
 
+/*******************************************************************************
+ * CA signer index
+ ******************************************************************************/
+
+#ifdef WOLFSSL_CA_INDEX
+
+#if !defined(SINGLE_THREADED) && !defined(WOLFSSL_ATOMIC_OPS)
+    #error "CA index requires atomic operations when multi-threaded."
+#endif
+
+/* Get the key a signer is looked up with by GetCA().
+ *
+ * @param [in] s  Signer.
+ * @return  Hash of subject key identifier or subject name.
+ */
+static const byte* ca_index_id(const Signer* s)
+{
+#ifndef NO_SKID
+    return s->subjectKeyIdHash;
+#else
+    return s->subjectNameHash;
+#endif
+}
+
+/* Get the first slot to probe for a hash.
+ *
+ * SKIDs are not always digests - mix all bytes so that sequential values
+ * don't share low bits.
+ *
+ * @param [in] hash  Hash signer is indexed with.
+ * @param [in] mask  Number of slots - 1.
+ * @return  Index of slot.
+ */
+static word32 ca_index_slot(const byte* hash, word32 mask)
+{
+    word32 h = 0;
+    int i;
+
+    for (i = 0; i + 4 <= SIGNER_DIGEST_SIZE; i += 4) {
+        h ^= MakeWordFromHash(hash + i);
+    }
+    h *= 0x9E3779B1U;
+
+    return (h ^ (h >> 16)) & mask;
+}
+
+/* Put a signer into the first empty slot from the hash's position.
+ *
+ * Caller holds caLock. Slot is stored atomically for lock free readers.
+ *
+ * @param [in] slots  Slots of index.
+ * @param [in] mask   Number of slots - 1.
+ * @param [in] hash   Hash signer is indexed with.
+ * @param [in] s      Signer.
+ */
+static void ca_index_put(Signer* volatile* slots, word32 mask,
+    const byte* hash, Signer* s)
+{
+    word32 i = ca_index_slot(hash, mask);
+
+    while (slots[i] != NULL) {
+        i = (i + 1) & mask;
+    }
+    wolfSSL_Atomic_Ptr_Store((void* volatile*)&slots[i], s);
+}
+
+/* Get the row of the CA table a signer is in.
+ *
+ * Same as HashSigner() in ssl.c.
+ *
+ * @param [in] s  Signer.
+ * @return  Index of row.
+ */
+static word32 ca_index_row(const Signer* s)
+{
+    return MakeWordFromHash(ca_index_id(s)) % CA_TABLE_SIZE;
+}
+
+/* Put a newly added signer into the subject name slots.
+ *
+ * Without an index, GetCAByName() walks the CA table by row and each row from
+ * its head, where new signers are added, and returns the first match. Signers
+ * with the same subject name are kept in that order along the probe sequence
+ * so that the index finds the same one: the new signer goes before the first
+ * with the same name in the same or a later row. Those after it move along to
+ * the next same name slot, the last into the empty slot, so that lock free
+ * readers always find each signer.
+ *
+ * Caller holds caLock.
+ *
+ * @param [in] slots  Subject name slots of index.
+ * @param [in] mask   Number of slots - 1.
+ * @param [in] s      Signer added to head of its row.
+ */
+static void ca_index_put_name(Signer* volatile* slots, word32 mask, Signer* s)
+{
+    word32 row = ca_index_row(s);
+    word32 i = ca_index_slot(s->subjectNameHash, mask);
+    word32 j;
+    word32 k;
+    Signer* cur;
+
+    while ((cur = slots[i]) != NULL) {
+        if ((XMEMCMP(cur->subjectNameHash, s->subjectNameHash,
+                SIGNER_DIGEST_SIZE) == 0) && (ca_index_row(cur) >= row)) {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    if (cur != NULL) {
+        /* Find end of run and move same name signers along, last first. */
+        j = i;
+        while (slots[j] != NULL) {
+            j = (j + 1) & mask;
+        }
+        k = j;
+        while (j != i) {
+            j = (j - 1) & mask;
+            cur = slots[j];
+            if (XMEMCMP(cur->subjectNameHash, s->subjectNameHash,
+                    SIGNER_DIGEST_SIZE) == 0) {
+                wolfSSL_Atomic_Ptr_Store((void* volatile*)&slots[k], cur);
+                k = j;
+            }
+        }
+    }
+    wolfSSL_Atomic_Ptr_Store((void* volatile*)&slots[i], s);
+}
+
+/* Build an index of all signers in the CA table.
+ *
+ * Caller holds caLock. Table is at most a quarter full. Signers are put in
+ * the order the CA table is walked so signers with the same subject name are
+ * found in the same order as without the index.
+ *
+ * @param [in] cm  Certificate manager.
+ * @return  New index on success.
+ * @return  NULL when no signers or dynamic memory allocation fails.
+ */
+static CaIndexTable* ca_index_new(WOLFSSL_CERT_MANAGER* cm)
+{
+    CaIndexTable* t = NULL;
+    Signer* s;
+    word32 count = 0;
+    word32 slots = WOLFSSL_CA_INDEX_MIN_SZ;
+    int row;
+
+    for (row = 0; row < CA_TABLE_SIZE; row++) {
+        for (s = cm->caTable[row]; s != NULL; s = s->next) {
+            count++;
+        }
+    }
+    while ((slots < count * 4) && (slots < ((word32)1 << 28))) {
+        slots <<= 1;
+    }
+
+    if ((count > 0) && (count * 2 < slots)) {
+        /* Both arrays of slots allocated after table. */
+        t = (CaIndexTable*)XMALLOC(sizeof(CaIndexTable) +
+            2 * slots * sizeof(Signer*), cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    }
+    if (t != NULL) {
+        XMEMSET(t, 0, sizeof(CaIndexTable) + 2 * slots * sizeof(Signer*));
+        t->byId = (Signer* volatile*)(t + 1);
+        t->byName = t->byId + slots;
+        t->mask = slots - 1;
+        t->count = count;
+        for (row = 0; row < CA_TABLE_SIZE; row++) {
+            for (s = cm->caTable[row]; s != NULL; s = s->next) {
+                ca_index_put(t->byId, t->mask, ca_index_id(s), s);
+                ca_index_put(t->byName, t->mask, s->subjectNameHash, s);
+            }
+        }
+    }
+
+    return t;
+}
+
+/* Make index the one readers use and retire the current one.
+ *
+ * Caller holds caLock.
+ *
+ * @param [in] cm  Certificate manager.
+ * @param [in] t   Index to publish. NULL makes readers search the CA table.
+ */
+static void ca_index_publish(WOLFSSL_CERT_MANAGER* cm, CaIndexTable* t)
+{
+    CaIndexTable* old = cm->caIndex;
+
+    wolfSSL_Atomic_Ptr_Store((void* volatile*)&cm->caIndex, t);
+    if (old != NULL) {
+        /* Readers may still be searching old index. */
+        old->retired = cm->caIndexRetired;
+        cm->caIndexRetired = old;
+    }
+}
+
+/* Index a signer that has been added to the CA table.
+ *
+ * Caller holds caLock. When the index is half full a bigger one is built.
+ *
+ * @param [in] cm  Certificate manager.
+ * @param [in] s   Signer added to CA table.
+ */
+void CM_CaIndexAdd(WOLFSSL_CERT_MANAGER* cm, Signer* s)
+{
+    CaIndexTable* t = cm->caIndex;
+
+    if ((t != NULL) && ((t->count + 1) * 2 <= t->mask + 1)) {
+        ca_index_put(t->byId, t->mask, ca_index_id(s), s);
+        ca_index_put_name(t->byName, t->mask, s);
+        t->count++;
+    }
+    else {
+        /* On allocation failure, readers search the CA table instead. */
+        ca_index_publish(cm, ca_index_new(cm));
+    }
+}
+
+/* Rebuild the index after signers have been removed from the CA table.
+ *
+ * Caller holds caLock. Frees retired indexes - as with the signers removed,
+ * no certificate may be being verified concurrently.
+ *
+ * @param [in] cm  Certificate manager.
+ */
+void CM_CaIndexReset(WOLFSSL_CERT_MANAGER* cm)
+{
+    CaIndexTable* t;
+
+    ca_index_publish(cm, NULL);
+    while ((t = cm->caIndexRetired) != NULL) {
+        cm->caIndexRetired = t->retired;
+        XFREE(t, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    }
+    ca_index_publish(cm, ca_index_new(cm));
+}
+
+/* Find a signer in the index without locking.
+ *
+ * @param [in]  cm      Certificate manager.
+ * @param [in]  hash    Hash of SKID, or subject name when NO_SKID.
+ * @param [in]  byName  Whether hash is of the subject name.
+ * @param [out] signer  Signer found or NULL when not found.
+ * @return  0 when index was searched.
+ * @return  -1 when no index and CA table must be searched.
+ */
+int CM_CaIndexFind(WOLFSSL_CERT_MANAGER* cm, const byte* hash, int byName,
+    Signer** signer)
+{
+    CaIndexTable* t;
+    Signer* volatile* slots;
+    Signer* s;
+    word32 i;
+
+    t = (CaIndexTable*)wolfSSL_Atomic_Ptr_Load((void* volatile*)&cm->caIndex);
+    if (t == NULL) {
+        return -1;
+    }
+
+    slots = byName ? t->byName : t->byId;
+    i = ca_index_slot(hash, t->mask);
+    /* Index is never full so an empty slot ends the search. */
+    while ((s = (Signer*)wolfSSL_Atomic_Ptr_Load(
+            (void* volatile*)&slots[i])) != NULL) {
+        const byte* key = byName ? s->subjectNameHash : ca_index_id(s);
+        if (XMEMCMP(hash, key, SIGNER_DIGEST_SIZE) == 0) {
+            break;
+        }
+        i = (i + 1) & t->mask;
+    }
+    *signer = s;
+
+    return 0;
+}
+
+#endif /* WOLFSSL_CA_INDEX */
+
+/*******************************************************************************
+ * Certificate signature verification cache
+ ******************************************************************************/
+
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+
+/* Enable, resize or disable caching of certificate signature verifications.
+ *
+ * A certificate signed by a CA that has been seen before with the same CA
+ * public key need not have its signature checked again. Only the signature
+ * check is skipped - the certificate is still decoded as the decoded fields
+ * are used by the rest of certificate processing. Results are kept for
+ * timeout seconds. Changing the size discards all cached results.
+ *
+ * Not thread safe with respect to certificate verification - call before
+ * using the certificate manager.
+ *
+ * @param [in] cm       Certificate manager.
+ * @param [in] sz       Number of results to cache. 0 disables the cache.
+ * @param [in] timeout  Seconds to keep a result. 0 uses the default of
+ *                      WOLFSSL_CERT_VERIFY_CACHE_TIMEOUT.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when cm is NULL.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  BAD_MUTEX_E when initializing mutex fails.
+ */
+int wolfSSL_CertManagerSetVerifyCache(WOLFSSL_CERT_MANAGER* cm, word32 sz,
+    word32 timeout)
+{
+    int ret = WOLFSSL_SUCCESS;
+    CertVerifyCache* cache = NULL;
+    word32 rows = 0;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerSetVerifyCache");
+
+    /* Validate parameter. */
+    if (cm == NULL) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == WOLFSSL_SUCCESS) && (sz > 0)) {
+        /* Round up to a whole number of rows. */
+        rows = (sz + WOLFSSL_CERT_VERIFY_CACHE_WAYS - 1) /
+               WOLFSSL_CERT_VERIFY_CACHE_WAYS;
+        if (rows > (word32)0xFFFFFFFF / (WOLFSSL_CERT_VERIFY_CACHE_WAYS *
+                (word32)sizeof(CertVerifyCacheEntry))) {
+            ret = BAD_FUNC_ARG;
+        }
+    }
+    if ((ret == WOLFSSL_SUCCESS) && (sz > 0)) {
+        cache = (CertVerifyCache*)XMALLOC(sizeof(CertVerifyCache), cm->heap,
+            DYNAMIC_TYPE_CERT_MANAGER);
+        if (cache == NULL) {
+            ret = MEMORY_E;
+        }
+        else {
+            XMEMSET(cache, 0, sizeof(CertVerifyCache));
+            cache->rows = rows;
+            cache->timeout = (timeout == 0) ? WOLFSSL_CERT_VERIFY_CACHE_TIMEOUT
+                                            : timeout;
+            cache->entries = (CertVerifyCacheEntry*)XMALLOC(
+                rows * WOLFSSL_CERT_VERIFY_CACHE_WAYS *
+                sizeof(CertVerifyCacheEntry), cm->heap,
+                DYNAMIC_TYPE_CERT_MANAGER);
+            if (cache->entries == NULL) {
+                ret = MEMORY_E;
+            }
+            else {
+                XMEMSET(cache->entries, 0, rows *
+                    WOLFSSL_CERT_VERIFY_CACHE_WAYS *
+                    sizeof(CertVerifyCacheEntry));
+                if (wc_InitMutex(&cache->lock) != 0) {
+                    ret = BAD_MUTEX_E;
+                }
+            }
+            if (ret != WOLFSSL_SUCCESS) {
+                XFREE(cache->entries, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+                XFREE(cache, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+                cache = NULL;
+            }
+        }
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        /* Replace any existing cache. */
+        cm_verify_cache_free(cm);
+        cm->verifyCache = cache;
+    }
+
+    return ret;
+}
+
+/* Get the statistics of the signature verification cache.
+ *
+ * @param [in]  cm     Certificate manager.
+ * @param [out] stats  Cache statistics.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when cm or stats is NULL.
+ * @return  BAD_STATE_E when the cache is not enabled.
+ * @return  BAD_MUTEX_E when locking fails.
+ */
+int wolfSSL_CertManagerGetVerifyCacheStats(WOLFSSL_CERT_MANAGER* cm,
+    WOLFSSL_CERT_VERIFY_CACHE_STATS* stats)
+{
+    int ret = WOLFSSL_SUCCESS;
+    CertVerifyCache* cache = NULL;
+
+    /* Validate parameters. */
+    if ((cm == NULL) || (stats == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    else if ((cache = cm->verifyCache) == NULL) {
+        ret = BAD_STATE_E;
+    }
+    else if (wc_LockMutex(&cache->lock) != 0) {
+        ret = BAD_MUTEX_E;
+    }
+    else {
+        word32 i;
+        word32 now = LowResTimer();
+
+        XMEMSET(stats, 0, sizeof(*stats));
+        stats->hits = cache->hits;
+        stats->misses = cache->misses;
+        stats->evictions = cache->evictions;
+        /* Count results that have not expired. */
+        for (i = 0; i < cache->rows * WOLFSSL_CERT_VERIFY_CACHE_WAYS; i++) {
+            if (cache->entries[i].used &&
+                    (now - cache->entries[i].added < cache->timeout)) {
+                stats->entries++;
+            }
+        }
+        wc_UnLockMutex(&cache->lock);
+    }
+
+    return ret;
+}
+
+/* Calculate the identity of a signature verification.
+ *
+ * Covers everything the result of the signature check depends on: the CA's
+ * public key and the signed data, signature and signature algorithm of the
+ * certificate.
+ *
+ * @param [in]  cert    Decoded certificate with CA found.
+ * @param [in]  keyOID  Key OID used to verify signature.
+ * @param [out] id      Buffer to hold SHA-256 digest.
+ * @return  0 on success.
+ * @return  Other value on hashing failure.
+ */
+static int cm_verify_cache_id(const DecodedCert* cert, word32 keyOID, byte* id)
+{
+    int ret;
+    byte lens[4 * 4];
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Sha256* sha256;
+#else
+    wc_Sha256 sha256[1];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    sha256 = (wc_Sha256*)XMALLOC(sizeof(wc_Sha256), cert->heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (sha256 == NULL) {
+        return MEMORY_E;
+    }
+#endif
+
+    /* Lengths and OIDs make the concatenation unambiguous. */
+    c32toa(keyOID, lens);
+    c32toa(cert->ca->pubKeySize, lens + 4);
+    c32toa(cert->signatureOID, lens + 8);
+    c32toa(cert->sigIndex - cert->certBegin, lens + 12);
+
+    ret = wc_InitSha256_ex(sha256, cert->heap, INVALID_DEVID);
+    if (ret == 0) {
+        ret = wc_Sha256Update(sha256, lens, sizeof(lens));
+        if (ret == 0) {
+            ret = wc_Sha256Update(sha256, cert->ca->publicKey,
+                cert->ca->pubKeySize);
+        }
+        if (ret == 0) {
+            ret = wc_Sha256Update(sha256, cert->source + cert->certBegin,
+                cert->sigIndex - cert->certBegin);
+        }
+    #ifdef WC_RSA_PSS
+        if (ret == 0) {
+            ret = wc_Sha256Update(sha256, cert->source + cert->sigParamsIndex,
+                cert->sigParamsLength);
+        }
+    #endif
+        if (ret == 0) {
+            ret = wc_Sha256Update(sha256, cert->signature, cert->sigLength);
+        }
+        if (ret == 0) {
+            ret = wc_Sha256Final(sha256, id);
+        }
+        wc_Sha256Free(sha256);
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(sha256, cert->heap, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    return ret;
+}
+
+/* Look up whether the certificate's signature has been verified before.
+ *
+ * Called when parsing a certificate for which the CA has been found.
+ *
+ * @param [in]  vp      Certificate manager.
+ * @param [in]  cert    Decoded certificate with CA found.
+ * @param [in]  keyOID  Key OID used to verify signature.
+ * @param [out] id      Identity of verification to pass to
+ *                      CM_VerifyCacheAdd(). WC_SHA256_DIGEST_SIZE bytes.
+ * @return  1 when signature verified previously.
+ * @return  0 when not found and id has been calculated.
+ * @return  -1 when cache not enabled or an error occurred.
+ */
+int CM_VerifyCacheLookup(void* vp, const DecodedCert* cert, word32 keyOID,
+    byte* id)
+{
+    WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
+    CertVerifyCache* cache;
+    CertVerifyCacheEntry* row;
+    word32 now;
+    word32 i;
+    int ret = 0;
+
+    if ((cm == NULL) || ((cache = cm->verifyCache) == NULL) ||
+            (cert->ca == NULL) || (cert->ca->publicKey == NULL)) {
+        return -1;
+    }
+    if (cm_verify_cache_id(cert, keyOID, id) != 0) {
+        return -1;
+    }
+    if (wc_LockMutex(&cache->lock) != 0) {
+        return -1;
+    }
+
+    now = LowResTimer();
+    row = &cache->entries[(MakeWordFromHash(id) % cache->rows) *
+                          WOLFSSL_CERT_VERIFY_CACHE_WAYS];
+    for (i = 0; i < WOLFSSL_CERT_VERIFY_CACHE_WAYS; i++) {
+        if (row[i].used && (now - row[i].added < cache->timeout) &&
+                (ConstantCompare(row[i].id, id, WC_SHA256_DIGEST_SIZE) == 0)) {
+            ret = 1;
+            break;
+        }
+    }
+    if (ret == 1) {
+        cache->hits++;
+    }
+    else {
+        cache->misses++;
+    }
+
+    wc_UnLockMutex(&cache->lock);
+    return ret;
+}
+
+/* Cache that a certificate's signature was successfully verified.
+ *
+ * Uses a free or expired way of the row, otherwise replaces the oldest.
+ *
+ * @param [in] vp  Certificate manager.
+ * @param [in] id  Identity of verification from CM_VerifyCacheLookup().
+ */
+void CM_VerifyCacheAdd(void* vp, const byte* id)
+{
+    WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
+    CertVerifyCache* cache;
+    CertVerifyCacheEntry* row;
+    CertVerifyCacheEntry* entry = NULL;
+    word32 now;
+    word32 i;
+
+    if ((cm == NULL) || ((cache = cm->verifyCache) == NULL)) {
+        return;
+    }
+    if (wc_LockMutex(&cache->lock) != 0) {
+        return;
+    }
+
+    now = LowResTimer();
+    row = &cache->entries[(MakeWordFromHash(id) % cache->rows) *
+                          WOLFSSL_CERT_VERIFY_CACHE_WAYS];
+    for (i = 0; i < WOLFSSL_CERT_VERIFY_CACHE_WAYS; i++) {
+        if ((!row[i].used) || (now - row[i].added >= cache->timeout)) {
+            entry = &row[i];
+            break;
+        }
+        if ((entry == NULL) || (now - row[i].added > now - entry->added)) {
+            entry = &row[i];
+        }
+    }
+    if ((i == WOLFSSL_CERT_VERIFY_CACHE_WAYS) && (entry != NULL)) {
+        cache->evictions++;
+    }
+    if (entry != NULL) {
+        XMEMCPY(entry->id, id, WC_SHA256_DIGEST_SIZE);
+        entry->added = now;
+        entry->used = 1;
+    }
+
+    wc_UnLockMutex(&cache->lock);
+}
+
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
+
 /*******************************************************************************
  * CRL handling
  ******************************************************************************/
@@ -1746,6 +2370,175 @@ int wolfSSL_CertManagerLoadCRLBuffer(WOLFSSL_CERT_MANAGER* cm,
     return ret;
 }
 
+#ifdef WOLFSSL_CRL_COMPILED
+/* Set the key that authenticates compiled CRLs.
+ *
+ * Compiled CRLs are tagged with an HMAC-SHA256 using this key and only
+ * compiled CRLs with a matching tag are loaded. The key must be kept secret
+ * from anyone able to write a compiled CRL file.
+ *
+ * @param [in] cm     Certificate manager.
+ * @param [in] key    Key data.
+ * @param [in] keySz  Size of key in bytes.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when cm or key is NULL or keySz is less than
+ *          WOLFSSL_CRL_COMPILED_MIN_KEY_SZ or more than
+ *          WOLFSSL_CRL_COMPILED_MAX_KEY_SZ.
+ */
+int wolfSSL_CertManagerSetCompiledCRLKey(WOLFSSL_CERT_MANAGER* cm,
+    const unsigned char* key, word32 keySz)
+{
+    WOLFSSL_ENTER("wolfSSL_CertManagerSetCompiledCRLKey");
+
+    /* Validate parameters. */
+    if ((cm == NULL) || (key == NULL) ||
+            (keySz < WOLFSSL_CRL_COMPILED_MIN_KEY_SZ) ||
+            (keySz > WOLFSSL_CRL_COMPILED_MAX_KEY_SZ)) {
+        return BAD_FUNC_ARG;
+    }
+
+    ForceZero(cm->crlCompiledKey, sizeof(cm->crlCompiledKey));
+    XMEMCPY(cm->crlCompiledKey, key, keySz);
+    cm->crlCompiledKeySz = keySz;
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Compile a CRL into a flat sorted form that is loaded without parsing.
+ *
+ * The CRL is verified with the CAs loaded into the certificate manager and
+ * the compiled CRL is authenticated with the key set by
+ * wolfSSL_CertManagerSetCompiledCRLKey().
+ * Pass NULL for out to get the size of the compiled CRL.
+ *
+ * @param [in]      cm     Certificate manager.
+ * @param [in]      buff   Buffer holding CRL.
+ * @param [in]      sz     Size in bytes of CRL in buffer.
+ * @param [in]      type   Format of encoding. Valid values:
+ *                           WOLFSSL_FILETYPE_ASN1, WOLFSSL_FILETYPE_PEM.
+ * @param [out]     out    Buffer to hold compiled CRL. May be NULL.
+ * @param [in, out] outSz  On in, size of buffer in bytes.
+ *                         On out, size of compiled CRL in bytes.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  LENGTH_ONLY_E when out is NULL and outSz is set.
+ * @return  BAD_FUNC_ARG when cm, buff or outSz is NULL or sz is negative or
+ *          zero.
+ * @return  BAD_STATE_E when no compiled CRL key is set.
+ * @return  BUFFER_E when out is too small.
+ * @return  Other negative value when CRL fails to parse or verify.
+ */
+int wolfSSL_CertManagerCompileCRL(WOLFSSL_CERT_MANAGER* cm,
+    const unsigned char* buff, long sz, int type, unsigned char* out,
+    word32* outSz)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerCompileCRL");
+
+    ret = CompileCRL(cm, buff, sz, type, out, outSz);
+    if (ret == 0) {
+        ret = WOLFSSL_SUCCESS;
+    }
+
+    return ret;
+}
+
+/* Load a compiled CRL for use.
+ *
+ * The compiled CRL is used in place and must stay valid until replaced or
+ * the CRL object is freed. A compiled CRL for the same issuer is replaced -
+ * the previous buffer may be freed once this returns.
+ *
+ * @param [in] cm    Certificate manager.
+ * @param [in] buff  Buffer holding compiled CRL.
+ * @param [in] sz    Size in bytes of compiled CRL.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when cm or buff is NULL or sz is out of range.
+ * @return  WOLFSSL_FATAL_ERROR when creating CRL object fails.
+ * @return  BAD_STATE_E when no compiled CRL key is set.
+ * @return  ASN_PARSE_E when buff is not a compiled CRL for this build.
+ * @return  ASN_CRL_CONFIRM_E when the authentication tag doesn't match.
+ * @return  ASN_CRL_NO_SIGNER_E when the issuer isn't a loaded CA.
+ */
+int wolfSSL_CertManagerLoadCompiledCRL(WOLFSSL_CERT_MANAGER* cm,
+    const unsigned char* buff, long sz)
+{
+    int ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerLoadCompiledCRL");
+
+    /* Validate parameters. */
+    if ((cm == NULL) || (buff == NULL) || (sz <= 0) ||
+            ((unsigned long)sz > 0xFFFFFFFFUL)) {
+        ret = BAD_FUNC_ARG;
+    }
+
+    /* Create a CRL object if not available and enable CRL checking. */
+    if ((ret == WOLFSSL_SUCCESS) && (cm->crl == NULL) &&
+            (wolfSSL_CertManagerEnableCRL(cm, WOLFSSL_CRL_CHECK) !=
+             WOLFSSL_SUCCESS)) {
+        WOLFSSL_MSG("Enable CRL failed");
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+
+    if (ret == WOLFSSL_SUCCESS) {
+        ret = LoadCompiledCRL(cm->crl, buff, (word32)sz, 0);
+        if (ret == 0) {
+            ret = WOLFSSL_SUCCESS;
+        }
+    }
+
+    return ret;
+}
+
+#if defined(WOLFSSL_CRL_COMPILED_MMAP) && !defined(NO_FILESYSTEM)
+/* Map a compiled CRL file into memory and load it for use.
+ *
+ * Loading a new file for the same issuer replaces the mapping of the old one.
+ *
+ * @param [in] cm    Certificate manager.
+ * @param [in] file  Name of compiled CRL file.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when cm or file is NULL.
+ * @return  WOLFSSL_FATAL_ERROR when creating CRL object fails.
+ * @return  BAD_PATH_ERROR when file can't be opened.
+ * @return  BAD_STATE_E when no compiled CRL key is set.
+ * @return  ASN_PARSE_E when file is not a compiled CRL for this build.
+ * @return  ASN_CRL_CONFIRM_E when the authentication tag doesn't match.
+ * @return  ASN_CRL_NO_SIGNER_E when the issuer isn't a loaded CA.
+ */
+int wolfSSL_CertManagerLoadCompiledCRLFile(WOLFSSL_CERT_MANAGER* cm,
+    const char* file)
+{
+    int ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerLoadCompiledCRLFile");
+
+    /* Validate parameters. */
+    if ((cm == NULL) || (file == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+
+    /* Create a CRL object if not available and enable CRL checking. */
+    if ((ret == WOLFSSL_SUCCESS) && (cm->crl == NULL) &&
+            (wolfSSL_CertManagerEnableCRL(cm, WOLFSSL_CRL_CHECK) !=
+             WOLFSSL_SUCCESS)) {
+        WOLFSSL_MSG("Enable CRL failed");
+        ret = WOLFSSL_FATAL_ERROR;
+    }
+
+    if (ret == WOLFSSL_SUCCESS) {
+        ret = LoadCompiledCRLFile(cm->crl, file);
+        if (ret == 0) {
+            ret = WOLFSSL_SUCCESS;
+        }
+    }
+
+    return ret;
+}
+#endif
+#endif /* WOLFSSL_CRL_COMPILED */
+
 /* Free the CRL object of the certificate manager.
  *
  * @param [in] cm  Certificate manager.
@@ -2434,6 +3227,81 @@ int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER* cm, CbOCSPIO ioCb,
     return ret;
 }
 
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+/* Set the OCSP response cache policy.
+ *
+ * A thread is started that fetches new responses using the OCSP I/O callback
+ * so that lookups don't wait on the responder. A response is refreshed when
+ * used within prefetch seconds of its nextUpdate. An expired response is used
+ * for up to maxStale seconds after nextUpdate while it is refreshed - not for
+ * stapling. The least recently used response is evicted when maxEntries
+ * responses are cached.
+ *
+ * Call after enabling OCSP and before the certificate manager is used.
+ * Calling again changes the policy.
+ *
+ * @param [in] cm          Certificate manager.
+ * @param [in] maxEntries  Maximum responses to cache. 0 for no limit.
+ * @param [in] prefetch    Seconds before nextUpdate to refresh response.
+ * @param [in] maxStale    Seconds after nextUpdate to use response while
+ *                         refreshing. 0 to never use an expired response.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when cm is NULL or OCSP not enabled.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  THREAD_CREATE_E when refresh thread can't be started.
+ * @return  Other negative value on signaling or locking failure.
+ */
+int wolfSSL_CertManagerSetOCSPCache(WOLFSSL_CERT_MANAGER* cm,
+    word32 maxEntries, word32 prefetch, word32 maxStale)
+{
+    int ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerSetOCSPCache");
+
+    /* Validate parameters. */
+    if ((cm == NULL) || (cm->ocsp == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        ret = SetOcspCache(cm->ocsp, maxEntries, prefetch, maxStale);
+        if (ret == 0) {
+            ret = WOLFSSL_SUCCESS;
+        }
+    }
+
+    return ret;
+}
+
+/* Get the statistics of the OCSP response cache.
+ *
+ * @param [in]  cm     Certificate manager.
+ * @param [out] stats  Statistics of cache.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when cm or stats is NULL or no cache policy set.
+ * @return  BAD_MUTEX_E when locking fails.
+ */
+int wolfSSL_CertManagerGetOCSPCacheStats(WOLFSSL_CERT_MANAGER* cm,
+    WOLFSSL_OCSP_CACHE_STATS* stats)
+{
+    int ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerGetOCSPCacheStats");
+
+    /* Validate parameters. */
+    if ((cm == NULL) || (stats == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if (ret == WOLFSSL_SUCCESS) {
+        ret = GetOcspCacheStats(cm->ocsp, stats);
+        if (ret == 0) {
+            ret = WOLFSSL_SUCCESS;
+        }
+    }
+
+    return ret;
+}
+#endif /* WOLFSSL_OCSP_CACHE_REFRESH */
+
 #endif /* HAVE_OCSP */
 
 #endif /* NO_CERTS */
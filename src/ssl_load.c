@@ -1307,6 +1307,10 @@ static int ProcessBufferPrivKeyHandleDer(WOLFSSL_CTX* ctx, WOLFSSL* ssl,
         ssl->buffers.weOwnKey = 1;
     }
     else if (ctx != NULL) {
+    #ifdef WOLFSSL_PRIV_KEY_CACHE
+        /* Decoded objects of the previous key are no longer valid. */
+        PrivKeyCache_Flush(ctx);
+    #endif
         /* Dispose of previous key. */
         FreeDer(&ctx->privateKey);
         ctx->privateKeyId = 0;
@@ -3978,6 +3982,9 @@ int wolfSSL_CTX_use_PrivateKey_Id(WOLFSSL_CTX* ctx, const unsigned char* id,
 {
     int ret = 1;
 
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    PrivKeyCache_Flush(ctx);
+#endif
     /* Dispose of old private key and allocate and copy in id. */
     FreeDer(&ctx->privateKey);
     if (AllocCopyDer(&ctx->privateKey, id, (word32)sz, PRIVATEKEY_TYPE,
@@ -4042,6 +4049,9 @@ int wolfSSL_CTX_use_PrivateKey_Label(WOLFSSL_CTX* ctx, const char* label,
     int ret = 1;
     word32 sz = (word32)XSTRLEN(label) + 1;
 
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    PrivKeyCache_Flush(ctx);
+#endif
     /* Dispose of old private key and allocate and copy in label. */
     FreeDer(&ctx->privateKey);
     if (AllocCopyDer(&ctx->privateKey, (const byte*)label, (word32)sz,
@@ -34,6 +34,13 @@
 
 #ifndef NO_SESSION_CACHE
 
+#ifdef SESSION_CACHE_SHARED_MEM
+    #ifndef WOLFSSL_PTHREADS
+        #error "Shared session cache requires process shared pthread locks."
+    #endif
+    #include <sys/mman.h>
+#endif
+
     /* basic config gives a cache with 33 sessions, adequate for clients and
        embedded servers
 
@@ -42,7 +49,22 @@
        levels of traffic.
 
        ENABLE_SESSION_CACHE_ROW_LOCK: Allows row level locking for increased
-       performance with large session caches
+       performance with large session caches. Each row is then an independent
+       shard with its own lock. On by default for the TITAN, HUGE and BIG
+       caches, define NO_SESSION_CACHE_ROW_LOCK to use a single global lock.
+
+       Within a row sessions are replaced using a CLOCK policy: unused and
+       expired slots are taken first, otherwise the first session that has
+       not been looked up since the clock hand last passed it is evicted.
+       wolfSSL_CTX_sess_set_cache_size() lowers the number of slots used per
+       row at runtime (up to the compile time maximum). The cache is global so
+       the size applies to all contexts, not just the one passed in. With
+       SESSION_CACHE_DYNAMIC_MEM this bounds the memory used by the cache.
+
+       SESSION_CACHE_SHARED_MEM: Allows the cache to be moved into an
+       anonymous shared memory mapping with process shared locks by calling
+       wolfSSL_use_shared_session_cache() before forking worker processes.
+       All workers then look up and add sessions in the same cache.
 
        HUGE_SESSION_CACHE yields 65,791 sessions, for servers under heavy load,
        allows over 13,000 new sessions per minute or over 200 new sessions per
@@ -73,9 +95,15 @@
     #elif defined(HUGE_SESSION_CACHE)
         #define SESSIONS_PER_ROW 11
         #define SESSION_ROWS 5981
+        #ifndef ENABLE_SESSION_CACHE_ROW_LOCK
+            #define ENABLE_SESSION_CACHE_ROW_LOCK
+        #endif
     #elif defined(BIG_SESSION_CACHE)
         #define SESSIONS_PER_ROW 7
         #define SESSION_ROWS 2861
+        #ifndef ENABLE_SESSION_CACHE_ROW_LOCK
+            #define ENABLE_SESSION_CACHE_ROW_LOCK
+        #endif
     #elif defined(MEDIUM_SESSION_CACHE)
         #define SESSIONS_PER_ROW 5
         #define SESSION_ROWS 211
@@ -104,6 +132,8 @@
 #else
         WOLFSSL_SESSION Sessions[SESSIONS_PER_ROW];
 #endif
+        byte accessed[SESSIONS_PER_ROW];       /* CLOCK reference bits      */
+        int cap;                               /* slots in use, 0 means all */
 
     #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
         /* not included in import/export */
@@ -113,10 +143,74 @@
     } SessionRow;
     #define SIZEOF_SESSION_ROW (sizeof(WOLFSSL_SESSION) + (sizeof(int) * 2))
 
+#ifdef SESSION_CACHE_SHARED_MEM
+    static WOLFSSL_GLOBAL SessionRow SessionCacheLocal[SESSION_ROWS];
+    /* Rows of the shared mapping when in use, otherwise the local rows. */
+    static WOLFSSL_GLOBAL SessionRow* SessionCache = SessionCacheLocal;
+#else
     static WOLFSSL_GLOBAL SessionRow SessionCache[SESSION_ROWS];
+#endif
+    #define SESSION_CACHE_SZ (sizeof(SessionRow) * SESSION_ROWS)
+
+    /* Number of slots used in a row. Changed for all contexts with
+     * wolfSSL_CTX_sess_set_cache_size() and read with the row locked. */
+    #define SESSION_ROW_CAP(row) \
+        (((row)->cap > 0) ? (row)->cap : SESSIONS_PER_ROW)
+
+    /* Lookups set the CLOCK reference bit holding only the row read lock.
+     * Concurrent lookups only ever store 1 and the bit is cleared under the
+     * write lock. Only store when not already set to keep the cache line
+     * shared. */
+    #if defined(HAVE_C___ATOMIC) && !defined(SINGLE_THREADED)
+    #define SESSION_ROW_SET_ACCESSED(row, i)                                  \
+        do {                                                                  \
+            if (__atomic_load_n(&(row)->accessed[i], __ATOMIC_RELAXED) == 0)  \
+                __atomic_store_n(&(row)->accessed[i], 1, __ATOMIC_RELAXED);   \
+        } while (0)
+    #else
+    #define SESSION_ROW_SET_ACCESSED(row, i)                                  \
+        do {                                                                  \
+            if ((row)->accessed[i] == 0)                                      \
+                (row)->accessed[i] = 1;                                       \
+        } while (0)
+    #endif
+
+    #ifdef WOLFSSL_SESSION_STATS
+    /* Counters of the session cache. Kept with the cache so that processes
+     * sharing it see the same values. Lookups only hold the row read lock so
+     * the counters are updated atomically when possible. */
+    typedef struct SessionCacheStats {
+    #ifdef WOLFSSL_ATOMIC_OPS
+        wolfSSL_Atomic_Int hits;
+        wolfSSL_Atomic_Int misses;
+        wolfSSL_Atomic_Int evictions;
+    #else
+        int hits;
+        int misses;
+        int evictions;
+    #endif
+    #ifdef WOLFSSL_PEAK_SESSIONS
+        word32 peak;
+    #endif
+    } SessionCacheStats;
 
-    #if defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS)
-        static WOLFSSL_GLOBAL word32 PeakSessions;
+    #ifdef SESSION_CACHE_SHARED_MEM
+        static WOLFSSL_GLOBAL SessionCacheStats SessionStatsLocal;
+        /* Counters of the shared mapping when in use, otherwise local. */
+        static WOLFSSL_GLOBAL SessionCacheStats* SessionStats =
+            &SessionStatsLocal;
+    #else
+        static WOLFSSL_GLOBAL SessionCacheStats SessionStatsLocal;
+        #define SessionStats (&SessionStatsLocal)
+    #endif
+    #ifdef WOLFSSL_ATOMIC_OPS
+        #define SESSION_STAT_INC(c) \
+            (void)wolfSSL_Atomic_Int_FetchAdd(&SessionStats->c, 1)
+    #else
+        #define SESSION_STAT_INC(c) SessionStats->c++
+    #endif
+    #else
+        #define SESSION_STAT_INC(c) WC_DO_NOTHING
     #endif
 
     #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
@@ -126,9 +220,15 @@
     #else
     static WOLFSSL_GLOBAL wolfSSL_RwLock session_lock; /* SessionCache lock */
     static WOLFSSL_GLOBAL int session_lock_valid = 0;
-    #define SESSION_ROW_RD_LOCK(row)   wc_LockRwLock_Rd(&session_lock)
-    #define SESSION_ROW_WR_LOCK(row)   wc_LockRwLock_Wr(&session_lock)
-    #define SESSION_ROW_UNLOCK(row)    wc_UnLockRwLock(&session_lock);
+    #ifdef SESSION_CACHE_SHARED_MEM
+    static WOLFSSL_GLOBAL wolfSSL_RwLock* session_lock_ptr = &session_lock;
+    #define SESSION_CACHE_LOCK         session_lock_ptr
+    #else
+    #define SESSION_CACHE_LOCK         (&session_lock)
+    #endif
+    #define SESSION_ROW_RD_LOCK(row)   wc_LockRwLock_Rd(SESSION_CACHE_LOCK)
+    #define SESSION_ROW_WR_LOCK(row)   wc_LockRwLock_Wr(SESSION_CACHE_LOCK)
+    #define SESSION_ROW_UNLOCK(row)    wc_UnLockRwLock(SESSION_CACHE_LOCK);
     #endif
 
     #if !defined(NO_SESSION_CACHE_REF) && defined(NO_CLIENT_CACHE)
@@ -176,9 +276,15 @@
             ClientSession Clients[CLIENT_SESSIONS_PER_ROW];
         } ClientRow;
 
+    #ifdef SESSION_CACHE_SHARED_MEM
+        static WOLFSSL_GLOBAL ClientRow ClientCacheLocal[CLIENT_SESSION_ROWS];
+        static WOLFSSL_GLOBAL ClientRow* ClientCache = ClientCacheLocal;
+    #else
         static WOLFSSL_GLOBAL ClientRow ClientCache[CLIENT_SESSION_ROWS];
                                                      /* Client Cache */
                                                      /* uses session mutex */
+    #endif
+        #define CLIENT_CACHE_SZ (sizeof(ClientRow) * CLIENT_SESSION_ROWS)
 
         /* ClientCache mutex */
         static WOLFSSL_GLOBAL wolfSSL_Mutex clisession_mutex
@@ -186,6 +292,13 @@
         #ifndef WOLFSSL_MUTEX_INITIALIZER
         static WOLFSSL_GLOBAL int clisession_mutex_valid = 0;
         #endif
+    #ifdef SESSION_CACHE_SHARED_MEM
+        static WOLFSSL_GLOBAL wolfSSL_Mutex* clisession_mutex_ptr =
+            &clisession_mutex;
+        #define CLIENT_CACHE_LOCK clisession_mutex_ptr
+    #else
+        #define CLIENT_CACHE_LOCK (&clisession_mutex)
+    #endif
     #endif /* !NO_CLIENT_CACHE */
 
     void EvictSessionFromCache(WOLFSSL_SESSION* session)
@@ -422,9 +535,9 @@ typedef struct {
 /* get how big the the session cache save buffer needs to be */
 int wolfSSL_get_session_cache_memsize(void)
 {
-    int sz  = (int)(sizeof(SessionCache) + sizeof(cache_header_t));
+    int sz  = (int)(SESSION_CACHE_SZ + sizeof(cache_header_t));
 #ifndef NO_CLIENT_CACHE
-    sz += (int)(sizeof(ClientCache));
+    sz += (int)(CLIENT_CACHE_SZ);
 #endif
     return sz;
 }
@@ -474,12 +587,12 @@ int wolfSSL_memsave_session_cache(void* mem, int sz)
 #endif
 
 #ifndef NO_CLIENT_CACHE
-    if (wc_LockMutex(&clisession_mutex) != 0) {
+    if (wc_LockMutex(CLIENT_CACHE_LOCK) != 0) {
         WOLFSSL_MSG("Client cache mutex lock failed");
         return BAD_MUTEX_E;
     }
-    XMEMCPY(row, ClientCache, sizeof(ClientCache));
-    wc_UnLockMutex(&clisession_mutex);
+    XMEMCPY(row, ClientCache, CLIENT_CACHE_SZ);
+    wc_UnLockMutex(CLIENT_CACHE_LOCK);
 #endif
 
     WOLFSSL_LEAVE("wolfSSL_memsave_session_cache", WOLFSSL_SUCCESS);
@@ -536,12 +649,12 @@ int wolfSSL_memrestore_session_cache(const void* mem, int sz)
 #endif
 
 #ifndef NO_CLIENT_CACHE
-    if (wc_LockMutex(&clisession_mutex) != 0) {
+    if (wc_LockMutex(CLIENT_CACHE_LOCK) != 0) {
         WOLFSSL_MSG("Client cache mutex lock failed");
         return BAD_MUTEX_E;
     }
-    XMEMCPY(ClientCache, row, sizeof(ClientCache));
-    wc_UnLockMutex(&clisession_mutex);
+    XMEMCPY(ClientCache, row, CLIENT_CACHE_SZ);
+    wc_UnLockMutex(CLIENT_CACHE_LOCK);
 #endif
 
     WOLFSSL_LEAVE("wolfSSL_memrestore_session_cache", WOLFSSL_SUCCESS);
@@ -614,17 +727,17 @@ int wolfSSL_save_session_cache(const char *fname)
 
 #ifndef NO_CLIENT_CACHE
     /* client cache */
-    if (wc_LockMutex(&clisession_mutex) != 0) {
+    if (wc_LockMutex(CLIENT_CACHE_LOCK) != 0) {
         WOLFSSL_MSG("Client cache mutex lock failed");
         XFCLOSE(file);
         return BAD_MUTEX_E;
     }
-    ret = (int)XFWRITE(ClientCache, sizeof(ClientCache), 1, file);
+    ret = (int)XFWRITE(ClientCache, CLIENT_CACHE_SZ, 1, file);
     if (ret != 1) {
         WOLFSSL_MSG("Client cache member file write failed");
         rc = FWRITE_ERROR;
     }
-    wc_UnLockMutex(&clisession_mutex);
+    wc_UnLockMutex(CLIENT_CACHE_LOCK);
 #endif /* !NO_CLIENT_CACHE */
 
     XFCLOSE(file);
@@ -691,7 +804,7 @@ int wolfSSL_restore_session_cache(const char *fname)
     #endif
         if (ret != 1) {
             WOLFSSL_MSG("Session cache member file read failed");
-            XMEMSET(SessionCache, 0, sizeof SessionCache);
+            XMEMSET(SessionCache, 0, SESSION_CACHE_SZ);
             rc = FREAD_ERROR;
             break;
         }
@@ -702,18 +815,18 @@ int wolfSSL_restore_session_cache(const char *fname)
 
 #ifndef NO_CLIENT_CACHE
     /* client cache */
-    if (wc_LockMutex(&clisession_mutex) != 0) {
+    if (wc_LockMutex(CLIENT_CACHE_LOCK) != 0) {
         WOLFSSL_MSG("Client cache mutex lock failed");
         XFCLOSE(file);
         return BAD_MUTEX_E;
     }
-    ret = (int)XFREAD(ClientCache, sizeof(ClientCache), 1, file);
+    ret = (int)XFREAD(ClientCache, CLIENT_CACHE_SZ, 1, file);
     if (ret != 1) {
         WOLFSSL_MSG("Client cache member file read failed");
-        XMEMSET(ClientCache, 0, sizeof ClientCache);
+        XMEMSET(ClientCache, 0, CLIENT_CACHE_SZ);
         rc = FREAD_ERROR;
     }
-    wc_UnLockMutex(&clisession_mutex);
+    wc_UnLockMutex(CLIENT_CACHE_LOCK);
 #endif /* !NO_CLIENT_CACHE */
 
     XFCLOSE(file);
@@ -725,6 +838,179 @@ int wolfSSL_restore_session_cache(const char *fname)
 #endif /* !NO_FILESYSTEM */
 #endif /* PERSIST_SESSION_CACHE && !SESSION_CACHE_DYNAMIC_MEM */
 
+#ifdef SESSION_CACHE_SHARED_MEM
+
+/* Layout of the shared memory mapping holding the session cache. */
+typedef struct SessionCacheShm {
+#ifndef ENABLE_SESSION_CACHE_ROW_LOCK
+    wolfSSL_RwLock lock;                  /* replaces session_lock     */
+#endif
+#ifndef NO_CLIENT_CACHE
+    wolfSSL_Mutex  cliLock;               /* replaces clisession_mutex */
+    ClientRow      clients[CLIENT_SESSION_ROWS];
+#endif
+    SessionRow     rows[SESSION_ROWS];
+#ifdef WOLFSSL_SESSION_STATS
+    SessionCacheStats stats;              /* replaces SessionStatsLocal */
+#endif
+} SessionCacheShm;
+
+static WOLFSSL_GLOBAL SessionCacheShm* SessionCacheShared = NULL;
+
+/* Initialize a mutex that can be used by all processes mapping it. */
+static int SessionCacheShmInitMutex(pthread_mutex_t* m)
+{
+    int ret = 0;
+    pthread_mutexattr_t attr;
+
+    if (pthread_mutexattr_init(&attr) != 0)
+        return BAD_MUTEX_E;
+    if (pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) != 0 ||
+            pthread_mutex_init(m, &attr) != 0) {
+        ret = BAD_MUTEX_E;
+    }
+    (void)pthread_mutexattr_destroy(&attr);
+
+    return ret;
+}
+
+/* Initialize a read/write lock that can be used by all processes mapping it.
+ */
+static int SessionCacheShmInitRwLock(wolfSSL_RwLock* m)
+{
+#ifdef WOLFSSL_USE_RWLOCK
+    int ret = 0;
+    pthread_rwlockattr_t attr;
+
+    if (pthread_rwlockattr_init(&attr) != 0)
+        return BAD_MUTEX_E;
+    if (pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) != 0 ||
+            pthread_rwlock_init(m, &attr) != 0) {
+        ret = BAD_MUTEX_E;
+    }
+    (void)pthread_rwlockattr_destroy(&attr);
+
+    return ret;
+#else
+    return SessionCacheShmInitMutex(m);
+#endif
+}
+
+/* Move the session cache into shared memory.
+ *
+ * The cache is placed in an anonymous shared mapping that is inherited by
+ * child processes. Call after wolfSSL_Init() and before forking worker
+ * processes and creating any connections. Sessions already in the process
+ * local cache are not carried over.
+ *
+ * Only data held inline in WOLFSSL_SESSION is shared. Sessions with a ticket
+ * larger than SESSION_TICKET_LEN are not cached and ex_data stays with the
+ * session object of the process that set it.
+ *
+ * returns WOLFSSL_SUCCESS on success.
+ * returns MEMORY_E when mapping the memory fails.
+ * returns BAD_MUTEX_E when creating the process shared locks fails.
+ * returns BAD_STATE_E when the shared cache is already in use.
+ */
+int wolfSSL_use_shared_session_cache(void)
+{
+    SessionCacheShm* shm;
+    int ret = WOLFSSL_SUCCESS;
+    int i;
+
+    WOLFSSL_ENTER("wolfSSL_use_shared_session_cache");
+
+    if (SessionCacheShared != NULL)
+        return BAD_STATE_E;
+
+    shm = (SessionCacheShm*)mmap(NULL, sizeof(SessionCacheShm),
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shm == (SessionCacheShm*)MAP_FAILED) {
+        WOLFSSL_MSG("Session cache mmap failed");
+        return MEMORY_E;
+    }
+    /* Anonymous mappings are zero filled. Keep the size set for the process
+     * local cache. */
+    for (i = 0; i < SESSION_ROWS; i++) {
+        shm->rows[i].cap = SessionCacheLocal[i].cap;
+    }
+
+#ifdef ENABLE_SESSION_CACHE_ROW_LOCK
+    for (i = 0; (ret == WOLFSSL_SUCCESS) && (i < SESSION_ROWS); i++) {
+        if (SessionCacheShmInitRwLock(&shm->rows[i].row_lock) != 0)
+            ret = BAD_MUTEX_E;
+        else
+            shm->rows[i].lock_valid = 1;
+    }
+#else
+    if (SessionCacheShmInitRwLock(&shm->lock) != 0)
+        ret = BAD_MUTEX_E;
+#endif
+#ifndef NO_CLIENT_CACHE
+    if ((ret == WOLFSSL_SUCCESS) &&
+            (SessionCacheShmInitMutex(&shm->cliLock) != 0)) {
+        ret = BAD_MUTEX_E;
+    }
+#endif
+    if (ret != WOLFSSL_SUCCESS) {
+        WOLFSSL_MSG("Shared session cache lock init failed");
+        (void)munmap(shm, sizeof(SessionCacheShm));
+        return ret;
+    }
+
+    SessionCacheShared = shm;
+    SessionCache = shm->rows;
+#ifdef WOLFSSL_SESSION_STATS
+    SessionStats = &shm->stats;
+#endif
+#ifndef ENABLE_SESSION_CACHE_ROW_LOCK
+    session_lock_ptr = &shm->lock;
+#endif
+#ifndef NO_CLIENT_CACHE
+    ClientCache = shm->clients;
+    clisession_mutex_ptr = &shm->cliLock;
+#endif
+
+    WOLFSSL_LEAVE("wolfSSL_use_shared_session_cache", ret);
+
+    return ret;
+}
+
+/* Stop using the shared session cache in this process.
+ *
+ * The process goes back to its local session cache. The shared locks are
+ * left alone as other processes may still be using them. The memory is
+ * released when the last process unmaps it. Must not be called while other
+ * threads of the process are using the session cache.
+ *
+ * returns WOLFSSL_SUCCESS.
+ */
+int wolfSSL_release_shared_session_cache(void)
+{
+    WOLFSSL_ENTER("wolfSSL_release_shared_session_cache");
+
+    if (SessionCacheShared == NULL)
+        return WOLFSSL_SUCCESS;
+
+    SessionCache = SessionCacheLocal;
+#ifdef WOLFSSL_SESSION_STATS
+    SessionStats = &SessionStatsLocal;
+#endif
+#ifndef ENABLE_SESSION_CACHE_ROW_LOCK
+    session_lock_ptr = &session_lock;
+#endif
+#ifndef NO_CLIENT_CACHE
+    ClientCache = ClientCacheLocal;
+    clisession_mutex_ptr = &clisession_mutex;
+#endif
+    (void)munmap(SessionCacheShared, sizeof(SessionCacheShm));
+    SessionCacheShared = NULL;
+
+    return WOLFSSL_SUCCESS;
+}
+
+#endif /* SESSION_CACHE_SHARED_MEM */
+
 
 /* on by default if built in but allow user to turn off */
 WOLFSSL_ABI
@@ -969,7 +1255,7 @@ WOLFSSL_SESSION* wolfSSL_GetSessionClient(WOLFSSL* ssl, const byte* id, int len)
         return NULL;
     }
 
-    if (wc_LockMutex(&clisession_mutex) != 0) {
+    if (wc_LockMutex(CLIENT_CACHE_LOCK) != 0) {
         WOLFSSL_MSG("Client cache mutex lock failed");
         return NULL;
     }
@@ -1022,7 +1308,7 @@ WOLFSSL_SESSION* wolfSSL_GetSessionClient(WOLFSSL* ssl, const byte* id, int len)
         idx = idx > 0 ? idx - 1 : CLIENT_SESSIONS_PER_ROW - 1;
     }
 
-    wc_UnLockMutex(&clisession_mutex);
+    wc_UnLockMutex(CLIENT_CACHE_LOCK);
 
     return ret;
 }
@@ -1093,6 +1379,7 @@ static int TlsSessionCacheGetAndLock(const byte *id,
     const WOLFSSL_SESSION *s;
     word32 row;
     int count;
+    int used;
     int error;
     int idx;
 
@@ -1108,13 +1395,13 @@ static int TlsSessionCacheGetAndLock(const byte *id,
     if (error != 0)
         return FATAL_ERROR;
 
-    /* start from most recently used */
-    count = (int)min((word32)sessRow->totalCount, SESSIONS_PER_ROW);
+    /* start from most recently added */
+    used = (int)min((word32)sessRow->totalCount, SESSIONS_PER_ROW);
     idx = sessRow->nextIdx - 1;
-    if (idx < 0 || idx >= SESSIONS_PER_ROW) {
-        idx = SESSIONS_PER_ROW - 1; /* if back to front, the previous was end */
+    if (idx < 0 || idx >= used) {
+        idx = used - 1; /* if back to front, the previous was end */
     }
-    for (; count > 0; --count) {
+    for (count = used; count > 0; --count) {
 #ifdef SESSION_CACHE_DYNAMIC_MEM
         s = sessRow->Sessions[idx];
 #else
@@ -1122,15 +1409,18 @@ static int TlsSessionCacheGetAndLock(const byte *id,
 #endif
         if (s && XMEMCMP(s->sessionID, id, ID_LEN) == 0 && s->side == side) {
             *sess = s;
+            SESSION_ROW_SET_ACCESSED(sessRow, idx);
             break;
         }
-        idx = idx > 0 ? idx - 1 : SESSIONS_PER_ROW - 1;
+        idx = idx > 0 ? idx - 1 : used - 1;
     }
     if (*sess == NULL) {
         SESSION_ROW_UNLOCK(sessRow);
+        SESSION_STAT_INC(misses);
     }
     else {
         *lockedRow = row;
+        SESSION_STAT_INC(hits);
     }
 
     return 0;
@@ -1627,7 +1917,7 @@ ClientSession* AddSessionToClientCache(int side, int row, int idx,
         else {
             error = WOLFSSL_FATAL_ERROR;
         }
-        if (error == 0 && wc_LockMutex(&clisession_mutex) == 0) {
+        if (error == 0 && wc_LockMutex(CLIENT_CACHE_LOCK) == 0) {
             clientIdx = (word32)ClientCache[clientRow].nextIdx;
             if (clientIdx < CLIENT_SESSIONS_PER_ROW) {
                 ClientCache[clientRow].Clients[clientIdx].serverRow =
@@ -1660,7 +1950,7 @@ ClientSession* AddSessionToClientCache(int side, int row, int idx,
                 ClientCache[clientRow].nextIdx %= CLIENT_SESSIONS_PER_ROW;
             }
 
-            wc_UnLockMutex(&clisession_mutex);
+            wc_UnLockMutex(CLIENT_CACHE_LOCK);
         }
         else {
             WOLFSSL_MSG("Hash session or lock failed");
@@ -1695,14 +1985,14 @@ WOLFSSL_SESSION* ClientSessionToSession(const WOLFSSL_SESSION* session)
     /* Check if session points into ClientCache */
     if ((byte*)session >= (byte*)ClientCache &&
             /* Cast to byte* to make pointer arithmetic work per byte */
-            (byte*)session < ((byte*)ClientCache) + sizeof(ClientCache)) {
+            (byte*)session < ((byte*)ClientCache) + CLIENT_CACHE_SZ) {
         ClientSession* clientSession = (ClientSession*)session;
         SessionRow* sessRow = NULL;
         WOLFSSL_SESSION* cacheSession = NULL;
         word32 sessionIDHash = 0;
         int error = 0;
         session = NULL; /* Default to NULL for failure case */
-        if (wc_LockMutex(&clisession_mutex) != 0) {
+        if (wc_LockMutex(CLIENT_CACHE_LOCK) != 0) {
             WOLFSSL_MSG("Client cache mutex lock failed");
             return NULL;
         }
@@ -1756,7 +2046,7 @@ WOLFSSL_SESSION* ClientSessionToSession(const WOLFSSL_SESSION* session)
         if (sessRow != NULL) {
             SESSION_ROW_UNLOCK(sessRow);
         }
-        wc_UnLockMutex(&clisession_mutex);
+        wc_UnLockMutex(CLIENT_CACHE_LOCK);
         return (WOLFSSL_SESSION*)session;
     }
     else {
@@ -1769,6 +2059,73 @@ WOLFSSL_SESSION* ClientSessionToSession(const WOLFSSL_SESSION* session)
 #endif
 }
 
+/* Choose the slot in a write locked row for a new session.
+ *
+ * Unused slots are filled first. Once the row is at capacity an expired
+ * session is replaced, otherwise the CLOCK hand (nextIdx) sweeps the row
+ * clearing reference bits and stops at the first session that has not been
+ * looked up since the hand last passed it.
+ *
+ * sessRow  [in]  Row of the session cache.
+ * cap      [in]  Number of slots of the row in use.
+ * evict    [out] Set to 1 when a live session is being replaced.
+ * returns the index of the slot to use.
+ */
+static word32 SessionCacheRowSlot(SessionRow* sessRow, int cap, int* evict)
+{
+    WOLFSSL_SESSION* s;
+    word32 ticks = LowResTimer();
+    int idx;
+    int i;
+
+    *evict = 0;
+    if (sessRow->totalCount < cap)
+        return (word32)sessRow->totalCount;
+
+    for (idx = 0; idx < cap; idx++) {
+    #ifdef SESSION_CACHE_DYNAMIC_MEM
+        s = sessRow->Sessions[idx];
+        if (s == NULL)
+            return (word32)idx;
+    #else
+        s = &sessRow->Sessions[idx];
+    #endif
+        if (ticks >= s->bornOn + s->timeout)
+            return (word32)idx;
+    }
+
+    idx = sessRow->nextIdx;
+    if (idx < 0 || idx >= cap)
+        idx = 0;
+    /* After one full revolution every bit is clear. */
+    for (i = 0; i < cap && sessRow->accessed[idx]; i++) {
+        sessRow->accessed[idx] = 0;
+        idx = (idx + 1) % cap;
+    }
+    *evict = 1;
+    return (word32)idx;
+}
+
+/* Get the number of sessions the internal cache holds.
+ *
+ * Every row has the same capacity once wolfSSL_CTX_sess_set_cache_size()
+ * completes so the first row is representative.
+ *
+ * returns the number of sessions.
+ */
+static long SessionCacheSize(void)
+{
+    long sz = (long)SESSIONS_PER_ROW * SESSION_ROWS;
+    SessionRow* row = &SessionCache[0];
+
+    if (SESSION_ROW_RD_LOCK(row) == 0) {
+        sz = (long)SESSION_ROW_CAP(row) * SESSION_ROWS;
+        SESSION_ROW_UNLOCK(row);
+    }
+
+    return sz;
+}
+
 int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
         const byte* id, byte idSz, int* sessionIndex, int side,
         word16 useTicket, ClientSession** clientCacheEntry)
@@ -1796,6 +2153,8 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
     int ret = 0;
     int row;
     int i;
+    int cap;
+    int evict = 0;
     int overwrite = 0;
     (void)ctx;
     (void)sessionIndex;
@@ -1817,6 +2176,21 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
 
 #ifdef HAVE_SESSION_TICKET
     ticLen = addSession->ticketLen;
+#ifdef SESSION_CACHE_SHARED_MEM
+    /* Heap memory is private to the process that allocated it. */
+    if (SessionCacheShared != NULL && ticLen > SESSION_TICKET_LEN) {
+        WOLFSSL_MSG("Ticket too big for shared session cache");
+        return BUFFER_E;
+    }
+#if defined(WOLFSSL_TLS13) && defined(WOLFSSL_TICKET_NONCE_MALLOC) &&          \
+    (!defined(HAVE_FIPS) || (defined(FIPS_VERSION_GE) && FIPS_VERSION_GE(5,3)))
+    if (SessionCacheShared != NULL &&
+            addSession->ticketNonce.data != addSession->ticketNonce.dataStatic) {
+        WOLFSSL_MSG("Ticket nonce too big for shared session cache");
+        return BUFFER_E;
+    }
+#endif
+#endif
     /* Alloc Memory here to avoid syscalls during lock */
     if (ticLen > SESSION_TICKET_LEN) {
         ticBuff = (byte*)XMALLOC(ticLen, NULL,
@@ -1886,8 +2260,9 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
         }
     }
 
+    cap = SESSION_ROW_CAP(sessRow);
     if (!overwrite)
-        idx = (word32)sessRow->nextIdx;
+        idx = SessionCacheRowSlot(sessRow, cap, &evict);
 #ifdef SESSION_INDEX
     if (sessionIndex != NULL)
         *sessionIndex = (row << SESSIDX_ROW_SHIFT) | idx;
@@ -1917,6 +2292,15 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
 #endif
 
 #ifdef HAVE_EX_DATA
+#ifdef SESSION_CACHE_SHARED_MEM
+    if (SessionCacheShared != NULL) {
+        /* ex_data points into the heap of the process that set it. The
+         * session object passed in keeps it. */
+        XMEMSET(&cacheSession->ex_data, 0, sizeof(WOLFSSL_CRYPTO_EX_DATA));
+        cacheSession->ownExData = 0;
+    }
+    else
+#endif
     if (overwrite) {
         /* Figure out who owns the ex_data */
         if (cacheSession->ownExData) {
@@ -2005,10 +2389,13 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
 
     if (ret == 0) {
         if (!overwrite) {
-            /* Increment the totalCount and the nextIdx */
-            if (sessRow->totalCount < SESSIONS_PER_ROW)
+            /* Slots in use are kept contiguous from the start of the row */
+            if ((int)idx == sessRow->totalCount)
                 sessRow->totalCount++;
-            sessRow->nextIdx = (sessRow->nextIdx + 1) % SESSIONS_PER_ROW;
+            sessRow->accessed[idx] = 0;
+            sessRow->nextIdx = (int)((idx + 1) % (word32)cap);
+            if (evict)
+                SESSION_STAT_INC(evictions);
         }
         if (id != addSession->sessionID) {
             /* ssl->session->sessionID may contain the bogus ID or we want the
@@ -2021,9 +2408,18 @@ int AddSessionToCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* addSession,
             cacheSession->rem_sess_cb = ctx->rem_sess_cb;
 #endif
 #ifdef HAVE_EX_DATA
-        /* The session in cache now owns the ex_data */
-        addSession->ownExData = 0;
-        cacheSession->ownExData = 1;
+    #ifdef SESSION_CACHE_SHARED_MEM
+        if (SessionCacheShared != NULL) {
+            XMEMSET(&cacheSession->ex_data, 0,
+                    sizeof(WOLFSSL_CRYPTO_EX_DATA));
+        }
+        else
+    #endif
+        {
+            /* The session in cache now owns the ex_data */
+            addSession->ownExData = 0;
+            cacheSession->ownExData = 1;
+        }
 #endif
 #if defined(HAVE_SESSION_TICKET) && defined(WOLFSSL_TLS13) &&                  \
     defined(WOLFSSL_TICKET_NONCE_MALLOC) &&                                    \
@@ -2167,8 +2563,8 @@ void AddSession(WOLFSSL* ssl)
         if (error == WOLFSSL_SUCCESS) {
             error = 0;  /* back to this function ok */
 
-            if (PeakSessions < active) {
-                PeakSessions = active;
+            if (SessionStats->peak < active) {
+                SessionStats->peak = active;
             }
         }
     }
@@ -2286,6 +2682,7 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
     int result = WOLFSSL_SUCCESS;
     int i;
     int count;
+    int used;
     int idx;
     word32 now   = 0;
     word32 seen  = 0;
@@ -2308,14 +2705,17 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
         seen += row->totalCount;
 
         if (active == NULL) {
+        #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
             SESSION_ROW_UNLOCK(row);
+        #endif
             continue;
         }
 
-        count = min((word32)row->totalCount, SESSIONS_PER_ROW);
+        used  = (int)min((word32)row->totalCount, SESSIONS_PER_ROW);
+        count = used;
         idx   = row->nextIdx - 1;
-        if (idx < 0 || idx >= SESSIONS_PER_ROW) {
-            idx = SESSIONS_PER_ROW - 1; /* if back to front previous was end */
+        if (idx < 0 || idx >= used) {
+            idx = used - 1; /* if back to front previous was end */
         }
 
         for (; count > 0; --count) {
@@ -2332,7 +2732,7 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
                 now++;
             }
 
-            idx = idx > 0 ? idx - 1 : SESSIONS_PER_ROW - 1;
+            idx = idx > 0 ? idx - 1 : used - 1;
         }
 
     #ifdef ENABLE_SESSION_CACHE_ROW_LOCK
@@ -2352,7 +2752,7 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
 
 #ifdef WOLFSSL_PEAK_SESSIONS
     if (peak) {
-        *peak = PeakSessions;
+        *peak = SessionStats->peak;
     }
 #else
     (void)peak;
@@ -2373,7 +2773,7 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
     WOLFSSL_ENTER("wolfSSL_get_session_stats");
 
     if (maxSessions) {
-        *maxSessions = SESSIONS_PER_ROW * SESSION_ROWS;
+        *maxSessions = (word32)SessionCacheSize();
 
         if (active == NULL && total == NULL && peak == NULL)
             return result;  /* we're done */
@@ -2391,6 +2791,28 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
     return result;
 }
 
+/* Get the lookup and eviction counters of the internal session cache.
+ *
+ * hits       [out] Lookups that found the session. May be NULL.
+ * misses     [out] Lookups that did not find the session. May be NULL.
+ * evictions  [out] Live sessions replaced to make room. May be NULL.
+ * returns WOLFSSL_SUCCESS.
+ */
+int wolfSSL_get_session_cache_stats(word32* hits, word32* misses,
+                                    word32* evictions)
+{
+    WOLFSSL_ENTER("wolfSSL_get_session_cache_stats");
+
+    if (hits != NULL)
+        *hits = (word32)SessionStats->hits;
+    if (misses != NULL)
+        *misses = (word32)SessionStats->misses;
+    if (evictions != NULL)
+        *evictions = (word32)SessionStats->evictions;
+
+    return WOLFSSL_SUCCESS;
+}
+
 #endif /* WOLFSSL_SESSION_STATS */
 
 
@@ -2418,6 +2840,13 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
         printf("Peak  Sessions      = %u\n", peak);
 #endif
         printf("Max   Sessions      = %u\n", maxSessions);
+        {
+            word32 hits = 0, misses = 0, evictions = 0;
+            (void)wolfSSL_get_session_cache_stats(&hits, &misses, &evictions);
+            printf("Cache Hits          = %u\n", hits);
+            printf("Cache Misses        = %u\n", misses);
+            printf("Cache Evictions     = %u\n", evictions);
+        }
 
         E = (double)totalSessionsSeen / SESSION_ROWS;
 
@@ -2468,34 +2897,86 @@ WOLFSSL_SESSION* wolfSSL_GetSession(WOLFSSL* ssl, byte* masterSecret,
 
 #endif /* NO_SESSION_CACHE */
 
-#ifdef OPENSSL_EXTRA
+#ifndef NO_SESSION_CACHE
+/* Set the number of sessions the internal cache holds.
+ *
+ * The cache is shared by all contexts so this applies to every WOLFSSL_CTX.
+ * ctx is not used and may be NULL.
+ * The size is rounded up to a whole number of slots per row and limited to
+ * the compile time maximum. Sessions in slots no longer used are evicted.
+ *
+ * ctx  [in]  SSL/TLS context object.
+ * sz   [in]  Number of sessions to cache.
+ * returns the previous cache size.
+ */
+long wolfSSL_CTX_sess_set_cache_size(WOLFSSL_CTX* ctx, long sz)
+{
+    long prev = SessionCacheSize();
+    int cap;
+    int i;
+    int j;
 
-   /* returns previous set cache size which stays constant */
-    long wolfSSL_CTX_sess_set_cache_size(WOLFSSL_CTX* ctx, long sz)
-    {
-        /* cache size fixed at compile time in wolfSSL */
-        (void)ctx;
-        (void)sz;
-        WOLFSSL_MSG("session cache is set at compile time");
-        #ifndef NO_SESSION_CACHE
-            return (long)(SESSIONS_PER_ROW * SESSION_ROWS);
-        #else
-            return 0;
-        #endif
-    }
+    WOLFSSL_ENTER("wolfSSL_CTX_sess_set_cache_size");
+    (void)ctx;
 
+    if (sz <= 0)
+        return prev;
 
-    long wolfSSL_CTX_sess_get_cache_size(WOLFSSL_CTX* ctx)
-    {
-        (void)ctx;
-        #ifndef NO_SESSION_CACHE
-            return (long)(SESSIONS_PER_ROW * SESSION_ROWS);
-        #else
-            return 0;
-        #endif
+    if (sz >= (long)SESSIONS_PER_ROW * SESSION_ROWS)
+        cap = SESSIONS_PER_ROW;
+    else
+        cap = (int)((sz + SESSION_ROWS - 1) / SESSION_ROWS);
+
+    for (i = 0; i < SESSION_ROWS; i++) {
+        SessionRow* row = &SessionCache[i];
+
+        if (SESSION_ROW_WR_LOCK(row) != 0) {
+            WOLFSSL_MSG("Session row cache mutex lock failed");
+            break;
+        }
+        for (j = cap; j < row->totalCount && j < SESSIONS_PER_ROW; j++) {
+    #ifdef SESSION_CACHE_DYNAMIC_MEM
+            WOLFSSL_SESSION* s = row->Sessions[j];
+            if (s != NULL) {
+                EvictSessionFromCache(s);
+                XFREE(s, s->heap, DYNAMIC_TYPE_SESSION);
+                row->Sessions[j] = NULL;
+            }
+    #else
+            EvictSessionFromCache(&row->Sessions[j]);
+    #endif
+            row->accessed[j] = 0;
+        }
+        if (row->totalCount > cap)
+            row->totalCount = cap;
+        if (row->nextIdx >= cap)
+            row->nextIdx = 0;
+        row->cap = cap;
+        SESSION_ROW_UNLOCK(row);
     }
 
-#endif
+    return prev;
+}
+
+long wolfSSL_CTX_sess_get_cache_size(WOLFSSL_CTX* ctx)
+{
+    (void)ctx;
+    return SessionCacheSize();
+}
+#else
+long wolfSSL_CTX_sess_set_cache_size(WOLFSSL_CTX* ctx, long sz)
+{
+    (void)ctx;
+    (void)sz;
+    return 0;
+}
+
+long wolfSSL_CTX_sess_get_cache_size(WOLFSSL_CTX* ctx)
+{
+    (void)ctx;
+    return 0;
+}
+#endif /* !NO_SESSION_CACHE */
 
 #ifndef NO_SESSION_CACHE
 int wolfSSL_CTX_add_session(WOLFSSL_CTX* ctx, WOLFSSL_SESSION* session)
@@ -63,6 +63,10 @@
 
 #include <wolfssl/wolfcrypt/hpke.h>
 
+#if defined(WOLFSSL_CERT_COMPRESSION) && defined(HAVE_LIBZ)
+    #include <wolfssl/wolfcrypt/compress.h>
+#endif
+
 #ifndef NO_TLS
 
 #if defined(WOLFSSL_TLS13) && defined(HAVE_SUPPORTED_CURVES)
@@ -3450,6 +3454,23 @@ static int TLSX_CSR_Parse(WOLFSSL* ssl, const byte* input, word16 length,
 
     #if defined(WOLFSSL_TLS13)
         if (ssl->options.tls1_3) {
+        #ifdef WOLFSSL_OCSP_STAPLE_CACHE
+            extension = TLSX_Find(ssl->extensions, TLSX_STATUS_REQUEST);
+            csr = extension ?
+                (CertificateStatusRequest*)extension->data : NULL;
+            if (csr == NULL)
+                return MEMORY_ERROR;
+
+            /* Response is ready - no parsing or fetching. */
+            ret = CopyOcspStaple(ssl, &csr->response);
+            if (ret < 0)
+                return ret;
+            if (ret == 1) {
+                TLSX_SetResponse(ssl, TLSX_STATUS_REQUEST);
+                ssl->status_request = status_type;
+                return 0;
+            }
+        #endif
             if (ssl->buffers.certificate == NULL) {
                 WOLFSSL_MSG("Certificate buffer not set!");
                 return BUFFER_ERROR;
@@ -8008,12 +8029,13 @@ static int TLSX_KeyShare_GenPqcKey(WOLFSSL *ssl, KeyShareEntry* kse)
 }
 #endif /* WOLFSSL_HAVE_KYBER */
 
-/* Generate a secret/key using the key share entry.
+/* Generate a key pair for the group of the key share entry.
  *
  * ssl  The SSL/TLS object.
- * kse  The key share entry holding peer data.
+ * kse  The key share entry object.
+ * returns 0 on success, otherwise failure.
  */
-int TLSX_KeyShare_GenKey(WOLFSSL *ssl, KeyShareEntry *kse)
+static int TLSX_KeyShare_MakeKey(WOLFSSL *ssl, KeyShareEntry *kse)
 {
     int ret;
     /* Named FFDHE groups have a bit set to identify them. */
@@ -8029,6 +8051,321 @@ int TLSX_KeyShare_GenKey(WOLFSSL *ssl, KeyShareEntry *kse)
 #endif
     else
         ret = TLSX_KeyShare_GenEccKey(ssl, kse);
+    return ret;
+}
+
+#ifdef WOLFSSL_KEY_SHARE_POOL
+/* Find the pool of key shares for a named group.
+ *
+ * pool   The key share pool. Lock must be held.
+ * group  The named group.
+ * returns the group's pool or NULL when group not configured.
+ */
+static KeySharePoolGroup* TLSX_KeySharePool_Find(KeySharePool* pool,
+    word16 group)
+{
+    byte i;
+
+    for (i = 0; i < pool->numGroups; i++) {
+        if (pool->groups[i].group == group)
+            return &pool->groups[i];
+    }
+    return NULL;
+}
+
+/* Move a pregenerated key pair from the CTX's pool into the key share entry.
+ * The key pair is single-use and removed from the pool.
+ *
+ * ssl  The SSL/TLS object.
+ * kse  The key share entry object. No key pair generated yet.
+ * returns 1 when a key pair was taken, 0 when one must be generated.
+ */
+static int TLSX_KeySharePool_Take(WOLFSSL *ssl, KeyShareEntry *kse)
+{
+    KeySharePool* pool;
+    KeySharePoolGroup* pg;
+    KeyShareEntry* ready = NULL;
+
+    if (ssl->ctx == NULL || ssl->ctx->keySharePool == NULL)
+        return 0;
+    if (kse->key != NULL || kse->pubKey != NULL)
+        return 0;
+    pool = ssl->ctx->keySharePool;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return 0;
+    pg = TLSX_KeySharePool_Find(pool, kse->group);
+    if (pg != NULL) {
+        ready = pg->list;
+        if (ready != NULL) {
+            pg->list = ready->next;
+            pg->count--;
+            pool->hits++;
+        }
+        else {
+            pool->misses++;
+        }
+    }
+    wc_UnLockMutex(&pool->lock);
+
+    if (ready == NULL)
+        return 0;
+
+    kse->key = ready->key;
+    kse->keyLen = ready->keyLen;
+    kse->pubKey = ready->pubKey;
+    kse->pubKeyLen = ready->pubKeyLen;
+#if !defined(NO_DH) || defined(HAVE_FALCON) || defined(HAVE_DILITHIUM)
+    kse->privKey = ready->privKey;
+    kse->privKeyLen = ready->privKeyLen;
+#endif
+    XFREE(ready, ssl->ctx->heap, DYNAMIC_TYPE_TLSX);
+
+#ifdef HAVE_ECC
+    /* Set the curve as EccMakeKey does - ECC and hybrid groups only. */
+    if (kse->key != NULL && !WOLFSSL_NAMED_GROUP_IS_FFHDE(kse->group) &&
+            kse->group != WOLFSSL_ECC_X25519 &&
+            kse->group != WOLFSSL_ECC_X448 &&
+            ((ecc_key*)kse->key)->dp != NULL) {
+        ssl->ecdhCurveOID = ((ecc_key*)kse->key)->dp->oidSum;
+        ssl->namedGroup = 0;
+    }
+#endif
+
+    return 1;
+}
+
+/* Free the pool of pregenerated key shares of the CTX.
+ *
+ * ctx  The SSL/TLS CTX object.
+ */
+void TLSX_KeySharePool_Free(WOLFSSL_CTX* ctx)
+{
+    KeySharePool* pool = ctx->keySharePool;
+    byte i;
+
+    if (pool == NULL)
+        return;
+
+    for (i = 0; i < pool->numGroups; i++)
+        TLSX_KeyShare_FreeAll(pool->groups[i].list, ctx->heap);
+    wc_FreeMutex(&pool->lock);
+    XFREE(pool, ctx->heap, DYNAMIC_TYPE_TLSX);
+    ctx->keySharePool = NULL;
+}
+
+/* Set the number of key shares of a named group to keep pregenerated.
+ * Key shares are generated by wolfSSL_CTX_KeySharePool_Fill().
+ *
+ * ctx    The SSL/TLS CTX object.
+ * group  The named group.
+ * depth  Number of key shares to keep. 0 stops pooling the group.
+ * returns WOLFSSL_SUCCESS on success, BAD_FUNC_ARG when a parameter is invalid
+ * or too many groups, MEMORY_E on dynamic memory allocation failure and
+ * BAD_MUTEX_E when the lock can't be taken.
+ */
+int wolfSSL_CTX_KeySharePool_Set(WOLFSSL_CTX* ctx, word16 group, word16 depth)
+{
+    int ret = WOLFSSL_SUCCESS;
+    KeySharePool* pool;
+    KeySharePoolGroup* pg;
+    KeyShareEntry* list = NULL;
+    KeyShareEntry** next;
+    word16 cnt;
+
+    if (ctx == NULL || !TLSX_KeyShare_IsSupported(group))
+        return BAD_FUNC_ARG;
+
+    if (ctx->keySharePool == NULL) {
+        if (depth == 0)
+            return WOLFSSL_SUCCESS;
+        pool = (KeySharePool*)XMALLOC(sizeof(KeySharePool), ctx->heap,
+            DYNAMIC_TYPE_TLSX);
+        if (pool == NULL)
+            return MEMORY_E;
+        XMEMSET(pool, 0, sizeof(KeySharePool));
+        if (wc_InitMutex(&pool->lock) != 0) {
+            XFREE(pool, ctx->heap, DYNAMIC_TYPE_TLSX);
+            return BAD_MUTEX_E;
+        }
+        ctx->keySharePool = pool;
+    }
+    pool = ctx->keySharePool;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+
+    pg = TLSX_KeySharePool_Find(pool, group);
+    if (pg == NULL && depth > 0) {
+        if (pool->numGroups == WOLFSSL_MAX_GROUP_COUNT)
+            ret = BAD_FUNC_ARG;
+        else {
+            pg = &pool->groups[pool->numGroups++];
+            pg->group = group;
+        }
+    }
+    if (pg != NULL) {
+        pg->depth = depth;
+        /* Detach key shares beyond new depth to free outside the lock. */
+        next = &pg->list;
+        for (cnt = 0; cnt < depth && *next != NULL; cnt++)
+            next = &(*next)->next;
+        list = *next;
+        *next = NULL;
+        pg->count = cnt;
+        if (depth == 0) {
+            pool->numGroups--;
+            XMEMMOVE(pg, pg + 1, (size_t)((pool->groups + pool->numGroups) -
+                pg) * sizeof(KeySharePoolGroup));
+        }
+    }
+
+    wc_UnLockMutex(&pool->lock);
+
+    TLSX_KeyShare_FreeAll(list, ctx->heap);
+
+    return ret;
+}
+
+/* Generate key shares for the pools of the CTX that are below their depth.
+ * Intended to be called from a background thread or when the application is
+ * idle. Groups are refilled in turn so that all are kept topped up.
+ * A temporary SSL object supplies the RNG and callbacks of the CTX.
+ *
+ * ctx      The SSL/TLS CTX object.
+ * maxKeys  Maximum number of key shares to generate. 0 means until full.
+ * returns the number of key shares generated on success, BAD_FUNC_ARG when
+ * ctx is NULL, otherwise failure.
+ */
+int wolfSSL_CTX_KeySharePool_Fill(WOLFSSL_CTX* ctx, word32 maxKeys)
+{
+    int ret = 0;
+    word32 generated = 0;
+    KeySharePool* pool;
+    KeySharePoolGroup* pg;
+    KeyShareEntry* kse;
+    WOLFSSL* ssl;
+    word16 need[WOLFSSL_MAX_GROUP_COUNT];
+    byte numNeed;
+    byte i;
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+    pool = ctx->keySharePool;
+    if (pool == NULL)
+        return 0;
+
+    ssl = wolfSSL_new(ctx);
+    if (ssl == NULL)
+        return MEMORY_E;
+
+    do {
+        /* Find the groups still below depth. */
+        if (wc_LockMutex(&pool->lock) != 0) {
+            ret = BAD_MUTEX_E;
+            break;
+        }
+        numNeed = 0;
+        for (i = 0; i < pool->numGroups; i++) {
+            if (pool->groups[i].count < pool->groups[i].depth)
+                need[numNeed++] = pool->groups[i].group;
+        }
+        wc_UnLockMutex(&pool->lock);
+
+        for (i = 0; i < numNeed; i++) {
+            if (maxKeys != 0 && generated == maxKeys)
+                break;
+
+            kse = (KeyShareEntry*)XMALLOC(sizeof(KeyShareEntry), ctx->heap,
+                DYNAMIC_TYPE_TLSX);
+            if (kse == NULL) {
+                ret = MEMORY_E;
+                break;
+            }
+            XMEMSET(kse, 0, sizeof(KeyShareEntry));
+            kse->group = need[i];
+            ret = TLSX_KeyShare_MakeKey(ssl, kse);
+            if (ret != 0) {
+                TLSX_KeyShare_FreeAll(kse, ctx->heap);
+                break;
+            }
+            generated++;
+
+            if (wc_LockMutex(&pool->lock) != 0) {
+                TLSX_KeyShare_FreeAll(kse, ctx->heap);
+                ret = BAD_MUTEX_E;
+                break;
+            }
+            pool->generated++;
+            /* Group may have been changed while generating. */
+            pg = TLSX_KeySharePool_Find(pool, kse->group);
+            if (pg != NULL && pg->count < pg->depth) {
+                kse->next = pg->list;
+                pg->list = kse;
+                pg->count++;
+                kse = NULL;
+            }
+            wc_UnLockMutex(&pool->lock);
+            TLSX_KeyShare_FreeAll(kse, ctx->heap);
+        }
+    } while (ret == 0 && numNeed > 0 &&
+             (maxKeys == 0 || generated < maxKeys));
+
+    wolfSSL_free(ssl);
+
+    if (ret == 0)
+        ret = (int)generated;
+    return ret;
+}
+
+/* Get the statistics of the pool of pregenerated key shares.
+ *
+ * ctx    The SSL/TLS CTX object.
+ * stats  The statistics filled in.
+ * returns WOLFSSL_SUCCESS on success, BAD_FUNC_ARG when a parameter is NULL
+ * and BAD_MUTEX_E when the lock can't be taken.
+ */
+int wolfSSL_CTX_KeySharePool_GetStats(WOLFSSL_CTX* ctx,
+    WOLFSSL_KEY_SHARE_POOL_STATS* stats)
+{
+    KeySharePool* pool;
+    byte i;
+
+    if (ctx == NULL || stats == NULL)
+        return BAD_FUNC_ARG;
+
+    XMEMSET(stats, 0, sizeof(*stats));
+    pool = ctx->keySharePool;
+    if (pool == NULL)
+        return WOLFSSL_SUCCESS;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+    for (i = 0; i < pool->numGroups; i++)
+        stats->ready += pool->groups[i].count;
+    stats->hits = pool->hits;
+    stats->misses = pool->misses;
+    stats->generated = pool->generated;
+    wc_UnLockMutex(&pool->lock);
+
+    return WOLFSSL_SUCCESS;
+}
+#endif /* WOLFSSL_KEY_SHARE_POOL */
+
+/* Generate a secret/key using the key share entry.
+ *
+ * ssl  The SSL/TLS object.
+ * kse  The key share entry holding peer data.
+ */
+int TLSX_KeyShare_GenKey(WOLFSSL *ssl, KeyShareEntry *kse)
+{
+    int ret;
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    if (TLSX_KeySharePool_Take(ssl, kse))
+        ret = 0;
+    else
+#endif
+        ret = TLSX_KeyShare_MakeKey(ssl, kse);
 #ifdef WOLFSSL_ASYNC_CRYPT
     kse->lastRet = ret;
 #endif
@@ -9177,8 +9514,14 @@ static int server_generate_pqc_ciphertext(WOLFSSL* ssl,
 
     if (ret == 0 && ecc_group != 0) {
         ecc_kse->group = ecc_group;
-        ret = TLSX_KeyShare_GenEccKey(ssl, ecc_kse);
-        /* No message, TLSX_KeyShare_GenEccKey() will do it. */
+    #ifdef WOLFSSL_KEY_SHARE_POOL
+        /* Use a pregenerated key of the ECC group when available. */
+        if (!TLSX_KeySharePool_Take(ssl, ecc_kse))
+    #endif
+        {
+            ret = TLSX_KeyShare_GenEccKey(ssl, ecc_kse);
+            /* No message, TLSX_KeyShare_GenEccKey() will do it. */
+        }
     }
 
     if (ret == 0) {
@@ -10873,6 +11216,421 @@ static int TLSX_PostHandAuth_Use(WOLFSSL* ssl)
 
 #endif
 
+/******************************************************************************/
+/* Certificate Compression - RFC 8879                                         */
+/******************************************************************************/
+
+#ifdef WOLFSSL_CERT_COMPRESSION
+#ifdef HAVE_LIBZ
+/* Built-in zlib compression of the Certificate message. */
+static int TLSX_CertComp_ZlibCompress(WOLFSSL* ssl, const byte* in,
+                                      word32 inSz, byte* out, word32 outSz)
+{
+    (void)ssl;
+    return wc_Compress(out, outSz, in, inSz, 0);
+}
+
+/* Built-in zlib decompression of the Certificate message. */
+static int TLSX_CertComp_ZlibDecompress(WOLFSSL* ssl, const byte* in,
+                                        word32 inSz, byte* out, word32 outSz)
+{
+    (void)ssl;
+    return wc_DeCompress(out, outSz, in, inSz);
+}
+#endif
+
+/* Get the certificate compression configuration of the SSL's context.
+ *
+ * ssl  The SSL/TLS object.
+ * returns the configuration or NULL when none set.
+ */
+static CertComp* TLSX_CertComp_Get(const WOLFSSL* ssl)
+{
+    TLSX* extension;
+
+    if (ssl->ctx == NULL)
+        return NULL;
+    extension = TLSX_Find(ssl->ctx->extensions, TLSX_COMPRESS_CERTIFICATE);
+    if (extension == NULL)
+        return NULL;
+    return (CertComp*)extension->data;
+}
+
+/* Free the certificate compression configuration and cached chains.
+ *
+ * certComp  The compress_certificate extension data.
+ * heap      The heap used for allocation.
+ */
+static void TLSX_CertComp_Free(CertComp* certComp, void* heap)
+{
+    int i;
+
+    if (certComp == NULL)
+        return;
+
+    for (i = 0; i < certComp->cnt; i++) {
+        XFREE(certComp->algs[i].msg, heap, DYNAMIC_TYPE_CERT);
+        XFREE(certComp->algs[i].comp, heap, DYNAMIC_TYPE_CERT);
+    }
+    wc_FreeMutex(&certComp->lock);
+    XFREE(certComp, heap, DYNAMIC_TYPE_TLSX);
+    (void)heap;
+}
+
+/* Whether the client offers to decompress a compressed certificate.
+ * Compressed certificates are not supported with DTLS.
+ *
+ * ssl  The SSL/TLS object.
+ * returns 1 when at least one decompression algorithm is offered, else 0.
+ */
+int TLSX_CertComp_Offered(const WOLFSSL* ssl)
+{
+    CertComp* certComp = TLSX_CertComp_Get(ssl);
+    int       i;
+
+    if (certComp == NULL || ssl->options.dtls)
+        return 0;
+
+    for (i = 0; i < certComp->cnt; i++) {
+        if (certComp->algs[i].decompress != NULL)
+            return 1;
+    }
+    return 0;
+}
+
+/* Get the size of the encoded compress_certificate extension.
+ * Only in ClientHello.
+ *
+ * certComp  The compress_certificate extension data.
+ * msgType   The type of the message this extension is being written into.
+ * pSz       The size of the extension data is added to this.
+ * returns 0 on success, otherwise failure.
+ */
+static int TLSX_CertComp_GetSize(const CertComp* certComp, byte msgType,
+                                 word16* pSz)
+{
+    int i;
+
+    if (msgType != client_hello) {
+        WOLFSSL_ERROR_VERBOSE(SANITY_MSG_E);
+        return SANITY_MSG_E;
+    }
+
+    *pSz += OPAQUE8_LEN;
+    for (i = 0; i < certComp->cnt; i++) {
+        if (certComp->algs[i].decompress != NULL)
+            *pSz += OPAQUE16_LEN;
+    }
+
+    return 0;
+}
+
+/* Writes the compress_certificate extension into the output buffer.
+ * Lists the algorithms a compressed certificate can be decompressed with.
+ * Only in ClientHello.
+ *
+ * certComp  The compress_certificate extension data.
+ * output    The buffer to write into.
+ * msgType   The type of the message this extension is being written into.
+ * pSz       The number of bytes written is added to this.
+ * returns 0 on success, otherwise failure.
+ */
+static int TLSX_CertComp_Write(const CertComp* certComp, byte* output,
+                               byte msgType, word16* pSz)
+{
+    word16 idx = OPAQUE8_LEN;
+    int    i;
+
+    if (msgType != client_hello) {
+        WOLFSSL_ERROR_VERBOSE(SANITY_MSG_E);
+        return SANITY_MSG_E;
+    }
+
+    for (i = 0; i < certComp->cnt; i++) {
+        if (certComp->algs[i].decompress != NULL) {
+            c16toa(certComp->algs[i].alg, output + idx);
+            idx += OPAQUE16_LEN;
+        }
+    }
+    output[0] = (byte)(idx - OPAQUE8_LEN);
+
+    *pSz += idx;
+    return 0;
+}
+
+/* Parse the compress_certificate extension.
+ * In ClientHello, the server picks the first algorithm in its preference
+ * order that it can compress with and the client can decompress. Client
+ * certificates are not compressed so the extension is ignored in
+ * CertificateRequest.
+ *
+ * ssl      The SSL/TLS object.
+ * input    The extension data.
+ * length   The length of the extension data.
+ * msgType  The type of the message this extension is being parsed from.
+ * returns 0 on success and other values indicate failure.
+ */
+static int TLSX_CertComp_Parse(WOLFSSL* ssl, const byte* input, word16 length,
+                               byte msgType)
+{
+    CertComp* certComp;
+    word16    alg;
+    word16    idx;
+    int       i;
+
+    if (msgType != client_hello)
+        return 0;
+
+    if (length < OPAQUE8_LEN + OPAQUE16_LEN ||
+            input[0] != length - OPAQUE8_LEN ||
+            (input[0] % OPAQUE16_LEN) != 0) {
+        return BUFFER_ERROR;
+    }
+
+    ssl->certCompAlg = 0;
+    certComp = TLSX_CertComp_Get(ssl);
+    if (certComp == NULL || ssl->options.dtls)
+        return 0;
+
+    for (i = 0; i < certComp->cnt && ssl->certCompAlg == 0; i++) {
+        if (certComp->algs[i].compress == NULL)
+            continue;
+        for (idx = OPAQUE8_LEN; idx < length; idx += OPAQUE16_LEN) {
+            ato16(input + idx, &alg);
+            if (alg == certComp->algs[i].alg) {
+                ssl->certCompAlg = alg;
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Compress the body of a Certificate message with the negotiated algorithm.
+ * The last compressed chain is cached on the context for each algorithm and
+ * is reused while the Certificate message body is unchanged.
+ *
+ * ssl      The SSL/TLS object.
+ * msg      The Certificate message body.
+ * msgSz    The length of the Certificate message body.
+ * reserve  Number of bytes to leave free before the compressed data.
+ * out      On success, the allocated buffer holding the compressed data after
+ *          reserve bytes. Caller frees with DYNAMIC_TYPE_TMP_BUFFER.
+ * outSz    On success, the length of the compressed data.
+ * returns 0 on success, otherwise failure.
+ */
+int TLSX_CertComp_Compress(WOLFSSL* ssl, const byte* msg, word32 msgSz,
+                           word32 reserve, byte** out, word32* outSz)
+{
+    int          ret = 0;
+    CertComp*    certComp = TLSX_CertComp_Get(ssl);
+    CertCompAlg* compAlg = NULL;
+    byte*        buf;
+    word32       bufSz;
+    byte*        msgCopy;
+    byte*        compCopy;
+    int          i;
+
+    if (certComp == NULL)
+        return BAD_STATE_E;
+    for (i = 0; i < certComp->cnt; i++) {
+        if (certComp->algs[i].alg == ssl->certCompAlg &&
+                certComp->algs[i].compress != NULL) {
+            compAlg = &certComp->algs[i];
+            break;
+        }
+    }
+    if (compAlg == NULL)
+        return BAD_STATE_E;
+
+    if (wc_LockMutex(&certComp->lock) != 0)
+        return BAD_MUTEX_E;
+    if (compAlg->msg != NULL && compAlg->msgSz == msgSz &&
+            XMEMCMP(compAlg->msg, msg, msgSz) == 0) {
+        buf = (byte*)XMALLOC(reserve + compAlg->compSz, ssl->heap,
+                             DYNAMIC_TYPE_TMP_BUFFER);
+        if (buf == NULL)
+            ret = MEMORY_E;
+        else {
+            XMEMCPY(buf + reserve, compAlg->comp, compAlg->compSz);
+            *out = buf;
+            *outSz = compAlg->compSz;
+        }
+        wc_UnLockMutex(&certComp->lock);
+        return ret;
+    }
+    wc_UnLockMutex(&certComp->lock);
+
+    /* Not cached - compress without holding the lock. Allow for data that
+     * doesn't compress. */
+    bufSz = msgSz + msgSz / 8 + 64;
+    buf = (byte*)XMALLOC(reserve + bufSz, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (buf == NULL)
+        return MEMORY_E;
+    ret = compAlg->compress(ssl, msg, msgSz, buf + reserve, bufSz);
+    if (ret <= 0 || (word32)ret > bufSz) {
+        WOLFSSL_MSG("Certificate compression failed");
+        XFREE(buf, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        return (ret < 0) ? ret : COMPRESS_E;
+    }
+    *out = buf;
+    *outSz = (word32)ret;
+
+    /* Cache the compressed chain for the next handshake. Failing to cache is
+     * not an error. */
+    msgCopy = (byte*)XMALLOC(msgSz, ssl->ctx->heap, DYNAMIC_TYPE_CERT);
+    compCopy = (byte*)XMALLOC(*outSz, ssl->ctx->heap, DYNAMIC_TYPE_CERT);
+    if (msgCopy != NULL && compCopy != NULL &&
+            wc_LockMutex(&certComp->lock) == 0) {
+        XMEMCPY(msgCopy, msg, msgSz);
+        XMEMCPY(compCopy, buf + reserve, *outSz);
+        XFREE(compAlg->msg, ssl->ctx->heap, DYNAMIC_TYPE_CERT);
+        XFREE(compAlg->comp, ssl->ctx->heap, DYNAMIC_TYPE_CERT);
+        compAlg->msg = msgCopy;
+        compAlg->msgSz = msgSz;
+        compAlg->comp = compCopy;
+        compAlg->compSz = *outSz;
+        wc_UnLockMutex(&certComp->lock);
+        msgCopy = NULL;
+        compCopy = NULL;
+    }
+    XFREE(msgCopy, ssl->ctx->heap, DYNAMIC_TYPE_CERT);
+    XFREE(compCopy, ssl->ctx->heap, DYNAMIC_TYPE_CERT);
+
+    return 0;
+}
+
+/* Decompress the Certificate message of a CompressedCertificate message.
+ *
+ * ssl    The SSL/TLS object.
+ * alg    The algorithm the peer compressed with.
+ * in     The compressed data.
+ * inSz   The length of the compressed data.
+ * out    The buffer to hold the Certificate message body.
+ * outSz  The expected length of the Certificate message body.
+ * returns the number of bytes decompressed, otherwise negative on failure.
+ */
+int TLSX_CertComp_Decompress(WOLFSSL* ssl, word16 alg, const byte* in,
+                             word32 inSz, byte* out, word32 outSz)
+{
+    CertComp* certComp = TLSX_CertComp_Get(ssl);
+    int       i;
+
+    if (certComp == NULL)
+        return BAD_STATE_E;
+
+    for (i = 0; i < certComp->cnt; i++) {
+        if (certComp->algs[i].alg == alg &&
+                certComp->algs[i].decompress != NULL) {
+            return certComp->algs[i].decompress(ssl, in, inSz, out, outSz);
+        }
+    }
+
+    WOLFSSL_MSG("Certificate compressed with algorithm not offered");
+    return DECOMPRESS_E;
+}
+
+/* Add a certificate compression algorithm to the context.
+ * Algorithms are preferred in the order they are added.
+ *
+ * ctx           The SSL/TLS context.
+ * alg           The CertificateCompressionAlgorithm identifier.
+ * compressCb    Callback to compress our Certificate message. NULL when
+ *               only decompressing the peer's.
+ * decompressCb  Callback to decompress the peer's Certificate message. NULL
+ *               when only compressing ours.
+ * When both callbacks are NULL and alg is WOLFSSL_CERT_COMP_ZLIB, the built-in
+ * zlib support is used.
+ * returns WOLFSSL_SUCCESS on success, otherwise failure.
+ */
+int wolfSSL_CTX_AddCertCompression(WOLFSSL_CTX* ctx, word16 alg,
+                                   CallbackCertCompress compressCb,
+                                   CallbackCertDecompress decompressCb)
+{
+    int          ret;
+    TLSX*        extension;
+    CertComp*    certComp;
+    CertCompAlg* compAlg = NULL;
+    int          i;
+
+    if (ctx == NULL || alg == 0)
+        return BAD_FUNC_ARG;
+
+#ifdef HAVE_LIBZ
+    if (alg == WOLFSSL_CERT_COMP_ZLIB && compressCb == NULL &&
+            decompressCb == NULL) {
+        compressCb = TLSX_CertComp_ZlibCompress;
+        decompressCb = TLSX_CertComp_ZlibDecompress;
+    }
+#endif
+    if (compressCb == NULL && decompressCb == NULL)
+        return BAD_FUNC_ARG;
+
+    extension = TLSX_Find(ctx->extensions, TLSX_COMPRESS_CERTIFICATE);
+    if (extension == NULL) {
+        certComp = (CertComp*)XMALLOC(sizeof(CertComp), ctx->heap,
+                                      DYNAMIC_TYPE_TLSX);
+        if (certComp == NULL)
+            return MEMORY_E;
+        XMEMSET(certComp, 0, sizeof(CertComp));
+        if (wc_InitMutex(&certComp->lock) != 0) {
+            XFREE(certComp, ctx->heap, DYNAMIC_TYPE_TLSX);
+            return BAD_MUTEX_E;
+        }
+        ret = TLSX_Push(&ctx->extensions, TLSX_COMPRESS_CERTIFICATE, certComp,
+                        ctx->heap);
+        if (ret != 0) {
+            TLSX_CertComp_Free(certComp, ctx->heap);
+            return ret;
+        }
+    }
+    else
+        certComp = (CertComp*)extension->data;
+
+    for (i = 0; i < certComp->cnt; i++) {
+        if (certComp->algs[i].alg == alg) {
+            compAlg = &certComp->algs[i];
+            break;
+        }
+    }
+    if (compAlg == NULL) {
+        if (certComp->cnt == WOLFSSL_CERT_COMP_MAX_ALGS)
+            return BUFFER_E;
+        compAlg = &certComp->algs[certComp->cnt++];
+        compAlg->alg = alg;
+    }
+
+    if (wc_LockMutex(&certComp->lock) != 0)
+        return BAD_MUTEX_E;
+    compAlg->compress = compressCb;
+    compAlg->decompress = decompressCb;
+    /* Cached chain may have been compressed by the replaced callback. */
+    XFREE(compAlg->msg, ctx->heap, DYNAMIC_TYPE_CERT);
+    XFREE(compAlg->comp, ctx->heap, DYNAMIC_TYPE_CERT);
+    compAlg->msg = NULL;
+    compAlg->comp = NULL;
+    compAlg->msgSz = 0;
+    compAlg->compSz = 0;
+    wc_UnLockMutex(&certComp->lock);
+
+    return WOLFSSL_SUCCESS;
+}
+
+#define CCM_FREE_ALL         TLSX_CertComp_Free
+#define CCM_GET_SIZE         TLSX_CertComp_GetSize
+#define CCM_WRITE            TLSX_CertComp_Write
+#define CCM_PARSE            TLSX_CertComp_Parse
+
+#else
+
+#define CCM_FREE_ALL(a, b)     WC_DO_NOTHING
+#define CCM_GET_SIZE(a, b, c)  0
+#define CCM_WRITE(a, b, c, d)  0
+#define CCM_PARSE(a, b, c, d)  0
+
+#endif /* WOLFSSL_CERT_COMPRESSION */
+
 /******************************************************************************/
 /* Early Data Indication                                                      */
 /******************************************************************************/
@@ -12499,6 +13257,13 @@ void TLSX_FreeAll(TLSX* list, void* heap)
                 break;
     #endif
 
+    #ifdef WOLFSSL_CERT_COMPRESSION
+            case TLSX_COMPRESS_CERTIFICATE:
+                WOLFSSL_MSG("Compress Certificate extension free");
+                CCM_FREE_ALL((CertComp*)extension->data, heap);
+                break;
+    #endif
+
     #if !defined(NO_CERTS) && !defined(WOLFSSL_NO_SIGALG)
             case TLSX_SIGNATURE_ALGORITHMS_CERT:
                 WOLFSSL_MSG("Signature Algorithms extension free");
@@ -12695,6 +13460,13 @@ static int TLSX_GetSize(TLSX* list, byte* semaphore, byte msgType,
                 break;
     #endif
 
+    #ifdef WOLFSSL_CERT_COMPRESSION
+            case TLSX_COMPRESS_CERTIFICATE:
+                ret = CCM_GET_SIZE((CertComp*)extension->data, msgType,
+                                   &length);
+                break;
+    #endif
+
     #if !defined(NO_CERTS) && !defined(WOLFSSL_NO_SIGALG)
             case TLSX_SIGNATURE_ALGORITHMS_CERT:
                 length += SAC_GET_SIZE(extension->data);
@@ -12935,6 +13707,14 @@ static int TLSX_Write(TLSX* list, byte* output, byte* semaphore,
                 break;
     #endif
 
+    #ifdef WOLFSSL_CERT_COMPRESSION
+            case TLSX_COMPRESS_CERTIFICATE:
+                WOLFSSL_MSG("Compress Certificate extension to write");
+                ret = CCM_WRITE((CertComp*)extension->data, output + offset,
+                                msgType, &offset);
+                break;
+    #endif
+
     #if !defined(NO_CERTS) && !defined(WOLFSSL_NO_SIGALG)
             case TLSX_SIGNATURE_ALGORITHMS_CERT:
                 WOLFSSL_MSG("Signature Algorithms extension to write");
@@ -13842,6 +14622,11 @@ int TLSX_GetRequestSize(WOLFSSL* ssl, byte msgType, word32* pLength)
         #endif
         }
     #endif
+    #ifdef WOLFSSL_CERT_COMPRESSION
+        /* Only offered in TLS v1.3 and when able to decompress. */
+        if (!IsAtLeastTLSv1_3(ssl->version) || !TLSX_CertComp_Offered(ssl))
+            TURN_ON(semaphore, TLSX_ToSemaphore(TLSX_COMPRESS_CERTIFICATE));
+    #endif
 #endif /* WOLFSSL_TLS13 */
     #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
      || defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
@@ -14086,6 +14871,11 @@ int TLSX_WriteRequest(WOLFSSL* ssl, byte* output, byte msgType, word32* pOffset)
          */
         TURN_ON(semaphore, TLSX_ToSemaphore(TLSX_PRE_SHARED_KEY));
     #endif
+    #ifdef WOLFSSL_CERT_COMPRESSION
+        /* Only offered in TLS v1.3 and when able to decompress. */
+        if (!IsAtLeastTLSv1_3(ssl->version) || !TLSX_CertComp_Offered(ssl))
+            TURN_ON(semaphore, TLSX_ToSemaphore(TLSX_COMPRESS_CERTIFICATE));
+    #endif
 #endif /* WOLFSSL_TLS13 */
     #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
      || defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
@@ -15174,6 +15964,26 @@ int TLSX_Parse(WOLFSSL* ssl, const byte* input, word16 length, byte msgType,
                 break;
     #endif
 
+    #ifdef WOLFSSL_CERT_COMPRESSION
+            case TLSX_COMPRESS_CERTIFICATE:
+                WOLFSSL_MSG("Compress Certificate extension received");
+            #ifdef WOLFSSL_DEBUG_TLS
+                WOLFSSL_BUFFER(input + offset, size);
+            #endif
+
+                if (!IsAtLeastTLSv1_3(ssl->version))
+                    break;
+
+                if (msgType != client_hello &&
+                        msgType != certificate_request) {
+                    WOLFSSL_ERROR_VERBOSE(EXT_NOT_ALLOWED);
+                    return EXT_NOT_ALLOWED;
+                }
+
+                ret = CCM_PARSE(ssl, input + offset, size, msgType);
+                break;
+    #endif
+
     #if !defined(NO_CERTS) && !defined(WOLFSSL_NO_SIGALG)
             case TLSX_SIGNATURE_ALGORITHMS_CERT:
                 WOLFSSL_MSG("Signature Algorithms extension received");
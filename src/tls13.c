@@ -3339,7 +3339,7 @@ int BuildTls13Message(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
 
             /* TLS v1.3 can do in place encryption. */
             if (input != output + args->idx)
-                XMEMCPY(output + args->idx, input, (size_t)inSz);
+                BuildMessageInput(ssl, output + args->idx, input, inSz);
             args->idx += (word32)inSz;
 
             ssl->options.buildMsgState = BUILD_MSG_HASH;
@@ -8465,6 +8465,173 @@ static word32 AddCertExt(WOLFSSL* ssl, byte* cert, word32 len, word16 extSz,
     return i;
 }
 
+#if defined(WOLFSSL_CERT_COMPRESSION) && !defined(NO_WOLFSSL_SERVER)
+/* Build the server's CompressedCertificate message.
+ * The Certificate message body is encoded and compressed with the negotiated
+ * algorithm. The compressed chain is cached on the context so the chain is
+ * only recompressed when the certificates or extensions change.
+ * The message, with handshake header, is kept until sent.
+ *
+ * ssl  The SSL/TLS object.
+ * returns 0 on success, otherwise failure.
+ */
+static int BuildTls13CompressedCertificate(WOLFSSL* ssl)
+{
+    int    ret;
+    word16 extSz = 0;
+    word32 certSz = ssl->buffers.certificate->length;
+    word32 certChainSz = 0;
+    word32 listSz;
+    word32 msgSz;
+    word32 compSz = 0;
+    word32 len;
+    word32 idx = 0;
+    word32 i = 0;
+    byte*  msg;
+    byte*  comp = NULL;
+    /* Handshake header | Algorithm | Uncompressed length | Compressed length */
+    const word32 headerSz = HANDSHAKE_HEADER_SZ + OPAQUE16_LEN +
+                            OPAQUE24_LEN + OPAQUE24_LEN;
+
+    ret = TLSX_GetResponseSize(ssl, certificate, &extSz);
+    if (ret < 0)
+        return ret;
+
+    if (ssl->buffers.certChainCnt > 0) {
+        certChainSz = ssl->buffers.certChain->length +
+                      OPAQUE16_LEN * (word32)ssl->buffers.certChainCnt;
+    }
+    listSz = CERT_HEADER_SZ + certSz + extSz + certChainSz;
+    /* Empty request context | Certificate list length | list */
+    msgSz = OPAQUE8_LEN + CERT_HEADER_SZ + listSz;
+
+    msg = (byte*)XMALLOC(msgSz, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (msg == NULL)
+        return MEMORY_E;
+
+    msg[i++] = 0;
+    c32to24(listSz, msg + i);
+    i += CERT_HEADER_SZ;
+    /* Leaf certificate with extensions. */
+    c32to24(certSz, msg + i);
+    i += CERT_HEADER_SZ;
+    XMEMCPY(msg + i, ssl->buffers.certificate->buffer, certSz);
+    i += certSz;
+    if (extSz > OPAQUE16_LEN) {
+        word16 extWritten = 0;
+
+        ret = TLSX_WriteResponse(ssl, msg + i, certificate, &extWritten);
+        if (ret == 0 && extWritten != extSz)
+            ret = BUFFER_E;
+    }
+    else {
+        msg[i] = 0;
+        msg[i + 1] = 0;
+    }
+    i += extSz;
+    /* CA certificates with empty extensions. */
+    while (ret == 0 && certChainSz > 0 &&
+           (len = NextCert(ssl->buffers.certChain->buffer,
+                           ssl->buffers.certChain->length, &idx)) != 0) {
+        XMEMCPY(msg + i, ssl->buffers.certChain->buffer + idx - len, len);
+        i += len;
+        msg[i++] = 0;
+        msg[i++] = 0;
+    }
+
+    if (ret == 0) {
+        ret = TLSX_CertComp_Compress(ssl, msg, msgSz, headerSz, &comp,
+                                     &compSz);
+    }
+    XFREE(msg, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (ret != 0)
+        return ret;
+
+    AddTls13HandShakeHeader(comp, headerSz - HANDSHAKE_HEADER_SZ + compSz, 0,
+                            0, compressed_certificate, ssl);
+    i = HANDSHAKE_HEADER_SZ;
+    c16toa(ssl->certCompAlg, comp + i);
+    i += OPAQUE16_LEN;
+    c32to24(msgSz, comp + i);
+    i += OPAQUE24_LEN;
+    c32to24(compSz, comp + i);
+
+    ssl->certCompMsg = comp;
+    ssl->certCompMsgSz = headerSz + compSz;
+    ssl->fragOffset = 0;
+
+    return 0;
+}
+
+/* handle generation TLS v1.3 compressed_certificate (25) */
+/* Send the built CompressedCertificate message in as many records as needed.
+ * This message is always encrypted in TLS v1.3.
+ *
+ * ssl  The SSL/TLS object.
+ * returns 0 on success, otherwise failure.
+ */
+static int SendTls13CompressedCertificate(WOLFSSL* ssl)
+{
+    int    ret = 0;
+    word32 maxFragment;
+
+    WOLFSSL_ENTER("SendTls13CompressedCertificate");
+
+    maxFragment = (word32)wolfSSL_GetMaxFragSize(ssl, MAX_RECORD_SIZE);
+
+    while (ret == 0 && ssl->fragOffset < ssl->certCompMsgSz) {
+        byte*  output;
+        word32 fragSz = min(ssl->certCompMsgSz - ssl->fragOffset,
+                            maxFragment);
+        int    sendSz = RECORD_HEADER_SZ + (int)fragSz + MAX_MSG_EXTRA;
+
+        /* Check buffers are big enough and grow if needed. */
+        if ((ret = CheckAvailableSize(ssl, sendSz)) != 0)
+            return ret;
+
+        /* Get position in output buffer to write new message to. */
+        output = GetOutputBuffer(ssl);
+
+        /* This message is always encrypted. */
+        sendSz = BuildTls13Message(ssl, output, sendSz,
+            ssl->certCompMsg + ssl->fragOffset, (int)fragSz, handshake, 1,
+            0, 0);
+        if (sendSz < 0)
+            return sendSz;
+
+#if defined(WOLFSSL_CALLBACKS) || defined(OPENSSL_EXTRA)
+        if (ssl->hsInfoOn)
+            AddPacketName(ssl, "CompressedCertificate");
+        if (ssl->toInfoOn) {
+            ret = AddPacketInfo(ssl, "CompressedCertificate", handshake,
+                          output, sendSz, WRITE_PROTO, 0, ssl->heap);
+            if (ret != 0)
+                return ret;
+        }
+#endif
+
+        ssl->fragOffset += fragSz;
+        ssl->buffers.outputBuffer.length += (word32)sendSz;
+        if (!ssl->options.groupMessages)
+            ret = SendBuffered(ssl);
+    }
+
+    if (ret != WC_NO_ERR_TRACE(WANT_WRITE)) {
+        XFREE(ssl->certCompMsg, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        ssl->certCompMsg = NULL;
+        ssl->certCompMsgSz = 0;
+        ssl->options.buildingMsg = 0;
+        ssl->fragOffset = 0;
+        if (ret == 0)
+            ssl->options.serverState = SERVER_CERT_COMPLETE;
+    }
+
+    WOLFSSL_LEAVE("SendTls13CompressedCertificate", ret);
+
+    return ret;
+}
+#endif /* WOLFSSL_CERT_COMPRESSION && !NO_WOLFSSL_SERVER */
+
 /* handle generation TLS v1.3 certificate (11) */
 /* Send the certificate for this end and any CAs that help with validation.
  * This message is always encrypted in TLS v1.3.
@@ -8521,6 +8688,25 @@ static int SendTls13Certificate(WOLFSSL* ssl)
     }
 #endif
 
+#if defined(WOLFSSL_CERT_COMPRESSION) && !defined(NO_WOLFSSL_SERVER)
+    if (ssl->certCompAlg != 0 && ssl->options.side == WOLFSSL_SERVER_END &&
+            ssl->buffers.certificate != NULL &&
+            ssl->buffers.certificate->buffer != NULL) {
+        if (ssl->certCompMsg != NULL ||
+                BuildTls13CompressedCertificate(ssl) == 0) {
+            ret = SendTls13CompressedCertificate(ssl);
+
+            WOLFSSL_LEAVE("SendTls13Certificate", ret);
+            WOLFSSL_END(WC_FUNC_CERTIFICATE_SEND);
+
+            return ret;
+        }
+        /* Peer can always process an uncompressed Certificate. */
+        WOLFSSL_MSG("Compressing Certificate failed, sending uncompressed");
+        ssl->certCompAlg = 0;
+    }
+#endif
+
     if (ssl->options.sendVerify == SEND_BLANK_CERT) {
         certSz = 0;
         certChainSz = 0;
@@ -9696,6 +9882,94 @@ static int DoTls13Certificate(WOLFSSL* ssl, byte* input, word32* inOutIdx,
 }
 #endif
 
+#if defined(WOLFSSL_CERT_COMPRESSION) && !defined(NO_WOLFSSL_CLIENT)
+/* handle processing TLS v1.3 compressed_certificate (25) */
+/* Parse and handle a TLS v1.3 CompressedCertificate message.
+ * The Certificate message is decompressed and processed as if received.
+ * The decompressed message is kept until processing completes as certificate
+ * processing may be resumed.
+ *
+ * ssl       The SSL/TLS object.
+ * input     The message buffer.
+ * inOutIdx  On entry, the index into the message buffer of
+ *           CompressedCertificate.
+ *           On exit, the index of byte after the CompressedCertificate
+ *           message.
+ * totalSz   The length of the current handshake message.
+ * returns 0 on success and otherwise failure.
+ */
+static int DoTls13CompressedCertificate(WOLFSSL* ssl, byte* input,
+                                        word32* inOutIdx, word32 totalSz)
+{
+    int    ret = 0;
+    word32 begin = *inOutIdx;
+    word32 idx = 0;
+    word16 alg;
+    word32 msgSz;
+    word32 compSz;
+
+    WOLFSSL_ENTER("DoTls13CompressedCertificate");
+
+    if (ssl->certCompIn == NULL) {
+        /* Algorithm | Uncompressed length | Compressed length */
+        if (totalSz < OPAQUE16_LEN + OPAQUE24_LEN + OPAQUE24_LEN)
+            return BUFFER_ERROR;
+        ato16(input + begin, &alg);
+        c24to32(input + begin + OPAQUE16_LEN, &msgSz);
+        c24to32(input + begin + OPAQUE16_LEN + OPAQUE24_LEN, &compSz);
+        idx = begin + OPAQUE16_LEN + OPAQUE24_LEN + OPAQUE24_LEN;
+        if (compSz == 0 || idx - begin + compSz != totalSz)
+            return BUFFER_ERROR;
+
+        if (msgSz == 0 || msgSz > WOLFSSL_CERT_COMP_MAX_SZ) {
+            WOLFSSL_MSG("Uncompressed Certificate length not supported");
+            ret = DECOMPRESS_E;
+        }
+        if (ret == 0) {
+            ssl->certCompIn = (byte*)XMALLOC(msgSz, ssl->heap,
+                                             DYNAMIC_TYPE_TMP_BUFFER);
+            if (ssl->certCompIn == NULL)
+                return MEMORY_E;
+            ret = TLSX_CertComp_Decompress(ssl, alg, input + idx, compSz,
+                                           ssl->certCompIn, msgSz);
+            /* Must decompress to exactly the advertised length. */
+            if (ret == (int)msgSz)
+                ret = 0;
+            else {
+                WOLFSSL_MSG("Certificate decompression failed");
+                ret = DECOMPRESS_E;
+            }
+        }
+        if (ret != 0) {
+            XFREE(ssl->certCompIn, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            ssl->certCompIn = NULL;
+            SendAlert(ssl, alert_fatal, bad_certificate);
+            WOLFSSL_ERROR_VERBOSE(ret);
+            return ret;
+        }
+        ssl->certCompInSz = msgSz;
+    }
+
+    idx = 0;
+    ret = DoTls13Certificate(ssl, ssl->certCompIn, &idx, ssl->certCompInSz);
+    if (ret != WC_NO_ERR_TRACE(WC_PENDING_E) &&
+            ret != WC_NO_ERR_TRACE(OCSP_WANT_READ)) {
+        XFREE(ssl->certCompIn, ssl->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        ssl->certCompIn = NULL;
+        ssl->certCompInSz = 0;
+    }
+    if (ret == 0) {
+        *inOutIdx = begin + totalSz;
+        if (IsEncryptionOn(ssl, 0))
+            *inOutIdx += ssl->keys.padSz;
+    }
+
+    WOLFSSL_LEAVE("DoTls13CompressedCertificate", ret);
+
+    return ret;
+}
+#endif
+
 #if !defined(NO_RSA) || defined(HAVE_ECC) || defined(HAVE_ED25519) || \
                                                              defined(HAVE_ED448)
 
@@ -11165,6 +11439,15 @@ static int SendTls13KeyUpdate(WOLFSSL* ssl)
     }
     else
 #endif /* WOLFSSL_DTLS13 */
+#ifdef WOLFSSL_KTLS
+    if (ssl->ktls & WOLFSSL_KTLS_TX) {
+        /* Kernel encrypts the message. */
+        ret = KtlsSendRecord(ssl, handshake, input, headerSz + OPAQUE8_LEN);
+        if (ret != 0)
+            return ret;
+    }
+    else
+#endif /* WOLFSSL_KTLS */
     {
         /* This message is always encrypted. */
         int sendSz = BuildTls13Message(ssl, output, outputSz, input,
@@ -11201,6 +11484,12 @@ static int SendTls13KeyUpdate(WOLFSSL* ssl)
             return ret;
         if ((ret = SetKeysSide(ssl, ENCRYPT_SIDE_ONLY)) != 0)
             return ret;
+    #ifdef WOLFSSL_KTLS
+        if ((ssl->ktls & WOLFSSL_KTLS_TX) &&
+                (ret = KtlsSetKeys(ssl, WOLFSSL_KTLS_TX)) != 0) {
+            return ret;
+        }
+    #endif
     }
 
 
@@ -12044,6 +12333,19 @@ static int SanityCheckTls13MsgReceived(WOLFSSL* ssl, byte type)
             break;
 #endif
 
+#ifdef WOLFSSL_CERT_COMPRESSION
+        case compressed_certificate:
+            /* Only sent by a server when offered a decompression algorithm.
+             * Otherwise, checked as a Certificate message. */
+            if (ssl->options.side != WOLFSSL_CLIENT_END ||
+                    !TLSX_CertComp_Offered(ssl)) {
+                WOLFSSL_MSG("CompressedCertificate received unexpectedly");
+                WOLFSSL_ERROR_VERBOSE(SANITY_MSG_E);
+                return SANITY_MSG_E;
+            }
+            FALL_THROUGH;
+#endif
+
         case certificate:
             /* Valid on both sides. */
     #ifndef NO_WOLFSSL_CLIENT
@@ -12574,6 +12876,12 @@ int DoTls13HandShakeMsgType(WOLFSSL* ssl, byte* input, word32* inOutIdx,
         ret = DoTls13Certificate(ssl, input, inOutIdx, size);
         break;
 #endif
+#if defined(WOLFSSL_CERT_COMPRESSION) && !defined(NO_WOLFSSL_CLIENT)
+    case compressed_certificate:
+        WOLFSSL_MSG("processing compressed certificate");
+        ret = DoTls13CompressedCertificate(ssl, input, inOutIdx, size);
+        break;
+#endif
 
 #if !defined(NO_RSA) || defined(HAVE_ECC) || defined(HAVE_ED25519) || \
     defined(HAVE_ED448) || defined(HAVE_FALCON) || defined(HAVE_DILITHIUM)
@@ -29,6 +29,10 @@
 #endif
 
 #include <wolfssl/wolfcrypt/settings.h>
+#if defined(WOLFSSL_DTLS_MMSG) && !defined(_GNU_SOURCE)
+    /* turn on GNU extensions for recvmmsg() and sendmmsg() */
+    #define _GNU_SOURCE 1
+#endif
 
 #ifndef WOLFCRYPT_ONLY
 
@@ -99,6 +103,24 @@ int Nucleus_Net_Errno;
     #endif /* USE_WINDOWS_API */
 #endif /* defined(USE_WOLFSSL_IO) || defined(HAVE_HTTP_CLIENT) */
 
+#if defined(WOLFSSL_KTLS) && defined(USE_WOLFSSL_IO)
+    #include <netinet/tcp.h>
+    #include <linux/tls.h>
+    #ifndef SOL_TLS
+        #define SOL_TLS 282
+    #endif
+    #ifndef TCP_ULP
+        #define TCP_ULP 31
+    #endif
+#endif
+
+#if defined(WOLFSSL_IO_URING) && defined(USE_WOLFSSL_IO)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
 
 #if defined(HAVE_HTTP_CLIENT)
     #include <stdlib.h>   /* strtol() */
@@ -632,6 +654,101 @@ static int isDGramSock(int sfd)
     }
 }
 
+#ifdef WOLFSSL_DTLS_MMSG
+static DtlsMmsg* DtlsMmsgGet(WOLFSSL* ssl, WOLFSSL_DTLS_CTX* dtlsCtx)
+{
+    if (dtlsCtx->mmsg == NULL) {
+        dtlsCtx->mmsg = (DtlsMmsg*)XMALLOC(sizeof(DtlsMmsg), ssl->heap,
+            DYNAMIC_TYPE_DTLS_MMSG);
+        if (dtlsCtx->mmsg != NULL)
+            XMEMSET(dtlsCtx->mmsg, 0, sizeof(DtlsMmsg));
+    }
+
+    return dtlsCtx->mmsg;
+}
+
+/* Receive a datagram like recvfrom(). When none have been read ahead, up to
+ * WOLFSSL_DTLS_MMSG_CNT datagrams are read with one recvmmsg() call - only
+ * waiting for the first. A peek returns the next datagram read ahead and
+ * leaves it to be read.
+ *  return : nb bytes read, or -1 with errno set
+ */
+static int DtlsRecvFromBatch(WOLFSSL* ssl, WOLFSSL_DTLS_CTX* dtlsCtx, int sd,
+    char* buf, int sz, SOCKADDR_S* peer, XSOCKLENT* peerSz)
+{
+    DtlsMmsg* mmsg;
+    int peek = (ssl->rflags & MSG_PEEK) != 0;
+    int i;
+    int len;
+
+    mmsg = DtlsMmsgGet(ssl, dtlsCtx);
+    if (mmsg != NULL && mmsg->rxIdx == mmsg->rxCnt) {
+        if (peek) {
+            /* Nothing read ahead - peek at the socket. */
+            mmsg = NULL;
+        }
+        else if (mmsg->rxBuf == NULL || mmsg->rxSlotSz < (word32)sz) {
+            XFREE(mmsg->rxBuf, ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+            mmsg->rxBuf = (byte*)XMALLOC((size_t)sz * WOLFSSL_DTLS_MMSG_CNT,
+                ssl->heap, DYNAMIC_TYPE_IN_BUFFER);
+            mmsg->rxSlotSz = (mmsg->rxBuf != NULL) ? (word32)sz : 0;
+        }
+    }
+    if (mmsg == NULL || mmsg->rxBuf == NULL) {
+        return (int)DTLS_RECVFROM_FUNCTION(sd, buf, (size_t)sz, ssl->rflags,
+            (SOCKADDR*)peer, peerSz);
+    }
+
+    if (mmsg->rxIdx == mmsg->rxCnt) {
+        struct mmsghdr msgs[WOLFSSL_DTLS_MMSG_CNT];
+        struct iovec   iov[WOLFSSL_DTLS_MMSG_CNT];
+        int n;
+
+        XMEMSET(msgs, 0, sizeof(msgs));
+        for (i = 0; i < WOLFSSL_DTLS_MMSG_CNT; i++) {
+            iov[i].iov_base = mmsg->rxBuf + (size_t)i * mmsg->rxSlotSz;
+            iov[i].iov_len  = mmsg->rxSlotSz;
+            msgs[i].msg_hdr.msg_iov    = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            if (peer != NULL) {
+                msgs[i].msg_hdr.msg_name    = &mmsg->rxAddr[i];
+                msgs[i].msg_hdr.msg_namelen = sizeof(mmsg->rxAddr[i]);
+            }
+        }
+
+        n = recvmmsg(sd, msgs, WOLFSSL_DTLS_MMSG_CNT,
+                     ssl->rflags | MSG_WAITFORONE, NULL);
+        if (n <= 0)
+            return n;
+
+        for (i = 0; i < n; i++) {
+            mmsg->rxLen[i]    = msgs[i].msg_len;
+            mmsg->rxAddrSz[i] = msgs[i].msg_hdr.msg_namelen;
+        }
+        mmsg->rxCnt = n;
+        mmsg->rxIdx = 0;
+    }
+
+    i = mmsg->rxIdx;
+    if (!peek)
+        mmsg->rxIdx++;
+    len = (int)mmsg->rxLen[i];
+    if (len > sz)
+        len = sz;
+    XMEMCPY(buf, mmsg->rxBuf + (size_t)i * mmsg->rxSlotSz, (size_t)len);
+    if (peer != NULL) {
+        /* Address truncated like recvfrom() but full size returned. */
+        XSOCKLENT addrSz = mmsg->rxAddrSz[i];
+        if (addrSz > *peerSz)
+            addrSz = *peerSz;
+        XMEMCPY(peer, &mmsg->rxAddr[i], (size_t)addrSz);
+        *peerSz = mmsg->rxAddrSz[i];
+    }
+
+    return len;
+}
+#endif /* WOLFSSL_DTLS_MMSG */
+
 /* The receive embedded callback
  *  return : nb bytes read, or error
  */
@@ -755,8 +872,13 @@ int EmbedReceiveFrom(WOLFSSL *ssl, char *buf, int sz, void *ctx)
         }
 #endif /* !NO_ASN_TIME */
 
+#ifdef WOLFSSL_DTLS_MMSG
+        recvd = DtlsRecvFromBatch(ssl, dtlsCtx, sd, buf, sz, peer,
+            peer != NULL ? &peerSz : NULL);
+#else
         recvd = (int)DTLS_RECVFROM_FUNCTION(sd, buf, (size_t)sz, ssl->rflags,
             (SOCKADDR*)peer, peer != NULL ? &peerSz : NULL);
+#endif
 
         /* From the RECV(2) man page
          * The returned address is truncated if the buffer provided is too
@@ -835,33 +957,47 @@ int EmbedReceiveFrom(WOLFSSL *ssl, char *buf, int sz, void *ctx)
 }
 
 
-/* The send embedded callback
- *  return : nb bytes sent, or error
+/* Get the address to send datagrams to.
+ *  return : 0 on success, or error
  */
-int EmbedSendTo(WOLFSSL* ssl, char *buf, int sz, void *ctx)
+static int DtlsSendToPeer(WOLFSSL_DTLS_CTX* dtlsCtx, int sd,
+    const SOCKADDR_S** peer, XSOCKLENT* peerSz)
 {
-    WOLFSSL_DTLS_CTX* dtlsCtx = (WOLFSSL_DTLS_CTX*)ctx;
-    int sd = dtlsCtx->wfd;
-    int sent;
-    const SOCKADDR_S* peer = NULL;
-    XSOCKLENT peerSz = 0;
-
-    WOLFSSL_ENTER("EmbedSendTo");
+    *peer = NULL;
+    *peerSz = 0;
 
     if (!isDGramSock(sd)) {
         /* Probably a TCP socket. peer and peerSz MUST be NULL and 0 */
     }
     else if (!dtlsCtx->connected) {
-        peer   = (const SOCKADDR_S*)dtlsCtx->peer.sa;
-        peerSz = dtlsCtx->peer.sz;
+        *peer   = (const SOCKADDR_S*)dtlsCtx->peer.sa;
+        *peerSz = dtlsCtx->peer.sz;
 #ifndef WOLFSSL_IPV6
-        if (PeerIsIpv6(peer, peerSz)) {
+        if (PeerIsIpv6(*peer, *peerSz)) {
             WOLFSSL_MSG("ipv6 dtls peer set but no ipv6 support compiled");
             return NOT_COMPILED_IN;
         }
 #endif
     }
 
+    return 0;
+}
+
+/* Send a datagram to the peer.
+ *  return : nb bytes sent, or error
+ */
+static int DtlsSendTo(WOLFSSL* ssl, WOLFSSL_DTLS_CTX* dtlsCtx, char* buf,
+    int sz)
+{
+    int sd = dtlsCtx->wfd;
+    int sent;
+    const SOCKADDR_S* peer;
+    XSOCKLENT peerSz;
+
+    sent = DtlsSendToPeer(dtlsCtx, sd, &peer, &peerSz);
+    if (sent != 0)
+        return sent;
+
     sent = (int)DTLS_SENDTO_FUNCTION(sd, buf, (size_t)sz, ssl->wflags,
             (const SOCKADDR*)peer, peerSz);
 
@@ -874,6 +1010,195 @@ int EmbedSendTo(WOLFSSL* ssl, char *buf, int sz, void *ctx)
     return sent;
 }
 
+#ifdef WOLFSSL_DTLS_MMSG
+/* Size of buffer datagrams are queued in before sendmmsg(). */
+#define DTLS_MMSG_TX_SZ \
+    (WOLFSSL_DTLS_MMSG_CNT * (MAX_MTU + DTLS_MTU_ADDITIONAL_READ_BUFFER))
+
+/* Write the queued datagrams with sendmmsg(). Datagrams that can't be written
+ * without blocking stay queued, in order, to be written first next time.
+ *  return : 0 on success, WOLFSSL_CBIO_ERR_WANT_WRITE when datagrams are left
+ *           queued, or error
+ */
+static int DtlsSendQueued(WOLFSSL* ssl, WOLFSSL_DTLS_CTX* dtlsCtx)
+{
+    DtlsMmsg* mmsg = dtlsCtx->mmsg;
+    struct mmsghdr msgs[WOLFSSL_DTLS_MMSG_CNT];
+    struct iovec   iov[WOLFSSL_DTLS_MMSG_CNT];
+    const SOCKADDR_S* peer;
+    XSOCKLENT peerSz;
+    int sd = dtlsCtx->wfd;
+    int done = 0;
+    int ret;
+    int i;
+    word32 off = 0;
+
+    if (mmsg == NULL || mmsg->txCnt == 0)
+        return 0;
+
+    ret = DtlsSendToPeer(dtlsCtx, sd, &peer, &peerSz);
+    if (ret == 0) {
+        XMEMSET(msgs, 0, sizeof(msgs));
+        for (i = 0; i < mmsg->txCnt; i++) {
+            iov[i].iov_base = mmsg->txBuf + off;
+            iov[i].iov_len  = mmsg->txLen[i];
+            off += mmsg->txLen[i];
+            msgs[i].msg_hdr.msg_iov     = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen  = 1;
+            msgs[i].msg_hdr.msg_name    = (void*)peer;
+            msgs[i].msg_hdr.msg_namelen = peerSz;
+        }
+    }
+
+    while (ret == 0 && done < mmsg->txCnt) {
+        int n = sendmmsg(sd, msgs + done, (unsigned int)(mmsg->txCnt - done),
+                         ssl->wflags);
+        if (n < 0) {
+            n = TranslateIoReturnCode(n, sd, SOCKET_SENDING);
+            if (n == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_ISR))
+                continue;
+            if (n == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_WANT_WRITE)) {
+                WOLFSSL_MSG("Keeping datagrams queued - send would block");
+            }
+            else {
+                WOLFSSL_MSG("Embed Send To error");
+            }
+            ret = n;
+        }
+        else {
+            done += n;
+        }
+    }
+
+    if (ret == WC_NO_ERR_TRACE(WOLFSSL_CBIO_ERR_WANT_WRITE)) {
+        /* Move the datagrams not written to the front of the queue. */
+        word32 sentSz = 0;
+
+        for (i = 0; i < done; i++)
+            sentSz += mmsg->txLen[i];
+        mmsg->txCnt -= done;
+        mmsg->txUsed -= sentSz;
+        XMEMMOVE(mmsg->txBuf, mmsg->txBuf + sentSz, mmsg->txUsed);
+        XMEMMOVE(mmsg->txLen, mmsg->txLen + done,
+            (size_t)mmsg->txCnt * sizeof(*mmsg->txLen));
+    }
+    else {
+        mmsg->txCnt = 0;
+        mmsg->txUsed = 0;
+    }
+
+    return ret;
+}
+
+/* Queue a datagram while sending is deferred.
+ *  return : nb bytes queued, or error
+ */
+static int DtlsSendToQueue(WOLFSSL* ssl, WOLFSSL_DTLS_CTX* dtlsCtx, char* buf,
+    int sz)
+{
+    DtlsMmsg* mmsg = dtlsCtx->mmsg;
+    int ret;
+
+    if (mmsg->txCnt == WOLFSSL_DTLS_MMSG_CNT ||
+            mmsg->txUsed + (word32)sz > DTLS_MMSG_TX_SZ) {
+        ret = DtlsSendQueued(ssl, dtlsCtx);
+        if (ret != 0)
+            return ret;
+    }
+    if ((word32)sz > DTLS_MMSG_TX_SZ)
+        return DtlsSendTo(ssl, dtlsCtx, buf, sz);
+
+    XMEMCPY(mmsg->txBuf + mmsg->txUsed, buf, (size_t)sz);
+    mmsg->txUsed += (word32)sz;
+    mmsg->txLen[mmsg->txCnt++] = (word32)sz;
+
+    return sz;
+}
+
+/* Queue the datagrams written with EmbedSendTo() until the matching
+ * wolfIO_DtlsSendFlush(). Calls may be nested.
+ *  return : 0 on success, or MEMORY_E
+ */
+int wolfIO_DtlsSendDefer(WOLFSSL* ssl, void* ctx)
+{
+    DtlsMmsg* mmsg = DtlsMmsgGet(ssl, (WOLFSSL_DTLS_CTX*)ctx);
+
+    if (mmsg != NULL && mmsg->txBuf == NULL) {
+        mmsg->txBuf = (byte*)XMALLOC(DTLS_MMSG_TX_SZ, ssl->heap,
+            DYNAMIC_TYPE_OUT_BUFFER);
+    }
+    if (mmsg == NULL || mmsg->txBuf == NULL)
+        return MEMORY_E;
+
+    mmsg->txDefer++;
+
+    return 0;
+}
+
+/* End deferring and write all queued datagrams with sendmmsg(). When not
+ * deferring, writes the datagrams left queued by a send that would block.
+ *  return : 0 on success, WOLFSSL_CBIO_ERR_WANT_WRITE when datagrams are left
+ *           queued, or error
+ */
+int wolfIO_DtlsSendFlush(WOLFSSL* ssl, void* ctx)
+{
+    WOLFSSL_DTLS_CTX* dtlsCtx = (WOLFSSL_DTLS_CTX*)ctx;
+
+    if (dtlsCtx->mmsg == NULL)
+        return 0;
+    if (dtlsCtx->mmsg->txDefer > 0 && --dtlsCtx->mmsg->txDefer > 0)
+        return 0;
+
+    return DtlsSendQueued(ssl, dtlsCtx);
+}
+
+/* Get whether datagrams read ahead are waiting to be processed. */
+int wolfIO_DtlsRecvPending(const void* ctx)
+{
+    const DtlsMmsg* mmsg = ((const WOLFSSL_DTLS_CTX*)ctx)->mmsg;
+
+    return mmsg != NULL && mmsg->rxIdx < mmsg->rxCnt;
+}
+
+void wolfIO_DtlsMmsgFree(void* ctx, void* heap)
+{
+    WOLFSSL_DTLS_CTX* dtlsCtx = (WOLFSSL_DTLS_CTX*)ctx;
+
+    if (dtlsCtx->mmsg != NULL) {
+        XFREE(dtlsCtx->mmsg->rxBuf, heap, DYNAMIC_TYPE_IN_BUFFER);
+        XFREE(dtlsCtx->mmsg->txBuf, heap, DYNAMIC_TYPE_OUT_BUFFER);
+        XFREE(dtlsCtx->mmsg, heap, DYNAMIC_TYPE_DTLS_MMSG);
+        dtlsCtx->mmsg = NULL;
+    }
+    (void)heap;
+}
+#endif /* WOLFSSL_DTLS_MMSG */
+
+/* The send embedded callback
+ *  return : nb bytes sent, or error
+ */
+int EmbedSendTo(WOLFSSL* ssl, char *buf, int sz, void *ctx)
+{
+    WOLFSSL_DTLS_CTX* dtlsCtx = (WOLFSSL_DTLS_CTX*)ctx;
+
+    WOLFSSL_ENTER("EmbedSendTo");
+
+#ifdef WOLFSSL_DTLS_MMSG
+    if (dtlsCtx->mmsg != NULL) {
+        int ret;
+
+        if (dtlsCtx->mmsg->txDefer > 0)
+            return DtlsSendToQueue(ssl, dtlsCtx, buf, sz);
+        /* Datagrams left queued when the socket was full go first. */
+        ret = DtlsSendQueued(ssl, dtlsCtx);
+        if (ret != 0)
+            return ret;
+    }
+#endif
+
+    return DtlsSendTo(ssl, dtlsCtx, buf, sz);
+}
+
 
 #ifdef WOLFSSL_MULTICAST
 
@@ -1140,6 +1465,139 @@ int wolfIO_Send(SOCKET_T sd, char *buf, int sz, int wrFlags)
     return sent;
 }
 
+#ifdef WOLFSSL_KTLS
+
+/* Attach the kernel TLS upper layer protocol to a connected TCP socket.
+ *
+ * @param [in] sd  Socket.
+ * @return  0 on success or when already attached.
+ * @return  WOLFSSL_CBIO_ERR_GENERAL when the kernel doesn't support TLS.
+ */
+int wolfIO_KtlsAttach(SOCKET_T sd)
+{
+    if (setsockopt(sd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 &&
+            errno != EEXIST) {
+        WOLFSSL_MSG("Kernel TLS not available on socket");
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+
+    return 0;
+}
+
+/* Give the kernel the record protection parameters for one direction.
+ *
+ * @param [in] sd      Socket with kernel TLS attached.
+ * @param [in] rx      1 for receiving and 0 for sending.
+ * @param [in] info    Kernel crypto info structure.
+ * @param [in] infoSz  Size of crypto info structure in bytes.
+ * @return  0 on success.
+ * @return  WOLFSSL_CBIO_ERR_GENERAL when the kernel rejects the parameters.
+ */
+int wolfIO_KtlsSetCrypto(SOCKET_T sd, int rx, const void* info, word32 infoSz)
+{
+    if (setsockopt(sd, SOL_TLS, rx ? TLS_RX : TLS_TX, info,
+            (socklen_t)infoSz) != 0) {
+        WOLFSSL_MSG("Kernel TLS rejected crypto parameters");
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+
+    return 0;
+}
+
+/* Send the plain text of a record of a given content type on a kernel TLS
+ * socket. Application data is sent with wolfIO_Send().
+ *
+ * @param [in] sd       Socket with kernel TLS sending on.
+ * @param [in] type     Record content type.
+ * @param [in] buf      Plain text of record.
+ * @param [in] sz       Size of plain text in bytes.
+ * @param [in] wrFlags  Flags for sendmsg().
+ * @return  Number of bytes sent on success.
+ * @return  WOLFSSL_CBIO_ERR_* value on failure.
+ */
+int wolfIO_SendRecord(SOCKET_T sd, byte type, char *buf, int sz, int wrFlags)
+{
+    struct msghdr   msg;
+    struct iovec    iov;
+    struct cmsghdr* cmsg;
+    union {
+        struct cmsghdr hdr;
+        byte           buf[CMSG_SPACE(sizeof(byte))];
+    } ctrl;
+    int sent;
+
+    XMEMSET(&msg, 0, sizeof(msg));
+    XMEMSET(&ctrl, 0, sizeof(ctrl));
+    iov.iov_base = buf;
+    iov.iov_len = (size_t)sz;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+
+    cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_TLS;
+    cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(byte));
+    *CMSG_DATA(cmsg) = type;
+    msg.msg_controllen = cmsg->cmsg_len;
+
+    sent = (int)sendmsg(sd, &msg, wrFlags);
+    sent = TranslateIoReturnCode(sent, sd, SOCKET_SENDING);
+
+    return sent;
+}
+
+/* Receive decrypted data from a kernel TLS socket.
+ *
+ * Data of only one content type is returned. The data of a record that is not
+ * application data is returned on its own.
+ *
+ * @param [in]  sd       Socket with kernel TLS receiving on.
+ * @param [out] type     Record content type of data.
+ * @param [out] buf      Buffer to hold data.
+ * @param [in]  sz       Size of buffer in bytes.
+ * @param [in]  rdFlags  Flags for recvmsg().
+ * @return  Number of bytes received on success.
+ * @return  0 when the connection was closed.
+ * @return  WOLFSSL_CBIO_ERR_* value on failure.
+ */
+int wolfIO_RecvRecord(SOCKET_T sd, byte* type, char *buf, int sz, int rdFlags)
+{
+    struct msghdr   msg;
+    struct iovec    iov;
+    struct cmsghdr* cmsg;
+    union {
+        struct cmsghdr hdr;
+        byte           buf[CMSG_SPACE(sizeof(byte))];
+    } ctrl;
+    int recvd;
+
+    XMEMSET(&msg, 0, sizeof(msg));
+    iov.iov_base = buf;
+    iov.iov_len = (size_t)sz;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+
+    recvd = (int)recvmsg(sd, &msg, rdFlags);
+    recvd = TranslateIoReturnCode(recvd, sd, SOCKET_RECEIVING);
+    if (recvd > 0) {
+        /* No control message means application data. */
+        *type = application_data;
+        cmsg = CMSG_FIRSTHDR(&msg);
+        if (cmsg != NULL && cmsg->cmsg_level == SOL_TLS &&
+                cmsg->cmsg_type == TLS_GET_RECORD_TYPE) {
+            *type = *CMSG_DATA(cmsg);
+        }
+    }
+
+    return recvd;
+}
+
+#endif /* WOLFSSL_KTLS */
+
 #if defined(WOLFSSL_HAVE_BIO_ADDR) && defined(WOLFSSL_DTLS) && defined(OPENSSL_EXTRA)
 
 int wolfIO_RecvFrom(SOCKET_T sd, WOLFSSL_BIO_ADDR *addr, char *buf, int sz, int rdFlags)
@@ -3740,4 +4198,842 @@ int wolfSSL_SetIO_ISOTP(WOLFSSL *ssl, isotp_wolfssl_ctx *ctx,
     return 0;
 }
 #endif
+
+#if defined(WOLFSSL_IO_URING) && defined(USE_WOLFSSL_IO)
+
+/* Largest registered buffer the kernel accepts. */
+#define IO_URING_MAX_REG_BUF_SZ     (1UL << 30)
+/* Entries in the submission queue - flushed to the kernel when full. */
+#define IO_URING_MAX_SQ_ENTRIES     4096
+
+/* Operation encoded in the low bits of the user data of a submission. */
+#define IO_URING_OP_RECV            0
+#define IO_URING_OP_SEND            1
+#define IO_URING_OP_CANCEL          2
+#define IO_URING_OP_MASK            3
+#define IO_URING_OP_BITS            2
+
+/* A connection on an io_uring.
+ *
+ * The staging buffers live in the ring so that an operation still in flight
+ * when the WOLFSSL object is freed never writes to freed memory.
+ */
+typedef struct WOLFSSL_URING_CONN {
+    WOLFSSL*          ssl;          /* NULL when free or detached */
+    WOLFSSL_URING*    ring;
+    byte*             rxBuf;
+    byte*             txBuf;
+    SOCKET_T          fd;
+    word32            rxIdx;        /* Next received byte to hand out */
+    word32            rxLen;        /* Bytes received into staging buffer */
+    word32            txIdx;        /* Next staged byte to send */
+    word32            txLen;        /* Bytes staged to send */
+    int               rxErr;        /* Receive error to report */
+    int               txErr;        /* Send error to report */
+    int               next;         /* Free or ready list link */
+    word16            bufIdx;       /* Index of registered buffer */
+    byte              rxPending:1;  /* Receive in flight */
+    byte              txPending:1;  /* Send in flight */
+    byte              ready:1;      /* On ready list */
+    byte              noFixed:1;    /* Fixed receive unusable on socket */
+} WOLFSSL_URING_CONN;
+
+struct WOLFSSL_URING {
+    void*                  heap;
+    int                    fd;          /* io_uring file descriptor */
+    /* Shared ring memory - submission and completion queues. */
+    byte*                  rings;
+    size_t                 ringsSz;
+    struct io_uring_sqe*   sqes;
+    size_t                 sqesSz;
+    unsigned*              sqHead;
+    unsigned*              sqTail;
+    unsigned*              sqArray;
+    unsigned               sqMask;
+    unsigned               sqEntries;
+    unsigned               sqLocalTail; /* Tail including unpublished */
+    unsigned               toSubmit;    /* Entries not yet entered */
+    unsigned*              cqHead;
+    unsigned*              cqTail;
+    unsigned               cqMask;
+    struct io_uring_cqe*   cqes;
+    /* Connections. */
+    WOLFSSL_URING_CONN* conns;
+    byte*                  bufs;        /* Staging buffers of connections */
+    int                    connCnt;
+    int                    connsPerBuf; /* Connections per registered buffer */
+    int                    freeHead;
+    int                    readyHead;
+    int                    readyTail;
+    word32                 inFlight;    /* Receives and sends in flight */
+    WOLFSSL_URING_STATS stats;
+};
+
+/* Hand the published submissions to the kernel.
+ *
+ * @param [in, out] ring    io_uring object.
+ * @param [in]      waitNr  Number of completions to wait for.
+ * @return  0 on success.
+ * @return  Negative errno value on failure.
+ */
+static int IoUringEnter(WOLFSSL_URING* ring, unsigned waitNr)
+{
+    int ret;
+
+    /* Entries must be visible to the kernel before the tail is. */
+    __atomic_store_n(ring->sqTail, ring->sqLocalTail, __ATOMIC_RELEASE);
+    do {
+        ring->stats.enters++;
+        ret = (int)syscall(__NR_io_uring_enter, ring->fd, ring->toSubmit,
+            waitNr, (waitNr > 0) ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        return -errno;
+    }
+
+    ring->toSubmit -= (unsigned)ret;
+    ring->stats.submitted += (word32)ret;
+    return 0;
+}
+
+/* Get a cleared submission queue entry.
+ *
+ * @param [in, out] ring  io_uring object.
+ * @return  Submission queue entry on success.
+ * @return  NULL when the queue is full and can't be flushed.
+ */
+static struct io_uring_sqe* IoUringGetSqe(WOLFSSL_URING* ring)
+{
+    struct io_uring_sqe* sqe;
+
+    if (ring->sqLocalTail - __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE) >=
+            ring->sqEntries) {
+        if (IoUringEnter(ring, 0) != 0 || ring->sqLocalTail -
+                __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE) >=
+                ring->sqEntries) {
+            WOLFSSL_MSG("io_uring submission queue full");
+            return NULL;
+        }
+    }
+
+    sqe = &ring->sqes[ring->sqLocalTail & ring->sqMask];
+    XMEMSET(sqe, 0, sizeof(*sqe));
+    ring->sqLocalTail++;
+    ring->toSubmit++;
+    return sqe;
+}
+
+/* User data identifying the connection and operation of a submission. */
+static WC_INLINE word64 IoUringData(WOLFSSL_URING* ring,
+    WOLFSSL_URING_CONN* conn, int op)
+{
+    return ((word64)(conn - ring->conns) << IO_URING_OP_BITS) | (word64)op;
+}
+
+/* Queue a receive into the connection's staging buffer.
+ *
+ * @param [in, out] ring  io_uring object.
+ * @param [in, out] conn  Connection.
+ * @return  0 on success.
+ * @return  WOLFSSL_CBIO_ERR_GENERAL when the queue is full.
+ */
+static int IoUringQueueRecv(WOLFSSL_URING* ring,
+    WOLFSSL_URING_CONN* conn)
+{
+    struct io_uring_sqe* sqe = IoUringGetSqe(ring);
+
+    if (sqe == NULL) {
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+    if (ring->stats.fixed && !conn->noFixed) {
+        /* Pages pinned at registration - no per receive page lookup. */
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->buf_index = conn->bufIdx;
+    }
+    else {
+        sqe->opcode = IORING_OP_RECV;
+    }
+    sqe->fd = conn->fd;
+    sqe->addr = (word64)(wc_ptr_t)conn->rxBuf;
+    sqe->len = WOLFSSL_IO_URING_BUF_SZ;
+    sqe->user_data = IoUringData(ring, conn, IO_URING_OP_RECV);
+    conn->rxPending = 1;
+    ring->inFlight++;
+    return 0;
+}
+
+/* Queue a send of the data staged on the connection.
+ *
+ * A write of a socket raises SIGPIPE on a reset connection so sends are
+ * always socket sends with MSG_NOSIGNAL.
+ *
+ * @param [in, out] ring  io_uring object.
+ * @param [in, out] conn  Connection.
+ * @return  0 on success.
+ * @return  WOLFSSL_CBIO_ERR_GENERAL when the queue is full.
+ */
+static int IoUringQueueSend(WOLFSSL_URING* ring,
+    WOLFSSL_URING_CONN* conn)
+{
+    struct io_uring_sqe* sqe = IoUringGetSqe(ring);
+
+    if (sqe == NULL) {
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = conn->fd;
+    sqe->addr = (word64)(wc_ptr_t)(conn->txBuf + conn->txIdx);
+    sqe->len = conn->txLen - conn->txIdx;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = IoUringData(ring, conn, IO_URING_OP_SEND);
+    conn->txPending = 1;
+    ring->inFlight++;
+    return 0;
+}
+
+/* Put a detached connection back on the free list once nothing refers to it.
+ *
+ * @param [in, out] ring  io_uring object.
+ * @param [in, out] conn  Connection.
+ */
+static void IoUringConnRelease(WOLFSSL_URING* ring,
+    WOLFSSL_URING_CONN* conn)
+{
+    if (conn->ssl == NULL && !conn->rxPending && !conn->txPending &&
+            !conn->ready) {
+        conn->next = ring->freeHead;
+        ring->freeHead = (int)(conn - ring->conns);
+    }
+}
+
+/* Convert the negative errno of a completion to an I/O callback error.
+ *
+ * @param [in] res  Result of completion.
+ * @return  WOLFSSL_CBIO_ERR_* value.
+ */
+static int IoUringError(int res)
+{
+    switch (-res) {
+        case ECONNRESET:
+        case ECONNABORTED:
+        case EPIPE:
+            WOLFSSL_MSG("\tConnection reset");
+            return WOLFSSL_CBIO_ERR_CONN_RST;
+        case ETIMEDOUT:
+            WOLFSSL_MSG("\tTimed out");
+            return WOLFSSL_CBIO_ERR_TIMEOUT;
+        default:
+            WOLFSSL_MSG("\tGeneral error");
+            return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+}
+
+/* Process a completion.
+ *
+ * @param [in, out] ring  io_uring object.
+ * @param [in]      data  User data of the submission.
+ * @param [in]      res   Result of the operation.
+ */
+static void IoUringComplete(WOLFSSL_URING* ring, word64 data, int res)
+{
+    WOLFSSL_URING_CONN* conn = &ring->conns[data >> IO_URING_OP_BITS];
+    int op = (int)(data & IO_URING_OP_MASK);
+
+    if (op == IO_URING_OP_CANCEL) {
+        return;
+    }
+    ring->inFlight--;
+
+    if (op == IO_URING_OP_RECV) {
+        conn->rxPending = 0;
+        if (res > 0) {
+            conn->rxIdx = 0;
+            conn->rxLen = (word32)res;
+        }
+        else if (res == 0) {
+            conn->rxErr = WOLFSSL_CBIO_ERR_CONN_CLOSE;
+        }
+        else if (res == -EAGAIN || res == -EINTR) {
+            /* Fixed buffer reads of a non-blocking socket don't wait. */
+            conn->noFixed = 1;
+            if (conn->ssl != NULL &&
+                    IoUringQueueRecv(ring, conn) != 0) {
+                conn->rxErr = WOLFSSL_CBIO_ERR_GENERAL;
+            }
+        }
+        else {
+            conn->rxErr = IoUringError(res);
+        }
+    }
+    else {
+        conn->txPending = 0;
+        if (res > 0) {
+            conn->txIdx += (word32)res;
+            if (conn->txIdx == conn->txLen) {
+                conn->txIdx = 0;
+                conn->txLen = 0;
+            }
+        }
+        else if (res < 0 && res != -EAGAIN && res != -EINTR) {
+            conn->txErr = IoUringError(res);
+        }
+        /* Send the rest - including data staged while in flight. */
+        if (conn->ssl != NULL && conn->txErr == 0 &&
+                conn->txLen > conn->txIdx &&
+                IoUringQueueSend(ring, conn) != 0) {
+            conn->txErr = WOLFSSL_CBIO_ERR_GENERAL;
+        }
+    }
+
+    if (conn->ssl == NULL) {
+        IoUringConnRelease(ring, conn);
+    }
+    else if (!conn->ready) {
+        conn->ready = 1;
+        conn->next = -1;
+        if (ring->readyTail >= 0) {
+            ring->conns[ring->readyTail].next = (int)(conn - ring->conns);
+        }
+        else {
+            ring->readyHead = (int)(conn - ring->conns);
+        }
+        ring->readyTail = (int)(conn - ring->conns);
+    }
+}
+
+/* Process all available completions.
+ *
+ * @param [in, out] ring  io_uring object.
+ */
+static void IoUringReap(WOLFSSL_URING* ring)
+{
+    unsigned head = *ring->cqHead;
+    unsigned tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+
+    while (head != tail) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & ring->cqMask];
+
+        IoUringComplete(ring, (word64)cqe->user_data, cqe->res);
+        ring->stats.completed++;
+        head++;
+    }
+    __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+}
+
+/* Receive callback: hand out staged data or queue a receive.
+ *
+ * @param [in]      ssl  SSL/TLS object.
+ * @param [out]     buf  Buffer to hold data.
+ * @param [in]      sz   Size of buffer in bytes.
+ * @param [in, out] ctx  io_uring connection.
+ * @return  Number of bytes received on success.
+ * @return  WOLFSSL_CBIO_ERR_WANT_READ when waiting on a completion.
+ * @return  Other WOLFSSL_CBIO_ERR_* value on failure.
+ */
+static int IoUringReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    WOLFSSL_URING_CONN* conn = (WOLFSSL_URING_CONN*)ctx;
+    int ret;
+
+    (void)ssl;
+
+    if (conn->rxLen > conn->rxIdx) {
+        ret = (int)(conn->rxLen - conn->rxIdx);
+        if (ret > sz) {
+            ret = sz;
+        }
+        XMEMCPY(buf, conn->rxBuf + conn->rxIdx, (size_t)ret);
+        conn->rxIdx += (word32)ret;
+        if (conn->rxIdx == conn->rxLen) {
+            conn->rxIdx = 0;
+            conn->rxLen = 0;
+        }
+        return ret;
+    }
+    if (conn->rxErr != 0) {
+        return conn->rxErr;
+    }
+    if (!conn->rxPending) {
+        ret = IoUringQueueRecv(conn->ring, conn);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+
+    return WOLFSSL_CBIO_ERR_WANT_READ;
+}
+
+/* Send callback: stage data and queue a send when none is in flight.
+ *
+ * @param [in]      ssl  SSL/TLS object.
+ * @param [in]      buf  Data to send.
+ * @param [in]      sz   Size of data in bytes.
+ * @param [in, out] ctx  io_uring connection.
+ * @return  Number of bytes staged on success.
+ * @return  WOLFSSL_CBIO_ERR_WANT_WRITE when the staging buffer is full.
+ * @return  Other WOLFSSL_CBIO_ERR_* value on failure.
+ */
+static int IoUringSend(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    WOLFSSL_URING_CONN* conn = (WOLFSSL_URING_CONN*)ctx;
+    word32 room;
+    int ret;
+
+    (void)ssl;
+
+    if (conn->txErr != 0) {
+        return conn->txErr;
+    }
+    if (!conn->txPending && conn->txIdx > 0) {
+        XMEMMOVE(conn->txBuf, conn->txBuf + conn->txIdx,
+            conn->txLen - conn->txIdx);
+        conn->txLen -= conn->txIdx;
+        conn->txIdx = 0;
+    }
+    room = WOLFSSL_IO_URING_BUF_SZ - conn->txLen;
+    if (room == 0) {
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    }
+    if ((word32)sz > room) {
+        sz = (int)room;
+    }
+    XMEMCPY(conn->txBuf + conn->txLen, buf, (size_t)sz);
+    conn->txLen += (word32)sz;
+    if (!conn->txPending) {
+        ret = IoUringQueueSend(conn->ring, conn);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+
+    return sz;
+}
+
+/* Map the shared queues of a newly set up ring.
+ *
+ * @param [in, out] ring  io_uring object.
+ * @param [in]      p     Parameters returned by setup.
+ * @return  0 on success.
+ * @return  -1 on failure.
+ */
+static int IoUringMap(WOLFSSL_URING* ring, struct io_uring_params* p)
+{
+    size_t sqSz = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+    size_t cqSz = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+    void* mem;
+    unsigned i;
+
+    /* One mapping for both queues since Linux 5.4. */
+    if ((p->features & IORING_FEAT_SINGLE_MMAP) == 0) {
+        WOLFSSL_MSG("io_uring single mmap not supported");
+        return -1;
+    }
+
+    ring->ringsSz = (sqSz > cqSz) ? sqSz : cqSz;
+    mem = mmap(NULL, ring->ringsSz, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (mem == MAP_FAILED) {
+        return -1;
+    }
+    ring->rings = (byte*)mem;
+
+    ring->sqesSz = p->sq_entries * sizeof(struct io_uring_sqe);
+    mem = mmap(NULL, ring->sqesSz, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (mem == MAP_FAILED) {
+        return -1;
+    }
+    ring->sqes = (struct io_uring_sqe*)mem;
+
+    ring->sqHead = (unsigned*)(ring->rings + p->sq_off.head);
+    ring->sqTail = (unsigned*)(ring->rings + p->sq_off.tail);
+    ring->sqArray = (unsigned*)(ring->rings + p->sq_off.array);
+    ring->sqMask = *(unsigned*)(ring->rings + p->sq_off.ring_mask);
+    ring->sqEntries = *(unsigned*)(ring->rings + p->sq_off.ring_entries);
+    ring->sqLocalTail = *ring->sqTail;
+    ring->cqHead = (unsigned*)(ring->rings + p->cq_off.head);
+    ring->cqTail = (unsigned*)(ring->rings + p->cq_off.tail);
+    ring->cqMask = *(unsigned*)(ring->rings + p->cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(ring->rings + p->cq_off.cqes);
+
+    /* Entries are always used in order - fix the indirection array. */
+    for (i = 0; i < ring->sqEntries; i++) {
+        ring->sqArray[i] = i;
+    }
+
+    return 0;
+}
+
+/* Register the staging buffers so the kernel pins their pages once.
+ *
+ * @param [in, out] ring  io_uring object.
+ */
+static void IoUringRegisterBuffers(WOLFSSL_URING* ring)
+{
+    size_t connSz = 2 * (size_t)WOLFSSL_IO_URING_BUF_SZ;
+    struct iovec* iov;
+    int cnt;
+    int i;
+
+    ring->connsPerBuf = (int)(IO_URING_MAX_REG_BUF_SZ / connSz);
+    cnt = (ring->connCnt + ring->connsPerBuf - 1) / ring->connsPerBuf;
+
+    iov = (struct iovec*)XMALLOC(sizeof(*iov) * (size_t)cnt, ring->heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (iov == NULL) {
+        return;
+    }
+    for (i = 0; i < cnt; i++) {
+        int conns = ring->connCnt - i * ring->connsPerBuf;
+
+        if (conns > ring->connsPerBuf) {
+            conns = ring->connsPerBuf;
+        }
+        iov[i].iov_base = ring->bufs + (size_t)i * ring->connsPerBuf * connSz;
+        iov[i].iov_len = (size_t)conns * connSz;
+    }
+    if (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS,
+            iov, cnt) == 0) {
+        ring->stats.fixed = 1;
+    }
+    else {
+        /* Locked memory limit - fall back to regular receives. */
+        WOLFSSL_MSG("io_uring buffer registration failed");
+    }
+    XFREE(iov, ring->heap, DYNAMIC_TYPE_TMP_BUFFER);
+}
+
+/* Create an io_uring for the I/O of many connections.
+ *
+ * Each connection gets a receive and a send staging buffer of
+ * WOLFSSL_IO_URING_BUF_SZ bytes from one allocation made here.
+ *
+ * @param [in] conns  Maximum number of connections on the ring.
+ * @param [in] flags  WOLFSSL_IO_URING_FIXED_BUFFERS or 0.
+ * @param [in] heap   Dynamic memory allocation hint.
+ * @return  io_uring object on success.
+ * @return  NULL when conns or flags is invalid, on allocation failure or when
+ *          the kernel doesn't support io_uring.
+ */
+WOLFSSL_URING* wolfSSL_IoUring_new(int conns, int flags, void* heap)
+{
+    WOLFSSL_URING* ring;
+    struct io_uring_params p;
+    unsigned sqEntries;
+    size_t connSz = 2 * (size_t)WOLFSSL_IO_URING_BUF_SZ;
+    int i;
+
+    WOLFSSL_ENTER("wolfSSL_IoUring_new");
+
+    if (conns <= 0 || conns > WOLFSSL_IO_URING_MAX_CONNS ||
+            (flags & ~WOLFSSL_IO_URING_FIXED_BUFFERS) != 0) {
+        return NULL;
+    }
+
+    ring = (WOLFSSL_URING*)XMALLOC(sizeof(*ring), heap,
+        DYNAMIC_TYPE_IO_URING);
+    if (ring == NULL) {
+        return NULL;
+    }
+    XMEMSET(ring, 0, sizeof(*ring));
+    ring->heap = heap;
+    ring->fd = -1;
+    ring->connCnt = conns;
+    ring->readyHead = -1;
+    ring->readyTail = -1;
+
+    ring->conns = (WOLFSSL_URING_CONN*)XMALLOC(
+        sizeof(WOLFSSL_URING_CONN) * (size_t)conns, heap,
+        DYNAMIC_TYPE_IO_URING);
+    ring->bufs = (byte*)XMALLOC(connSz * (size_t)conns, heap,
+        DYNAMIC_TYPE_IO_URING);
+    if (ring->conns == NULL || ring->bufs == NULL) {
+        wolfSSL_IoUring_free(ring);
+        return NULL;
+    }
+    XMEMSET(ring->conns, 0, sizeof(WOLFSSL_URING_CONN) * (size_t)conns);
+    ring->connsPerBuf = conns;
+    ring->freeHead = -1;
+    for (i = conns - 1; i >= 0; i--) {
+        ring->conns[i].ring = ring;
+        ring->conns[i].rxBuf = ring->bufs + (size_t)i * connSz;
+        ring->conns[i].txBuf = ring->conns[i].rxBuf + WOLFSSL_IO_URING_BUF_SZ;
+        ring->conns[i].next = ring->freeHead;
+        ring->freeHead = i;
+    }
+
+    /* Completion queue holds a receive and a send of every connection. */
+    sqEntries = (unsigned)conns * 2;
+    if (sqEntries > IO_URING_MAX_SQ_ENTRIES) {
+        sqEntries = IO_URING_MAX_SQ_ENTRIES;
+    }
+    XMEMSET(&p, 0, sizeof(p));
+    p.flags = IORING_SETUP_CQSIZE;
+    p.cq_entries = (unsigned)conns * 2;
+    ring->fd = (int)syscall(__NR_io_uring_setup, sqEntries, &p);
+    if (ring->fd < 0 || IoUringMap(ring, &p) != 0) {
+        WOLFSSL_MSG("io_uring setup failed");
+        wolfSSL_IoUring_free(ring);
+        return NULL;
+    }
+
+    if ((flags & WOLFSSL_IO_URING_FIXED_BUFFERS) != 0) {
+        IoUringRegisterBuffers(ring);
+    }
+    for (i = 0; i < conns; i++) {
+        ring->conns[i].bufIdx = (word16)(i / ring->connsPerBuf);
+    }
+
+    return ring;
+}
+
+/* Free an io_uring.
+ *
+ * Closing the ring cancels all operations in flight. Connections still
+ * attached are left without I/O callbacks.
+ *
+ * @param [in] ring  io_uring object.
+ */
+void wolfSSL_IoUring_free(WOLFSSL_URING* ring)
+{
+    void* heap;
+    int i;
+
+    if (ring == NULL) {
+        return;
+    }
+    heap = ring->heap;
+
+    if (ring->conns != NULL) {
+        for (i = 0; i < ring->connCnt; i++) {
+            WOLFSSL* ssl = ring->conns[i].ssl;
+
+            if (ssl != NULL) {
+                ssl->ioUringConn = NULL;
+                wolfSSL_SSLSetIORecv(ssl, NULL);
+                wolfSSL_SSLSetIOSend(ssl, NULL);
+                wolfSSL_SetIOReadCtx(ssl, NULL);
+                wolfSSL_SetIOWriteCtx(ssl, NULL);
+            }
+        }
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    if (ring->sqes != NULL) {
+        munmap(ring->sqes, ring->sqesSz);
+    }
+    if (ring->rings != NULL) {
+        munmap(ring->rings, ring->ringsSz);
+    }
+    XFREE(ring->bufs, heap, DYNAMIC_TYPE_IO_URING);
+    XFREE(ring->conns, heap, DYNAMIC_TYPE_IO_URING);
+    XFREE(ring, heap, DYNAMIC_TYPE_IO_URING);
+}
+
+/* Do the I/O of an SSL/TLS object through an io_uring.
+ *
+ * The socket set with wolfSSL_set_fd() is used. Receives and sends are
+ * queued on the ring and only handed to the kernel, together with those of
+ * other connections, by wolfSSL_IoUring_Submit().
+ *
+ * @param [in, out] ssl   SSL/TLS object.
+ * @param [in, out] ring  io_uring object.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when ssl or ring is NULL.
+ * @return  BAD_STATE_E when already on a ring, the connection is DTLS or the
+ *          socket isn't set.
+ * @return  MEMORY_E when the ring has no free connections.
+ */
+int wolfSSL_SetIO_IoUring(WOLFSSL* ssl, WOLFSSL_URING* ring)
+{
+    WOLFSSL_URING_CONN* conn;
+
+    WOLFSSL_ENTER("wolfSSL_SetIO_IoUring");
+
+    if (ssl == NULL || ring == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    if (ssl->ioUringConn != NULL || ssl->options.dtls ||
+            ssl->rfd == SOCKET_INVALID || ssl->rfd != ssl->wfd) {
+        return BAD_STATE_E;
+    }
+    if (ring->freeHead < 0) {
+        WOLFSSL_MSG("io_uring has no free connections");
+        return MEMORY_E;
+    }
+
+    conn = &ring->conns[ring->freeHead];
+    ring->freeHead = conn->next;
+    conn->ssl = ssl;
+    conn->fd = ssl->rfd;
+    conn->rxIdx = 0;
+    conn->rxLen = 0;
+    conn->txIdx = 0;
+    conn->txLen = 0;
+    conn->rxErr = 0;
+    conn->txErr = 0;
+    conn->noFixed = 0;
+    ssl->ioUringConn = conn;
+
+    wolfSSL_SSLSetIORecv(ssl, IoUringReceive);
+    wolfSSL_SSLSetIOSend(ssl, IoUringSend);
+    wolfSSL_SetIOReadCtx(ssl, conn);
+    wolfSSL_SetIOWriteCtx(ssl, conn);
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Take an SSL/TLS object off its io_uring - called when freed.
+ *
+ * Operations in flight are cancelled so the socket can be closed. The
+ * connection is reused once their completions are reaped.
+ *
+ * @param [in, out] ssl  SSL/TLS object.
+ */
+void wolfIO_IoUringDetach(WOLFSSL* ssl)
+{
+    WOLFSSL_URING_CONN* conn = ssl->ioUringConn;
+    WOLFSSL_URING* ring;
+    struct io_uring_sqe* sqe;
+    int op;
+
+    if (conn == NULL) {
+        return;
+    }
+    ring = conn->ring;
+    ssl->ioUringConn = NULL;
+    conn->ssl = NULL;
+
+    for (op = IO_URING_OP_RECV; op <= IO_URING_OP_SEND; op++) {
+        if ((op == IO_URING_OP_RECV) ? conn->rxPending : conn->txPending) {
+            sqe = IoUringGetSqe(ring);
+            if (sqe != NULL) {
+                sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                sqe->addr = IoUringData(ring, conn, op);
+                sqe->user_data = IoUringData(ring, conn, IO_URING_OP_CANCEL);
+            }
+        }
+    }
+    if (ring->toSubmit > 0) {
+        (void)IoUringEnter(ring, 0);
+    }
+
+    IoUringConnRelease(ring, conn);
+}
+
+/* Submit the queued operations of all connections and reap completions.
+ *
+ * Connections with completed operations are returned so that the
+ * application can call wolfSSL_accept(), wolfSSL_read(), wolfSSL_write(),
+ * ... on them again. Connections that don't fit are returned by the next
+ * call.
+ *
+ * @param [in, out] ring     io_uring object.
+ * @param [in]      wait     Wait for a completion when none are available
+ *                           and operations are in flight.
+ * @param [out]     ready    Connections with completed operations.
+ * @param [in]      readySz  Number of entries in ready.
+ * @return  Number of connections put in ready on success.
+ * @return  BAD_FUNC_ARG when ring is NULL or ready is NULL with readySz
+ *          greater than 0.
+ * @return  SOCKET_ERROR_E when the kernel fails the submission.
+ */
+int wolfSSL_IoUring_Submit(WOLFSSL_URING* ring, int wait, WOLFSSL** ready,
+    int readySz)
+{
+    unsigned waitNr = 0;
+    int ret;
+    int cnt = 0;
+
+    if (ring == NULL || readySz < 0 || (ready == NULL && readySz > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (wait && ring->readyHead < 0 && ring->inFlight > 0 &&
+            *ring->cqHead == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE)) {
+        waitNr = 1;
+    }
+    if (ring->toSubmit > 0 || waitNr > 0) {
+        ret = IoUringEnter(ring, waitNr);
+        if (ret == -EBUSY) {
+            /* Completions overflowed - make room and try again. */
+            IoUringReap(ring);
+            ret = IoUringEnter(ring, 0);
+        }
+        if (ret != 0) {
+            WOLFSSL_MSG("io_uring_enter failed");
+            return SOCKET_ERROR_E;
+        }
+    }
+    IoUringReap(ring);
+
+    while (cnt < readySz && ring->readyHead >= 0) {
+        WOLFSSL_URING_CONN* conn = &ring->conns[ring->readyHead];
+
+        ring->readyHead = conn->next;
+        if (ring->readyHead < 0) {
+            ring->readyTail = -1;
+        }
+        conn->ready = 0;
+        if (conn->ssl != NULL) {
+            ready[cnt++] = conn->ssl;
+        }
+        else {
+            IoUringConnRelease(ring, conn);
+        }
+    }
+
+    return cnt;
+}
+
+/* Get the number of bytes staged to send but not yet sent.
+ *
+ * @param [in] ssl  SSL/TLS object.
+ * @return  Number of bytes waiting to be sent.
+ * @return  BAD_FUNC_ARG when ssl is NULL or not on an io_uring.
+ */
+int wolfSSL_IoUring_Pending(WOLFSSL* ssl)
+{
+    if (ssl == NULL || ssl->ioUringConn == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    return (int)(ssl->ioUringConn->txLen - ssl->ioUringConn->txIdx);
+}
+
+/* Get the statistics of an io_uring.
+ *
+ * @param [in]  ring   io_uring object.
+ * @param [out] stats  Statistics.
+ * @return  WOLFSSL_SUCCESS on success.
+ * @return  BAD_FUNC_ARG when ring or stats is NULL.
+ */
+int wolfSSL_IoUring_GetStats(WOLFSSL_URING* ring,
+    WOLFSSL_URING_STATS* stats)
+{
+    if (ring == NULL || stats == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    *stats = ring->stats;
+    return WOLFSSL_SUCCESS;
+}
+
+/* Get the file descriptor of an io_uring.
+ *
+ * The descriptor is readable when completions are waiting. Use it to wait on
+ * the ring together with other descriptors, such as a listening socket,
+ * after calling wolfSSL_IoUring_Submit() without waiting.
+ *
+ * @param [in] ring  io_uring object.
+ * @return  File descriptor on success.
+ * @return  BAD_FUNC_ARG when ring is NULL.
+ */
+int wolfSSL_IoUring_GetFd(WOLFSSL_URING* ring)
+{
+    if (ring == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    return ring->fd;
+}
+#endif /* WOLFSSL_IO_URING && USE_WOLFSSL_IO */
 #endif /* WOLFCRYPT_ONLY */
@@ -154,6 +154,9 @@
         #include <wolfssl/wolfcrypt/compress.h>
     #endif
 #endif
+#if defined(WOLFSSL_CERT_COMPRESSION) && defined(HAVE_LIBZ)
+    #include <wolfssl/wolfcrypt/compress.h>
+#endif
 
 #ifdef WOLFSSL_SMALL_CERT_VERIFY
     #include <wolfssl/wolfcrypt/asn.h>
@@ -291,6 +294,11 @@
 #define WOLFSSL_MISC_INCLUDED
 #include <wolfcrypt/src/misc.c>
 
+#if !defined(NO_SESSION_CACHE) && defined(SESSION_CACHE_SHARED_MEM)
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
 
 
 #if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
@@ -3158,6 +3166,851 @@ static int test_wolfSSL_CertManagerSetVerify(void)
     return EXPECT_RESULT();
 }
 
+static int test_wolfSSL_CertManagerSignerKeyCache(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_SIGNER_KEY_CACHE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_RSA) && defined(HAVE_ECC) && !defined(NO_WOLFSSL_CM_VERIFY)
+    const char* caFiles[2] = { "./certs/ca-cert.pem", "./certs/ca-ecc-cert.pem" };
+    const char* certFiles[2] = { "./certs/server-cert.der",
+                                 "./certs/server-ecc.der" };
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    Signer* signer;
+    byte* cert = NULL;
+    size_t certSz = 0;
+    int keyObjs;
+    int i;
+    int j;
+
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+    for (i = 0; i < 2; i++) {
+        ExpectIntEQ(wolfSSL_CertManagerLoadCA(cm, caFiles[i], NULL),
+            WOLFSSL_SUCCESS);
+    }
+
+    for (i = 0; i < 2; i++) {
+        ExpectIntEQ(load_file(certFiles[i], &cert, &certSz), 0);
+        /* First verification decodes the CA key and keeps the object. */
+        for (j = 0; j < 2; j++) {
+            ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, cert,
+                (long)certSz, WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+        }
+        /* Bad signature still fails with the cached key. */
+        if (cert != NULL) {
+            cert[certSz - 1] ^= 0x01;
+        }
+        ExpectIntNE(wolfSSL_CertManagerVerifyBuffer(cm, cert, (long)certSz,
+            WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+        if (cert != NULL) {
+            cert[certSz - 1] ^= 0x01;
+        }
+        ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, cert, (long)certSz,
+            WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+        free(cert);
+        cert = NULL;
+    }
+
+    /* Both CAs have a decoded key and none is held by a verification. */
+    keyObjs = 0;
+    for (i = 0; (cm != NULL) && (i < CA_TABLE_SIZE); i++) {
+        for (signer = cm->caTable[i]; signer != NULL; signer = signer->next) {
+            ExpectNotNull(signer->keyCache);
+            if ((signer->keyCache != NULL) && (signer->keyCache->obj != NULL)) {
+                keyObjs++;
+            }
+            if (signer->keyCache != NULL) {
+                ExpectIntEQ(signer->keyCache->busy, 0);
+            }
+        }
+    }
+    ExpectIntEQ(keyObjs, 2);
+
+    wolfSSL_CertManagerFree(cm);
+#endif
+
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_CertManagerVerifyCache(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_CERT_VERIFY_CACHE) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_RSA)
+    const char* caFile = "./certs/ca-cert.pem";
+    const char* certFile = "./certs/server-cert.der";
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    WOLFSSL_CERT_VERIFY_CACHE_STATS stats;
+    byte* cert = NULL;
+    size_t certSz = 0;
+
+    XMEMSET(&stats, 0, sizeof(stats));
+
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+    ExpectIntEQ(wolfSSL_CertManagerSetVerifyCache(NULL, 8, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(NULL, &stats),
+        BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, NULL),
+        BAD_FUNC_ARG);
+    /* Not enabled by default. */
+    ExpectIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &stats),
+        BAD_STATE_E);
+    ExpectIntEQ(wolfSSL_CertManagerSetVerifyCache(cm, 8, 0), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCA(cm, caFile, NULL), WOLFSSL_SUCCESS);
+    ExpectIntEQ(load_file(certFile, &cert, &certSz), 0);
+
+    /* First verification checks signature and caches result. */
+    ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, cert, (long)certSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.misses, 1);
+    ExpectIntEQ(stats.hits, 0);
+    ExpectIntEQ(stats.entries, 1);
+    /* Second verification uses cached result. */
+    ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, cert, (long)certSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.misses, 1);
+    ExpectIntEQ(stats.hits, 1);
+
+    /* Bad signature is not found in cache, fails and is not cached. */
+    if (cert != NULL) {
+        cert[certSz - 1] ^= 0x01;
+    }
+    ExpectIntNE(wolfSSL_CertManagerVerifyBuffer(cm, cert, (long)certSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntNE(wolfSSL_CertManagerVerifyBuffer(cm, cert, (long)certSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.misses, 3);
+    ExpectIntEQ(stats.hits, 1);
+    ExpectIntEQ(stats.entries, 1);
+    if (cert != NULL) {
+        cert[certSz - 1] ^= 0x01;
+    }
+
+    /* Resizing discards results. */
+    ExpectIntEQ(wolfSSL_CertManagerSetVerifyCache(cm, 1, 60), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, cert, (long)certSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.misses, 1);
+    ExpectIntEQ(stats.hits, 0);
+
+    /* Disable cache. */
+    ExpectIntEQ(wolfSSL_CertManagerSetVerifyCache(cm, 0, 0), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerGetVerifyCacheStats(cm, &stats),
+        BAD_STATE_E);
+    ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, cert, (long)certSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+
+    free(cert);
+    wolfSSL_CertManagerFree(cm);
+#endif
+
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_CertManagerCaIndex(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_CA_INDEX) && defined(WOLFSSL_CERT_GEN) && \
+    defined(WOLFSSL_CERT_EXT) && defined(HAVE_ECC) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    /* More CAs than fit in the smallest index. */
+    #define CA_INDEX_TEST_CNT (WOLFSSL_CA_INDEX_MIN_SZ / 2 + 8)
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    WC_RNG rng;
+    ecc_key key;
+    Cert cert;
+    byte* der[CA_INDEX_TEST_CNT];
+    int derSz[CA_INDEX_TEST_CNT];
+    byte leaf[FOURK_BUF];
+    int leafSz = 0;
+    int i;
+
+    XMEMSET(&rng, 0, sizeof(rng));
+    XMEMSET(&key, 0, sizeof(key));
+    XMEMSET(der, 0, sizeof(der));
+    XMEMSET(derSz, 0, sizeof(derSz));
+
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+    ExpectIntEQ(wc_ecc_init(&key), 0);
+    ExpectIntEQ(wc_ecc_make_key(&rng, 32, &key), 0);
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+
+    /* Self-signed CAs with the same key but different names and SKIDs. */
+    for (i = 0; i < CA_INDEX_TEST_CNT; i++) {
+        ExpectNotNull(der[i] = (byte*)XMALLOC(FOURK_BUF, HEAP_HINT,
+            DYNAMIC_TYPE_TMP_BUFFER));
+        ExpectIntEQ(wc_InitCert(&cert), 0);
+        (void)XSNPRINTF(cert.subject.commonName, CTC_NAME_SIZE,
+            "CA index test %d", i);
+        XSTRNCPY(cert.issuer.commonName, cert.subject.commonName,
+            CTC_NAME_SIZE);
+        cert.isCA = 1;
+        cert.sigType = CTC_SHA256wECDSA;
+        XMEMSET(cert.skid, 0xa5, KEYID_SIZE);
+        cert.skid[0] = (byte)i;
+        cert.skidSz = KEYID_SIZE;
+        ExpectIntGT(wc_MakeCert_ex(&cert, der[i], FOURK_BUF, ECC_TYPE, &key,
+            &rng), 0);
+        ExpectIntGT(derSz[i] = wc_SignCert_ex(cert.bodySz, cert.sigType,
+            der[i], FOURK_BUF, ECC_TYPE, &key, &rng), 0);
+        ExpectIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, der[i], derSz[i],
+            WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+        if (cm != NULL) {
+            ExpectNotNull(cm->caIndex);
+        }
+        if ((cm != NULL) && (cm->caIndex != NULL)) {
+            ExpectIntEQ(cm->caIndex->count, i + 1);
+        }
+        /* Loading again doesn't add a signer. */
+        ExpectIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, der[i], derSz[i],
+            WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+        if ((cm != NULL) && (cm->caIndex != NULL)) {
+            ExpectIntEQ(cm->caIndex->count, i + 1);
+        }
+    }
+    /* Index has grown and kept the old one for concurrent readers. */
+    if ((cm != NULL) && (cm->caIndex != NULL)) {
+        ExpectIntGT(cm->caIndex->mask + 1, WOLFSSL_CA_INDEX_MIN_SZ);
+        ExpectNotNull(cm->caIndexRetired);
+    }
+
+    /* Found by SKID. */
+    for (i = 0; i < CA_INDEX_TEST_CNT; i++) {
+        ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, der[i], derSz[i],
+            WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    }
+
+    /* Leaf without AKID: CA found by subject name. */
+    ExpectIntEQ(wc_InitCert(&cert), 0);
+    XSTRNCPY(cert.subject.commonName, "CA index test leaf", CTC_NAME_SIZE);
+    cert.sigType = CTC_SHA256wECDSA;
+    ExpectIntEQ(wc_SetIssuerBuffer(&cert, der[CA_INDEX_TEST_CNT - 1],
+        derSz[CA_INDEX_TEST_CNT - 1]), 0);
+    ExpectIntGT(wc_MakeCert_ex(&cert, leaf, sizeof(leaf), ECC_TYPE, &key,
+        &rng), 0);
+    ExpectIntGT(leafSz = wc_SignCert_ex(cert.bodySz, cert.sigType, leaf,
+        sizeof(leaf), ECC_TYPE, &key, &rng), 0);
+    ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, leaf, leafSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+
+    /* Unloading empties the index. */
+    ExpectIntEQ(wolfSSL_CertManagerUnloadCAs(cm), WOLFSSL_SUCCESS);
+    if (cm != NULL) {
+        ExpectNull(cm->caIndex);
+        ExpectNull(cm->caIndexRetired);
+    }
+    ExpectIntNE(wolfSSL_CertManagerVerifyBuffer(cm, leaf, leafSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntNE(wolfSSL_CertManagerVerifyBuffer(cm, der[0], derSz[0],
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, der[0], derSz[0],
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, der[0], derSz[0],
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+
+    wolfSSL_CertManagerFree(cm);
+    for (i = 0; i < CA_INDEX_TEST_CNT; i++) {
+        XFREE(der[i], HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    wc_ecc_free(&key);
+    wc_FreeRng(&rng);
+    #undef CA_INDEX_TEST_CNT
+#endif
+
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_CertManagerCaIndexSameName(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_CA_INDEX) && defined(WOLFSSL_CERT_GEN) && \
+    defined(WOLFSSL_CERT_EXT) && defined(HAVE_ECC) && !defined(NO_SKID) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    #define CA_INDEX_NAME_TEST_CNT 6
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    WC_RNG rng;
+    ecc_key key[CA_INDEX_NAME_TEST_CNT];
+    Cert cert;
+    byte der[FOURK_BUF];
+    int derSz = 0;
+    byte leaf[FOURK_BUF];
+    int leafSz = 0;
+    Signer* signers[CA_INDEX_NAME_TEST_CNT];
+    Signer* s;
+    Signer* first;
+    int i;
+    int j;
+    int k;
+    int row;
+
+    XMEMSET(&rng, 0, sizeof(rng));
+    XMEMSET(key, 0, sizeof(key));
+    XMEMSET(signers, 0, sizeof(signers));
+
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+
+    /* CAs with the same subject name and different keys. After each is
+     * added, a leaf found by name must verify against the signer found first
+     * when walking the CA table. */
+    for (i = 0; i < CA_INDEX_NAME_TEST_CNT; i++) {
+        ExpectIntEQ(wc_ecc_init(&key[i]), 0);
+        ExpectIntEQ(wc_ecc_make_key(&rng, 32, &key[i]), 0);
+        ExpectIntEQ(wc_InitCert(&cert), 0);
+        XSTRNCPY(cert.subject.commonName, "CA index same name",
+            CTC_NAME_SIZE);
+        XSTRNCPY(cert.issuer.commonName, cert.subject.commonName,
+            CTC_NAME_SIZE);
+        cert.isCA = 1;
+        cert.sigType = CTC_SHA256wECDSA;
+        XMEMSET(cert.skid, 0x5a, KEYID_SIZE);
+        cert.skid[0] = (byte)i;
+        cert.skidSz = KEYID_SIZE;
+        ExpectIntGT(wc_MakeCert_ex(&cert, der, sizeof(der), ECC_TYPE, &key[i],
+            &rng), 0);
+        ExpectIntGT(derSz = wc_SignCert_ex(cert.bodySz, cert.sigType, der,
+            sizeof(der), ECC_TYPE, &key[i], &rng), 0);
+        ExpectIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, der, derSz,
+            WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+
+        /* Find the new signer and the first one in table order. */
+        first = NULL;
+        for (row = 0; (cm != NULL) && (row < CA_TABLE_SIZE); row++) {
+            for (s = cm->caTable[row]; s != NULL; s = s->next) {
+                for (j = 0; j < i; j++) {
+                    if (signers[j] == s)
+                        break;
+                }
+                if (j == i) {
+                    signers[i] = s;
+                }
+                if (first == NULL) {
+                    first = s;
+                }
+            }
+        }
+        ExpectNotNull(signers[i]);
+        for (k = 0; k < i; k++) {
+            if (signers[k] == first)
+                break;
+        }
+        ExpectPtrEq(signers[k], first);
+
+        /* Leaf without AKID signed with the key of that signer. */
+        ExpectIntEQ(wc_InitCert(&cert), 0);
+        XSTRNCPY(cert.subject.commonName, "CA index same name leaf",
+            CTC_NAME_SIZE);
+        cert.sigType = CTC_SHA256wECDSA;
+        ExpectIntEQ(wc_SetIssuerBuffer(&cert, der, derSz), 0);
+        if (EXPECT_SUCCESS()) {
+            ExpectIntGT(wc_MakeCert_ex(&cert, leaf, sizeof(leaf), ECC_TYPE,
+                &key[k], &rng), 0);
+            ExpectIntGT(leafSz = wc_SignCert_ex(cert.bodySz, cert.sigType,
+                leaf, sizeof(leaf), ECC_TYPE, &key[k], &rng), 0);
+        }
+        ExpectIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, leaf, leafSz,
+            WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    }
+
+    wolfSSL_CertManagerFree(cm);
+    for (i = 0; i < CA_INDEX_NAME_TEST_CNT; i++) {
+        wc_ecc_free(&key[i]);
+    }
+    wc_FreeRng(&rng);
+    #undef CA_INDEX_NAME_TEST_CNT
+#endif
+
+    return EXPECT_RESULT();
+}
+
+#if defined(HAVE_CRL) && (defined(WOLFSSL_CRL_SERIAL_INDEX) || \
+    defined(WOLFSSL_CRL_COMPILED)) && defined(WOLFSSL_CERT_GEN) && \
+    defined(WOLFSSL_CERT_EXT) && defined(HAVE_ECC) && !defined(NO_SHA256) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+/* Encode DER tag and length. Returns number of bytes written.
+ * Only the size is calculated when out is NULL. */
+static word32 test_crl_der_hdr(byte* out, byte tag, word32 len)
+{
+    byte tmp[5];
+    word32 i = 0;
+
+    if (out == NULL) {
+        out = tmp;
+    }
+    out[i++] = tag;
+    if (len < 0x80) {
+        out[i++] = (byte)len;
+    }
+    else if (len < 0x100) {
+        out[i++] = 0x81;
+        out[i++] = (byte)len;
+    }
+    else if (len < 0x10000) {
+        out[i++] = 0x82;
+        out[i++] = (byte)(len >> 8);
+        out[i++] = (byte)len;
+    }
+    else {
+        out[i++] = 0x83;
+        out[i++] = (byte)(len >> 16);
+        out[i++] = (byte)(len >> 8);
+        out[i++] = (byte)len;
+    }
+
+    return i;
+}
+
+/* Make a v2 CRL signed with ECDSA-SHA256 revoking the serial numbers
+ * 0x01, hi, lo for index 0 to cnt - 1. The issuer is the contents of the
+ * name SEQUENCE. Returns size of CRL DER. */
+static int test_crl_make(byte* der, word32 derSz, const byte* issuer,
+    word32 issuerSz, int cnt, ecc_key* key, WC_RNG* rng)
+{
+    static const byte version[] = { 0x02, 0x01, 0x01 };
+    static const byte sigAlgo[] = {
+        0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02
+    };
+    static const byte thisUpdate[] = "\x17\x0d" "240101000000Z";
+    static const byte nextUpdate[] = "\x17\x0d" "490101000000Z";
+    word32 entrySz = 2 + 5 + (word32)sizeof(thisUpdate) - 1;
+    word32 listSz = (word32)cnt * entrySz;
+    word32 tbsSz;
+    word32 idx = 0;
+    int i;
+
+    tbsSz = (word32)sizeof(version) + (word32)sizeof(sigAlgo) +
+        test_crl_der_hdr(NULL, 0x30, issuerSz) + issuerSz +
+        2 * ((word32)sizeof(thisUpdate) - 1) + test_crl_der_hdr(NULL, 0x30,
+        listSz) + listSz;
+    if (tbsSz + 5 + 128 > derSz) {
+        return BUFFER_E;
+    }
+
+    idx += test_crl_der_hdr(der + idx, 0x30, tbsSz);
+    XMEMCPY(der + idx, version, sizeof(version));
+    idx += (word32)sizeof(version);
+    XMEMCPY(der + idx, sigAlgo, sizeof(sigAlgo));
+    idx += (word32)sizeof(sigAlgo);
+    idx += test_crl_der_hdr(der + idx, 0x30, issuerSz);
+    XMEMCPY(der + idx, issuer, issuerSz);
+    idx += issuerSz;
+    XMEMCPY(der + idx, thisUpdate, sizeof(thisUpdate) - 1);
+    idx += (word32)sizeof(thisUpdate) - 1;
+    XMEMCPY(der + idx, nextUpdate, sizeof(nextUpdate) - 1);
+    idx += (word32)sizeof(nextUpdate) - 1;
+    idx += test_crl_der_hdr(der + idx, 0x30, listSz);
+    for (i = 0; i < cnt; i++) {
+        idx += test_crl_der_hdr(der + idx, 0x30, entrySz - 2);
+        idx += test_crl_der_hdr(der + idx, 0x02, 3);
+        der[idx++] = 0x01;
+        der[idx++] = (byte)(i >> 8);
+        der[idx++] = (byte)i;
+        XMEMCPY(der + idx, thisUpdate, sizeof(thisUpdate) - 1);
+        idx += (word32)sizeof(thisUpdate) - 1;
+    }
+
+    return wc_SignCert_ex((int)idx, CTC_SHA256wECDSA, der, derSz, ECC_TYPE,
+        key, rng);
+}
+
+/* Make a self-signed CA, a certificate with a serial number in the middle of
+ * a CRL of cnt entries, a certificate with a serial number one past the end
+ * and the CRL itself. Certificate buffers are FOURK_BUF bytes.
+ * Returns 0 on success. */
+static int test_crl_make_certs(int cnt, ecc_key* key, WC_RNG* rng, byte* ca,
+    int* caSz, byte* revoked, int* revokedSz, byte* good, int* goodSz,
+    byte* crl, word32 crlMax, int* crlSz)
+{
+    int ret;
+    Cert cert;
+    DecodedCert dCert;
+
+    ret = wc_InitCert(&cert);
+    if (ret == 0) {
+        XSTRNCPY(cert.subject.commonName, "CRL test CA", CTC_NAME_SIZE);
+        XSTRNCPY(cert.issuer.commonName, cert.subject.commonName,
+            CTC_NAME_SIZE);
+        cert.isCA = 1;
+        cert.sigType = CTC_SHA256wECDSA;
+        ret = wc_MakeCert_ex(&cert, ca, FOURK_BUF, ECC_TYPE, key, rng);
+    }
+    if (ret > 0) {
+        ret = *caSz = wc_SignCert_ex(cert.bodySz, cert.sigType, ca, FOURK_BUF,
+            ECC_TYPE, key, rng);
+    }
+
+    /* Serial number in the middle of the CRL. */
+    if (ret > 0) {
+        ret = wc_InitCert(&cert);
+    }
+    if (ret == 0) {
+        XSTRNCPY(cert.subject.commonName, "CRL test revoked", CTC_NAME_SIZE);
+        cert.sigType = CTC_SHA256wECDSA;
+        cert.serial[0] = 0x01;
+        cert.serial[1] = (byte)((cnt / 2) >> 8);
+        cert.serial[2] = (byte)(cnt / 2);
+        cert.serialSz = 3;
+        ret = wc_SetIssuerBuffer(&cert, ca, *caSz);
+    }
+    if (ret == 0) {
+        ret = wc_MakeCert_ex(&cert, revoked, FOURK_BUF, ECC_TYPE, key, rng);
+    }
+    if (ret > 0) {
+        ret = *revokedSz = wc_SignCert_ex(cert.bodySz, cert.sigType, revoked,
+            FOURK_BUF, ECC_TYPE, key, rng);
+    }
+
+    /* Serial number one past the end of the CRL. */
+    if (ret > 0) {
+        ret = wc_InitCert(&cert);
+    }
+    if (ret == 0) {
+        XSTRNCPY(cert.subject.commonName, "CRL test good", CTC_NAME_SIZE);
+        cert.sigType = CTC_SHA256wECDSA;
+        cert.serial[0] = 0x01;
+        cert.serial[1] = (byte)(cnt >> 8);
+        cert.serial[2] = (byte)cnt;
+        cert.serialSz = 3;
+        ret = wc_SetIssuerBuffer(&cert, ca, *caSz);
+    }
+    if (ret == 0) {
+        ret = wc_MakeCert_ex(&cert, good, FOURK_BUF, ECC_TYPE, key, rng);
+    }
+    if (ret > 0) {
+        ret = *goodSz = wc_SignCert_ex(cert.bodySz, cert.sigType, good,
+            FOURK_BUF, ECC_TYPE, key, rng);
+    }
+
+    if (ret > 0) {
+        wc_InitDecodedCert(&dCert, ca, (word32)*caSz, NULL);
+        ret = wc_ParseCert(&dCert, CERT_TYPE, NO_VERIFY, NULL);
+        if (ret == 0) {
+            ret = *crlSz = test_crl_make(crl, crlMax, dCert.subjectRaw,
+                (word32)dCert.subjectRawLen, cnt, key, rng);
+        }
+        wc_FreeDecodedCert(&dCert);
+    }
+
+    return (ret > 0) ? 0 : -1;
+}
+#endif
+
+static int test_wolfSSL_CertManagerCRLSerialIndex(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_CRL) && defined(WOLFSSL_CRL_SERIAL_INDEX) && \
+    defined(WOLFSSL_CERT_GEN) && defined(WOLFSSL_CERT_EXT) && \
+    defined(HAVE_ECC) && !defined(NO_SHA256) && !defined(WOLFSSL_ASYNC_CRYPT)
+    /* Enough revoked certificates to need a large index. */
+    #define CRL_INDEX_TEST_CNT 1000
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    WC_RNG rng;
+    ecc_key key;
+    byte ca[FOURK_BUF];
+    int caSz = 0;
+    byte revoked[FOURK_BUF];
+    int revokedSz = 0;
+    byte good[FOURK_BUF];
+    int goodSz = 0;
+    byte* crl = NULL;
+    int crlSz = 0;
+    word32 crlMax = CRL_INDEX_TEST_CNT * 24 + 1024;
+
+    XMEMSET(&rng, 0, sizeof(rng));
+    XMEMSET(&key, 0, sizeof(key));
+
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+    ExpectIntEQ(wc_ecc_init(&key), 0);
+    ExpectIntEQ(wc_ecc_make_key(&rng, 32, &key), 0);
+    ExpectNotNull(crl = (byte*)XMALLOC(crlMax, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    if (EXPECT_SUCCESS()) {
+        ExpectIntEQ(test_crl_make_certs(CRL_INDEX_TEST_CNT, &key, &rng, ca,
+            &caSz, revoked, &revokedSz, good, &goodSz, crl, crlMax, &crlSz),
+            0);
+    }
+
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+    ExpectIntEQ(wolfSSL_CertManagerEnableCRL(cm, 0), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, ca, caSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCRLBuffer(cm, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    /* Index built at load time. */
+    if ((cm != NULL) && (cm->crl != NULL) && (cm->crl->crlList != NULL)) {
+        ExpectNotNull(cm->crl->crlList->serialIndex);
+        ExpectIntEQ(cm->crl->crlList->totalCerts, CRL_INDEX_TEST_CNT);
+    }
+
+    ExpectIntEQ(wolfSSL_CertManagerCheckCRL(cm, revoked, revokedSz),
+        WC_NO_ERR_TRACE(CRL_CERT_REVOKED));
+    ExpectIntEQ(wolfSSL_CertManagerCheckCRL(cm, good, goodSz),
+        WOLFSSL_SUCCESS);
+
+    wolfSSL_CertManagerFree(cm);
+    XFREE(crl, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    wc_ecc_free(&key);
+    wc_FreeRng(&rng);
+    #undef CRL_INDEX_TEST_CNT
+#endif
+
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_CertManagerCompiledCRL(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_CRL) && defined(WOLFSSL_CRL_COMPILED) && \
+    defined(WOLFSSL_CERT_GEN) && defined(WOLFSSL_CERT_EXT) && \
+    defined(HAVE_ECC) && !defined(NO_SHA256) && !defined(WOLFSSL_ASYNC_CRYPT)
+    #define CRL_COMPILED_TEST_CNT 100
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    WC_RNG rng;
+    ecc_key key;
+    byte ca[FOURK_BUF];
+    int caSz = 0;
+    byte revoked[FOURK_BUF];
+    int revokedSz = 0;
+    byte good[FOURK_BUF];
+    int goodSz = 0;
+    byte* crl = NULL;
+    int crlSz = 0;
+    word32 crlMax = CRL_COMPILED_TEST_CNT * 24 + 1024;
+    byte* compiled = NULL;
+    word32 compiledSz = 0;
+    byte* empty = NULL;
+    word32 emptySz = 0;
+    byte* bad = NULL;
+    static const byte crlKey[32] = {
+        0x3b, 0x8a, 0x51, 0x0e, 0xc2, 0x77, 0x19, 0xd4,
+        0x60, 0x2f, 0x9b, 0xe8, 0x14, 0xa5, 0x36, 0x7c,
+        0xf1, 0x08, 0x4d, 0x92, 0x6e, 0xb3, 0x25, 0xca,
+        0x57, 0x0a, 0xdf, 0x81, 0x3c, 0x64, 0xe9, 0x1b
+    };
+    static const byte otherKey[16] = {
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10
+    };
+#if defined(WOLFSSL_CRL_COMPILED_MMAP) && !defined(NO_FILESYSTEM)
+    const char* fileName = "./tests/crl_compiled.tmp";
+    XFILE f = XBADFILE;
+#endif
+
+    XMEMSET(&rng, 0, sizeof(rng));
+    XMEMSET(&key, 0, sizeof(key));
+
+    ExpectIntEQ(wc_InitRng(&rng), 0);
+    ExpectIntEQ(wc_ecc_init(&key), 0);
+    ExpectIntEQ(wc_ecc_make_key(&rng, 32, &key), 0);
+    ExpectNotNull(crl = (byte*)XMALLOC(crlMax, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    if (EXPECT_SUCCESS()) {
+        ExpectIntEQ(test_crl_make_certs(CRL_COMPILED_TEST_CNT, &key, &rng, ca,
+            &caSz, revoked, &revokedSz, good, &goodSz, crl, crlMax, &crlSz),
+            0);
+    }
+
+    /* Compiling needs a key to authenticate compiled CRL. */
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+    ExpectIntEQ(wolfSSL_CertManagerCompileCRL(cm, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1, NULL, &compiledSz),
+        WC_NO_ERR_TRACE(BAD_STATE_E));
+    ExpectIntEQ(wolfSSL_CertManagerSetCompiledCRLKey(NULL, crlKey,
+        sizeof(crlKey)), WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    ExpectIntEQ(wolfSSL_CertManagerSetCompiledCRLKey(cm, NULL,
+        sizeof(crlKey)), WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    ExpectIntEQ(wolfSSL_CertManagerSetCompiledCRLKey(cm, crlKey,
+        WOLFSSL_CRL_COMPILED_MIN_KEY_SZ - 1), WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    ExpectIntEQ(wolfSSL_CertManagerSetCompiledCRLKey(cm, crlKey,
+        sizeof(crlKey)), WOLFSSL_SUCCESS);
+    /* Compiling verifies the CRL with the loaded CAs. */
+    ExpectIntEQ(wolfSSL_CertManagerCompileCRL(cm, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1, NULL, &compiledSz),
+        WC_NO_ERR_TRACE(ASN_CRL_NO_SIGNER_E));
+    ExpectIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, ca, caSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerCompileCRL(NULL, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1, NULL, &compiledSz), WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    ExpectIntEQ(wolfSSL_CertManagerCompileCRL(cm, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1, NULL, &compiledSz),
+        WC_NO_ERR_TRACE(LENGTH_ONLY_E));
+    ExpectIntGT(compiledSz, 0);
+    ExpectNotNull(compiled = (byte*)XMALLOC(compiledSz, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    compiledSz--;
+    ExpectIntEQ(wolfSSL_CertManagerCompileCRL(cm, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1, compiled, &compiledSz),
+        WC_NO_ERR_TRACE(BUFFER_E));
+    compiledSz++;
+    ExpectIntEQ(wolfSSL_CertManagerCompileCRL(cm, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1, compiled, &compiledSz), WOLFSSL_SUCCESS);
+
+    /* CRL with no revoked certificates to replace the first. */
+    if (EXPECT_SUCCESS()) {
+        DecodedCert dCert;
+
+        wc_InitDecodedCert(&dCert, ca, (word32)caSz, NULL);
+        ExpectIntEQ(wc_ParseCert(&dCert, CERT_TYPE, NO_VERIFY, NULL), 0);
+        ExpectIntGT(crlSz = test_crl_make(crl, crlMax, dCert.subjectRaw,
+            (word32)dCert.subjectRawLen, 0, &key, &rng), 0);
+        wc_FreeDecodedCert(&dCert);
+    }
+    ExpectIntEQ(wolfSSL_CertManagerCompileCRL(cm, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1, NULL, &emptySz),
+        WC_NO_ERR_TRACE(LENGTH_ONLY_E));
+    ExpectNotNull(empty = (byte*)XMALLOC(emptySz, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    ExpectIntEQ(wolfSSL_CertManagerCompileCRL(cm, crl, crlSz,
+        WOLFSSL_FILETYPE_ASN1, empty, &emptySz), WOLFSSL_SUCCESS);
+    ExpectIntLT(emptySz, compiledSz);
+    wolfSSL_CertManagerFree(cm);
+    cm = NULL;
+
+    /* Compiled CRL only loaded when issuer is a trusted CA. */
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+    ExpectIntEQ(wolfSSL_CertManagerSetCompiledCRLKey(cm, crlKey,
+        sizeof(crlKey)), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, compiled, compiledSz),
+        WC_NO_ERR_TRACE(ASN_CRL_NO_SIGNER_E));
+    wolfSSL_CertManagerFree(cm);
+    cm = NULL;
+
+    /* Load compiled CRL - no parsing of CRL needed. */
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+    ExpectIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, ca, caSz,
+        WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(NULL, compiled,
+        compiledSz), WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    /* No key to authenticate compiled CRL with. */
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, compiled, compiledSz),
+        WC_NO_ERR_TRACE(BAD_STATE_E));
+    /* Compiled CRL authenticated with a different key. */
+    ExpectIntEQ(wolfSSL_CertManagerSetCompiledCRLKey(cm, otherKey,
+        sizeof(otherKey)), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, compiled, compiledSz),
+        WC_NO_ERR_TRACE(ASN_CRL_CONFIRM_E));
+    ExpectIntEQ(wolfSSL_CertManagerSetCompiledCRLKey(cm, crlKey,
+        sizeof(crlKey)), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, crl, crlSz),
+        WC_NO_ERR_TRACE(ASN_PARSE_E));
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, compiled,
+        compiledSz - 1), WC_NO_ERR_TRACE(ASN_PARSE_E));
+    /* Modified compiled CRL is rejected: HMAC then ordering. */
+    ExpectNotNull(bad = (byte*)XMALLOC(compiledSz, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER));
+    if (EXPECT_SUCCESS()) {
+        /* Serial number records then hashes at end of compiled CRL. */
+        word32 recSz = 1 + EXTERNAL_SERIAL_SIZE;
+        word32 recs = compiledSz -
+            (word32)CRL_COMPILED_TEST_CNT * (recSz + SIGNER_DIGEST_SIZE);
+
+        word32 body = 12 + WC_SHA256_DIGEST_SIZE;
+        Hmac hmac;
+
+        XMEMCPY(bad, compiled, compiledSz);
+        bad[recs + 1] ^= 0x01;
+        ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, bad, compiledSz),
+            WC_NO_ERR_TRACE(ASN_CRL_CONFIRM_E));
+        /* Drop a revoked certificate and fix up the count and a plain
+         * digest of the body - rejected without the key. */
+        XMEMCPY(bad, compiled, recs);
+        XMEMCPY(bad + recs, compiled + recs + recSz,
+            (CRL_COMPILED_TEST_CNT - 1) * recSz);
+        XMEMCPY(bad + recs + (CRL_COMPILED_TEST_CNT - 1) * recSz,
+            compiled + recs + CRL_COMPILED_TEST_CNT * recSz +
+            SIGNER_DIGEST_SIZE, (CRL_COMPILED_TEST_CNT - 1) *
+            SIGNER_DIGEST_SIZE);
+        bad[body + 7] = CRL_COMPILED_TEST_CNT - 1;
+        ExpectIntEQ(wc_Sha256Hash(bad + body,
+            compiledSz - recSz - SIGNER_DIGEST_SIZE - body, bad + 12), 0);
+        ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, bad,
+            compiledSz - recSz - SIGNER_DIGEST_SIZE),
+            WC_NO_ERR_TRACE(ASN_CRL_CONFIRM_E));
+        /* Swap first two serial number records and fix up the HMAC with the
+         * key. */
+        XMEMCPY(bad, compiled, compiledSz);
+        XMEMCPY(bad + recs, compiled + recs + recSz, recSz);
+        XMEMCPY(bad + recs + recSz, compiled + recs, recSz);
+        ExpectIntEQ(wc_HmacInit(&hmac, NULL, INVALID_DEVID), 0);
+        ExpectIntEQ(wc_HmacSetKey(&hmac, WC_SHA256, crlKey, sizeof(crlKey)),
+            0);
+        ExpectIntEQ(wc_HmacUpdate(&hmac, bad, 12), 0);
+        ExpectIntEQ(wc_HmacUpdate(&hmac, bad + body, compiledSz - body), 0);
+        ExpectIntEQ(wc_HmacFinal(&hmac, bad + 12), 0);
+        wc_HmacFree(&hmac);
+        ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, bad, compiledSz),
+            WC_NO_ERR_TRACE(ASN_PARSE_E));
+    }
+    XFREE(bad, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, compiled, compiledSz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerCheckCRL(cm, revoked, revokedSz),
+        WC_NO_ERR_TRACE(CRL_CERT_REVOKED));
+    ExpectIntEQ(wolfSSL_CertManagerCheckCRL(cm, good, goodSz),
+        WOLFSSL_SUCCESS);
+
+    /* Reloading for the same issuer swaps in the new data. */
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRL(cm, empty, emptySz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerCheckCRL(cm, revoked, revokedSz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerCheckCRL(cm, good, goodSz),
+        WOLFSSL_SUCCESS);
+
+#if defined(WOLFSSL_CRL_COMPILED_MMAP) && !defined(NO_FILESYSTEM)
+    /* Map compiled CRL from file in place of the empty one. */
+    ExpectTrue((f = XFOPEN(fileName, "wb")) != XBADFILE);
+    ExpectIntEQ(XFWRITE(compiled, 1, compiledSz, f), compiledSz);
+    if (f != XBADFILE) {
+        XFCLOSE(f);
+        f = XBADFILE;
+    }
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRLFile(cm,
+        "./tests/no_such_file.tmp"), WC_NO_ERR_TRACE(BAD_PATH_ERROR));
+    /* Tampered file is rejected. */
+    ExpectTrue((f = XFOPEN(fileName, "r+b")) != XBADFILE);
+    if (f != XBADFILE) {
+        ExpectIntEQ(XFSEEK(f, (long)compiledSz - 1, XSEEK_SET), 0);
+        ExpectIntEQ(XFWRITE("\xff", 1, 1, f), 1);
+        XFCLOSE(f);
+        f = XBADFILE;
+    }
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRLFile(cm, fileName),
+        WC_NO_ERR_TRACE(ASN_CRL_CONFIRM_E));
+    ExpectTrue((f = XFOPEN(fileName, "wb")) != XBADFILE);
+    ExpectIntEQ(XFWRITE(compiled, 1, compiledSz, f), compiledSz);
+    if (f != XBADFILE) {
+        XFCLOSE(f);
+        f = XBADFILE;
+    }
+    ExpectIntEQ(wolfSSL_CertManagerLoadCompiledCRLFile(cm, fileName),
+        WOLFSSL_SUCCESS);
+    (void)remove(fileName);
+    ExpectIntEQ(wolfSSL_CertManagerCheckCRL(cm, revoked, revokedSz),
+        WC_NO_ERR_TRACE(CRL_CERT_REVOKED));
+    ExpectIntEQ(wolfSSL_CertManagerCheckCRL(cm, good, goodSz),
+        WOLFSSL_SUCCESS);
+#endif
+
+    wolfSSL_CertManagerFree(cm);
+    XFREE(empty, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(compiled, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(crl, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    wc_ecc_free(&key);
+    wc_FreeRng(&rng);
+    #undef CRL_COMPILED_TEST_CNT
+#endif
+
+    return EXPECT_RESULT();
+}
+
 #if !defined(NO_FILESYSTEM) && defined(OPENSSL_EXTRA) && \
     defined(DEBUG_UNIT_TEST_CERTS)
 /* Used when debugging name constraint tests. Not static to allow use in
@@ -4514,6 +5367,351 @@ static int test_wolfSSL_CertManagerCheckOCSPResponse(void)
     return EXPECT_RESULT();
 }
 
+#if defined(HAVE_OCSP) && (defined(WOLFSSL_OCSP_CACHE_REFRESH) || \
+    defined(WOLFSSL_OCSP_STAPLE_CACHE)) && !defined(NO_RSA) && \
+    !defined(NO_SHA) && !defined(NO_FILESYSTEM) && defined(WOLFSSL_PEM_TO_DER)
+/* Time seen by certificate manager - starts inside response validity. */
+static time_t test_ocsp_cache_now = 1702512000; /* Dec 14 00:00:00 2023 */
+/* nextUpdate of responses in test-multi-response-short.der - a year before
+ * the certificates expire so that stale responses can be checked. */
+#define TEST_OCSP_CACHE_NEXT_UPDATE     1734041971 /* Dec 12 22:19:31 2024 */
+/* Response returned by I/O callback. */
+static byte test_ocsp_cache_resp[4096];
+static int test_ocsp_cache_respSz = 0;
+/* Count of times I/O callback called - blocking and background. */
+static int test_ocsp_cache_io_calls = 0;
+
+static time_t test_ocsp_cache_time_cb(time_t* t)
+{
+    if (t != NULL) {
+        *t = test_ocsp_cache_now;
+    }
+
+    return test_ocsp_cache_now;
+}
+
+static int test_ocsp_cache_io_cb(void* ctx, const char* url, int urlSz,
+    unsigned char* req, int reqSz, unsigned char** resp)
+{
+    (void)ctx;
+    (void)url;
+    (void)urlSz;
+    (void)req;
+    (void)reqSz;
+
+    test_ocsp_cache_io_calls++;
+    *resp = test_ocsp_cache_resp;
+    return test_ocsp_cache_respSz;
+}
+#endif
+
+#if defined(HAVE_OCSP) && defined(WOLFSSL_OCSP_CACHE_REFRESH) && \
+    !defined(NO_RSA) && !defined(NO_SHA) && !defined(NO_FILESYSTEM) && \
+    defined(WOLFSSL_PEM_TO_DER)
+/* Wait for the background refreshes to reach a count. */
+static int test_ocsp_cache_wait(WOLFSSL_CERT_MANAGER* cm, word32 done)
+{
+    WOLFSSL_OCSP_CACHE_STATS stats;
+    int i;
+
+    for (i = 0; i < 200; i++) {
+        if (wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats) !=
+                WOLFSSL_SUCCESS) {
+            return 0;
+        }
+        if (stats.refreshes + stats.refreshFails >= done) {
+            return 1;
+        }
+        XSLEEP_MS(10);
+    }
+
+    return 0;
+}
+#endif
+
+static int test_wolfSSL_CertManagerOCSPCache(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_OCSP) && defined(WOLFSSL_OCSP_CACHE_REFRESH) && \
+    !defined(NO_RSA) && !defined(NO_SHA) && !defined(NO_FILESYSTEM) && \
+    defined(WOLFSSL_PEM_TO_DER)
+    const char* responseFile = "./certs/ocsp/test-multi-response-short.der";
+    const char* caFile = "./certs/ocsp/root-ca-cert.pem";
+    const char* cert1File = "./certs/ocsp/intermediate1-ca-cert.pem";
+    const char* cert2File = "./certs/ocsp/intermediate2-ca-cert.pem";
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    WOLFSSL_OCSP_CACHE_STATS stats;
+    static byte pem[16384];
+    int  pemSz = 0;
+    byte cert1[2048];
+    int  cert1Sz = 0;
+    byte cert2[2048];
+    int  cert2Sz = 0;
+    XFILE f = XBADFILE;
+
+    ExpectTrue((f = XFOPEN(responseFile, "rb")) != XBADFILE);
+    ExpectIntGT(test_ocsp_cache_respSz = (int)XFREAD(test_ocsp_cache_resp, 1,
+        sizeof(test_ocsp_cache_resp), f), 0);
+    if (f != XBADFILE) {
+        XFCLOSE(f);
+        f = XBADFILE;
+    }
+    ExpectTrue((f = XFOPEN(cert1File, "rb")) != XBADFILE);
+    ExpectIntGT(pemSz = (int)XFREAD(pem, 1, sizeof(pem), f), 0);
+    if (f != XBADFILE) {
+        XFCLOSE(f);
+        f = XBADFILE;
+    }
+    ExpectIntGT(cert1Sz = wc_CertPemToDer(pem, pemSz, cert1, sizeof(cert1),
+        CERT_TYPE), 0);
+    ExpectTrue((f = XFOPEN(cert2File, "rb")) != XBADFILE);
+    ExpectIntGT(pemSz = (int)XFREAD(pem, 1, sizeof(pem), f), 0);
+    if (f != XBADFILE) {
+        XFCLOSE(f);
+        f = XBADFILE;
+    }
+    ExpectIntGT(cert2Sz = wc_CertPemToDer(pem, pemSz, cert2, sizeof(cert2),
+        CERT_TYPE), 0);
+
+    test_ocsp_cache_now = 1702512000;
+    test_ocsp_cache_io_calls = 0;
+    ExpectIntEQ(wc_SetTimeCb(test_ocsp_cache_time_cb), 0);
+
+    ExpectNotNull(cm = wolfSSL_CertManagerNew());
+    ExpectIntEQ(wolfSSL_CertManagerLoadCA(cm, caFile, NULL), WOLFSSL_SUCCESS);
+
+    /* Bad parameters and OCSP not enabled. */
+    ExpectIntEQ(wolfSSL_CertManagerSetOCSPCache(NULL, 0, 0, 0),
+        WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    ExpectIntEQ(wolfSSL_CertManagerSetOCSPCache(cm, 0, 0, 0),
+        WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(NULL, &stats),
+        WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(cm, NULL),
+        WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+
+    /* Canned response has a nonce that won't match the request. */
+    ExpectIntEQ(wolfSSL_CertManagerEnableOCSP(cm, WOLFSSL_OCSP_NO_NONCE),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerSetOCSP_Cb(cm, test_ocsp_cache_io_cb, NULL,
+        NULL), WOLFSSL_SUCCESS);
+    /* No cache policy set yet. */
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats),
+        WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+    ExpectIntEQ(wolfSSL_CertManagerSetOCSPCache(cm, 0, 3600, 86400),
+        WOLFSSL_SUCCESS);
+
+    /* First lookup waits on responder. */
+    ExpectIntEQ(wolfSSL_CertManagerCheckOCSP(cm, cert1, cert1Sz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ocsp_cache_io_calls, 1);
+    /* Second lookup answered from cache. */
+    ExpectIntEQ(wolfSSL_CertManagerCheckOCSP(cm, cert1, cert1Sz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ocsp_cache_io_calls, 1);
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.misses, 1);
+    ExpectIntEQ(stats.hits, 1);
+    ExpectIntEQ(stats.entries, 1);
+
+    /* Within prefetch window - answered from cache and refreshed. */
+    test_ocsp_cache_now = TEST_OCSP_CACHE_NEXT_UPDATE - 60;
+    ExpectIntEQ(wolfSSL_CertManagerCheckOCSP(cm, cert1, cert1Sz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ocsp_cache_wait(cm, 1), 1);
+    ExpectIntEQ(test_ocsp_cache_io_calls, 2);
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.hits, 2);
+    ExpectIntEQ(stats.refreshes, 1);
+    ExpectIntEQ(stats.misses, 1);
+
+    /* Expired but within max stale - answered from cache and refreshed. */
+    test_ocsp_cache_now = TEST_OCSP_CACHE_NEXT_UPDATE + 60;
+    ExpectIntEQ(wolfSSL_CertManagerCheckOCSP(cm, cert1, cert1Sz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_ocsp_cache_wait(cm, 2), 1);
+    ExpectIntEQ(test_ocsp_cache_io_calls, 3);
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.staleHits, 1);
+    ExpectIntEQ(stats.misses, 1);
+    ExpectIntEQ(stats.entries, 1);
+#ifndef NO_ASN_TIME_CHECK
+    /* Canned response has expired too so refresh fails and entry is kept. */
+    ExpectIntEQ(stats.refreshes, 1);
+    ExpectIntEQ(stats.refreshFails, 1);
+    /* Failed refresh isn't retried until the back off has passed. */
+    ExpectIntEQ(wolfSSL_CertManagerCheckOCSP(cm, cert1, cert1Sz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.staleHits, 2);
+    ExpectIntEQ(test_ocsp_cache_io_calls, 3);
+#endif
+
+    /* Limit cache to one response - second certificate evicts first. */
+    test_ocsp_cache_now = 1702512000;
+    ExpectIntEQ(wolfSSL_CertManagerSetOCSPCache(cm, 1, 3600, 86400),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerCheckOCSP(cm, cert2, cert2Sz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.misses, 2);
+    ExpectIntEQ(stats.evictions, 1);
+    ExpectIntEQ(stats.entries, 1);
+    ExpectIntEQ(wolfSSL_CertManagerCheckOCSP(cm, cert1, cert1Sz),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CertManagerGetOCSPCacheStats(cm, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.misses, 3);
+    ExpectIntEQ(stats.evictions, 2);
+    ExpectIntEQ(test_ocsp_cache_io_calls, 5);
+
+    wolfSSL_CertManagerFree(cm);
+    ExpectIntEQ(wc_SetTimeCb(NULL), 0);
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(HAVE_OCSP) && defined(WOLFSSL_OCSP_STAPLE_CACHE) && \
+    defined(HAVE_CERTIFICATE_STATUS_REQUEST) && \
+    defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && !defined(NO_RSA) && \
+    !defined(NO_SHA) && !defined(NO_FILESYSTEM) && \
+    defined(WOLFSSL_PEM_TO_DER)
+/* Server certificate is a CA certificate without digitalSignature key usage
+ * as it is the one in the canned response. */
+static int test_ocsp_staple_cache_verify_cb(int preverify,
+    WOLFSSL_X509_STORE_CTX* store)
+{
+    if (store->error == WC_NO_ERR_TRACE(KEYUSE_SIGNATURE_E))
+        return 1;
+    return preverify;
+}
+#endif
+
+static int test_wolfSSL_CTX_OCSPStapleCache(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_OCSP) && defined(WOLFSSL_OCSP_STAPLE_CACHE) && \
+    defined(HAVE_CERTIFICATE_STATUS_REQUEST) && \
+    defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && !defined(NO_RSA) && \
+    !defined(NO_SHA) && !defined(NO_FILESYSTEM) && \
+    defined(WOLFSSL_PEM_TO_DER)
+    const char* responseFile = "./certs/ocsp/test-multi-response.der";
+    const char* caFile = "./certs/ocsp/root-ca-cert.pem";
+    /* Intermediate is serial 01 in the response - use as server cert. */
+    const char* certFile = "./certs/ocsp/intermediate1-ca-cert.pem";
+    const char* keyFile = "./certs/ocsp/intermediate1-ca-key.pem";
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX* ctx_c = NULL;
+    WOLFSSL_CTX* ctx_s = NULL;
+    WOLFSSL* ssl_c = NULL;
+    WOLFSSL* ssl_s = NULL;
+    XFILE f = XBADFILE;
+    int calls = 0;
+    int i;
+    int j;
+    struct {
+        method_provider client;
+        method_provider server;
+    } methods[] = {
+#ifndef WOLFSSL_NO_TLS12
+        { wolfTLSv1_2_client_method, wolfTLSv1_2_server_method },
+#endif
+#ifdef WOLFSSL_TLS13
+        { wolfTLSv1_3_client_method, wolfTLSv1_3_server_method },
+#endif
+    };
+
+    ExpectTrue((f = XFOPEN(responseFile, "rb")) != XBADFILE);
+    ExpectIntGT(test_ocsp_cache_respSz = (int)XFREAD(test_ocsp_cache_resp, 1,
+        sizeof(test_ocsp_cache_resp), f), 0);
+    if (f != XBADFILE) {
+        XFCLOSE(f);
+        f = XBADFILE;
+    }
+
+    test_ocsp_cache_now = 1702512000;
+    test_ocsp_cache_io_calls = 0;
+    ExpectIntEQ(wc_SetTimeCb(test_ocsp_cache_time_cb), 0);
+
+    for (i = 0; i < (int)(sizeof(methods) / sizeof(*methods)); i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+
+        ExpectNotNull(ctx_s = wolfSSL_CTX_new(methods[i].server()));
+        ExpectIntEQ(wolfSSL_CTX_use_certificate_file(ctx_s, certFile,
+            WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_use_PrivateKey_file(ctx_s, keyFile,
+            WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_load_verify_locations(ctx_s, caFile, NULL),
+            WOLFSSL_SUCCESS);
+        wolfSSL_SetIORecv(ctx_s, test_memio_read_cb);
+        wolfSSL_SetIOSend(ctx_s, test_memio_write_cb);
+
+        /* Bad parameters and stapling not enabled. */
+        ExpectIntEQ(wolfSSL_CTX_EnableOCSPStapleCache(NULL, 0),
+            WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+        ExpectIntEQ(wolfSSL_CTX_RefreshOCSPStapleCache(NULL),
+            WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+        ExpectIntEQ(wolfSSL_CTX_RefreshOCSPStapleCache(ctx_s),
+            WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+        ExpectIntEQ(wolfSSL_CTX_EnableOCSPStapleCache(ctx_s, 0),
+            WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+
+        /* Canned response has a nonce that won't match the request. */
+        ExpectIntEQ(wolfSSL_CTX_EnableOCSP(ctx_s, WOLFSSL_OCSP_NO_NONCE),
+            WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_EnableOCSPStapling(ctx_s), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_SetOCSP_Cb(ctx_s, test_ocsp_cache_io_cb, NULL,
+            NULL), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_EnableOCSPStapleCache(ctx_s, 0),
+            WOLFSSL_SUCCESS);
+        /* Response fetched before any handshake. */
+        ExpectIntEQ(wolfSSL_CTX_RefreshOCSPStapleCache(ctx_s),
+            WOLFSSL_SUCCESS);
+        /* Wait for the refresh started when enabled. */
+        for (j = 0; j < 200 && test_ocsp_cache_io_calls < calls + 2; j++) {
+            XSLEEP_MS(10);
+        }
+        ExpectIntEQ(test_ocsp_cache_io_calls, calls + 2);
+        calls = test_ocsp_cache_io_calls;
+
+        ExpectNotNull(ctx_c = wolfSSL_CTX_new(methods[i].client()));
+        ExpectIntEQ(wolfSSL_CTX_load_verify_locations(ctx_c, caFile, NULL),
+            WOLFSSL_SUCCESS);
+        wolfSSL_CTX_set_verify(ctx_c, WOLFSSL_VERIFY_PEER,
+            test_ocsp_staple_cache_verify_cb);
+        ExpectIntEQ(wolfSSL_CTX_EnableOCSPStapling(ctx_c), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_EnableOCSPMustStaple(ctx_c), WOLFSSL_SUCCESS);
+        wolfSSL_SetIORecv(ctx_c, test_memio_read_cb);
+        wolfSSL_SetIOSend(ctx_c, test_memio_write_cb);
+
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c,
+            &ssl_s, NULL, NULL), 0);
+        ExpectIntEQ(wolfSSL_UseOCSPStapling(ssl_c, WOLFSSL_CSR_OCSP, 0),
+            WOLFSSL_SUCCESS);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        /* Staple served from cache - responder not contacted. */
+        ExpectIntEQ(test_ocsp_cache_io_calls, calls);
+
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        wolfSSL_CTX_free(ctx_c);
+        ctx_c = NULL;
+        wolfSSL_CTX_free(ctx_s);
+        ctx_s = NULL;
+    }
+
+    ExpectIntEQ(wc_SetTimeCb(NULL), 0);
+#endif
+    return EXPECT_RESULT();
+}
+
 static int test_wolfSSL_CheckOCSPResponse(void)
 {
     EXPECT_DECLS;
@@ -9406,6 +10604,1091 @@ static int test_wolfSSL_read_write(void)
     return EXPECT_RESULT();
 }
 
+static int test_wolfSSL_writev(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && !defined(NO_WRITEV) && \
+    !defined(USE_WINDOWS_API)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    static byte msg[20000 + 100 + 3 + 5000];
+    static byte reply[sizeof(msg)];
+    struct iovec iov[6];
+    int len = 0;
+    int ret;
+    int i;
+    struct {
+        method_provider client_meth;
+        method_provider server_meth;
+    } params[] = {
+#ifdef WOLFSSL_TLS13
+        { wolfTLSv1_3_client_method, wolfTLSv1_3_server_method },
+#endif
+#ifndef WOLFSSL_NO_TLS12
+        { wolfTLSv1_2_client_method, wolfTLSv1_2_server_method },
+#endif
+    };
+
+    for (i = 0; i < (int)sizeof(msg); i++)
+        msg[i] = (byte)i;
+    /* Records span elements, including an empty one. */
+    iov[0].iov_base = msg;
+    iov[0].iov_len  = 100;
+    iov[1].iov_base = msg + 100;
+    iov[1].iov_len  = 20000;
+    iov[2].iov_base = NULL;
+    iov[2].iov_len  = 0;
+    iov[3].iov_base = msg + 20100;
+    iov[3].iov_len  = 3;
+    iov[4].iov_base = msg + 20103;
+    iov[4].iov_len  = 5000;
+
+    for (i = 0; i < (int)XELEM_CNT(params) && EXPECT_SUCCESS(); i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c,
+            &ssl_s, params[i].client_meth, params[i].server_meth), 0);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+
+        ExpectIntEQ(wolfSSL_writev(NULL, iov, 5), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_writev(ssl_c, NULL, 5), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_writev(ssl_c, iov, -1), BAD_FUNC_ARG);
+        iov[5].iov_base = NULL;
+        iov[5].iov_len  = 1;
+        ExpectIntEQ(wolfSSL_writev(ssl_c, iov, 6), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_writev(ssl_c, iov, 0), 0);
+
+        ExpectIntEQ(wolfSSL_writev(ssl_c, iov, 5), (int)sizeof(msg));
+        for (len = 0; EXPECT_SUCCESS() && len < (int)sizeof(reply); ) {
+            ExpectIntGT(ret = wolfSSL_read(ssl_s, reply + len,
+                (int)sizeof(reply) - len), 0);
+            if (ret > 0)
+                len += ret;
+        }
+        ExpectIntEQ(len, sizeof(msg));
+        ExpectBufEQ(reply, msg, sizeof(msg));
+
+        /* One element. */
+        iov[5].iov_base = msg;
+        iov[5].iov_len  = 10;
+        ExpectIntEQ(wolfSSL_writev(ssl_s, iov + 5, 1), 10);
+        ExpectIntEQ(wolfSSL_read(ssl_c, reply, (int)sizeof(reply)), 10);
+        ExpectBufEQ(reply, msg, 10);
+
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        wolfSSL_CTX_free(ctx_c);
+        ctx_c = NULL;
+        wolfSSL_CTX_free(ctx_s);
+        ctx_s = NULL;
+    }
+#endif
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_read_zc(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    static byte msg[20000];
+    byte reply[16];
+    const unsigned char* data = NULL;
+    int len = 0;
+    int ret;
+    int i;
+    struct {
+        method_provider client_meth;
+        method_provider server_meth;
+    } params[] = {
+#ifdef WOLFSSL_TLS13
+        { wolfTLSv1_3_client_method, wolfTLSv1_3_server_method },
+#endif
+#ifndef WOLFSSL_NO_TLS12
+        { wolfTLSv1_2_client_method, wolfTLSv1_2_server_method },
+#endif
+    };
+
+    for (i = 0; i < (int)sizeof(msg); i++)
+        msg[i] = (byte)i;
+
+    for (i = 0; i < (int)XELEM_CNT(params) && EXPECT_SUCCESS(); i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c,
+            &ssl_s, params[i].client_meth, params[i].server_meth), 0);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+
+        ExpectIntEQ(wolfSSL_read_zc(NULL, &data, 10), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_read_zc(ssl_s, NULL, 10), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_read_zc(ssl_s, &data, -1), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_read_zc_release(NULL, 0), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_read_zc_release(ssl_s, 1), BAD_FUNC_ARG);
+        ExpectIntEQ(wolfSSL_read_zc_release(ssl_s, 0), WOLFSSL_SUCCESS);
+
+        /* Spans two records. */
+        ExpectIntEQ(wolfSSL_write(ssl_c, msg, (int)sizeof(msg)),
+            (int)sizeof(msg));
+        for (len = 0; EXPECT_SUCCESS() && len < (int)sizeof(msg); ) {
+            ExpectIntGT(ret = wolfSSL_read_zc(ssl_s, &data,
+                (int)sizeof(msg)), 0);
+            if (EXPECT_SUCCESS()) {
+                /* Plaintext is handed out from the receive buffer. */
+                ExpectTrue(data >= ssl_s->buffers.inputBuffer.buffer &&
+                    data + ret <= ssl_s->buffers.inputBuffer.buffer +
+                                  ssl_s->buffers.inputBuffer.bufferSize);
+                ExpectBufEQ(data, msg + len, ret);
+                ExpectIntEQ(wolfSSL_read_zc_release(ssl_s, ret + 1),
+                    BAD_FUNC_ARG);
+                ExpectIntEQ(wolfSSL_read_zc_release(ssl_s, ret),
+                    WOLFSSL_SUCCESS);
+                len += ret;
+            }
+        }
+        ExpectIntEQ(len, sizeof(msg));
+
+        /* Partial release - remainder returned by next read. Writing while
+         * data is held is allowed. */
+        ExpectIntEQ(wolfSSL_write(ssl_c, msg, 10), 10);
+        ExpectIntEQ(wolfSSL_read_zc(ssl_s, &data, 4), 4);
+        ExpectBufEQ(data, msg, 4);
+        ExpectIntEQ(wolfSSL_read_zc(ssl_s, &data, (int)sizeof(msg)), 10);
+        ExpectBufEQ(data, msg, 10);
+        ExpectIntEQ(wolfSSL_write(ssl_s, msg, 5), 5);
+        ExpectIntEQ(wolfSSL_read_zc_release(ssl_s, 6), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_read(ssl_s, reply, (int)sizeof(reply)), 4);
+        ExpectBufEQ(reply, msg + 6, 4);
+        ExpectIntEQ(wolfSSL_read(ssl_c, reply, (int)sizeof(reply)), 5);
+        ExpectBufEQ(reply, msg, 5);
+
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        wolfSSL_CTX_free(ctx_c);
+        ctx_c = NULL;
+        wolfSSL_CTX_free(ctx_s);
+        ctx_s = NULL;
+    }
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(WOLFSSL_SEND_BATCH)
+static int test_send_batch_writes;
+
+static int test_send_batch_write_cb(WOLFSSL* ssl, char* data, int sz,
+    void* ctx)
+{
+    int ret = test_memio_write_cb(ssl, data, sz, ctx);
+    if (ret > 0)
+        test_send_batch_writes++;
+    return ret;
+}
+#endif
+
+static int test_wolfSSL_send_batch(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(WOLFSSL_SEND_BATCH)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    /* Three full records. */
+    static byte msg[3 * 16384];
+    static byte reply[3 * 16384];
+    int len;
+    int i;
+    struct {
+        method_provider client_meth;
+        method_provider server_meth;
+    } params[] = {
+#ifdef WOLFSSL_TLS13
+        { wolfTLSv1_3_client_method, wolfTLSv1_3_server_method },
+#endif
+#ifndef WOLFSSL_NO_TLS12
+        { wolfTLSv1_2_client_method, wolfTLSv1_2_server_method },
+#endif
+    };
+
+    for (i = 0; i < (int)sizeof(msg); i++)
+        msg[i] = (byte)i;
+
+    for (i = 0; i < (int)XELEM_CNT(params) && EXPECT_SUCCESS(); i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c,
+            &ssl_s, params[i].client_meth, params[i].server_meth), 0);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        if (ssl_c != NULL)
+            wolfSSL_SSLSetIOSend(ssl_c, test_send_batch_write_cb);
+
+        /* Records of a batch are written in one go. */
+        test_send_batch_writes = 0;
+        ExpectIntEQ(wolfSSL_write(ssl_c, msg, (int)sizeof(msg)),
+            (int)sizeof(msg));
+        ExpectIntEQ(test_send_batch_writes,
+            (3 + WOLFSSL_SEND_BATCH_RECORDS - 1) / WOLFSSL_SEND_BATCH_RECORDS);
+
+        /* Peer's buffer too full for the batch - resume after WANT_WRITE. */
+        ExpectIntEQ(wolfSSL_write(ssl_c, msg, (int)sizeof(msg)), -1);
+        ExpectIntEQ(wolfSSL_get_error(ssl_c, -1), WOLFSSL_ERROR_WANT_WRITE);
+        for (len = 0; EXPECT_SUCCESS() && len < (int)sizeof(reply); ) {
+            int ret;
+            ExpectIntGT(ret = wolfSSL_read(ssl_s, reply + len,
+                (int)sizeof(reply) - len), 0);
+            if (ret > 0)
+                len += ret;
+        }
+        ExpectBufEQ(reply, msg, sizeof(msg));
+        ExpectIntEQ(wolfSSL_write(ssl_c, msg, (int)sizeof(msg)),
+            (int)sizeof(msg));
+        for (len = 0; EXPECT_SUCCESS() && len < (int)sizeof(reply); ) {
+            int ret;
+            ExpectIntGT(ret = wolfSSL_read(ssl_s, reply + len,
+                (int)sizeof(reply) - len), 0);
+            if (ret > 0)
+                len += ret;
+        }
+        ExpectBufEQ(reply, msg, sizeof(msg));
+
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        wolfSSL_CTX_free(ctx_c);
+        ctx_c = NULL;
+        wolfSSL_CTX_free(ctx_s);
+        ctx_s = NULL;
+    }
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(WOLFSSL_KTLS) && defined(HAVE_IO_TESTS_DEPENDENCIES)
+static int test_ktls_client_res;
+static int test_ktls_server_res;
+
+/* Kernel TLS needs the tls module - unavailable returns ENOENT. */
+static int test_ktls_kernel_support(void)
+{
+#ifndef TCP_ULP
+    #define TCP_ULP 31
+#endif
+    int ret = 0;
+    SOCKET_T fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (fd != SOCKET_INVALID) {
+        ret = (setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) == 0)
+              || (errno != ENOENT);
+        CloseSocket(fd);
+    }
+    return ret;
+}
+
+/* After the harness messages: offload and echo through the kernel. */
+static void test_ktls_on_result(WOLFSSL* ssl)
+{
+    static const char ping[] = "kernel TLS ping";
+    char reply[sizeof(ping)];
+    int* res = (wolfSSL_is_server(ssl) ? &test_ktls_server_res :
+                                          &test_ktls_client_res);
+
+    *res = TEST_FAIL;
+    if (wolfSSL_EnableKTLS(ssl, WOLFSSL_KTLS_TX | WOLFSSL_KTLS_RX) !=
+            WOLFSSL_SUCCESS ||
+            wolfSSL_GetKTLS(ssl) != (WOLFSSL_KTLS_TX | WOLFSSL_KTLS_RX)) {
+        return;
+    }
+    /* Offloading again is a no-op. */
+    if (wolfSSL_EnableKTLS(ssl, WOLFSSL_KTLS_TX) != WOLFSSL_SUCCESS)
+        return;
+
+    if (!wolfSSL_is_server(ssl)) {
+        if (wolfSSL_write(ssl, ping, (int)sizeof(ping)) != (int)sizeof(ping))
+            return;
+    }
+    XMEMSET(reply, 0, sizeof(reply));
+    if (wolfSSL_read(ssl, reply, (int)sizeof(reply)) != (int)sizeof(ping) ||
+            XMEMCMP(reply, ping, sizeof(ping)) != 0) {
+        return;
+    }
+    if (wolfSSL_is_server(ssl)) {
+        if (wolfSSL_write(ssl, ping, (int)sizeof(ping)) != (int)sizeof(ping))
+            return;
+    }
+    *res = TEST_SUCCESS;
+}
+#endif
+
+static int test_wolfSSL_EnableKTLS(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_KTLS) && defined(HAVE_IO_TESTS_DEPENDENCIES)
+    WOLFSSL_CTX* ctx = NULL;
+    WOLFSSL* ssl = NULL;
+    callback_functions client_cb;
+    callback_functions server_cb;
+    int i;
+    struct {
+        method_provider client_meth;
+        method_provider server_meth;
+    } params[] = {
+#ifdef WOLFSSL_TLS13
+        { wolfTLSv1_3_client_method, wolfTLSv1_3_server_method },
+#endif
+#ifndef WOLFSSL_NO_TLS12
+        { wolfTLSv1_2_client_method, wolfTLSv1_2_server_method },
+#endif
+    };
+
+    ExpectIntEQ(wolfSSL_EnableKTLS(NULL, WOLFSSL_KTLS_TX), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_GetKTLS(NULL), 0);
+
+    ExpectNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    ExpectNotNull(ssl = wolfSSL_new(ctx));
+    ExpectIntEQ(wolfSSL_EnableKTLS(ssl, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_EnableKTLS(ssl, 0x04), BAD_FUNC_ARG);
+    /* Handshake not done. */
+    ExpectIntEQ(wolfSSL_EnableKTLS(ssl, WOLFSSL_KTLS_TX), BAD_STATE_E);
+    ExpectIntEQ(wolfSSL_GetKTLS(ssl), 0);
+    wolfSSL_free(ssl);
+    wolfSSL_CTX_free(ctx);
+
+    /* Offload needs kernel support. */
+    if (EXPECT_SUCCESS() && !test_ktls_kernel_support())
+        return TEST_SKIPPED;
+
+    for (i = 0; i < (int)XELEM_CNT(params) && EXPECT_SUCCESS(); i++) {
+        XMEMSET(&client_cb, 0, sizeof(client_cb));
+        XMEMSET(&server_cb, 0, sizeof(server_cb));
+        client_cb.method = params[i].client_meth;
+        server_cb.method = params[i].server_meth;
+        client_cb.on_result = test_ktls_on_result;
+        server_cb.on_result = test_ktls_on_result;
+        test_ktls_client_res = TEST_FAIL;
+        test_ktls_server_res = TEST_FAIL;
+
+        test_wolfSSL_client_server_nofail(&client_cb, &server_cb);
+
+        ExpectIntEQ(client_cb.return_code, TEST_SUCCESS);
+        ExpectIntEQ(server_cb.return_code, TEST_SUCCESS);
+        ExpectIntEQ(test_ktls_client_res, TEST_SUCCESS);
+        ExpectIntEQ(test_ktls_server_res, TEST_SUCCESS);
+    }
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(WOLFSSL_DTLS_MMSG) && defined(HAVE_IO_TESTS_DEPENDENCIES)
+/* Bind a non-blocking UDP socket on the loopback interface. */
+static SOCKET_T test_dtls_batch_socket(SOCKADDR_IN_T* addr)
+{
+    SOCKET_T fd = socket(AF_INET, SOCK_DGRAM, 0);
+    socklen_t len = (socklen_t)sizeof(*addr);
+
+    if (fd == SOCKET_INVALID)
+        return fd;
+    XMEMSET(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (struct sockaddr*)addr, len) != 0 ||
+            getsockname(fd, (struct sockaddr*)addr, &len) != 0) {
+        CloseSocket(fd);
+        return SOCKET_INVALID;
+    }
+    tcp_set_nonblocking(&fd);
+    return fd;
+}
+#endif
+
+static int test_wolfSSL_dtls_batch(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_DTLS_MMSG) && defined(HAVE_IO_TESTS_DEPENDENCIES)
+    WOLFSSL_CTX* ctx_c = NULL;
+    WOLFSSL_CTX* ctx_s = NULL;
+    WOLFSSL* ssl_c = NULL;
+    WOLFSSL* ssl_s = NULL;
+    SOCKET_T fd_c = SOCKET_INVALID;
+    SOCKET_T fd_s = SOCKET_INVALID;
+    SOCKADDR_IN_T addr_c;
+    SOCKADDR_IN_T addr_s;
+    static const char* msgs[] = { "one", "two", "three", "four", "five" };
+    struct iovec wr[5];
+    struct iovec rd[8];
+    char bufs[8][32];
+    char peekBuf[2][256];
+    int peekSz = 0;
+    int i;
+    int p;
+    int ret_c;
+    int ret_s;
+    struct {
+        method_provider client_meth;
+        method_provider server_meth;
+    } params[] = {
+#ifdef WOLFSSL_DTLS13
+        { wolfDTLSv1_3_client_method, wolfDTLSv1_3_server_method },
+#endif
+#ifndef WOLFSSL_NO_TLS12
+        { wolfDTLSv1_2_client_method, wolfDTLSv1_2_server_method },
+#endif
+    };
+
+    XMEMSET(wr, 0, sizeof(wr));
+    XMEMSET(rd, 0, sizeof(rd));
+    ExpectIntEQ(wolfSSL_dtls_write_batch(NULL, wr, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_dtls_read_batch(NULL, rd, 1), BAD_FUNC_ARG);
+
+    /* Batches are only for DTLS. */
+    ExpectNotNull(ctx_c = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    ExpectIntEQ(wolfSSL_dtls_write_batch(ssl_c, wr, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_dtls_read_batch(ssl_c, rd, 1), BAD_FUNC_ARG);
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    wolfSSL_CTX_free(ctx_c);
+    ctx_c = NULL;
+
+    /* Batches are only with the built-in I/O callbacks. */
+    ExpectNotNull(ctx_c = wolfSSL_CTX_new(wolfDTLS_client_method()));
+    ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+    ExpectIntEQ(wolfSSL_dtls_write_batch(ssl_c, NULL, 1), BAD_FUNC_ARG);
+    wolfSSL_SSLSetIOSend(ssl_c, test_memio_write_cb);
+    wolfSSL_SSLSetIORecv(ssl_c, test_memio_read_cb);
+    ExpectIntEQ(wolfSSL_dtls_write_batch(ssl_c, wr, 1), BAD_STATE_E);
+    ExpectIntEQ(wolfSSL_dtls_read_batch(ssl_c, rd, 1), BAD_STATE_E);
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    wolfSSL_CTX_free(ctx_c);
+    ctx_c = NULL;
+
+    for (i = 0; i < (int)XELEM_CNT(msgs); i++) {
+        wr[i].iov_base = (void*)msgs[i];
+        wr[i].iov_len = XSTRLEN(msgs[i]);
+    }
+
+    for (p = 0; p < (int)XELEM_CNT(params) && EXPECT_SUCCESS(); p++) {
+        ExpectTrue((fd_c = test_dtls_batch_socket(&addr_c)) != SOCKET_INVALID);
+        ExpectTrue((fd_s = test_dtls_batch_socket(&addr_s)) != SOCKET_INVALID);
+        ExpectIntEQ(connect(fd_c, (struct sockaddr*)&addr_s, sizeof(addr_s)),
+            0);
+        ExpectIntEQ(connect(fd_s, (struct sockaddr*)&addr_c, sizeof(addr_c)),
+            0);
+
+        ExpectNotNull(ctx_c = wolfSSL_CTX_new(params[p].client_meth()));
+        ExpectNotNull(ctx_s = wolfSSL_CTX_new(params[p].server_meth()));
+        ExpectIntEQ(wolfSSL_CTX_load_verify_locations(ctx_c, caCertFile, 0),
+            WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_use_certificate_file(ctx_s, svrCertFile,
+            WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_CTX_use_PrivateKey_file(ctx_s, svrKeyFile,
+            WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+        ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+        ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+        ExpectIntEQ(wolfSSL_set_fd(ssl_c, fd_c), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_set_fd(ssl_s, fd_s), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_dtls_set_peer(ssl_c, &addr_s, sizeof(addr_s)),
+            WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_dtls_set_peer(ssl_s, &addr_c, sizeof(addr_c)),
+            WOLFSSL_SUCCESS);
+        wolfSSL_dtls_set_using_nonblock(ssl_c, 1);
+        wolfSSL_dtls_set_using_nonblock(ssl_s, 1);
+
+        ret_c = ret_s = WOLFSSL_FATAL_ERROR;
+        for (i = 0; i < 50 && EXPECT_SUCCESS() &&
+                (ret_c != WOLFSSL_SUCCESS || ret_s != WOLFSSL_SUCCESS); i++) {
+            if (ret_c != WOLFSSL_SUCCESS) {
+                ret_c = wolfSSL_connect(ssl_c);
+                if (ret_c != WOLFSSL_SUCCESS) {
+                    ExpectIntEQ(wolfSSL_get_error(ssl_c, ret_c),
+                        WOLFSSL_ERROR_WANT_READ);
+                }
+            }
+            if (ret_s != WOLFSSL_SUCCESS) {
+                ret_s = wolfSSL_accept(ssl_s);
+                if (ret_s != WOLFSSL_SUCCESS) {
+                    ExpectIntEQ(wolfSSL_get_error(ssl_s, ret_s),
+                        WOLFSSL_ERROR_WANT_READ);
+                }
+            }
+        }
+        ExpectIntEQ(ret_c, WOLFSSL_SUCCESS);
+        ExpectIntEQ(ret_s, WOLFSSL_SUCCESS);
+
+        ExpectIntEQ(wolfSSL_dtls_write_batch(ssl_c, wr, 0), 0);
+        ExpectIntEQ(wolfSSL_dtls_write_batch(ssl_c, wr, (int)XELEM_CNT(wr)),
+            (int)XELEM_CNT(wr));
+
+        /* All messages read in one batch with room to spare. */
+        for (i = 0; i < (int)XELEM_CNT(rd); i++) {
+            rd[i].iov_base = bufs[i];
+            rd[i].iov_len = sizeof(bufs[i]);
+        }
+        ExpectIntEQ(wolfSSL_dtls_read_batch(ssl_s, rd, (int)XELEM_CNT(rd)),
+            (int)XELEM_CNT(msgs));
+        for (i = 0; i < (int)XELEM_CNT(msgs) && EXPECT_SUCCESS(); i++) {
+            ExpectIntEQ((int)rd[i].iov_len, (int)XSTRLEN(msgs[i]));
+            ExpectBufEQ(bufs[i], msgs[i], XSTRLEN(msgs[i]));
+        }
+
+        /* Fewer buffers than messages: the rest stay pending. */
+        ExpectIntEQ(wolfSSL_dtls_write_batch(ssl_s, wr, (int)XELEM_CNT(wr)),
+            (int)XELEM_CNT(wr));
+        for (i = 0; i < 2; i++) {
+            rd[i].iov_base = bufs[i];
+            rd[i].iov_len = sizeof(bufs[i]);
+        }
+        ExpectIntEQ(wolfSSL_dtls_read_batch(ssl_c, rd, 2), 2);
+        ExpectBufEQ(bufs[1], msgs[1], XSTRLEN(msgs[1]));
+        ExpectIntEQ(wolfSSL_has_pending(ssl_c), 1);
+        for (i = 0; i < 3; i++) {
+            rd[i].iov_base = bufs[i];
+            rd[i].iov_len = sizeof(bufs[i]);
+        }
+        ExpectIntEQ(wolfSSL_dtls_read_batch(ssl_c, rd, 3), 3);
+        ExpectBufEQ(bufs[2], msgs[4], XSTRLEN(msgs[4]));
+        /* Nothing left - read would block. */
+        ExpectIntLE(wolfSSL_dtls_read_batch(ssl_c, rd, 1), 0);
+        ExpectIntEQ(wolfSSL_get_error(ssl_c, 0), WOLFSSL_ERROR_WANT_READ);
+
+        /* Peek returns the datagram read ahead and leaves it queued. */
+        ExpectIntEQ(wolfSSL_dtls_write_batch(ssl_s, wr, 2), 2);
+        ExpectIntGT(EmbedReceiveFrom(ssl_c, peekBuf[0],
+            (int)sizeof(peekBuf[0]), &ssl_c->buffers.dtlsCtx), 0);
+        wolfSSL_SetIOReadFlags(ssl_c, MSG_PEEK);
+        ExpectIntGT(peekSz = EmbedReceiveFrom(ssl_c, peekBuf[1],
+            (int)sizeof(peekBuf[1]), &ssl_c->buffers.dtlsCtx), 0);
+        wolfSSL_SetIOReadFlags(ssl_c, 0);
+        ExpectIntEQ(EmbedReceiveFrom(ssl_c, peekBuf[0],
+            (int)sizeof(peekBuf[0]), &ssl_c->buffers.dtlsCtx), peekSz);
+        ExpectBufEQ(peekBuf[0], peekBuf[1], peekSz);
+        ExpectIntEQ(EmbedReceiveFrom(ssl_c, peekBuf[0],
+            (int)sizeof(peekBuf[0]), &ssl_c->buffers.dtlsCtx),
+            WOLFSSL_CBIO_ERR_WANT_READ);
+
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        wolfSSL_CTX_free(ctx_c);
+        ctx_c = NULL;
+        wolfSSL_CTX_free(ctx_s);
+        ctx_s = NULL;
+        if (fd_c != SOCKET_INVALID)
+            CloseSocket(fd_c);
+        if (fd_s != SOCKET_INVALID)
+            CloseSocket(fd_s);
+        fd_c = fd_s = SOCKET_INVALID;
+    }
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(WOLFSSL_IO_URING) && defined(HAVE_IO_TESTS_DEPENDENCIES)
+/* Drive both ends of a connection on one ring until func is done on both. */
+static int test_io_uring_drive(WOLFSSL_URING* ring, WOLFSSL* ssl_c,
+    WOLFSSL* ssl_s, int (*func)(WOLFSSL* ssl, int idx))
+{
+    WOLFSSL* ready[2];
+    int done_c = 0;
+    int done_s = 0;
+    int ret;
+    int i;
+
+    for (i = 0; i < 200 && (!done_c || !done_s); i++) {
+        if (!done_c) {
+            ret = func(ssl_c, 0);
+            if (ret == WOLFSSL_SUCCESS)
+                done_c = 1;
+            else if (ret != WOLFSSL_ERROR_WANT_READ &&
+                     ret != WOLFSSL_ERROR_WANT_WRITE)
+                return TEST_FAIL;
+        }
+        if (!done_s) {
+            ret = func(ssl_s, 1);
+            if (ret == WOLFSSL_SUCCESS)
+                done_s = 1;
+            else if (ret != WOLFSSL_ERROR_WANT_READ &&
+                     ret != WOLFSSL_ERROR_WANT_WRITE)
+                return TEST_FAIL;
+        }
+        if (wolfSSL_IoUring_Submit(ring, !done_c || !done_s, ready, 2) < 0)
+            return TEST_FAIL;
+    }
+
+    return (done_c && done_s) ? TEST_SUCCESS : TEST_FAIL;
+}
+
+static int test_io_uring_handshake(WOLFSSL* ssl, int idx)
+{
+    int ret = (idx == 0) ? wolfSSL_connect(ssl) : wolfSSL_accept(ssl);
+
+    if (ret == WOLFSSL_SUCCESS)
+        return ret;
+    return wolfSSL_get_error(ssl, ret);
+}
+
+static byte test_io_uring_data[20000];
+static int test_io_uring_cnt[2];
+
+/* Client writes more than a staging buffer holds while server reads it. */
+static int test_io_uring_transfer(WOLFSSL* ssl, int idx)
+{
+    static byte buf[sizeof(test_io_uring_data)];
+    int ret;
+
+    if (idx == 0) {
+        ret = wolfSSL_write(ssl, test_io_uring_data,
+            (int)sizeof(test_io_uring_data));
+        if (ret == (int)sizeof(test_io_uring_data))
+            return WOLFSSL_SUCCESS;
+    }
+    else {
+        ret = wolfSSL_read(ssl, buf + test_io_uring_cnt[idx],
+            (int)sizeof(buf) - test_io_uring_cnt[idx]);
+        if (ret > 0) {
+            test_io_uring_cnt[idx] += ret;
+            if (test_io_uring_cnt[idx] < (int)sizeof(buf))
+                return WOLFSSL_ERROR_WANT_READ;
+            return (XMEMCMP(buf, test_io_uring_data, sizeof(buf)) == 0) ?
+                WOLFSSL_SUCCESS : WOLFSSL_FATAL_ERROR;
+        }
+    }
+    return wolfSSL_get_error(ssl, ret);
+}
+#endif
+
+static int test_wolfSSL_IoUring(void)
+{
+    EXPECT_DECLS;
+#if defined(WOLFSSL_IO_URING) && defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    !defined(WOLFSSL_NO_TLS12)
+    WOLFSSL_URING* ring = NULL;
+    WOLFSSL_URING_STATS stats;
+    WOLFSSL_CTX* ctx_c = NULL;
+    WOLFSSL_CTX* ctx_s = NULL;
+    WOLFSSL* ssl_c = NULL;
+    WOLFSSL* ssl_s = NULL;
+    WOLFSSL* ssl_x = NULL;
+    WOLFSSL* ready[2];
+    int fds[2] = { -1, -1 };
+    int flags;
+    int i;
+
+    ExpectNull(wolfSSL_IoUring_new(0, 0, HEAP_HINT));
+    ExpectNull(wolfSSL_IoUring_new(WOLFSSL_IO_URING_MAX_CONNS + 1, 0,
+        HEAP_HINT));
+    ExpectNull(wolfSSL_IoUring_new(1, 0x80, HEAP_HINT));
+    ExpectIntEQ(wolfSSL_SetIO_IoUring(NULL, NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_IoUring_Submit(NULL, 0, NULL, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_IoUring_Pending(NULL), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_IoUring_GetStats(NULL, &stats), BAD_FUNC_ARG);
+    wolfSSL_IoUring_free(NULL);
+
+    /* Kernel may have io_uring disabled. */
+    ring = wolfSSL_IoUring_new(2, 0, HEAP_HINT);
+    if (EXPECT_SUCCESS() && ring == NULL)
+        return TEST_SKIPPED;
+    wolfSSL_IoUring_free(ring);
+    ring = NULL;
+
+    for (i = 0; i < (int)sizeof(test_io_uring_data); i++)
+        test_io_uring_data[i] = (byte)i;
+
+    ExpectNotNull(ctx_c = wolfSSL_CTX_new(wolfTLSv1_2_client_method()));
+    ExpectNotNull(ctx_s = wolfSSL_CTX_new(wolfTLSv1_2_server_method()));
+    ExpectIntEQ(wolfSSL_CTX_load_verify_locations(ctx_c, caCertFile, 0),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_use_certificate_file(ctx_s, svrCertFile,
+        WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_use_PrivateKey_file(ctx_s, svrKeyFile,
+        WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+
+    for (flags = 0; flags <= WOLFSSL_IO_URING_FIXED_BUFFERS && EXPECT_SUCCESS();
+            flags++) {
+        ExpectNotNull(ring = wolfSSL_IoUring_new(2, flags, HEAP_HINT));
+        ExpectIntEQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        ExpectNotNull(ssl_c = wolfSSL_new(ctx_c));
+        ExpectNotNull(ssl_s = wolfSSL_new(ctx_s));
+        ExpectNotNull(ssl_x = wolfSSL_new(ctx_c));
+
+        /* Socket must be set first. */
+        ExpectIntEQ(wolfSSL_SetIO_IoUring(ssl_c, ring), BAD_STATE_E);
+        ExpectIntEQ(wolfSSL_set_fd(ssl_c, fds[0]), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_set_fd(ssl_s, fds[1]), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_set_fd(ssl_x, fds[0]), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_SetIO_IoUring(ssl_c, ring), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_SetIO_IoUring(ssl_c, ring), BAD_STATE_E);
+        ExpectIntEQ(wolfSSL_SetIO_IoUring(ssl_s, ring), WOLFSSL_SUCCESS);
+        /* No more connections on ring. */
+        ExpectIntEQ(wolfSSL_SetIO_IoUring(ssl_x, ring), MEMORY_E);
+
+        /* Nothing queued - returns without waiting. */
+        ExpectIntEQ(wolfSSL_IoUring_Submit(ring, 1, ready, 2), 0);
+
+        ExpectIntEQ(test_io_uring_drive(ring, ssl_c, ssl_s,
+            test_io_uring_handshake), TEST_SUCCESS);
+        XMEMSET(test_io_uring_cnt, 0, sizeof(test_io_uring_cnt));
+        ExpectIntEQ(test_io_uring_drive(ring, ssl_c, ssl_s,
+            test_io_uring_transfer), TEST_SUCCESS);
+        ExpectIntEQ(wolfSSL_IoUring_Pending(ssl_c), 0);
+        ExpectIntEQ(wolfSSL_IoUring_Pending(ssl_x), BAD_FUNC_ARG);
+
+        ExpectIntEQ(wolfSSL_IoUring_GetStats(ring, &stats), WOLFSSL_SUCCESS);
+        ExpectIntGT(stats.enters, 0);
+        ExpectIntGT(stats.submitted, 0);
+        ExpectIntGE(stats.submitted, stats.completed);
+        if (flags == 0)
+            ExpectIntEQ(stats.fixed, 0);
+
+        /* Freeing cancels the receive in flight and frees the connection. */
+        ExpectIntEQ(wolfSSL_read(ssl_s, ready, 1), WOLFSSL_FATAL_ERROR);
+        ExpectIntEQ(wolfSSL_get_error(ssl_s, WOLFSSL_FATAL_ERROR),
+            WOLFSSL_ERROR_WANT_READ);
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        for (i = 0; i < 100 && EXPECT_SUCCESS(); i++) {
+            if (wolfSSL_SetIO_IoUring(ssl_x, ring) == WOLFSSL_SUCCESS)
+                break;
+            ExpectIntGE(wolfSSL_IoUring_Submit(ring, 0, ready, 2), 0);
+        }
+        ExpectIntLT(i, 100);
+
+        wolfSSL_free(ssl_x);
+        ssl_x = NULL;
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_IoUring_free(ring);
+        ring = NULL;
+        if (fds[0] >= 0)
+            close(fds[0]);
+        if (fds[1] >= 0)
+            close(fds[1]);
+        fds[0] = fds[1] = -1;
+    }
+
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_RecordPool(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(WOLFSSL_RECORD_POOL)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    WOLFSSL_RECORD_POOL_STATS stats;
+    static byte msg[16384];
+    static byte reply[16384];
+    word32 allocs = 0;
+    int len;
+    int i;
+
+    ExpectIntEQ(wolfSSL_RecordPool_GetStats(NULL), BAD_FUNC_ARG);
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLS_client_method, wolfTLS_server_method), 0);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+
+    /* Idle connections hold no record buffers. */
+    ExpectIntEQ(wolfSSL_RecordPool_GetStats(&stats), WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.inUse, 0);
+    ExpectIntGT(stats.peakInUse, 0);
+
+    for (i = 0; i < 10 && EXPECT_SUCCESS(); i++) {
+        ExpectIntEQ(wolfSSL_write(ssl_c, msg, (int)sizeof(msg)),
+            (int)sizeof(msg));
+        for (len = 0; EXPECT_SUCCESS() && len < (int)sizeof(reply); ) {
+            int ret;
+            ExpectIntGT(ret = wolfSSL_read(ssl_s, reply + len,
+                (int)sizeof(reply) - len), 0);
+            if (ret > 0)
+                len += ret;
+        }
+        ExpectIntEQ(wolfSSL_RecordPool_GetStats(&stats), WOLFSSL_SUCCESS);
+        ExpectIntEQ(stats.inUse, 0);
+        /* Full records reuse the buffers of the first one. */
+        if (i == 0)
+            allocs = stats.allocs;
+        ExpectIntEQ(stats.allocs, allocs);
+    }
+
+    /* Idle buffers are freed when no longer wanted. */
+    ExpectIntEQ(wolfSSL_RecordPool_SetMaxIdle(0), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_RecordPool_GetStats(&stats), WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.idle, 0);
+    /* Buffers given back are then freed. */
+    ExpectIntEQ(wolfSSL_write(ssl_s, msg, (int)sizeof(msg)), (int)sizeof(msg));
+    ExpectIntEQ(wolfSSL_read(ssl_c, reply, (int)sizeof(reply)),
+        (int)sizeof(reply));
+    ExpectIntEQ(wolfSSL_RecordPool_GetStats(&stats), WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.idle, 0);
+    ExpectIntEQ(stats.inUse, 0);
+    ExpectIntEQ(wolfSSL_RecordPool_SetMaxIdle(WOLFSSL_RECORD_POOL_MAX_IDLE),
+        WOLFSSL_SUCCESS);
+
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_KeySharePool(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(WOLFSSL_KEY_SHARE_POOL) && \
+    (defined(HAVE_CURVE25519) || defined(HAVE_ECC))
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    WOLFSSL_KEY_SHARE_POOL_STATS stats;
+#ifdef HAVE_CURVE25519
+    word16 group = WOLFSSL_ECC_X25519;
+#else
+    word16 group = WOLFSSL_ECC_SECP256R1;
+#endif
+
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Set(NULL, group, 1), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Fill(NULL, 0), BAD_FUNC_ARG);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_GetStats(NULL, &stats),
+        BAD_FUNC_ARG);
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Set(ctx_c, 0, 1), BAD_FUNC_ARG);
+    /* Nothing to generate until a group is pooled. */
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Fill(ctx_c, 0), 0);
+
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Set(ctx_c, group, 2),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Set(ctx_s, group, 2),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Fill(ctx_c, 1), 1);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Fill(ctx_c, 0), 1);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Fill(ctx_c, 0), 0);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Fill(ctx_s, 0), 2);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_GetStats(ctx_c, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.ready, 2);
+    ExpectIntEQ(stats.generated, 2);
+    ExpectIntEQ(stats.hits, 0);
+
+    /* Both sides take their ephemeral key from the pool. */
+    ExpectIntEQ(wolfSSL_UseKeyShare(ssl_c, group), WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_GetStats(ctx_c, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.ready, 1);
+    ExpectIntEQ(stats.hits, 1);
+    ExpectIntEQ(stats.misses, 0);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_GetStats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.ready, 1);
+    ExpectIntEQ(stats.hits, 1);
+
+    /* Keys are dropped when the group is no longer pooled. */
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Set(ctx_s, group, 0),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_GetStats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.ready, 0);
+    ExpectIntEQ(wolfSSL_CTX_KeySharePool_Fill(ctx_s, 0), 0);
+
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+    return EXPECT_RESULT();
+}
+
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(WOLFSSL_CERT_COMPRESSION) && defined(HAVE_LIBZ)
+static int test_cert_comp_compress_calls = 0;
+static int test_cert_comp_decompress_calls = 0;
+
+static int test_cert_comp_compress(WOLFSSL* ssl, const byte* in, word32 inSz,
+    byte* out, word32 outSz)
+{
+    (void)ssl;
+    test_cert_comp_compress_calls++;
+    return wc_Compress(out, outSz, in, inSz, 0);
+}
+
+static int test_cert_comp_decompress(WOLFSSL* ssl, const byte* in,
+    word32 inSz, byte* out, word32 outSz)
+{
+    (void)ssl;
+    test_cert_comp_decompress_calls++;
+    return wc_DeCompress(out, outSz, in, inSz);
+}
+#endif
+
+static int test_wolfSSL_CertCompression(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(WOLFSSL_CERT_COMPRESSION) && defined(HAVE_LIBZ)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    int i;
+
+    test_cert_comp_compress_calls = 0;
+    test_cert_comp_decompress_calls = 0;
+
+    ExpectIntEQ(wolfSSL_CTX_AddCertCompression(NULL, WOLFSSL_CERT_COMP_ZLIB,
+        NULL, NULL), BAD_FUNC_ARG);
+
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+
+    ExpectIntEQ(wolfSSL_CTX_AddCertCompression(ctx_s, 0,
+        test_cert_comp_compress, NULL), BAD_FUNC_ARG);
+    /* No built-in support for brotli. */
+    ExpectIntEQ(wolfSSL_CTX_AddCertCompression(ctx_s,
+        WOLFSSL_CERT_COMP_BROTLI, NULL, NULL), BAD_FUNC_ARG);
+
+    /* Client not offering compression gets an uncompressed Certificate. */
+    ExpectIntEQ(wolfSSL_CTX_AddCertCompression(ctx_s, WOLFSSL_CERT_COMP_ZLIB,
+        test_cert_comp_compress, NULL), WOLFSSL_SUCCESS);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectIntEQ(test_cert_comp_compress_calls, 0);
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    wolfSSL_free(ssl_s);
+    ssl_s = NULL;
+
+    /* Unknown algorithm offered first - server picks the one it supports. */
+    ExpectIntEQ(wolfSSL_CTX_AddCertCompression(ctx_c, WOLFSSL_CERT_COMP_ZSTD,
+        NULL, test_cert_comp_decompress), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_AddCertCompression(ctx_c, WOLFSSL_CERT_COMP_ZLIB,
+        NULL, test_cert_comp_decompress), WOLFSSL_SUCCESS);
+
+    /* Chain is compressed on the first handshake and reused afterwards. */
+    for (i = 0; i < 2; i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c,
+            &ssl_s, wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        ExpectIntEQ(test_cert_comp_compress_calls, 1);
+        ExpectIntEQ(test_cert_comp_decompress_calls, i + 1);
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+    }
+
+    /* Replacing the callbacks drops the cached chain. Built-in zlib. */
+    ExpectIntEQ(wolfSSL_CTX_AddCertCompression(ctx_s, WOLFSSL_CERT_COMP_ZLIB,
+        NULL, NULL), WOLFSSL_SUCCESS);
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    ExpectIntEQ(test_cert_comp_compress_calls, 1);
+    ExpectIntEQ(test_cert_comp_decompress_calls, 3);
+
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_PrivKeyCache(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && \
+    defined(WOLFSSL_PRIV_KEY_CACHE) && !defined(NO_RSA) && \
+    defined(HAVE_ECC) && !defined(NO_FILESYSTEM) && \
+    !defined(WOLFSSL_BLIND_PRIVATE_KEY)
+    struct test_memio_ctx test_ctx;
+    WOLFSSL_CTX *ctx_c = NULL, *ctx_s = NULL;
+    WOLFSSL *ssl_c = NULL, *ssl_s = NULL;
+    WOLFSSL_PRIV_KEY_CACHE_STATS stats;
+    int i;
+
+    ExpectIntEQ(wolfSSL_CTX_PrivKeyCache_GetStats(NULL, &stats),
+        WC_NO_ERR_TRACE(BAD_FUNC_ARG));
+
+    /* First handshake decodes the key, the second reuses the object. */
+    for (i = 0; i < 2; i++) {
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c,
+            &ssl_s, wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        wolfSSL_free(ssl_c);
+        ssl_c = NULL;
+        wolfSSL_free(ssl_s);
+        ssl_s = NULL;
+        ExpectIntEQ(wolfSSL_CTX_PrivKeyCache_GetStats(ctx_s, &stats),
+            WOLFSSL_SUCCESS);
+        ExpectIntEQ(stats.misses, 1);
+        ExpectIntEQ(stats.hits, i);
+        ExpectIntEQ(stats.ready, 1);
+    }
+
+    /* Minimum key size of the SSL object is checked against cached key. */
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+    ExpectIntEQ(wolfSSL_SetMinRsaKey_Sz(ssl_s, 4096), WOLFSSL_SUCCESS);
+    ExpectIntNE(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    wolfSSL_free(ssl_c);
+    ssl_c = NULL;
+    wolfSSL_free(ssl_s);
+    ssl_s = NULL;
+    ExpectIntEQ(wolfSSL_CTX_PrivKeyCache_GetStats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.hits, 2);
+    ExpectIntEQ(stats.ready, 1);
+
+    /* Loading a new private key drops the decoded objects. */
+    ExpectIntEQ(wolfSSL_CTX_use_certificate_file(ctx_s, eccCertFile,
+        WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_use_PrivateKey_file(ctx_s, eccKeyFile,
+        WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_PrivKeyCache_GetStats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.ready, 0);
+    ExpectIntEQ(wolfSSL_CTX_load_verify_locations(ctx_c, caEccCertFile, 0),
+        WOLFSSL_SUCCESS);
+    XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+    ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+        wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+    ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+    wolfSSL_free(ssl_c);
+    wolfSSL_free(ssl_s);
+    ExpectIntEQ(wolfSSL_CTX_PrivKeyCache_GetStats(ctx_s, &stats),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(stats.misses, 2);
+    ExpectIntEQ(stats.ready, 1);
+
+    wolfSSL_CTX_free(ctx_c);
+    wolfSSL_CTX_free(ctx_s);
+#endif
+    return EXPECT_RESULT();
+}
+
 static int test_wolfSSL_reuse_WOLFSSLobj(void)
 {
     EXPECT_DECLS;
@@ -10622,6 +12905,176 @@ static int test_wolfSSL_CTX_add_session_ext_dtls1(void)
     return EXPECT_RESULT();
 }
 
+static int test_wolfSSL_CTX_sess_set_cache_size(void)
+{
+    EXPECT_DECLS;
+#if !defined(NO_SESSION_CACHE) && (defined(OPENSSL_ALL) || \
+    defined(WOLFSSL_HAPROXY) || defined(WOLFSSL_NGINX)) && \
+    !defined(NO_WOLFSSL_SERVER)
+    WOLFSSL_CTX* ctx = NULL;
+    WOLFSSL_CTX* ctx2 = NULL;
+    WOLFSSL_SESSION* sess = NULL;
+    byte id[ID_LEN];
+    long maxSz = 0;
+    long sz = 0;
+    int i;
+#ifdef WOLFSSL_SESSION_STATS
+    word32 active = 0;
+    word32 maxSessions = 0;
+    word32 evictions = 0;
+#endif
+
+    ExpectNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    ExpectNotNull(ctx2 = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    ExpectIntGT(maxSz = wolfSSL_CTX_sess_get_cache_size(ctx), 0);
+
+    /* Rounded up to a whole number of slots per row */
+    ExpectIntEQ(wolfSSL_CTX_sess_set_cache_size(ctx, 1), maxSz);
+    ExpectIntGT(sz = wolfSSL_CTX_sess_get_cache_size(ctx), 0);
+    ExpectIntLE(sz, maxSz);
+    /* The cache is global - the size applies to every context. */
+    ExpectIntEQ(wolfSSL_CTX_sess_get_cache_size(ctx2), sz);
+    ExpectIntEQ(wolfSSL_CTX_sess_get_cache_size(NULL), sz);
+    ExpectIntEQ(wolfSSL_CTX_sess_set_cache_size(ctx2, maxSz), sz);
+    ExpectIntEQ(wolfSSL_CTX_sess_get_cache_size(ctx), maxSz);
+    ExpectIntEQ(wolfSSL_CTX_sess_set_cache_size(ctx, 1), maxSz);
+    /* Limited to the compile time maximum */
+    ExpectIntEQ(wolfSSL_CTX_sess_set_cache_size(ctx, maxSz * 2), sz);
+    ExpectIntEQ(wolfSSL_CTX_sess_get_cache_size(ctx), maxSz);
+    ExpectIntEQ(wolfSSL_CTX_sess_set_cache_size(ctx, 1), maxSz);
+
+    /* Add more live sessions than fit so that some are evicted. */
+    XMEMSET(id, 0, sizeof(id));
+    for (i = 0; EXPECT_SUCCESS() && i < (int)(4 * sz); i++) {
+        id[0] = (byte)i;
+        id[1] = (byte)(i >> 8);
+        ExpectNotNull(sess = wolfSSL_SESSION_new());
+        ExpectIntEQ(wolfSSL_SESSION_set1_id(sess, id, ID_LEN), WOLFSSL_SUCCESS);
+        ExpectIntGT(wolfSSL_SESSION_set_time(sess, (long)XTIME(NULL)), 0);
+        ExpectIntGT(wolfSSL_SSL_SESSION_set_timeout(sess, 500), 0);
+        ExpectIntEQ(wolfSSL_CTX_add_session(ctx, sess), WOLFSSL_SUCCESS);
+        wolfSSL_SESSION_free(sess);
+        sess = NULL;
+    }
+#ifdef WOLFSSL_SESSION_STATS
+    ExpectIntEQ(wolfSSL_get_session_stats(&active, NULL, NULL, &maxSessions),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(maxSessions, sz);
+    ExpectIntLE(active, sz);
+    ExpectIntEQ(wolfSSL_get_session_cache_stats(NULL, NULL, &evictions),
+        WOLFSSL_SUCCESS);
+    ExpectIntGT(evictions, 0);
+#endif
+
+    /* Restore the full cache for the other tests. */
+    ExpectIntEQ(wolfSSL_CTX_sess_set_cache_size(ctx, maxSz), sz);
+    wolfSSL_CTX_free(ctx2);
+    wolfSSL_CTX_free(ctx);
+#endif
+    return EXPECT_RESULT();
+}
+
+static int test_wolfSSL_use_shared_session_cache(void)
+{
+    EXPECT_DECLS;
+#if !defined(NO_SESSION_CACHE) && defined(SESSION_CACHE_SHARED_MEM) && \
+    (defined(OPENSSL_ALL) || defined(WOLFSSL_HAPROXY) || \
+     defined(WOLFSSL_NGINX)) && defined(WOLFSSL_SESSION_STATS) && \
+    !defined(NO_WOLFSSL_SERVER)
+    WOLFSSL_CTX* ctx = NULL;
+    WOLFSSL_SESSION* sess = NULL;
+    byte id[ID_LEN];
+    word32 before = 0;
+    word32 after = 0;
+    word32 evictions = 0;
+    word32 maxSessions = 0;
+    long maxSz = 0;
+    pid_t pid = -1;
+    int status = -1;
+
+    ExpectIntEQ(wolfSSL_use_shared_session_cache(), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_use_shared_session_cache(), BAD_STATE_E);
+    ExpectNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    ExpectIntEQ(wolfSSL_get_session_stats(&before, NULL, NULL, NULL),
+        WOLFSSL_SUCCESS);
+
+    /* Session added by a forked worker is visible to the parent. */
+    XMEMSET(id, 0x5A, sizeof(id));
+    if (EXPECT_SUCCESS()) {
+        pid = fork();
+        if (pid == 0) {
+            int ok = 0;
+            sess = wolfSSL_SESSION_new();
+            if ((sess != NULL) &&
+                    (wolfSSL_SESSION_set1_id(sess, id, ID_LEN) ==
+                        WOLFSSL_SUCCESS) &&
+                    (wolfSSL_SESSION_set_time(sess, (long)XTIME(NULL)) > 0) &&
+                    (wolfSSL_SSL_SESSION_set_timeout(sess, 500) > 0) &&
+                    (wolfSSL_CTX_add_session(ctx, sess) == WOLFSSL_SUCCESS)) {
+                ok = 1;
+            }
+            _exit(ok ? 0 : 1);
+        }
+    }
+    ExpectIntGT(pid, 0);
+    ExpectIntEQ(waitpid(pid, &status, 0), pid);
+    ExpectTrue(WIFEXITED(status));
+    ExpectIntEQ(WEXITSTATUS(status), 0);
+    ExpectIntEQ(wolfSSL_get_session_stats(&after, NULL, NULL, NULL),
+        WOLFSSL_SUCCESS);
+    ExpectIntEQ(after, before + 1);
+
+    /* Cache size and counters changed by a worker are seen by the parent. */
+    ExpectIntGT(maxSz = wolfSSL_CTX_sess_get_cache_size(ctx), 0);
+    ExpectIntEQ(wolfSSL_get_session_cache_stats(NULL, NULL, &before),
+        WOLFSSL_SUCCESS);
+    if (EXPECT_SUCCESS()) {
+        pid = fork();
+        if (pid == 0) {
+            int ok = 1;
+            int i;
+            long sz;
+
+            (void)wolfSSL_CTX_sess_set_cache_size(ctx, 1);
+            sz = wolfSSL_CTX_sess_get_cache_size(ctx);
+            /* More live sessions than fit so that some are evicted. */
+            for (i = 0; ok && (i < (int)(4 * sz)); i++) {
+                id[0] = (byte)i;
+                id[1] = (byte)(i >> 8);
+                sess = wolfSSL_SESSION_new();
+                ok = (sess != NULL) &&
+                    (wolfSSL_SESSION_set1_id(sess, id, ID_LEN) ==
+                        WOLFSSL_SUCCESS) &&
+                    (wolfSSL_SESSION_set_time(sess, (long)XTIME(NULL)) > 0) &&
+                    (wolfSSL_SSL_SESSION_set_timeout(sess, 500) > 0) &&
+                    (wolfSSL_CTX_add_session(ctx, sess) == WOLFSSL_SUCCESS);
+                wolfSSL_SESSION_free(sess);
+            }
+            _exit(ok ? 0 : 1);
+        }
+    }
+    ExpectIntGT(pid, 0);
+    ExpectIntEQ(waitpid(pid, &status, 0), pid);
+    ExpectTrue(WIFEXITED(status));
+    ExpectIntEQ(WEXITSTATUS(status), 0);
+    ExpectIntEQ(wolfSSL_get_session_stats(NULL, NULL, NULL, &maxSessions),
+        WOLFSSL_SUCCESS);
+    ExpectIntLT(maxSessions, maxSz);
+    ExpectIntEQ(wolfSSL_get_session_cache_stats(NULL, NULL, &evictions),
+        WOLFSSL_SUCCESS);
+    ExpectIntGT(evictions, before);
+
+    /* Restore the full size and the process local cache for other tests. */
+    ExpectIntEQ(wolfSSL_CTX_sess_set_cache_size(ctx, maxSz), maxSessions);
+    ExpectIntEQ(wolfSSL_release_shared_session_cache(), WOLFSSL_SUCCESS);
+    ExpectIntEQ(wolfSSL_CTX_sess_get_cache_size(ctx), maxSz);
+    ExpectIntEQ(wolfSSL_release_shared_session_cache(), WOLFSSL_SUCCESS);
+
+    wolfSSL_CTX_free(ctx);
+#endif
+    return EXPECT_RESULT();
+}
+
 #if defined(WOLFSSL_DTLS) && defined(WOLFSSL_SESSION_EXPORT)
 /* canned export of a session using older version 3 */
 static unsigned char version_3[] = {
@@ -70702,6 +73155,121 @@ static int test_wolfSSL_ticket_keys(void)
     return EXPECT_RESULT();
 }
 
+#if defined(HAVE_SESSION_TICKET) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && \
+    !defined(NO_WOLFSSL_SERVER)
+/* Encrypt or decrypt a ticket with the default callback of the context. */
+static int test_ticket_enc_cb(WOLFSSL* ssl, byte* name, byte* iv, byte* mac,
+    byte* ticket, int enc)
+{
+    int outLen = 0;
+    int ret;
+
+    ret = ssl->ctx->ticketEncCb(ssl, name, iv, mac, enc, ticket,
+        (int)WOLFSSL_INTERNAL_TICKET_LEN, &outLen, ssl->ctx->ticketEncCtx);
+    if (ret == WC_NO_ERR_TRACE(WOLFSSL_TICKET_RET_CREATE))
+        ret = WOLFSSL_TICKET_RET_OK;
+    return ret;
+}
+#endif
+
+static int test_wolfSSL_ticket_key_rotation(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_SESSION_TICKET) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && \
+    !defined(NO_WOLFSSL_SERVER) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA)
+    WOLFSSL_CTX* ctx = NULL;
+    WOLFSSL_CTX* ctx2 = NULL;
+    WOLFSSL* ssl = NULL;
+    WOLFSSL* ssl2 = NULL;
+    byte keys[WOLFSSL_TICKET_KEYS_SZ];
+    byte name[2][WOLFSSL_TICKET_NAME_SZ];
+    byte iv[2][WOLFSSL_TICKET_IV_SZ];
+    byte mac[2][WOLFSSL_TICKET_MAC_SZ];
+    byte ticket[2][WOLFSSL_INTERNAL_TICKET_LEN];
+    byte plain[WOLFSSL_INTERNAL_TICKET_LEN];
+    byte tmp[WOLFSSL_INTERNAL_TICKET_LEN];
+    int idx[2] = { 0, 0 };
+    word32 now = (word32)XTIME(NULL);
+
+    XMEMSET(plain, 0xA5, sizeof(plain));
+    XMEMCPY(ticket[0], plain, sizeof(plain));
+    XMEMCPY(ticket[1], plain, sizeof(plain));
+
+    ExpectNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    /* Server object needs a certificate and key to be created. */
+    ExpectTrue(wolfSSL_CTX_use_certificate_file(ctx, svrCertFile,
+        WOLFSSL_FILETYPE_PEM));
+    ExpectTrue(wolfSSL_CTX_use_PrivateKey_file(ctx, svrKeyFile,
+        WOLFSSL_FILETYPE_PEM));
+    ExpectNotNull(ssl = wolfSSL_new(ctx));
+    ExpectIntEQ(test_ticket_enc_cb(ssl, name[0], iv[0], mac[0], ticket[0], 1),
+        WOLFSSL_TICKET_RET_OK);
+    if (EXPECT_SUCCESS()) {
+        idx[0] = name[0][WOLFSSL_TICKET_NAME_SZ - 1] &
+                 (WOLFSSL_TICKET_KEY_CNT - 1);
+        /* Key still valid for decryption but not for encrypting tickets. */
+        ctx->ticketKeyCtx.expirary[idx[0]] = now + 2;
+    }
+    ExpectIntEQ(test_ticket_enc_cb(ssl, name[1], iv[1], mac[1], ticket[1], 1),
+        WOLFSSL_TICKET_RET_OK);
+    if (EXPECT_SUCCESS()) {
+        idx[1] = name[1][WOLFSSL_TICKET_NAME_SZ - 1] &
+                 (WOLFSSL_TICKET_KEY_CNT - 1);
+    }
+    ExpectIntNE(idx[0], idx[1]);
+
+    /* Both tickets accepted by another context with the same keys. */
+    ExpectIntEQ(wolfSSL_CTX_get_tlsext_ticket_keys(ctx, keys, sizeof(keys)),
+        WOLFSSL_SUCCESS);
+    ExpectNotNull(ctx2 = wolfSSL_CTX_new(wolfSSLv23_server_method()));
+    ExpectIntEQ(wolfSSL_CTX_set_tlsext_ticket_keys(ctx2, keys, sizeof(keys)),
+        WOLFSSL_SUCCESS);
+    ExpectTrue(wolfSSL_CTX_use_certificate_file(ctx2, svrCertFile,
+        WOLFSSL_FILETYPE_PEM));
+    ExpectTrue(wolfSSL_CTX_use_PrivateKey_file(ctx2, svrKeyFile,
+        WOLFSSL_FILETYPE_PEM));
+    ExpectNotNull(ssl2 = wolfSSL_new(ctx2));
+    XMEMCPY(tmp, ticket[0], sizeof(tmp));
+    ExpectIntEQ(test_ticket_enc_cb(ssl2, name[0], iv[0], mac[0], tmp, 0),
+        WOLFSSL_TICKET_RET_OK);
+    ExpectBufEQ(tmp, plain, sizeof(plain));
+    XMEMCPY(tmp, ticket[1], sizeof(tmp));
+    ExpectIntEQ(test_ticket_enc_cb(ssl2, name[1], iv[1], mac[1], tmp, 0),
+        WOLFSSL_TICKET_RET_OK);
+    ExpectBufEQ(tmp, plain, sizeof(plain));
+
+    /* Both keys still usable for decryption. */
+    XMEMCPY(tmp, ticket[0], sizeof(tmp));
+    ExpectIntEQ(test_ticket_enc_cb(ssl, name[0], iv[0], mac[0], tmp, 0),
+        WOLFSSL_TICKET_RET_OK);
+    ExpectBufEQ(tmp, plain, sizeof(plain));
+    XMEMCPY(tmp, ticket[1], sizeof(tmp));
+    ExpectIntEQ(test_ticket_enc_cb(ssl, name[1], iv[1], mac[1], tmp, 0),
+        WOLFSSL_TICKET_RET_OK);
+    ExpectBufEQ(tmp, plain, sizeof(plain));
+
+    /* Ticket rejected once its key has expired. */
+    if (EXPECT_SUCCESS()) {
+        ctx->ticketKeyCtx.expirary[idx[0]] = 1;
+    }
+    XMEMCPY(tmp, ticket[0], sizeof(tmp));
+    ExpectIntEQ(test_ticket_enc_cb(ssl, name[0], iv[0], mac[0], tmp, 0),
+        WOLFSSL_TICKET_RET_REJECT);
+    /* Modified ticket rejected. */
+    XMEMCPY(tmp, ticket[1], sizeof(tmp));
+    tmp[0] ^= 0x01;
+    ExpectIntEQ(test_ticket_enc_cb(ssl, name[1], iv[1], mac[1], tmp, 0),
+        WOLFSSL_TICKET_RET_REJECT);
+
+    wolfSSL_free(ssl2);
+    wolfSSL_CTX_free(ctx2);
+    wolfSSL_free(ssl);
+    wolfSSL_CTX_free(ctx);
+#endif
+    return EXPECT_RESULT();
+}
+
 #ifndef NO_BIO
 
 static int test_wolfSSL_d2i_PUBKEY(void)
@@ -87552,6 +90120,14 @@ static word32 test_wolfSSL_dtls_stateless_HashWOLFSSL(const WOLFSSL* ssl)
     sslCopy.buffers.outputBuffer.bufferSize = 0;
     sslCopy.buffers.outputBuffer.dynamicFlag = 0;
     sslCopy.buffers.outputBuffer.offset = 0;
+#ifdef WOLFSSL_RECORD_POOL
+    sslCopy.buffers.inputBuffer.pooled = 0;
+    sslCopy.buffers.outputBuffer.pooled = 0;
+#endif
+#ifdef WOLFSSL_DTLS_MMSG
+    /* Datagram batch buffers are allocated on first use */
+    sslCopy.buffers.dtlsCtx.mmsg = NULL;
+#endif
     sslCopy.error = 0;
     sslCopy.curSize = 0;
     sslCopy.curStartIdx = 0;
@@ -97374,6 +99950,7 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wolfSSL_SESSION_expire_downgrade),
     TEST_DECL(test_wolfSSL_CTX_sess_set_remove_cb),
     TEST_DECL(test_wolfSSL_ticket_keys),
+    TEST_DECL(test_wolfSSL_ticket_key_rotation),
     TEST_DECL(test_wolfSSL_sk_GENERAL_NAME),
     TEST_DECL(test_wolfSSL_GENERAL_NAME_print),
     TEST_DECL(test_wolfSSL_sk_DIST_POINT),
@@ -97539,6 +100116,12 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wolfSSL_CertManagerLoadCABuffer_ex),
     TEST_DECL(test_wolfSSL_CertManagerGetCerts),
     TEST_DECL(test_wolfSSL_CertManagerSetVerify),
+    TEST_DECL(test_wolfSSL_CertManagerSignerKeyCache),
+    TEST_DECL(test_wolfSSL_CertManagerVerifyCache),
+    TEST_DECL(test_wolfSSL_CertManagerCaIndex),
+    TEST_DECL(test_wolfSSL_CertManagerCaIndexSameName),
+    TEST_DECL(test_wolfSSL_CertManagerCRLSerialIndex),
+    TEST_DECL(test_wolfSSL_CertManagerCompiledCRL),
     TEST_DECL(test_wolfSSL_CertManagerNameConstraint),
     TEST_DECL(test_wolfSSL_CertManagerNameConstraint2),
     TEST_DECL(test_wolfSSL_CertManagerNameConstraint3),
@@ -97546,6 +100129,8 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wolfSSL_CertManagerNameConstraint5),
     TEST_DECL(test_wolfSSL_CertManagerCRL),
     TEST_DECL(test_wolfSSL_CertManagerCheckOCSPResponse),
+    TEST_DECL(test_wolfSSL_CertManagerOCSPCache),
+    TEST_DECL(test_wolfSSL_CTX_OCSPStapleCache),
     TEST_DECL(test_wolfSSL_CheckOCSPResponse),
 #ifdef HAVE_CERT_CHAIN_VALIDATION
     TEST_DECL(test_various_pathlen_chains),
@@ -97622,6 +100207,8 @@ TEST_CASE testCases[] = {
     /* Large number of memory allocations. */
     TEST_DECL(test_wolfSSL_CTX_add_session_ext_dtls1),
 #endif
+    TEST_DECL(test_wolfSSL_CTX_sess_set_cache_size),
+    TEST_DECL(test_wolfSSL_use_shared_session_cache),
     TEST_DECL(test_SSL_CIPHER_get_xxx),
     TEST_DECL(test_wolfSSL_ERR_strings),
     TEST_DECL(test_wolfSSL_CTX_set_cipher_list_bytes),
@@ -97668,6 +100255,16 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_wolfSSL_dtls_set_mtu),
     /* Uses Assert in handshake callback. */
     TEST_DECL(test_wolfSSL_dtls_plaintext),
+    TEST_DECL(test_wolfSSL_writev),
+    TEST_DECL(test_wolfSSL_read_zc),
+    TEST_DECL(test_wolfSSL_send_batch),
+    TEST_DECL(test_wolfSSL_EnableKTLS),
+    TEST_DECL(test_wolfSSL_dtls_batch),
+    TEST_DECL(test_wolfSSL_IoUring),
+    TEST_DECL(test_wolfSSL_RecordPool),
+    TEST_DECL(test_wolfSSL_KeySharePool),
+    TEST_DECL(test_wolfSSL_CertCompression),
+    TEST_DECL(test_wolfSSL_PrivKeyCache),
 #if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
     defined(HAVE_IO_TESTS_DEPENDENCIES)
     TEST_DECL(test_wolfSSL_read_write),
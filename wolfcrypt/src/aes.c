@@ -6692,6 +6692,173 @@ void AES_GCM_decrypt_avx2(const unsigned char *in, unsigned char *out,
 #endif /* HAVE_INTEL_AVX1 */
 #endif /* HAVE_AES_DECRYPT */
 
+#if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+/* Wide-vector kernels need AVX2 with 256-bit AES and carry-less multiply. */
+#define IS_INTEL_AES_VAES(f)    (IS_INTEL_AVX2(f) && IS_INTEL_VAES(f) && \
+                                 IS_INTEL_VPCLMULQDQ(f))
+/* Bytes processed by each iteration of the wide-vector kernels. */
+#define AES_GCM_VAES_SZ         256
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Assembly code implementations in: aes_gcm_asm.S */
+extern void AES_GCM_init_avx2(const unsigned char* key, int nr,
+    const unsigned char* ivec, unsigned int ibytes, unsigned char* h,
+    unsigned char* counter, unsigned char* initCtr);
+extern void AES_GCM_aad_update_avx2(const unsigned char* addt,
+    unsigned int abytes, unsigned char* tag, unsigned char* h);
+extern void AES_GCM_encrypt_block_avx2(const unsigned char* key, int nr,
+    unsigned char* out, const unsigned char* in, unsigned char* counter);
+extern void AES_GCM_ghash_block_avx2(const unsigned char* data,
+    unsigned char* tag, unsigned char* h);
+extern void AES_GCM_encrypt_update_avx2(const unsigned char* key, int nr,
+    unsigned char* out, const unsigned char* in, unsigned int nbytes,
+    unsigned char* tag, unsigned char* h, unsigned char* counter);
+extern void AES_GCM_encrypt_final_avx2(unsigned char* tag,
+    unsigned char* authTag, unsigned int tbytes, unsigned int nbytes,
+    unsigned int abytes, unsigned char* h, unsigned char* initCtr);
+/* Only whole multiples of AES_GCM_VAES_SZ bytes are processed. */
+extern void AES_GCM_encrypt_update_vaes_avx2(const unsigned char* key, int nr,
+    unsigned char* out, const unsigned char* in, unsigned int nbytes,
+    unsigned char* tag, unsigned char* h, unsigned char* counter);
+#if defined(HAVE_AES_DECRYPT) || defined(HAVE_AESGCM_DECRYPT)
+extern void AES_GCM_decrypt_update_avx2(const unsigned char* key, int nr,
+    unsigned char* out, const unsigned char* in, unsigned int nbytes,
+    unsigned char* tag, unsigned char* h, unsigned char* counter);
+extern void AES_GCM_decrypt_final_avx2(unsigned char* tag,
+    const unsigned char* authTag, unsigned int tbytes, unsigned int nbytes,
+    unsigned int abytes, unsigned char* h, unsigned char* initCtr, int* res);
+/* Only whole multiples of AES_GCM_VAES_SZ bytes are processed. */
+extern void AES_GCM_decrypt_update_vaes_avx2(const unsigned char* key, int nr,
+    unsigned char* out, const unsigned char* in, unsigned int nbytes,
+    unsigned char* tag, unsigned char* h, unsigned char* counter);
+#endif /* HAVE_AES_DECRYPT || HAVE_AESGCM_DECRYPT */
+
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+
+/* GHASH the authentication data including a zero padded last block.
+ *
+ * @param [in]      addt    Authentication data.
+ * @param [in]      abytes  Length of authentication data in bytes.
+ * @param [in, out] tag     GHASH state.
+ * @param [in]      h       GHASH key.
+ */
+static void AES_GCM_aad_vaes(const byte* addt, word32 abytes, byte* tag,
+    byte* h)
+{
+    word32 blocksSz = abytes & (~(word32)(AES_BLOCK_SIZE - 1));
+
+    if (blocksSz > 0) {
+        AES_GCM_aad_update_avx2(addt, blocksSz, tag, h);
+    }
+    if (abytes > blocksSz) {
+        ALIGN16 byte last[AES_BLOCK_SIZE];
+
+        XMEMSET(last, 0, AES_BLOCK_SIZE);
+        XMEMCPY(last, addt + blocksSz, abytes - blocksSz);
+        AES_GCM_ghash_block_avx2(last, tag, h);
+    }
+}
+
+/* AES-GCM encrypt with the wide-vector kernel for the bulk of the data.
+ *
+ * The AVX2 streaming code handles the IV, authentication data, remaining
+ * blocks and the tag.
+ *
+ * Same parameters as AES_GCM_encrypt_avx2().
+ */
+static void AES_GCM_encrypt_vaes(const byte* in, byte* out, const byte* addt,
+    const byte* ivec, byte* tag, word32 nbytes, word32 abytes, word32 ibytes,
+    word32 tbytes, const byte* key, int nr)
+{
+    ALIGN16 byte h[AES_BLOCK_SIZE];
+    ALIGN16 byte counter[AES_BLOCK_SIZE];
+    ALIGN16 byte initCtr[AES_BLOCK_SIZE];
+    ALIGN16 byte ghash[AES_BLOCK_SIZE];
+    ALIGN16 byte last[AES_BLOCK_SIZE];
+    word32 sz = nbytes & (~(word32)(AES_GCM_VAES_SZ - 1));
+    word32 blocksSz = nbytes & (~(word32)(AES_BLOCK_SIZE - 1));
+
+    XMEMSET(ghash, 0, AES_BLOCK_SIZE);
+    AES_GCM_init_avx2(key, nr, ivec, ibytes, h, counter, initCtr);
+    AES_GCM_aad_vaes(addt, abytes, ghash, h);
+
+    AES_GCM_encrypt_update_vaes_avx2(key, nr, out, in, sz, ghash, h, counter);
+    if (blocksSz > sz) {
+        AES_GCM_encrypt_update_avx2(key, nr, out + sz, in + sz, blocksSz - sz,
+            ghash, h, counter);
+    }
+    if (nbytes > blocksSz) {
+        /* Encrypt the counter - XOR in zeros as proxy for plaintext. */
+        XMEMSET(last, 0, AES_BLOCK_SIZE);
+        AES_GCM_encrypt_block_avx2(key, nr, last, last, counter);
+        xorbuf(last, in + blocksSz, nbytes - blocksSz);
+        XMEMCPY(out + blocksSz, last, nbytes - blocksSz);
+        XMEMSET(last + nbytes - blocksSz, 0, AES_BLOCK_SIZE -
+            (nbytes - blocksSz));
+        AES_GCM_ghash_block_avx2(last, ghash, h);
+    }
+
+    AES_GCM_encrypt_final_avx2(ghash, tag, tbytes, nbytes, abytes, h, initCtr);
+
+    ForceZero(h, AES_BLOCK_SIZE);
+    ForceZero(initCtr, AES_BLOCK_SIZE);
+    ForceZero(last, AES_BLOCK_SIZE);
+}
+
+#if defined(HAVE_AES_DECRYPT) || defined(HAVE_AESGCM_DECRYPT)
+/* AES-GCM decrypt with the wide-vector kernel for the bulk of the data.
+ *
+ * The AVX2 streaming code handles the IV, authentication data, remaining
+ * blocks and the tag.
+ *
+ * Same parameters as AES_GCM_decrypt_avx2().
+ */
+static void AES_GCM_decrypt_vaes(const byte* in, byte* out, const byte* addt,
+    const byte* ivec, const byte* tag, word32 nbytes, word32 abytes,
+    word32 ibytes, word32 tbytes, const byte* key, int nr, int* res)
+{
+    ALIGN16 byte h[AES_BLOCK_SIZE];
+    ALIGN16 byte counter[AES_BLOCK_SIZE];
+    ALIGN16 byte initCtr[AES_BLOCK_SIZE];
+    ALIGN16 byte ghash[AES_BLOCK_SIZE];
+    ALIGN16 byte last[AES_BLOCK_SIZE];
+    word32 sz = nbytes & (~(word32)(AES_GCM_VAES_SZ - 1));
+    word32 blocksSz = nbytes & (~(word32)(AES_BLOCK_SIZE - 1));
+
+    XMEMSET(ghash, 0, AES_BLOCK_SIZE);
+    AES_GCM_init_avx2(key, nr, ivec, ibytes, h, counter, initCtr);
+    AES_GCM_aad_vaes(addt, abytes, ghash, h);
+
+    AES_GCM_decrypt_update_vaes_avx2(key, nr, out, in, sz, ghash, h, counter);
+    if (blocksSz > sz) {
+        AES_GCM_decrypt_update_avx2(key, nr, out + sz, in + sz, blocksSz - sz,
+            ghash, h, counter);
+    }
+    if (nbytes > blocksSz) {
+        /* GHASH the zero padded cipher text then decrypt. */
+        XMEMSET(last, 0, AES_BLOCK_SIZE);
+        XMEMCPY(last, in + blocksSz, nbytes - blocksSz);
+        AES_GCM_ghash_block_avx2(last, ghash, h);
+        XMEMSET(last, 0, AES_BLOCK_SIZE);
+        AES_GCM_encrypt_block_avx2(key, nr, last, last, counter);
+        xorbufout(out + blocksSz, last, in + blocksSz, nbytes - blocksSz);
+    }
+
+    AES_GCM_decrypt_final_avx2(ghash, tag, tbytes, nbytes, abytes, h, initCtr,
+        res);
+
+    ForceZero(h, AES_BLOCK_SIZE);
+    ForceZero(initCtr, AES_BLOCK_SIZE);
+    ForceZero(last, AES_BLOCK_SIZE);
+}
+#endif /* HAVE_AES_DECRYPT || HAVE_AESGCM_DECRYPT */
+#endif /* WOLFSSL_AES_VAES && HAVE_INTEL_AVX2 */
+
 #endif /* WOLFSSL_AESNI */
 
 #if defined(GCM_SMALL)
@@ -8553,6 +8720,14 @@ int wc_AesGcmEncrypt(Aes* aes, byte* out, const byte* in, word32 sz,
 
 #ifdef WOLFSSL_AESNI
     if (aes->use_aesni) {
+#if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+        if (IS_INTEL_AES_VAES(intel_flags) && (sz >= AES_GCM_VAES_SZ)) {
+            AES_GCM_encrypt_vaes(in, out, authIn, iv, authTag, sz, authInSz,
+                ivSz, authTagSz, (const byte*)aes->key, (int)aes->rounds);
+            ret = 0;
+        }
+        else
+#endif
 #ifdef HAVE_INTEL_AVX2
         if (IS_INTEL_AVX2(intel_flags)) {
             AES_GCM_encrypt_avx2(in, out, authIn, iv, authTag, sz, authInSz, ivSz,
@@ -9117,6 +9292,17 @@ int wc_AesGcmDecrypt(Aes* aes, byte* out, const byte* in, word32 sz,
 
 #ifdef WOLFSSL_AESNI
     if (aes->use_aesni) {
+#if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+        if (IS_INTEL_AES_VAES(intel_flags) && (sz >= AES_GCM_VAES_SZ)) {
+            AES_GCM_decrypt_vaes(in, out, authIn, iv, authTag, sz, authInSz,
+                ivSz, authTagSz, (byte*)aes->key, (int)aes->rounds, &res);
+            if (res == 0)
+                ret = AES_GCM_AUTH_E;
+            else
+                ret = 0;
+        }
+        else
+#endif
 #ifdef HAVE_INTEL_AVX2
         if (IS_INTEL_AVX2(intel_flags)) {
             AES_GCM_decrypt_avx2(in, out, authIn, iv, authTag, sz, authInSz, ivSz,
@@ -9625,6 +9811,20 @@ static WARN_UNUSED_RESULT int AesGcmEncryptUpdate_aesni(
         /* Calculate number of blocks of plaintext and the leftover. */
         blocks = cSz / AES_BLOCK_SIZE;
         partial = cSz % AES_BLOCK_SIZE;
+    #if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+        if (IS_INTEL_AES_VAES(intel_flags) &&
+                (blocks >= AES_GCM_VAES_SZ / AES_BLOCK_SIZE)) {
+            word32 vaesSz = (blocks * AES_BLOCK_SIZE) &
+                            (~(word32)(AES_GCM_VAES_SZ - 1));
+            /* Encrypt and GHASH bulk of blocks with wide-vector kernel. */
+            AES_GCM_encrypt_update_vaes_avx2((byte*)aes->key,
+                (int)aes->rounds, c, p, vaesSz, AES_TAG(aes), aes->gcm.H,
+                AES_COUNTER(aes));
+            p += vaesSz;
+            c += vaesSz;
+            blocks -= vaesSz / AES_BLOCK_SIZE;
+        }
+    #endif
         if (blocks > 0) {
             /* Encrypt and GHASH full blocks now. */
         #ifdef HAVE_INTEL_AVX2
@@ -9858,6 +10058,20 @@ static WARN_UNUSED_RESULT int AesGcmDecryptUpdate_aesni(
         /* Calculate number of blocks of plaintext and the leftover. */
         blocks = cSz / AES_BLOCK_SIZE;
         partial = cSz % AES_BLOCK_SIZE;
+    #if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+        if (IS_INTEL_AES_VAES(intel_flags) &&
+                (blocks >= AES_GCM_VAES_SZ / AES_BLOCK_SIZE)) {
+            word32 vaesSz = (blocks * AES_BLOCK_SIZE) &
+                            (~(word32)(AES_GCM_VAES_SZ - 1));
+            /* Decrypt and GHASH bulk of blocks with wide-vector kernel. */
+            AES_GCM_decrypt_update_vaes_avx2((byte*)aes->key,
+                (int)aes->rounds, p, c, vaesSz, AES_TAG(aes), aes->gcm.H,
+                AES_COUNTER(aes));
+            p += vaesSz;
+            c += vaesSz;
+            blocks -= vaesSz / AES_BLOCK_SIZE;
+        }
+    #endif
         if (blocks > 0) {
             /* Decrypt and GHASH full blocks now. */
         #ifdef HAVE_INTEL_AVX2
@@ -12762,7 +12976,7 @@ void AES_XTS_encrypt_aesni(const unsigned char *in, unsigned char *out, word32 s
                      const unsigned char* i, const unsigned char* key,
                      const unsigned char* key2, int nr)
                      XASM_LINK("AES_XTS_encrypt_aesni");
-#ifdef WOLFSSL_AESXTS_STREAM
+#if defined(WOLFSSL_AESXTS_STREAM) || defined(WOLFSSL_AES_VAES)
 void AES_XTS_init_aesni(unsigned char* i, const unsigned char* tweak_key,
                      int tweak_nr)
                      XASM_LINK("AES_XTS_init_aesni");
@@ -12776,7 +12990,7 @@ void AES_XTS_encrypt_avx1(const unsigned char *in, unsigned char *out,
                      const unsigned char* key, const unsigned char* key2,
                      int nr)
                      XASM_LINK("AES_XTS_encrypt_avx1");
-#ifdef WOLFSSL_AESXTS_STREAM
+#if defined(WOLFSSL_AESXTS_STREAM) || defined(WOLFSSL_AES_VAES)
 void AES_XTS_init_avx1(unsigned char* i, const unsigned char* tweak_key,
                      int tweak_nr)
                      XASM_LINK("AES_XTS_init_avx1");
@@ -12791,7 +13005,7 @@ void AES_XTS_decrypt_aesni(const unsigned char *in, unsigned char *out, word32 s
                      const unsigned char* i, const unsigned char* key,
                      const unsigned char* key2, int nr)
                      XASM_LINK("AES_XTS_decrypt_aesni");
-#ifdef WOLFSSL_AESXTS_STREAM
+#if defined(WOLFSSL_AESXTS_STREAM) || defined(WOLFSSL_AES_VAES)
 void AES_XTS_decrypt_update_aesni(const unsigned char *in, unsigned char *out, word32 sz,
                      const unsigned char* key, unsigned char *i, int nr)
                      XASM_LINK("AES_XTS_decrypt_update_aesni");
@@ -12802,7 +13016,7 @@ void AES_XTS_decrypt_avx1(const unsigned char *in, unsigned char *out,
                      const unsigned char* key, const unsigned char* key2,
                      int nr)
                      XASM_LINK("AES_XTS_decrypt_avx1");
-#ifdef WOLFSSL_AESXTS_STREAM
+#if defined(WOLFSSL_AESXTS_STREAM) || defined(WOLFSSL_AES_VAES)
 void AES_XTS_decrypt_update_avx1(const unsigned char *in, unsigned char *out, word32 sz,
                      const unsigned char* key, unsigned char *i, int nr)
                      XASM_LINK("AES_XTS_decrypt_update_avx1");
@@ -12810,6 +13024,117 @@ void AES_XTS_decrypt_update_avx1(const unsigned char *in, unsigned char *out, wo
 #endif /* HAVE_INTEL_AVX1 */
 #endif /* HAVE_AES_DECRYPT */
 
+#if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+#ifndef IS_INTEL_AES_VAES
+/* Wide-vector kernels need AVX2 with 256-bit AES and carry-less multiply. */
+#define IS_INTEL_AES_VAES(f)    (IS_INTEL_AVX2(f) && IS_INTEL_VAES(f) && \
+                                 IS_INTEL_VPCLMULQDQ(f))
+#endif
+/* Bytes processed by each iteration of the wide-vector kernels. */
+#define AES_XTS_VAES_SZ         256
+
+/* Only whole multiples of AES_XTS_VAES_SZ bytes are processed. */
+void AES_XTS_encrypt_update_vaes_avx2(const unsigned char *in,
+                     unsigned char *out, word32 sz, const unsigned char* key,
+                     unsigned char *i, int nr)
+                     XASM_LINK("AES_XTS_encrypt_update_vaes_avx2");
+#ifdef HAVE_AES_DECRYPT
+void AES_XTS_decrypt_update_vaes_avx2(const unsigned char *in,
+                     unsigned char *out, word32 sz, const unsigned char* key,
+                     unsigned char *i, int nr)
+                     XASM_LINK("AES_XTS_decrypt_update_vaes_avx2");
+#endif
+
+/* Number of bytes to give to the wide-vector kernel.
+ *
+ * When there is a partial block, the last full block is left for the
+ * AVX1 code to do cipher text stealing.
+ */
+static WC_INLINE word32 AesXtsVaesBulkSz(word32 sz)
+{
+    if ((sz & ((word32)AES_BLOCK_SIZE - 1U)) != 0)
+        sz -= AES_BLOCK_SIZE;
+    return sz & (~(word32)(AES_XTS_VAES_SZ - 1));
+}
+
+/* Encrypt from the current tweak with the wide-vector kernel for the bulk of
+ * the data and AVX1 for the remainder.
+ *
+ * in   input plain text buffer
+ * out  output cipher text buffer
+ * sz   size of both out and in buffers - at least AES_BLOCK_SIZE
+ * key  AES key schedule for data
+ * i    tweak of next block, updated on return
+ * nr   number of AES rounds
+ */
+static void AES_XTS_encrypt_update_vaes(const byte* in, byte* out, word32 sz,
+                                        const byte* key, byte* i, int nr)
+{
+    word32 bulkSz = AesXtsVaesBulkSz(sz);
+
+    if (bulkSz > 0) {
+        AES_XTS_encrypt_update_vaes_avx2(in, out, bulkSz, key, i, nr);
+    }
+    if (sz > bulkSz) {
+        AES_XTS_encrypt_update_avx1(in + bulkSz, out + bulkSz, sz - bulkSz,
+                                    key, i, nr);
+    }
+}
+
+/* One-shot encrypt using the wide-vector kernel.
+ *
+ * Same parameters as AES_XTS_encrypt_avx1().
+ */
+static void AES_XTS_encrypt_vaes(const byte* in, byte* out, word32 sz,
+                                 const byte* i, const byte* key,
+                                 const byte* key2, int nr)
+{
+    ALIGN16 byte tweak[AES_BLOCK_SIZE];
+
+    XMEMCPY(tweak, i, AES_BLOCK_SIZE);
+    AES_XTS_init_avx1(tweak, key2, nr);
+    AES_XTS_encrypt_update_vaes(in, out, sz, key, tweak, nr);
+    ForceZero(tweak, AES_BLOCK_SIZE);
+}
+
+#ifdef HAVE_AES_DECRYPT
+/* Decrypt from the current tweak with the wide-vector kernel for the bulk of
+ * the data and AVX1 for the remainder.
+ *
+ * Same parameters as AES_XTS_encrypt_update_vaes().
+ */
+static void AES_XTS_decrypt_update_vaes(const byte* in, byte* out, word32 sz,
+                                        const byte* key, byte* i, int nr)
+{
+    word32 bulkSz = AesXtsVaesBulkSz(sz);
+
+    if (bulkSz > 0) {
+        AES_XTS_decrypt_update_vaes_avx2(in, out, bulkSz, key, i, nr);
+    }
+    if (sz > bulkSz) {
+        AES_XTS_decrypt_update_avx1(in + bulkSz, out + bulkSz, sz - bulkSz,
+                                    key, i, nr);
+    }
+}
+
+/* One-shot decrypt using the wide-vector kernel.
+ *
+ * Same parameters as AES_XTS_decrypt_avx1().
+ */
+static void AES_XTS_decrypt_vaes(const byte* in, byte* out, word32 sz,
+                                 const byte* i, const byte* key,
+                                 const byte* key2, int nr)
+{
+    ALIGN16 byte tweak[AES_BLOCK_SIZE];
+
+    XMEMCPY(tweak, i, AES_BLOCK_SIZE);
+    AES_XTS_init_avx1(tweak, key2, nr);
+    AES_XTS_decrypt_update_vaes(in, out, sz, key, tweak, nr);
+    ForceZero(tweak, AES_BLOCK_SIZE);
+}
+#endif /* HAVE_AES_DECRYPT */
+#endif /* WOLFSSL_AES_VAES && HAVE_INTEL_AVX2 */
+
 #endif /* WOLFSSL_AESNI */
 
 #if !defined(WOLFSSL_ARMASM) || defined(WOLFSSL_ARMASM_NO_HW_CRYPTO)
@@ -13054,6 +13379,17 @@ int wc_AesXtsEncrypt(XtsAes* xaes, byte* out, const byte* in, word32 sz,
 #ifdef WOLFSSL_AESNI
         if (aes->use_aesni) {
             SAVE_VECTOR_REGISTERS(return _svr_ret;);
+#if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+            if (IS_INTEL_AES_VAES(intel_flags) &&
+                    (sz >= AES_XTS_VAES_SZ)) {
+                AES_XTS_encrypt_vaes(in, out, sz, i,
+                                     (const byte*)aes->key,
+                                     (const byte*)xaes->tweak.key,
+                                     (int)aes->rounds);
+                ret = 0;
+            }
+            else
+#endif
 #if defined(HAVE_INTEL_AVX1)
             if (IS_INTEL_AVX1(intel_flags)) {
                 AES_XTS_encrypt_avx1(in, out, sz, i,
@@ -13214,6 +13550,17 @@ static int AesXtsEncryptUpdate(XtsAes* xaes, byte* out, const byte* in, word32 s
 #ifdef WOLFSSL_AESNI
         if (aes->use_aesni) {
             SAVE_VECTOR_REGISTERS(return _svr_ret;);
+#if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+            if (IS_INTEL_AES_VAES(intel_flags) &&
+                    (sz >= AES_XTS_VAES_SZ)) {
+                AES_XTS_encrypt_update_vaes(in, out, sz,
+                                            (const byte*)aes->key,
+                                            stream->tweak_block,
+                                            (int)aes->rounds);
+                ret = 0;
+            }
+            else
+#endif
 #if defined(HAVE_INTEL_AVX1)
             if (IS_INTEL_AVX1(intel_flags)) {
                 AES_XTS_encrypt_update_avx1(in, out, sz,
@@ -13487,6 +13834,17 @@ int wc_AesXtsDecrypt(XtsAes* xaes, byte* out, const byte* in, word32 sz,
 #ifdef WOLFSSL_AESNI
         if (aes->use_aesni) {
             SAVE_VECTOR_REGISTERS(return _svr_ret;);
+#if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+            if (IS_INTEL_AES_VAES(intel_flags) &&
+                    (sz >= AES_XTS_VAES_SZ)) {
+                AES_XTS_decrypt_vaes(in, out, sz, i,
+                                     (const byte*)aes->key,
+                                     (const byte*)xaes->tweak.key,
+                                     (int)aes->rounds);
+                ret = 0;
+            }
+            else
+#endif
 #if defined(HAVE_INTEL_AVX1)
             if (IS_INTEL_AVX1(intel_flags)) {
                 AES_XTS_decrypt_avx1(in, out, sz, i,
@@ -13641,6 +13999,17 @@ static int AesXtsDecryptUpdate(XtsAes* xaes, byte* out, const byte* in, word32 s
 #ifdef WOLFSSL_AESNI
         if (aes->use_aesni) {
             SAVE_VECTOR_REGISTERS(return _svr_ret;);
+#if defined(WOLFSSL_AES_VAES) && defined(HAVE_INTEL_AVX2)
+            if (IS_INTEL_AES_VAES(intel_flags) &&
+                    (sz >= AES_XTS_VAES_SZ)) {
+                AES_XTS_decrypt_update_vaes(in, out, sz,
+                                            (const byte*)aes->key,
+                                            stream->tweak_block,
+                                            (int)aes->rounds);
+                ret = 0;
+            }
+            else
+#endif
 #if defined(HAVE_INTEL_AVX1)
             if (IS_INTEL_AVX1(intel_flags)) {
                 AES_XTS_decrypt_update_avx1(in, out, sz,
@@ -199,6 +199,11 @@ ASN Options:
     #include <wolfssl/wolfcrypt/cryptocb.h>
 #endif
 
+#if defined(WOLFSSL_SIGNER_KEY_CACHE) && !defined(SINGLE_THREADED) && \
+    !defined(WOLFSSL_ATOMIC_OPS)
+    #error "Signer key cache requires atomic operations."
+#endif
+
 #ifndef WOLFCRYPT_ONLY
     #include <wolfssl/internal.h>
 #endif
@@ -16478,6 +16483,97 @@ void InitSignatureCtx(SignatureCtx* sigCtx, void* heap, int devId)
     }
 }
 
+#ifdef WOLFSSL_SIGNER_KEY_CACHE
+/* Free the decoded public key object cached in a signer.
+ *
+ * @param [in, out] signer  Signer object.
+ */
+static void FreeSignerKeyObj(Signer* signer)
+{
+    SignerKeyCache* cache = signer->keyCache;
+
+    if ((cache == NULL) || (cache->obj == NULL))
+        return;
+
+    switch (signer->keyOID) {
+    #ifndef NO_RSA
+        #ifdef WC_RSA_PSS
+        case RSAPSSk:
+        #endif
+        case RSAk:
+            wc_FreeRsaKey((RsaKey*)cache->obj);
+            XFREE(cache->obj, cache->heap, DYNAMIC_TYPE_RSA);
+            break;
+    #endif
+    #ifdef HAVE_ECC
+        #if defined(WOLFSSL_SM2) && defined(WOLFSSL_SM3)
+        case SM2k:
+        #endif
+        case ECDSAk:
+            wc_ecc_free((ecc_key*)cache->obj);
+            XFREE(cache->obj, cache->heap, DYNAMIC_TYPE_ECC);
+            break;
+    #endif
+        default:
+            break;
+    }
+    cache->obj = NULL;
+}
+
+/* Take hold of the decoded public key object of the signer.
+ *
+ * Only one verification holds a signer's object at a time. A verification
+ * that can't get hold of it decodes the key into its own object as before.
+ * When the signer has no object yet, the holder decodes the key and gives
+ * the object to the signer with SignerKeyKeep().
+ *
+ * @param [in, out] sigCtx  Signature context object.
+ * @param [in]      key     Public key data to verify with.
+ * @param [in]      keyOID  Public key algorithm.
+ * @return  1 when the signer's decoded object is now in sigCtx->key.
+ * @return  0 when the key is to be decoded.
+ */
+static int SignerKeyTake(SignatureCtx* sigCtx, const byte* key, word32 keyOID)
+{
+    Signer* signer = sigCtx->signer;
+    SignerKeyCache* cache;
+
+    if ((signer == NULL) || (signer->keyCache == NULL) ||
+            (key != signer->publicKey) || (keyOID != signer->keyOID) ||
+            (sigCtx->devId != INVALID_DEVID)) {
+        return 0;
+    }
+    cache = signer->keyCache;
+    if (wolfSSL_Atomic_Int_FetchAdd(&cache->busy, 1) != 0) {
+        /* In use by another verification. */
+        (void)wolfSSL_Atomic_Int_FetchSub(&cache->busy, 1);
+        return 0;
+    }
+    sigCtx->keyCache = cache;
+    if (cache->obj == NULL) {
+        return 0;
+    }
+    sigCtx->key.ptr = cache->obj;
+    sigCtx->keyBorrowed = 1;
+    return 1;
+}
+
+/* Give the newly decoded public key object to the signer being held.
+ *
+ * @param [in, out] sigCtx  Signature context object.
+ */
+static void SignerKeyKeep(SignatureCtx* sigCtx)
+{
+    SignerKeyCache* cache = sigCtx->keyCache;
+
+    if ((cache != NULL) && !sigCtx->keyBorrowed) {
+        cache->obj = sigCtx->key.ptr;
+        cache->heap = sigCtx->heap;
+        sigCtx->keyBorrowed = 1;
+    }
+}
+#endif /* WOLFSSL_SIGNER_KEY_CACHE */
+
 /* Free dynamic data in a signature context object.
  *
  * @param [in, out] sigCtx  Signature context object.
@@ -16487,6 +16583,19 @@ void FreeSignatureCtx(SignatureCtx* sigCtx)
     if (sigCtx == NULL)
         return;
 
+#ifdef WOLFSSL_SIGNER_KEY_CACHE
+    if (sigCtx->keyCache != NULL) {
+        if (sigCtx->keyBorrowed) {
+            /* Key object belongs to the signer. */
+            sigCtx->key.ptr = NULL;
+            sigCtx->keyBorrowed = 0;
+        }
+        (void)wolfSSL_Atomic_Int_FetchSub(&sigCtx->keyCache->busy, 1);
+        sigCtx->keyCache = NULL;
+    }
+    sigCtx->signer = NULL;
+#endif
+
     XFREE(sigCtx->digest, sigCtx->heap, DYNAMIC_TYPE_DIGEST);
     sigCtx->digest = NULL;
 #if !(defined(NO_RSA) && defined(NO_DSA))
@@ -16888,15 +16997,6 @@ static int ConfirmSignature(SignatureCtx* sigCtx,
                 {
                     word32 idx = 0;
 
-                    sigCtx->key.rsa = (RsaKey*)XMALLOC(sizeof(RsaKey),
-                                                sigCtx->heap, DYNAMIC_TYPE_RSA);
-                    if (sigCtx->key.rsa == NULL) {
-                        ERROR_OUT(MEMORY_E, exit_cs);
-                    }
-                    if ((ret = wc_InitRsaKey_ex(sigCtx->key.rsa, sigCtx->heap,
-                                                        sigCtx->devId)) != 0) {
-                        goto exit_cs;
-                    }
                     sigCtx->sigCpy = (byte*)XMALLOC(sigSz, sigCtx->heap,
                                                         DYNAMIC_TYPE_SIGNATURE);
                     if (sigCtx->sigCpy == NULL) {
@@ -16906,11 +17006,28 @@ static int ConfirmSignature(SignatureCtx* sigCtx,
                         WOLFSSL_MSG("Verify Signature is too big");
                         ERROR_OUT(BUFFER_E, exit_cs);
                     }
-                    if ((ret = wc_RsaPublicKeyDecode(key, &idx, sigCtx->key.rsa,
-                                                                 keySz)) != 0) {
-                        WOLFSSL_MSG("ASN Key decode error RSA");
-                        WOLFSSL_ERROR_VERBOSE(ret);
-                        goto exit_cs;
+                #ifdef WOLFSSL_SIGNER_KEY_CACHE
+                    if (!SignerKeyTake(sigCtx, key, keyOID))
+                #endif
+                    {
+                        sigCtx->key.rsa = (RsaKey*)XMALLOC(sizeof(RsaKey),
+                                                sigCtx->heap, DYNAMIC_TYPE_RSA);
+                        if (sigCtx->key.rsa == NULL) {
+                            ERROR_OUT(MEMORY_E, exit_cs);
+                        }
+                        if ((ret = wc_InitRsaKey_ex(sigCtx->key.rsa,
+                                        sigCtx->heap, sigCtx->devId)) != 0) {
+                            goto exit_cs;
+                        }
+                        if ((ret = wc_RsaPublicKeyDecode(key, &idx,
+                                            sigCtx->key.rsa, keySz)) != 0) {
+                            WOLFSSL_MSG("ASN Key decode error RSA");
+                            WOLFSSL_ERROR_VERBOSE(ret);
+                            goto exit_cs;
+                        }
+                    #ifdef WOLFSSL_SIGNER_KEY_CACHE
+                        SignerKeyKeep(sigCtx);
+                    #endif
                     }
                     XMEMCPY(sigCtx->sigCpy, sig, sigSz);
                     sigCtx->out = NULL;
@@ -17046,6 +17163,11 @@ static int ConfirmSignature(SignatureCtx* sigCtx,
                       WC_ASYNC_ENABLE_ECC */
 
                     sigCtx->verify = 0;
+                #ifdef WOLFSSL_SIGNER_KEY_CACHE
+                    if (SignerKeyTake(sigCtx, key, keyOID)) {
+                        break;
+                    }
+                #endif
                     sigCtx->key.ecc = (ecc_key*)XMALLOC(sizeof(ecc_key),
                                                 sigCtx->heap, DYNAMIC_TYPE_ECC);
                     if (sigCtx->key.ecc == NULL) {
@@ -17077,6 +17199,9 @@ static int ConfirmSignature(SignatureCtx* sigCtx,
                         WOLFSSL_ERROR_VERBOSE(ret);
                         goto exit_cs;
                     }
+                #ifdef WOLFSSL_SIGNER_KEY_CACHE
+                    SignerKeyKeep(sigCtx);
+                #endif
                 #ifdef WOLFSSL_ASYNC_CRYPT
                     sigCtx->asyncDev = &sigCtx->key.ecc->asyncDev;
                 #endif
@@ -24116,10 +24241,26 @@ int ParseCertRelative(DecodedCert* cert, int type, int verify, void* cm, Signer
             if (verify == VERIFY || verify == VERIFY_OCSP ||
                                                  verify == VERIFY_SKIP_DATE) {
                 word32 keyOID = cert->ca->keyOID;
+            #ifdef WOLFSSL_CERT_VERIFY_CACHE
+                byte verifyId[WC_SHA256_DIGEST_SIZE];
+                int  verifyCached;
+            #endif
             #if defined(WOLFSSL_SM2) && defined(WOLFSSL_SM3)
                 if (cert->selfSigned && (cert->signatureOID == CTC_SM3wSM2)) {
                     keyOID = SM2k;
                 }
+            #endif
+            #ifdef WOLFSSL_SIGNER_KEY_CACHE
+                cert->sigCtx.signer = cert->ca;
+            #endif
+            #ifdef WOLFSSL_CERT_VERIFY_CACHE
+                /* Same CA key and same signed data: already verified. */
+                verifyCached = CM_VerifyCacheLookup(cm, cert, keyOID,
+                    verifyId);
+                if (verifyCached == 1) {
+                    WOLFSSL_MSG("Signature verification result cached");
+                }
+                else
             #endif
                 /* try to confirm/verify signature */
                 if ((ret = ConfirmSignature(&cert->sigCtx,
@@ -24141,6 +24282,11 @@ int ParseCertRelative(DecodedCert* cert, int type, int verify, void* cm, Signer
                     WOLFSSL_ERROR_VERBOSE(ret);
                     return ret;
                 }
+            #ifdef WOLFSSL_CERT_VERIFY_CACHE
+                else if (verifyCached == 0) {
+                    CM_VerifyCacheAdd(cm, verifyId);
+                }
+            #endif
 
             #ifdef WOLFSSL_DUAL_ALG_CERTS
                 if ((ret == 0) && cert->extAltSigAlgSet &&
@@ -24381,6 +24527,15 @@ Signer* MakeSigner(void* heap)
                                        DYNAMIC_TYPE_SIGNER);
     if (signer) {
         XMEMSET(signer, 0, sizeof(Signer));
+    #ifdef WOLFSSL_SIGNER_KEY_CACHE
+        signer->keyCache = (SignerKeyCache*)XMALLOC(sizeof(SignerKeyCache),
+                                                heap, DYNAMIC_TYPE_SIGNER);
+        if (signer->keyCache == NULL) {
+            XFREE(signer, heap, DYNAMIC_TYPE_SIGNER);
+            return NULL;
+        }
+        XMEMSET(signer->keyCache, 0, sizeof(SignerKeyCache));
+    #endif
     }
     (void)heap;
 
@@ -24413,6 +24568,12 @@ void FreeSigner(Signer* signer, void* heap)
 #endif
 #ifdef WOLFSSL_SIGNER_DER_CERT
     FreeDer(&signer->derCert);
+#endif
+#ifdef WOLFSSL_SIGNER_KEY_CACHE
+    if (signer->keyCache != NULL) {
+        FreeSignerKeyObj(signer);
+        XFREE(signer->keyCache, heap, DYNAMIC_TYPE_SIGNER);
+    }
 #endif
     XFREE(signer, heap, DYNAMIC_TYPE_SIGNER);
 }
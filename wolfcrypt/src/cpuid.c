@@ -97,6 +97,8 @@
             if (cpuid_flag(1, 0, ECX, 22)) { cpuid_flags |= CPUID_MOVBE ; }
             if (cpuid_flag(7, 0, EBX,  3)) { cpuid_flags |= CPUID_BMI1  ; }
             if (cpuid_flag(7, 0, EBX, 29)) { cpuid_flags |= CPUID_SHA   ; }
+            if (cpuid_flag(7, 0, ECX,  9)) { cpuid_flags |= CPUID_VAES  ; }
+            if (cpuid_flag(7, 0, ECX, 10)) { cpuid_flags |= CPUID_VPCLMULQDQ; }
 
             cpuid_check = 1;
         }
@@ -1909,6 +1909,204 @@ static void dilithium_vec_encode_w1(const sword32* w1, byte k, sword32 gamma2,
  * Expand operations
  ******************************************************************************/
 
+#ifndef WOLFSSL_DILITHIUM_SMALL
+/* Create polynomial from the first blocks of SHAKE-128 output.
+ *
+ * DILITHIUM_GEN_A_NBLOCKS blocks give a high probability of being able to get
+ * 256 valid 3-byte, 23-bit values.
+ *
+ * @param [out] a  Polynomial.
+ * @param [in]  h  SHAKE-128 output. Has space for one more byte.
+ * @return  Number of values put into polynomial.
+ */
+static unsigned int dilithium_rej_ntt_poly_first(sword32* a, byte* h)
+{
+    unsigned int j = 0;
+    unsigned int c;
+
+#if defined(LITTLE_ENDIAN_ORDER) && (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
+    /* Reading 4 bytes for 3 so need to set 1 past for last read. */
+    h[DILITHIUM_GEN_A_BYTES] = 0;
+#endif
+
+    /* Use the first 256 triplets and know we won't exceed required. */
+#ifdef WOLFSSL_DILITHIUM_NO_LARGE_CODE
+    for (c = 0; c < (DILITHIUM_N - 1) * 3; c += 3) {
+    #if defined(LITTLE_ENDIAN_ORDER) && (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
+        /* Load 32-bit value and mask out 23 bits. */
+        sword32 t = *((sword32*)(h + c)) & 0x7fffff;
+    #else
+        /* Load 24-bit value and mask out 23 bits. */
+        sword32 t = (h[c] + ((sword32)h[c+1] << 8) +
+                     ((sword32)h[c+2] << 16)) & 0x7fffff;
+    #endif
+        /* Check if value is in valid range. */
+        if (t < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t;
+        }
+    }
+    /* Use the remaining triplets, checking we have enough. */
+    for (; c < DILITHIUM_GEN_A_BYTES; c += 3) {
+    #if defined(LITTLE_ENDIAN_ORDER) && (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
+        /* Load 32-bit value and mask out 23 bits. */
+        sword32 t = *((sword32*)(h + c)) & 0x7fffff;
+    #else
+        /* Load 24-bit value and mask out 23 bits. */
+        sword32 t = (h[c] + ((sword32)h[c+1] << 8) +
+                     ((sword32)h[c+2] << 16)) & 0x7fffff;
+    #endif
+        /* Check if value is in valid range. */
+        if (t < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t;
+            /* Check we whether we have enough yet. */
+            if (j == DILITHIUM_N) {
+                break;
+            }
+        }
+    }
+#else
+    /* Do 15 bytes at a time: 255 * 3 / 15 = 51 */
+    for (c = 0; c < DILITHIUM_N * 3; c += 24) {
+    #if defined(LITTLE_ENDIAN_ORDER) && (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
+        /* Load 32-bit value and mask out 23 bits. */
+        sword32 t0 = *((sword32*)(h + c +  0)) & 0x7fffff;
+        sword32 t1 = *((sword32*)(h + c +  3)) & 0x7fffff;
+        sword32 t2 = *((sword32*)(h + c +  6)) & 0x7fffff;
+        sword32 t3 = *((sword32*)(h + c +  9)) & 0x7fffff;
+        sword32 t4 = *((sword32*)(h + c + 12)) & 0x7fffff;
+        sword32 t5 = *((sword32*)(h + c + 15)) & 0x7fffff;
+        sword32 t6 = *((sword32*)(h + c + 18)) & 0x7fffff;
+        sword32 t7 = *((sword32*)(h + c + 21)) & 0x7fffff;
+    #else
+        /* Load 24-bit value and mask out 23 bits. */
+        sword32 t0 = (h[c +  0] + ((sword32)h[c +  1] << 8) +
+                      ((sword32)h[c +  2] << 16)) & 0x7fffff;
+        sword32 t1 = (h[c +  3] + ((sword32)h[c +  4] << 8) +
+                      ((sword32)h[c +  5] << 16)) & 0x7fffff;
+        sword32 t2 = (h[c +  6] + ((sword32)h[c +  7] << 8) +
+                      ((sword32)h[c +  8] << 16)) & 0x7fffff;
+        sword32 t3 = (h[c +  9] + ((sword32)h[c + 10] << 8) +
+                      ((sword32)h[c + 11] << 16)) & 0x7fffff;
+        sword32 t4 = (h[c + 12] + ((sword32)h[c + 13] << 8) +
+                      ((sword32)h[c + 14] << 16)) & 0x7fffff;
+        sword32 t5 = (h[c + 15] + ((sword32)h[c + 16] << 8) +
+                      ((sword32)h[c + 17] << 16)) & 0x7fffff;
+        sword32 t6 = (h[c + 18] + ((sword32)h[c + 19] << 8) +
+                      ((sword32)h[c + 20] << 16)) & 0x7fffff;
+        sword32 t7 = (h[c + 21] + ((sword32)h[c + 22] << 8) +
+                      ((sword32)h[c + 23] << 16)) & 0x7fffff;
+    #endif
+        /* Check if value is in valid range. */
+        if (t0 < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t0;
+        }
+        /* Check if value is in valid range. */
+        if (t1 < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t1;
+        }
+        /* Check if value is in valid range. */
+        if (t2 < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t2;
+        }
+        /* Check if value is in valid range. */
+        if (t3 < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t3;
+        }
+        /* Check if value is in valid range. */
+        if (t4 < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t4;
+        }
+        /* Check if value is in valid range. */
+        if (t5 < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t5;
+        }
+        /* Check if value is in valid range. */
+        if (t6 < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t6;
+        }
+        /* Check if value is in valid range. */
+        if (t7 < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values. */
+            a[j++] = t7;
+        }
+    }
+    if (j < DILITHIUM_N) {
+        /* Use the remaining triplets, checking we have enough. */
+        for (; c < DILITHIUM_GEN_A_BYTES; c += 3) {
+        #if defined(LITTLE_ENDIAN_ORDER) && \
+            (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
+            /* Load 32-bit value and mask out 23 bits. */
+            sword32 t = *((sword32*)(h + c)) & 0x7fffff;
+        #else
+            /* Load 24-bit value and mask out 23 bits. */
+            sword32 t = (h[c] + ((sword32)h[c+1] << 8) +
+                         ((sword32)h[c+2] << 16)) & 0x7fffff;
+        #endif
+            /* Check if value is in valid range. */
+            if (t < DILITHIUM_Q) {
+                /* Store value in polynomial and increment count of values.
+                 */
+                a[j++] = t;
+                /* Check we whether we have enough yet. */
+                if (j == DILITHIUM_N) {
+                    break;
+                }
+            }
+        }
+    }
+#endif
+
+    return j;
+}
+
+/* Continue polynomial with another block of SHAKE-128 output.
+ *
+ * @param [out] a  Polynomial.
+ * @param [in]  j  Number of values already in polynomial.
+ * @param [in]  h  Block of SHAKE-128 output.
+ * @return  Number of values now in polynomial.
+ */
+static unsigned int dilithium_rej_ntt_poly_next(sword32* a, unsigned int j,
+    byte* h)
+{
+    unsigned int c;
+
+    /* Use triplets until run out or have enough for polynomial. */
+    for (c = 0; c < DILITHIUM_GEN_A_BLOCK_BYTES; c += 3) {
+    #if defined(LITTLE_ENDIAN_ORDER) && \
+        (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
+        /* Load 32-bit value and mask out 23 bits. */
+        sword32 t = *((sword32*)(h + c)) & 0x7fffff;
+    #else
+        /* Load 24-bit value and mask out 23 bits. */
+        sword32 t = (h[c] + ((sword32)h[c+1] << 8) +
+                     ((sword32)h[c+2] << 16)) & 0x7fffff;
+    #endif
+        /* Check if value is in valid range. */
+        if (t < DILITHIUM_Q) {
+            /* Store value in polynomial and increment count of values.
+             */
+            a[j++] = t;
+            /* Check we whether we have enough yet. */
+            if (j == DILITHIUM_N) {
+                break;
+            }
+        }
+    }
+
+    return j;
+}
+#endif
+
 /* Generate a random polynomial by rejection.
  *
  * FIPS 204. 8.3: Algorithm 24 RejNTTPoly(rho)
@@ -1990,154 +2188,15 @@ static int dilithium_rej_ntt_poly_ex(wc_Shake* shake128, byte* seed, sword32* a,
         }
     }
 #else
-    unsigned int j = 0;
-    unsigned int c;
+    unsigned int j;
 
     /* Generate enough SHAKE-128 output blocks to give high probability of
      * being able to get 256 valid 3-byte, 23-bit values from it. */
     ret = dilithium_squeeze128(shake128, seed, DILITHIUM_GEN_A_SEED_SZ, h,
         DILITHIUM_GEN_A_NBLOCKS);
     if (ret == 0) {
-    #if defined(LITTLE_ENDIAN_ORDER) && (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
-        /* Reading 4 bytes for 3 so need to set 1 past for last read. */
-        h[DILITHIUM_GEN_A_BYTES] = 0;
-    #endif
-
-        /* Use the first 256 triplets and know we won't exceed required. */
-    #ifdef WOLFSSL_DILITHIUM_NO_LARGE_CODE
-        for (c = 0; c < (DILITHIUM_N - 1) * 3; c += 3) {
-        #if defined(LITTLE_ENDIAN_ORDER) && (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
-            /* Load 32-bit value and mask out 23 bits. */
-            sword32 t = *((sword32*)(h + c)) & 0x7fffff;
-        #else
-            /* Load 24-bit value and mask out 23 bits. */
-            sword32 t = (h[c] + ((sword32)h[c+1] << 8) +
-                         ((sword32)h[c+2] << 16)) & 0x7fffff;
-        #endif
-            /* Check if value is in valid range. */
-            if (t < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t;
-            }
-        }
-        /* Use the remaining triplets, checking we have enough. */
-        for (; c < DILITHIUM_GEN_A_BYTES; c += 3) {
-        #if defined(LITTLE_ENDIAN_ORDER) && (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
-            /* Load 32-bit value and mask out 23 bits. */
-            sword32 t = *((sword32*)(h + c)) & 0x7fffff;
-        #else
-            /* Load 24-bit value and mask out 23 bits. */
-            sword32 t = (h[c] + ((sword32)h[c+1] << 8) +
-                         ((sword32)h[c+2] << 16)) & 0x7fffff;
-        #endif
-            /* Check if value is in valid range. */
-            if (t < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t;
-                /* Check we whether we have enough yet. */
-                if (j == DILITHIUM_N) {
-                    break;
-                }
-            }
-        }
-    #else
-        /* Do 15 bytes at a time: 255 * 3 / 15 = 51 */
-        for (c = 0; c < DILITHIUM_N * 3; c += 24) {
-        #if defined(LITTLE_ENDIAN_ORDER) && (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
-            /* Load 32-bit value and mask out 23 bits. */
-            sword32 t0 = *((sword32*)(h + c +  0)) & 0x7fffff;
-            sword32 t1 = *((sword32*)(h + c +  3)) & 0x7fffff;
-            sword32 t2 = *((sword32*)(h + c +  6)) & 0x7fffff;
-            sword32 t3 = *((sword32*)(h + c +  9)) & 0x7fffff;
-            sword32 t4 = *((sword32*)(h + c + 12)) & 0x7fffff;
-            sword32 t5 = *((sword32*)(h + c + 15)) & 0x7fffff;
-            sword32 t6 = *((sword32*)(h + c + 18)) & 0x7fffff;
-            sword32 t7 = *((sword32*)(h + c + 21)) & 0x7fffff;
-        #else
-            /* Load 24-bit value and mask out 23 bits. */
-            sword32 t0 = (h[c +  0] + ((sword32)h[c +  1] << 8) +
-                          ((sword32)h[c +  2] << 16)) & 0x7fffff;
-            sword32 t1 = (h[c +  3] + ((sword32)h[c +  4] << 8) +
-                          ((sword32)h[c +  5] << 16)) & 0x7fffff;
-            sword32 t2 = (h[c +  6] + ((sword32)h[c +  7] << 8) +
-                          ((sword32)h[c +  8] << 16)) & 0x7fffff;
-            sword32 t3 = (h[c +  9] + ((sword32)h[c + 10] << 8) +
-                          ((sword32)h[c + 11] << 16)) & 0x7fffff;
-            sword32 t4 = (h[c + 12] + ((sword32)h[c + 13] << 8) +
-                          ((sword32)h[c + 14] << 16)) & 0x7fffff;
-            sword32 t5 = (h[c + 15] + ((sword32)h[c + 16] << 8) +
-                          ((sword32)h[c + 17] << 16)) & 0x7fffff;
-            sword32 t6 = (h[c + 18] + ((sword32)h[c + 19] << 8) +
-                          ((sword32)h[c + 20] << 16)) & 0x7fffff;
-            sword32 t7 = (h[c + 21] + ((sword32)h[c + 22] << 8) +
-                          ((sword32)h[c + 23] << 16)) & 0x7fffff;
-        #endif
-            /* Check if value is in valid range. */
-            if (t0 < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t0;
-            }
-            /* Check if value is in valid range. */
-            if (t1 < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t1;
-            }
-            /* Check if value is in valid range. */
-            if (t2 < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t2;
-            }
-            /* Check if value is in valid range. */
-            if (t3 < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t3;
-            }
-            /* Check if value is in valid range. */
-            if (t4 < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t4;
-            }
-            /* Check if value is in valid range. */
-            if (t5 < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t5;
-            }
-            /* Check if value is in valid range. */
-            if (t6 < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t6;
-            }
-            /* Check if value is in valid range. */
-            if (t7 < DILITHIUM_Q) {
-                /* Store value in polynomial and increment count of values. */
-                a[j++] = t7;
-            }
-        }
-        if (j < DILITHIUM_N) {
-            /* Use the remaining triplets, checking we have enough. */
-            for (; c < DILITHIUM_GEN_A_BYTES; c += 3) {
-            #if defined(LITTLE_ENDIAN_ORDER) && \
-                (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
-                /* Load 32-bit value and mask out 23 bits. */
-                sword32 t = *((sword32*)(h + c)) & 0x7fffff;
-            #else
-                /* Load 24-bit value and mask out 23 bits. */
-                sword32 t = (h[c] + ((sword32)h[c+1] << 8) +
-                             ((sword32)h[c+2] << 16)) & 0x7fffff;
-            #endif
-                /* Check if value is in valid range. */
-                if (t < DILITHIUM_Q) {
-                    /* Store value in polynomial and increment count of values.
-                     */
-                    a[j++] = t;
-                    /* Check we whether we have enough yet. */
-                    if (j == DILITHIUM_N) {
-                        break;
-                    }
-                }
-            }
-        }
-    #endif
+        /* Use the first blocks of output. */
+        j = dilithium_rej_ntt_poly_first(a, h);
         /* Keep generating more blocks and using triplets until we have enough.
          */
         while (j < DILITHIUM_N) {
@@ -2147,27 +2206,7 @@ static int dilithium_rej_ntt_poly_ex(wc_Shake* shake128, byte* seed, sword32* a,
                 break;
             }
             /* Use triplets until run out or have enough for polynomial. */
-            for (c = 0; c < DILITHIUM_GEN_A_BLOCK_BYTES; c += 3) {
-            #if defined(LITTLE_ENDIAN_ORDER) && \
-                (WOLFSSL_DILITHIUM_ALIGNMENT == 0)
-                /* Load 32-bit value and mask out 23 bits. */
-                sword32 t = *((sword32*)(h + c)) & 0x7fffff;
-            #else
-                /* Load 24-bit value and mask out 23 bits. */
-                sword32 t = (h[c] + ((sword32)h[c+1] << 8) +
-                             ((sword32)h[c+2] << 16)) & 0x7fffff;
-            #endif
-                /* Check if value is in valid range. */
-                if (t < DILITHIUM_Q) {
-                    /* Store value in polynomial and increment count of values.
-                     */
-                    a[j++] = t;
-                    /* Check we whether we have enough yet. */
-                    if (j == DILITHIUM_N) {
-                        break;
-                    }
-                }
-            }
+            j = dilithium_rej_ntt_poly_next(a, j, h);
         }
     }
 #endif
@@ -2230,6 +2269,88 @@ static int dilithium_rej_ntt_poly(wc_Shake* shake128, byte* seed, sword32* a,
     (!defined(WOLFSSL_DILITHIUM_NO_SIGN) && \
      (!defined(WOLFSSL_DILITHIUM_SIGN_SMALL_MEM) || \
       defined(WC_DILITHIUM_CACHE_MATRIX_A)))
+#if defined(WC_SHAKE_X4) && !defined(WOLFSSL_DILITHIUM_SMALL)
+/* Generate four random polynomials by rejection using four-way SHAKE-128.
+ *
+ * FIPS 204. 8.3: Algorithm 24 RejNTTPoly(rho)
+ *
+ * @param [in]  seed  Four seeds of DILITHIUM_GEN_A_SEED_SZ bytes each.
+ * @param [out] a     Four consecutive polynomials.
+ * @param [in]  heap  Dynamic memory hint.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Negative on hash error.
+ */
+static int dilithium_rej_ntt_poly_x4(const byte* seed, sword32* a, void* heap)
+{
+    int ret = 0;
+    int i;
+    unsigned int j[4];
+    const byte* in[4];
+    byte* out[4];
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Shakex4* shake = NULL;
+    byte* h = NULL;
+#else
+    wc_Shakex4 shake[1];
+    byte h[4 * DILITHIUM_REJ_NTT_POLY_H_SIZE];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    shake = (wc_Shakex4*)XMALLOC(sizeof(wc_Shakex4), heap,
+        DYNAMIC_TYPE_DILITHIUM);
+    h = (byte*)XMALLOC(4 * DILITHIUM_REJ_NTT_POLY_H_SIZE, heap,
+        DYNAMIC_TYPE_DILITHIUM);
+    if ((shake == NULL) || (h == NULL)) {
+        ret = MEMORY_E;
+    }
+#endif
+
+    if (ret == 0) {
+        ret = wc_InitShake128x4(shake, heap, INVALID_DEVID);
+    }
+    if (ret == 0) {
+        for (i = 0; i < 4; i++) {
+            in[i] = seed + i * DILITHIUM_GEN_A_SEED_SZ;
+            out[i] = h + i * DILITHIUM_REJ_NTT_POLY_H_SIZE;
+        }
+        /* Absorb the four seeds. */
+        ret = wc_Shake128x4_Absorb(shake, in, DILITHIUM_GEN_A_SEED_SZ);
+    }
+    if (ret == 0) {
+        /* Generate enough SHAKE-128 output blocks for each polynomial to give
+         * high probability of having 256 valid values. */
+        ret = wc_Shake128x4_SqueezeBlocks(shake, out, DILITHIUM_GEN_A_NBLOCKS);
+    }
+    if (ret == 0) {
+        for (i = 0; i < 4; i++) {
+            j[i] = dilithium_rej_ntt_poly_first(a + i * DILITHIUM_N, out[i]);
+        }
+        /* Keep generating a block for each until all polynomials are full. */
+        while ((j[0] < DILITHIUM_N) || (j[1] < DILITHIUM_N) ||
+               (j[2] < DILITHIUM_N) || (j[3] < DILITHIUM_N)) {
+            ret = wc_Shake128x4_SqueezeBlocks(shake, out, 1);
+            if (ret != 0) {
+                break;
+            }
+            for (i = 0; i < 4; i++) {
+                if (j[i] < DILITHIUM_N) {
+                    j[i] = dilithium_rej_ntt_poly_next(a + i * DILITHIUM_N,
+                        j[i], out[i]);
+                }
+            }
+        }
+    }
+
+    wc_Shake128x4_Free(shake);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(h, heap, DYNAMIC_TYPE_DILITHIUM);
+    XFREE(shake, heap, DYNAMIC_TYPE_DILITHIUM);
+#endif
+    return ret;
+}
+#endif
+
 /* Expand the seed to create matrix a.
  *
  * FIPS 204. 8.3: Algorithm 26 ExpandA(rho)
@@ -2254,6 +2375,31 @@ static int dilithium_expand_a(wc_Shake* shake128, const byte* pub_seed, byte k,
     byte l, sword32* a, void* heap)
 {
     int ret = 0;
+#if defined(WC_SHAKE_X4) && !defined(WOLFSSL_DILITHIUM_SMALL)
+    unsigned int i;
+    unsigned int c;
+    unsigned int n = (unsigned int)k * l;
+    byte seed[4 * DILITHIUM_GEN_A_SEED_SZ];
+
+    /* Steps 1-3: Create four polynomials at a time with index r * l + s. */
+    for (i = 0; (ret == 0) && (i + 4 <= n); i += 4) {
+        for (c = 0; c < 4; c++) {
+            byte* sd = seed + c * DILITHIUM_GEN_A_SEED_SZ;
+
+            XMEMCPY(sd, pub_seed, DILITHIUM_PUB_SEED_SZ);
+            sd[DILITHIUM_PUB_SEED_SZ + 0] = (byte)((i + c) % l);
+            sd[DILITHIUM_PUB_SEED_SZ + 1] = (byte)((i + c) / l);
+        }
+        ret = dilithium_rej_ntt_poly_x4(seed, a + i * DILITHIUM_N, heap);
+    }
+    /* Create remaining polynomials one at a time. */
+    XMEMCPY(seed, pub_seed, DILITHIUM_PUB_SEED_SZ);
+    for (; (ret == 0) && (i < n); i++) {
+        seed[DILITHIUM_PUB_SEED_SZ + 0] = (byte)(i % l);
+        seed[DILITHIUM_PUB_SEED_SZ + 1] = (byte)(i / l);
+        ret = dilithium_rej_ntt_poly(shake128, seed, a + i * DILITHIUM_N, heap);
+    }
+#else
     byte r;
     byte s;
     byte seed[DILITHIUM_GEN_A_SEED_SZ];
@@ -2274,6 +2420,7 @@ static int dilithium_expand_a(wc_Shake* shake128, const byte* pub_seed, byte k,
             a += DILITHIUM_N;
         }
     }
+#endif
 
     return ret;
 }
@@ -2668,6 +2815,89 @@ static int dilithium_rej_bound_poly(wc_Shake* shake256, byte* seed, sword32* s,
 #endif
 }
 
+#if defined(WC_SHAKE_X4) && !defined(WOLFSSL_DILITHIUM_SMALL)
+/* Create four polynomials from hashing the seeds with bounded values.
+ *
+ * FIPS 204. 8.3: Algorithm 25 RejBoundedPoly(rho)
+ *
+ * @param [in]  seed  Four seeds of DILITHIUM_GEN_S_SEED_SZ bytes each.
+ * @param [out] s     Four polynomials.
+ * @param [in]  eta   Range specifier of each value.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Negative on hash error.
+ */
+static int dilithium_rej_bound_poly_x4(const byte* seed, sword32** s, byte eta)
+{
+    int ret = 0;
+    int i;
+    unsigned int j[4] = { 0, 0, 0, 0 };
+    const byte* in[4];
+    byte* out[4];
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Shakex4* shake = NULL;
+    byte* z = NULL;
+#else
+    wc_Shakex4 shake[1];
+    byte z[4 * DILITHIUM_GEN_S_BYTES];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    shake = (wc_Shakex4*)XMALLOC(sizeof(wc_Shakex4), NULL,
+        DYNAMIC_TYPE_DILITHIUM);
+    z = (byte*)XMALLOC(4 * DILITHIUM_GEN_S_BYTES, NULL,
+        DYNAMIC_TYPE_DILITHIUM);
+    if ((shake == NULL) || (z == NULL)) {
+        ret = MEMORY_E;
+    }
+#endif
+
+    if (ret == 0) {
+        ret = wc_InitShake256x4(shake, NULL, INVALID_DEVID);
+    }
+    if (ret == 0) {
+        for (i = 0; i < 4; i++) {
+            in[i] = seed + i * DILITHIUM_GEN_S_SEED_SZ;
+            out[i] = z + i * DILITHIUM_GEN_S_BYTES;
+        }
+        /* Absorb the four seeds. */
+        ret = wc_Shake256x4_Absorb(shake, in, DILITHIUM_GEN_S_SEED_SZ);
+    }
+    if (ret == 0) {
+        /* Squeeze out some blocks for each polynomial. */
+        ret = wc_Shake256x4_SqueezeBlocks(shake, out, DILITHIUM_GEN_S_NBLOCKS);
+    }
+    if (ret == 0) {
+        /* Extract up to 256 valid coefficients for each polynomial. */
+        for (i = 0; i < 4; i++) {
+            dilithium_extract_coeffs(out[i], DILITHIUM_GEN_S_BYTES, eta, s[i],
+                &j[i]);
+        }
+        /* Keep generating a block for each until all polynomials are full. */
+        while ((j[0] < DILITHIUM_N) || (j[1] < DILITHIUM_N) ||
+               (j[2] < DILITHIUM_N) || (j[3] < DILITHIUM_N)) {
+            ret = wc_Shake256x4_SqueezeBlocks(shake, out, 1);
+            if (ret != 0) {
+                break;
+            }
+            for (i = 0; i < 4; i++) {
+                if (j[i] < DILITHIUM_N) {
+                    dilithium_extract_coeffs(out[i],
+                        DILITHIUM_GEN_S_BLOCK_BYTES, eta, s[i], &j[i]);
+                }
+            }
+        }
+    }
+
+    wc_Shake256x4_Free(shake);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(z, NULL, DYNAMIC_TYPE_DILITHIUM);
+    XFREE(shake, NULL, DYNAMIC_TYPE_DILITHIUM);
+#endif
+    return ret;
+}
+#endif
+
 /* Expand private seed into vectors s1 and s2.
  *
  * FIPS 204. 8.3: Algorithm 27 ExpandS(rho)
@@ -2693,6 +2923,47 @@ static int dilithium_expand_s(wc_Shake* shake256, byte* priv_seed, byte eta,
     sword32* s1, byte s1Len, sword32* s2, byte s2Len)
 {
     int ret = 0;
+#if defined(WC_SHAKE_X4) && !defined(WOLFSSL_DILITHIUM_SMALL)
+    unsigned int r;
+    unsigned int c;
+    unsigned int n = (unsigned int)s1Len + s2Len;
+    byte seed[4 * DILITHIUM_GEN_S_SEED_SZ];
+    sword32* s[4];
+
+    /* Steps 1-6: Create four polynomials at a time with r indexing s1 then
+     * s2. */
+    for (r = 0; (ret == 0) && (r + 4 <= n); r += 4) {
+        for (c = 0; c < 4; c++) {
+            byte* sd = seed + c * DILITHIUM_GEN_S_SEED_SZ;
+
+            XMEMCPY(sd, priv_seed, DILITHIUM_PRIV_SEED_SZ);
+            /* Set r into buffer - little endian. */
+            sd[DILITHIUM_PRIV_SEED_SZ + 0] = (byte)(r + c);
+            sd[DILITHIUM_PRIV_SEED_SZ + 1] = 0;
+            if (r + c < s1Len) {
+                s[c] = s1 + (r + c) * DILITHIUM_N;
+            }
+            else {
+                s[c] = s2 + (r + c - s1Len) * DILITHIUM_N;
+            }
+        }
+        ret = dilithium_rej_bound_poly_x4(seed, s, eta);
+    }
+    /* Create remaining polynomials one at a time. */
+    XMEMCPY(seed, priv_seed, DILITHIUM_PRIV_SEED_SZ);
+    seed[DILITHIUM_PRIV_SEED_SZ + 1] = 0;
+    for (; (ret == 0) && (r < n); r++) {
+        seed[DILITHIUM_PRIV_SEED_SZ] = (byte)r;
+        if (r < s1Len) {
+            ret = dilithium_rej_bound_poly(shake256, seed,
+                s1 + r * DILITHIUM_N, eta);
+        }
+        else {
+            ret = dilithium_rej_bound_poly(shake256, seed,
+                s2 + (r - s1Len) * DILITHIUM_N, eta);
+        }
+    }
+#else
     byte r;
     byte seed[DILITHIUM_GEN_S_SEED_SZ];
 
@@ -2719,6 +2990,7 @@ static int dilithium_expand_s(wc_Shake* shake256, byte* priv_seed, byte eta,
         /* Next polynomial in s2. */
         s2 += DILITHIUM_N;
     }
+#endif
 
     return ret;
 }
@@ -2726,6 +2998,93 @@ static int dilithium_expand_s(wc_Shake* shake256, byte* priv_seed, byte eta,
 #endif /* !WOLFSSL_DILITHIUM_NO_MAKE_KEY */
 
 #ifndef WOLFSSL_DILITHIUM_NO_SIGN
+#if defined(WC_SHAKE_X4) && !defined(WOLFSSL_DILITHIUM_SMALL)
+/* Expand the private random seed into four polynomials of vector y.
+ *
+ * FIPS 204. 8.3: Algorithm 28 ExpandMask(rho, mu)
+ *   3:     n <- IntegerToBits(mu + r, 16)
+ *   4:     v <- (H(rho||n)[[32rc]], H(rho||n)[[32rc + 1]], ...,
+ *                H(rho||n)[[32rc + 32c - 1]])
+ *   5:     s[r] <- BitUnpack(v, GAMMA-1, GAMMA1)
+ *
+ * @param [in]  seed         Buffer containing seed to expand.
+ * @param [in]  kappa        Value to append to first seed.
+ * @param [in]  gamma1_bits  Number of bits per value.
+ * @param [out] y            Four consecutive polynomials.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Negative on hash error.
+ */
+static int dilithium_expand_mask_x4(const byte* seed, word16 kappa,
+    byte gamma1_bits, sword32* y)
+{
+    int ret = 0;
+    int i;
+    const byte* in[4];
+    byte* out[4];
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Shakex4* shake = NULL;
+    byte* v = NULL;
+    byte* sd = NULL;
+#else
+    wc_Shakex4 shake[1];
+    byte v[4 * DILITHIUM_MAX_V];
+    byte sd[4 * DILITHIUM_Y_SEED_SZ];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    shake = (wc_Shakex4*)XMALLOC(sizeof(wc_Shakex4), NULL,
+        DYNAMIC_TYPE_DILITHIUM);
+    v = (byte*)XMALLOC(4 * (DILITHIUM_MAX_V + DILITHIUM_Y_SEED_SZ), NULL,
+        DYNAMIC_TYPE_DILITHIUM);
+    if ((shake == NULL) || (v == NULL)) {
+        ret = MEMORY_E;
+    }
+    else {
+        sd = v + 4 * DILITHIUM_MAX_V;
+    }
+#endif
+
+    if (ret == 0) {
+        ret = wc_InitShake256x4(shake, NULL, INVALID_DEVID);
+    }
+    if (ret == 0) {
+        for (i = 0; i < 4; i++) {
+            /* Step 3: Calculate value to append to seed. */
+            word16 n = (word16)(kappa + i);
+
+            in[i] = sd + i * DILITHIUM_Y_SEED_SZ;
+            out[i] = v + i * DILITHIUM_MAX_V;
+            XMEMCPY(sd + i * DILITHIUM_Y_SEED_SZ, seed,
+                DILITHIUM_PRIV_RAND_SEED_SZ);
+            sd[i * DILITHIUM_Y_SEED_SZ + DILITHIUM_PRIV_RAND_SEED_SZ + 0] =
+                (byte)n;
+            sd[i * DILITHIUM_Y_SEED_SZ + DILITHIUM_PRIV_RAND_SEED_SZ + 1] =
+                (byte)(n >> 8);
+        }
+        /* Step 4: Absorb the four seeds and squeeze out data. */
+        ret = wc_Shake256x4_Absorb(shake, in, DILITHIUM_Y_SEED_SZ);
+    }
+    if (ret == 0) {
+        ret = wc_Shake256x4_SqueezeBlocks(shake, out, DILITHIUM_MAX_V_BLOCKS);
+    }
+    if (ret == 0) {
+        for (i = 0; i < 4; i++) {
+            /* Decode v into polynomial. */
+            dilithium_decode_gamma1(out[i], gamma1_bits,
+                y + i * DILITHIUM_N);
+        }
+    }
+
+    wc_Shake256x4_Free(shake);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(v, NULL, DYNAMIC_TYPE_DILITHIUM);
+    XFREE(shake, NULL, DYNAMIC_TYPE_DILITHIUM);
+#endif
+    return ret;
+}
+#endif
+
 /* Expand the private random seed into vector y.
  *
  * FIPS 204. 8.3: Algorithm 28 ExpandMask(rho, mu)
@@ -2752,11 +3111,19 @@ static int dilithium_vec_expand_mask(wc_Shake* shake256, byte* seed,
     word16 kappa, byte gamma1_bits, sword32* y, byte l)
 {
     int ret = 0;
-    byte r;
+    byte r = 0;
     byte v[DILITHIUM_MAX_V];
 
+#if defined(WC_SHAKE_X4) && !defined(WOLFSSL_DILITHIUM_SMALL)
+    /* Step 2: Create four polynomials of vector at a time. */
+    for (; (ret == 0) && (r + 4 <= l); r += 4) {
+        ret = dilithium_expand_mask_x4(seed, (word16)(kappa + r), gamma1_bits,
+            y);
+        y += 4 * DILITHIUM_N;
+    }
+#endif
     /* Step 2: For each polynomial of vector. */
-    for (r = 0; (ret == 0) && (r < l); r++) {
+    for (; (ret == 0) && (r < l); r++) {
         /* Step 3: Calculate value to append to seed. */
         word16 n = kappa + r;
 
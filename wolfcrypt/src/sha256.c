@@ -388,6 +388,15 @@ static int InitSha256(wc_Sha256* sha256)
                                                   const byte* data, word32 len);
         #endif /* HAVE_INTEL_RORX */
     #endif /* HAVE_INTEL_AVX2 */
+    #ifdef WOLFSSL_SHA256_MULTI
+        #if defined(HAVE_INTEL_AVX1)
+        extern int Transform_Sha256_AVX1_x4(word32* digest, const byte** data);
+        #endif
+        #if defined(HAVE_INTEL_AVX2)
+        extern int Transform_Sha256_AVX2_x8(word32* digest, const byte** data);
+        #endif
+        #define WC_SHA256_MULTI_X86
+    #endif /* WOLFSSL_SHA256_MULTI */
 
 #ifdef __cplusplus
     }  /* extern "C" */
@@ -2624,4 +2633,275 @@ int wc_Sha256GetFlags(wc_Sha256* sha256, word32* flags)
 #endif
 #endif /* !WOLFSSL_TI_HASH */
 
+#ifdef WOLFSSL_SHA256_MULTI
+/* Hash each message, one after the other, with a single SHA-256 object.
+ *
+ * @param [in]  data   Array of messages.
+ * @param [in]  sz     Array of message lengths in bytes.
+ * @param [out] hash   Array of buffers to hold digests.
+ * @param [in]  cnt    Number of messages.
+ * @param [in]  heap   Dynamic memory hint.
+ * @param [in]  devId  Device identifier.
+ * @return  0 on success.
+ * @return  MEMORY_E on dynamic memory allocation failure.
+ */
+static int Sha256_MultiHash_Each(const byte* const* data, const word32* sz,
+    byte* const* hash, word32 cnt, void* heap, int devId)
+{
+    int ret;
+    word32 i;
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Sha256* sha256;
+#else
+    wc_Sha256 sha256[1];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    sha256 = (wc_Sha256*)XMALLOC(sizeof(wc_Sha256), heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (sha256 == NULL)
+        return MEMORY_E;
+#endif
+
+    ret = wc_InitSha256_ex(sha256, heap, devId);
+    if (ret == 0) {
+        for (i = 0; (ret == 0) && (i < cnt); i++) {
+            ret = wc_Sha256Update(sha256, data[i], sz[i]);
+            if (ret == 0) {
+                /* Final resets the object ready for the next message. */
+                ret = wc_Sha256Final(sha256, hash[i]);
+            }
+        }
+        wc_Sha256Free(sha256);
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(sha256, heap, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+
+#ifdef WC_SHA256_MULTI_X86
+/* Maximum number of messages hashed at once. */
+#define WC_SHA256_MULTI_MAX_LANES       8
+
+/* Multi-buffer transform: one block of each lane's data. */
+typedef int (*Sha256MultiTransform)(word32* digest, const byte** data);
+
+/* Hash messages in parallel with a multi-buffer transform.
+ *
+ * Each lane works on one message at a time. Message blocks are read in place
+ * and the padded final blocks are built in a per lane buffer. When a lane's
+ * message is done, its digest is output and the next message is started in
+ * that lane. Lanes without a message hash the first lane's padding buffer and
+ * the result is ignored.
+ *
+ * digest is stored by word: digest[w * lanes + lane].
+ *
+ * @param [in]  data       Array of messages.
+ * @param [in]  sz         Array of message lengths in bytes.
+ * @param [out] hash       Array of buffers to hold digests.
+ * @param [in]  cnt        Number of messages.
+ * @param [in]  lanes      Number of lanes of transform.
+ * @param [in]  transform  Multi-buffer transform function.
+ * @param [in]  heap       Dynamic memory hint.
+ * @return  0 on success.
+ * @return  MEMORY_E on dynamic memory allocation failure.
+ */
+static int Sha256_MultiHash_Lanes(const byte* const* data, const word32* sz,
+    byte* const* hash, word32 cnt, int lanes, Sha256MultiTransform transform,
+    void* heap)
+{
+    static const word32 sha256_iv[WC_SHA256_DIGEST_SIZE / sizeof(word32)] = {
+        0x6A09E667L, 0xBB67AE85L, 0x3C6EF372L, 0xA54FF53AL,
+        0x510E527FL, 0x9B05688CL, 0x1F83D9ABL, 0x5BE0CD19L
+    };
+    int ret = 0;
+    int l;
+    int w;
+    int active = 0;
+    word32 next = 0;
+    word32 msg[WC_SHA256_MULTI_MAX_LANES];
+    word32 full[WC_SHA256_MULTI_MAX_LANES];
+    word32 blocks[WC_SHA256_MULTI_MAX_LANES];
+    word32 pos[WC_SHA256_MULTI_MAX_LANES];
+    const byte* ptr[WC_SHA256_MULTI_MAX_LANES];
+    word32 digest[8 * WC_SHA256_MULTI_MAX_LANES];
+#ifdef WOLFSSL_SMALL_STACK
+    byte* pad;
+#else
+    byte pad[WC_SHA256_MULTI_MAX_LANES * 2 * WC_SHA256_BLOCK_SIZE];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    pad = (byte*)XMALLOC(WC_SHA256_MULTI_MAX_LANES * 2 * WC_SHA256_BLOCK_SIZE,
+        heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (pad == NULL)
+        return MEMORY_E;
+#else
+    (void)heap;
+#endif
+
+    for (l = 0; l < lanes; l++) {
+        msg[l] = cnt;
+    }
+    do {
+        /* Start the next messages in any free lanes. */
+        for (l = 0; (l < lanes) && (next < cnt); l++) {
+            byte* p;
+            word32 rem;
+            word32 padSz;
+
+            if (msg[l] != cnt)
+                continue;
+
+            msg[l] = next;
+            full[l] = sz[next] / WC_SHA256_BLOCK_SIZE;
+            rem = sz[next] % WC_SHA256_BLOCK_SIZE;
+            blocks[l] = full[l] + ((rem < WC_SHA256_PAD_SIZE) ? 1 : 2);
+            pos[l] = 0;
+
+            /* Build the final blocks: remaining data, 0x80, zeros, length. */
+            p = pad + l * 2 * WC_SHA256_BLOCK_SIZE;
+            padSz = (blocks[l] - full[l]) * WC_SHA256_BLOCK_SIZE;
+            if (rem > 0) {
+                XMEMCPY(p, data[next] + full[l] * WC_SHA256_BLOCK_SIZE, rem);
+            }
+            p[rem] = 0x80;
+            XMEMSET(p + rem + 1, 0, padSz - rem - 1);
+            /* Length in bits as a 64-bit big-endian number. */
+            p[padSz - 5] = (byte)(sz[next] >> 29);
+            p[padSz - 4] = (byte)(sz[next] >> 21);
+            p[padSz - 3] = (byte)(sz[next] >> 13);
+            p[padSz - 2] = (byte)(sz[next] >>  5);
+            p[padSz - 1] = (byte)(sz[next] <<  3);
+
+            for (w = 0; w < 8; w++) {
+                digest[w * lanes + l] = sha256_iv[w];
+            }
+            next++;
+            active++;
+        }
+        if (active == 0)
+            break;
+
+        /* Point each lane at its next block. */
+        for (l = 0; l < lanes; l++) {
+            if (msg[l] == cnt) {
+                ptr[l] = pad;
+            }
+            else if (pos[l] < full[l]) {
+                ptr[l] = data[msg[l]] + pos[l] * WC_SHA256_BLOCK_SIZE;
+            }
+            else {
+                ptr[l] = pad + (l * 2 + pos[l] - full[l]) *
+                    WC_SHA256_BLOCK_SIZE;
+            }
+        }
+
+        transform(digest, ptr);
+
+        /* Output the digest of each message that is complete. */
+        for (l = 0; l < lanes; l++) {
+            if ((msg[l] == cnt) || (++pos[l] != blocks[l]))
+                continue;
+            for (w = 0; w < 8; w++) {
+                word32 v = digest[w * lanes + l];
+                byte* h = hash[msg[l]] + w * (int)sizeof(word32);
+
+                h[0] = (byte)(v >> 24);
+                h[1] = (byte)(v >> 16);
+                h[2] = (byte)(v >>  8);
+                h[3] = (byte)(v      );
+            }
+            msg[l] = cnt;
+            active--;
+        }
+    }
+    while (1);
+
+    ForceZero(pad, (word32)lanes * 2 * WC_SHA256_BLOCK_SIZE);
+    ForceZero(digest, (word32)lanes * 8 * (word32)sizeof(word32));
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(pad, heap, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+#endif /* WC_SHA256_MULTI_X86 */
+
+/* Hash a number of independent messages.
+ *
+ * On x86_64 with AVX2 or AVX1, and without the SHA instructions, the messages
+ * are hashed in parallel, 8 or 4 at a time, in the lanes of vector registers.
+ * Otherwise, and when a device is to be used, each message is hashed in turn.
+ *
+ * @param [in]  data   Array of messages. Entry may be NULL when size is 0.
+ * @param [in]  sz     Array of message lengths in bytes.
+ * @param [out] hash   Array of buffers to hold digests. Each buffer is
+ *                     WC_SHA256_DIGEST_SIZE bytes.
+ * @param [in]  cnt    Number of messages.
+ * @param [in]  heap   Dynamic memory hint.
+ * @param [in]  devId  Device identifier.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when an array or entry is NULL.
+ * @return  MEMORY_E on dynamic memory allocation failure.
+ */
+int wc_Sha256_MultiHash(const byte* const* data, const word32* sz,
+    byte* const* hash, word32 cnt, void* heap, int devId)
+{
+    int ret = 0;
+    word32 i;
+
+    if ((cnt > 0) && ((data == NULL) || (sz == NULL) || (hash == NULL))) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < cnt; i++) {
+        if (((data[i] == NULL) && (sz[i] > 0)) || (hash[i] == NULL)) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+#ifdef WC_SHA256_MULTI_X86
+    if (intel_flags == 0)
+        intel_flags = cpuid_get_flags();
+
+    /* SHA instructions on one message are as fast as vector instructions on a
+     * number of messages. */
+    if ((devId == INVALID_DEVID) && (!IS_INTEL_SHA(intel_flags))) {
+        Sha256MultiTransform transform = NULL;
+        int lanes = 0;
+
+        /* Only worth it when at least half of the lanes are in use. */
+    #ifdef HAVE_INTEL_AVX2
+        if (IS_INTEL_AVX2(intel_flags) && (cnt >= 4)) {
+            transform = Transform_Sha256_AVX2_x8;
+            lanes = 8;
+        }
+    #endif
+    #ifdef HAVE_INTEL_AVX1
+        if ((transform == NULL) && IS_INTEL_AVX1(intel_flags) && (cnt >= 2)) {
+            transform = Transform_Sha256_AVX1_x4;
+            lanes = 4;
+        }
+    #endif
+        if (transform != NULL) {
+            SAVE_VECTOR_REGISTERS(return _svr_ret;);
+            ret = Sha256_MultiHash_Lanes(data, sz, hash, cnt, lanes, transform,
+                heap);
+            RESTORE_VECTOR_REGISTERS();
+            cnt = 0;
+        }
+    }
+#endif /* WC_SHA256_MULTI_X86 */
+
+    if ((ret == 0) && (cnt > 0)) {
+        ret = Sha256_MultiHash_Each(data, sz, hash, cnt, heap, devId);
+    }
+
+    return ret;
+}
+#endif /* WOLFSSL_SHA256_MULTI */
+
 #endif /* NO_SHA256 */
@@ -612,6 +612,54 @@ static word64 Load64BitBigEndian(const byte* a)
 #endif
 }
 
+#ifdef USE_INTEL_SPEEDUP
+/* Select the block functions to use based on the CPU features.
+ *
+ * block    Set to the single block function.
+ * block_n  Set to the multiple block function or NULL when not available.
+ */
+static void Sha3SelectBlock(void (**block)(word64 *s),
+    void (**block_n)(word64 *s, const byte* data, word32 n, word64 c))
+{
+#ifdef WC_C_DYNAMIC_FALLBACK
+    if (! CAN_SAVE_VECTOR_REGISTERS()) {
+        *block = BlockSha3;
+        *block_n = NULL;
+    }
+    else
+#endif
+    if (IS_INTEL_BMI1(cpuid_flags) && IS_INTEL_BMI2(cpuid_flags)) {
+        *block = sha3_block_bmi2;
+        *block_n = sha3_block_n_bmi2;
+    }
+    else if (IS_INTEL_AVX2(cpuid_flags)) {
+        *block = sha3_block_avx2;
+        *block_n = NULL;
+    }
+    else {
+        *block = BlockSha3;
+        *block_n = NULL;
+    }
+}
+
+/* Get the CPU features once and, when not selected per object, the block
+ * functions to use.
+ *
+ * Must be called by every initialization function before the CPU features or
+ * the block functions are used.
+ */
+static void Sha3InitCpuid(void)
+{
+    if (!cpuid_flags_set) {
+        cpuid_flags = cpuid_get_flags();
+    #ifndef WC_C_DYNAMIC_FALLBACK
+        Sha3SelectBlock(&sha3_block, &sha3_block_n);
+    #endif
+        cpuid_flags_set = 1;
+    }
+}
+#endif
+
 /* Initialize the state for a SHA3-224 hash operation.
  *
  * sha3   wc_Sha3 object holding state.
@@ -629,31 +677,10 @@ static int InitSha3(wc_Sha3* sha3)
 #endif
 
 #ifdef USE_INTEL_SPEEDUP
-    if (!cpuid_flags_set) {
-        cpuid_flags = cpuid_get_flags();
-        cpuid_flags_set = 1;
+    Sha3InitCpuid();
 #ifdef WC_C_DYNAMIC_FALLBACK
-    }
-    {
-        if (! CAN_SAVE_VECTOR_REGISTERS()) {
-            SHA3_BLOCK = BlockSha3;
-            SHA3_BLOCK_N = NULL;
-        }
-        else
+    Sha3SelectBlock(&SHA3_BLOCK, &SHA3_BLOCK_N);
 #endif
-        if (IS_INTEL_BMI1(cpuid_flags) && IS_INTEL_BMI2(cpuid_flags)) {
-            SHA3_BLOCK = sha3_block_bmi2;
-            SHA3_BLOCK_N = sha3_block_n_bmi2;
-        }
-        else if (IS_INTEL_AVX2(cpuid_flags)) {
-            SHA3_BLOCK = sha3_block_avx2;
-            SHA3_BLOCK_N = NULL;
-        }
-        else {
-            SHA3_BLOCK = BlockSha3;
-            SHA3_BLOCK_N = NULL;
-        }
-    }
 #endif
 
     return 0;
@@ -1319,6 +1346,160 @@ int wc_Sha3_GetFlags(wc_Sha3* sha3, word32* flags)
 }
 #endif
 
+#ifdef WC_SHAKE_X4
+/* The block operation performed on the four interleaved states.
+ *
+ * s  The four states: s[word * 4 + operation].
+ */
+static void Sha3x4Block(word64* s)
+{
+    word64 t[25];
+    int i;
+    int j;
+#ifdef USE_INTEL_SPEEDUP
+    void (*block)(word64 *s) = BlockSha3;
+
+    if (IS_INTEL_AVX2(cpuid_flags) && (SAVE_VECTOR_REGISTERS2() == 0)) {
+        kyber_sha3_blocksx4_avx2(s);
+        RESTORE_VECTOR_REGISTERS();
+        return;
+    }
+    if (IS_INTEL_BMI1(cpuid_flags) && IS_INTEL_BMI2(cpuid_flags)) {
+        block = sha3_block_bmi2;
+    }
+#endif
+
+    /* Process each state in turn. */
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < 25; j++) {
+            t[j] = s[j * 4 + i];
+        }
+    #ifdef USE_INTEL_SPEEDUP
+        (*block)(t);
+    #else
+        BlockSha3(t);
+    #endif
+        for (j = 0; j < 25; j++) {
+            s[j * 4 + i] = t[j];
+        }
+    }
+    ForceZero(t, sizeof(t));
+}
+
+/* Initialize the state for four SHAKE operations.
+ *
+ * shake  wc_Shakex4 object holding state.
+ * heap   Heap reference for dynamic memory allocation.
+ * returns 0 on success.
+ * returns BAD_FUNC_ARG when shake is NULL.
+ */
+static int InitShakex4(wc_Shakex4* shake, void* heap)
+{
+    if (shake == NULL)
+        return BAD_FUNC_ARG;
+
+    XMEMSET(shake->s, 0, sizeof(shake->s));
+    shake->heap = heap;
+#ifdef USE_INTEL_SPEEDUP
+    Sha3InitCpuid();
+#endif
+
+    return 0;
+}
+
+/* Absorb the same length of data into each of the four SHAKE operations.
+ *
+ * Update and final with data but no output.
+ *
+ * shake  wc_Shakex4 object holding state.
+ * data   Four buffers of data to absorb.
+ * len    Length of each buffer of data in bytes.
+ * p      Number of 64-bit numbers in a block of data to process.
+ * returns 0 on success.
+ * returns BAD_FUNC_ARG when shake, data or an entry of data is NULL.
+ */
+static int Shakex4Absorb(wc_Shakex4* shake, const byte* const* data,
+    word32 len, byte p)
+{
+    word32 rate = (word32)p * 8;
+    word32 o = 0;
+    byte t[WC_SHA3_128_COUNT * 8];
+    int i;
+    int j;
+
+    if ((shake == NULL) || (data == NULL))
+        return BAD_FUNC_ARG;
+    for (i = 0; i < 4; i++) {
+        if ((data[i] == NULL) && (len > 0))
+            return BAD_FUNC_ARG;
+    }
+
+    /* Full blocks of data. */
+    for (; len - o >= rate; o += rate) {
+        for (i = 0; i < 4; i++) {
+            for (j = 0; j < p; j++) {
+                shake->s[j * 4 + i] ^= Load64BitBigEndian(data[i] + o + 8 * j);
+            }
+        }
+        Sha3x4Block(shake->s);
+    }
+    /* Last partial block of data with padding. */
+    for (i = 0; i < 4; i++) {
+        if (len - o > 0) {
+            XMEMCPY(t, data[i] + o, len - o);
+        }
+        t[len - o] = 0x1f;
+        XMEMSET(t + len - o + 1, 0, rate - (len - o) - 1);
+        t[rate - 1] |= 0x80;
+        for (j = 0; j < p; j++) {
+            shake->s[j * 4 + i] ^= Load64BitBigEndian(t + 8 * j);
+        }
+    }
+    ForceZero(t, sizeof(t));
+
+    return 0;
+}
+
+/* Squeeze the four states to produce pseudo-random output.
+ *
+ * shake     wc_Shakex4 object holding state.
+ * out       Four output buffers.
+ * blockCnt  Number of blocks to write to each output buffer.
+ * p         Number of 64-bit numbers in a block of data to process.
+ * returns 0 on success.
+ * returns BAD_FUNC_ARG when shake, out or an entry of out is NULL.
+ */
+static int Shakex4SqueezeBlocks(wc_Shakex4* shake, byte* const* out,
+    word32 blockCnt, byte p)
+{
+    word32 o;
+    int i;
+    int j;
+
+    if ((shake == NULL) || (out == NULL))
+        return BAD_FUNC_ARG;
+    for (i = 0; i < 4; i++) {
+        if ((out[i] == NULL) && (blockCnt > 0))
+            return BAD_FUNC_ARG;
+    }
+
+    for (o = 0; blockCnt > 0; blockCnt--, o += (word32)p * 8) {
+        Sha3x4Block(shake->s);
+        for (i = 0; i < 4; i++) {
+            for (j = 0; j < p; j++) {
+                word64 w = shake->s[j * 4 + i];
+            #if defined(BIG_ENDIAN_ORDER)
+                w = ByteReverseWord64(w);
+            #endif
+                XMEMCPY(out[i] + o + 8 * j, &w, sizeof(w));
+            }
+        }
+    }
+
+    return 0;
+}
+#endif /* WC_SHAKE_X4 */
+
 #ifdef WOLFSSL_SHAKE128
 /* Initialize the state for a Shake128 hash operation.
  *
@@ -1461,6 +1642,61 @@ int wc_Shake128_Copy(wc_Shake* src, wc_Shake* dst)
 {
     return wc_Sha3Copy(src, dst);
 }
+
+#ifdef WC_SHAKE_X4
+/* Initialize the state for four Shake128 hash operations.
+ *
+ * shake  wc_Shakex4 object holding state.
+ * heap   Heap reference for dynamic memory allocation.
+ * devId  Device identifier. Not used.
+ * returns 0 on success.
+ */
+int wc_InitShake128x4(wc_Shakex4* shake, void* heap, int devId)
+{
+    (void)devId;
+
+    return InitShakex4(shake, heap);
+}
+
+/* Absorb the same length of data into each of the four SHAKE128 operations.
+ *
+ * Update and final with data but no output and no reset.
+ *
+ * shake  wc_Shakex4 object holding state.
+ * data   Four buffers of data to absorb.
+ * len    Length of each buffer of data in bytes.
+ * returns 0 on success.
+ */
+int wc_Shake128x4_Absorb(wc_Shakex4* shake, const byte* const* data,
+    word32 len)
+{
+    return Shakex4Absorb(shake, data, len, WC_SHA3_128_COUNT);
+}
+
+/* Squeeze the four SHAKE128 states to produce pseudo-random output.
+ *
+ * shake     wc_Shakex4 object holding state.
+ * out       Four output buffers.
+ * blockCnt  Number of blocks to write to each output buffer.
+ * returns 0 on success.
+ */
+int wc_Shake128x4_SqueezeBlocks(wc_Shakex4* shake, byte* const* out,
+    word32 blockCnt)
+{
+    return Shakex4SqueezeBlocks(shake, out, blockCnt, WC_SHA3_128_COUNT);
+}
+
+/* Dispose of the state of the four SHAKE128 operations.
+ *
+ * shake  wc_Shakex4 object holding state.
+ */
+void wc_Shake128x4_Free(wc_Shakex4* shake)
+{
+    if (shake != NULL) {
+        ForceZero(shake->s, sizeof(shake->s));
+    }
+}
+#endif /* WC_SHAKE_X4 */
 #endif
 
 #ifdef WOLFSSL_SHAKE256
@@ -1599,6 +1835,61 @@ int wc_Shake256_Copy(wc_Shake* src, wc_Shake* dst)
 {
     return wc_Sha3Copy(src, dst);
 }
+
+#ifdef WC_SHAKE_X4
+/* Initialize the state for four Shake256 hash operations.
+ *
+ * shake  wc_Shakex4 object holding state.
+ * heap   Heap reference for dynamic memory allocation.
+ * devId  Device identifier. Not used.
+ * returns 0 on success.
+ */
+int wc_InitShake256x4(wc_Shakex4* shake, void* heap, int devId)
+{
+    (void)devId;
+
+    return InitShakex4(shake, heap);
+}
+
+/* Absorb the same length of data into each of the four SHAKE256 operations.
+ *
+ * Update and final with data but no output and no reset.
+ *
+ * shake  wc_Shakex4 object holding state.
+ * data   Four buffers of data to absorb.
+ * len    Length of each buffer of data in bytes.
+ * returns 0 on success.
+ */
+int wc_Shake256x4_Absorb(wc_Shakex4* shake, const byte* const* data,
+    word32 len)
+{
+    return Shakex4Absorb(shake, data, len, WC_SHA3_256_COUNT);
+}
+
+/* Squeeze the four SHAKE256 states to produce pseudo-random output.
+ *
+ * shake     wc_Shakex4 object holding state.
+ * out       Four output buffers.
+ * blockCnt  Number of blocks to write to each output buffer.
+ * returns 0 on success.
+ */
+int wc_Shake256x4_SqueezeBlocks(wc_Shakex4* shake, byte* const* out,
+    word32 blockCnt)
+{
+    return Shakex4SqueezeBlocks(shake, out, blockCnt, WC_SHA3_256_COUNT);
+}
+
+/* Dispose of the state of the four SHAKE256 operations.
+ *
+ * shake  wc_Shakex4 object holding state.
+ */
+void wc_Shake256x4_Free(wc_Shakex4* shake)
+{
+    if (shake != NULL) {
+        ForceZero(shake->s, sizeof(shake->s));
+    }
+}
+#endif /* WC_SHAKE_X4 */
 #endif
 
 #endif /* WOLFSSL_SHA3 */
@@ -35,6 +35,9 @@
  * WOLFSSL_WC_LMS_SMALL                                  Default: OFF
  *   Implementation is smaller code size with slow signing.
  *   Enable when memory is limited.
+ * WOLFSSL_SHA256_MULTI                                  Default: OFF
+ *   Computes LM-OTS hash chains in parallel with multi-buffer SHA-256.
+ *   Used on x86_64 when the CPU has AVX but not the SHA instructions.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -53,6 +56,14 @@
 
 #if defined(WOLFSSL_HAVE_LMS) && defined(WOLFSSL_WC_LMS)
 
+#if defined(WOLFSSL_SHA256_MULTI) && defined(WOLFSSL_X86_64_BUILD) && \
+    defined(USE_INTEL_SPEEDUP)
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+    /* Compute LM-OTS hash chains in parallel when it is faster. */
+    #define WC_LMS_MULTI
+#endif
+
 /* Length of R in bytes. */
 #define LMS_R_LEN           4
 /* Length of D in bytes. */
@@ -404,6 +415,280 @@ static WC_INLINE int wc_lms_hash_final(wc_Sha256* sha256, byte* hash)
 #endif
 }
 
+#ifdef WC_LMS_MULTI
+/* Determine whether to compute LM-OTS hash chains in parallel.
+ *
+ * SHA instructions hashing one chain at a time are as fast as the vector
+ * instructions hashing a number of chains.
+ *
+ * @return  1 when chains are to be hashed in parallel.
+ * @return  0 otherwise.
+ */
+static int wc_lms_multi_use(void)
+{
+    word32 flags = cpuid_get_flags();
+
+    return (!IS_INTEL_SHA(flags)) && IS_INTEL_AVX1(flags);
+}
+
+/* Offset of j in the data to hash of a chain. */
+#define LMS_MULTI_J_OFF     LMS_K_PRE_LEN
+/* Offset of tmp in the data to hash of a chain. */
+#define LMS_MULTI_TMP_OFF   (LMS_K_PRE_LEN + LMS_W_LEN)
+
+/* Set up the data to hash for a number of LM-OTS hash chains.
+ *
+ * Caller set: state->buffer = I || u32str(q)
+ *
+ * Chain k: I || u32str(q) || u16str(i + k) || u8str(j) || tmp
+ *
+ * @param [in, out] state   LMS state.
+ * @param [in]      i       Index of first chain.
+ * @param [in]      n       Number of chains.
+ * @param [in]      tmp     Initial value of tmp for first chain.
+ * @param [in]      tmpInc  Offset to initial value of tmp for next chain.
+ */
+static void wc_lmots_multi_init(LmsState* state, word16 i, int n,
+    const byte* tmp, word32 tmpInc)
+{
+    int k;
+
+    for (k = 0; k < n; k++) {
+        byte* buffer = state->multi[k];
+
+        XMEMCPY(buffer, state->buffer, LMS_I_LEN + LMS_Q_LEN);
+        c16toa((word16)(i + k), buffer + LMS_I_LEN + LMS_Q_LEN);
+        XMEMCPY(buffer + LMS_MULTI_TMP_OFF, tmp, LMS_MAX_NODE_LEN);
+        tmp += tmpInc;
+    }
+}
+
+/* Hash the data of a number of chains in parallel.
+ *
+ * For each chain:
+ *   tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp)
+ *
+ * @param [in, out] state   LMS state.
+ * @param [in, out] buffer  Data to hash of chains.
+ * @param [in]      cnt     Number of chains.
+ * @return  0 on success.
+ */
+static int wc_lmots_multi_hash(LmsState* state, byte** buffer, int cnt)
+{
+    word32 len[LMS_MULTI_CHAINS];
+    byte* hash[LMS_MULTI_CHAINS];
+    int devId = INVALID_DEVID;
+    int k;
+
+    for (k = 0; k < cnt; k++) {
+        len[k] = LMS_HASH_BUFFER_LEN;
+        hash[k] = buffer[k] + LMS_MULTI_TMP_OFF;
+    }
+#ifdef WOLF_CRYPTO_CB
+    devId = state->hash.devId;
+#else
+    (void)state;
+#endif
+
+    return wc_Sha256_MultiHash((const byte* const*)buffer, len, hash,
+        (word32)cnt, NULL, devId);
+}
+
+/* Iterate a number of hash chains in parallel.
+ *
+ * Chain k is hashed for j from start[k] up to, but not including, end[k]:
+ *   tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp)
+ *
+ * @param [in, out] state  LMS state.
+ * @param [in]      n      Number of chains.
+ * @param [in]      start  First j value of each chain.
+ * @param [in]      end    Last j value plus one of each chain.
+ * @return  0 on success.
+ */
+static int wc_lmots_multi_chains(LmsState* state, int n, const byte* start,
+    const byte* end)
+{
+    int ret = 0;
+    byte* buffer[LMS_MULTI_CHAINS];
+    unsigned int lo = start[0];
+    unsigned int hi = end[0];
+    unsigned int j;
+    int k;
+
+    for (k = 1; k < n; k++) {
+        if (start[k] < lo)
+            lo = start[k];
+        if (end[k] > hi)
+            hi = end[k];
+    }
+
+    for (j = lo; (ret == 0) && (j < hi); j++) {
+        int cnt = 0;
+
+        /* Only the chains that still have iterations at j. */
+        for (k = 0; k < n; k++) {
+            if ((start[k] <= j) && (j < end[k])) {
+                state->multi[k][LMS_MULTI_J_OFF] = (byte)j;
+                buffer[cnt++] = state->multi[k];
+            }
+        }
+        if (cnt > 0) {
+            ret = wc_lmots_multi_hash(state, buffer, cnt);
+        }
+    }
+
+    return ret;
+}
+#ifndef WOLFSSL_LMS_VERIFY_ONLY
+/* Calculate x for a number of chains in parallel.
+ *
+ * Appendix A, The elements of the LM-OTS private keys are computed as:
+ *   x_q[i] = H(I || u32str(q) || u16str(i) || u8str(0xff) || SEED).
+ *
+ * @param [in, out] state  LMS state.
+ * @param [in]      n      Number of chains.
+ * @return  0 on success.
+ */
+static int wc_lmots_multi_x(LmsState* state, int n)
+{
+    byte* buffer[LMS_MULTI_CHAINS];
+    int k;
+
+    for (k = 0; k < n; k++) {
+        state->multi[k][LMS_MULTI_J_OFF] = LMS_D_FIXED;
+        buffer[k] = state->multi[k];
+    }
+
+    return wc_lmots_multi_hash(state, buffer, n);
+}
+
+/* Compute array y for a number of coefficients at a time.
+ *
+ * @param [in, out] state  LMS state.
+ * @param [in]      seed   Seed to hash.
+ * @param [in]      a      Coefficients.
+ * @param [out]     y      Calculated intermediate hashes.
+ * @return  0 on success.
+ */
+static int wc_lmots_multi_y(LmsState* state, const byte* seed, const byte* a,
+    byte* y)
+{
+    const LmsParams* params = state->params;
+    int ret = 0;
+    word16 i;
+
+    for (i = 0; (ret == 0) && (i < params->p); i += LMS_MULTI_CHAINS) {
+        byte start[LMS_MULTI_CHAINS];
+        int n = params->p - i;
+        int k;
+
+        if (n > LMS_MULTI_CHAINS)
+            n = LMS_MULTI_CHAINS;
+
+        /* tmp = x[i]
+         *     = H(I || u32str(q) || u16str(i) || u8str(0xff) || SEED). */
+        wc_lmots_multi_init(state, i, n, seed, 0);
+        ret = wc_lmots_multi_x(state, n);
+        if (ret == 0) {
+            /* Apply the hash function coefficient number of times. */
+            XMEMSET(start, 0, sizeof(start));
+            ret = wc_lmots_multi_chains(state, n, start, a + i);
+        }
+        for (k = 0; (ret == 0) && (k < n); k++) {
+            /* y[i] = tmp */
+            XMEMCPY(y, state->multi[k] + LMS_MULTI_TMP_OFF, LMS_MAX_NODE_LEN);
+            y += LMS_MAX_NODE_LEN;
+        }
+    }
+
+    return ret;
+}
+
+/* Compute and hash array y, for the public key, for a number of coefficients
+ * at a time.
+ *
+ * @param [in, out] state  LMS state.
+ * @param [in]      seed   Seed to hash.
+ * @param [in]      max    Number of iterations of hash chain.
+ * @return  0 on success.
+ */
+static int wc_lmots_multi_k(LmsState* state, const byte* seed, byte max)
+{
+    const LmsParams* params = state->params;
+    int ret = 0;
+    word16 i;
+
+    for (i = 0; (ret == 0) && (i < params->p); i += LMS_MULTI_CHAINS) {
+        byte start[LMS_MULTI_CHAINS];
+        byte end[LMS_MULTI_CHAINS];
+        int n = params->p - i;
+        int k;
+
+        if (n > LMS_MULTI_CHAINS)
+            n = LMS_MULTI_CHAINS;
+
+        /* tmp = x[i]
+         *     = H(I || u32str(q) || u16str(i) || u8str(0xff) || SEED). */
+        wc_lmots_multi_init(state, i, n, seed, 0);
+        ret = wc_lmots_multi_x(state, n);
+        if (ret == 0) {
+            /* Do all iterations to calculate y. */
+            XMEMSET(start, 0, sizeof(start));
+            XMEMSET(end, max, sizeof(end));
+            ret = wc_lmots_multi_chains(state, n, start, end);
+        }
+        for (k = 0; (ret == 0) && (k < n); k++) {
+            /* K = H(... || y[i] || ...) */
+            ret = wc_lms_hash_update(&state->hash_k,
+                state->multi[k] + LMS_MULTI_TMP_OFF, LMS_MAX_NODE_LEN);
+        }
+    }
+
+    return ret;
+}
+#endif /* !WOLFSSL_LMS_VERIFY_ONLY */
+
+/* Compute and hash array z, for Kc, for a number of coefficients at a time.
+ *
+ * @param [in, out] state  LMS state.
+ * @param [in]      sig_y  Part of signature containing array y.
+ * @param [in]      a      Coefficients.
+ * @param [in]      max    Number of iterations of hash chain.
+ * @return  0 on success.
+ */
+static int wc_lmots_multi_z(LmsState* state, const byte* sig_y, const byte* a,
+    byte max)
+{
+    const LmsParams* params = state->params;
+    int ret = 0;
+    word16 i;
+
+    for (i = 0; (ret == 0) && (i < params->p); i += LMS_MULTI_CHAINS) {
+        byte end[LMS_MULTI_CHAINS];
+        int n = params->p - i;
+        int k;
+
+        if (n > LMS_MULTI_CHAINS)
+            n = LMS_MULTI_CHAINS;
+
+        /* tmp = y[i]. */
+        wc_lmots_multi_init(state, i, n, sig_y, LMS_MAX_NODE_LEN);
+        sig_y += n * LMS_MAX_NODE_LEN;
+
+        /* Finish iterations of hash from coefficient to max. */
+        XMEMSET(end, max, sizeof(end));
+        ret = wc_lmots_multi_chains(state, n, a + i, end);
+        for (k = 0; (ret == 0) && (k < n); k++) {
+            /* H(... || z[i] || ...) (for calculating Kc). */
+            ret = wc_lms_hash_update(&state->hash_k,
+                state->multi[k] + LMS_MULTI_TMP_OFF, LMS_MAX_NODE_LEN);
+        }
+    }
+
+    return ret;
+}
+#endif /* WC_LMS_MULTI */
+
 /***************************************
  * LM-OTS APIs
  **************************************/
@@ -687,44 +972,54 @@ static int wc_lmots_compute_y_from_seed(LmsState* state, const byte* seed,
         ret = wc_lmots_q_expand(q, LMS_MAX_NODE_LEN, params->width, params->ls,
              a);
     }
-    #ifndef WC_LMS_FULL_HASH
-    if (ret == 0) {
-        /* Put in padding for final block. */
-        LMS_SHA256_SET_LEN_55(buffer);
+#ifdef WC_LMS_MULTI
+    if ((ret == 0) && wc_lms_multi_use()) {
+        /* Compute y for a number of coefficients at a time. */
+        ret = wc_lmots_multi_y(state, seed, a, y);
     }
-    #endif /* !WC_LMS_FULL_HASH */
-
-    /* Compute y for each coefficient. */
-    for (i = 0; (ret == 0) && (i < params->p); i++) {
-        unsigned int j;
+    else
+#endif /* WC_LMS_MULTI */
+    {
+        #ifndef WC_LMS_FULL_HASH
+        if (ret == 0) {
+            /* Put in padding for final block. */
+            LMS_SHA256_SET_LEN_55(buffer);
+        }
+        #endif /* !WC_LMS_FULL_HASH */
 
-        /* tmp = x[i]
-         *     = H(I || u32str(q) || u16str(i) || u8str(0xff) || SEED). */
-        c16toa(i, ip);
-        *jp = LMS_D_FIXED;
-        XMEMCPY(tmp, seed, LMS_SEED_LEN);
-    #ifndef WC_LMS_FULL_HASH
-        ret = wc_lms_hash_block(&state->hash, buffer, tmp);
-    #else
-        ret = wc_lms_hash(&state->hash, buffer, LMS_HASH_BUFFER_LEN, tmp);
-    #endif /* !WC_LMS_FULL_HASH */
+        /* Compute y for each coefficient. */
+        for (i = 0; (ret == 0) && (i < params->p); i++) {
+            unsigned int j;
 
-        /* Apply the hash function coefficient number of times. */
-        for (j = 0; (ret == 0) && (j < a[i]); j++) {
-            /* I || u32str(q) || u16str(i) || u8str(j) || tmp */
-            *jp = j;
-            /* tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp) */
+            /* tmp = x[i]
+             *     = H(I || u32str(q) || u16str(i) || u8str(0xff) || SEED). */
+            c16toa(i, ip);
+            *jp = LMS_D_FIXED;
+            XMEMCPY(tmp, seed, LMS_SEED_LEN);
         #ifndef WC_LMS_FULL_HASH
             ret = wc_lms_hash_block(&state->hash, buffer, tmp);
         #else
             ret = wc_lms_hash(&state->hash, buffer, LMS_HASH_BUFFER_LEN, tmp);
         #endif /* !WC_LMS_FULL_HASH */
-        }
 
-        if (ret == 0) {
-            /* y[i] = tmp */
-            XMEMCPY(y, tmp, LMS_MAX_NODE_LEN);
-            y += LMS_MAX_NODE_LEN;
+            /* Apply the hash function coefficient number of times. */
+            for (j = 0; (ret == 0) && (j < a[i]); j++) {
+                /* I || u32str(q) || u16str(i) || u8str(j) || tmp */
+                *jp = j;
+                /* tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp) */
+            #ifndef WC_LMS_FULL_HASH
+                ret = wc_lms_hash_block(&state->hash, buffer, tmp);
+            #else
+                ret = wc_lms_hash(&state->hash, buffer, LMS_HASH_BUFFER_LEN,
+                    tmp);
+            #endif /* !WC_LMS_FULL_HASH */
+            }
+
+            if (ret == 0) {
+                /* y[i] = tmp */
+                XMEMCPY(y, tmp, LMS_MAX_NODE_LEN);
+                y += LMS_MAX_NODE_LEN;
+            }
         }
     }
 
@@ -792,40 +1087,51 @@ static int wc_lmots_compute_kc_from_sig(LmsState* state, const byte* msg,
         ret = wc_lmots_q_expand(q, LMS_MAX_NODE_LEN, params->width, params->ls,
             a);
     }
-    #ifndef WC_LMS_FULL_HASH
-    if (ret == 0) {
-        /* Put in padding for final block. */
-        LMS_SHA256_SET_LEN_55(buffer);
+#ifdef WC_LMS_MULTI
+    if ((ret == 0) && wc_lms_multi_use()) {
+        /* Compute z for a number of coefficients at a time. */
+        ret = wc_lmots_multi_z(state, sig_y, a, (byte)max);
     }
-    #endif /* !WC_LMS_FULL_HASH */
-
-    /* Compute z for each coefficient. */
-    for (i = 0; (ret == 0) && (i < params->p); i++) {
-        unsigned int j;
-
-        /* I || u32(str) || u16str(i) || ... */
-        c16toa(i, ip);
-
-        /* tmp = y[i].
-         * I || u32(str) || u16str(i) || ... || tmp */
-        XMEMCPY(tmp, sig_y, LMS_MAX_NODE_LEN);
-        sig_y += LMS_MAX_NODE_LEN;
-
-        /* Finish iterations of hash from coefficient to max. */
-        for (j = a[i]; (ret == 0) && (j < max); j++) {
-            /* I || u32str(q) || u16str(i) || u8str(j) || tmp */
-            *jp = (word8)j;
-            /* tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp) */
+    else
+#endif /* WC_LMS_MULTI */
+    {
         #ifndef WC_LMS_FULL_HASH
-            ret = wc_lms_hash_block(&state->hash, buffer, tmp);
-        #else
-            ret = wc_lms_hash(&state->hash, buffer, LMS_HASH_BUFFER_LEN, tmp);
-        #endif /* !WC_LMS_FULL_HASH */
+        if (ret == 0) {
+            /* Put in padding for final block. */
+            LMS_SHA256_SET_LEN_55(buffer);
         }
+        #endif /* !WC_LMS_FULL_HASH */
 
-        if (ret == 0) {
-            /* H(... || z[i] || ...) (for calculating Kc). */
-            ret = wc_lms_hash_update(&state->hash_k, tmp, LMS_MAX_NODE_LEN);
+        /* Compute z for each coefficient. */
+        for (i = 0; (ret == 0) && (i < params->p); i++) {
+            unsigned int j;
+
+            /* I || u32(str) || u16str(i) || ... */
+            c16toa(i, ip);
+
+            /* tmp = y[i].
+             * I || u32(str) || u16str(i) || ... || tmp */
+            XMEMCPY(tmp, sig_y, LMS_MAX_NODE_LEN);
+            sig_y += LMS_MAX_NODE_LEN;
+
+            /* Finish iterations of hash from coefficient to max. */
+            for (j = a[i]; (ret == 0) && (j < max); j++) {
+                /* I || u32str(q) || u16str(i) || u8str(j) || tmp */
+                *jp = (word8)j;
+                /* tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp) */
+            #ifndef WC_LMS_FULL_HASH
+                ret = wc_lms_hash_block(&state->hash, buffer, tmp);
+            #else
+                ret = wc_lms_hash(&state->hash, buffer, LMS_HASH_BUFFER_LEN,
+                    tmp);
+            #endif /* !WC_LMS_FULL_HASH */
+            }
+
+            if (ret == 0) {
+                /* H(... || z[i] || ...) (for calculating Kc). */
+                ret = wc_lms_hash_update(&state->hash_k, tmp,
+                    LMS_MAX_NODE_LEN);
+            }
         }
     }
 
@@ -878,38 +1184,49 @@ static int wc_lmots_make_public_hash(LmsState* state, const byte* seed, byte* k)
     /* K = H(I || u32str(q) || u16str(D_PBLC) || ...) */
     ret = wc_lms_hash_first(&state->hash_k, buffer, LMS_K_PRE_LEN);
 
+#ifdef WC_LMS_MULTI
+    if ((ret == 0) && wc_lms_multi_use()) {
+        /* Compute y for a number of coefficients at a time. */
+        ret = wc_lmots_multi_k(state, seed, (byte)max);
+    }
+    else
+#endif /* WC_LMS_MULTI */
+    {
 #ifndef WC_LMS_FULL_HASH
-    /* Put in padding for final block. */
-    LMS_SHA256_SET_LEN_55(buffer);
+        /* Put in padding for final block. */
+        LMS_SHA256_SET_LEN_55(buffer);
 #endif /* !WC_LMS_FULL_HASH */
 
-    for (i = 0; (ret == 0) && (i < params->p); i++) {
-        unsigned int j;
+        for (i = 0; (ret == 0) && (i < params->p); i++) {
+            unsigned int j;
 
-        /* tmp = x[i]
-         *     = H(I || u32str(q) || u16str(i) || u8str(0xff) || SEED). */
-        c16toa(i, ip);
-        *jp = LMS_D_FIXED;
-        XMEMCPY(tmp, seed, LMS_SEED_LEN);
-    #ifndef WC_LMS_FULL_HASH
-        ret = wc_lms_hash_block(&state->hash, buffer, tmp);
-    #else
-        ret = wc_lms_hash(&state->hash, buffer, LMS_HASH_BUFFER_LEN, tmp);
-    #endif /* !WC_LMS_FULL_HASH */
-        /* Do all iterations to calculate y. */
-        for (j = 0; (ret == 0) && (j < max); j++) {
-            /* I || u32str(q) || u16str(i) || u8str(j) || tmp */
-            *jp = (word8)j;
-            /* tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp) */
+            /* tmp = x[i]
+             *     = H(I || u32str(q) || u16str(i) || u8str(0xff) || SEED). */
+            c16toa(i, ip);
+            *jp = LMS_D_FIXED;
+            XMEMCPY(tmp, seed, LMS_SEED_LEN);
         #ifndef WC_LMS_FULL_HASH
             ret = wc_lms_hash_block(&state->hash, buffer, tmp);
         #else
             ret = wc_lms_hash(&state->hash, buffer, LMS_HASH_BUFFER_LEN, tmp);
         #endif /* !WC_LMS_FULL_HASH */
-        }
-        if (ret == 0) {
-            /* K = H(... || y[i] || ...) */
-            ret = wc_lms_hash_update(&state->hash_k, tmp, LMS_MAX_NODE_LEN);
+            /* Do all iterations to calculate y. */
+            for (j = 0; (ret == 0) && (j < max); j++) {
+                /* I || u32str(q) || u16str(i) || u8str(j) || tmp */
+                *jp = (word8)j;
+                /* tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp) */
+            #ifndef WC_LMS_FULL_HASH
+                ret = wc_lms_hash_block(&state->hash, buffer, tmp);
+            #else
+                ret = wc_lms_hash(&state->hash, buffer, LMS_HASH_BUFFER_LEN,
+                    tmp);
+            #endif /* !WC_LMS_FULL_HASH */
+            }
+            if (ret == 0) {
+                /* K = H(... || y[i] || ...) */
+                ret = wc_lms_hash_update(&state->hash_k, tmp,
+                    LMS_MAX_NODE_LEN);
+            }
         }
     }
     if (ret == 0) {
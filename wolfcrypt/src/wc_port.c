@@ -1259,6 +1259,22 @@ int wolfSSL_Atomic_Int_FetchSub(wolfSSL_Atomic_Int* c, int i)
 }
 #endif /* __cplusplus */
 
+/* Pointers are not declared atomic - use compiler built-in functions. */
+void* wolfSSL_Atomic_Ptr_Load(void* volatile* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+void wolfSSL_Atomic_Ptr_Store(void* volatile* p, void* v)
+{
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+void wolfSSL_Atomic_Fence(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
 #elif defined(_MSC_VER)
 
 /* Default C Implementation */
@@ -1277,6 +1293,24 @@ int wolfSSL_Atomic_Int_FetchSub(wolfSSL_Atomic_Int* c, int i)
     return (int)_InterlockedExchangeAdd(c, (long)-i);
 }
 
+void* wolfSSL_Atomic_Ptr_Load(void* volatile* p)
+{
+    return _InterlockedCompareExchangePointer(p, NULL, NULL);
+}
+
+void wolfSSL_Atomic_Ptr_Store(void* volatile* p, void* v)
+{
+    (void)_InterlockedExchangePointer(p, v);
+}
+
+void wolfSSL_Atomic_Fence(void)
+{
+    volatile long fence = 0;
+
+    /* Interlocked operations are full barriers. */
+    (void)_InterlockedExchange(&fence, 0);
+}
+
 #endif
 
 #endif /* WOLFSSL_ATOMIC_OPS */
@@ -1692,6 +1692,216 @@ static void wc_xmss_chain(XmssState* state, const byte* data,
     }
 }
 
+#if !defined(WOLFSSL_WC_XMSS_SMALL) && defined(WC_SHAKE_X4) && \
+    (defined(WC_XMSS_SHAKE128) || defined(WC_XMSS_SHAKE256))
+/* Chain hash four WOTS+ chains at a time when using SHAKE. */
+#define WC_XMSS_CHAIN_X4
+
+/* Number of chains hashed in parallel. */
+#define XMSS_CHAIN_X4_CNT       4
+
+/* Data for chain hashing four chains in parallel. */
+typedef struct XmssChainX4 {
+    /* Four-way SHAKE object. */
+    wc_Shakex4 shake;
+    /* PRF data of each chain: pad || SEED || ADRS. */
+    ALIGN16 byte prf_buf[XMSS_CHAIN_X4_CNT][WC_XMSS_HASH_PRF_MAX_DATA_LEN];
+    /* Chain hash data of each chain: pad || KEY || (tmp XOR BM). */
+    ALIGN16 byte buf[XMSS_CHAIN_X4_CNT][WC_XMSS_HASH_MAX_DATA_LEN];
+    /* First block of SHAKE output of each chain. */
+    ALIGN16 byte out[XMSS_CHAIN_X4_CNT][WC_SHA3_128_COUNT * 8];
+} XmssChainX4;
+
+/* Check whether the parameters use a SHAKE digest.
+ *
+ * @param [in] params  XMSS/MT parameters.
+ * @return  1 when hash is SHAKE-128 or SHAKE-256.
+ * @return  0 otherwise.
+ */
+static WC_INLINE int wc_xmss_hash_is_shake(const XmssParams* params)
+{
+    return (params->hash == WC_HASH_TYPE_SHAKE128) ||
+           (params->hash == WC_HASH_TYPE_SHAKE256);
+}
+
+/* Hash four messages of the same length in parallel.
+ *
+ * Only the first block of output is calculated - n is always less than a
+ * block.
+ *
+ * @param [in]  params  XMSS/MT parameters.
+ * @param [in]  shake   Four-way SHAKE object.
+ * @param [in]  in      Four buffers of data to digest.
+ * @param [in]  inlen   Length of each buffer of data in bytes.
+ * @param [out] out     Four buffers to hold a block of output.
+ * @return  0 on success.
+ * @return  NOT_COMPILED_IN when hash is not a supported SHAKE digest.
+ */
+static int wc_xmss_hash_x4(const XmssParams* params, wc_Shakex4* shake,
+    const byte* const* in, word32 inlen, byte* const* out)
+{
+    int ret;
+
+#ifdef WC_XMSS_SHAKE128
+    if (params->hash == WC_HASH_TYPE_SHAKE128) {
+        ret = wc_InitShake128x4(shake, NULL, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_Shake128x4_Absorb(shake, in, inlen);
+        }
+        if (ret == 0) {
+            ret = wc_Shake128x4_SqueezeBlocks(shake, out, 1);
+        }
+        wc_Shake128x4_Free(shake);
+    }
+    else
+#endif /* WC_XMSS_SHAKE128 */
+#ifdef WC_XMSS_SHAKE256
+    if (params->hash == WC_HASH_TYPE_SHAKE256) {
+        ret = wc_InitShake256x4(shake, NULL, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_Shake256x4_Absorb(shake, in, inlen);
+        }
+        if (ret == 0) {
+            ret = wc_Shake256x4_SqueezeBlocks(shake, out, 1);
+        }
+        wc_Shake256x4_Free(shake);
+    }
+    else
+#endif /* WC_XMSS_SHAKE256 */
+    {
+        ret = NOT_COMPILED_IN;
+    }
+
+    return ret;
+}
+
+/* Chain hashing of four consecutive chains in parallel.
+ *
+ * RFC 8391: 3.1.2, Algorithm 2 - recursive.
+ * Iterative version operating on four chains with SHAKE.
+ * Each chain has its own start and number of steps. A chain that has finished
+ * keeps its value while the others continue.
+ *
+ * @param [in]  state    XMSS/MT state including digest and parameters.
+ * @param [in]  data     Initial data to hash for the four chains.
+ * @param [in]  start    Starting hash value in hash address of each chain.
+ * @param [in]  steps    Size of step of each chain.
+ * @param [in]  pk_seed  Random public seed.
+ * @param [in]  addr     Hash address as a byte array.
+ * @param [in]  chain    Chain index of first chain.
+ * @param [out] hash     Chained hashes of the four chains.
+ */
+static void wc_xmss_chain_x4(XmssState* state, const byte* data,
+    const word8* start, const word8* steps, const byte* pk_seed,
+    const byte* addr, word32 chain, byte* hash)
+{
+    const XmssParams* params = state->params;
+    const word8 n = params->n;
+    int ret = 0;
+    word8 maxSteps = 0;
+    word8 s;
+    int j;
+
+    if (hash != data) {
+        XMEMCPY(hash, data, XMSS_CHAIN_X4_CNT * n);
+    }
+    for (j = 0; j < XMSS_CHAIN_X4_CNT; j++) {
+        if (steps[j] > maxSteps) {
+            maxSteps = steps[j];
+        }
+    }
+
+    if (maxSteps > 0) {
+    #ifdef WOLFSSL_SMALL_STACK
+        XmssChainX4* x4;
+    #else
+        XmssChainX4 x4[1];
+    #endif
+        const byte* prf[XMSS_CHAIN_X4_CNT];
+        const byte* buf[XMSS_CHAIN_X4_CNT];
+        byte* out[XMSS_CHAIN_X4_CNT];
+        byte* addr_buf[XMSS_CHAIN_X4_CNT];
+
+    #ifdef WOLFSSL_SMALL_STACK
+        x4 = (XmssChainX4*)XMALLOC(sizeof(XmssChainX4), NULL,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        if (x4 == NULL) {
+            ret = MEMORY_E;
+        }
+        if (ret == 0)
+    #endif
+        {
+            /* Set data for PRF and chain hash of each chain. */
+            for (j = 0; j < XMSS_CHAIN_X4_CNT; j++) {
+                byte* pad = x4->prf_buf[j];
+                byte* seed = pad + params->pad_len;
+
+                addr_buf[j] = seed + n;
+                XMSS_PAD_ENC(XMSS_HASH_PADDING_PRF, pad, params->pad_len);
+                XMEMCPY(seed, pk_seed, n);
+                XMEMCPY(addr_buf[j], addr, WC_XMSS_ADDR_LEN);
+                addr_buf[j][XMSS_ADDR_CHAIN * 4 + 3] = (byte)(chain + j);
+                XMSS_PAD_ENC(XMSS_HASH_PADDING_F, x4->buf[j],
+                    params->pad_len);
+
+                prf[j] = x4->prf_buf[j];
+                buf[j] = x4->buf[j];
+                out[j] = x4->out[j];
+            }
+        }
+
+        /* Iterate until longest chain is done. */
+        for (s = 0; (ret == 0) && (s < maxSteps); s++) {
+            /* Calculate n-byte key - KEY. */
+            for (j = 0; j < XMSS_CHAIN_X4_CNT; j++) {
+                XMSS_ADDR_SET_BYTE(addr_buf[j], XMSS_ADDR_HASH, start[j] + s);
+                ((word32*)addr_buf[j])[XMSS_ADDR_KEY_MASK] = 0;
+            }
+            ret = wc_xmss_hash_x4(params, &x4->shake, prf,
+                XMSS_HASH_PRF_DATA_LEN(params), out);
+            if (ret == 0) {
+                for (j = 0; j < XMSS_CHAIN_X4_CNT; j++) {
+                    XMEMCPY(x4->buf[j] + params->pad_len, out[j], n);
+                    addr_buf[j][XMSS_ADDR_KEY_MASK * 4 + 3] = 1;
+                }
+                /* Calculate n-byte bit mask - BM. */
+                ret = wc_xmss_hash_x4(params, &x4->shake, prf,
+                    XMSS_HASH_PRF_DATA_LEN(params), out);
+            }
+            if (ret == 0) {
+                for (j = 0; j < XMSS_CHAIN_X4_CNT; j++) {
+                    byte* bm = x4->buf[j] + params->pad_len + n;
+
+                    XMEMCPY(bm, out[j], n);
+                    xorbuf(bm, hash + j * n, n);
+                }
+                /* Calculate the chain hashes. */
+                ret = wc_xmss_hash_x4(params, &x4->shake, buf,
+                    XMSS_CHAIN_HASH_DATA_LEN(params), out);
+            }
+            if (ret == 0) {
+                /* Only update chains that have steps remaining. */
+                for (j = 0; j < XMSS_CHAIN_X4_CNT; j++) {
+                    if (s < steps[j]) {
+                        XMEMCPY(hash + j * n, out[j], n);
+                    }
+                }
+            }
+        }
+
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(x4, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+    }
+
+    if ((ret != 0) && (state->ret == 0)) {
+        /* Store any digest failures for public APIs to return. */
+        state->ret = ret;
+    }
+}
+#endif /* !WOLFSSL_WC_XMSS_SMALL && WC_SHAKE_X4 &&
+        * (WC_XMSS_SHAKE128 || WC_XMSS_SHAKE256) */
+
 /* Convert base on message and add checksum.
  *
  * RFC 8391:, 2.6, Algorithm 1: base_w
@@ -1817,12 +2027,29 @@ static void wc_xmss_wots_gen_pk(XmssState* state, const byte* sk,
         /* Expand the private seed - getWOTS_SK */
         wc_xmss_wots_get_wots_sk(state, sk, seed, addr_buf, pk);
 
+        i = 0;
+    #ifdef WC_XMSS_CHAIN_X4
+        if (wc_xmss_hash_is_shake(params)) {
+            static const word8 start[XMSS_CHAIN_X4_CNT] = { 0, 0, 0, 0 };
+            static const word8 steps[XMSS_CHAIN_X4_CNT] = {
+                XMSS_WOTS_W - 1, XMSS_WOTS_W - 1, XMSS_WOTS_W - 1,
+                XMSS_WOTS_W - 1
+            };
+
+            /* Calculate chain hash of four chains at a time. */
+            for (; i + XMSS_CHAIN_X4_CNT <= params->wots_len;
+                    i += XMSS_CHAIN_X4_CNT) {
+                wc_xmss_chain_x4(state, pk, start, steps, seed, addr_buf, i,
+                    pk);
+                pk += XMSS_CHAIN_X4_CNT * params->n;
+            }
+        }
+    #endif /* WC_XMSS_CHAIN_X4 */
         /* Calculate chain hash. */
-        wc_xmss_chain(state, pk, 0, XMSS_WOTS_W - 1, seed, addr_buf, pk);
-        for (i = 1; i < params->wots_len; i++) {
-            pk += params->n;
+        for (; i < params->wots_len; i++) {
             addr_buf[XMSS_ADDR_CHAIN * 4 + 3] = i;
             wc_xmss_chain(state, pk, 0, XMSS_WOTS_W - 1, seed, addr_buf, pk);
+            pk += params->n;
         }
     }
 }
@@ -1887,12 +2114,25 @@ static void wc_xmss_wots_sign(XmssState* state, const byte* m,
         /* Expand the private seed - getWOTS_SK */
         wc_xmss_wots_get_wots_sk(state, sk, seed, addr_buf, sig);
 
-       /* Calculate chain hash. */
-        wc_xmss_chain(state, sig, 0, state->encMsg[0], seed, addr_buf, sig);
-        for (i = 1; i < params->wots_len; i++) {
-            sig += params->n;
+        i = 0;
+    #ifdef WC_XMSS_CHAIN_X4
+        if (wc_xmss_hash_is_shake(params)) {
+            static const word8 start[XMSS_CHAIN_X4_CNT] = { 0, 0, 0, 0 };
+
+            /* Calculate chain hash of four chains at a time. */
+            for (; i + XMSS_CHAIN_X4_CNT <= params->wots_len;
+                    i += XMSS_CHAIN_X4_CNT) {
+                wc_xmss_chain_x4(state, sig, start, state->encMsg + i, seed,
+                    addr_buf, i, sig);
+                sig += XMSS_CHAIN_X4_CNT * params->n;
+            }
+        }
+    #endif /* WC_XMSS_CHAIN_X4 */
+        /* Calculate chain hash. */
+        for (; i < params->wots_len; i++) {
             addr_buf[XMSS_ADDR_CHAIN * 4 + 3] = i;
             wc_xmss_chain(state, sig, 0, state->encMsg[i], seed, addr_buf, sig);
+            sig += params->n;
         }
     }
 }
@@ -1951,16 +2191,33 @@ static void wc_xmss_wots_pk_from_sig(XmssState* state, const byte* sig,
     else
 #endif /* !WOLFSSL_WC_XMSS_SMALL && WC_XMSS_SHA256 */
     {
+        i = 0;
+    #ifdef WC_XMSS_CHAIN_X4
+        if (wc_xmss_hash_is_shake(params)) {
+            word8 steps[XMSS_CHAIN_X4_CNT];
+            int j;
+
+            /* Calculate chain hash of four chains at a time. */
+            for (; i + XMSS_CHAIN_X4_CNT <= params->wots_len;
+                    i += XMSS_CHAIN_X4_CNT) {
+                for (j = 0; j < XMSS_CHAIN_X4_CNT; j++) {
+                    steps[j] = (word8)(XMSS_WOTS_W - 1 - state->encMsg[i + j]);
+                }
+                wc_xmss_chain_x4(state, sig, state->encMsg + i, steps, seed,
+                    addr_buf, i, pk);
+                sig += XMSS_CHAIN_X4_CNT * params->n;
+                pk += XMSS_CHAIN_X4_CNT * params->n;
+            }
+        }
+    #endif /* WC_XMSS_CHAIN_X4 */
         /* Calculate chain hash. */
-        wc_xmss_chain(state, sig, state->encMsg[0],
-            XMSS_WOTS_W - 1 - state->encMsg[0], seed, addr_buf, pk);
-        for (i = 1; i < params->wots_len; i++) {
-            sig += params->n;
-            pk += params->n;
+        for (; i < params->wots_len; i++) {
             /* Update chain. */
             addr_buf[XMSS_ADDR_CHAIN * 4 + 3] = i;
             wc_xmss_chain(state, sig, state->encMsg[i],
                 XMSS_WOTS_W - 1 - state->encMsg[i], seed, addr_buf, pk);
+            sig += params->n;
+            pk += params->n;
         }
     }
 }
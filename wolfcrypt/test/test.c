@@ -3904,6 +3904,75 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sha256_test(void)
     }
 #endif
 
+#ifdef WOLFSSL_SHA256_MULTI
+    {
+        /* More messages than lanes with one and two padding blocks. */
+        #define SHA256_MULTI_TEST_CNT   11
+        static const word32 multi_sz[SHA256_MULTI_TEST_CNT - 4] = {
+            63, 64, 65, 119, 120, 200, 255
+        };
+        byte multi_in[255];
+        const byte* multi_data[SHA256_MULTI_TEST_CNT];
+        word32 multi_len[SHA256_MULTI_TEST_CNT];
+        byte multi_hash[SHA256_MULTI_TEST_CNT][WC_SHA256_DIGEST_SIZE];
+        byte* multi_out[SHA256_MULTI_TEST_CNT];
+
+        for (i = 0; i < (int)sizeof(multi_in); i++) {
+            multi_in[i] = (byte)i;
+        }
+        for (i = 0; i < 4; i++) {
+            multi_data[i] = (const byte*)test_sha[i].input;
+            multi_len[i] = (word32)test_sha[i].inLen;
+        }
+        for (; i < SHA256_MULTI_TEST_CNT; i++) {
+            multi_data[i] = multi_in;
+            multi_len[i] = multi_sz[i - 4];
+        }
+        for (i = 0; i < SHA256_MULTI_TEST_CNT; i++) {
+            multi_out[i] = multi_hash[i];
+        }
+
+        ret = wc_Sha256_MultiHash(multi_data, multi_len, multi_out,
+            SHA256_MULTI_TEST_CNT, HEAP_HINT, devId);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit);
+        for (i = 0; i < SHA256_MULTI_TEST_CNT; i++) {
+            if (i < 4) {
+                XMEMCPY(hash, test_sha[i].output, WC_SHA256_DIGEST_SIZE);
+            }
+            else {
+                ret = wc_Sha256Update(&sha, multi_data[i], multi_len[i]);
+                if (ret == 0)
+                    ret = wc_Sha256Final(&sha, hash);
+                if (ret != 0)
+                    ERROR_OUT(WC_TEST_RET_ENC_I(i), exit);
+            }
+            if (XMEMCMP(multi_hash[i], hash, WC_SHA256_DIGEST_SIZE) != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_I(i), exit);
+        }
+
+        /* Fewer messages than lanes. */
+        XMEMSET(multi_hash, 0, sizeof(multi_hash));
+        ret = wc_Sha256_MultiHash(multi_data, multi_len, multi_out, 3,
+            HEAP_HINT, devId);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit);
+        for (i = 0; i < 3; i++) {
+            if (XMEMCMP(multi_hash[i], test_sha[i].output,
+                    WC_SHA256_DIGEST_SIZE) != 0) {
+                ERROR_OUT(WC_TEST_RET_ENC_I(i), exit);
+            }
+        }
+
+        ret = wc_Sha256_MultiHash(NULL, multi_len, multi_out, 1, HEAP_HINT,
+            devId);
+        if (ret != WC_NO_ERR_TRACE(BAD_FUNC_ARG))
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit);
+        ret = 0;
+        #undef SHA256_MULTI_TEST_CNT
+    }
+#endif
+
 exit:
 
 #if !defined(NO_LARGE_HASH_TEST) && defined(WOLFSSL_SMALL_STACK)
@@ -5011,6 +5080,69 @@ exit:
 }
 #endif /* WOLFSSL_NOSHA3_512 */
 
+#if defined(WOLFSSL_SHAKE128) && defined(WC_SHAKE_X4) && \
+    !defined(WOLFSSL_NOSHA3_256)
+/* Use the four-way SHAKE API before any single SHA-3 operation.
+ * Initialization of either must select the block functions to use.
+ */
+static wc_test_ret_t sha3_shake128_x4_first_test(void)
+{
+    static const byte empty[1] = { 0 };
+    static const byte expShake[] = {
+        0x7f, 0x9c, 0x2b, 0xa4, 0xe8, 0x8f, 0x82, 0x7d,
+        0x61, 0x60, 0x45, 0x50, 0x76, 0x05, 0x85, 0x3e,
+        0xd7, 0x3b, 0x80, 0x93, 0xf6, 0xef, 0xbc, 0x88,
+        0xeb, 0x1a, 0x6e, 0xac, 0xfa, 0x66, 0xef, 0x26
+    };
+    static const byte expSha3[WC_SHA3_256_DIGEST_SIZE] = {
+        0x3a, 0x98, 0x5d, 0xa7, 0x4f, 0xe2, 0x25, 0xb2,
+        0x04, 0x5c, 0x17, 0x2d, 0x6b, 0xd3, 0x90, 0xbd,
+        0x85, 0x5f, 0x08, 0x6e, 0x3e, 0x9d, 0x52, 0x5b,
+        0x46, 0xbf, 0xe2, 0x45, 0x11, 0x43, 0x15, 0x32
+    };
+    wc_Shakex4 shake4;
+    wc_Sha3 sha;
+    byte hash[4][WC_SHA3_128_BLOCK_SIZE];
+    byte digest[WC_SHA3_256_DIGEST_SIZE];
+    const byte* data[4];
+    byte* out[4];
+    wc_test_ret_t ret;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        data[i] = empty;
+        out[i] = hash[i];
+    }
+    ret = wc_InitShake128x4(&shake4, HEAP_HINT, devId);
+    if (ret != 0)
+        return WC_TEST_RET_ENC_EC(ret);
+    ret = wc_Shake128x4_Absorb(&shake4, data, 0);
+    if (ret == 0)
+        ret = wc_Shake128x4_SqueezeBlocks(&shake4, out, 1);
+    wc_Shake128x4_Free(&shake4);
+    if (ret != 0)
+        return WC_TEST_RET_ENC_EC(ret);
+    for (i = 0; i < 4; i++) {
+        if (XMEMCMP(hash[i], expShake, sizeof(expShake)) != 0)
+            return WC_TEST_RET_ENC_I(i);
+    }
+
+    ret = wc_InitSha3_256(&sha, HEAP_HINT, devId);
+    if (ret != 0)
+        return WC_TEST_RET_ENC_EC(ret);
+    ret = wc_Sha3_256_Update(&sha, (const byte*)"abc", 3);
+    if (ret == 0)
+        ret = wc_Sha3_256_Final(&sha, digest);
+    wc_Sha3_256_Free(&sha);
+    if (ret != 0)
+        return WC_TEST_RET_ENC_EC(ret);
+    if (XMEMCMP(digest, expSha3, sizeof(expSha3)) != 0)
+        return WC_TEST_RET_ENC_NC;
+
+    return 0;
+}
+#endif
+
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sha3_test(void)
 {
     wc_test_ret_t ret;
@@ -5018,6 +5150,12 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sha3_test(void)
     (void)ret;
     WOLFSSL_ENTER("sha3_test");
 
+#if defined(WOLFSSL_SHAKE128) && defined(WC_SHAKE_X4) && \
+    !defined(WOLFSSL_NOSHA3_256)
+    /* Must be first use of SHA-3. */
+    if ((ret = sha3_shake128_x4_first_test()) != 0)
+        return ret;
+#endif
 #ifndef WOLFSSL_NOSHA3_224
     if ((ret = sha3_224_test()) != 0)
         return ret;
@@ -5040,6 +5178,68 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sha3_test(void)
 #endif /* WOLFSSL_SHA3 */
 
 #ifdef WOLFSSL_SHAKE128
+#ifdef WC_SHAKE_X4
+/* Compare four SHAKE128 operations in parallel against each on its own. */
+static wc_test_ret_t shake128_x4_test(wc_Shake* sha, byte* large_input_buf,
+                                      size_t large_input_buf_size)
+{
+    static const word32 lens[] = { 0, 34, WC_SHA3_128_BLOCK_SIZE, 400 };
+    wc_Shakex4 shake4;
+    byte hash[4][3 * WC_SHA3_128_BLOCK_SIZE];
+    byte expHash[3 * WC_SHA3_128_BLOCK_SIZE];
+    const byte* data[4];
+    byte* out[4];
+    wc_test_ret_t ret = 0;
+    int i;
+    int j;
+
+    if (large_input_buf_size < 4 + 400)
+        return WC_TEST_RET_ENC_NC;
+
+    for (i = 0; i < (int)(sizeof(lens) / sizeof(*lens)); i++) {
+        for (j = 0; j < 4; j++) {
+            /* Different data for each operation. */
+            data[j] = large_input_buf + j;
+            out[j] = hash[j];
+        }
+
+        ret = wc_InitShake128x4(&shake4, HEAP_HINT, devId);
+        if (ret != 0)
+            return WC_TEST_RET_ENC_EC(ret);
+        ret = wc_Shake128x4_Absorb(&shake4, data, lens[i]);
+        if (ret == 0)
+            ret = wc_Shake128x4_SqueezeBlocks(&shake4, out, 2);
+        if (ret == 0) {
+            /* Squeeze more after first squeeze. */
+            for (j = 0; j < 4; j++)
+                out[j] = hash[j] + 2 * WC_SHA3_128_BLOCK_SIZE;
+            ret = wc_Shake128x4_SqueezeBlocks(&shake4, out, 1);
+        }
+        wc_Shake128x4_Free(&shake4);
+        if (ret != 0)
+            return WC_TEST_RET_ENC_EC(ret);
+
+        for (j = 0; j < 4; j++) {
+            ret = wc_InitShake128(sha, HEAP_HINT, devId);
+            if (ret == 0)
+                ret = wc_Shake128_Absorb(sha, data[j], lens[i]);
+            if (ret == 0)
+                ret = wc_Shake128_SqueezeBlocks(sha, expHash, 3);
+            if (ret != 0)
+                return WC_TEST_RET_ENC_EC(ret);
+            if (XMEMCMP(hash[j], expHash, sizeof(expHash)) != 0)
+                return WC_TEST_RET_ENC_I(i);
+        }
+    }
+
+    ret = wc_InitShake128x4(NULL, HEAP_HINT, devId);
+    if (ret != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_EC(ret);
+
+    return 0;
+}
+#endif
+
 static wc_test_ret_t shake128_absorb_test(wc_Shake* sha, byte *large_input_buf,
                                 size_t large_input_buf_size)
 {
@@ -5383,6 +5583,11 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t shake128_test(void)
 #endif /* NO_LARGE_HASH_TEST */
 
     ret = shake128_absorb_test(&sha, large_input, SHAKE128_LARGE_INPUT_BUFSIZ);
+#ifdef WC_SHAKE_X4
+    if (ret == 0) {
+        ret = shake128_x4_test(&sha, large_input, SHAKE128_LARGE_INPUT_BUFSIZ);
+    }
+#endif
 
 exit:
     wc_Shake128_Free(&sha);
@@ -5396,6 +5601,68 @@ exit:
 #endif
 
 #ifdef WOLFSSL_SHAKE256
+#ifdef WC_SHAKE_X4
+/* Compare four SHAKE256 operations in parallel against each on its own. */
+static wc_test_ret_t shake256_x4_test(wc_Shake* sha, byte* large_input_buf,
+                                      size_t large_input_buf_size)
+{
+    static const word32 lens[] = { 0, 34, WC_SHA3_256_BLOCK_SIZE, 400 };
+    wc_Shakex4 shake4;
+    byte hash[4][3 * WC_SHA3_256_BLOCK_SIZE];
+    byte expHash[3 * WC_SHA3_256_BLOCK_SIZE];
+    const byte* data[4];
+    byte* out[4];
+    wc_test_ret_t ret = 0;
+    int i;
+    int j;
+
+    if (large_input_buf_size < 4 + 400)
+        return WC_TEST_RET_ENC_NC;
+
+    for (i = 0; i < (int)(sizeof(lens) / sizeof(*lens)); i++) {
+        for (j = 0; j < 4; j++) {
+            /* Different data for each operation. */
+            data[j] = large_input_buf + j;
+            out[j] = hash[j];
+        }
+
+        ret = wc_InitShake256x4(&shake4, HEAP_HINT, devId);
+        if (ret != 0)
+            return WC_TEST_RET_ENC_EC(ret);
+        ret = wc_Shake256x4_Absorb(&shake4, data, lens[i]);
+        if (ret == 0)
+            ret = wc_Shake256x4_SqueezeBlocks(&shake4, out, 2);
+        if (ret == 0) {
+            /* Squeeze more after first squeeze. */
+            for (j = 0; j < 4; j++)
+                out[j] = hash[j] + 2 * WC_SHA3_256_BLOCK_SIZE;
+            ret = wc_Shake256x4_SqueezeBlocks(&shake4, out, 1);
+        }
+        wc_Shake256x4_Free(&shake4);
+        if (ret != 0)
+            return WC_TEST_RET_ENC_EC(ret);
+
+        for (j = 0; j < 4; j++) {
+            ret = wc_InitShake256(sha, HEAP_HINT, devId);
+            if (ret == 0)
+                ret = wc_Shake256_Absorb(sha, data[j], lens[i]);
+            if (ret == 0)
+                ret = wc_Shake256_SqueezeBlocks(sha, expHash, 3);
+            if (ret != 0)
+                return WC_TEST_RET_ENC_EC(ret);
+            if (XMEMCMP(hash[j], expHash, sizeof(expHash)) != 0)
+                return WC_TEST_RET_ENC_I(i);
+        }
+    }
+
+    ret = wc_InitShake256x4(NULL, HEAP_HINT, devId);
+    if (ret != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_EC(ret);
+
+    return 0;
+}
+#endif
+
 static wc_test_ret_t shake256_absorb_test(wc_Shake* sha, byte *large_input_buf,
                                 size_t large_input_buf_size)
 {
@@ -5722,6 +5989,11 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t shake256_test(void)
 #endif /* NO_LARGE_HASH_TEST */
 
     ret = shake256_absorb_test(&sha, large_input, SHAKE256_LARGE_INPUT_BUFSIZ);
+#ifdef WC_SHAKE_X4
+    if (ret == 0) {
+        ret = shake256_x4_test(&sha, large_input, SHAKE256_LARGE_INPUT_BUFSIZ);
+    }
+#endif
 exit:
     wc_Shake256_Free(&sha);
 
@@ -10434,6 +10706,15 @@ static wc_test_ret_t aes_xts_128_test(void)
     #else
     byte large_input[LARGE_XTS_SZ];
     #endif
+    /* Cipher text blocks at offsets 240 and 1008 of large_input with k1/i1. */
+    WOLFSSL_SMALL_STACK_STATIC const unsigned char cl1[] = {
+        0xf1, 0x1c, 0x55, 0x44, 0xde, 0xa1, 0x35, 0x2f,
+        0xd9, 0x23, 0x43, 0x5f, 0xc3, 0x56, 0x4a, 0x55
+    };
+    WOLFSSL_SMALL_STACK_STATIC const unsigned char cl2[] = {
+        0xe9, 0x3e, 0x43, 0x43, 0xbc, 0xe8, 0x27, 0x1d,
+        0x60, 0x7c, 0x1c, 0x12, 0x74, 0x27, 0xb4, 0xf6
+    };
 #endif
 
     /* 128 key tests */
@@ -10949,6 +11230,24 @@ static wc_test_ret_t aes_xts_128_test(void)
             ERROR_OUT(WC_TEST_RET_ENC_EC(MEMORY_E), out);
     #endif
 
+        for (i = 0; i < (int)LARGE_XTS_SZ; i++)
+            large_input[i] = (byte)i;
+
+        ret = wc_AesXtsSetKeyNoInit(aes, k1, sizeof(k1), AES_ENCRYPTION);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        ret = wc_AesXtsEncrypt(aes, large_input, large_input, LARGE_XTS_SZ, i1,
+            sizeof(i1));
+    #if defined(WOLFSSL_ASYNC_CRYPT)
+        ret = wc_AsyncWait(ret, &aes->aes.asyncDev, WC_ASYNC_FLAG_NONE);
+    #endif
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(large_input + 240, cl1, sizeof(cl1)))
+            ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+        if (XMEMCMP(large_input + 1008, cl2, sizeof(cl2)))
+            ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+
         for (i = 0; i < (int)LARGE_XTS_SZ; i++)
             large_input[i] = (byte)i;
 
@@ -15009,6 +15308,14 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aesgcm_test(void)
     #if !defined(BENCH_AESGCM_LARGE)
         #define BENCH_AESGCM_LARGE 1024
     #endif
+    #if defined(WOLFSSL_AES_256) && (BENCH_AESGCM_LARGE >= 1000)
+    /* Tag of first 1000 bytes of large_input with k1, iv1 and a. */
+    WOLFSSL_SMALL_STACK_STATIC const byte tLarge[] =
+    {
+        0x41, 0x7e, 0x31, 0x80, 0x18, 0xdb, 0x1b, 0xea,
+        0xd3, 0xb0, 0x34, 0x29, 0x51, 0xd3, 0x70, 0xfc
+    };
+    #endif
 
 #ifndef WOLFSSL_NO_MALLOC
     byte *large_input = (byte *)XMALLOC(BENCH_AESGCM_LARGE, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
@@ -15115,6 +15422,37 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aesgcm_test(void)
     if (ret != 0)
         ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
 #endif /* HAVE_AES_DECRYPT */
+
+#if BENCH_AESGCM_LARGE >= 1000
+    /* Known answer with a length that is not a multiple of the wide-vector
+     * or block size. */
+    ret = wc_AesGcmEncrypt(enc, large_output, large_input, 1000, iv1,
+                              sizeof(iv1), resultT, sizeof(tLarge), a,
+                              sizeof(a));
+#if defined(WOLFSSL_ASYNC_CRYPT)
+    ret = wc_AsyncWait(ret, &enc->asyncDev, WC_ASYNC_FLAG_NONE);
+#endif
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+#ifndef HAVE_RENESAS_SYNC
+    if (XMEMCMP(tLarge, resultT, sizeof(tLarge)))
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+#endif
+
+#ifdef HAVE_AES_DECRYPT
+    XMEMSET(large_outdec, 0, BENCH_AESGCM_LARGE);
+    ret = wc_AesGcmDecrypt(dec, large_outdec, large_output, 1000, iv1,
+                              sizeof(iv1), resultT, sizeof(tLarge), a,
+                              sizeof(a));
+#if defined(WOLFSSL_ASYNC_CRYPT)
+    ret = wc_AsyncWait(ret, &dec->asyncDev, WC_ASYNC_FLAG_NONE);
+#endif
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    if (XMEMCMP(large_input, large_outdec, 1000))
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+#endif /* HAVE_AES_DECRYPT */
+#endif /* BENCH_AESGCM_LARGE >= 1000 */
 #endif /* BENCH_AESGCM_LARGE */
 #if defined(ENABLE_NON_12BYTE_IV_TEST) && defined(WOLFSSL_AES_256)
     /* Variable IV length test */
@@ -41,6 +41,15 @@ WOLFSSL_LOCAL int  LoadCRL(WOLFSSL_CRL* crl, const char* path, int type,
                            int monitor);
 WOLFSSL_LOCAL int  BufferLoadCRL(WOLFSSL_CRL* crl, const byte* buff, long sz,
                                  int type, int verify);
+#ifdef WOLFSSL_CRL_COMPILED
+WOLFSSL_LOCAL int  CompileCRL(WOLFSSL_CERT_MANAGER* cm, const byte* buff,
+                              long sz, int type, byte* out, word32* outSz);
+WOLFSSL_LOCAL int  LoadCompiledCRL(WOLFSSL_CRL* crl, const byte* data,
+                                   word32 sz, int mapped);
+#if defined(WOLFSSL_CRL_COMPILED_MMAP) && !defined(NO_FILESYSTEM)
+WOLFSSL_LOCAL int  LoadCompiledCRLFile(WOLFSSL_CRL* crl, const char* file);
+#endif
+#endif
 WOLFSSL_LOCAL int  CheckCertCRL(WOLFSSL_CRL* crl, DecodedCert* cert);
 WOLFSSL_LOCAL int  CheckCertCRL_ex(WOLFSSL_CRL* crl, byte* issuerHash,
         byte* serial, int serialSz, byte* serialHash, const byte* extCrlInfo,
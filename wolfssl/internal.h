@@ -2049,7 +2049,8 @@ enum Misc {
     #define SESSION_TICKET_HINT_DEFAULT 300
 #endif
 
-#if !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && !defined(NO_WOLFSSL_SERVER)
+#if defined(HAVE_SESSION_TICKET) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && \
+    !defined(NO_WOLFSSL_SERVER)
     /* Check chosen encryption is available. */
     #if !(defined(HAVE_CHACHA) && defined(HAVE_POLY1305)) && \
         defined(WOLFSSL_TICKET_ENC_CHACHA20_POLY1305)
@@ -2067,6 +2068,45 @@ enum Misc {
     #if WOLFSSL_TICKET_KEY_LIFETIME <= SESSION_TICKET_HINT_DEFAULT
         #error "Ticket Key lifetime must be longer than ticket life hint."
     #endif
+    #ifndef WOLFSSL_TICKET_KEY_ROTATE
+        /* Default is to use a key for encryption for as long as tickets
+         * encrypted with it can be decrypted for their whole lifetime. */
+        #define WOLFSSL_TICKET_KEY_ROTATE         WOLFSSL_TICKET_KEY_LIFETIME
+    #endif
+    #if WOLFSSL_TICKET_KEY_ROTATE > WOLFSSL_TICKET_KEY_LIFETIME
+        #error "Ticket key rotation period must not exceed the key lifetime."
+    #endif
+    /* Key index is held in the bottom bits of the last byte of the name. */
+    #if (WOLFSSL_TICKET_KEY_CNT < 2) || (WOLFSSL_TICKET_KEY_CNT > 128) || \
+        ((WOLFSSL_TICKET_KEY_CNT & (WOLFSSL_TICKET_KEY_CNT - 1)) != 0)
+        #error "Ticket key count must be a power of 2 from 2 to 128."
+    #endif
+    /* A new key replaces one that has expired for decryption. */
+    #if WOLFSSL_TICKET_KEY_CNT <= \
+        (WOLFSSL_TICKET_KEY_LIFETIME / WOLFSSL_TICKET_KEY_ROTATE)
+        #error "Too few ticket keys for key lifetime and rotation period."
+    #endif
+
+    /* Keep an AES-GCM context keyed for each ticket key and work on a copy
+     * of it for each ticket. Only when AES-GCM is the ticket cipher - define
+     * WOLFSSL_TICKET_ENC_AES128_GCM or WOLFSSL_TICKET_ENC_AES256_GCM when
+     * ChaCha20-Poly1305 is available as it is otherwise the default.
+     * ChaCha20-Poly1305 derives the Poly1305 key from the nonce so there is
+     * no per key state worth keeping.
+     * Not for AES implementations that hold a device handle in the context as
+     * the copies would share it. */
+    #if !defined(WOLFSSL_TICKET_ENC_CBC_HMAC) && defined(HAVE_AESGCM) && \
+        (!defined(HAVE_CHACHA) || !defined(HAVE_POLY1305) || \
+         defined(WOLFSSL_TICKET_ENC_AES128_GCM) || \
+         defined(WOLFSSL_TICKET_ENC_AES256_GCM)) && \
+        !defined(WOLFSSL_TICKET_ENC_NO_PREKEY) && \
+        !defined(WOLFSSL_AFALG) && !defined(WOLFSSL_AFALG_XILINX_AES) && \
+        !defined(WOLFSSL_KCAPI_AES) && !defined(WOLFSSL_DEVCRYPTO_AES) && \
+        !defined(WOLFSSL_IMXRT_DCP) && !defined(WOLFSSL_SE050) && \
+        !defined(WOLFSSL_HAVE_PSA) && !defined(WOLFSSL_MAXQ10XX_CRYPTO) && \
+        !defined(WOLFSSL_ASYNC_CRYPT)
+        #define WOLFSSL_TICKET_ENC_PREKEY
+    #endif
 #endif
 
 #define MAX_ENCRYPT_SZ ENCRYPT_LEN
@@ -2380,6 +2420,32 @@ enum {
     #define STATIC_BUFFER_LEN RECORD_HEADER_SZ
 #endif
 
+#ifdef WOLFSSL_SEND_BATCH
+    /* Maximum number of application data records built into the output
+     * buffer before writing them to the socket in one call. Only the socket
+     * writes are coalesced - each record is still encrypted on its own. */
+    #ifndef WOLFSSL_SEND_BATCH_RECORDS
+        #define WOLFSSL_SEND_BATCH_RECORDS 4
+    #elif WOLFSSL_SEND_BATCH_RECORDS < 1
+        #error WOLFSSL_SEND_BATCH_RECORDS must be at least 1
+    #endif
+#endif
+
+#ifdef WOLFSSL_RECORD_POOL
+    /* Size of the record buffers shared by all connections: a full record
+     * with header, compression and cipher overhead. Larger buffers are
+     * allocated for the connection. */
+    #ifndef WOLFSSL_RECORD_POOL_BUF_SZ
+        #define WOLFSSL_RECORD_POOL_BUF_SZ (DTLS_RECORD_HEADER_SZ + \
+            MAX_RECORD_SIZE + MAX_COMP_EXTRA + MAX_MSG_EXTRA + \
+            MTU_EXTRA + WOLFSSL_GENERAL_ALIGNMENT + DTLS_RECORD_HEADER_SZ)
+    #endif
+    /* Default number of idle record buffers kept for reuse. */
+    #ifndef WOLFSSL_RECORD_POOL_MAX_IDLE
+        #define WOLFSSL_RECORD_POOL_MAX_IDLE 64
+    #endif
+#endif
+
 typedef struct {
     ALIGN16 byte staticBuffer[STATIC_BUFFER_LEN];
     byte*  buffer;       /* place holder for static or dynamic buffer */
@@ -2388,6 +2454,9 @@ typedef struct {
     word32 bufferSize;   /* current buffer size */
     byte   dynamicFlag;  /* dynamic memory currently in use */
     byte   offset;       /* alignment offset attempt */
+#ifdef WOLFSSL_RECORD_POOL
+    byte   pooled;       /* dynamic memory borrowed from the record pool */
+#endif
 } bufferStatic;
 
 /* Cipher Suites holder */
@@ -2486,16 +2555,84 @@ struct WOLFSSL_CIPHER {
 
 /* wolfSSL OCSP controller */
 #ifdef HAVE_OCSP
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+#ifndef WOLFSSL_COND
+    #error "OCSP cache refresh requires thread signaling (WOLFSSL_COND)."
+#endif
+
+typedef struct OcspRefresh OcspRefresh;
+
+/* Request for a response to be fetched by the refresh thread. */
+struct OcspRefresh {
+    OcspRefresh* next;                   /* next queued request */
+    OcspRequest  request;                /* copy of request to send */
+    byte         wantRaw;                /* keep raw response for stapling */
+};
+
+/* Policy, refresh thread and statistics of an OCSP response cache. */
+typedef struct OcspCache {
+    OcspRefresh*          queue;         /* requests for refresh thread */
+    COND_TYPE             cond;          /* protects queue and stop */
+    THREAD_TYPE           tid;           /* refresh thread */
+    word32                maxEntries;    /* responses kept, 0 for no limit */
+    word32                prefetch;      /* seconds before nextUpdate */
+    word32                maxStale;      /* seconds after nextUpdate */
+    word32                clock;         /* LRU clock, ticks on each use */
+    byte                  stop;          /* refresh thread to exit */
+    WOLFSSL_OCSP_CACHE_STATS stats;      /* protected by ocspLock */
+} OcspCache;
+#endif
+
 struct WOLFSSL_OCSP {
     WOLFSSL_CERT_MANAGER* cm;            /* pointer back to cert manager */
     OcspEntry*            ocspList;      /* OCSP response list */
     wolfSSL_Mutex         ocspLock;      /* OCSP list lock */
     int                   error;
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    OcspCache*            cache;         /* cache policy, NULL when not set */
+#endif
 #if defined(OPENSSL_ALL) || defined(OPENSSL_EXTRA) || \
     defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY)
     int(*statusCb)(WOLFSSL*, void*);
 #endif
 };
+
+#ifdef WOLFSSL_OCSP_STAPLE_CACHE
+#ifndef WOLFSSL_COND
+    #error "OCSP staple cache requires thread signaling (WOLFSSL_COND)."
+#endif
+#ifndef WOLFSSL_ATOMIC_OPS
+    #error "OCSP staple cache requires atomic operations."
+#endif
+
+typedef struct OcspStaple OcspStaple;
+
+/* Responses to staple for the certificate and chain of a WOLFSSL_CTX.
+ * Not modified while published or referenced by a handshake. */
+struct OcspStaple {
+    OcspStaple*        next;             /* next in pool of CTX */
+    buffer             response[1 + MAX_CHAIN_DEPTH]; /* DER, empty if none */
+    byte               count;            /* certificate then chain */
+    time_t             nextTime;         /* not stapled from this time */
+    time_t             refreshTime;      /* wake refresh thread from here */
+    wolfSSL_Atomic_Int readers;          /* handshakes referencing staple */
+    wolfSSL_Atomic_Int woken;            /* handshakes that saw refresh due */
+};
+
+/* Per-CTX store of responses to staple, kept current by a refresh thread. */
+typedef struct OcspStapleCache {
+    OcspStaple*        current;          /* published staple, may be NULL */
+    OcspStaple*        pool;             /* all staples - freed with CTX */
+    OcspRequest*       request[1 + MAX_CHAIN_DEPTH]; /* certificate, chain */
+    byte               count;            /* number of requests */
+    word32             interval;         /* seconds between refreshes */
+    wolfSSL_Mutex      lock;             /* serializes refreshes */
+    COND_TYPE          cond;             /* protects wake and stop */
+    THREAD_TYPE        tid;              /* refresh thread */
+    byte               wake;             /* refresh requested */
+    byte               stop;             /* refresh thread to exit */
+} OcspStapleCache;
+#endif
 #endif
 
 #ifndef MAX_DATE_SIZE
@@ -2522,10 +2659,29 @@ typedef struct CRL_Entry CRL_Entry;
         #error CRL_MAX_REVOKED_CERTS too big, max is 22000
     #endif
 #endif
+#ifdef WOLFSSL_CRL_SERIAL_INDEX
+/* Slot of the revoked serial index keyed by the hash of the serial number. */
+typedef struct CrlSerialHashSlot {
+    RevokedCert* rc;                          /* NULL when slot is empty */
+    byte         hash[SIGNER_DIGEST_SIZE];    /* hash of serial number */
+} CrlSerialHashSlot;
+
+/* Open addressed index of the revoked certificates of a CRL entry.
+ * Built when the CRL is loaded and not modified after. */
+typedef struct CrlSerialIndex {
+    RevokedCert**      bySerial;    /* keyed by the serial number */
+    CrlSerialHashSlot* byHash;      /* keyed by the hash of the serial */
+    word32             mask;        /* number of slots - 1 */
+} CrlSerialIndex;
+#endif
+
 /* Complete CRL */
 struct CRL_Entry {
     byte*   toBeSigned;
     byte*   signature;
+#ifdef WOLFSSL_CRL_SERIAL_INDEX
+    CrlSerialIndex* serialIndex;      /* index of certs, rebuilt on dup */
+#endif
 #if defined(OPENSSL_EXTRA)
     WOLFSSL_X509_NAME*    issuer;     /* X509_NAME type issuer */
 #endif
@@ -2568,6 +2724,26 @@ struct CRL_Entry {
 };
 
 
+#ifdef WOLFSSL_CRL_COMPILED
+/* Minimum size of the key authenticating compiled CRLs. */
+#ifndef WOLFSSL_CRL_COMPILED_MIN_KEY_SZ
+    #define WOLFSSL_CRL_COMPILED_MIN_KEY_SZ     16
+#endif
+/* Maximum size of the key authenticating compiled CRLs - HMAC block size. */
+#define WOLFSSL_CRL_COMPILED_MAX_KEY_SZ         WC_SHA256_BLOCK_SIZE
+
+typedef struct CRL_Compiled CRL_Compiled;
+
+/* CRL compiled into a flat sorted form that is searched in place.
+ * One per issuer - loading a newer compiled CRL swaps the data. */
+struct CRL_Compiled {
+    CRL_Compiled* next;      /* next compiled CRL */
+    const byte*   data;      /* compiled CRL, not copied */
+    word32        sz;        /* size of compiled CRL in bytes */
+    byte          mapped;    /* data is a file mapping to unmap on free */
+};
+#endif
+
 #ifdef HAVE_CRL_MONITOR
 typedef struct CRL_Monitor CRL_Monitor;
 
@@ -2601,6 +2777,9 @@ struct WOLFSSL_CRL {
     WOLFSSL_CERT_MANAGER* cm;            /* pointer back to cert manager */
     CRL_Entry*            currentEntry;  /* Current CRL entry being processed */
     CRL_Entry*            crlList;       /* our CRL list */
+#ifdef WOLFSSL_CRL_COMPILED
+    CRL_Compiled*         compiledList;  /* compiled CRLs */
+#endif
 #ifdef HAVE_CRL_IO
     CbCrlIO               crlIOCb;
 #endif
@@ -2631,6 +2810,54 @@ struct WOLFSSL_CRL {
     #define TP_TABLE_SIZE 11
 #endif
 
+#ifdef WOLFSSL_CA_INDEX
+#ifndef WOLFSSL_CA_INDEX_MIN_SZ
+    #define WOLFSSL_CA_INDEX_MIN_SZ 64 /* Minimum slots - power of 2 */
+#endif
+
+/* Hash index of the signers in the CA table.
+ *
+ * Open addressed with linear probing. Readers search without taking caLock.
+ * Writers hold caLock and only fill empty slots of the published table. When
+ * it gets half full, a table twice the size is built and published and the
+ * old one is retired. Retired tables are freed when signers are removed.
+ */
+typedef struct CaIndexTable {
+    Signer* volatile*    byId;    /* Keyed by SKID (name hash when NO_SKID) */
+    Signer* volatile*    byName;  /* Keyed by subject name hash */
+    word32               mask;    /* Number of slots - 1 */
+    word32               count;   /* Signers indexed */
+    struct CaIndexTable* retired; /* Next older retired table */
+} CaIndexTable;
+#endif /* WOLFSSL_CA_INDEX */
+
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+#ifndef WOLFSSL_CERT_VERIFY_CACHE_WAYS
+    #define WOLFSSL_CERT_VERIFY_CACHE_WAYS 4
+#endif
+#ifndef WOLFSSL_CERT_VERIFY_CACHE_TIMEOUT
+    #define WOLFSSL_CERT_VERIFY_CACHE_TIMEOUT 3600
+#endif
+
+/* Certificate whose signature was verified with a CA key. */
+typedef struct CertVerifyCacheEntry {
+    byte   id[WC_SHA256_DIGEST_SIZE]; /* Hash of CA key and certificate */
+    word32 added;                     /* LowResTimer() when verified     */
+    byte   used;
+} CertVerifyCacheEntry;
+
+/* Set associative cache of signature verification results. */
+typedef struct CertVerifyCache {
+    wolfSSL_Mutex         lock;
+    CertVerifyCacheEntry* entries; /* rows * WOLFSSL_CERT_VERIFY_CACHE_WAYS */
+    word32                rows;
+    word32                timeout; /* Seconds a result is kept */
+    word32                hits;
+    word32                misses;
+    word32                evictions;
+} CertVerifyCache;
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
+
 /* wolfSSL Certificate Manager */
 struct WOLFSSL_CERT_MANAGER {
     Signer*         caTable[CA_TABLE_SIZE]; /* the CA signer table */
@@ -2690,6 +2917,18 @@ struct WOLFSSL_CERT_MANAGER {
 #ifdef WC_ASN_UNKNOWN_EXT_CB
     wc_UnknownExtCallback unknownExtCallback;
 #endif
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    CertVerifyCache* verifyCache;       /* verified certificate signatures */
+#endif
+#ifdef WOLFSSL_CA_INDEX
+    CaIndexTable* volatile caIndex;     /* lock free index of caTable */
+    CaIndexTable*   caIndexRetired;     /* replaced indexes, under caLock */
+#endif
+#ifdef WOLFSSL_CRL_COMPILED
+    /* HMAC key authenticating compiled CRLs. */
+    byte            crlCompiledKey[WOLFSSL_CRL_COMPILED_MAX_KEY_SZ];
+    word32          crlCompiledKeySz;
+#endif
 };
 
 WOLFSSL_LOCAL int CM_SaveCertCache(WOLFSSL_CERT_MANAGER* cm,
@@ -2703,6 +2942,12 @@ WOLFSSL_LOCAL int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER* cm,
 WOLFSSL_LOCAL int CM_GetCertCacheMemSize(WOLFSSL_CERT_MANAGER* cm);
 WOLFSSL_LOCAL int CM_VerifyBuffer_ex(WOLFSSL_CERT_MANAGER* cm, const byte* buff,
                                      long sz, int format, int prev_err);
+#ifdef WOLFSSL_CA_INDEX
+WOLFSSL_LOCAL void CM_CaIndexAdd(WOLFSSL_CERT_MANAGER* cm, Signer* s);
+WOLFSSL_LOCAL void CM_CaIndexReset(WOLFSSL_CERT_MANAGER* cm);
+WOLFSSL_LOCAL int CM_CaIndexFind(WOLFSSL_CERT_MANAGER* cm, const byte* hash,
+                                 int byName, Signer** signer);
+#endif
 
 
 #ifndef NO_CERTS
@@ -2754,6 +2999,30 @@ struct WOLFSSL_SOCKADDR {
     void*        sa; /* pointer to the sockaddr_in or sockaddr_in6 */
 };
 
+#ifdef WOLFSSL_DTLS_MMSG
+/* Maximum number of datagrams read or written in one recvmmsg()/sendmmsg(). */
+#ifndef WOLFSSL_DTLS_MMSG_CNT
+    #define WOLFSSL_DTLS_MMSG_CNT 16
+#endif
+
+/* Datagrams read ahead with recvmmsg() and queued for sendmmsg() by the
+ * built-in DTLS I/O callbacks. */
+typedef struct DtlsMmsg {
+    byte*      rxBuf;                          /* slots of rxSlotSz bytes */
+    word32     rxSlotSz;
+    word32     rxLen[WOLFSSL_DTLS_MMSG_CNT];
+    SOCKADDR_S rxAddr[WOLFSSL_DTLS_MMSG_CNT];
+    XSOCKLENT  rxAddrSz[WOLFSSL_DTLS_MMSG_CNT];
+    int        rxCnt;                          /* datagrams read ahead */
+    int        rxIdx;                          /* next datagram to return */
+    byte*      txBuf;                          /* queued datagrams */
+    word32     txUsed;
+    word32     txLen[WOLFSSL_DTLS_MMSG_CNT];
+    int        txCnt;                          /* datagrams queued */
+    int        txDefer;                        /* queue instead of send */
+} DtlsMmsg;
+#endif
+
 typedef struct WOLFSSL_DTLS_CTX {
     WOLFSSL_SOCKADDR peer;
     int rfd;
@@ -2763,6 +3032,9 @@ typedef struct WOLFSSL_DTLS_CTX {
                        * connected (connect() and bind() both called).
                        * This means that sendto and recvfrom do not need to
                        * specify and store the peer address. */
+#ifdef WOLFSSL_DTLS_MMSG
+    DtlsMmsg* mmsg;
+#endif
 } WOLFSSL_DTLS_CTX;
 
 
@@ -2946,6 +3218,7 @@ typedef struct Options Options;
 #define TLSXT_SERVER_CERTIFICATE         0x0014 /* RFC8446 */
 #define TLSXT_ENCRYPT_THEN_MAC           0x0016 /* RFC 7366 */
 #define TLSXT_EXTENDED_MASTER_SECRET     0x0017 /* HELLO_EXT_EXTMS */
+#define TLSXT_COMPRESS_CERTIFICATE       0x001b /* RFC 8879 */
 #define TLSXT_SESSION_TICKET             0x0023
 #define TLSXT_PRE_SHARED_KEY             0x0029
 #define TLSXT_EARLY_DATA                 0x002a
@@ -3010,6 +3283,9 @@ typedef enum {
     #ifdef WOLFSSL_POST_HANDSHAKE_AUTH
     TLSX_POST_HANDSHAKE_AUTH        = TLSXT_POST_HANDSHAKE_AUTH,
     #endif
+    #ifdef WOLFSSL_CERT_COMPRESSION
+    TLSX_COMPRESS_CERTIFICATE       = TLSXT_COMPRESS_CERTIFICATE,
+    #endif
     #if !defined(NO_CERTS) && !defined(WOLFSSL_NO_SIGALG)
     TLSX_SIGNATURE_ALGORITHMS_CERT  = TLSXT_SIGNATURE_ALGORITHMS_CERT,
     #endif
@@ -3488,10 +3764,16 @@ typedef struct SessionTicket {
 typedef struct TicketEncCbCtx {
     /* Name for this context. */
     byte name[WOLFSSL_TICKET_NAME_SZ];
-    /* Current keys - current and next. */
-    byte key[2][WOLFSSL_TICKET_KEY_SZ];
+    /* Keys - one used for encryption and others still valid to decrypt. */
+    byte key[WOLFSSL_TICKET_KEY_CNT][WOLFSSL_TICKET_KEY_SZ];
     /* Expirary date of keys. */
-    word32 expirary[2];
+    word32 expirary[WOLFSSL_TICKET_KEY_CNT];
+#ifdef WOLFSSL_TICKET_ENC_PREKEY
+    /* AES-GCM objects with key schedule and hash key set up for each key. */
+    Aes aes[WOLFSSL_TICKET_KEY_CNT];
+#endif
+    /* Index of key currently used for encryption. */
+    int encIdx;
     /* Random number generator to use for generating name, keys and IV. */
     WC_RNG rng;
 #ifndef SINGLE_THREADED
@@ -3502,6 +3784,8 @@ typedef struct TicketEncCbCtx {
     WOLFSSL_CTX* ctx;
 } TicketEncCbCtx;
 
+WOLFSSL_LOCAL int TicketEncCbCtx_SetKey(TicketEncCbCtx* keyCtx, int idx);
+
 #endif /* !WOLFSSL_NO_DEF_TICKET_ENC_CB && !NO_WOLFSSL_SERVER */
 
 WOLFSSL_LOCAL int  TLSX_UseSessionTicket(TLSX** extensions,
@@ -3555,6 +3839,28 @@ typedef struct KeyShareEntry {
     struct KeyShareEntry* next;      /* List pointer             */
 } KeyShareEntry;
 
+#ifdef WOLFSSL_KEY_SHARE_POOL
+/* Pregenerated key shares of one named group. */
+typedef struct KeySharePoolGroup {
+    KeyShareEntry* list;      /* Ready key shares, linked by next */
+    word16         group;     /* NamedGroup                       */
+    word16         depth;     /* Number of key shares to keep     */
+    word16         count;     /* Number of key shares ready       */
+} KeySharePoolGroup;
+
+/* Per-CTX pool of single-use key shares generated off the handshake path. */
+typedef struct KeySharePool {
+    wolfSSL_Mutex     lock;
+    KeySharePoolGroup groups[WOLFSSL_MAX_GROUP_COUNT];
+    byte              numGroups;
+    word32            hits;
+    word32            misses;
+    word32            generated;
+} KeySharePool;
+
+WOLFSSL_LOCAL void TLSX_KeySharePool_Free(WOLFSSL_CTX* ctx);
+#endif
+
 WOLFSSL_LOCAL int TLSX_KeyShare_Use(const WOLFSSL* ssl, word16 group,
         word16 len, byte* data, KeyShareEntry **kse, TLSX** extensions);
 WOLFSSL_LOCAL int TLSX_KeyShare_Empty(WOLFSSL* ssl);
@@ -3655,6 +3961,43 @@ WOLFSSL_LOCAL int TLSX_EarlyData_Use(WOLFSSL* ssl, word32 max, int is_response);
 #endif
 #endif /* HAVE_SESSION_TICKET || !NO_PSK */
 
+#ifdef WOLFSSL_CERT_COMPRESSION
+/* Certificate Compression - RFC 8879 */
+
+#ifndef WOLFSSL_CERT_COMP_MAX_ALGS
+    #define WOLFSSL_CERT_COMP_MAX_ALGS  4
+#endif
+/* Largest uncompressed Certificate message accepted from the peer. */
+#ifndef WOLFSSL_CERT_COMP_MAX_SZ
+    #define WOLFSSL_CERT_COMP_MAX_SZ    (1 << 17)
+#endif
+
+/* A certificate compression algorithm and the last chain compressed with it.
+ */
+typedef struct CertCompAlg {
+    CallbackCertCompress   compress;   /* NULL when only decompressing */
+    CallbackCertDecompress decompress; /* NULL when only compressing   */
+    byte*                  msg;        /* Certificate body compressed  */
+    byte*                  comp;       /* Compressed msg               */
+    word32                 msgSz;
+    word32                 compSz;
+    word16                 alg;        /* Algorithm identifier         */
+} CertCompAlg;
+
+/* The compress_certificate extension information - kept on the CTX. */
+typedef struct CertComp {
+    wolfSSL_Mutex lock;                             /* Protects msg/comp */
+    CertCompAlg   algs[WOLFSSL_CERT_COMP_MAX_ALGS]; /* Preference order  */
+    byte          cnt;
+} CertComp;
+
+WOLFSSL_LOCAL int TLSX_CertComp_Offered(const WOLFSSL* ssl);
+WOLFSSL_LOCAL int TLSX_CertComp_Compress(WOLFSSL* ssl, const byte* msg,
+        word32 msgSz, word32 reserve, byte** out, word32* outSz);
+WOLFSSL_LOCAL int TLSX_CertComp_Decompress(WOLFSSL* ssl, word16 alg,
+        const byte* in, word32 inSz, byte* out, word32 outSz);
+#endif /* WOLFSSL_CERT_COMPRESSION */
+
 
 /* The types of keys to derive for. */
 enum DeriveKeyType {
@@ -3723,6 +4066,25 @@ typedef struct {
 } StaticKeyExchangeInfo_t;
 #endif /* WOLFSSL_STATIC_EPHEMERAL */
 
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+#ifndef WOLFSSL_PRIV_KEY_CACHE_SZ
+    #define WOLFSSL_PRIV_KEY_CACHE_SZ 8
+#endif
+
+/* Decoded RSA/ECC objects of the CTX private key.
+ * A key object is checked out by one handshake at a time and put back when
+ * the handshake key is freed. */
+typedef struct PrivKeyCache {
+    wolfSSL_Mutex lock;
+    void*         keys[WOLFSSL_PRIV_KEY_CACHE_SZ]; /* Idle decoded keys    */
+    word32        type;   /* DYNAMIC_TYPE_* of cached keys                 */
+    word32        gen;    /* Incremented each time the private key changes */
+    word32        hits;
+    word32        misses;
+    byte          count;  /* Number of idle keys                           */
+} PrivKeyCache;
+#endif /* WOLFSSL_PRIV_KEY_CACHE */
+
 
 /* wolfSSL context type */
 struct WOLFSSL_CTX {
@@ -3849,6 +4211,9 @@ struct WOLFSSL_CTX {
 #if defined(WOLFSSL_STATIC_EPHEMERAL) && !defined(SINGLE_THREADED)
     byte        staticKELockInit:1;
 #endif
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    byte        privKeyCacheInit:1;
+#endif
 #if defined(WOLFSSL_DTLS) && defined(WOLFSSL_SCTP)
     byte        dtlsSctp:1;         /* DTLS-over-SCTP mode */
 #endif
@@ -3959,6 +4324,9 @@ struct WOLFSSL_CTX {
     word16          group[WOLFSSL_MAX_GROUP_COUNT];
     byte            numGroups;
 #endif
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    struct KeySharePool* keySharePool;  /* pregenerated key shares */
+#endif
 #ifdef WOLFSSL_EARLY_DATA
     word32          maxEarlyDataSz;
 #endif
@@ -4009,6 +4377,9 @@ struct WOLFSSL_CTX {
         #if defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
             OcspRequest* chainOcspRequest[MAX_CHAIN_DEPTH];
         #endif
+        #ifdef WOLFSSL_OCSP_STAPLE_CACHE
+            OcspStapleCache* stapleCache; /* responses ready to staple */
+        #endif
     #endif
     #if defined(HAVE_SESSION_TICKET) && !defined(NO_WOLFSSL_SERVER)
         SessionTicketEncCb ticketEncCb;   /* enc/dec session ticket Cb */
@@ -4143,6 +4514,9 @@ struct WOLFSSL_CTX {
     wolfSSL_Mutex staticKELock;
     #endif
 #endif
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    PrivKeyCache    privKeyCache;       /* decoded private key objects */
+#endif
 #ifdef WOLFSSL_QUIC
     struct {
         const WOLFSSL_QUIC_METHOD *method;
@@ -4731,6 +5105,15 @@ typedef struct Buffers {
                                               when got WANT_WRITE            */
     int             plainSz;               /* plain text bytes in buffer to send
                                               when got WANT_WRITE            */
+#if !defined(USE_WINDOWS_API) && !defined(NO_WRITEV)
+    const struct iovec* sendIov;           /* wolfSSL_writev() plain text,
+                                              used by SendData when set      */
+    int             sendIovCnt;            /* number of sendIov elements     */
+    int             sendIovOff;            /* offset of record plain text in
+                                              sendIov when gathering         */
+    byte            sendIovGather;         /* record plain text is gathered
+                                              from sendIov by BuildMessage   */
+#endif
     byte            weOwnCert;             /* SSL own cert flag */
     byte            weOwnCertChain;        /* SSL own cert chain flag */
     byte            weOwnKey;              /* SSL own key flag */
@@ -4912,6 +5295,9 @@ struct Options {
                                            or psk */
     word16            weOwnRng:1;         /* will be true unless CTX owns */
     word16            dontFreeDigest:1;   /* when true, we used SetDigest */
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    word16            hsKeyCached:1;      /* hsKey taken from CTX key cache */
+#endif
     word16            haveEMS:1;          /* using extended master secret */
 #ifdef HAVE_POLY1305
     word16            oldPoly:1;        /* set when to use old rfc way of poly*/
@@ -5726,6 +6112,9 @@ struct WOLFSSL {
              /* side that decrements dupCount to zero frees overall structure */
     byte            dupSide;            /* write side or read side */
 #endif
+#ifdef WOLFSSL_KTLS
+    byte            ktls;               /* WOLFSSL_KTLS_TX/RX offloaded */
+#endif
 #ifdef OPENSSL_EXTRA
     byte              cbioFlag;         /* WOLFSSL_CBIO_RECV/SEND:
                                          * CBIORecv/Send is set */
@@ -5761,6 +6150,9 @@ struct WOLFSSL {
     void*           hsKey;              /* Handshake key (RsaKey or ecc_key)
                                          * allocated from heap */
     word32          hsType;             /* Type of Handshake key (hsKey) */
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    word32          hsKeyGen;           /* Cache generation hsKey taken at */
+#endif
     WOLFSSL_CIPHER  cipher;
 #ifdef WOLFSSL_DUAL_ALG_CERTS
     void*           hsAltKey;           /* Handshake key (dilithium, falcon)
@@ -5973,6 +6365,13 @@ struct WOLFSSL {
 #if defined(WOLFSSL_TLS13) && defined(WOLFSSL_POST_HANDSHAKE_AUTH)
     CertReqCtx*     certReqCtx;
 #endif
+#ifdef WOLFSSL_CERT_COMPRESSION
+    byte*           certCompMsg;        /* CompressedCertificate to send */
+    word32          certCompMsgSz;
+    byte*           certCompIn;         /* Decompressed peer Certificate */
+    word32          certCompInSz;
+    word16          certCompAlg;        /* Algorithm to compress ours with */
+#endif
 #ifdef WOLFSSL_LOCAL_X509_STORE
     WOLFSSL_X509_STORE* x509_store_pt; /* take ownership of external store */
 #endif
@@ -6050,6 +6449,9 @@ struct WOLFSSL {
 #ifdef WOLFSSL_GNRC
     struct gnrc_wolfssl_ctx *gnrcCtx;  /* Riot-OS GNRC UDP/IP context */
 #endif
+#ifdef WOLFSSL_IO_URING
+    struct WOLFSSL_URING_CONN* ioUringConn; /* io_uring IO Context */
+#endif
 #ifdef SESSION_INDEX
     int sessionIndex;                  /* Session's location in the cache. */
 #endif
@@ -6331,6 +6733,7 @@ enum HandShakeType {
     finished             =  20,
     certificate_status   =  22,
     key_update           =  24,
+    compressed_certificate = 25,   /* RFC 8879 */
     change_cipher_hs     =  55,    /* simulate unique handshake type for sanity
                                       checks.  record layer change_cipher
                                       conflicts with handshake finished */
@@ -6412,12 +6815,19 @@ WOLFSSL_LOCAL int SendCertificateStatus(WOLFSSL* ssl);
 WOLFSSL_LOCAL int SendServerKeyExchange(WOLFSSL* ssl);
 WOLFSSL_LOCAL int SendBuffered(WOLFSSL* ssl);
 WOLFSSL_LOCAL int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek);
+WOLFSSL_LOCAL int ReceiveDataInPlace(WOLFSSL* ssl, const byte** data, int sz);
+WOLFSSL_LOCAL int ReleaseReceivedData(WOLFSSL* ssl, int sz);
 WOLFSSL_LOCAL int SendFinished(WOLFSSL* ssl);
 WOLFSSL_LOCAL int RetrySendAlert(WOLFSSL* ssl);
 WOLFSSL_LOCAL int SendAlert(WOLFSSL* ssl, int severity, int type);
 WOLFSSL_LOCAL int SendFatalAlertOnly(WOLFSSL *ssl, int error);
 WOLFSSL_LOCAL int ProcessReply(WOLFSSL* ssl);
 WOLFSSL_LOCAL int ProcessReplyEx(WOLFSSL* ssl, int allowSocketErr);
+#ifdef WOLFSSL_KTLS
+WOLFSSL_LOCAL int KtlsSetKeys(WOLFSSL* ssl, int dir);
+WOLFSSL_LOCAL int KtlsSendRecord(WOLFSSL* ssl, byte type, const byte* data,
+    int sz);
+#endif
 
 WOLFSSL_LOCAL const char* AlertTypeToString(int type);
 
@@ -6439,6 +6849,10 @@ WOLFSSL_LOCAL int TLSv1_3_Capable(WOLFSSL* ssl);
 WOLFSSL_LOCAL void FreeHandshakeResources(WOLFSSL* ssl);
 WOLFSSL_LOCAL void ShrinkInputBuffer(WOLFSSL* ssl, int forcedFree);
 WOLFSSL_LOCAL void ShrinkOutputBuffer(WOLFSSL* ssl);
+#ifdef WOLFSSL_RECORD_POOL
+WOLFSSL_LOCAL int  InitRecordPool(void);
+WOLFSSL_LOCAL void FreeRecordPool(void);
+#endif
 WOLFSSL_LOCAL byte* GetOutputBuffer(WOLFSSL* ssl);
 
 WOLFSSL_LOCAL int CipherRequires(byte first, byte second, int requirement);
@@ -6556,6 +6970,11 @@ WOLFSSL_LOCAL WC_RNG* WOLFSSL_RSA_GetRNG(WOLFSSL_RSA *rsa, WC_RNG **tmpRNG,
     #if !defined(NO_SKID) && !defined(GetCAByName)
         WOLFSSL_LOCAL Signer* GetCAByName(void* cm, byte* hash);
     #endif
+    #ifdef WOLFSSL_CERT_VERIFY_CACHE
+        WOLFSSL_LOCAL int CM_VerifyCacheLookup(void* vp,
+                const DecodedCert* cert, word32 keyOID, byte* id);
+        WOLFSSL_LOCAL void CM_VerifyCacheAdd(void* vp, const byte* id);
+    #endif
 #endif /* !NO_CERTS */
 WOLFSSL_LOCAL int  BuildTlsHandshakeHash(WOLFSSL* ssl, byte* hash,
                                    word32* hashLen);
@@ -6626,6 +7045,10 @@ WOLFSSL_LOCAL word32 MacSize(const WOLFSSL* ssl);
     WOLFSSL_LOCAL int  VerifyForTxDtlsMsgDelete(WOLFSSL* ssl, DtlsMsg* item);
     WOLFSSL_LOCAL void DtlsMsgPoolReset(WOLFSSL* ssl);
     WOLFSSL_LOCAL int  DtlsMsgPoolSend(WOLFSSL* ssl, int sendOnlyFirstPacket);
+#ifdef WOLFSSL_DTLS_MMSG
+    WOLFSSL_LOCAL int  DtlsMmsgSendStart(WOLFSSL* ssl);
+    WOLFSSL_LOCAL int  DtlsMmsgSendEnd(WOLFSSL* ssl);
+#endif
     WOLFSSL_LOCAL void DtlsMsgDestroyFragBucket(DtlsFragBucket* fragBucket, void* heap);
     WOLFSSL_LOCAL int GetDtlsHandShakeHeader(WOLFSSL *ssl, const byte *input,
         word32 *inOutIdx, byte *type, word32 *size, word32 *fragOffset,
@@ -6791,6 +7214,8 @@ WOLFSSL_LOCAL void FreeBuildMsgArgs(WOLFSSL* ssl, BuildMsgArgs* args);
 WOLFSSL_LOCAL int BuildMessage(WOLFSSL* ssl, byte* output, int outSz,
                         const byte* input, int inSz, int type, int hashOutput,
                         int sizeOnly, int asyncOkay, int epochOrder);
+WOLFSSL_LOCAL void BuildMessageInput(WOLFSSL* ssl, byte* output,
+                        const byte* input, int inSz);
 
 #ifdef WOLFSSL_TLS13
 /* Use WOLFSSL_API to use this function in tests/api.c */
@@ -6801,6 +7226,9 @@ WOLFSSL_LOCAL int Tls13UpdateKeys(WOLFSSL* ssl);
 
 WOLFSSL_LOCAL int AllocKey(WOLFSSL* ssl, int type, void** pKey);
 WOLFSSL_LOCAL void FreeKey(WOLFSSL* ssl, int type, void** pKey);
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+WOLFSSL_LOCAL void PrivKeyCache_Flush(WOLFSSL_CTX* ctx);
+#endif
 
 #ifdef WOLFSSL_ASYNC_CRYPT
     WOLFSSL_LOCAL int wolfSSL_AsyncInit(WOLFSSL* ssl, WC_ASYNC_DEV* asyncDev, word32 flags);
@@ -77,6 +77,22 @@ WOLFSSL_LOCAL int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int resp
 WOLFSSL_LOCAL int CheckOcspResponder(OcspResponse *bs, DecodedCert *cert,
                                      void* vp);
 
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+WOLFSSL_LOCAL int SetOcspCache(WOLFSSL_OCSP* ocsp, word32 maxEntries,
+                               word32 prefetch, word32 maxStale);
+WOLFSSL_LOCAL int GetOcspCacheStats(WOLFSSL_OCSP* ocsp,
+                                    WOLFSSL_OCSP_CACHE_STATS* stats);
+#endif
+
+#ifdef WOLFSSL_OCSP_STAPLE_CACHE
+WOLFSSL_LOCAL int  InitOcspStapleCache(WOLFSSL_CTX* ctx, word32 interval);
+WOLFSSL_LOCAL void FreeOcspStapleCache(WOLFSSL_CTX* ctx);
+WOLFSSL_LOCAL int  RefreshOcspStapleCache(WOLFSSL_CTX* ctx);
+WOLFSSL_LOCAL struct OcspStaple* GetOcspStaple(WOLFSSL* ssl, int chain);
+WOLFSSL_LOCAL void ReleaseOcspStaple(struct OcspStaple* staple);
+WOLFSSL_LOCAL int  CopyOcspStaple(WOLFSSL* ssl, WOLFSSL_BUFFER_INFO* response);
+#endif
+
 #ifdef OPENSSL_EXTRA
 WOLFSSL_API int wolfSSL_OCSP_resp_find_status(WOLFSSL_OCSP_BASICRESP *bs,
                                               WOLFSSL_OCSP_CERTID *id, int *status, int *reason,
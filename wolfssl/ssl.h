@@ -1181,6 +1181,9 @@ WOLFSSL_ABI WOLFSSL_API int  wolfSSL_write(
     WOLFSSL* ssl, const void* data, int sz);
 WOLFSSL_ABI WOLFSSL_API int  wolfSSL_read(WOLFSSL* ssl, void* data, int sz);
 WOLFSSL_API int  wolfSSL_peek(WOLFSSL* ssl, void* data, int sz);
+WOLFSSL_API int  wolfSSL_read_zc(WOLFSSL* ssl, const unsigned char** data,
+    int sz);
+WOLFSSL_API int  wolfSSL_read_zc_release(WOLFSSL* ssl, int sz);
 WOLFSSL_ABI WOLFSSL_API int  wolfSSL_accept(WOLFSSL* ssl);
 WOLFSSL_API int  wolfSSL_CTX_mutual_auth(WOLFSSL_CTX* ctx, int req);
 WOLFSSL_API int  wolfSSL_mutual_auth(WOLFSSL* ssl, int req);
@@ -1394,6 +1397,10 @@ WOLFSSL_API int  wolfSSL_restore_session_cache(const char* fname);
 WOLFSSL_API int  wolfSSL_memsave_session_cache(void* mem, int sz);
 WOLFSSL_API int  wolfSSL_memrestore_session_cache(const void* mem, int sz);
 WOLFSSL_API int  wolfSSL_get_session_cache_memsize(void);
+#if !defined(NO_SESSION_CACHE) && defined(SESSION_CACHE_SHARED_MEM)
+WOLFSSL_API int  wolfSSL_use_shared_session_cache(void);
+WOLFSSL_API int  wolfSSL_release_shared_session_cache(void);
+#endif
 
 /* certificate cache persistence, uses ctx since certs are per ctx */
 WOLFSSL_API int  wolfSSL_CTX_save_cert_cache(WOLFSSL_CTX* ctx, const char* fname);
@@ -3174,6 +3181,35 @@ WOLFSSL_API int wolfSSL_make_eap_keys(WOLFSSL* ssl, void* key, unsigned int len,
     #endif /* !NO_WRITEV */
 #endif /* !_WIN32 */
 
+#ifdef WOLFSSL_KTLS
+    /* Directions of record protection offloaded to the Linux kernel. */
+    #define WOLFSSL_KTLS_TX  0x01
+    #define WOLFSSL_KTLS_RX  0x02
+
+    WOLFSSL_API int wolfSSL_EnableKTLS(WOLFSSL* ssl, int dir);
+    WOLFSSL_API int wolfSSL_GetKTLS(WOLFSSL* ssl);
+#endif
+
+#ifdef WOLFSSL_DTLS_MMSG
+    WOLFSSL_API int wolfSSL_dtls_write_batch(WOLFSSL* ssl,
+        const struct iovec* msgs, int cnt);
+    WOLFSSL_API int wolfSSL_dtls_read_batch(WOLFSSL* ssl, struct iovec* msgs,
+        int cnt);
+#endif
+
+#ifdef WOLFSSL_RECORD_POOL
+    typedef struct WOLFSSL_RECORD_POOL_STATS {
+        word32 inUse;       /* Buffers lent to connections */
+        word32 idle;        /* Buffers kept for reuse */
+        word32 peakInUse;   /* Most buffers lent at one time */
+        word32 allocs;      /* Buffers allocated from the heap */
+    } WOLFSSL_RECORD_POOL_STATS;
+
+    WOLFSSL_API int wolfSSL_RecordPool_SetMaxIdle(word32 maxIdle);
+    WOLFSSL_API int wolfSSL_RecordPool_GetStats(
+        WOLFSSL_RECORD_POOL_STATS* stats);
+#endif
+
 
 #ifndef NO_CERTS
     /* SSL_CTX versions */
@@ -3761,12 +3797,38 @@ WOLFSSL_API void wolfSSL_CTX_SetPerformTlsRecordProcessingCb(WOLFSSL_CTX* ctx,
     WOLFSSL_API int wolfSSL_CertManagerDisableCRL(WOLFSSL_CERT_MANAGER* cm);
     WOLFSSL_API void wolfSSL_CertManagerSetVerify(WOLFSSL_CERT_MANAGER* cm,
         VerifyCallback vc);
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    typedef struct WOLFSSL_CERT_VERIFY_CACHE_STATS {
+        word32 hits;      /* signature checks skipped */
+        word32 misses;    /* signature checks performed */
+        word32 entries;   /* results currently cached */
+        word32 evictions; /* results dropped to make room */
+    } WOLFSSL_CERT_VERIFY_CACHE_STATS;
+
+    WOLFSSL_API int wolfSSL_CertManagerSetVerifyCache(WOLFSSL_CERT_MANAGER* cm,
+        word32 sz, word32 timeout);
+    WOLFSSL_API int wolfSSL_CertManagerGetVerifyCacheStats(
+        WOLFSSL_CERT_MANAGER* cm, WOLFSSL_CERT_VERIFY_CACHE_STATS* stats);
+#endif
     WOLFSSL_API int wolfSSL_CertManagerLoadCRL(WOLFSSL_CERT_MANAGER* cm,
         const char* path, int type, int monitor);
     WOLFSSL_API int wolfSSL_CertManagerLoadCRLFile(WOLFSSL_CERT_MANAGER* cm,
         const char* file, int type);
     WOLFSSL_API int wolfSSL_CertManagerLoadCRLBuffer(WOLFSSL_CERT_MANAGER* cm,
         const unsigned char* buff, long sz, int type);
+#ifdef WOLFSSL_CRL_COMPILED
+    WOLFSSL_API int wolfSSL_CertManagerSetCompiledCRLKey(
+        WOLFSSL_CERT_MANAGER* cm, const unsigned char* key, word32 keySz);
+    WOLFSSL_API int wolfSSL_CertManagerCompileCRL(WOLFSSL_CERT_MANAGER* cm,
+        const unsigned char* buff, long sz, int type, unsigned char* out,
+        word32* outSz);
+    WOLFSSL_API int wolfSSL_CertManagerLoadCompiledCRL(
+        WOLFSSL_CERT_MANAGER* cm, const unsigned char* buff, long sz);
+#if defined(WOLFSSL_CRL_COMPILED_MMAP) && !defined(NO_FILESYSTEM)
+    WOLFSSL_API int wolfSSL_CertManagerLoadCompiledCRLFile(
+        WOLFSSL_CERT_MANAGER* cm, const char* file);
+#endif
+#endif
     WOLFSSL_API int wolfSSL_CertManagerSetCRL_Cb(WOLFSSL_CERT_MANAGER* cm,
         CbMissingCRL cb);
     WOLFSSL_API int wolfSSL_CertManagerSetCRL_ErrorCb(WOLFSSL_CERT_MANAGER* cm,
@@ -3791,6 +3853,22 @@ WOLFSSL_API void wolfSSL_CTX_SetPerformTlsRecordProcessingCb(WOLFSSL_CTX* ctx,
         WOLFSSL_CERT_MANAGER* cm, const char* url);
     WOLFSSL_API int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER* cm,
         CbOCSPIO ioCb, CbOCSPRespFree respFreeCb, void* ioCbCtx);
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    typedef struct WOLFSSL_OCSP_CACHE_STATS {
+        word32 hits;          /* lookups answered with a current response */
+        word32 staleHits;     /* lookups answered with an expired response */
+        word32 misses;        /* lookups that waited for a response */
+        word32 refreshes;     /* background refreshes that succeeded */
+        word32 refreshFails;  /* background refreshes that failed */
+        word32 evictions;     /* responses dropped to make room */
+        word32 entries;       /* responses currently cached */
+    } WOLFSSL_OCSP_CACHE_STATS;
+
+    WOLFSSL_API int wolfSSL_CertManagerSetOCSPCache(WOLFSSL_CERT_MANAGER* cm,
+        word32 maxEntries, word32 prefetch, word32 maxStale);
+    WOLFSSL_API int wolfSSL_CertManagerGetOCSPCacheStats(
+        WOLFSSL_CERT_MANAGER* cm, WOLFSSL_OCSP_CACHE_STATS* stats);
+#endif
 
     WOLFSSL_API int wolfSSL_CertManagerEnableOCSPStapling(
         WOLFSSL_CERT_MANAGER* cm);
@@ -3848,6 +3926,11 @@ WOLFSSL_API WOLF_STACK_OF(WOLFSSL_X509)* wolfSSL_X509_STORE_get1_certs(
     WOLFSSL_API int wolfSSL_CTX_DisableOCSPStapling(WOLFSSL_CTX* ctx);
     WOLFSSL_API int wolfSSL_CTX_EnableOCSPMustStaple(WOLFSSL_CTX* ctx);
     WOLFSSL_API int wolfSSL_CTX_DisableOCSPMustStaple(WOLFSSL_CTX* ctx);
+#ifdef WOLFSSL_OCSP_STAPLE_CACHE
+    WOLFSSL_API int wolfSSL_CTX_EnableOCSPStapleCache(WOLFSSL_CTX* ctx,
+        word32 interval);
+    WOLFSSL_API int wolfSSL_CTX_RefreshOCSPStapleCache(WOLFSSL_CTX* ctx);
+#endif
 #endif /* !NO_CERTS */
 
 
@@ -4180,6 +4263,52 @@ WOLFSSL_API int wolfSSL_UseKeyShare(WOLFSSL* ssl, word16 group);
 WOLFSSL_API int wolfSSL_NoKeyShares(WOLFSSL* ssl);
 #endif
 
+#ifdef WOLFSSL_KEY_SHARE_POOL
+typedef struct WOLFSSL_KEY_SHARE_POOL_STATS {
+    word32 ready;       /* Key shares ready for use in all groups */
+    word32 hits;        /* Key shares taken from the pool */
+    word32 misses;      /* Key shares generated as the pool was empty */
+    word32 generated;   /* Key shares generated to fill the pool */
+} WOLFSSL_KEY_SHARE_POOL_STATS;
+
+WOLFSSL_API int wolfSSL_CTX_KeySharePool_Set(WOLFSSL_CTX* ctx, word16 group,
+                                             word16 depth);
+WOLFSSL_API int wolfSSL_CTX_KeySharePool_Fill(WOLFSSL_CTX* ctx,
+                                              word32 maxKeys);
+WOLFSSL_API int wolfSSL_CTX_KeySharePool_GetStats(WOLFSSL_CTX* ctx,
+                                        WOLFSSL_KEY_SHARE_POOL_STATS* stats);
+#endif
+
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+typedef struct WOLFSSL_PRIV_KEY_CACHE_STATS {
+    word32 ready;       /* Decoded keys idle in the cache */
+    word32 hits;        /* Handshakes that took a decoded key */
+    word32 misses;      /* Handshakes that decoded the key */
+} WOLFSSL_PRIV_KEY_CACHE_STATS;
+
+WOLFSSL_API int wolfSSL_CTX_PrivKeyCache_GetStats(WOLFSSL_CTX* ctx,
+                                        WOLFSSL_PRIV_KEY_CACHE_STATS* stats);
+#endif
+
+#ifdef WOLFSSL_CERT_COMPRESSION
+/* CertificateCompressionAlgorithm - RFC 8879 */
+enum {
+    WOLFSSL_CERT_COMP_ZLIB   = 1,
+    WOLFSSL_CERT_COMP_BROTLI = 2,
+    WOLFSSL_CERT_COMP_ZSTD   = 3
+};
+
+/* Return the number of bytes written to out or a negative error. */
+typedef int (*CallbackCertCompress)(WOLFSSL* ssl, const byte* in, word32 inSz,
+                                    byte* out, word32 outSz);
+typedef int (*CallbackCertDecompress)(WOLFSSL* ssl, const byte* in,
+                                      word32 inSz, byte* out, word32 outSz);
+
+WOLFSSL_API int wolfSSL_CTX_AddCertCompression(WOLFSSL_CTX* ctx, word16 alg,
+                                       CallbackCertCompress compressCb,
+                                       CallbackCertDecompress decompressCb);
+#endif
+
 #ifdef WOLFSSL_DUAL_ALG_CERTS
 #define WOLFSSL_CKS_SIGSPEC_NATIVE      0x0001
 #define WOLFSSL_CKS_SIGSPEC_ALTERNATIVE 0x0002
@@ -4223,6 +4352,10 @@ WOLFSSL_API long wolfSSL_SSL_get_secure_renegotiation_support(WOLFSSL* ssl);
 #ifdef HAVE_SESSION_TICKET
 
 #if !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB) && !defined(NO_WOLFSSL_SERVER)
+    /* Cipher of default ticket callback: ChaCha20-Poly1305 when available,
+     * otherwise AES-GCM. AES-GCM keeps a keyed context per ticket key and is
+     * faster where AES is accelerated - select it with
+     * WOLFSSL_TICKET_ENC_AES128_GCM or WOLFSSL_TICKET_ENC_AES256_GCM. */
     #ifdef WOLFSSL_TICKET_ENC_CBC_HMAC
         #if defined(WOLFSSL_TICKET_ENC_HMAC_SHA512)
             #define WOLFSSL_TICKET_ENC_HMAC     WC_HASH_TYPE_SHA512
@@ -4251,9 +4384,16 @@ WOLFSSL_API long wolfSSL_SSL_get_secure_renegotiation_support(WOLFSSL* ssl);
         #define WOLFSSL_TICKET_KEY_SZ       AES_128_KEY_SIZE
     #endif
 
+    #ifndef WOLFSSL_TICKET_KEY_CNT
+        /* Number of keys that can be valid for decryption at one time. */
+        #define WOLFSSL_TICKET_KEY_CNT      2
+    #endif
+
     #define WOLFSSL_TICKET_KEYS_SZ     (WOLFSSL_TICKET_NAME_SZ +    \
-                                        2 * WOLFSSL_TICKET_KEY_SZ + \
-                                        sizeof(word32) * 2)
+                                        WOLFSSL_TICKET_KEY_CNT *    \
+                                        WOLFSSL_TICKET_KEY_SZ +     \
+                                        sizeof(word32) *            \
+                                        WOLFSSL_TICKET_KEY_CNT)
 #endif
 
 #ifndef NO_WOLFSSL_CLIENT
@@ -4333,6 +4473,9 @@ WOLFSSL_API int wolfSSL_get_session_stats(unsigned int* active,
                                           unsigned int* total,
                                           unsigned int* peak,
                                           unsigned int* maxSessions);
+WOLFSSL_API int wolfSSL_get_session_cache_stats(unsigned int* hits,
+                                                unsigned int* misses,
+                                                unsigned int* evictions);
 /* External facing KDF */
 WOLFSSL_API
 int wolfSSL_MakeTlsMasterSecret(unsigned char* ms, word32 msLen,
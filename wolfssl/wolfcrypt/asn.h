@@ -1561,6 +1561,11 @@ struct SignatureCtx {
     int saltLen;
 #endif
 #endif
+#ifdef WOLFSSL_SIGNER_KEY_CACHE
+    struct Signer* signer;           /* CA that may lend its decoded key */
+    struct SignerKeyCache* keyCache; /* CA decoded key cache being held */
+    byte keyBorrowed;                /* key object belongs to keyCache */
+#endif
 };
 
 enum CertSignState {
@@ -2029,6 +2034,20 @@ struct DecodedCert {
 
 /* CA Signers */
 /* if change layout change PERSIST_CERT_CACHE functions too */
+#ifdef WOLFSSL_SIGNER_KEY_CACHE
+/* Decoded public key of a signer. Kept apart from the Signer so that the
+ * signer itself is not modified after being added to the table. */
+typedef struct SignerKeyCache {
+    void*   obj;   /* RsaKey or ecc_key */
+    void*   heap;  /* heap hint obj allocated with */
+    #ifdef WOLFSSL_ATOMIC_OPS
+    wolfSSL_Atomic_Int busy; /* non-zero while held by a verify */
+    #else
+    int     busy;
+    #endif
+} SignerKeyCache;
+#endif
+
 struct Signer {
     word32  pubKeySize;
     word32  keyOID;                  /* key type */
@@ -2071,6 +2090,9 @@ struct Signer {
     byte*   sapkiDer;
     int     sapkiLen;
 #endif /* WOLFSSL_DUAL_ALG_CERTS */
+#ifdef WOLFSSL_SIGNER_KEY_CACHE
+    SignerKeyCache* keyCache; /* decoded publicKey, filled on first use */
+#endif
     byte type;
 
     Signer* next;
@@ -2549,6 +2571,12 @@ struct CertStatus {
 
     byte*  rawOcspResponse;
     word32 rawOcspResponseSz;
+#ifdef WOLFSSL_OCSP_CACHE_REFRESH
+    time_t nextTime;   /* nextDate as seconds since epoch, 0 when none */
+    time_t retryTime;  /* no refresh before this time */
+    word32 lastUsed;   /* cache LRU clock at last use */
+    byte   refreshing; /* refresh queued for refresh thread */
+#endif
 };
 
 typedef struct OcspEntry OcspEntry;
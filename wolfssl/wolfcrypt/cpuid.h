@@ -51,6 +51,8 @@
     #define CPUID_MOVBE  0x0080   /* Move and byte swap */
     #define CPUID_BMI1   0x0100   /* ANDN */
     #define CPUID_SHA    0x0200   /* SHA-1 and SHA-256 instructions */
+    #define CPUID_VAES   0x0400   /* 256-bit AES instructions */
+    #define CPUID_VPCLMULQDQ 0x0800 /* 256-bit carry-less multiply */
 
     #define IS_INTEL_AVX1(f)    ((f) & CPUID_AVX1)
     #define IS_INTEL_AVX2(f)    ((f) & CPUID_AVX2)
@@ -62,6 +64,8 @@
     #define IS_INTEL_MOVBE(f)   ((f) & CPUID_MOVBE)
     #define IS_INTEL_BMI1(f)    ((f) & CPUID_BMI1)
     #define IS_INTEL_SHA(f)     ((f) & CPUID_SHA)
+    #define IS_INTEL_VAES(f)    ((f) & CPUID_VAES)
+    #define IS_INTEL_VPCLMULQDQ(f) ((f) & CPUID_VPCLMULQDQ)
 
 #endif
 
@@ -4086,6 +4086,109 @@ extern void uITRON4_free(void *p) ;
 #error "Dynamic session cache currently does not support persistent session cache."
 #endif
 
+#ifdef SESSION_CACHE_SHARED_MEM
+    #ifdef SESSION_CACHE_DYNAMIC_MEM
+        #error "Shared session cache does not support dynamic session cache."
+    #endif
+    #ifdef SINGLE_THREADED
+        #error "Shared session cache requires process shared pthread locks."
+    #endif
+#endif
+
+#ifdef WOLFSSL_KTLS
+    #if !defined(__linux__) || defined(WOLFSSL_LINUXKM)
+        #error "Kernel TLS offload is only available on Linux user space."
+    #endif
+    #if defined(WOLFSSL_USER_IO) || defined(WOLFSSL_NO_SOCK)
+        #error "Kernel TLS offload requires the built-in socket I/O."
+    #endif
+#endif
+
+#ifdef WOLFSSL_DTLS_MMSG
+    #ifndef WOLFSSL_DTLS
+        #error "Batched datagram I/O requires DTLS."
+    #endif
+    #if !defined(__linux__) || defined(WOLFSSL_LINUXKM)
+        #error "Batched datagram I/O is only available on Linux user space."
+    #endif
+    #if defined(WOLFSSL_USER_IO) || defined(WOLFSSL_NO_SOCK) || \
+        defined(NO_WRITEV)
+        #error "Batched datagram I/O requires the built-in socket I/O."
+    #endif
+#endif
+
+#ifdef WOLFSSL_IO_URING
+    #if !defined(__linux__) || defined(WOLFSSL_LINUXKM)
+        #error "io_uring is only available on Linux user space."
+    #endif
+    #if defined(WOLFSSL_USER_IO) || defined(WOLFSSL_NO_SOCK)
+        #error "io_uring requires the built-in socket I/O."
+    #endif
+#endif
+
+#if defined(WOLFSSL_RECORD_POOL) && defined(WOLFSSL_STATIC_MEMORY)
+    #error "Record pool not supported with static memory - use its IO pools."
+#endif
+
+#if defined(WOLFSSL_SEND_BATCH) && defined(WOLFSSL_ASYNC_CRYPT)
+    #error "Batched record send does not support asynchronous crypto."
+#endif
+
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    #if !defined(WOLFSSL_TLS13) || !defined(HAVE_SUPPORTED_CURVES)
+        #error "Key share pool requires TLS 1.3 and supported curves."
+    #endif
+    #if defined(WOLFSSL_ASYNC_CRYPT) || defined(WOLFSSL_STATIC_EPHEMERAL)
+        #error "Key share pool not supported with async or static ephemeral keys."
+    #endif
+#endif
+
+#ifdef WOLFSSL_CERT_COMPRESSION
+    #if !defined(WOLFSSL_TLS13) || !defined(HAVE_TLS_EXTENSIONS) || \
+        defined(NO_CERTS)
+        #error "Certificate compression requires TLS 1.3 and certificates."
+    #endif
+#endif
+
+#ifdef WOLFSSL_PRIV_KEY_CACHE
+    #if defined(NO_CERTS) || (defined(NO_RSA) && !defined(HAVE_ECC))
+        #error "Private key cache requires certificates and RSA or ECC."
+    #endif
+    #ifdef WOLFSSL_ASYNC_CRYPT
+        #error "Private key cache not supported with async crypto."
+    #endif
+#endif
+
+#if defined(WOLFSSL_SIGNER_KEY_CACHE) && defined(WOLFSSL_ASYNC_CRYPT)
+    #error "Signer key cache not supported with async crypto."
+#endif
+
+#if defined(WOLFSSL_CERT_VERIFY_CACHE) && (defined(WOLFCRYPT_ONLY) || \
+        defined(NO_CERTS) || defined(NO_SHA256))
+    #error "Certificate verify cache requires certificates and SHA-256."
+#endif
+
+#if defined(WOLFSSL_CRL_SERIAL_INDEX) && defined(CRL_STATIC_REVOKED_LIST)
+    #error "CRL serial index is not used with the static revoked list."
+#endif
+
+#if defined(WOLFSSL_CRL_COMPILED) && defined(CRL_STATIC_REVOKED_LIST)
+    #error "Compiled CRLs are not supported with the static revoked list."
+#endif
+
+#if defined(WOLFSSL_OCSP_CACHE_REFRESH) && (!defined(HAVE_OCSP) || \
+        defined(SINGLE_THREADED) || defined(NO_ASN_TIME))
+    #error "OCSP cache refresh requires OCSP, threads and ASN time."
+#endif
+
+#if defined(WOLFSSL_OCSP_STAPLE_CACHE) && (!defined(HAVE_OCSP) || \
+        defined(SINGLE_THREADED) || defined(NO_ASN_TIME) || \
+        defined(NO_WOLFSSL_SERVER) || \
+        (!defined(HAVE_CERTIFICATE_STATUS_REQUEST) && \
+         !defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)))
+    #error "OCSP staple cache requires stapling, server, threads and ASN time."
+#endif
+
 #ifdef WOLFSSL_HARDEN_TLS
     #if defined(HAVE_TRUNCATED_HMAC) && !defined(WOLFSSL_HARDEN_TLS_ALLOW_TRUNCATED_HMAC)
         #error "Truncated HMAC Extension not allowed https://www.rfc-editor.org/rfc/rfc9325#section-4.6"
@@ -274,6 +274,10 @@ WOLFSSL_API int wc_Sha256Transform(wc_Sha256* sha, const unsigned char* data);
 WOLFSSL_API int wc_Sha256HashBlock(wc_Sha256* sha, const unsigned char* data,
     unsigned char* hash);
 #endif
+#ifdef WOLFSSL_SHA256_MULTI
+WOLFSSL_API int wc_Sha256_MultiHash(const byte* const* data, const word32* sz,
+    byte* const* hash, word32 cnt, void* heap, int devId);
+#endif
 #if defined(WOLFSSL_HASH_KEEP)
 WOLFSSL_API int wc_Sha256_Grow(wc_Sha256* sha256, const byte* in, int inSz);
 #endif
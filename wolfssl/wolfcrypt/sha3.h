@@ -147,6 +147,24 @@ struct wc_Sha3 {
     #define WC_SHA3_TYPE_DEFINED
 #endif
 
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+/* Four SHAKE operations performed in parallel. */
+struct wc_Shakex4 {
+    /* State of each operation interleaved: s[word * 4 + operation]. */
+    word64 s[25 * 4];
+
+    void*  heap;
+};
+
+#ifndef WC_SHAKEX4_TYPE_DEFINED
+    typedef struct wc_Shakex4 wc_Shakex4;
+    #define WC_SHAKEX4_TYPE_DEFINED
+#endif
+
+/* Multi-buffer SHAKE API available. */
+#define WC_SHAKE_X4
+#endif
+
 #endif
 
 #if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
@@ -194,6 +212,14 @@ WOLFSSL_API int wc_Shake128_SqueezeBlocks(wc_Shake* shake, byte* out,
     word32 blockCnt);
 WOLFSSL_API void wc_Shake128_Free(wc_Shake* shake);
 WOLFSSL_API int wc_Shake128_Copy(wc_Shake* src, wc_Sha3* dst);
+#ifdef WC_SHAKE_X4
+WOLFSSL_API int wc_InitShake128x4(wc_Shakex4* shake, void* heap, int devId);
+WOLFSSL_API int wc_Shake128x4_Absorb(wc_Shakex4* shake,
+    const byte* const* data, word32 len);
+WOLFSSL_API int wc_Shake128x4_SqueezeBlocks(wc_Shakex4* shake,
+    byte* const* out, word32 blockCnt);
+WOLFSSL_API void wc_Shake128x4_Free(wc_Shakex4* shake);
+#endif
 #endif
 
 #ifdef WOLFSSL_SHAKE256
@@ -206,6 +232,14 @@ WOLFSSL_API int wc_Shake256_SqueezeBlocks(wc_Shake* shake, byte* out,
     word32 blockCnt);
 WOLFSSL_API void wc_Shake256_Free(wc_Shake* shake);
 WOLFSSL_API int wc_Shake256_Copy(wc_Shake* src, wc_Sha3* dst);
+#ifdef WC_SHAKE_X4
+WOLFSSL_API int wc_InitShake256x4(wc_Shakex4* shake, void* heap, int devId);
+WOLFSSL_API int wc_Shake256x4_Absorb(wc_Shakex4* shake,
+    const byte* const* data, word32 len);
+WOLFSSL_API int wc_Shake256x4_SqueezeBlocks(wc_Shakex4* shake,
+    byte* const* out, word32 blockCnt);
+WOLFSSL_API void wc_Shake256x4_Free(wc_Shakex4* shake);
+#endif
 #endif
 
 #ifdef WOLFSSL_HASH_FLAGS
@@ -219,6 +253,9 @@ WOLFSSL_LOCAL void sha3_block_n_bmi2(word64* s, const byte* data, word32 n,
 WOLFSSL_LOCAL void sha3_block_bmi2(word64* s);
 WOLFSSL_LOCAL void sha3_block_avx2(word64* s);
 WOLFSSL_LOCAL void BlockSha3(word64 *s);
+#ifdef WC_SHAKE_X4
+WOLFSSL_LOCAL void kyber_sha3_blocksx4_avx2(word64* s);
+#endif
 #endif
 #if defined(WOLFSSL_ARMASM) || defined(WOLFSSL_RISCV_ASM)
 WOLFSSL_LOCAL void BlockSha3(word64 *s);
@@ -1098,6 +1098,8 @@ typedef struct w64wrapper {
         DYNAMIC_TYPE_LMS          = 101,
         DYNAMIC_TYPE_BIO          = 102,
         DYNAMIC_TYPE_X509_ACERT   = 103,
+        DYNAMIC_TYPE_DTLS_MMSG    = 104,
+        DYNAMIC_TYPE_IO_URING     = 105,
         DYNAMIC_TYPE_SNIFFER_SERVER      = 1000,
         DYNAMIC_TYPE_SNIFFER_SESSION     = 1001,
         DYNAMIC_TYPE_SNIFFER_PB          = 1002,
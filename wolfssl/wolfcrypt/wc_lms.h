@@ -145,6 +145,11 @@
 /* Length of SEED and I in bytes. */
 #define LMS_SEED_I_LEN              (LMS_SEED_LEN + LMS_I_LEN)
 
+#ifdef WOLFSSL_SHA256_MULTI
+/* Number of LM-OTS hash chains computed in parallel. */
+#define LMS_MULTI_CHAINS            8
+#endif
+
 
 #ifndef WOLFSSL_LMS_ROOT_LEVELS
     #ifdef WOLFSSL_LMS_LARGE_CACHES
@@ -363,6 +368,10 @@ typedef struct LmsState {
 #ifdef WOLFSSL_SMALL_STACK
     /* Buffer to hold expanded Q coefficients. */
     ALIGN16 byte a[LMS_MAX_P];
+#endif
+#ifdef WOLFSSL_SHA256_MULTI
+    /* Buffers to hold data to hash for chains computed in parallel. */
+    ALIGN16 byte multi[LMS_MULTI_CHAINS][WC_SHA256_BLOCK_SIZE];
 #endif
     /* LMS parameters. */
     const LmsParams* params;
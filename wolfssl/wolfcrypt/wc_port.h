@@ -364,6 +364,13 @@
      * the effects of the function. */
     WOLFSSL_API int wolfSSL_Atomic_Int_FetchAdd(wolfSSL_Atomic_Int* c, int i);
     WOLFSSL_API int wolfSSL_Atomic_Int_FetchSub(wolfSSL_Atomic_Int* c, int i);
+    /* Load with acquire and store with release semantics. Data written before
+     * a pointer is stored is visible to a thread that loads the pointer. */
+    WOLFSSL_API void* wolfSSL_Atomic_Ptr_Load(void* volatile* p);
+    WOLFSSL_API void wolfSSL_Atomic_Ptr_Store(void* volatile* p, void* v);
+    /* Sequentially consistent fence. Orders a preceding store or counter
+     * update before a following load as seen by all threads. */
+    WOLFSSL_API void wolfSSL_Atomic_Fence(void);
 #else
     /* Code using these fallback macros needs to arrange its own fallback for
      * wolfSSL_Atomic_Int, which is never defined if
@@ -373,6 +380,9 @@
     #define wolfSSL_Atomic_Int_Init(c, i) (*(c) = (i))
     #define wolfSSL_Atomic_Int_FetchAdd(c, i) (*(c) += (i), *(c) - (i))
     #define wolfSSL_Atomic_Int_FetchSub(c, i) (*(c) -= (i), *(c) + (i))
+    #define wolfSSL_Atomic_Ptr_Load(p) (*(p))
+    #define wolfSSL_Atomic_Ptr_Store(p, v) (*(p) = (v))
+    #define wolfSSL_Atomic_Fence() WC_DO_NOTHING
 #endif
 
 /* Reference counting. */
@@ -460,6 +460,15 @@ WOLFSSL_API int wolfIO_TcpAccept(SOCKET_T sockfd, SOCKADDR* peer_addr, XSOCKLENT
 WOLFSSL_API int wolfIO_TcpBind(SOCKET_T* sockfd, word16 port);
 WOLFSSL_API  int wolfIO_Send(SOCKET_T sd, char *buf, int sz, int wrFlags);
 WOLFSSL_API  int wolfIO_Recv(SOCKET_T sd, char *buf, int sz, int rdFlags);
+#ifdef WOLFSSL_KTLS
+WOLFSSL_LOCAL int wolfIO_KtlsAttach(SOCKET_T sd);
+WOLFSSL_LOCAL int wolfIO_KtlsSetCrypto(SOCKET_T sd, int rx, const void* info,
+    word32 infoSz);
+WOLFSSL_LOCAL int wolfIO_SendRecord(SOCKET_T sd, byte type, char *buf, int sz,
+    int wrFlags);
+WOLFSSL_LOCAL int wolfIO_RecvRecord(SOCKET_T sd, byte* type, char *buf, int sz,
+    int rdFlags);
+#endif
 
 #ifdef WOLFSSL_HAVE_BIO_ADDR
 
@@ -547,6 +556,12 @@ WOLFSSL_LOCAL int SslBioReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
             WOLFSSL_API int EmbedReceiveFromMcast(WOLFSSL *ssl, char *buf,
                                                   int sz, void *ctx);
         #endif /* WOLFSSL_MULTICAST */
+        #ifdef WOLFSSL_DTLS_MMSG
+            WOLFSSL_LOCAL int wolfIO_DtlsSendDefer(WOLFSSL* ssl, void* ctx);
+            WOLFSSL_LOCAL int wolfIO_DtlsSendFlush(WOLFSSL* ssl, void* ctx);
+            WOLFSSL_LOCAL int wolfIO_DtlsRecvPending(const void* ctx);
+            WOLFSSL_LOCAL void wolfIO_DtlsMmsgFree(void* ctx, void* heap);
+        #endif
     #endif /* WOLFSSL_DTLS */
 #endif /* USE_WOLFSSL_IO */
 
@@ -802,6 +817,42 @@ WOLFSSL_API void wolfSSL_SetIOWriteFlags(WOLFSSL* ssl, int flags);
             int receive_buffer_size, void *arg);
 
 #endif
+#ifdef WOLFSSL_IO_URING
+    /* Size of each of a connection's receive and send staging buffers. */
+    #ifndef WOLFSSL_IO_URING_BUF_SZ
+        #define WOLFSSL_IO_URING_BUF_SZ 8192
+    #endif
+    /* Maximum connections on one ring - two completions each must fit. */
+    #define WOLFSSL_IO_URING_MAX_CONNS 32768
+
+    /* Flags for wolfSSL_IoUring_new(). */
+    /* Register the staging buffers with the kernel once: pinned and reused
+     * by every receive. */
+    #define WOLFSSL_IO_URING_FIXED_BUFFERS 0x01
+
+    typedef struct WOLFSSL_URING WOLFSSL_URING;
+    struct WOLFSSL_URING_CONN;
+
+    typedef struct WOLFSSL_URING_STATS {
+        word32 enters;      /* io_uring_enter() system calls */
+        word32 submitted;   /* Receive and send operations submitted */
+        word32 completed;   /* Completions reaped */
+        byte   fixed;       /* Staging buffers registered with the kernel */
+    } WOLFSSL_URING_STATS;
+
+    WOLFSSL_API WOLFSSL_URING* wolfSSL_IoUring_new(int conns, int flags,
+                                                   void* heap);
+    WOLFSSL_API void wolfSSL_IoUring_free(WOLFSSL_URING* ring);
+    WOLFSSL_API int wolfSSL_SetIO_IoUring(WOLFSSL* ssl,
+                                          WOLFSSL_URING* ring);
+    WOLFSSL_API int wolfSSL_IoUring_Submit(WOLFSSL_URING* ring, int wait,
+                                           WOLFSSL** ready, int readySz);
+    WOLFSSL_API int wolfSSL_IoUring_Pending(WOLFSSL* ssl);
+    WOLFSSL_API int wolfSSL_IoUring_GetStats(WOLFSSL_URING* ring,
+                                             WOLFSSL_URING_STATS* stats);
+    WOLFSSL_API int wolfSSL_IoUring_GetFd(WOLFSSL_URING* ring);
+    WOLFSSL_LOCAL void wolfIO_IoUringDetach(WOLFSSL* ssl);
+#endif /* WOLFSSL_IO_URING */
 #ifdef WOLFSSL_DTLS
     typedef int (*CallbackGenCookie)(WOLFSSL* ssl, unsigned char* buf, int sz,
                                      void* ctx);